@@ -16,6 +16,7 @@
 #import <Foundation/Foundation.h>
 #import <AWSCore/AWSCore.h>
 #import "AWSAPIGatewayModel.h"
+#import "AWSAPIGatewayResponseCache.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -41,6 +42,12 @@ typedef NS_ENUM(NSInteger, AWSAPIGatewayErrorType) {
 
 @property (nonatomic, strong, nullable) NSString *APIKey;
 
+/**
+ *  The cache of the responses to `GET` requests. The default value is `nil`, and every request is sent to the API.
+ *
+ *  @see AWSAPIGatewayResponseCache
+ */
+@property (nonatomic, strong, nullable) AWSAPIGatewayResponseCache *responseCache;
 
 
 /**
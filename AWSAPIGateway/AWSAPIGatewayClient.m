@@ -44,6 +44,17 @@ static int defaultChunkSize = 1024;
 
 @end
 
+@interface AWSAPIGatewayResponseCache()
+
+- (AWSAPIGatewayResponse *)cachedResponseForRequest:(NSMutableURLRequest *)request
+                                        credentials:(AWSCredentials *)credentials;
+- (AWSAPIGatewayResponse *)responseForRequest:(NSURLRequest *)request
+                                  credentials:(AWSCredentials *)credentials
+                                 HTTPResponse:(NSHTTPURLResponse *)HTTPResponse
+                                         data:(NSData *)data;
+
+@end
+
 @interface AWSAPIGatewayResponse()
 
 @property (nonatomic, readwrite) NSDictionary *headers;
@@ -86,6 +97,15 @@ static int defaultChunkSize = 1024;
     return self;
 }
 
++ (AWSExecutor *)serializationExecutor {
+    static AWSExecutor *serializationExecutor = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        serializationExecutor = [AWSExecutor executorWithDispatchQueue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)];
+    });
+    return serializationExecutor;
+}
+
 - (AWSTask<AWSAPIGatewayResponse *> *)invoke:(AWSAPIGatewayRequest *)apiRequest {
     
     if(!apiRequest) {
@@ -102,9 +122,7 @@ static int defaultChunkSize = 1024;
         [request addValue:self.APIKey forHTTPHeaderField:AWSAPIGatewayAPIKeyHeader];
     }
     
-    AWSTask *task = [AWSTask taskWithResult:nil];
-    
-    task = [task continueWithSuccessBlock:^id(AWSTask *task) {
+    AWSTask *task = [[AWSTask taskWithResult:nil] continueWithExecutor:[AWSAPIGatewayClient serializationExecutor] withSuccessBlock:^id(AWSTask *task) {
         NSError *error = nil;
         if (apiRequest.HTTPBody != nil) {
             
@@ -163,52 +181,7 @@ static int defaultChunkSize = 1024;
         return nil;
     }];
     
-    // Refreshes credentials if necessary
-    task = [task continueWithSuccessBlock:^id(AWSTask *task) {
-        id signer = [self.configuration.requestInterceptors lastObject];
-        if (signer) {
-            if ([signer respondsToSelector:@selector(credentialsProvider)]) {
-                id<AWSCredentialsProvider> credentialsProvider = [signer performSelector:@selector(credentialsProvider)];
-                return [credentialsProvider credentials];
-            }
-        }
-        return nil;
-    }];
-    
-    // Signs the request
-    for (id<AWSNetworkingRequestInterceptor> interceptor in self.configuration.requestInterceptors) {
-        task = [task continueWithSuccessBlock:^id(AWSTask *task) {
-            return [interceptor interceptRequest:request];
-        }];
-    }
-    
-    return  [task continueWithSuccessBlock:^id(AWSTask *task) {
-        AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource new];
-        
-        void (^completionHandler)(NSData *data, NSURLResponse *response, NSError *error) = ^(NSData *data, NSURLResponse *response, NSError *error) {
-            // Networking errors
-            if (error) {
-                [completionSource setError:error];
-            } else {
-                
-                NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
-                NSDictionary *HTTPHeaderFields = HTTPResponse.allHeaderFields;
-                NSInteger HTTPStatusCode = HTTPResponse.statusCode;
-                
-                [completionSource setResult:[[AWSAPIGatewayResponse alloc] initWithHeaders:HTTPHeaderFields
-                                                                              responseData:data
-                                                                       NSURLResponseObject:response
-                                                                                statusCode:HTTPStatusCode]];
-            }
-        };
-        AWSDDLogVerbose(@"%@",request);
-        NSURLSessionDataTask *sessionTask = [self.session dataTaskWithRequest:request
-                                                            completionHandler:completionHandler];
-        [sessionTask resume];
-        
-        return completionSource.task;
-    }];
-
+    return [self sendRequest:request afterTask:task];
 }
 
 - (AWSTask *)invokeHTTPRequest:(NSString *)HTTPMethod
@@ -226,38 +199,183 @@ static int defaultChunkSize = 1024;
         [request addValue:self.APIKey forHTTPHeaderField:AWSAPIGatewayAPIKeyHeader];
     }
 
-    NSError *error = nil;
-    if (body != nil) {
-        NSDictionary *bodyParameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:body] aws_removeNullValues];
-        request.HTTPBody = [NSJSONSerialization dataWithJSONObject:bodyParameters
-                                                           options:0
-                                                             error:&error];
-        if (!request.HTTPBody) {
-            AWSDDLogError(@"Failed to serialize a request body. %@", error);
+    // Serializes the HTTP body
+    AWSTask *task = [[AWSTask taskWithResult:nil] continueWithExecutor:[AWSAPIGatewayClient serializationExecutor] withSuccessBlock:^id(AWSTask *task) {
+        if (body != nil) {
+            NSError *error = nil;
+            NSDictionary *bodyParameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:body] aws_removeNullValues];
+            request.HTTPBody = [NSJSONSerialization dataWithJSONObject:bodyParameters
+                                                               options:0
+                                                                 error:&error];
+            if (!request.HTTPBody) {
+                AWSDDLogError(@"Failed to serialize a request body. %@", error);
+            }
         }
-    }
+        return nil;
+    }];
 
-    // Refreshes credentials if necessary
-    AWSTask *task = [AWSTask taskWithResult:nil];
-    task = [task continueWithSuccessBlock:^id(AWSTask *task) {
-        id signer = [self.configuration.requestInterceptors lastObject];
-        if (signer) {
-            if ([signer respondsToSelector:@selector(credentialsProvider)]) {
-                id<AWSCredentialsProvider> credentialsProvider = [signer performSelector:@selector(credentialsProvider)];
-                return [credentialsProvider credentials];
+    task = [self sendRequest:request afterTask:task];
+
+    return [task continueWithExecutor:[AWSAPIGatewayClient serializationExecutor] withSuccessBlock:^id(AWSTask<AWSAPIGatewayResponse *> *task) {
+        AWSAPIGatewayResponse *response = task.result;
+        NSData *data = response.responseData;
+        NSError *error = nil;
+
+        // Serializes the HTTP body
+        id JSONObject = nil;
+        if (data && [data length] > 0) {
+            JSONObject = [NSJSONSerialization JSONObjectWithData:data
+                                                         options:NSJSONReadingAllowFragments
+                                                           error:&error];
+            if (!JSONObject) {
+                NSString *bodyString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+                if ([bodyString length] > 0) {
+                    AWSDDLogError(@"The body is not in JSON format. Body: %@\nError: %@", bodyString, error);
+                }
+                return [AWSTask taskWithError:error];
+            }
+        }
+
+        // Handles developer defined errors
+        NSDictionary *HTTPHeaderFields = response.headers;
+        NSInteger HTTPStatusCode = response.statusCode;
+        if (HTTPStatusCode/100 == 4 || HTTPStatusCode/100 == 5) {
+            NSMutableDictionary *userInfo = [NSMutableDictionary new];
+            if (JSONObject) {
+                userInfo[AWSAPIGatewayErrorHTTPBodyKey] = JSONObject;
+            }
+            if (HTTPHeaderFields) {
+                userInfo[AWSAPIGatewayErrorHTTPHeaderFieldsKey] = HTTPHeaderFields;
+            }
+
+            if (HTTPStatusCode/100 == 4) {
+                return [AWSTask taskWithError:[NSError errorWithDomain:AWSAPIGatewayErrorDomain
+                                                                  code:AWSAPIGatewayErrorTypeClient
+                                                              userInfo:userInfo]];
+            }
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSAPIGatewayErrorDomain
+                                                              code:AWSAPIGatewayErrorTypeService
+                                                          userInfo:userInfo]];
+        }
+
+        // Maps a serialized JSON object to an Objective-C object
+        if (JSONObject) {
+            if (responseClass
+                && responseClass != [NSDictionary class]) {
+                if ([JSONObject isKindOfClass:[NSDictionary class]]) {
+                    NSError *responseSerializationError = nil;
+                    JSONObject = [AWSMTLJSONAdapter modelOfClass:responseClass
+                                              fromJSONDictionary:JSONObject
+                                                           error:&responseSerializationError];
+                    if (!JSONObject) {
+                        AWSDDLogError(@"Failed to serialize the body JSON. %@", responseSerializationError);
+                    }
+                }
+                if ([JSONObject isKindOfClass:[NSArray class]]) {
+                    NSError *responseSerializationError = nil;
+                    NSMutableArray *models = [NSMutableArray new];
+                    for (id object in JSONObject) {
+                        id model = [AWSMTLJSONAdapter modelOfClass:responseClass
+                                                fromJSONDictionary:object
+                                                             error:&responseSerializationError];
+                        [models addObject:model];
+                        if (!JSONObject) {
+                            AWSDDLogError(@"Failed to serialize the body JSON. %@", responseSerializationError);
+                        }
+                    }
+                    JSONObject = models;
+                }
             }
+            return JSONObject;
         }
         return nil;
     }];
+}
+
+// Sends the request once `task` completes, answering it from `responseCache` when possible. The serialization and
+// the mapping of responses run on `serializationExecutor` rather than on the delegate queue of the session, which
+// every client shares.
+- (AWSTask<AWSAPIGatewayResponse *> *)sendRequest:(NSMutableURLRequest *)request
+                                        afterTask:(AWSTask *)task {
+    AWSAPIGatewayResponseCache *responseCache = self.responseCache;
+    if (!responseCache) {
+        return [task continueWithSuccessBlock:^id(AWSTask *task) {
+            return [self signAndSendRequest:request];
+        }];
+    }
+
+    // The response cache replaces the URL cache of the session.
+    request.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+
+    // The cache looks up and stores responses with the request as it is before validators are added and it is signed,
+    // so that the headers named by `Vary` are compared on the same request both times.
+    __block AWSCredentials *credentials = nil;
+    __block NSURLRequest *cacheRequest = nil;
+    return [[task continueWithSuccessBlock:^id(AWSTask *task) {
+        return [self credentialsForSigning];
+    }] continueWithSuccessBlock:^id(AWSTask<AWSCredentials *> *task) {
+        credentials = task.result;
+        cacheRequest = [request copy];
+        AWSAPIGatewayResponse *cachedResponse = [responseCache cachedResponseForRequest:request
+                                                                            credentials:credentials];
+        if (cachedResponse) {
+            return cachedResponse;
+        }
+
+        return [[self signAndSendRequest:request] continueWithExecutor:[AWSAPIGatewayClient serializationExecutor] withSuccessBlock:^id(AWSTask<AWSAPIGatewayResponse *> *task) {
+            AWSAPIGatewayResponse *response = task.result;
+            if (![response.rawResponse isKindOfClass:[NSHTTPURLResponse class]]) {
+                return response;
+            }
+            AWSAPIGatewayResponse *cachedResponse = [responseCache responseForRequest:cacheRequest
+                                                                          credentials:credentials
+                                                                         HTTPResponse:(NSHTTPURLResponse *)response.rawResponse
+                                                                                 data:response.responseData];
+            if (cachedResponse) {
+                return cachedResponse;
+            }
+
+            // The response the validators were sent for has been removed from the cache since, so the `304 Not
+            // Modified` cannot be answered. Sends the request again without them.
+            AWSDDLogDebug(@"Resending %@ without validators.", cacheRequest.URL);
+            return [[self signAndSendRequest:[cacheRequest mutableCopy]] continueWithExecutor:[AWSAPIGatewayClient serializationExecutor] withSuccessBlock:^id(AWSTask<AWSAPIGatewayResponse *> *task) {
+                AWSAPIGatewayResponse *response = task.result;
+                if (![response.rawResponse isKindOfClass:[NSHTTPURLResponse class]]) {
+                    return response;
+                }
+                return [responseCache responseForRequest:cacheRequest
+                                             credentials:credentials
+                                            HTTPResponse:(NSHTTPURLResponse *)response.rawResponse
+                                                    data:response.responseData] ?: response;
+            }];
+        }];
+    }];
+}
+
+// Returns the credentials of the signer, refreshing them if necessary, or `nil` when requests are not signed.
+- (AWSTask<AWSCredentials *> *)credentialsForSigning {
+    id signer = [self.configuration.requestInterceptors lastObject];
+    if (signer) {
+        if ([signer respondsToSelector:@selector(credentialsProvider)]) {
+            id<AWSCredentialsProvider> credentialsProvider = [signer performSelector:@selector(credentialsProvider)];
+            return [credentialsProvider credentials];
+        }
+    }
+    return [AWSTask taskWithResult:nil];
+}
+
+- (AWSTask<AWSAPIGatewayResponse *> *)signAndSendRequest:(NSMutableURLRequest *)request {
+    // Refreshes credentials if necessary
+    AWSTask *signingTask = [self credentialsForSigning];
 
     // Signs the request
     for (id<AWSNetworkingRequestInterceptor> interceptor in self.configuration.requestInterceptors) {
-        task = [task continueWithSuccessBlock:^id(AWSTask *task) {
+        signingTask = [signingTask continueWithSuccessBlock:^id(AWSTask *task) {
             return [interceptor interceptRequest:request];
         }];
     }
 
-    return [task continueWithSuccessBlock:^id(AWSTask *task) {
+    return [signingTask continueWithSuccessBlock:^id(AWSTask *task) {
         AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource new];
 
         void (^completionHandler)(NSData *data, NSURLResponse *response, NSError *error) = ^(NSData *data, NSURLResponse *response, NSError *error) {
@@ -267,84 +385,13 @@ static int defaultChunkSize = 1024;
                 return;
             }
 
-            // Serializes the HTTP body
-            id JSONObject = nil;
-            if (data && [data length] > 0) {
-                JSONObject = [NSJSONSerialization JSONObjectWithData:data
-                                                             options:NSJSONReadingAllowFragments
-                                                               error:&error];
-                if (!JSONObject) {
-                    NSString *bodyString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
-                    if ([bodyString length] > 0) {
-                        AWSDDLogError(@"The body is not in JSON format. Body: %@\nError: %@", bodyString, error);
-                    }
-                    [completionSource setError:error];
-                    return;
-                }
-            }
-
-            // Handles developer defined errors
             NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
-
-            NSDictionary *HTTPHeaderFields = HTTPResponse.allHeaderFields;
-            NSInteger HTTPStatusCode = HTTPResponse.statusCode;
-            if (HTTPStatusCode/100 == 4 || HTTPStatusCode/100 == 5) {
-                NSMutableDictionary *userInfo = [NSMutableDictionary new];
-                if (JSONObject) {
-                    userInfo[AWSAPIGatewayErrorHTTPBodyKey] = JSONObject;
-                }
-                if (HTTPHeaderFields) {
-                    userInfo[AWSAPIGatewayErrorHTTPHeaderFieldsKey] = HTTPHeaderFields;
-                }
-
-                if (HTTPStatusCode/100 == 4) {
-                    NSError *clientError = [NSError errorWithDomain:AWSAPIGatewayErrorDomain
-                                                               code:AWSAPIGatewayErrorTypeClient
-                                                           userInfo:userInfo];
-                    [completionSource setError:clientError];
-                }
-                if (HTTPStatusCode/100 == 5) {
-                    NSError *clientError = [NSError errorWithDomain:AWSAPIGatewayErrorDomain
-                                                               code:AWSAPIGatewayErrorTypeService
-                                                           userInfo:userInfo];
-                    [completionSource setError:clientError];
-                }
-                return;
-            }
-
-            // Maps a serialized JSON object to an Objective-C object
-            if (JSONObject) {
-                if (responseClass
-                    && responseClass != [NSDictionary class]) {
-                    if ([JSONObject isKindOfClass:[NSDictionary class]]) {
-                        NSError *responseSerializationError = nil;
-                        JSONObject = [AWSMTLJSONAdapter modelOfClass:responseClass
-                                                  fromJSONDictionary:JSONObject
-                                                               error:&responseSerializationError];
-                        if (!JSONObject) {
-                            AWSDDLogError(@"Failed to serialize the body JSON. %@", responseSerializationError);
-                        }
-                    }
-                    if ([JSONObject isKindOfClass:[NSArray class]]) {
-                        NSError *responseSerializationError = nil;
-                        NSMutableArray *models = [NSMutableArray new];
-                        for (id object in JSONObject) {
-                            id model = [AWSMTLJSONAdapter modelOfClass:responseClass
-                                                    fromJSONDictionary:object
-                                                                 error:&responseSerializationError];
-                            [models addObject:model];
-                            if (!JSONObject) {
-                                AWSDDLogError(@"Failed to serialize the body JSON. %@", responseSerializationError);
-                            }
-                        }
-                        JSONObject = models;
-                    }
-                }
-                [completionSource setResult:JSONObject];
-            } else {
-                [completionSource setResult:nil];
-            }
+            [completionSource setResult:[[AWSAPIGatewayResponse alloc] initWithHeaders:HTTPResponse.allHeaderFields
+                                                                          responseData:data
+                                                                   NSURLResponseObject:response
+                                                                            statusCode:HTTPResponse.statusCode]];
         };
+        AWSDDLogVerbose(@"%@",request);
         NSURLSessionDataTask *sessionTask = [self.session dataTaskWithRequest:request
                                                             completionHandler:completionHandler];
         [sessionTask resume];
@@ -359,18 +406,22 @@ static int defaultChunkSize = 1024;
     // Constructs the URL path components
     if (URLPathComponentsDictionary) {
         for (NSString *key in URLPathComponentsDictionary) {
+            NSMutableString *pathComponent = [NSMutableString new];
+            [AWSNetworkingHelpers appendQueryStringValue:URLPathComponentsDictionary[key] toQueryString:pathComponent];
             [mutableURLString replaceOccurrencesOfString:[NSString stringWithFormat:@"{%@}", key]
-                                              withString:[self encodeQueryStringValue:URLPathComponentsDictionary[key]]
+                                              withString:pathComponent
                                                  options:NSLiteralSearch
                                                    range:NSMakeRange(0, [mutableURLString length])];
         }
     }
 
     // Adds query string
-    NSMutableString *queryString = [NSMutableString new];
-    [self processParameters:query queryString:queryString];
-    if ([queryString length] > 0) {
-        [mutableURLString appendFormat:@"?%@", queryString];
+    if ([query count] > 0) {
+        NSMutableString *queryString = [NSMutableString new];
+        [AWSNetworkingHelpers appendQueryStringFromParameters:query toQueryString:queryString];
+        if ([queryString length] > 0) {
+            [mutableURLString appendFormat:@"?%@", queryString];
+        }
     }
 
     NSString *urlString = [NSString stringWithFormat:@"%@%@", self.configuration.baseURL, mutableURLString];
@@ -378,54 +429,4 @@ static int defaultChunkSize = 1024;
     return [NSURL URLWithString:urlString];
 }
 
-// TODO: merge it with - (void)processParameters:(NSDictionary *)parameters queryString:(NSMutableString *)queryString in AWSURLRequestSerialization.m
-- (void)processParameters:(NSDictionary *)parameters queryString:(NSMutableString *)queryString {
-    for (NSString *key in parameters) {
-        id obj = parameters[key];
-
-        if ([obj isKindOfClass:[NSDictionary class]]) {
-            [self processParameters:obj queryString:queryString];
-        } else {
-            if ([queryString length] > 0) {
-                [queryString appendString:@"&"];
-            }
-
-            [queryString appendString:[self generateQueryStringWithKey:key value:obj]];
-        }
-    }
-}
-
-- (NSString *)generateQueryStringWithKey:(NSString *)key value:(id)value {
-    NSMutableString *queryString = [NSMutableString new];
-    [queryString appendString:[key aws_stringWithURLEncoding]];
-    [queryString appendString:@"="];
-    [queryString appendString:[self encodeQueryStringValue:value]];
-
-    return queryString;
-}
-
-- (NSString *)encodeQueryStringValue:(id)value {
-    if ([value isKindOfClass:[NSString class]]) {
-        return [value aws_stringWithURLEncoding];
-    }
-
-    if ([value isKindOfClass:[NSNumber class]]) {
-        return [[value stringValue] aws_stringWithURLEncoding];
-    }
-
-    if ([value isKindOfClass:[NSArray class]]) {
-        NSMutableString *mutableString = [NSMutableString new];
-        for (id obj in value) {
-            if ([mutableString length] > 0) {
-                [mutableString appendString:@","];
-            }
-            [mutableString appendString:[self encodeQueryStringValue:obj]];
-        }
-        return mutableString;
-    }
-    
-    AWSDDLogError(@"value[%@] is invalid.", value);
-    return [[value description] aws_stringWithURLEncoding];
-}
-
 @end
@@ -0,0 +1,114 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The default value of `memoryCapacity`, 1MB.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSAPIGatewayResponseCacheDefaultMemoryCapacity;
+
+/**
+ The default value of `diskCapacity`, 10MB.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSAPIGatewayResponseCacheDefaultDiskCapacity;
+
+/**
+ A cache of the responses to `GET` requests made by `AWSAPIGatewayClient`.
+
+ Set it as the `responseCache` of a client to turn it on. Responses are cached as the `Cache-Control`, `Expires`, `ETag`
+ and `Last-Modified` headers of the API allow, the way a private HTTP cache does. A fresh response is returned without
+ a request. A stale response with an `ETag` or a `Last-Modified` header is revalidated with `If-None-Match` or
+ `If-Modified-Since`, and returned again when the API answers `304 Not Modified`. A successful `PUT`, `POST`, `PATCH`
+ or `DELETE` request removes the cached response of its URL.
+
+ Responses are cached per identity: a response is only returned to requests signed with the same access key and sent
+ with the same `Authorization` header as the request it answered.
+
+ Responses are kept in memory up to `memoryCapacity` bytes, and in a directory up to `diskCapacity` bytes. When either
+ store is full, the least recently used responses are removed from it. Caches that use the same directory share the
+ responses kept in it, which are kept up to the smallest of their disk capacities.
+ */
+@interface AWSAPIGatewayResponseCache : NSObject
+
+/**
+ The maximum total size of the responses kept in memory, in bytes.
+ */
+@property (nonatomic, assign, readonly) NSUInteger memoryCapacity;
+
+/**
+ The maximum total size of the responses kept on disk, in bytes.
+ */
+@property (nonatomic, assign, readonly) NSUInteger diskCapacity;
+
+/**
+ The directory of the responses kept on disk, or `nil` when responses are only kept in memory.
+ */
+@property (nonatomic, strong, readonly, nullable) NSString *directoryPath;
+
+/**
+ The number of requests answered by a fresh cached response, without a request.
+ */
+@property (atomic, assign, readonly) NSUInteger hitCount;
+
+/**
+ The number of requests answered by a cached response after the API answered `304 Not Modified`.
+ */
+@property (atomic, assign, readonly) NSUInteger revalidationCount;
+
+/**
+ The number of requests sent to the API because no fresh response was cached, including the requests that revalidated a cached response.
+ */
+@property (atomic, assign, readonly) NSUInteger missCount;
+
+/**
+ The total size of the responses kept in memory, in bytes.
+ */
+@property (atomic, assign, readonly) NSUInteger currentMemoryUsage;
+
+/**
+ The total size of the responses kept on disk, in bytes.
+ */
+@property (atomic, assign, readonly) NSUInteger currentDiskUsage;
+
+/**
+ Creates a cache of `AWSAPIGatewayResponseCacheDefaultMemoryCapacity` and `AWSAPIGatewayResponseCacheDefaultDiskCapacity`
+ in the caches directory of the app.
+ */
+- (instancetype)init;
+
+/**
+ Creates a cache.
+
+ @param memoryCapacity The maximum total size of the responses kept in memory, in bytes.
+ @param diskCapacity   The maximum total size of the responses kept on disk, in bytes.
+ @param directoryPath  The directory of the responses kept on disk. It is created if it does not exist. When `nil`, responses are only kept in memory.
+
+ @return A cache.
+ */
+- (instancetype)initWithMemoryCapacity:(NSUInteger)memoryCapacity
+                          diskCapacity:(NSUInteger)diskCapacity
+                         directoryPath:(nullable NSString *)directoryPath NS_DESIGNATED_INITIALIZER;
+
+/**
+ Removes all of the cached responses from memory and disk. The counters are not reset.
+ */
+- (void)removeAllCachedResponses;
+
+@end
+
+NS_ASSUME_NONNULL_END
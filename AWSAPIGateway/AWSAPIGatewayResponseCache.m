@@ -0,0 +1,685 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSAPIGatewayResponseCache.h"
+#import <AWSCore/AWSCore.h>
+#import <CommonCrypto/CommonCrypto.h>
+#import "AWSAPIGatewayModel.h"
+
+NSUInteger const AWSAPIGatewayResponseCacheDefaultMemoryCapacity = 1024 * 1024;
+NSUInteger const AWSAPIGatewayResponseCacheDefaultDiskCapacity = 10 * 1024 * 1024;
+
+static NSString *const AWSAPIGatewayResponseCacheDirectoryName = @"com.amazonaws.AWSAPIGatewayResponseCache";
+
+static NSString *const AWSAPIGatewayCachedResponseURLKey = @"URL";
+static NSString *const AWSAPIGatewayCachedResponseStatusCodeKey = @"StatusCode";
+static NSString *const AWSAPIGatewayCachedResponseHeadersKey = @"Headers";
+static NSString *const AWSAPIGatewayCachedResponseDataKey = @"Data";
+static NSString *const AWSAPIGatewayCachedResponseVaryingHeadersKey = @"VaryingHeaders";
+static NSString *const AWSAPIGatewayCachedResponseResponseTimeKey = @"ResponseTime";
+static NSString *const AWSAPIGatewayCachedResponseInitialAgeKey = @"InitialAge";
+static NSString *const AWSAPIGatewayCachedResponseFreshnessLifetimeKey = @"FreshnessLifetime";
+
+@interface AWSAPIGatewayResponse()
+
+- (instancetype)initWithHeaders:(NSDictionary *)headers
+                   responseData:(NSData *)responseData
+            NSURLResponseObject:(NSURLResponse *)NSURLResponseObject
+                     statusCode:(NSInteger)statusCode;
+
+@end
+
+#pragma mark - AWSAPIGatewayCachedResponse
+
+@interface AWSAPIGatewayCachedResponse : NSObject
+
+@property (nonatomic, strong) NSString *key;
+@property (nonatomic, strong) NSURL *URL;
+@property (nonatomic, assign) NSInteger statusCode;
+@property (nonatomic, strong) NSDictionary<NSString *, NSString *> *headers;
+@property (nonatomic, strong) NSData *data;
+// The values of the request headers named by the `Vary` header of the response.
+@property (nonatomic, strong) NSDictionary<NSString *, NSString *> *varyingHeaders;
+@property (nonatomic, assign) NSTimeInterval responseTime;
+@property (nonatomic, assign) NSTimeInterval initialAge;
+@property (nonatomic, assign) NSTimeInterval freshnessLifetime;
+
+@property (nonatomic, assign, readonly) NSUInteger cost;
+
+@end
+
+@implementation AWSAPIGatewayCachedResponse
+
++ (instancetype)cachedResponseWithPropertyList:(NSDictionary *)propertyList
+                                           key:(NSString *)key {
+    AWSAPIGatewayCachedResponse *cachedResponse = [AWSAPIGatewayCachedResponse new];
+    cachedResponse.key = key;
+    cachedResponse.URL = [NSURL URLWithString:propertyList[AWSAPIGatewayCachedResponseURLKey]];
+    cachedResponse.statusCode = [propertyList[AWSAPIGatewayCachedResponseStatusCodeKey] integerValue];
+    cachedResponse.headers = propertyList[AWSAPIGatewayCachedResponseHeadersKey];
+    cachedResponse.data = propertyList[AWSAPIGatewayCachedResponseDataKey];
+    cachedResponse.varyingHeaders = propertyList[AWSAPIGatewayCachedResponseVaryingHeadersKey];
+    cachedResponse.responseTime = [propertyList[AWSAPIGatewayCachedResponseResponseTimeKey] doubleValue];
+    cachedResponse.initialAge = [propertyList[AWSAPIGatewayCachedResponseInitialAgeKey] doubleValue];
+    cachedResponse.freshnessLifetime = [propertyList[AWSAPIGatewayCachedResponseFreshnessLifetimeKey] doubleValue];
+    if (!cachedResponse.URL
+        || ![cachedResponse.headers isKindOfClass:[NSDictionary class]]
+        || ![cachedResponse.data isKindOfClass:[NSData class]]
+        || ![cachedResponse.varyingHeaders isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    return cachedResponse;
+}
+
+- (NSDictionary *)propertyList {
+    return @{AWSAPIGatewayCachedResponseURLKey : [self.URL absoluteString],
+             AWSAPIGatewayCachedResponseStatusCodeKey : @(self.statusCode),
+             AWSAPIGatewayCachedResponseHeadersKey : self.headers,
+             AWSAPIGatewayCachedResponseDataKey : self.data,
+             AWSAPIGatewayCachedResponseVaryingHeadersKey : self.varyingHeaders,
+             AWSAPIGatewayCachedResponseResponseTimeKey : @(self.responseTime),
+             AWSAPIGatewayCachedResponseInitialAgeKey : @(self.initialAge),
+             AWSAPIGatewayCachedResponseFreshnessLifetimeKey : @(self.freshnessLifetime)};
+}
+
+- (NSUInteger)cost {
+    NSUInteger cost = [self.data length];
+    for (NSString *name in self.headers) {
+        cost += [name length] + [self.headers[name] length];
+    }
+    return cost;
+}
+
+- (BOOL)isFresh {
+    NSTimeInterval age = self.initialAge + ([NSDate timeIntervalSinceReferenceDate] - self.responseTime);
+    return age < self.freshnessLifetime;
+}
+
+- (AWSAPIGatewayResponse *)response {
+    NSHTTPURLResponse *HTTPResponse = [[NSHTTPURLResponse alloc] initWithURL:self.URL
+                                                                  statusCode:self.statusCode
+                                                                 HTTPVersion:@"HTTP/1.1"
+                                                                headerFields:self.headers];
+    return [[AWSAPIGatewayResponse alloc] initWithHeaders:HTTPResponse.allHeaderFields
+                                             responseData:self.data
+                                      NSURLResponseObject:HTTPResponse
+                                               statusCode:self.statusCode];
+}
+
+@end
+
+#pragma mark - AWSAPIGatewayResponseDiskStore
+
+// The responses kept in a directory. Every cache that uses the same directory shares one store, so that they evict from
+// one index and keep the directory within the smallest of their disk capacities.
+@interface AWSAPIGatewayResponseDiskStore : NSObject
+
+@property (nonatomic, strong, readonly) NSString *directoryPath;
+
+// The store is only accessed on `queue`. `keys` is ordered from the least to the most recently used file name.
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, assign) NSUInteger capacity;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *sizes;
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *keys;
+@property (nonatomic, assign) NSUInteger usage;
+
+@end
+
+@implementation AWSAPIGatewayResponseDiskStore
+
++ (instancetype)diskStoreWithDirectoryPath:(NSString *)directoryPath
+                                  capacity:(NSUInteger)capacity {
+    static NSMapTable<NSString *, AWSAPIGatewayResponseDiskStore *> *diskStores = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        diskStores = [NSMapTable strongToWeakObjectsMapTable];
+    });
+
+    NSString *standardizedPath = [directoryPath stringByStandardizingPath];
+    @synchronized(diskStores) {
+        AWSAPIGatewayResponseDiskStore *diskStore = [diskStores objectForKey:standardizedPath];
+        if (diskStore) {
+            dispatch_async(diskStore.queue, ^{
+                diskStore.capacity = MIN(diskStore.capacity, capacity);
+                [diskStore evictToCapacity];
+            });
+            return diskStore;
+        }
+
+        diskStore = [[AWSAPIGatewayResponseDiskStore alloc] initWithDirectoryPath:standardizedPath
+                                                                          capacity:capacity];
+        [diskStores setObject:diskStore forKey:standardizedPath];
+        return diskStore;
+    }
+}
+
+- (instancetype)initWithDirectoryPath:(NSString *)directoryPath
+                             capacity:(NSUInteger)capacity {
+    if (self = [super init]) {
+        _directoryPath = directoryPath;
+        _capacity = capacity;
+        _queue = dispatch_queue_create("com.amazonaws.AWSAPIGatewayResponseCache.disk", DISPATCH_QUEUE_SERIAL);
+        _sizes = [NSMutableDictionary new];
+        _keys = [NSMutableOrderedSet new];
+
+        dispatch_async(_queue, ^{
+            [self loadIndex];
+        });
+    }
+    return self;
+}
+
+- (NSUInteger)currentUsage {
+    __block NSUInteger usage = 0;
+    dispatch_sync(self.queue, ^{
+        usage = self.usage;
+    });
+    return usage;
+}
+
+- (AWSAPIGatewayCachedResponse *)cachedResponseForKey:(NSString *)key {
+    __block AWSAPIGatewayCachedResponse *cachedResponse = nil;
+    NSString *fileName = [self fileNameForKey:key];
+    dispatch_sync(self.queue, ^{
+        if (!self.sizes[fileName]) {
+            return;
+        }
+        NSData *fileData = [NSData dataWithContentsOfFile:[self pathForFileName:fileName]];
+        NSDictionary *propertyList = fileData ? [NSPropertyListSerialization propertyListWithData:fileData
+                                                                                          options:NSPropertyListImmutable
+                                                                                           format:NULL
+                                                                                            error:nil] : nil;
+        if ([propertyList isKindOfClass:[NSDictionary class]]) {
+            cachedResponse = [AWSAPIGatewayCachedResponse cachedResponseWithPropertyList:propertyList key:key];
+        }
+        if (cachedResponse) {
+            [self.keys removeObject:fileName];
+            [self.keys addObject:fileName];
+            [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate : [NSDate date]}
+                                             ofItemAtPath:[self pathForFileName:fileName]
+                                                    error:nil];
+        } else {
+            [self removeFileName:fileName];
+        }
+    });
+    return cachedResponse;
+}
+
+- (void)storeCachedResponse:(AWSAPIGatewayCachedResponse *)cachedResponse {
+    NSData *fileData = [NSPropertyListSerialization dataWithPropertyList:[cachedResponse propertyList]
+                                                                  format:NSPropertyListBinaryFormat_v1_0
+                                                                 options:0
+                                                                   error:nil];
+    NSString *fileName = [self fileNameForKey:cachedResponse.key];
+    dispatch_async(self.queue, ^{
+        [self removeFileName:fileName];
+        if (!fileData || [fileData length] > self.capacity) {
+            return;
+        }
+        if (![fileData writeToFile:[self pathForFileName:fileName] atomically:YES]) {
+            AWSDDLogError(@"Failed to write a cached response to %@.", self.directoryPath);
+            return;
+        }
+        self.sizes[fileName] = @([fileData length]);
+        [self.keys addObject:fileName];
+        self.usage += [fileData length];
+        [self evictToCapacity];
+    });
+}
+
+- (void)removeCachedResponseForKey:(NSString *)key {
+    NSString *fileName = [self fileNameForKey:key];
+    dispatch_async(self.queue, ^{
+        [self removeFileName:fileName];
+    });
+}
+
+- (void)removeAllCachedResponses {
+    dispatch_sync(self.queue, ^{
+        for (NSString *fileName in self.keys) {
+            [[NSFileManager defaultManager] removeItemAtPath:[self pathForFileName:fileName] error:nil];
+        }
+        [self.sizes removeAllObjects];
+        [self.keys removeAllObjects];
+        self.usage = 0;
+    });
+}
+
+// Must be called on `queue`.
+- (void)removeFileName:(NSString *)fileName {
+    NSNumber *size = self.sizes[fileName];
+    if (size) {
+        [self.sizes removeObjectForKey:fileName];
+        [self.keys removeObject:fileName];
+        self.usage -= [size unsignedIntegerValue];
+        [[NSFileManager defaultManager] removeItemAtPath:[self pathForFileName:fileName] error:nil];
+    }
+}
+
+// Must be called on `queue`.
+- (void)evictToCapacity {
+    while (self.usage > self.capacity && [self.keys count] > 0) {
+        [self removeFileName:[self.keys firstObject]];
+    }
+}
+
+// Must be called on `queue`. Orders the files of a previous launch by their modification date, which is updated on every use.
+- (void)loadIndex {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSError *error = nil;
+    if (![fileManager createDirectoryAtPath:self.directoryPath
+                withIntermediateDirectories:YES
+                                 attributes:nil
+                                      error:&error]) {
+        AWSDDLogError(@"Failed to create the response cache directory %@. %@", self.directoryPath, error);
+        return;
+    }
+
+    NSURL *directoryURL = [NSURL fileURLWithPath:self.directoryPath isDirectory:YES];
+    NSArray<NSURL *> *fileURLs = [fileManager contentsOfDirectoryAtURL:directoryURL
+                                            includingPropertiesForKeys:@[NSURLFileSizeKey, NSURLContentModificationDateKey]
+                                                               options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                 error:nil];
+    NSMutableDictionary<NSString *, NSDate *> *modificationDates = [NSMutableDictionary new];
+    for (NSURL *fileURL in fileURLs) {
+        NSNumber *size = nil;
+        NSDate *modificationDate = nil;
+        [fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+        [fileURL getResourceValue:&modificationDate forKey:NSURLContentModificationDateKey error:nil];
+        NSString *fileName = [fileURL lastPathComponent];
+        self.sizes[fileName] = size ?: @0;
+        modificationDates[fileName] = modificationDate ?: [NSDate distantPast];
+        self.usage += [size unsignedIntegerValue];
+    }
+    [self.keys addObjectsFromArray:[modificationDates keysSortedByValueUsingSelector:@selector(compare:)]];
+    [self evictToCapacity];
+}
+
+- (NSString *)fileNameForKey:(NSString *)key {
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256([keyData bytes], (CC_LONG)[keyData length], digest);
+
+    NSMutableString *fileName = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [fileName appendFormat:@"%02x", digest[i]];
+    }
+    return fileName;
+}
+
+- (NSString *)pathForFileName:(NSString *)fileName {
+    return [self.directoryPath stringByAppendingPathComponent:fileName];
+}
+
+@end
+
+#pragma mark - AWSAPIGatewayResponseCache
+
+@interface AWSAPIGatewayResponseCache()
+
+@property (atomic, assign, readwrite) NSUInteger hitCount;
+@property (atomic, assign, readwrite) NSUInteger revalidationCount;
+@property (atomic, assign, readwrite) NSUInteger missCount;
+
+// The memory store is guarded by @synchronized(self). `memoryKeys` is ordered from the least to the most recently used key.
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSAPIGatewayCachedResponse *> *memoryResponses;
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *memoryKeys;
+@property (nonatomic, assign) NSUInteger memoryUsage;
+
+// The disk store of `directoryPath`, shared with the other caches of the same directory.
+@property (nonatomic, strong) AWSAPIGatewayResponseDiskStore *diskStore;
+
+@end
+
+@implementation AWSAPIGatewayResponseCache
+
+- (instancetype)init {
+    NSString *cachesDirectoryPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    return [self initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                           diskCapacity:AWSAPIGatewayResponseCacheDefaultDiskCapacity
+                          directoryPath:[cachesDirectoryPath stringByAppendingPathComponent:AWSAPIGatewayResponseCacheDirectoryName]];
+}
+
+- (instancetype)initWithMemoryCapacity:(NSUInteger)memoryCapacity
+                          diskCapacity:(NSUInteger)diskCapacity
+                         directoryPath:(NSString *)directoryPath {
+    if (self = [super init]) {
+        _memoryCapacity = memoryCapacity;
+        _diskCapacity = diskCapacity;
+        _directoryPath = directoryPath;
+        _memoryResponses = [NSMutableDictionary new];
+        _memoryKeys = [NSMutableOrderedSet new];
+
+        if (_directoryPath) {
+            _diskStore = [AWSAPIGatewayResponseDiskStore diskStoreWithDirectoryPath:_directoryPath
+                                                                           capacity:_diskCapacity];
+        }
+    }
+    return self;
+}
+
+- (NSUInteger)currentMemoryUsage {
+    @synchronized(self) {
+        return self.memoryUsage;
+    }
+}
+
+- (NSUInteger)currentDiskUsage {
+    return [self.diskStore currentUsage];
+}
+
+- (void)removeAllCachedResponses {
+    @synchronized(self) {
+        [self.memoryResponses removeAllObjects];
+        [self.memoryKeys removeAllObjects];
+        self.memoryUsage = 0;
+    }
+    [self.diskStore removeAllCachedResponses];
+}
+
+#pragma mark - Client
+
+- (AWSAPIGatewayResponse *)cachedResponseForRequest:(NSMutableURLRequest *)request
+                                        credentials:(AWSCredentials *)credentials {
+    if (![request.HTTPMethod isEqualToString:@"GET"]) {
+        return nil;
+    }
+
+    AWSAPIGatewayCachedResponse *cachedResponse = [self cachedResponseForKey:[self keyForRequest:request credentials:credentials]];
+    if (cachedResponse && ![self request:request matchesVaryingHeadersOfCachedResponse:cachedResponse]) {
+        cachedResponse = nil;
+    }
+
+    NSDictionary<NSString *, NSString *> *requestDirectives = [[self class] cacheControlDirectivesOfHeaderValue:[request valueForHTTPHeaderField:@"Cache-Control"]];
+    if (cachedResponse
+        && [cachedResponse isFresh]
+        && !requestDirectives[@"no-cache"]) {
+        @synchronized(self) {
+            self.hitCount++;
+        }
+        return [cachedResponse response];
+    }
+
+    @synchronized(self) {
+        self.missCount++;
+    }
+    if (cachedResponse) {
+        NSString *ETag = [[self class] valueOfHeader:@"ETag" inHeaders:cachedResponse.headers];
+        NSString *lastModified = [[self class] valueOfHeader:@"Last-Modified" inHeaders:cachedResponse.headers];
+        if (ETag && ![request valueForHTTPHeaderField:@"If-None-Match"]) {
+            [request setValue:ETag forHTTPHeaderField:@"If-None-Match"];
+        }
+        if (lastModified && ![request valueForHTTPHeaderField:@"If-Modified-Since"]) {
+            [request setValue:lastModified forHTTPHeaderField:@"If-Modified-Since"];
+        }
+    }
+
+    return nil;
+}
+
+- (AWSAPIGatewayResponse *)responseForRequest:(NSURLRequest *)request
+                                  credentials:(AWSCredentials *)credentials
+                                 HTTPResponse:(NSHTTPURLResponse *)HTTPResponse
+                                         data:(NSData *)data {
+    AWSAPIGatewayResponse *response = [[AWSAPIGatewayResponse alloc] initWithHeaders:HTTPResponse.allHeaderFields
+                                                                        responseData:data
+                                                                 NSURLResponseObject:HTTPResponse
+                                                                          statusCode:HTTPResponse.statusCode];
+    NSString *key = [self keyForRequest:request credentials:credentials];
+
+    if (![request.HTTPMethod isEqualToString:@"GET"]) {
+        // A successful unsafe request invalidates the cached response of its URL.
+        if (![request.HTTPMethod isEqualToString:@"HEAD"]
+            && HTTPResponse.statusCode >= 200
+            && HTTPResponse.statusCode < 400) {
+            [self removeCachedResponseForKey:key];
+        }
+        return response;
+    }
+
+    if (HTTPResponse.statusCode == 304) {
+        AWSAPIGatewayCachedResponse *cachedResponse = [self cachedResponseForKey:key];
+        if (!cachedResponse) {
+            // The 304 answers validators of the caller, or of a response removed from the cache since they were sent.
+            if ([request valueForHTTPHeaderField:@"If-None-Match"] || [request valueForHTTPHeaderField:@"If-Modified-Since"]) {
+                return response;
+            }
+            return nil;
+        }
+
+        // Updates the cached response with the headers of the 304 response.
+        NSMutableDictionary<NSString *, NSString *> *headers = [cachedResponse.headers mutableCopy];
+        for (NSString *name in HTTPResponse.allHeaderFields) {
+            for (NSString *cachedName in [headers allKeys]) {
+                if ([cachedName caseInsensitiveCompare:name] == NSOrderedSame) {
+                    [headers removeObjectForKey:cachedName];
+                }
+            }
+            headers[name] = HTTPResponse.allHeaderFields[name];
+        }
+        AWSAPIGatewayCachedResponse *updatedResponse = [self cachedResponseWithRequest:request
+                                                                                   key:key
+                                                                            statusCode:cachedResponse.statusCode
+                                                                               headers:headers
+                                                                                  data:cachedResponse.data];
+        if (updatedResponse) {
+            [self storeCachedResponse:updatedResponse];
+        } else {
+            [self removeCachedResponseForKey:key];
+        }
+        @synchronized(self) {
+            self.revalidationCount++;
+        }
+        return [(updatedResponse ?: cachedResponse) response];
+    }
+
+    if (HTTPResponse.statusCode == 200) {
+        AWSAPIGatewayCachedResponse *cachedResponse = [self cachedResponseWithRequest:request
+                                                                                  key:key
+                                                                           statusCode:HTTPResponse.statusCode
+                                                                              headers:HTTPResponse.allHeaderFields
+                                                                                 data:data ?: [NSData data]];
+        if (cachedResponse) {
+            [self storeCachedResponse:cachedResponse];
+        } else {
+            [self removeCachedResponseForKey:key];
+        }
+    }
+
+    return response;
+}
+
+#pragma mark - HTTP caching
+
+// Responses are cached per identity as well as per URL: the access key of the credentials the request is signed with,
+// and the `Authorization` header of the caller. One identity is never answered with the response to another.
+- (NSString *)keyForRequest:(NSURLRequest *)request
+                credentials:(AWSCredentials *)credentials {
+    return [NSString stringWithFormat:@"%@\n%@\n%@",
+            [request.URL absoluteString],
+            credentials.accessKey ?: @"",
+            [request valueForHTTPHeaderField:@"Authorization"] ?: @""];
+}
+
+// Returns the response to cache, or `nil` if the response may not be cached.
+- (AWSAPIGatewayCachedResponse *)cachedResponseWithRequest:(NSURLRequest *)request
+                                                       key:(NSString *)key
+                                                statusCode:(NSInteger)statusCode
+                                                   headers:(NSDictionary<NSString *, NSString *> *)headers
+                                                      data:(NSData *)data {
+    Class cacheClass = [self class];
+    NSDictionary<NSString *, NSString *> *requestDirectives = [cacheClass cacheControlDirectivesOfHeaderValue:[request valueForHTTPHeaderField:@"Cache-Control"]];
+    NSDictionary<NSString *, NSString *> *responseDirectives = [cacheClass cacheControlDirectivesOfHeaderValue:[cacheClass valueOfHeader:@"Cache-Control" inHeaders:headers]];
+    if (requestDirectives[@"no-store"] || responseDirectives[@"no-store"]) {
+        return nil;
+    }
+
+    NSMutableDictionary<NSString *, NSString *> *varyingHeaders = [NSMutableDictionary new];
+    NSString *vary = [cacheClass valueOfHeader:@"Vary" inHeaders:headers];
+    for (NSString *component in [vary componentsSeparatedByString:@","]) {
+        NSString *name = [[component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] lowercaseString];
+        if ([name isEqualToString:@"*"]) {
+            return nil;
+        }
+        if ([name length] > 0) {
+            varyingHeaders[name] = [request valueForHTTPHeaderField:name] ?: @"";
+        }
+    }
+
+    NSDate *date = [cacheClass dateOfHeader:@"Date" inHeaders:headers];
+    NSTimeInterval freshnessLifetime = 0;
+    if (responseDirectives[@"no-cache"]) {
+        freshnessLifetime = 0;
+    } else if (responseDirectives[@"max-age"]) {
+        freshnessLifetime = [responseDirectives[@"max-age"] doubleValue];
+    } else {
+        NSDate *expires = [cacheClass dateOfHeader:@"Expires" inHeaders:headers];
+        if (expires) {
+            freshnessLifetime = [expires timeIntervalSinceDate:date ?: [NSDate date]];
+        }
+    }
+
+    BOOL hasValidator = [cacheClass valueOfHeader:@"ETag" inHeaders:headers] || [cacheClass valueOfHeader:@"Last-Modified" inHeaders:headers];
+    if (freshnessLifetime <= 0 && !hasValidator) {
+        return nil;
+    }
+
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    NSTimeInterval initialAge = [[cacheClass valueOfHeader:@"Age" inHeaders:headers] doubleValue];
+    if (date) {
+        initialAge = MAX(initialAge, now - [date timeIntervalSinceReferenceDate]);
+    }
+
+    AWSAPIGatewayCachedResponse *cachedResponse = [AWSAPIGatewayCachedResponse new];
+    cachedResponse.key = key;
+    cachedResponse.URL = request.URL;
+    cachedResponse.statusCode = statusCode;
+    cachedResponse.headers = [headers copy];
+    cachedResponse.data = data;
+    cachedResponse.varyingHeaders = varyingHeaders;
+    cachedResponse.responseTime = now;
+    cachedResponse.initialAge = MAX(initialAge, 0);
+    cachedResponse.freshnessLifetime = MAX(freshnessLifetime, 0);
+    return cachedResponse;
+}
+
+- (BOOL)request:(NSURLRequest *)request matchesVaryingHeadersOfCachedResponse:(AWSAPIGatewayCachedResponse *)cachedResponse {
+    for (NSString *name in cachedResponse.varyingHeaders) {
+        NSString *value = [request valueForHTTPHeaderField:name] ?: @"";
+        if (![value isEqualToString:cachedResponse.varyingHeaders[name]]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+// Maps the directives of a `Cache-Control` header to their values, or to an empty string for directives without a value.
++ (NSDictionary<NSString *, NSString *> *)cacheControlDirectivesOfHeaderValue:(NSString *)headerValue {
+    NSMutableDictionary<NSString *, NSString *> *directives = [NSMutableDictionary new];
+    for (NSString *component in [headerValue componentsSeparatedByString:@","]) {
+        NSString *directive = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        NSRange separatorRange = [directive rangeOfString:@"="];
+        if (separatorRange.location == NSNotFound) {
+            directives[[directive lowercaseString]] = @"";
+        } else {
+            NSString *name = [[directive substringToIndex:separatorRange.location] lowercaseString];
+            NSString *value = [directive substringFromIndex:NSMaxRange(separatorRange)];
+            directives[name] = [value stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"\""]];
+        }
+    }
+    return directives;
+}
+
++ (NSString *)valueOfHeader:(NSString *)name
+                  inHeaders:(NSDictionary<NSString *, NSString *> *)headers {
+    NSString *value = headers[name];
+    if (value) {
+        return value;
+    }
+    for (NSString *headerName in headers) {
+        if ([headerName caseInsensitiveCompare:name] == NSOrderedSame) {
+            return headers[headerName];
+        }
+    }
+    return nil;
+}
+
++ (NSDate *)dateOfHeader:(NSString *)name
+               inHeaders:(NSDictionary<NSString *, NSString *> *)headers {
+    NSString *value = [self valueOfHeader:name inHeaders:headers];
+    if (!value) {
+        return nil;
+    }
+    return [NSDate aws_dateFromString:value format:AWSDateRFC822DateFormat1];
+}
+
+#pragma mark - Stores
+
+- (AWSAPIGatewayCachedResponse *)cachedResponseForKey:(NSString *)key {
+    @synchronized(self) {
+        AWSAPIGatewayCachedResponse *cachedResponse = self.memoryResponses[key];
+        if (cachedResponse) {
+            [self.memoryKeys removeObject:key];
+            [self.memoryKeys addObject:key];
+            return cachedResponse;
+        }
+    }
+
+    AWSAPIGatewayCachedResponse *cachedResponse = [self.diskStore cachedResponseForKey:key];
+    if (cachedResponse) {
+        [self storeCachedResponseInMemory:cachedResponse];
+    }
+    return cachedResponse;
+}
+
+- (void)storeCachedResponse:(AWSAPIGatewayCachedResponse *)cachedResponse {
+    [self storeCachedResponseInMemory:cachedResponse];
+    [self.diskStore storeCachedResponse:cachedResponse];
+}
+
+- (void)storeCachedResponseInMemory:(AWSAPIGatewayCachedResponse *)cachedResponse {
+    @synchronized(self) {
+        [self removeMemoryKey:cachedResponse.key];
+        if (cachedResponse.cost > self.memoryCapacity) {
+            return;
+        }
+        self.memoryResponses[cachedResponse.key] = cachedResponse;
+        [self.memoryKeys addObject:cachedResponse.key];
+        self.memoryUsage += cachedResponse.cost;
+
+        while (self.memoryUsage > self.memoryCapacity && [self.memoryKeys count] > 0) {
+            [self removeMemoryKey:[self.memoryKeys firstObject]];
+        }
+    }
+}
+
+- (void)removeCachedResponseForKey:(NSString *)key {
+    @synchronized(self) {
+        [self removeMemoryKey:key];
+    }
+    [self.diskStore removeCachedResponseForKey:key];
+}
+
+// Must be called in @synchronized(self).
+- (void)removeMemoryKey:(NSString *)key {
+    AWSAPIGatewayCachedResponse *cachedResponse = self.memoryResponses[key];
+    if (cachedResponse) {
+        [self.memoryResponses removeObjectForKey:key];
+        [self.memoryKeys removeObject:key];
+        self.memoryUsage -= cachedResponse.cost;
+    }
+}
+
+@end
@@ -0,0 +1,387 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSAPIGateway.h"
+
+static NSString *const AWSAPIGatewayStubETag = @"\"v1\"";
+
+static NSUInteger AWSAPIGatewayStubRequestCount = 0;
+static NSUInteger AWSAPIGatewayStubBytesTransferred = 0;
+static NSString *AWSAPIGatewayStubLastIfNoneMatch = nil;
+
+@interface AWSAPIGatewayClient()
+
+@property (nonatomic, strong) NSURLSession *session;
+
+- (AWSTask *)invokeHTTPRequest:(NSString *)HTTPMethod
+                     URLString:(NSString *)URLString
+                pathParameters:(NSDictionary *)pathParameters
+               queryParameters:(NSDictionary *)queryParameters
+              headerParameters:(NSDictionary *)headerParameters
+                          body:(id)body
+                 responseClass:(Class)responseClass;
+
+@end
+
+@interface AWSAPIGatewayResponseCache()
+
+- (AWSAPIGatewayResponse *)responseForRequest:(NSURLRequest *)request
+                                  credentials:(AWSCredentials *)credentials
+                                 HTTPResponse:(NSHTTPURLResponse *)HTTPResponse
+                                         data:(NSData *)data;
+
+@end
+
+// Answers like an API whose `/fresh` resources may be cached for a minute, whose `/revalidated` resources must be
+// revalidated on every use, and whose `/uncached` resources must not be stored.
+@interface AWSAPIGatewayStubURLProtocol : NSURLProtocol
+
+@end
+
+@implementation AWSAPIGatewayStubURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    return YES;
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    return request;
+}
+
++ (NSData *)body {
+    static NSData *body = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableArray *items = [NSMutableArray new];
+        for (NSUInteger i = 0; i < 200; i++) {
+            [items addObject:@{@"id" : @(i), @"name" : [NSString stringWithFormat:@"item-%lu", (unsigned long)i]}];
+        }
+        body = [NSJSONSerialization dataWithJSONObject:@{@"items" : items} options:0 error:nil];
+    });
+    return body;
+}
+
+- (void)startLoading {
+    NSString *path = self.request.URL.path;
+    NSString *ifNoneMatch = [self.request valueForHTTPHeaderField:@"If-None-Match"];
+    NSMutableDictionary *headers = [@{@"Content-Type" : @"application/json"} mutableCopy];
+    if ([path hasPrefix:@"/fresh"]) {
+        headers[@"Cache-Control"] = @"max-age=60";
+        headers[@"ETag"] = AWSAPIGatewayStubETag;
+    } else if ([path hasPrefix:@"/revalidated"]) {
+        headers[@"Cache-Control"] = @"no-cache";
+        headers[@"ETag"] = AWSAPIGatewayStubETag;
+    } else {
+        headers[@"Cache-Control"] = @"no-store";
+    }
+
+    NSInteger statusCode = 200;
+    NSData *body = [AWSAPIGatewayStubURLProtocol body];
+    if ([self.request.HTTPMethod isEqualToString:@"GET"] && [ifNoneMatch isEqualToString:AWSAPIGatewayStubETag]) {
+        statusCode = 304;
+        body = [NSData data];
+    }
+    @synchronized([AWSAPIGatewayStubURLProtocol class]) {
+        AWSAPIGatewayStubRequestCount++;
+        AWSAPIGatewayStubBytesTransferred += [body length];
+        AWSAPIGatewayStubLastIfNoneMatch = ifNoneMatch;
+    }
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                              statusCode:statusCode
+                                                             HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:headers];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    [self.client URLProtocol:self didLoadData:body];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading {
+}
+
+@end
+
+@interface AWSAPIGatewayResponseCacheTests : XCTestCase
+
+@property (nonatomic, strong) NSString *directoryPath;
+
+@end
+
+@implementation AWSAPIGatewayResponseCacheTests
+
+- (void)setUp {
+    [super setUp];
+    @synchronized([AWSAPIGatewayStubURLProtocol class]) {
+        AWSAPIGatewayStubRequestCount = 0;
+        AWSAPIGatewayStubBytesTransferred = 0;
+        AWSAPIGatewayStubLastIfNoneMatch = nil;
+    }
+    self.directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.directoryPath error:nil];
+    [super tearDown];
+}
+
+- (AWSAPIGatewayClient *)clientWithResponseCache:(AWSAPIGatewayResponseCache *)responseCache {
+    AWSAPIGatewayClient *client = [AWSAPIGatewayClient new];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUnknown
+                                                                         credentialsProvider:nil];
+    configuration.baseURL = [NSURL URLWithString:@"https://stub.example.com"];
+    client.configuration = configuration;
+    client.responseCache = responseCache;
+
+    NSURLSessionConfiguration *sessionConfiguration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    sessionConfiguration.protocolClasses = @[[AWSAPIGatewayStubURLProtocol class]];
+    client.session = [NSURLSession sessionWithConfiguration:sessionConfiguration];
+    return client;
+}
+
+- (AWSAPIGatewayResponse *)client:(AWSAPIGatewayClient *)client
+                           invoke:(NSString *)HTTPMethod
+                        URLString:(NSString *)URLString {
+    return [self client:client invoke:HTTPMethod URLString:URLString headerParameters:nil];
+}
+
+- (AWSAPIGatewayResponse *)client:(AWSAPIGatewayClient *)client
+                           invoke:(NSString *)HTTPMethod
+                        URLString:(NSString *)URLString
+                 headerParameters:(NSDictionary *)headerParameters {
+    AWSAPIGatewayRequest *request = [[AWSAPIGatewayRequest alloc] initWithHTTPMethod:HTTPMethod
+                                                                           URLString:URLString
+                                                                     queryParameters:nil
+                                                                    headerParameters:headerParameters
+                                                                            HTTPBody:nil];
+    AWSTask<AWSAPIGatewayResponse *> *task = [[client invoke:request] waitUntilFinished];
+    XCTAssertNil(task.error);
+    return task.result;
+}
+
+- (void)testFreshResponseIsReturnedWithoutRequest {
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                               diskCapacity:0
+                                                                                              directoryPath:nil];
+    AWSAPIGatewayClient *client = [self clientWithResponseCache:responseCache];
+
+    AWSAPIGatewayResponse *response = [self client:client invoke:@"GET" URLString:@"/fresh"];
+    AWSAPIGatewayResponse *cachedResponse = [self client:client invoke:@"GET" URLString:@"/fresh"];
+
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 1);
+    XCTAssertEqual(cachedResponse.statusCode, 200);
+    XCTAssertEqualObjects(cachedResponse.responseData, response.responseData);
+    XCTAssertEqual(responseCache.hitCount, 1);
+    XCTAssertEqual(responseCache.missCount, 1);
+}
+
+- (void)testStaleResponseIsRevalidated {
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                               diskCapacity:0
+                                                                                              directoryPath:nil];
+    AWSAPIGatewayClient *client = [self clientWithResponseCache:responseCache];
+
+    AWSAPIGatewayResponse *response = [self client:client invoke:@"GET" URLString:@"/revalidated"];
+    XCTAssertNil(AWSAPIGatewayStubLastIfNoneMatch);
+    AWSAPIGatewayResponse *revalidatedResponse = [self client:client invoke:@"GET" URLString:@"/revalidated"];
+
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 2);
+    XCTAssertEqualObjects(AWSAPIGatewayStubLastIfNoneMatch, AWSAPIGatewayStubETag);
+    XCTAssertEqual(AWSAPIGatewayStubBytesTransferred, [response.responseData length]);
+    XCTAssertEqual(revalidatedResponse.statusCode, 200);
+    XCTAssertEqualObjects(revalidatedResponse.responseData, response.responseData);
+    XCTAssertEqual(responseCache.revalidationCount, 1);
+}
+
+- (void)testNoStoreResponseIsNotCached {
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                               diskCapacity:0
+                                                                                              directoryPath:nil];
+    AWSAPIGatewayClient *client = [self clientWithResponseCache:responseCache];
+
+    [self client:client invoke:@"GET" URLString:@"/uncached"];
+    [self client:client invoke:@"GET" URLString:@"/uncached"];
+
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 2);
+    XCTAssertNil(AWSAPIGatewayStubLastIfNoneMatch);
+    XCTAssertEqual(responseCache.currentMemoryUsage, 0);
+}
+
+- (void)testUnsafeRequestRemovesCachedResponse {
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                               diskCapacity:0
+                                                                                              directoryPath:nil];
+    AWSAPIGatewayClient *client = [self clientWithResponseCache:responseCache];
+
+    [self client:client invoke:@"GET" URLString:@"/fresh"];
+    [self client:client invoke:@"POST" URLString:@"/fresh"];
+    [self client:client invoke:@"GET" URLString:@"/fresh"];
+
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 3);
+    XCTAssertEqual(responseCache.hitCount, 0);
+}
+
+- (void)testResponsesAreEvictedBeyondMemoryCapacity {
+    // Room for the bodies and headers of two responses, not three.
+    NSUInteger bodyLength = [[AWSAPIGatewayStubURLProtocol body] length];
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:bodyLength * 2 + 1024
+                                                                                               diskCapacity:0
+                                                                                              directoryPath:nil];
+    AWSAPIGatewayClient *client = [self clientWithResponseCache:responseCache];
+
+    [self client:client invoke:@"GET" URLString:@"/fresh/1"];
+    [self client:client invoke:@"GET" URLString:@"/fresh/2"];
+    [self client:client invoke:@"GET" URLString:@"/fresh/1"];
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 2);
+
+    // Evicts `/fresh/2`, the least recently used response.
+    [self client:client invoke:@"GET" URLString:@"/fresh/3"];
+    XCTAssertLessThanOrEqual(responseCache.currentMemoryUsage, bodyLength * 2 + 1024);
+    [self client:client invoke:@"GET" URLString:@"/fresh/1"];
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 3);
+    [self client:client invoke:@"GET" URLString:@"/fresh/2"];
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 4);
+}
+
+- (void)testResponsesArePersistedOnDisk {
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                               diskCapacity:AWSAPIGatewayResponseCacheDefaultDiskCapacity
+                                                                                              directoryPath:self.directoryPath];
+    AWSAPIGatewayResponse *response = [self client:[self clientWithResponseCache:responseCache] invoke:@"GET" URLString:@"/fresh"];
+    XCTAssertGreaterThan(responseCache.currentDiskUsage, [response.responseData length]);
+
+    AWSAPIGatewayResponseCache *reopenedResponseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                                       diskCapacity:AWSAPIGatewayResponseCacheDefaultDiskCapacity
+                                                                                                      directoryPath:self.directoryPath];
+    XCTAssertEqual(reopenedResponseCache.currentDiskUsage, responseCache.currentDiskUsage);
+    AWSAPIGatewayResponse *cachedResponse = [self client:[self clientWithResponseCache:reopenedResponseCache] invoke:@"GET" URLString:@"/fresh"];
+
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 1);
+    XCTAssertEqualObjects(cachedResponse.responseData, response.responseData);
+    XCTAssertEqualObjects(cachedResponse.headers[@"ETag"], AWSAPIGatewayStubETag);
+
+    [reopenedResponseCache removeAllCachedResponses];
+    XCTAssertEqual(reopenedResponseCache.currentDiskUsage, 0);
+    XCTAssertEqual(reopenedResponseCache.currentMemoryUsage, 0);
+}
+
+- (void)testResponsesAreCachedPerIdentity {
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                               diskCapacity:AWSAPIGatewayResponseCacheDefaultDiskCapacity
+                                                                                              directoryPath:self.directoryPath];
+    AWSAPIGatewayClient *client = [self clientWithResponseCache:responseCache];
+
+    [self client:client invoke:@"GET" URLString:@"/fresh" headerParameters:@{@"Authorization" : @"Bearer alice"}];
+    [self client:client invoke:@"GET" URLString:@"/fresh" headerParameters:@{@"Authorization" : @"Bearer bob"}];
+    [self client:client invoke:@"GET" URLString:@"/fresh" headerParameters:@{@"Authorization" : @"Bearer alice"}];
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 2);
+    XCTAssertEqual(responseCache.hitCount, 1);
+
+    // A later launch does not answer another identity from disk either.
+    AWSAPIGatewayResponseCache *reopenedResponseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                                       diskCapacity:AWSAPIGatewayResponseCacheDefaultDiskCapacity
+                                                                                                      directoryPath:self.directoryPath];
+    [self client:[self clientWithResponseCache:reopenedResponseCache] invoke:@"GET" URLString:@"/fresh" headerParameters:@{@"Authorization" : @"Bearer carol"}];
+    XCTAssertEqual(AWSAPIGatewayStubRequestCount, 3);
+    XCTAssertEqual(reopenedResponseCache.hitCount, 0);
+}
+
+- (void)testCachesOfOneDirectoryShareItsCapacity {
+    // Room on disk for one response, not two.
+    NSUInteger diskCapacity = [[AWSAPIGatewayStubURLProtocol body] length] * 3 / 2;
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:0
+                                                                                               diskCapacity:diskCapacity
+                                                                                              directoryPath:self.directoryPath];
+    AWSAPIGatewayResponseCache *otherResponseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:0
+                                                                                                    diskCapacity:diskCapacity
+                                                                                                   directoryPath:self.directoryPath];
+
+    [self client:[self clientWithResponseCache:responseCache] invoke:@"GET" URLString:@"/fresh/1"];
+    [self client:[self clientWithResponseCache:otherResponseCache] invoke:@"GET" URLString:@"/fresh/2"];
+
+    XCTAssertGreaterThan(responseCache.currentDiskUsage, 0);
+    XCTAssertLessThanOrEqual(responseCache.currentDiskUsage, diskCapacity);
+    XCTAssertEqual(otherResponseCache.currentDiskUsage, responseCache.currentDiskUsage);
+    NSArray *fileNames = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:self.directoryPath error:nil];
+    XCTAssertEqual([fileNames count], 1);
+}
+
+- (void)testNotModifiedWithoutCachedResponse {
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                               diskCapacity:0
+                                                                                              directoryPath:nil];
+    NSURL *URL = [NSURL URLWithString:@"https://stub.example.com/revalidated"];
+    NSHTTPURLResponse *HTTPResponse = [[NSHTTPURLResponse alloc] initWithURL:URL
+                                                                  statusCode:304
+                                                                 HTTPVersion:@"HTTP/1.1"
+                                                                headerFields:@{@"ETag" : AWSAPIGatewayStubETag}];
+
+    // Validators the cache sent for a response it no longer has: the request must be sent again.
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:URL];
+    XCTAssertNil([responseCache responseForRequest:request credentials:nil HTTPResponse:HTTPResponse data:[NSData data]]);
+
+    // Validators of the caller: the 304 is theirs.
+    [request setValue:AWSAPIGatewayStubETag forHTTPHeaderField:@"If-None-Match"];
+    AWSAPIGatewayResponse *response = [responseCache responseForRequest:request credentials:nil HTTPResponse:HTTPResponse data:[NSData data]];
+    XCTAssertEqual(response.statusCode, 304);
+}
+
+- (void)testInvokeHTTPRequestMapsCachedResponse {
+    AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                               diskCapacity:0
+                                                                                              directoryPath:nil];
+    AWSAPIGatewayClient *client = [self clientWithResponseCache:responseCache];
+
+    for (NSUInteger i = 0; i < 2; i++) {
+        AWSTask *task = [[client invokeHTTPRequest:@"GET"
+                                         URLString:@"/revalidated"
+                                    pathParameters:nil
+                                   queryParameters:@{@"limit" : @200, @"fields" : @[@"id", @"name"]}
+                                  headerParameters:nil
+                                              body:nil
+                                     responseClass:[NSDictionary class]] waitUntilFinished];
+        XCTAssertNil(task.error);
+        XCTAssertEqual([task.result[@"items"] count], 200);
+    }
+    XCTAssertEqual(responseCache.revalidationCount, 1);
+}
+
+- (void)testPollingLatencyAndBytesTransferred {
+    NSUInteger pollCount = 200;
+    NSArray<NSString *> *URLStrings = @[@"/uncached", @"/revalidated", @"/fresh"];
+    for (NSString *URLString in URLStrings) {
+        AWSAPIGatewayResponseCache *responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                                                   diskCapacity:AWSAPIGatewayResponseCacheDefaultDiskCapacity
+                                                                                                  directoryPath:self.directoryPath];
+        AWSAPIGatewayClient *client = [self clientWithResponseCache:responseCache];
+        @synchronized([AWSAPIGatewayStubURLProtocol class]) {
+            AWSAPIGatewayStubRequestCount = 0;
+            AWSAPIGatewayStubBytesTransferred = 0;
+        }
+
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        for (NSUInteger i = 0; i < pollCount; i++) {
+            [self client:client invoke:@"GET" URLString:URLString];
+        }
+        CFAbsoluteTime duration = CFAbsoluteTimeGetCurrent() - start;
+
+        NSLog(@"Polled %@ %lu times: %.3f ms per call, %lu requests, %lu bytes transferred",
+              URLString, (unsigned long)pollCount, duration * 1000 / pollCount,
+              (unsigned long)AWSAPIGatewayStubRequestCount, (unsigned long)AWSAPIGatewayStubBytesTransferred);
+        [responseCache removeAllCachedResponses];
+    }
+}
+
+@end
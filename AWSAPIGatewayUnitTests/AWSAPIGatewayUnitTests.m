@@ -56,4 +56,27 @@
     XCTAssertEqualObjects([URL path], @"/user/my-user-id/action/my-action-id");
 }
 
+- (void)testQueryStringGeneration {
+    AWSAPIGatewayClient *client = [AWSAPIGatewayClient new];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUnknown
+                                                                         credentialsProvider:nil];
+    configuration.baseURL = [NSURL URLWithString:@"https://test.com"];
+    client.configuration = configuration;
+
+    NSURL *URL = [client requestURL:@"/items"
+                              query:@{@"ids":@[@"a b", @2]}
+        URLPathComponentsDictionary:nil];
+    XCTAssertEqualObjects([URL query], @"ids=a%20b,2");
+
+    URL = [client requestURL:@"/items"
+                       query:@{@"filter":@{@"limit":@10}}
+ URLPathComponentsDictionary:nil];
+    XCTAssertEqualObjects([URL query], @"limit=10");
+
+    URL = [client requestURL:@"/items"
+                       query:@{}
+ URLPathComponentsDictionary:nil];
+    XCTAssertNil([URL query]);
+}
+
 @end
@@ -40,3 +40,4 @@ FOUNDATION_EXPORT const unsigned char AWSCloudWatchVersionString[] DEPRECATED_MS
 
 #import <AWSCore/AWSCore.h>
 #import "AWSCloudWatchService.h"
+#import "AWSCloudWatchMetricsPublisher.h"
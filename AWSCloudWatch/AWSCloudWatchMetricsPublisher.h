@@ -0,0 +1,144 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import <AWSCore/AWSCore.h>
+#import "AWSCloudWatchModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class AWSCloudWatch;
+
+/**
+ How recorded values are summarized before they are published.
+ */
+typedef NS_ENUM(NSInteger, AWSCloudWatchMetricAggregation) {
+    /**
+     Each metric is published as a statistic set: the minimum, maximum, sum and sample count of the values recorded
+     during the flush interval.
+     */
+    AWSCloudWatchMetricAggregationStatisticSet,
+    /**
+     Each metric is published as `Values` and `Counts` arrays, one entry per distinct value recorded during the flush
+     interval. CloudWatch can compute percentiles from this form. A metric with more than 150 distinct values is split
+     into several data points.
+     */
+    AWSCloudWatchMetricAggregationValues,
+};
+
+/**
+ The default value of `flushInterval`, 60 seconds.
+ */
+FOUNDATION_EXPORT NSTimeInterval const AWSCloudWatchMetricsPublisherFlushIntervalDefault;
+
+/**
+ The default value of `maximumDatumCount`, 1000.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSCloudWatchMetricsPublisherMaximumDatumCountDefault;
+
+/**
+ Aggregates metric values in memory and publishes them with as few `PutMetricData` calls as possible.
+
+ Values recorded with the same metric name, unit and dimensions during a flush interval are summarized into one data
+ point according to `aggregation`. Every `flushInterval` the data points are packed into `PutMetricData` requests of at
+ most 20 metrics and 40KB each, the limits of the API.
+
+ The publisher keeps at most `maximumDatumCount` data points in memory. When that many are pending it flushes early.
+ Until the flush has picked them up, values that would need another data point are dropped and counted in
+ `droppedValueCount`; values for metrics that are already pending are still aggregated.
+
+     AWSCloudWatchMetricsPublisher *publisher = [[AWSCloudWatchMetricsPublisher alloc] initWithConfiguration:configuration
+                                                                                                 namespace:@"MyApp"];
+     [publisher recordValue:latency metricName:@"RequestLatency" unit:AWSCloudWatchStandardUnitMilliseconds dimensions:nil];
+ */
+@interface AWSCloudWatchMetricsPublisher : NSObject
+
+/**
+ The namespace the metrics are published to.
+ */
+@property (nonatomic, strong, readonly) NSString *metricNamespace;
+
+/**
+ How recorded values are summarized. The default value is `AWSCloudWatchMetricAggregationStatisticSet`.
+ Metrics that are already pending keep their aggregation until the next flush.
+ */
+@property (atomic, assign) AWSCloudWatchMetricAggregation aggregation;
+
+/**
+ The time between two flushes. The default value is `AWSCloudWatchMetricsPublisherFlushIntervalDefault`.
+ Set it to `0` to flush only when `flush` is called or the publisher is full.
+ */
+@property (nonatomic, assign) NSTimeInterval flushInterval;
+
+/**
+ The maximum number of data points kept in memory. The default value is `AWSCloudWatchMetricsPublisherMaximumDatumCountDefault`.
+ */
+@property (atomic, assign) NSUInteger maximumDatumCount;
+
+/**
+ The number of recorded values that were dropped because the publisher was full or because a `PutMetricData` call failed.
+ */
+@property (atomic, assign, readonly) uint64_t droppedValueCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a publisher that calls `PutMetricData` with the given client. The request body is sent as is; use
+ `initWithConfiguration:namespace:` to have it compressed.
+
+ @param cloudWatch      The CloudWatch client.
+ @param metricNamespace The namespace the metrics are published to.
+
+ @return A publisher.
+ */
+- (instancetype)initWithCloudWatch:(AWSCloudWatch *)cloudWatch
+                         namespace:(NSString *)metricNamespace NS_DESIGNATED_INITIALIZER;
+
+/**
+ Creates a publisher with its own CloudWatch client for the given configuration. The client sends the `PutMetricData`
+ body compressed with gzip.
+
+ @param configuration   The service configuration of the client.
+ @param metricNamespace The namespace the metrics are published to.
+
+ @return A publisher.
+ */
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration
+                            namespace:(NSString *)metricNamespace;
+
+/**
+ Records a value. It is aggregated with the other values of the same metric, unit and dimensions until the next flush.
+
+ @param value      The value. Values CloudWatch rejects, such as NaN and infinities, are ignored.
+ @param metricName The name of the metric.
+ @param unit       The unit of the value.
+ @param dimensions The dimensions of the metric, at most 10. The order does not matter.
+ */
+- (void)recordValue:(double)value
+         metricName:(NSString *)metricName
+               unit:(AWSCloudWatchStandardUnit)unit
+         dimensions:(nullable NSArray<AWSCloudWatchDimension *> *)dimensions;
+
+/**
+ Publishes every pending data point.
+
+ @return An instance of `AWSTask`. `task.result` is the number of `PutMetricData` calls made. `task.error` is set when one
+ of them failed; the data points it carried are pending again if there is room for them, and dropped otherwise.
+ */
+- (AWSTask<NSNumber *> *)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,401 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSCloudWatchMetricsPublisher.h"
+#import "AWSCloudWatchService.h"
+
+NSTimeInterval const AWSCloudWatchMetricsPublisherFlushIntervalDefault = 60.0;
+NSUInteger const AWSCloudWatchMetricsPublisherMaximumDatumCountDefault = 1000;
+
+// PutMetricData limits.
+static NSUInteger const AWSCloudWatchMetricsPublisherMaximumDatumsPerRequest = 20;
+static NSUInteger const AWSCloudWatchMetricsPublisherMaximumRequestBytes = 40 * 1024;
+static NSUInteger const AWSCloudWatchMetricsPublisherMaximumDistinctValues = 150;
+
+// Every field of a datum is sent as "MetricData.member.N.<Field>=<value>&". These cover the longest field name with
+// its index, and the longest formatted number or unit.
+static NSUInteger const AWSCloudWatchMetricsPublisherFieldOverheadBytes = 56;
+static NSUInteger const AWSCloudWatchMetricsPublisherNumberBytes = 32;
+
+static NSUInteger AWSCloudWatchEncodedStringBytes(NSString *string) {
+    // Percent-encoding at most triples every byte.
+    return [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding] * 3;
+}
+
+static NSUInteger AWSCloudWatchEstimatedDatumBytes(AWSCloudWatchMetricDatum *datum) {
+    NSUInteger fieldBytes = AWSCloudWatchMetricsPublisherFieldOverheadBytes + AWSCloudWatchMetricsPublisherNumberBytes;
+    NSUInteger bytes = AWSCloudWatchMetricsPublisherFieldOverheadBytes + AWSCloudWatchEncodedStringBytes(datum.metricName);
+    bytes += 2 * fieldBytes; // Unit and Timestamp
+    for (AWSCloudWatchDimension *dimension in datum.dimensions) {
+        bytes += 2 * AWSCloudWatchMetricsPublisherFieldOverheadBytes;
+        bytes += AWSCloudWatchEncodedStringBytes(dimension.name) + AWSCloudWatchEncodedStringBytes(dimension.value);
+    }
+    if (datum.statisticValues) {
+        bytes += 4 * fieldBytes;
+    }
+    bytes += (datum.values.count + datum.counts.count) * fieldBytes;
+    return bytes;
+}
+
+static uint64_t AWSCloudWatchDatumValueCount(AWSCloudWatchMetricDatum *datum) {
+    if (datum.statisticValues) {
+        return [datum.statisticValues.sampleCount unsignedLongLongValue];
+    }
+    uint64_t count = 0;
+    for (NSNumber *number in datum.counts) {
+        count += [number unsignedLongLongValue];
+    }
+    return count;
+}
+
+#pragma mark - AWSCloudWatchMetricSeries
+
+// The values of one metric, unit and set of dimensions recorded since the last flush.
+@interface AWSCloudWatchMetricSeries : NSObject
+
+@property (nonatomic, strong) NSString *metricName;
+@property (nonatomic, assign) AWSCloudWatchStandardUnit unit;
+@property (nonatomic, strong) NSArray<AWSCloudWatchDimension *> *dimensions;
+@property (nonatomic, assign) AWSCloudWatchMetricAggregation aggregation;
+@property (nonatomic, strong) NSDate *timestamp;
+
+@property (nonatomic, assign) double minimum;
+@property (nonatomic, assign) double maximum;
+@property (nonatomic, assign) double sum;
+@property (nonatomic, assign) uint64_t sampleCount;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSNumber *> *histogram;
+
+@end
+
+@implementation AWSCloudWatchMetricSeries
+
+- (BOOL)canAddValue:(double)value {
+    return self.aggregation != AWSCloudWatchMetricAggregationValues
+    || self.histogram.count < AWSCloudWatchMetricsPublisherMaximumDistinctValues
+    || self.histogram[@(value)] != nil;
+}
+
+- (void)addValue:(double)value {
+    if (self.sampleCount == 0) {
+        self.timestamp = [NSDate date];
+        self.minimum = value;
+        self.maximum = value;
+    } else {
+        self.minimum = MIN(self.minimum, value);
+        self.maximum = MAX(self.maximum, value);
+    }
+    self.sum += value;
+    self.sampleCount++;
+
+    if (self.aggregation == AWSCloudWatchMetricAggregationValues) {
+        if (!self.histogram) {
+            self.histogram = [NSMutableDictionary new];
+        }
+        NSNumber *key = @(value);
+        self.histogram[key] = @([self.histogram[key] unsignedLongLongValue] + 1);
+    }
+}
+
+- (AWSCloudWatchMetricDatum *)datum {
+    AWSCloudWatchMetricDatum *datum = [AWSCloudWatchMetricDatum new];
+    datum.metricName = self.metricName;
+    datum.unit = self.unit;
+    datum.dimensions = self.dimensions;
+    datum.timestamp = self.timestamp;
+
+    if (self.aggregation == AWSCloudWatchMetricAggregationValues) {
+        NSArray<NSNumber *> *values = [self.histogram.allKeys sortedArrayUsingSelector:@selector(compare:)];
+        NSMutableArray<NSNumber *> *counts = [NSMutableArray arrayWithCapacity:values.count];
+        for (NSNumber *value in values) {
+            [counts addObject:self.histogram[value]];
+        }
+        datum.values = values;
+        datum.counts = counts;
+    } else {
+        AWSCloudWatchStatisticSet *statisticValues = [AWSCloudWatchStatisticSet new];
+        statisticValues.minimum = @(self.minimum);
+        statisticValues.maximum = @(self.maximum);
+        statisticValues.sum = @(self.sum);
+        statisticValues.sampleCount = @(self.sampleCount);
+        datum.statisticValues = statisticValues;
+    }
+
+    return datum;
+}
+
+- (void)reset {
+    self.sum = 0;
+    self.sampleCount = 0;
+    [self.histogram removeAllObjects];
+}
+
+@end
+
+#pragma mark - AWSCloudWatchMetricsPublisher
+
+@interface AWSCloudWatchMetricsPublisher() {
+    uint64_t _droppedValueCount;
+}
+
+@property (nonatomic, strong) AWSCloudWatch *cloudWatch;
+@property (nonatomic, strong) NSString *cloudWatchKey;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t flushTimer;
+
+// Guarded by @synchronized(self).
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSCloudWatchMetricSeries *> *series;
+@property (nonatomic, strong) NSMutableArray<AWSCloudWatchMetricDatum *> *pendingDatums;
+@property (nonatomic, assign) BOOL earlyFlushScheduled;
+
+@end
+
+@implementation AWSCloudWatchMetricsPublisher
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithCloudWatch:namespace:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithCloudWatch:(AWSCloudWatch *)cloudWatch
+                         namespace:(NSString *)metricNamespace {
+    if (self = [super init]) {
+        _cloudWatch = cloudWatch;
+        _metricNamespace = metricNamespace;
+        _aggregation = AWSCloudWatchMetricAggregationStatisticSet;
+        _maximumDatumCount = AWSCloudWatchMetricsPublisherMaximumDatumCountDefault;
+        _series = [NSMutableDictionary new];
+        _pendingDatums = [NSMutableArray new];
+        _queue = dispatch_queue_create("com.amazonaws.AWSCloudWatchMetricsPublisher", DISPATCH_QUEUE_SERIAL);
+        self.flushInterval = AWSCloudWatchMetricsPublisherFlushIntervalDefault;
+    }
+
+    return self;
+}
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration
+                            namespace:(NSString *)metricNamespace {
+    // PutMetricData accepts a gzip-compressed body, and the query serializer compresses it when the header is set.
+    AWSServiceConfiguration *gzipConfiguration = [configuration copy];
+    NSMutableDictionary *headers = [NSMutableDictionary dictionaryWithDictionary:gzipConfiguration.headers];
+    headers[@"Content-Encoding"] = @"gzip";
+    gzipConfiguration.headers = headers;
+
+    NSString *key = [NSString stringWithFormat:@"AWSCloudWatchMetricsPublisher.%@", [NSUUID UUID].UUIDString];
+    [AWSCloudWatch registerCloudWatchWithConfiguration:gzipConfiguration forKey:key];
+
+    if (self = [self initWithCloudWatch:[AWSCloudWatch CloudWatchForKey:key] namespace:metricNamespace]) {
+        _cloudWatchKey = key;
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    if (_flushTimer) {
+        dispatch_source_cancel(_flushTimer);
+    }
+    if (_cloudWatchKey) {
+        [AWSCloudWatch removeCloudWatchForKey:_cloudWatchKey];
+    }
+}
+
+- (void)setFlushInterval:(NSTimeInterval)flushInterval {
+    @synchronized(self) {
+        _flushInterval = flushInterval;
+
+        if (self.flushTimer) {
+            dispatch_source_cancel(self.flushTimer);
+            self.flushTimer = nil;
+        }
+        if (flushInterval <= 0) {
+            return;
+        }
+
+        uint64_t interval = (uint64_t)(flushInterval * NSEC_PER_SEC);
+        self.flushTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+        dispatch_source_set_timer(self.flushTimer, dispatch_time(DISPATCH_TIME_NOW, interval), interval, interval / 10);
+
+        __weak AWSCloudWatchMetricsPublisher *weakSelf = self;
+        dispatch_source_set_event_handler(self.flushTimer, ^{
+            [weakSelf flush];
+        });
+        dispatch_resume(self.flushTimer);
+    }
+}
+
+- (uint64_t)droppedValueCount {
+    @synchronized(self) {
+        return _droppedValueCount;
+    }
+}
+
+#pragma mark - Recording
+
+static NSString *AWSCloudWatchMetricSeriesKey(NSString *metricName,
+                                              AWSCloudWatchStandardUnit unit,
+                                              NSArray<AWSCloudWatchDimension *> *dimensions) {
+    NSMutableString *key = [NSMutableString stringWithFormat:@"%@\x1f%ld", metricName, (long)unit];
+    NSArray<AWSCloudWatchDimension *> *sortedDimensions = dimensions;
+    if (dimensions.count > 1) {
+        sortedDimensions = [dimensions sortedArrayUsingComparator:^NSComparisonResult(AWSCloudWatchDimension *dimension1, AWSCloudWatchDimension *dimension2) {
+            return [dimension1.name compare:dimension2.name];
+        }];
+    }
+    for (AWSCloudWatchDimension *dimension in sortedDimensions) {
+        [key appendFormat:@"\x1f%@\x1e%@", dimension.name, dimension.value];
+    }
+    return key;
+}
+
+- (NSUInteger)pendingDatumCount {
+    return self.series.count + self.pendingDatums.count;
+}
+
+- (void)recordValue:(double)value
+         metricName:(NSString *)metricName
+               unit:(AWSCloudWatchStandardUnit)unit
+         dimensions:(NSArray<AWSCloudWatchDimension *> *)dimensions {
+    if (isnan(value) || isinf(value)) {
+        return;
+    }
+
+    NSString *key = AWSCloudWatchMetricSeriesKey(metricName, unit, dimensions);
+    BOOL needsFlush = NO;
+
+    @synchronized(self) {
+        AWSCloudWatchMetricSeries *series = self.series[key];
+        if (!series || ![series canAddValue:value]) {
+            // Either a new metric or a histogram that is full; both take one more data point.
+            if ([self pendingDatumCount] >= self.maximumDatumCount) {
+                _droppedValueCount++;
+                needsFlush = YES;
+            } else if (!series) {
+                series = [AWSCloudWatchMetricSeries new];
+                series.metricName = metricName;
+                series.unit = unit;
+                series.dimensions = [dimensions copy];
+                series.aggregation = self.aggregation;
+                self.series[key] = series;
+            } else {
+                [self.pendingDatums addObject:[series datum]];
+                [series reset];
+            }
+        }
+
+        if (!needsFlush) {
+            [series addValue:value];
+            needsFlush = [self pendingDatumCount] >= self.maximumDatumCount;
+        }
+
+        if (needsFlush) {
+            needsFlush = !self.earlyFlushScheduled;
+            self.earlyFlushScheduled = YES;
+        }
+    }
+
+    if (needsFlush) {
+        __weak AWSCloudWatchMetricsPublisher *weakSelf = self;
+        dispatch_async(self.queue, ^{
+            [weakSelf flush];
+        });
+    }
+}
+
+#pragma mark - Publishing
+
+- (NSArray<AWSCloudWatchMetricDatum *> *)takePendingDatums {
+    @synchronized(self) {
+        NSMutableArray<AWSCloudWatchMetricDatum *> *datums = self.pendingDatums;
+        for (AWSCloudWatchMetricSeries *series in self.series.allValues) {
+            [datums addObject:[series datum]];
+        }
+        self.series = [NSMutableDictionary new];
+        self.pendingDatums = [NSMutableArray new];
+        self.earlyFlushScheduled = NO;
+        return datums;
+    }
+}
+
+- (void)restorePendingDatums:(NSArray<AWSCloudWatchMetricDatum *> *)datums {
+    @synchronized(self) {
+        for (AWSCloudWatchMetricDatum *datum in datums) {
+            if ([self pendingDatumCount] < self.maximumDatumCount) {
+                [self.pendingDatums addObject:datum];
+            } else {
+                _droppedValueCount += AWSCloudWatchDatumValueCount(datum);
+            }
+        }
+    }
+}
+
+- (NSArray<NSArray<AWSCloudWatchMetricDatum *> *> *)batchesForDatums:(NSArray<AWSCloudWatchMetricDatum *> *)datums {
+    // Action, Version and Namespace.
+    NSUInteger baseBytes = 64 + AWSCloudWatchEncodedStringBytes(self.metricNamespace);
+
+    NSMutableArray<NSArray<AWSCloudWatchMetricDatum *> *> *batches = [NSMutableArray new];
+    NSMutableArray<AWSCloudWatchMetricDatum *> *batch = [NSMutableArray new];
+    NSUInteger batchBytes = baseBytes;
+    for (AWSCloudWatchMetricDatum *datum in datums) {
+        NSUInteger datumBytes = AWSCloudWatchEstimatedDatumBytes(datum);
+        if (batch.count == AWSCloudWatchMetricsPublisherMaximumDatumsPerRequest
+            || (batch.count > 0 && batchBytes + datumBytes > AWSCloudWatchMetricsPublisherMaximumRequestBytes)) {
+            [batches addObject:batch];
+            batch = [NSMutableArray new];
+            batchBytes = baseBytes;
+        }
+        [batch addObject:datum];
+        batchBytes += datumBytes;
+    }
+    if (batch.count > 0) {
+        [batches addObject:batch];
+    }
+
+    return batches;
+}
+
+- (AWSTask<NSNumber *> *)flush {
+    NSArray<NSArray<AWSCloudWatchMetricDatum *> *> *batches = [self batchesForDatums:[self takePendingDatums]];
+    if (batches.count == 0) {
+        return [AWSTask taskWithResult:@0];
+    }
+
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray arrayWithCapacity:batches.count];
+    for (NSArray<AWSCloudWatchMetricDatum *> *batch in batches) {
+        AWSCloudWatchPutMetricDataInput *putMetricDataInput = [AWSCloudWatchPutMetricDataInput new];
+        putMetricDataInput.namespace = self.metricNamespace;
+        putMetricDataInput.metricData = batch;
+
+        [tasks addObject:[[self.cloudWatch putMetricData:putMetricDataInput] continueWithBlock:^id(AWSTask *task) {
+            if (task.error) {
+                AWSDDLogError(@"Failed to publish %lu metrics: %@", (unsigned long)batch.count, task.error);
+                [self restorePendingDatums:batch];
+            }
+            return task;
+        }]];
+    }
+
+    return [[AWSTask taskForCompletionOfAllTasks:tasks] continueWithBlock:^id(AWSTask *task) {
+        for (AWSTask *putMetricDataTask in tasks) {
+            if (putMetricDataTask.error) {
+                return [AWSTask taskWithError:putMetricDataTask.error];
+            }
+        }
+        return [AWSTask taskWithResult:@(tasks.count)];
+    }];
+}
+
+@end
@@ -0,0 +1,247 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSCloudWatchService.h"
+#import "AWSCloudWatchMetricsPublisher.h"
+#import "AWSCloudWatchResources.h"
+#import "AWSGZIP.h"
+
+@interface AWSCloudWatch()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSCloudWatchMetricsPublisher()
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+@end
+
+// Records the PutMetricData calls instead of sending them.
+@interface AWSCloudWatchMetricsPublisherTestClient : AWSCloudWatch
+
+@property (atomic, assign) BOOL offline;
+@property (nonatomic, strong) NSMutableArray<AWSCloudWatchPutMetricDataInput *> *requests;
+
+@end
+
+@implementation AWSCloudWatchMetricsPublisherTestClient
+
+- (AWSTask *)putMetricData:(AWSCloudWatchPutMetricDataInput *)request {
+    if (self.offline) {
+        return [AWSTask taskWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil]];
+    }
+    @synchronized(self) {
+        [self.requests addObject:request];
+    }
+    return [AWSTask taskWithResult:nil];
+}
+
+@end
+
+@interface AWSCloudWatchMetricsPublisherTests : XCTestCase
+
+@property (nonatomic, strong) AWSCloudWatchMetricsPublisherTestClient *client;
+@property (nonatomic, strong) AWSCloudWatchMetricsPublisher *publisher;
+
+@end
+
+@implementation AWSCloudWatchMetricsPublisherTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1 credentialsProvider:nil];
+    self.client = [[AWSCloudWatchMetricsPublisherTestClient alloc] initWithConfiguration:configuration];
+    self.client.requests = [NSMutableArray new];
+
+    self.publisher = [[AWSCloudWatchMetricsPublisher alloc] initWithCloudWatch:self.client namespace:@"AWSCloudWatchMetricsPublisherTests"];
+    self.publisher.flushInterval = 0;
+}
+
+- (AWSCloudWatchDimension *)dimensionWithName:(NSString *)name value:(NSString *)value {
+    AWSCloudWatchDimension *dimension = [AWSCloudWatchDimension new];
+    dimension.name = name;
+    dimension.value = value;
+    return dimension;
+}
+
+- (AWSTask<NSNumber *> *)flush {
+    AWSTask<NSNumber *> *task = [self.publisher flush];
+    [task waitUntilFinished];
+    return task;
+}
+
+- (NSArray<AWSCloudWatchMetricDatum *> *)publishedDatums {
+    NSMutableArray<AWSCloudWatchMetricDatum *> *datums = [NSMutableArray new];
+    for (AWSCloudWatchPutMetricDataInput *request in self.client.requests) {
+        XCTAssertEqualObjects(request.namespace, @"AWSCloudWatchMetricsPublisherTests");
+        [datums addObjectsFromArray:request.metricData];
+    }
+    return datums;
+}
+
+- (void)testStatisticSetAggregation {
+    NSArray *dimensions = @[[self dimensionWithName:@"Operation" value:@"GetItem"], [self dimensionWithName:@"Table" value:@"Users"]];
+    NSArray *reversedDimensions = [[dimensions reverseObjectEnumerator] allObjects];
+    for (NSUInteger i = 1; i <= 100; i++) {
+        [self.publisher recordValue:i metricName:@"Latency" unit:AWSCloudWatchStandardUnitMilliseconds dimensions:(i % 2 ? dimensions : reversedDimensions)];
+    }
+    [self.publisher recordValue:1 metricName:@"Latency" unit:AWSCloudWatchStandardUnitSeconds dimensions:dimensions];
+    [self.publisher recordValue:NAN metricName:@"Latency" unit:AWSCloudWatchStandardUnitMilliseconds dimensions:dimensions];
+
+    AWSTask *task = [self flush];
+    XCTAssertNil(task.error);
+    XCTAssertEqualObjects(task.result, @1);
+
+    NSArray<AWSCloudWatchMetricDatum *> *datums = [self publishedDatums];
+    XCTAssertEqual(datums.count, 2);
+    AWSCloudWatchMetricDatum *datum = datums[0].unit == AWSCloudWatchStandardUnitMilliseconds ? datums[0] : datums[1];
+    XCTAssertEqualObjects(datum.metricName, @"Latency");
+    XCTAssertEqual(datum.dimensions.count, 2);
+    XCTAssertNotNil(datum.timestamp);
+    XCTAssertNil(datum.value);
+    XCTAssertEqualObjects(datum.statisticValues.minimum, @1);
+    XCTAssertEqualObjects(datum.statisticValues.maximum, @100);
+    XCTAssertEqualObjects(datum.statisticValues.sum, @5050);
+    XCTAssertEqualObjects(datum.statisticValues.sampleCount, @100);
+
+    // Nothing is pending after a flush.
+    XCTAssertEqualObjects([self flush].result, @0);
+}
+
+- (void)testValuesAggregationSplitsAtDistinctValueLimit {
+    self.publisher.aggregation = AWSCloudWatchMetricAggregationValues;
+    for (NSUInteger i = 0; i < 400; i++) {
+        [self.publisher recordValue:(i % 200) metricName:@"Size" unit:AWSCloudWatchStandardUnitBytes dimensions:nil];
+    }
+    [self flush];
+
+    NSUInteger total = 0;
+    NSArray<AWSCloudWatchMetricDatum *> *datums = [self publishedDatums];
+    XCTAssertEqual(datums.count, 3);
+    for (AWSCloudWatchMetricDatum *datum in datums) {
+        XCTAssertNil(datum.statisticValues);
+        XCTAssertLessThanOrEqual(datum.values.count, 150);
+        XCTAssertEqual(datum.values.count, datum.counts.count);
+        for (NSNumber *count in datum.counts) {
+            total += [count unsignedIntegerValue];
+        }
+    }
+    XCTAssertEqual(total, 400);
+}
+
+- (void)testRequestsRespectPutMetricDataLimits {
+    self.publisher.aggregation = AWSCloudWatchMetricAggregationValues;
+    for (NSUInteger metric = 0; metric < 45; metric++) {
+        NSString *metricName = [NSString stringWithFormat:@"Metric%lu", (unsigned long)metric];
+        for (NSUInteger i = 0; i < 150; i++) {
+            [self.publisher recordValue:i * 1.001 metricName:metricName unit:AWSCloudWatchStandardUnitCount dimensions:nil];
+        }
+    }
+    [self flush];
+
+    XCTAssertEqual([self publishedDatums].count, 45);
+    for (AWSCloudWatchPutMetricDataInput *request in self.client.requests) {
+        XCTAssertLessThanOrEqual(request.metricData.count, 20);
+
+        NSDictionary *parameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:request] aws_removeNullValues];
+        NSMutableURLRequest *URLRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://monitoring.us-east-1.amazonaws.com"]];
+        AWSQueryStringRequestSerializer *serializer = [[AWSQueryStringRequestSerializer alloc] initWithJSONDefinition:[[AWSCloudWatchResources sharedInstance] JSONObject]
+                                                                                                            actionName:@"PutMetricData"];
+        XCTAssertNil([serializer serializeRequest:URLRequest headers:nil parameters:parameters].error);
+        XCTAssertLessThanOrEqual(URLRequest.HTTPBody.length, 40 * 1024);
+    }
+}
+
+- (void)testQueryStringBodyIsGzipped {
+    AWSCloudWatchPutMetricDataInput *request = [AWSCloudWatchPutMetricDataInput new];
+    request.namespace = @"AWSCloudWatchMetricsPublisherTests";
+    NSDictionary *parameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:request] aws_removeNullValues];
+    AWSQueryStringRequestSerializer *serializer = [[AWSQueryStringRequestSerializer alloc] initWithJSONDefinition:[[AWSCloudWatchResources sharedInstance] JSONObject]
+                                                                                                        actionName:@"PutMetricData"];
+
+    NSMutableURLRequest *plainRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://monitoring.us-east-1.amazonaws.com"]];
+    [serializer serializeRequest:plainRequest headers:nil parameters:parameters];
+
+    NSMutableURLRequest *gzipRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://monitoring.us-east-1.amazonaws.com"]];
+    [serializer serializeRequest:gzipRequest headers:@{@"Content-Encoding" : @"gzip"} parameters:parameters];
+
+    XCTAssertEqualObjects([gzipRequest valueForHTTPHeaderField:@"Content-Encoding"], @"gzip");
+    XCTAssertEqualObjects([gzipRequest.HTTPBody awsgzip_gunzippedData], plainRequest.HTTPBody);
+}
+
+- (void)testMemoryIsBounded {
+    self.publisher.maximumDatumCount = 10;
+    // Hold back the flush that a full publisher schedules on its queue, so that nothing is published while recording.
+    dispatch_suspend(self.publisher.queue);
+    for (NSUInteger i = 0; i < 20; i++) {
+        [self.publisher recordValue:1 metricName:[NSString stringWithFormat:@"Metric%lu", (unsigned long)i] unit:AWSCloudWatchStandardUnitCount dimensions:nil];
+    }
+    // Pending metrics keep aggregating while the publisher is full.
+    [self.publisher recordValue:2 metricName:@"Metric0" unit:AWSCloudWatchStandardUnitCount dimensions:nil];
+    XCTAssertEqual(self.publisher.droppedValueCount, 10);
+    XCTAssertEqual(self.client.requests.count, 0);
+
+    dispatch_resume(self.publisher.queue);
+    dispatch_sync(self.publisher.queue, ^{});
+    [self flush];
+
+    NSArray<AWSCloudWatchMetricDatum *> *datums = [self publishedDatums];
+    XCTAssertEqual(datums.count, 10);
+    XCTAssertEqual(self.publisher.droppedValueCount, 10);
+    for (AWSCloudWatchMetricDatum *datum in datums) {
+        NSNumber *sampleCount = [datum.metricName isEqualToString:@"Metric0"] ? @2 : @1;
+        XCTAssertEqualObjects(datum.statisticValues.sampleCount, sampleCount);
+    }
+}
+
+- (void)testFailedRequestsArePendingAgain {
+    self.client.offline = YES;
+    [self.publisher recordValue:1 metricName:@"Metric" unit:AWSCloudWatchStandardUnitCount dimensions:nil];
+    XCTAssertNotNil([self flush].error);
+
+    self.client.offline = NO;
+    [self.publisher recordValue:2 metricName:@"Metric" unit:AWSCloudWatchStandardUnitCount dimensions:nil];
+    XCTAssertNil([self flush].error);
+
+    NSArray<AWSCloudWatchMetricDatum *> *datums = [self publishedDatums];
+    XCTAssertEqual(datums.count, 2);
+    XCTAssertEqual(self.publisher.droppedValueCount, 0);
+}
+
+// One second of 10,000 latency values across 20 metrics. Without aggregation every value is one PutMetricData call.
+- (void)testRequestsSavedAtTenThousandValuesPerSecondPerformance {
+    NSArray *dimensions = @[[self dimensionWithName:@"Operation" value:@"GetItem"]];
+    __block NSUInteger requestCount = 0;
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10000; i++) {
+            [self.publisher recordValue:(i % 997) / 10.0
+                             metricName:[NSString stringWithFormat:@"Latency%lu", (unsigned long)(i % 20)]
+                                   unit:AWSCloudWatchStandardUnitMilliseconds
+                             dimensions:dimensions];
+        }
+        requestCount = [[self flush].result unsignedIntegerValue];
+    }];
+
+    XCTAssertEqual(requestCount, 1);
+    NSLog(@"10000 values published with %lu PutMetricData call(s).", (unsigned long)requestCount);
+}
+
+@end
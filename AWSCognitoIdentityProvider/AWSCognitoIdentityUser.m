@@ -32,6 +32,10 @@ static const NSString * AWSCognitoIdentityUserAsfDeviceId = @"asf.device.id";
 static const NSString * AWSCognitoIdentityUserDeviceSecret = @"device.secret";
 static const NSString * AWSCognitoIdentityUserDeviceGroup = @"device.group";
 static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttributes.";
+// Sessions expiring within this window are refreshed before being handed out.
+static const NSTimeInterval AWSCognitoIdentityUserSessionExpiryWindow = 2 * 60;
+// Sessions expiring within this window are handed out and refreshed in the background.
+static const NSTimeInterval AWSCognitoIdentityUserSessionRefreshAheadWindow = 5 * 60;
 
 -(instancetype) initWithUsername: (NSString *)username pool:(AWSCognitoIdentityUserPool *)pool {
     self = [super init];
@@ -202,7 +206,7 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
 // returned session tokens are valid for atleast 2 min.
 - (BOOL) isTokenValid:(AWSCognitoIdentityUserSessionToken * _Nonnull)token {
     if ([token.tokenClaims valueForKey:@"exp"]) {
-        int expiryWindow = 2 * 60;
+        NSTimeInterval expiryWindow = AWSCognitoIdentityUserSessionExpiryWindow;
         NSTimeInterval expiryInterval = [[token.tokenClaims valueForKey:@"exp"] doubleValue];
         NSDate *tokenExpiration =  [NSDate dateWithTimeIntervalSince1970:expiryInterval];
         return (tokenExpiration &&
@@ -217,87 +221,150 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
 -(AWSTask<AWSCognitoIdentityUserSession*> *) getSession {
     
     //check to see if we have valid tokens
-    __block NSString * keyChainNamespace = [self keyChainNamespaceClientId];
+    NSString * keyChainNamespace = [self keyChainNamespaceClientId];
     NSString * expirationTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserTokenExpiration];
     NSString * expirationDate = self.pool.keychain[expirationTokenKey];
     
     if(expirationDate){
-        NSDate *expiration = [NSDate aws_dateFromString:expirationDate format:AWSDateISO8601DateFormat1];
-        NSString * refreshToken = [self refreshTokenFromKeyChain:keyChainNamespace];
-
         // Token exists, the user is confirmed
         self.confirmedStatus = AWSCognitoIdentityUserStatusConfirmed;
 
-        NSString * accessTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserAccessToken];
-        NSString * idTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserIdToken];
-        
-        NSString * idToken = self.pool.keychain[idTokenKey];
-        NSString * accessToken = self.pool.keychain[accessTokenKey];
-        
-        AWSCognitoIdentityUserSession * session;
-        
-        // Session is available if we have expiration and accessToken.
-        if (expiration && accessToken) {
-            session = [[AWSCognitoIdentityUserSession alloc] initWithIdToken:idToken
-                                                                 accessToken:accessToken
-                                                                refreshToken:refreshToken
-                                                              expirationTime:expiration];
+        // The expiration is the only item read from the keychain on every call. If it still matches the cached entry
+        // the tokens have not been changed outside of this pool and the cached session can be used as is.
+        AWSCognitoIdentityUserSessionCacheEntry * cacheEntry = [self.pool.sessionCache objectForKey:keyChainNamespace];
+        if (![cacheEntry.expirationString isEqualToString:expirationDate]) {
+            cacheEntry = [self sessionCacheEntryFromKeyChain:keyChainNamespace expirationString:expirationDate];
         }
 
-        // If the session expires > 2 minutes return it. We need to check both accessToken and id Token expiry
-        // since user can change both of them in Cognito console.
-        if(session
-           && [self isSessionValid:session]
-           && [expiration compare:[NSDate dateWithTimeIntervalSinceNow:2 * 60]] == NSOrderedDescending) {
-            return [AWSTask taskWithResult:session];
+        // If the session expires > 2 minutes return it. The cache entry accounts for both accessToken and id Token
+        // expiry since user can change both of them in Cognito console.
+        if(cacheEntry.session && [cacheEntry isValidForInterval:AWSCognitoIdentityUserSessionExpiryWindow]) {
+            // Refresh ahead of expiry in the background so that callers do not wait for the round trip later on.
+            if (cacheEntry.refreshToken && ![cacheEntry isValidForInterval:AWSCognitoIdentityUserSessionRefreshAheadWindow]) {
+                [[self refreshSession:cacheEntry.refreshToken] continueWithBlock:^id _Nullable(AWSTask<AWSCognitoIdentityUserSession *> * _Nonnull task) {
+                    if (task.error) {
+                        AWSDDLogError(@"Background session refresh failed, the next call refreshes the session before returning it: %@", task.error);
+                        [self dropCachedSession:cacheEntry keyChainNamespace:keyChainNamespace];
+                    }
+                    return nil;
+                }];
+            }
+            return [AWSTask taskWithResult:cacheEntry.session];
         }
         //else refresh it using the refresh token
-        else if(refreshToken){
-            AWSCognitoIdentityProviderInitiateAuthRequest * request = [AWSCognitoIdentityProviderInitiateAuthRequest new];
-            request.authFlow = AWSCognitoIdentityProviderAuthFlowTypeRefreshTokenAuth;
-            request.clientId = self.pool.userPoolConfiguration.clientId;
-            request.analyticsMetadata = [self.pool analyticsMetadata];
-            request.userContextData = [self.pool userContextData:self.username deviceId: [self asfDeviceId]];
-            
-            NSMutableDictionary * authParameters = [[NSMutableDictionary alloc] initWithDictionary:@{@"REFRESH_TOKEN" : refreshToken}];
-            
-            //refresh token secret hash is actually client secret for this api, set it if it is supplied
-            if(self.pool.userPoolConfiguration.clientSecret != nil){
-                [authParameters setObject:self.pool.userPoolConfiguration.clientSecret forKey:@"SECRET_HASH"];
-            }
-            
-            [self addDeviceKey:authParameters];
-            
-            request.authParameters = authParameters;
-            return [[self.pool.client initiateAuth:request] continueWithBlock:^id _Nullable(AWSTask<AWSCognitoIdentityProviderInitiateAuthResponse *> * _Nonnull task) {
-                if(task.error){
-                    //If this token is no longer valid, fall back on interactive auth.
-                    if(task.error.code == AWSCognitoIdentityProviderErrorNotAuthorized) {
-                        return [self interactiveAuth];
-                    } else {
-                        return task;
-                    }
-                }
-                
-                AWSCognitoIdentityProviderInitiateAuthResponse *response = task.result;
-                AWSCognitoIdentityProviderAuthenticationResultType *authResult = response.authenticationResult;
-                /** Check to see if refreshToken is received in the response.
-                 If not, load it from the keychain.
-                 */
-                NSString * refreshToken = authResult.refreshToken;
-                if (refreshToken == nil){
-                    NSString * keyChainNamespace = [self keyChainNamespaceClientId];
-                    refreshToken = [self refreshTokenFromKeyChain:keyChainNamespace];
+        else if(cacheEntry.refreshToken){
+            return [[self refreshSession:cacheEntry.refreshToken] continueWithBlock:^id _Nullable(AWSTask<AWSCognitoIdentityUserSession *> * _Nonnull task) {
+                //If this token is no longer valid, fall back on interactive auth.
+                if(task.error.code == AWSCognitoIdentityProviderErrorNotAuthorized) {
+                    return [self interactiveAuth];
                 }
-                AWSCognitoIdentityUserSession * session = [[AWSCognitoIdentityUserSession alloc] initWithIdToken: authResult.idToken accessToken:authResult.accessToken refreshToken:refreshToken expiresIn:authResult.expiresIn];
-                [self updateUsernameAndPersistTokens:session];
-                return [AWSTask taskWithResult:session];
+                return task;
             }];
         }
     }
     return [self setConfirmationStatus: [self interactiveAuth]];
 }
 
+/**
+ Reads the session stored in the keychain and caches it.
+ */
+- (AWSCognitoIdentityUserSessionCacheEntry *) sessionCacheEntryFromKeyChain:(NSString *) keyChainNamespace expirationString:(NSString *) expirationString {
+    NSDate *expiration = [NSDate aws_dateFromString:expirationString format:AWSDateISO8601DateFormat1];
+    NSString * refreshToken = [self refreshTokenFromKeyChain:keyChainNamespace];
+
+    NSString * accessTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserAccessToken];
+    NSString * idTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserIdToken];
+
+    NSString * idToken = self.pool.keychain[idTokenKey];
+    NSString * accessToken = self.pool.keychain[accessTokenKey];
+
+    AWSCognitoIdentityUserSession * session;
+
+    // Session is available if we have expiration and accessToken.
+    if (expiration && accessToken) {
+        session = [[AWSCognitoIdentityUserSession alloc] initWithIdToken:idToken
+                                                             accessToken:accessToken
+                                                            refreshToken:refreshToken
+                                                          expirationTime:expiration];
+    }
+
+    AWSCognitoIdentityUserSessionCacheEntry * cacheEntry = [[AWSCognitoIdentityUserSessionCacheEntry alloc] initWithSession:session
+                                                                                                                  refreshToken:refreshToken
+                                                                                                              expirationString:expirationString];
+    [self.pool.sessionCache setObject:cacheEntry forKey:keyChainNamespace];
+    return cacheEntry;
+}
+
+/**
+ Replaces the cached session with an entry that has none, so that the next call to getSession refreshes it in the
+ foreground rather than handing it out again. Leaves the cache alone if the session was changed in the meantime.
+ */
+- (void) dropCachedSession:(AWSCognitoIdentityUserSessionCacheEntry *) cacheEntry keyChainNamespace:(NSString *) keyChainNamespace {
+    AWSCognitoIdentityUserSessionCacheEntry * droppedEntry = [[AWSCognitoIdentityUserSessionCacheEntry alloc] initWithSession:nil
+                                                                                                                    refreshToken:cacheEntry.refreshToken
+                                                                                                                expirationString:cacheEntry.expirationString];
+    if ([self.pool.sessionCache objectForKey:keyChainNamespace] == cacheEntry) {
+        [self.pool.sessionCache setObject:droppedEntry forKey:keyChainNamespace];
+    }
+}
+
+/**
+ Refresh the session using the refresh token. Concurrent callers for the same user share a single InitiateAuth request.
+ */
+- (AWSTask<AWSCognitoIdentityUserSession*> *) refreshSession:(NSString *) refreshToken {
+    NSString * keyChainNamespace = [self keyChainNamespaceClientId];
+    AWSTaskCompletionSource<AWSCognitoIdentityUserSession *> *refreshCompletionSource = nil;
+    @synchronized (self.pool.sessionRefreshes) {
+        AWSTaskCompletionSource *inFlightRefresh = self.pool.sessionRefreshes[keyChainNamespace];
+        if (inFlightRefresh) {
+            return inFlightRefresh.task;
+        }
+        refreshCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+        self.pool.sessionRefreshes[keyChainNamespace] = refreshCompletionSource;
+    }
+
+    AWSCognitoIdentityProviderInitiateAuthRequest * request = [AWSCognitoIdentityProviderInitiateAuthRequest new];
+    request.authFlow = AWSCognitoIdentityProviderAuthFlowTypeRefreshTokenAuth;
+    request.clientId = self.pool.userPoolConfiguration.clientId;
+    request.analyticsMetadata = [self.pool analyticsMetadata];
+    request.userContextData = [self.pool userContextData:self.username deviceId: [self asfDeviceId]];
+    
+    NSMutableDictionary * authParameters = [[NSMutableDictionary alloc] initWithDictionary:@{@"REFRESH_TOKEN" : refreshToken}];
+    
+    //refresh token secret hash is actually client secret for this api, set it if it is supplied
+    if(self.pool.userPoolConfiguration.clientSecret != nil){
+        [authParameters setObject:self.pool.userPoolConfiguration.clientSecret forKey:@"SECRET_HASH"];
+    }
+    
+    [self addDeviceKey:authParameters];
+    
+    request.authParameters = authParameters;
+    [[self.pool.client initiateAuth:request] continueWithBlock:^id _Nullable(AWSTask<AWSCognitoIdentityProviderInitiateAuthResponse *> * _Nonnull task) {
+        AWSCognitoIdentityUserSession * session = nil;
+        if(!task.error){
+            AWSCognitoIdentityProviderInitiateAuthResponse *response = task.result;
+            AWSCognitoIdentityProviderAuthenticationResultType *authResult = response.authenticationResult;
+            /** Check to see if refreshToken is received in the response.
+             If not, use the one the refresh was made with.
+             */
+            NSString * newRefreshToken = authResult.refreshToken ?: refreshToken;
+            session = [[AWSCognitoIdentityUserSession alloc] initWithIdToken: authResult.idToken accessToken:authResult.accessToken refreshToken:newRefreshToken expiresIn:authResult.expiresIn];
+            [self updateUsernameAndPersistTokens:session];
+        }
+
+        @synchronized (self.pool.sessionRefreshes) {
+            [self.pool.sessionRefreshes removeObjectForKey:keyChainNamespace];
+        }
+        if (task.error) {
+            [refreshCompletionSource setError:task.error];
+        } else {
+            [refreshCompletionSource setResult:session];
+        }
+        return nil;
+    }];
+    return refreshCompletionSource.task;
+}
+
 - (AWSTask<AWSCognitoIdentityUserSession*>*) getSession:(NSString *) username
                                                password:(NSString *) password
                                          validationData:(NSArray<AWSCognitoIdentityUserAttributeType*>*) validationData
@@ -1454,6 +1521,7 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
                 [self.pool.keychain removeItemForKey:key];
             }
         }
+        [self.pool.sessionCache removeObjectForKey:[self keyChainNamespaceClientId]];
     }
 }
 
@@ -1469,6 +1537,7 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
         NSString * accessTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserAccessToken];
         [self.pool.keychain removeItemForKey:idTokenKey];
         [self.pool.keychain removeItemForKey:accessTokenKey];
+        [self.pool.sessionCache removeObjectForKey:keyChainNamespace];
     }
 }
 
@@ -1608,7 +1677,19 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
     }
     if(session.expirationTime){
         NSString * expirationTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserTokenExpiration];
-        self.pool.keychain[expirationTokenKey] = [session.expirationTime aws_stringValue:AWSDateISO8601DateFormat1];
+        NSString * expirationString = [session.expirationTime aws_stringValue:AWSDateISO8601DateFormat1];
+        self.pool.keychain[expirationTokenKey] = expirationString;
+
+        // Write through to the session cache. A session missing any of the tokens is only partially persisted,
+        // in which case the next read goes back to the keychain.
+        if (session.idToken && session.accessToken && session.refreshToken) {
+            AWSCognitoIdentityUserSessionCacheEntry * cacheEntry = [[AWSCognitoIdentityUserSessionCacheEntry alloc] initWithSession:session
+                                                                                                                          refreshToken:session.refreshToken.tokenString
+                                                                                                                      expirationString:expirationString];
+            [self.pool.sessionCache setObject:cacheEntry forKey:keyChainNamespace];
+        } else {
+            [self.pool.sessionCache removeObjectForKey:keyChainNamespace];
+        }
     }
 }
 
@@ -1707,6 +1788,46 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
 }
 @end
 
+@implementation AWSCognitoIdentityUserSessionCacheEntry
+
+-(instancetype) initWithSession: (AWSCognitoIdentityUserSession *) session refreshToken:(NSString *) refreshToken expirationString:(NSString *) expirationString {
+    self = [super init];
+    if(self != nil) {
+        _session = session;
+        _refreshToken = refreshToken;
+        _expirationString = expirationString;
+        _validUntil = [self expiryOfSession:session];
+    }
+    return self;
+}
+
+// The earliest of the session expiration and the `exp` claims of the access token and, if present, the id token.
+// A token without an `exp` claim is treated as expired.
+-(NSTimeInterval) expiryOfSession: (AWSCognitoIdentityUserSession *) session {
+    if (session.accessToken == nil) {
+        return 0;
+    }
+    NSTimeInterval expiry = [session.expirationTime timeIntervalSince1970];
+    NSMutableArray<AWSCognitoIdentityUserSessionToken *> *tokens = [NSMutableArray arrayWithObject:session.accessToken];
+    if (session.idToken) {
+        [tokens addObject:session.idToken];
+    }
+    for (AWSCognitoIdentityUserSessionToken *token in tokens) {
+        id exp = [token.tokenClaims valueForKey:@"exp"];
+        if (exp == nil) {
+            return 0;
+        }
+        expiry = MIN(expiry, [exp doubleValue]);
+    }
+    return expiry;
+}
+
+-(BOOL) isValidForInterval: (NSTimeInterval) interval {
+    return self.validUntil > [[NSDate date] timeIntervalSince1970] + interval;
+}
+
+@end
+
 @implementation AWSCognitoIdentityUserSessionToken
 
 -(instancetype) initWithToken:(NSString *)token {
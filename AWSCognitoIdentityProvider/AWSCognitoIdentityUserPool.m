@@ -171,6 +171,8 @@ static NSString *const AWSPinpointContextKeychainUniqueIdKey = @"com.amazonaws.A
         _userPoolConfiguration = userPoolConfiguration;
 
         _keychain = [AWSUICKeyChainStore keyChainStoreWithService:[NSString stringWithFormat:@"%@.%@", [NSBundle mainBundle].bundleIdentifier, [AWSCognitoIdentityUserPool class]]];
+        _sessionCache = [AWSSynchronizedMutableDictionary new];
+        _sessionRefreshes = [NSMutableDictionary new];
         
         
         //If Pinpoint is setup, get the endpoint or create one.
@@ -290,6 +292,9 @@ static NSString *const AWSPinpointContextKeychainUniqueIdKey = @"com.amazonaws.A
             [self.keychain removeItemForKey:key];
         }
     }
+    for (NSString *key in self.sessionCache.allKeys) {
+        [self.sessionCache removeObjectForKey:key];
+    }
 }
 
 #pragma mark identity provider
@@ -95,6 +95,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (AWSJKBigInteger*) generatePrivateABigInt:(AWSJKBigInteger*)N;
 + (AWSJKBigInteger*) generatePublicABigInt:(AWSJKBigInteger*)privateA N:(AWSJKBigInteger*)N g:(AWSJKBigInteger*)g;
++ (AWSJKBigInteger*) powG:(AWSJKBigInteger*)exponent N:(AWSJKBigInteger*)N g:(AWSJKBigInteger*)g;
 + (NSString*) generateDateString:(NSDate *)date;
 
 + (AWSJKBigInteger*) hashSignedBigInts:(NSArray*)bigInts;
@@ -23,17 +23,55 @@ AWSJKBigInteger* finalizeSignedBigIntHash(CC_SHA256_CTX *ctx);
 
 static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129024E088A67CC74020BBEA63B139B22514A08798E3404DDEF9519B3CD3A431B302B0A6DF25F14374FE1356D6D51C245E485B576625E7EC6F44C42E9A637ED6B0BFF5CB6F406B7EDEE386BFB5A899FA5AE9F24117C4B1FE649286651ECE45B3DC2007CB8A163BF0598DA48361C55D39A69163FA8FD24CF5F83655D23DCA3AD961C62F356208552BB9ED529077096966D670C354E4ABC9804F1746C08CA18217C32905E462E36CE3BE39E772C180E86039B2783A2EC07A28FB5C55DF06F4C52C9DE2BCBF6955817183995497CEA956AE515D2261898FA051015728E5A8AAAC42DAD33170D04507A33A85521ABDF1CBA64ECFB850458DBEF0A8AEA71575D060C7DB3970F85A6E1E4C7ABF5AE8CDB0933D71E8C94E04A25619DCEE3D2261AD2EE6BF12FFA06D98A0864D87602733EC86A64521F2B18177B200CBBE117577A615D6C770988C0BAD946E208E24FA074E5AB3143DB5BFCE0FD108E4B82D120A93AD2CAFFFFFFFFFFFFFFFF";
 
+// Exponents used with g are SHA-256 hashes or 256 bit random numbers.
+static const int AWSCognitoIdentityProviderSrpFixedBaseExponentBits = 256;
+// 64 entries of 384 bytes, about three times faster than a fixed window for 256 bit exponents.
+static const int AWSCognitoIdentityProviderSrpFixedBaseTeeth = 6;
+
 #pragma mark - Srp State
+@interface AWSCognitoIdentityProviderSrpCommonState()
++ (AWSCognitoIdentityProviderSrpCommonState *)defaultState;
++ (aws_mp_fixed_base *)defaultFixedBase;
+@end
+
 @implementation AWSCognitoIdentityProviderSrpCommonState
-- (instancetype)init {
-    if (self = [super init]) {
-            self.N = [[AWSJKBigInteger alloc] initWithString:N_IN_HEX
-                                               andRadix:16];
 
-            self.g = [[AWSJKBigInteger alloc] initWithUnsignedLong:2l];
-            self.k = [self calculateK:self.N g:self.g];
-    }
-    return self;
+// N, g and k never change, parse and hash them once.
++ (AWSCognitoIdentityProviderSrpCommonState *)defaultState {
+    static AWSCognitoIdentityProviderSrpCommonState *_defaultState = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        AWSJKBigInteger *N = [[AWSJKBigInteger alloc] initWithString:N_IN_HEX
+                                                            andRadix:16];
+        AWSJKBigInteger *g = [[AWSJKBigInteger alloc] initWithUnsignedLong:2l];
+        _defaultState = [[AWSCognitoIdentityProviderSrpCommonState alloc] initN:N g:g];
+    });
+    return _defaultState;
+}
+
+// Comb table for g^e mod N with the default N and g, built on first use and never freed.
++ (aws_mp_fixed_base *)defaultFixedBase {
+    static aws_mp_fixed_base _fixedBase;
+    static BOOL _fixedBaseReady = NO;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        AWSCognitoIdentityProviderSrpCommonState *defaultState = [self defaultState];
+        int result = aws_mp_fixed_base_init(&_fixedBase,
+                                            [defaultState.g value],
+                                            [defaultState.N value],
+                                            AWSCognitoIdentityProviderSrpFixedBaseExponentBits,
+                                            AWSCognitoIdentityProviderSrpFixedBaseTeeth);
+        if (result != AWS_MP_OKAY) {
+            AWSDDLogError(@"Failed to precompute the SRP fixed base table: %d", result);
+        }
+        _fixedBaseReady = (result == AWS_MP_OKAY);
+    });
+    return _fixedBaseReady ? &_fixedBase : NULL;
+}
+
+- (instancetype)init {
+    AWSCognitoIdentityProviderSrpCommonState *defaultState = [AWSCognitoIdentityProviderSrpCommonState defaultState];
+    return [self initN:defaultState.N g:defaultState.g k:defaultState.k];
 }
 
 - (instancetype)initN:(AWSJKBigInteger *)N g:(AWSJKBigInteger *)g k:(AWSJKBigInteger *)k {
@@ -183,12 +221,10 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
                               password:password
                               salt:self.salt];
 
-        AWSJKBigInteger *N = [[AWSJKBigInteger alloc] initWithString:N_IN_HEX
-                                       andRadix:16];
-        AWSJKBigInteger *g = [[AWSJKBigInteger alloc] initWithUnsignedLong:2l];
-        
+        AWSCognitoIdentityProviderSrpCommonState *defaultState = [AWSCognitoIdentityProviderSrpCommonState defaultState];
+
         //calculate v
-        self.v = [g pow:x andMod:N];
+        self.v = [AWSCognitoIdentityProviderSrpHelper powG:x N:defaultState.N g:defaultState.g];
     }
     return self;
 }
@@ -275,12 +311,12 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
 
     AWSJKBigInteger *a = self.clientState.privateA;
     AWSJKBigInteger *exp = [a add:[self.u multiply:self.x]];
-    AWSJKBigInteger *base = [B subtract:[k multiply:[g pow:self.x andMod:N]]];
+    AWSJKBigInteger *base = [B subtract:[k multiply:[AWSCognitoIdentityProviderSrpHelper powG:self.x N:N g:g]]];
 
     //Need this for negative base #s
     base = [AWSCognitoIdentityProviderSrpHelper mod:base divisor:N];
 
-    AWSJKBigInteger *S = [base pow:exp andMod:N];
+    AWSJKBigInteger *S = [base constantTimePow:exp andMod:N];
     S = [AWSCognitoIdentityProviderSrpHelper mod:S divisor:N];
     
     return S;
@@ -301,10 +337,30 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
 }
 
 + (AWSJKBigInteger*) generatePublicABigInt:(AWSJKBigInteger*)privateA N:(AWSJKBigInteger*)N g:(AWSJKBigInteger*)g {
-    AWSJKBigInteger *publicA = [g pow:privateA andMod:N];
+    AWSJKBigInteger *publicA = [AWSCognitoIdentityProviderSrpHelper powG:privateA N:N g:g];
     return publicA;
 }
 
+// g^exponent mod N for a secret exponent, using the precomputed table for the default group.
++ (AWSJKBigInteger*) powG:(AWSJKBigInteger*)exponent N:(AWSJKBigInteger*)N g:(AWSJKBigInteger*)g {
+    AWSCognitoIdentityProviderSrpCommonState *defaultState = [AWSCognitoIdentityProviderSrpCommonState defaultState];
+    aws_mp_fixed_base *fixedBase = [AWSCognitoIdentityProviderSrpCommonState defaultFixedBase];
+    if (fixedBase != NULL
+        && [N compare:defaultState.N] == NSOrderedSame
+        && [g compare:defaultState.g] == NSOrderedSame) {
+        aws_mp_int output;
+        aws_mp_init(&output);
+        int result = aws_mp_fixed_base_exptmod(fixedBase, [exponent value], &output);
+        AWSJKBigInteger *power = nil;
+        if (result == AWS_MP_OKAY) {
+            power = [[AWSJKBigInteger alloc] initWithValue:&output];
+        }
+        aws_mp_clear(&output);
+        return power;
+    }
+    return [g constantTimePow:exponent andMod:N];
+}
+
 + (AWSJKBigInteger*) mod:(AWSJKBigInteger*)dividend divisor:(AWSJKBigInteger*) divisor {
     return [[divisor add:[dividend remainder:divisor]] remainder:divisor];
 }
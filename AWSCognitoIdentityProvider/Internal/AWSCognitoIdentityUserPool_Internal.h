@@ -9,9 +9,19 @@
 #import "AWSCognitoIdentityUserPool.h"
 
 @class AWSUICKeyChainStore;
+@class AWSSynchronizedMutableDictionary;
+@class AWSTaskCompletionSource;
 
 @interface AWSCognitoIdentityUserPool()
 @property (nonatomic, strong) AWSUICKeyChainStore * _Nonnull keychain;
+/**
+ In-memory session cache, keyed by the keychain namespace of the user. Entries are written through on every keychain update.
+ */
+@property (nonatomic, strong) AWSSynchronizedMutableDictionary * _Nonnull sessionCache;
+/**
+ In-flight refresh token requests, keyed by the keychain namespace of the user. Access must be synchronized on the dictionary.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSTaskCompletionSource *> * _Nonnull sessionRefreshes;
 @property (nonatomic, readonly) AWSCognitoIdentityProviderAnalyticsMetadataType * _Nullable analyticsMetadata;
 
 - (NSString * _Nullable) calculateSecretHash: (NSString* _Nonnull) userName;
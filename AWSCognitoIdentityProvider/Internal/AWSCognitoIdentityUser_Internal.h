@@ -30,6 +30,19 @@
 - (NSString *) asfDeviceId;
 @end
 
+/**
+ A session as last read from or written to the keychain, with its expiry pre-computed from the expiration time and
+ the `exp` claims of the tokens so that cache hits do not need to decode the JWTs again.
+ */
+@interface AWSCognitoIdentityUserSessionCacheEntry : NSObject
+@property (nonatomic, strong, readonly) NSString * expirationString;
+@property (nonatomic, strong, readonly) AWSCognitoIdentityUserSession * session;
+@property (nonatomic, strong, readonly) NSString * refreshToken;
+@property (nonatomic, assign, readonly) NSTimeInterval validUntil;
+-(instancetype) initWithSession: (AWSCognitoIdentityUserSession *) session refreshToken:(NSString *) refreshToken expirationString:(NSString *) expirationString;
+-(BOOL) isValidForInterval: (NSTimeInterval) interval;
+@end
+
 @interface AWSCognitoIdentityUserMFAOption()
 - (AWSCognitoIdentityProviderMFAOptionType *) mfaOptionTypeValue;
 @end
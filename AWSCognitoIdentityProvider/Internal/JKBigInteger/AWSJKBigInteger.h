@@ -30,6 +30,8 @@
 
 - (id)pow:(unsigned int)exponent;
 - (id)pow:(AWSJKBigInteger*)exponent andMod:(AWSJKBigInteger*)modulus;
+// Same as pow:andMod: for odd moduli, but the running time does not depend on the exponent's value.
+- (id)constantTimePow:(AWSJKBigInteger*)exponent andMod:(AWSJKBigInteger*)modulus;
 - (id)negate;
 - (id)abs;
 
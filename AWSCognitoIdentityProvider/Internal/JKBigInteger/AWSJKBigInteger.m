@@ -248,6 +248,24 @@
     return newBigInteger;
 }
 
+- (id)constantTimePow:(AWSJKBigInteger*)exponent andMod: (AWSJKBigInteger*)modulus {
+
+    int result;
+    aws_mp_int output;
+    aws_mp_init(&output);
+    
+    result = aws_mp_exptmod_ct(&m_value, &exponent->m_value, &modulus->m_value, &output);
+    if (result != AWS_MP_OKAY) {
+        aws_mp_clear(&output);
+        return nil;
+    }
+    
+    AWSJKBigInteger *newBigInteger = [[AWSJKBigInteger alloc] initWithValue:&output];
+    aws_mp_clear(&output);
+    
+    return newBigInteger;
+}
+
 - (id)negate {
 
     aws_mp_int negate;
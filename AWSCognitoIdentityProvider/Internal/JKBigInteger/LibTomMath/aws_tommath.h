@@ -443,6 +443,42 @@ int aws_mp_reduce_2k_l(aws_mp_int *a, aws_mp_int *n, aws_mp_int *d);
 /* d = a**b (mod c) */
 int aws_mp_exptmod(aws_mp_int *a, aws_mp_int *b, aws_mp_int *c, aws_mp_int *d);
 
+/* ---> Constant time exponentiation <--- */
+
+/* word size used by the constant time Montgomery code */
+#if defined(__SIZEOF_INT128__)
+   typedef unsigned long long  aws_mp_ct_limb;
+   typedef unsigned __int128   aws_mp_ct_dlimb;
+   #define AWS_MP_CT_LIMB_BIT  64
+#else
+   typedef unsigned int        aws_mp_ct_limb;
+   typedef unsigned long long  aws_mp_ct_dlimb;
+   #define AWS_MP_CT_LIMB_BIT  32
+#endif
+
+/* largest modulus handled by the constant time code, larger ones use aws_mp_exptmod */
+#define AWS_MP_CT_MAX_LIMBS          (8192 / AWS_MP_CT_LIMB_BIT)
+#define AWS_MP_FIXED_BASE_MAX_TEETH  8
+
+/* precomputed comb table for a fixed base and odd modulus */
+typedef struct {
+    int used, teeth, spacing;
+    aws_mp_ct_limb rho;
+    aws_mp_ct_limb *data, *n, *one, *table;
+    aws_mp_int G, P;
+} aws_mp_fixed_base;
+
+/* d = a**b (mod c) for odd c, the running time does not depend on the value of b */
+int aws_mp_exptmod_ct(aws_mp_int *a, aws_mp_int *b, aws_mp_int *c, aws_mp_int *d);
+
+/* precompute a comb of 2**teeth entries for exponents of up to max_bits bits */
+int aws_mp_fixed_base_init(aws_mp_fixed_base *fb, aws_mp_int *G, aws_mp_int *P, int max_bits, int teeth);
+
+/* Y = G**X (mod P) for the base and modulus of fb, constant time like aws_mp_exptmod_ct */
+int aws_mp_fixed_base_exptmod(aws_mp_fixed_base *fb, aws_mp_int *X, aws_mp_int *Y);
+
+void aws_mp_fixed_base_clear(aws_mp_fixed_base *fb);
+
 /* ---> Primes <--- */
 
 /* number of primes */
@@ -40,6 +40,7 @@
 #define AWS_BN_MP_EXCH_C
 #define AWS_BN_MP_EXPT_D_C
 #define AWS_BN_MP_EXPTMOD_C
+#define AWS_BN_MP_EXPTMOD_CT_C
 #define AWS_BN_MP_EXPTMOD_FAST_C
 #define AWS_BN_MP_EXTEUCLID_C
 #define AWS_BN_MP_FREAD_C
@@ -337,6 +338,21 @@
    #define AWS_BN_MP_EXPTMOD_FAST_C
 #endif
 
+#if defined(AWS_BN_MP_EXPTMOD_CT_C)
+   #define AWS_BN_MP_EXPTMOD_C
+   #define AWS_BN_MP_INIT_C
+   #define AWS_BN_MP_INIT_COPY_C
+   #define AWS_BN_MP_CLEAR_C
+   #define AWS_BN_MP_2EXPT_C
+   #define AWS_BN_MP_MOD_C
+   #define AWS_BN_MP_SQRMOD_C
+   #define AWS_BN_MP_CMP_D_C
+   #define AWS_BN_MP_COUNT_BITS_C
+   #define AWS_BN_MP_UNSIGNED_BIN_SIZE_C
+   #define AWS_BN_MP_TO_UNSIGNED_BIN_C
+   #define AWS_BN_MP_READ_UNSIGNED_BIN_C
+#endif
+
 #if defined(AWS_BN_MP_EXPTMOD_FAST_C)
    #define AWS_BN_MP_COUNT_BITS_C
    #define AWS_BN_MP_INIT_C
@@ -4592,6 +4592,490 @@ aws_mp_clear(&M[1]);
 }
 #endif
 
+#ifdef AWS_BN_MP_EXPTMOD_CT_C
+
+/* Constant time modular exponentiation for odd moduli.
+ *
+ * The arithmetic below works on fixed length arrays of full machine words
+ * ("limbs", 64-bit where the compiler offers a 128-bit type) instead of
+ * aws_mp_int digits.  Montgomery multiplication and squaring use the
+ * finely integrated product scanning (Comba) method with a three word
+ * accumulator, every loop bound depends only on the size of the modulus,
+ * the final subtraction is done with masks, and table lookups read every
+ * entry.  The only thing the exponent influences is the number of windows,
+ * which is derived from the length of the exponent in bytes.
+ *
+ * aws_mp_exptmod_ct() uses a fixed window.  aws_mp_fixed_base_exptmod()
+ * uses a Lim-Lee comb over a table precomputed once per base and modulus,
+ * which replaces most of the squarings with table lookups.
+ */
+
+static void aws_s_mp_ct_wipe(aws_mp_ct_limb *a, int len)
+{
+  volatile aws_mp_ct_limb *p = a;
+  int ix;
+
+  for (ix = 0; ix < len; ix++) {
+    p[ix] = 0;
+  }
+}
+
+/* all ones if a == b, zero otherwise */
+static aws_mp_ct_limb aws_s_mp_ct_eq_mask(aws_mp_ct_limb a, aws_mp_ct_limb b)
+{
+  aws_mp_ct_limb d = a ^ b;
+  return ((d | ((aws_mp_ct_limb)0 - d)) >> (AWS_MP_CT_LIMB_BIT - 1)) - (aws_mp_ct_limb)1;
+}
+
+/* c = mask ? a : b */
+static void aws_s_mp_ct_select(aws_mp_ct_limb *c, const aws_mp_ct_limb *a, const aws_mp_ct_limb *b, aws_mp_ct_limb mask, int len)
+{
+  int ix;
+
+  for (ix = 0; ix < len; ix++) {
+    c[ix] = (a[ix] & mask) | (b[ix] & ~mask);
+  }
+}
+
+/* c = table[index], reading every entry of the table */
+static void aws_s_mp_ct_lookup(aws_mp_ct_limb *c, const aws_mp_ct_limb *table, int entries, int index, int len)
+{
+  int ix, iy;
+
+  for (iy = 0; iy < len; iy++) {
+    c[iy] = 0;
+  }
+  for (ix = 0; ix < entries; ix++) {
+    aws_mp_ct_limb mask = aws_s_mp_ct_eq_mask((aws_mp_ct_limb)ix, (aws_mp_ct_limb)index);
+    const aws_mp_ct_limb *entry = table + (size_t)ix * len;
+    for (iy = 0; iy < len; iy++) {
+      c[iy] |= entry[iy] & mask;
+    }
+  }
+}
+
+/* -1/n0 mod 2**AWS_MP_CT_LIMB_BIT by Newton iteration, n0 must be odd */
+static aws_mp_ct_limb aws_s_mp_ct_montgomery_setup(aws_mp_ct_limb n0)
+{
+  aws_mp_ct_limb x = n0;   /* correct to 3 bits */
+  int ix;
+
+  for (ix = 0; ix < 6; ix++) {
+    x *= (aws_mp_ct_limb)2 - n0 * x;
+  }
+  return (aws_mp_ct_limb)0 - x;
+}
+
+/* (t2:t) += a * b, the accumulator is a double limb plus a carry limb */
+#define AWS_MP_CT_MULADD(a, b)                                                   \
+  do {                                                                           \
+    aws_mp_ct_dlimb p_ = (aws_mp_ct_dlimb)(a) * (b);                             \
+    t += p_;                                                                     \
+    t2 += (aws_mp_ct_limb)(t < p_);                                              \
+  } while (0)
+
+/* (t2:t) += 2 * a * b */
+#define AWS_MP_CT_MULADD2(a, b)                                                  \
+  do {                                                                           \
+    aws_mp_ct_dlimb p_ = (aws_mp_ct_dlimb)(a) * (b);                             \
+    t2 += (aws_mp_ct_limb)(p_ >> (2 * AWS_MP_CT_LIMB_BIT - 1));                  \
+    p_ <<= 1;                                                                    \
+    t += p_;                                                                     \
+    t2 += (aws_mp_ct_limb)(t < p_);                                              \
+  } while (0)
+
+/* shift the accumulator down by one limb */
+#define AWS_MP_CT_SHIFT()                                                        \
+  do {                                                                           \
+    t = (t >> AWS_MP_CT_LIMB_BIT) | ((aws_mp_ct_dlimb)t2 << AWS_MP_CT_LIMB_BIT); \
+    t2 = 0;                                                                      \
+  } while (0)
+
+/* r = r - n if (carry:r) >= n, for r < 2n */
+static void aws_s_mp_ct_final_sub(aws_mp_ct_limb *r, aws_mp_ct_limb carry, const aws_mp_ct_limb *n, int len)
+{
+  aws_mp_ct_limb d[AWS_MP_CT_MAX_LIMBS];
+  aws_mp_ct_limb borrow = 0, mask;
+  int ix;
+
+  for (ix = 0; ix < len; ix++) {
+    aws_mp_ct_dlimb t = (aws_mp_ct_dlimb)r[ix] - n[ix] - borrow;
+    d[ix] = (aws_mp_ct_limb)t;
+    borrow = (aws_mp_ct_limb)(t >> AWS_MP_CT_LIMB_BIT) & 1;
+  }
+  /* keep r only when there was no carry out and the subtraction borrowed */
+  mask = aws_s_mp_ct_eq_mask(carry, 0) & ((aws_mp_ct_limb)0 - borrow);
+  aws_s_mp_ct_select(r, r, d, mask, len);
+}
+
+/* r = a * b / R mod n, r may alias a or b */
+static void aws_s_mp_ct_mont_mul(aws_mp_ct_limb *r, const aws_mp_ct_limb *a, const aws_mp_ct_limb *b,
+                                 const aws_mp_ct_limb *n, aws_mp_ct_limb rho, int len)
+{
+  aws_mp_ct_limb m[AWS_MP_CT_MAX_LIMBS], out[AWS_MP_CT_MAX_LIMBS];
+  aws_mp_ct_dlimb t = 0;
+  aws_mp_ct_limb t2 = 0;
+  int ix, iy;
+
+  for (ix = 0; ix < len; ix++) {
+    for (iy = 0; iy < ix; iy++) {
+      AWS_MP_CT_MULADD(a[iy], b[ix - iy]);
+      AWS_MP_CT_MULADD(m[iy], n[ix - iy]);
+    }
+    AWS_MP_CT_MULADD(a[ix], b[0]);
+    m[ix] = (aws_mp_ct_limb)t * rho;
+    AWS_MP_CT_MULADD(m[ix], n[0]);
+    AWS_MP_CT_SHIFT();
+  }
+  for (ix = len; ix < 2 * len; ix++) {
+    for (iy = ix - len + 1; iy < len; iy++) {
+      AWS_MP_CT_MULADD(a[iy], b[ix - iy]);
+      AWS_MP_CT_MULADD(m[iy], n[ix - iy]);
+    }
+    out[ix - len] = (aws_mp_ct_limb)t;
+    AWS_MP_CT_SHIFT();
+  }
+  aws_s_mp_ct_final_sub(out, (aws_mp_ct_limb)t, n, len);
+  memcpy(r, out, (size_t)len * sizeof(aws_mp_ct_limb));
+}
+
+/* r = a * a / R mod n, r may alias a */
+static void aws_s_mp_ct_mont_sqr(aws_mp_ct_limb *r, const aws_mp_ct_limb *a,
+                                 const aws_mp_ct_limb *n, aws_mp_ct_limb rho, int len)
+{
+  aws_mp_ct_limb m[AWS_MP_CT_MAX_LIMBS], out[AWS_MP_CT_MAX_LIMBS];
+  aws_mp_ct_dlimb t = 0;
+  aws_mp_ct_limb t2 = 0;
+  int ix, iy;
+
+  for (ix = 0; ix < len; ix++) {
+    for (iy = 0; iy < (ix + 1) / 2; iy++) {
+      AWS_MP_CT_MULADD2(a[iy], a[ix - iy]);
+    }
+    if ((ix & 1) == 0) {
+      AWS_MP_CT_MULADD(a[ix / 2], a[ix / 2]);
+    }
+    for (iy = 0; iy < ix; iy++) {
+      AWS_MP_CT_MULADD(m[iy], n[ix - iy]);
+    }
+    m[ix] = (aws_mp_ct_limb)t * rho;
+    AWS_MP_CT_MULADD(m[ix], n[0]);
+    AWS_MP_CT_SHIFT();
+  }
+  for (ix = len; ix < 2 * len; ix++) {
+    for (iy = ix - len + 1; iy < (ix + 1) / 2; iy++) {
+      AWS_MP_CT_MULADD2(a[iy], a[ix - iy]);
+    }
+    if ((ix & 1) == 0) {
+      AWS_MP_CT_MULADD(a[ix / 2], a[ix / 2]);
+    }
+    for (iy = ix - len + 1; iy < len; iy++) {
+      AWS_MP_CT_MULADD(m[iy], n[ix - iy]);
+    }
+    out[ix - len] = (aws_mp_ct_limb)t;
+    AWS_MP_CT_SHIFT();
+  }
+  aws_s_mp_ct_final_sub(out, (aws_mp_ct_limb)t, n, len);
+  memcpy(r, out, (size_t)len * sizeof(aws_mp_ct_limb));
+}
+
+/* number of limbs needed for |a| */
+static int aws_s_mp_ct_limbs(aws_mp_int *a)
+{
+  int bytes = aws_mp_unsigned_bin_size(a);
+  return (bytes + (int)sizeof(aws_mp_ct_limb) - 1) / (int)sizeof(aws_mp_ct_limb);
+}
+
+/* little endian limbs of |a|, zero padded to len limbs (|a| must fit) */
+static int aws_s_mp_ct_to_limbs(aws_mp_int *a, aws_mp_ct_limb *out, int len)
+{
+  unsigned char buf[AWS_MP_CT_MAX_LIMBS * sizeof(aws_mp_ct_limb)];
+  int bytes, ix, res;
+
+  bytes = aws_mp_unsigned_bin_size(a);
+  if (bytes > len * (int)sizeof(aws_mp_ct_limb)) {
+    return AWS_MP_VAL;
+  }
+  if ((res = aws_mp_to_unsigned_bin(a, buf)) != AWS_MP_OKAY) {
+    return res;
+  }
+  for (ix = 0; ix < len; ix++) {
+    out[ix] = 0;
+  }
+  /* buf is big endian */
+  for (ix = 0; ix < bytes; ix++) {
+    out[ix / sizeof(aws_mp_ct_limb)] |= ((aws_mp_ct_limb)buf[bytes - 1 - ix]) << (8 * (ix % sizeof(aws_mp_ct_limb)));
+  }
+  memset(buf, 0, sizeof(buf));
+  return AWS_MP_OKAY;
+}
+
+static int aws_s_mp_ct_from_limbs(const aws_mp_ct_limb *a, int len, aws_mp_int *out)
+{
+  unsigned char buf[AWS_MP_CT_MAX_LIMBS * sizeof(aws_mp_ct_limb)];
+  int bytes = len * (int)sizeof(aws_mp_ct_limb);
+  int ix, res;
+
+  for (ix = 0; ix < bytes; ix++) {
+    buf[bytes - 1 - ix] = (unsigned char)(a[ix / sizeof(aws_mp_ct_limb)] >> (8 * (ix % sizeof(aws_mp_ct_limb))));
+  }
+  res = aws_mp_read_unsigned_bin(out, buf, bytes);
+  memset(buf, 0, sizeof(buf));
+  return res;
+}
+
+/* bit i of the little endian limb array e, zero past the end */
+static int aws_s_mp_ct_bit(const aws_mp_ct_limb *e, int elen, int i)
+{
+  int limb = i / AWS_MP_CT_LIMB_BIT;
+  if (limb >= elen) {
+    return 0;
+  }
+  return (int)((e[limb] >> (i % AWS_MP_CT_LIMB_BIT)) & 1);
+}
+
+/* the modulus in limbs plus R mod n and R**2 mod n, R = 2**(len * AWS_MP_CT_LIMB_BIT) */
+static int aws_s_mp_ct_setup(aws_mp_int *P, aws_mp_ct_limb *n, aws_mp_ct_limb *rmodn, aws_mp_ct_limb *r2modn, int *len, aws_mp_ct_limb *rho)
+{
+  aws_mp_int t;
+  int res;
+
+  /* only odd moduli > 1 that fit the fixed size buffers */
+  if (P->sign == AWS_MP_NEG || aws_mp_iseven(P) || aws_mp_cmp_d(P, 1) != AWS_MP_GT) {
+    return AWS_MP_VAL;
+  }
+  *len = aws_s_mp_ct_limbs(P);
+  if (*len > AWS_MP_CT_MAX_LIMBS) {
+    return AWS_MP_VAL;
+  }
+  if ((res = aws_s_mp_ct_to_limbs(P, n, *len)) != AWS_MP_OKAY) {
+    return res;
+  }
+  *rho = aws_s_mp_ct_montgomery_setup(n[0]);
+
+  if ((res = aws_mp_init(&t)) != AWS_MP_OKAY) {
+    return res;
+  }
+  if ((res = aws_mp_2expt(&t, *len * AWS_MP_CT_LIMB_BIT)) != AWS_MP_OKAY ||
+      (res = aws_mp_mod(&t, P, &t)) != AWS_MP_OKAY ||
+      (res = aws_s_mp_ct_to_limbs(&t, rmodn, *len)) != AWS_MP_OKAY ||
+      (res = aws_mp_sqrmod(&t, P, &t)) != AWS_MP_OKAY ||
+      (res = aws_s_mp_ct_to_limbs(&t, r2modn, *len)) != AWS_MP_OKAY) {
+    aws_mp_clear(&t);
+    return res;
+  }
+  aws_mp_clear(&t);
+  return AWS_MP_OKAY;
+}
+
+/* G mod n in Montgomery form */
+static int aws_s_mp_ct_to_montgomery(aws_mp_int *G, aws_mp_int *P, const aws_mp_ct_limb *n, const aws_mp_ct_limb *r2modn,
+                                     aws_mp_ct_limb rho, int len, aws_mp_ct_limb *out)
+{
+  aws_mp_int g;
+  int res;
+
+  if ((res = aws_mp_init(&g)) != AWS_MP_OKAY) {
+    return res;
+  }
+  if ((res = aws_mp_mod(G, P, &g)) == AWS_MP_OKAY &&
+      (res = aws_s_mp_ct_to_limbs(&g, out, len)) == AWS_MP_OKAY) {
+    aws_s_mp_ct_mont_mul(out, out, r2modn, n, rho, len);
+  }
+  aws_mp_clear(&g);
+  return res;
+}
+
+/* Y = montgomery value a converted back to normal form */
+static int aws_s_mp_ct_from_montgomery(aws_mp_ct_limb *a, const aws_mp_ct_limb *n, aws_mp_ct_limb rho, int len, aws_mp_int *Y)
+{
+  aws_mp_ct_limb one[AWS_MP_CT_MAX_LIMBS];
+  int ix;
+
+  one[0] = 1;
+  for (ix = 1; ix < len; ix++) {
+    one[ix] = 0;
+  }
+  aws_s_mp_ct_mont_mul(a, a, one, n, rho, len);
+  return aws_s_mp_ct_from_limbs(a, len, Y);
+}
+
+int aws_mp_exptmod_ct(aws_mp_int *G, aws_mp_int *X, aws_mp_int *P, aws_mp_int *Y)
+{
+  aws_mp_ct_limb n[AWS_MP_CT_MAX_LIMBS], rmodn[AWS_MP_CT_MAX_LIMBS], r2modn[AWS_MP_CT_MAX_LIMBS];
+  aws_mp_ct_limb e[AWS_MP_CT_MAX_LIMBS], acc[AWS_MP_CT_MAX_LIMBS], sel[AWS_MP_CT_MAX_LIMBS];
+  aws_mp_ct_limb rho, *table;
+  int len, elen, winsize, entries, windows, ix, iy, res;
+
+  /* negative exponents and unsupported moduli take the regular path */
+  if (X->sign == AWS_MP_NEG || aws_s_mp_ct_setup(P, n, rmodn, r2modn, &len, &rho) != AWS_MP_OKAY) {
+    return aws_mp_exptmod(G, X, P, Y);
+  }
+  elen = aws_s_mp_ct_limbs(X);
+  if (elen > AWS_MP_CT_MAX_LIMBS) {
+    return aws_mp_exptmod(G, X, P, Y);
+  }
+  if ((res = aws_s_mp_ct_to_limbs(X, e, elen)) != AWS_MP_OKAY) {
+    return res;
+  }
+
+  winsize = (elen * AWS_MP_CT_LIMB_BIT > 256) ? 5 : 4;
+  entries = 1 << winsize;
+  table = AWS_OPT_CAST(aws_mp_ct_limb) AWS_XMALLOC((size_t)entries * len * sizeof(aws_mp_ct_limb));
+  if (table == NULL) {
+    aws_s_mp_ct_wipe(e, elen);
+    return AWS_MP_MEM;
+  }
+
+  /* table[i] = G**i in Montgomery form */
+  memcpy(table, rmodn, (size_t)len * sizeof(aws_mp_ct_limb));
+  if ((res = aws_s_mp_ct_to_montgomery(G, P, n, r2modn, rho, len, table + len)) != AWS_MP_OKAY) {
+    goto LBL_TABLE;
+  }
+  for (ix = 2; ix < entries; ix++) {
+    aws_s_mp_ct_mont_mul(table + (size_t)ix * len, table + (size_t)(ix - 1) * len, table + len, n, rho, len);
+  }
+
+  /* fixed window, left to right, one multiplication per window whatever its value */
+  windows = (elen * AWS_MP_CT_LIMB_BIT + winsize - 1) / winsize;
+  memcpy(acc, rmodn, (size_t)len * sizeof(aws_mp_ct_limb));
+  for (ix = windows - 1; ix >= 0; ix--) {
+    int window = 0;
+    if (ix != windows - 1) {
+      for (iy = 0; iy < winsize; iy++) {
+        aws_s_mp_ct_mont_sqr(acc, acc, n, rho, len);
+      }
+    }
+    for (iy = winsize - 1; iy >= 0; iy--) {
+      window = (window << 1) | aws_s_mp_ct_bit(e, elen, ix * winsize + iy);
+    }
+    aws_s_mp_ct_lookup(sel, table, entries, window, len);
+    aws_s_mp_ct_mont_mul(acc, acc, sel, n, rho, len);
+  }
+
+  res = aws_s_mp_ct_from_montgomery(acc, n, rho, len, Y);
+
+LBL_TABLE:
+  aws_s_mp_ct_wipe(table, entries * len);
+  AWS_XFREE(table);
+  aws_s_mp_ct_wipe(e, elen);
+  aws_s_mp_ct_wipe(acc, len);
+  aws_s_mp_ct_wipe(sel, len);
+  return res;
+}
+
+int aws_mp_fixed_base_init(aws_mp_fixed_base *fb, aws_mp_int *G, aws_mp_int *P, int max_bits, int teeth)
+{
+  aws_mp_ct_limb n[AWS_MP_CT_MAX_LIMBS], rmodn[AWS_MP_CT_MAX_LIMBS], r2modn[AWS_MP_CT_MAX_LIMBS];
+  aws_mp_ct_limb *power;
+  int len, entries, ix, iy, res;
+
+  memset(fb, 0, sizeof(*fb));
+  if (max_bits <= 0 || teeth <= 0 || teeth > AWS_MP_FIXED_BASE_MAX_TEETH) {
+    return AWS_MP_VAL;
+  }
+  if ((res = aws_s_mp_ct_setup(P, n, rmodn, r2modn, &len, &fb->rho)) != AWS_MP_OKAY) {
+    return res;
+  }
+
+  /* data is [modulus | R mod n | table] */
+  entries = 1 << teeth;
+  fb->data = AWS_OPT_CAST(aws_mp_ct_limb) AWS_XMALLOC((size_t)(entries + 2) * len * sizeof(aws_mp_ct_limb));
+  if (fb->data == NULL) {
+    return AWS_MP_MEM;
+  }
+  fb->used = len;
+  fb->teeth = teeth;
+  fb->spacing = (max_bits + teeth - 1) / teeth;
+  fb->n = fb->data;
+  fb->one = fb->data + len;
+  fb->table = fb->data + 2 * len;
+  memcpy(fb->n, n, (size_t)len * sizeof(aws_mp_ct_limb));
+  memcpy(fb->one, rmodn, (size_t)len * sizeof(aws_mp_ct_limb));
+
+  /* table[v] is the product of G**(2**(t * spacing)) over the bits t set in v */
+  memcpy(fb->table, fb->one, (size_t)len * sizeof(aws_mp_ct_limb));
+  power = fb->table + len;
+  if ((res = aws_s_mp_ct_to_montgomery(G, P, fb->n, r2modn, fb->rho, len, power)) != AWS_MP_OKAY) {
+    goto LBL_ERR;
+  }
+  for (ix = 1; ix < teeth; ix++) {
+    aws_mp_ct_limb *next = fb->table + ((size_t)1 << ix) * len;
+    memcpy(next, power, (size_t)len * sizeof(aws_mp_ct_limb));
+    for (iy = 0; iy < fb->spacing; iy++) {
+      aws_s_mp_ct_mont_sqr(next, next, fb->n, fb->rho, len);
+    }
+    power = next;
+  }
+  for (ix = 3; ix < entries; ix++) {
+    int rest = ix & (ix - 1);
+    if (rest == 0) {
+      continue;   /* a single tooth, computed above */
+    }
+    aws_s_mp_ct_mont_mul(fb->table + (size_t)ix * len, fb->table + (size_t)rest * len,
+                         fb->table + (size_t)(ix ^ rest) * len, fb->n, fb->rho, len);
+  }
+
+  if ((res = aws_mp_init_copy(&fb->G, G)) != AWS_MP_OKAY) {
+    goto LBL_ERR;
+  }
+  if ((res = aws_mp_init_copy(&fb->P, P)) != AWS_MP_OKAY) {
+    aws_mp_clear(&fb->G);
+    goto LBL_ERR;
+  }
+  return AWS_MP_OKAY;
+
+LBL_ERR:
+  AWS_XFREE(fb->data);
+  memset(fb, 0, sizeof(*fb));
+  return res;
+}
+
+int aws_mp_fixed_base_exptmod(aws_mp_fixed_base *fb, aws_mp_int *X, aws_mp_int *Y)
+{
+  aws_mp_ct_limb e[AWS_MP_CT_MAX_LIMBS], acc[AWS_MP_CT_MAX_LIMBS], sel[AWS_MP_CT_MAX_LIMBS];
+  int len = fb->used, elen, ix, iy, res;
+
+  /* exponents that do not fit the comb use the fixed window */
+  if (X->sign == AWS_MP_NEG || aws_mp_count_bits(X) > fb->spacing * fb->teeth) {
+    return aws_mp_exptmod_ct(&fb->G, X, &fb->P, Y);
+  }
+  elen = (fb->spacing * fb->teeth + AWS_MP_CT_LIMB_BIT - 1) / AWS_MP_CT_LIMB_BIT;
+  if ((res = aws_s_mp_ct_to_limbs(X, e, elen)) != AWS_MP_OKAY) {
+    return res;
+  }
+
+  memcpy(acc, fb->one, (size_t)len * sizeof(aws_mp_ct_limb));
+  for (ix = fb->spacing - 1; ix >= 0; ix--) {
+    int index = 0;
+    if (ix != fb->spacing - 1) {
+      aws_s_mp_ct_mont_sqr(acc, acc, fb->n, fb->rho, len);
+    }
+    for (iy = fb->teeth - 1; iy >= 0; iy--) {
+      index = (index << 1) | aws_s_mp_ct_bit(e, elen, iy * fb->spacing + ix);
+    }
+    aws_s_mp_ct_lookup(sel, fb->table, 1 << fb->teeth, index, len);
+    aws_s_mp_ct_mont_mul(acc, acc, sel, fb->n, fb->rho, len);
+  }
+
+  res = aws_s_mp_ct_from_montgomery(acc, fb->n, fb->rho, len, Y);
+  aws_s_mp_ct_wipe(e, elen);
+  aws_s_mp_ct_wipe(acc, len);
+  aws_s_mp_ct_wipe(sel, len);
+  return res;
+}
+
+void aws_mp_fixed_base_clear(aws_mp_fixed_base *fb)
+{
+  if (fb->data != NULL) {
+    aws_mp_clear(&fb->G);
+    aws_mp_clear(&fb->P);
+    AWS_XFREE(fb->data);
+  }
+  memset(fb, 0, sizeof(*fb));
+}
+#endif
+
 #ifdef AWS_BN_S_MP_ADD_C
 
 /* low level addition, based on HAC pp.594, Algorithm 14.7 */
@@ -0,0 +1,130 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCognitoIdentityProviderSrpHelper.h"
+#import "AWSJKBigInteger.h"
+
+static NSString *const AWSSrpTestPoolName = @"abcdefghi";
+static NSString *const AWSSrpTestUserName = @"srp-test-user";
+static NSString *const AWSSrpTestPassword = @"Password1!";
+static NSString *const AWSSrpTestDerivedKeyInfo = @"Caldera Derived Key";
+
+@interface AWSCognitoIdentityProviderSrpHelperTests : XCTestCase
+
+@end
+
+@implementation AWSCognitoIdentityProviderSrpHelperTests
+
+- (AWSJKBigInteger *)randomBigIntegerWithBytes:(NSUInteger)byteCount {
+    NSMutableData *data = [NSMutableData dataWithLength:byteCount];
+    XCTAssertEqual(SecRandomCopyBytes(kSecRandomDefault, byteCount, data.mutableBytes), 0);
+    aws_mp_int value;
+    aws_mp_init(&value);
+    aws_mp_read_unsigned_bin(&value, data.mutableBytes, (int)byteCount);
+    AWSJKBigInteger *result = [[AWSJKBigInteger alloc] initWithValue:&value];
+    aws_mp_clear(&value);
+    return result;
+}
+
+- (void)testConstantTimePowMatchesPowAndMod {
+    AWSCognitoIdentityProviderSrpCommonState *commonState = [AWSCognitoIdentityProviderSrpCommonState new];
+    AWSJKBigInteger *smallModulus = [[AWSJKBigInteger alloc] initWithString:@"340282366920938463463374607431768211507"];
+
+    for (int i = 0; i < 20; i++) {
+        AWSJKBigInteger *base = [self randomBigIntegerWithBytes:384];
+        AWSJKBigInteger *exponent = [self randomBigIntegerWithBytes:(i % 2 == 0) ? 32 : 64];
+
+        XCTAssertEqualObjects([[base constantTimePow:exponent andMod:commonState.N] stringValue],
+                              [[base pow:exponent andMod:commonState.N] stringValue]);
+        XCTAssertEqualObjects([[base constantTimePow:exponent andMod:smallModulus] stringValue],
+                              [[base pow:exponent andMod:smallModulus] stringValue]);
+    }
+
+    AWSJKBigInteger *zero = [[AWSJKBigInteger alloc] initWithUnsignedLong:0];
+    XCTAssertEqualObjects([[commonState.g constantTimePow:zero andMod:commonState.N] stringValue], @"1");
+}
+
+- (void)testPowGMatchesPowAndMod {
+    AWSCognitoIdentityProviderSrpCommonState *commonState = [AWSCognitoIdentityProviderSrpCommonState new];
+
+    for (int i = 0; i < 20; i++) {
+        // Includes exponents longer than the precomputed table covers.
+        AWSJKBigInteger *exponent = [self randomBigIntegerWithBytes:(i % 4 == 0) ? 48 : 32];
+        XCTAssertEqualObjects([[AWSCognitoIdentityProviderSrpHelper powG:exponent N:commonState.N g:commonState.g] stringValue],
+                              [[commonState.g pow:exponent andMod:commonState.N] stringValue]);
+    }
+
+    AWSJKBigInteger *otherG = [[AWSJKBigInteger alloc] initWithUnsignedLong:5];
+    AWSJKBigInteger *exponent = [self randomBigIntegerWithBytes:32];
+    XCTAssertEqualObjects([[AWSCognitoIdentityProviderSrpHelper powG:exponent N:commonState.N g:otherG] stringValue],
+                          [[otherG pow:exponent andMod:commonState.N] stringValue]);
+}
+
+// Plays the server side of SRP-6a and checks that both sides agree on S.
+- (void)testClientAndServerComputeSameSecret {
+    AWSCognitoIdentityProviderSrpHelper *verifier = [[AWSCognitoIdentityProviderSrpHelper alloc] initWithPoolName:AWSSrpTestPoolName
+                                                                                                          userName:AWSSrpTestUserName
+                                                                                                          password:AWSSrpTestPassword];
+    AWSCognitoIdentityProviderSrpHelper *client = [AWSCognitoIdentityProviderSrpHelper beginUserAuthentication:AWSSrpTestUserName
+                                                                                                    password:AWSSrpTestPassword];
+    AWSJKBigInteger *N = client.commonState.N;
+    AWSJKBigInteger *g = client.commonState.g;
+    AWSJKBigInteger *k = client.commonState.k;
+
+    // B = kv + g^b
+    AWSJKBigInteger *b = [self randomBigIntegerWithBytes:32];
+    AWSJKBigInteger *publicB = [[[k multiply:verifier.v] add:[g pow:b andMod:N]] remainder:N];
+
+    AWSCognitoIdentityProviderSrpServerState *serverState = [AWSCognitoIdentityProviderSrpServerState serverStateForPoolName:AWSSrpTestPoolName
+                                                                                                           publicBHexString:[publicB stringValueWithRadix:16]
+                                                                                                              saltHexString:[verifier.salt stringValueWithRadix:16]
+                                                                                                             derivedKeyInfo:AWSSrpTestDerivedKeyInfo
+                                                                                                             derivedKeySize:16
+                                                                                                         serviceSecretBlock:[NSData data]];
+    XCTAssertNotNil([client completeAuthentication:serverState]);
+
+    // S = (A * v^u)^b
+    AWSJKBigInteger *u = [AWSCognitoIdentityProviderSrpHelper hashBigInts:@[client.clientState.publicA, publicB]];
+    AWSJKBigInteger *serverS = [[client.clientState.publicA multiply:[verifier.v pow:u andMod:N]] pow:b andMod:N];
+
+    XCTAssertEqualObjects([client.S stringValue], [serverS stringValue]);
+}
+
+- (void)testLoginPerformance {
+    AWSCognitoIdentityProviderSrpHelper *verifier = [[AWSCognitoIdentityProviderSrpHelper alloc] initWithPoolName:AWSSrpTestPoolName
+                                                                                                          userName:AWSSrpTestUserName
+                                                                                                          password:AWSSrpTestPassword];
+    AWSCognitoIdentityProviderSrpCommonState *commonState = [AWSCognitoIdentityProviderSrpCommonState new];
+    AWSJKBigInteger *publicB = [[[commonState.k multiply:verifier.v] add:[commonState.g pow:[self randomBigIntegerWithBytes:32] andMod:commonState.N]] remainder:commonState.N];
+    AWSCognitoIdentityProviderSrpServerState *serverState = [AWSCognitoIdentityProviderSrpServerState serverStateForPoolName:AWSSrpTestPoolName
+                                                                                                           publicBHexString:[publicB stringValueWithRadix:16]
+                                                                                                              saltHexString:[verifier.salt stringValueWithRadix:16]
+                                                                                                             derivedKeyInfo:AWSSrpTestDerivedKeyInfo
+                                                                                                             derivedKeySize:16
+                                                                                                         serviceSecretBlock:[NSData data]];
+    const int logins = 20;
+    [self measureBlock:^{
+        NSDate *start = [NSDate date];
+        for (int i = 0; i < logins; i++) {
+            AWSCognitoIdentityProviderSrpHelper *client = [AWSCognitoIdentityProviderSrpHelper beginUserAuthentication:AWSSrpTestUserName
+                                                                                                            password:AWSSrpTestPassword];
+            [client completeAuthentication:serverState];
+        }
+        NSLog(@"SRP logins/sec: %.1f", logins / -[start timeIntervalSinceNow]);
+    }];
+}
+
+@end
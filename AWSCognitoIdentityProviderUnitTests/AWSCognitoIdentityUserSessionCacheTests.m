@@ -0,0 +1,176 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSCognitoIdentityProvider.h"
+#import "AWSCognitoIdentityUser_Internal.h"
+#import "AWSCognitoIdentityUserPool_Internal.h"
+
+static NSString *const AWSCognitoIdentityUserSessionCacheTestsPoolKey = @"AWSCognitoIdentityUserSessionCacheTests";
+
+@interface AWSCognitoIdentityUserPool()
+
+@property (nonatomic, strong) AWSCognitoIdentityProvider *client;
+
+@end
+
+@interface AWSCognitoIdentityUser()
+
+- (void) updateUsernameAndPersistTokens: (AWSCognitoIdentityUserSession *) session;
+
+@end
+
+@interface AWSCognitoIdentityUserSessionCacheTests : XCTestCase
+
+@property (nonatomic, strong) AWSCognitoIdentityUserPool *pool;
+@property (nonatomic, strong) AWSCognitoIdentityUser *user;
+@property (nonatomic, strong) id mockClient;
+// The task every `initiateAuth:` request returns, and the number of requests made.
+@property (atomic, strong) AWSTask<AWSCognitoIdentityProviderInitiateAuthResponse *> *initiateAuthTask;
+@property (atomic, assign) NSUInteger initiateAuthCount;
+
+@end
+
+@implementation AWSCognitoIdentityUserSessionCacheTests
+
+- (void)setUp {
+    [super setUp];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:nil];
+    AWSCognitoIdentityUserPoolConfiguration *userPoolConfiguration = [[AWSCognitoIdentityUserPoolConfiguration alloc] initWithClientId:@"sessionCacheTestsClientId"
+                                                                                                                          clientSecret:nil
+                                                                                                                                poolId:@"us-east-1_sessionCacheTests"];
+    [AWSCognitoIdentityUserPool registerCognitoIdentityUserPoolWithConfiguration:configuration
+                                                           userPoolConfiguration:userPoolConfiguration
+                                                                          forKey:AWSCognitoIdentityUserSessionCacheTestsPoolKey];
+    self.pool = [AWSCognitoIdentityUserPool CognitoIdentityUserPoolForKey:AWSCognitoIdentityUserSessionCacheTestsPoolKey];
+
+    self.mockClient = OCMClassMock([AWSCognitoIdentityProvider class]);
+    OCMStub([self.mockClient initiateAuth:[OCMArg any]]).andDo(^(NSInvocation *invocation) {
+        self.initiateAuthCount++;
+        AWSTask *task = self.initiateAuthTask;
+        [invocation setReturnValue:&task];
+    });
+    self.pool.client = self.mockClient;
+
+    self.user = [self.pool getUser:@"sessionCacheTestsUser"];
+}
+
+- (void)tearDown {
+    [self.user signOut];
+    [self.mockClient stopMocking];
+    [AWSCognitoIdentityUserPool removeCognitoIdentityUserPoolForKey:AWSCognitoIdentityUserSessionCacheTestsPoolKey];
+    [super tearDown];
+}
+
+- (void)testCachedSessionIsReturnedWithoutRefresh {
+    AWSCognitoIdentityUserSession *session = [self sessionExpiringIn:60 * 60];
+    [self.user updateUsernameAndPersistTokens:session];
+
+    for (int i = 0; i < 10; i++) {
+        AWSTask<AWSCognitoIdentityUserSession *> *task = [self.user getSession];
+        XCTAssertTrue(task.completed);
+        // The session written through is returned as is, without reading the tokens back from the keychain.
+        XCTAssertEqual(task.result, session);
+    }
+    XCTAssertEqual(self.initiateAuthCount, 0);
+}
+
+- (void)testExpiredSessionIsRefreshed {
+    [self.user updateUsernameAndPersistTokens:[self sessionExpiringIn:60]];
+    self.initiateAuthTask = [AWSTask taskWithResult:[self initiateAuthResponseExpiringIn:60 * 60]];
+
+    AWSTask<AWSCognitoIdentityUserSession *> *task = [[self.user getSession] waitUntilFinished];
+    XCTAssertNil(task.error);
+    XCTAssertGreaterThan([task.result.expirationTime timeIntervalSinceNow], 50 * 60);
+    XCTAssertEqual(self.initiateAuthCount, 1);
+
+    // The refreshed session is cached.
+    XCTAssertEqual([[self.user getSession] result], task.result);
+    XCTAssertEqual(self.initiateAuthCount, 1);
+}
+
+- (void)testConcurrentCallersShareOneRefresh {
+    [self.user updateUsernameAndPersistTokens:[self sessionExpiringIn:60]];
+    AWSTaskCompletionSource<AWSCognitoIdentityProviderInitiateAuthResponse *> *refresh = [AWSTaskCompletionSource taskCompletionSource];
+    self.initiateAuthTask = refresh.task;
+
+    NSMutableArray<AWSTask<AWSCognitoIdentityUserSession *> *> *tasks = [NSMutableArray new];
+    dispatch_apply(20, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        AWSTask<AWSCognitoIdentityUserSession *> *task = [self.user getSession];
+        @synchronized(tasks) {
+            [tasks addObject:task];
+        }
+    });
+    [refresh setResult:[self initiateAuthResponseExpiringIn:60 * 60]];
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+
+    XCTAssertEqual(self.initiateAuthCount, 1);
+    for (AWSTask<AWSCognitoIdentityUserSession *> *task in tasks) {
+        XCTAssertNil(task.error);
+        XCTAssertEqualObjects(task.result.accessToken.tokenString, tasks[0].result.accessToken.tokenString);
+    }
+}
+
+- (void)testFailedBackgroundRefreshRefreshesInForeground {
+    // Due for a refresh ahead of expiry, but still valid long enough to be handed out.
+    AWSCognitoIdentityUserSession *session = [self sessionExpiringIn:4 * 60];
+    [self.user updateUsernameAndPersistTokens:session];
+    self.initiateAuthTask = [AWSTask taskWithError:[NSError errorWithDomain:NSURLErrorDomain
+                                                                       code:NSURLErrorNotConnectedToInternet
+                                                                   userInfo:nil]];
+
+    AWSTask<AWSCognitoIdentityUserSession *> *task = [[self.user getSession] waitUntilFinished];
+    XCTAssertEqual(task.result, session);
+    XCTAssertEqual(self.initiateAuthCount, 1);
+
+    // The failed background refresh dropped the cached session, so the next caller waits for the refresh.
+    self.initiateAuthTask = [AWSTask taskWithResult:[self initiateAuthResponseExpiringIn:60 * 60]];
+    task = [[self.user getSession] waitUntilFinished];
+    XCTAssertNil(task.error);
+    XCTAssertNotEqual(task.result, session);
+    XCTAssertGreaterThan([task.result.expirationTime timeIntervalSinceNow], 50 * 60);
+    XCTAssertEqual(self.initiateAuthCount, 2);
+}
+
+#pragma mark - Helpers
+
+- (NSString *)tokenExpiringIn:(NSTimeInterval)interval {
+    NSDictionary *claims = @{@"exp" : @((long long)[[NSDate dateWithTimeIntervalSinceNow:interval] timeIntervalSince1970]),
+                             @"jti" : [[NSUUID UUID] UUIDString]};
+    NSString *encodedClaims = [[NSJSONSerialization dataWithJSONObject:claims options:0 error:nil] base64EncodedStringWithOptions:0];
+    encodedClaims = [encodedClaims stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"="]];
+    return [NSString stringWithFormat:@"eyJhbGciOiJub25lIn0.%@.signature", encodedClaims];
+}
+
+- (AWSCognitoIdentityUserSession *)sessionExpiringIn:(NSTimeInterval)interval {
+    return [[AWSCognitoIdentityUserSession alloc] initWithIdToken:[self tokenExpiringIn:interval]
+                                                      accessToken:[self tokenExpiringIn:interval]
+                                                     refreshToken:@"refreshToken"
+                                                   expirationTime:[NSDate dateWithTimeIntervalSinceNow:interval]];
+}
+
+- (AWSCognitoIdentityProviderInitiateAuthResponse *)initiateAuthResponseExpiringIn:(NSTimeInterval)interval {
+    AWSCognitoIdentityProviderAuthenticationResultType *authenticationResult = [AWSCognitoIdentityProviderAuthenticationResultType new];
+    authenticationResult.idToken = [self tokenExpiringIn:interval];
+    authenticationResult.accessToken = [self tokenExpiringIn:interval];
+    authenticationResult.expiresIn = @((NSInteger)interval);
+    AWSCognitoIdentityProviderInitiateAuthResponse *response = [AWSCognitoIdentityProviderInitiateAuthResponse new];
+    response.authenticationResult = authenticationResult;
+    return response;
+}
+
+@end
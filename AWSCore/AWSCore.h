@@ -51,6 +51,7 @@ FOUNDATION_EXPORT const unsigned char AWSCoreVersionString[] DEPRECATED_MSG_ATTR
 #import "AWSLogging.h"
 #import "AWSClientContext.h"
 #import "AWSSynchronizedMutableDictionary.h"
+#import "AWSPaginator.h"
 #import "AWSXMLDictionary.h"
 #import "AWSSerialization.h"
 #import "AWSTimestampSerialization.h"
@@ -65,6 +66,7 @@ FOUNDATION_EXPORT const unsigned char AWSCoreVersionString[] DEPRECATED_MSG_ATTR
 
 #import "AWSBolts.h"
 #import "AWSGZIP.h"
+#import "AWSGZIPStream.h"
 #import "AWSFMDB.h"
 #import "AWSKSReachability.h"
 #import "AWSUICKeyChainStore.h"
@@ -30,6 +30,7 @@ typedef NS_ENUM(NSInteger, AWSCognitoCredentialsProviderErrorType) {
 
 @class AWSTask<__covariant ResultType>;
 @class AWSCancellationTokenSource;
+@class AWSSTS;
 
 /**
  An AWS credentials container class.
@@ -154,6 +155,115 @@ typedef NS_ENUM(NSInteger, AWSCognitoCredentialsProviderErrorType) {
 
 @end
 
+/**
+ A credentials provider that assumes an IAM role with AWS STS `AssumeRole`.
+
+ Credentials are cached by source credentials provider, region, role ARN, role session name and session policy, and the
+ cache is shared by every provider created with the same values, so switching back to a role reuses its credentials.
+ Concurrent requests for missing or expiring credentials wait for a single `AssumeRole` request. Past the refresh-ahead
+ point, the cached credentials are still returned without waiting while they are renewed in the background.
+ */
+@interface AWSAssumeRoleCredentialsProvider : NSObject <AWSCredentialsProvider>
+
+/**
+ The AWS STS client that assumes the role. Its credentials provider supplies the source credentials.
+ */
+@property (nonatomic, strong, readonly) AWSSTS *sts;
+
+/**
+ The ARN of the role to assume.
+ */
+@property (nonatomic, strong, readonly) NSString *roleArn;
+
+/**
+ The identifier of the assumed role session.
+ */
+@property (nonatomic, strong, readonly) NSString *roleSessionName;
+
+/**
+ The session policy in JSON, or `nil` for none.
+ */
+@property (nonatomic, strong, readonly, nullable) NSString *policy;
+
+/**
+ The duration of the role session, in seconds. When `nil`, the default duration of `AssumeRole` is used.
+ */
+@property (atomic, strong, nullable) NSNumber *durationSeconds;
+
+/**
+ The fraction of the credentials lifetime after which they are refreshed in the background. Values greater than or equal to `1.0` disable the background refresh, in which case credentials are refreshed on demand when they are about to expire. The default value is `0.75`.
+ */
+@property (atomic, assign) double refreshAheadFraction;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a credentials provider that assumes a role with the source credentials of another credentials provider.
+
+ @param regionType                The region of the AWS STS endpoint.
+ @param sourceCredentialsProvider The credentials provider of the credentials that assume the role.
+ @param roleArn                   The ARN of the role to assume.
+ @param roleSessionName           The identifier of the assumed role session.
+ @param policy                    The session policy in JSON, or `nil` for none.
+ */
+- (instancetype)initWithRegionType:(AWSRegionType)regionType
+         sourceCredentialsProvider:(id<AWSCredentialsProvider>)sourceCredentialsProvider
+                           roleArn:(NSString *)roleArn
+                   roleSessionName:(NSString *)roleSessionName
+                            policy:(nullable NSString *)policy;
+
+/**
+ Creates a credentials provider that assumes a role with an AWS STS client.
+
+ @param sts             The AWS STS client that assumes the role.
+ @param roleArn         The ARN of the role to assume.
+ @param roleSessionName The identifier of the assumed role session.
+ @param policy          The session policy in JSON, or `nil` for none.
+ */
+- (instancetype)initWithSTS:(AWSSTS *)sts
+                    roleArn:(NSString *)roleArn
+            roleSessionName:(NSString *)roleSessionName
+                     policy:(nullable NSString *)policy NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/**
+ Counters describing how `AWSCognitoCredentialsProvider` served credentials. All values are cumulative since the provider was created.
+ */
+@interface AWSCognitoCredentialsProviderMetrics : NSObject
+
+/**
+ The number of requests served from the in-memory credentials without waiting for a refresh.
+ */
+@property (nonatomic, assign, readonly) int64_t cacheHitCount;
+
+/**
+ The number of cache hits served while the credentials were past their refresh-ahead point, i.e. while a background refresh was due or in flight.
+ */
+@property (nonatomic, assign, readonly) int64_t staleHitCount;
+
+/**
+ The number of completed credentials refreshes, including failed ones.
+ */
+@property (nonatomic, assign, readonly) int64_t refreshCount;
+
+/**
+ The number of credentials refreshes that failed.
+ */
+@property (nonatomic, assign, readonly) int64_t refreshFailureCount;
+
+/**
+ The sum of the latencies of all completed refreshes, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval totalRefreshLatency;
+
+/**
+ The latency of the last completed refresh, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval lastRefreshLatency;
+
+@end
+
 /**
  An AWSCredentialsProvider that uses Amazon Cognito to fetch temporary credentials tied to an identity.
 
@@ -183,6 +293,16 @@ typedef NS_ENUM(NSInteger, AWSCognitoCredentialsProviderErrorType) {
  */
 @property (nonatomic, strong, readonly) NSString *identityPoolId;
 
+/**
+ The fraction of the credentials lifetime after which they are refreshed in the background. Requests made after this point keep receiving the current credentials without waiting while the refresh is in flight. Values greater than or equal to `1.0` disable the background refresh, in which case credentials are refreshed on demand when they are about to expire. The default value is `0.75`.
+ */
+@property (atomic, assign) double refreshAheadFraction;
+
+/**
+ Counters for cache hits and refreshes of this provider.
+ */
+@property (nonatomic, strong, readonly) AWSCognitoCredentialsProviderMetrics *metrics;
+
 /**
  Initializer for credentials provider with enhanced authentication flow. This is the recommended constructor for first time Amazon Cognito developers. Will create an instance of `AWSEnhancedCognitoIdentityProvider`.
 
@@ -19,6 +19,8 @@
 #import "AWSUICKeyChainStore.h"
 #import "AWSCocoaLumberjack.h"
 #import "AWSBolts.h"
+#import <libkern/OSAtomic.h>
+#import <objc/runtime.h>
 
 NSString *const AWSCognitoCredentialsProviderErrorDomain = @"com.amazonaws.AWSCognitoCredentialsProviderErrorDomain";
 
@@ -28,6 +30,16 @@ static NSString *const AWSCredentialsProviderKeychainSessionToken = @"sessionKey
 static NSString *const AWSCredentialsProviderKeychainExpiration = @"expiration";
 static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
 
+// Credentials expiring within this window are not handed out.
+static NSTimeInterval const AWSCognitoCredentialsProviderExpiryWindow = 10 * 60;
+// Delay before retrying a failed background refresh.
+static NSTimeInterval const AWSCognitoCredentialsProviderRefreshAheadRetryInterval = 30;
+static double const AWSCognitoCredentialsProviderDefaultRefreshAheadFraction = 0.75;
+// Assumed role credentials expiring within this window are not handed out. Role sessions can be as short as 15 minutes.
+static NSTimeInterval const AWSAssumeRoleCredentialsProviderExpiryWindow = 60;
+static NSTimeInterval const AWSAssumeRoleCredentialsProviderRefreshAheadRetryInterval = 30;
+static double const AWSAssumeRoleCredentialsProviderDefaultRefreshAheadFraction = 0.75;
+
 @interface AWSCognitoIdentity()
 
 - (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
@@ -268,6 +280,274 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
 
 @end
 
+// The cached credentials of a role session, shared by the providers of the session.
+@interface AWSAssumeRoleCredentialsCacheEntry : NSObject
+
+@property (atomic, strong) AWSCredentials *credentials;
+// Seconds since 1970 after which `credentials` are refreshed in the background.
+@property (atomic, assign) NSTimeInterval refreshAheadTime;
+// The refresh in flight, if any. Guarded by `@synchronized(self)`.
+@property (nonatomic, strong) AWSTask<AWSCredentials *> *refreshTask;
+
+@end
+
+@implementation AWSAssumeRoleCredentialsCacheEntry
+
+@end
+
+@interface AWSAssumeRoleCredentialsProvider()
+
+@property (nonatomic, strong) AWSSTS *sts;
+@property (nonatomic, strong) NSString *roleArn;
+@property (nonatomic, strong) NSString *roleSessionName;
+@property (nonatomic, strong) NSString *policy;
+// The entry of the role session with the current `durationSeconds`.
+@property (atomic, strong) AWSAssumeRoleCredentialsCacheEntry *cacheEntry;
+
+@end
+
+@implementation AWSAssumeRoleCredentialsProvider
+
+@synthesize durationSeconds = _durationSeconds;
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithSTS:roleArn:roleSessionName:policy:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithRegionType:(AWSRegionType)regionType
+         sourceCredentialsProvider:(id<AWSCredentialsProvider>)sourceCredentialsProvider
+                           roleArn:(NSString *)roleArn
+                   roleSessionName:(NSString *)roleSessionName
+                            policy:(NSString *)policy {
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:regionType
+                                                                         credentialsProvider:sourceCredentialsProvider];
+    return [self initWithSTS:[[AWSSTS alloc] initWithConfiguration:configuration]
+                     roleArn:roleArn
+             roleSessionName:roleSessionName
+                      policy:policy];
+}
+
+- (instancetype)initWithSTS:(AWSSTS *)sts
+                    roleArn:(NSString *)roleArn
+            roleSessionName:(NSString *)roleSessionName
+                     policy:(NSString *)policy {
+    if (self = [super init]) {
+        _sts = sts;
+        _roleArn = roleArn;
+        _roleSessionName = roleSessionName;
+        _policy = policy;
+        _refreshAheadFraction = AWSAssumeRoleCredentialsProviderDefaultRefreshAheadFraction;
+        _cacheEntry = [AWSAssumeRoleCredentialsProvider cacheEntryForSTS:sts
+                                                                  roleArn:roleArn
+                                                          roleSessionName:roleSessionName
+                                                                   policy:policy
+                                                          durationSeconds:nil];
+    }
+
+    return self;
+}
+
+- (NSNumber *)durationSeconds {
+    @synchronized(self) {
+        return _durationSeconds;
+    }
+}
+
+- (void)setDurationSeconds:(NSNumber *)durationSeconds {
+    @synchronized(self) {
+        _durationSeconds = durationSeconds;
+        self.cacheEntry = [AWSAssumeRoleCredentialsProvider cacheEntryForSTS:self.sts
+                                                                      roleArn:self.roleArn
+                                                              roleSessionName:self.roleSessionName
+                                                                       policy:self.policy
+                                                              durationSeconds:durationSeconds];
+    }
+}
+
+static char AWSAssumeRoleCredentialsCacheEntriesKey;
+
+// The cache entries of the role sessions by region, role, session name, policy and duration. The entries of a source
+// credentials provider are associated with it, so they are released with it.
++ (AWSAssumeRoleCredentialsCacheEntry *)cacheEntryForSTS:(AWSSTS *)sts
+                                                  roleArn:(NSString *)roleArn
+                                          roleSessionName:(NSString *)roleSessionName
+                                                   policy:(NSString *)policy
+                                          durationSeconds:(NSNumber *)durationSeconds {
+    // The entries of STS clients without a source credentials provider.
+    static NSMutableDictionary<NSString *, AWSAssumeRoleCredentialsCacheEntry *> *unsignedCacheEntries = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        unsignedCacheEntries = [NSMutableDictionary new];
+    });
+
+    id sourceCredentialsProvider = sts.configuration.credentialsProvider;
+    NSString *key = [NSString stringWithFormat:@"%ld\n%@\n%@\n%@\n%@", (long)sts.configuration.regionType, roleArn, roleSessionName, policy ?: @"", durationSeconds ?: @""];
+    @synchronized(unsignedCacheEntries) {
+        NSMutableDictionary<NSString *, AWSAssumeRoleCredentialsCacheEntry *> *entries = unsignedCacheEntries;
+        if (sourceCredentialsProvider) {
+            entries = objc_getAssociatedObject(sourceCredentialsProvider, &AWSAssumeRoleCredentialsCacheEntriesKey);
+            if (!entries) {
+                entries = [NSMutableDictionary new];
+                objc_setAssociatedObject(sourceCredentialsProvider, &AWSAssumeRoleCredentialsCacheEntriesKey, entries, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+            }
+        }
+        AWSAssumeRoleCredentialsCacheEntry *cacheEntry = entries[key];
+        if (!cacheEntry) {
+            cacheEntry = [AWSAssumeRoleCredentialsCacheEntry new];
+            entries[key] = cacheEntry;
+        }
+        return cacheEntry;
+    }
+}
+
+#pragma mark - AWSCredentialsProvider methods
+
+- (AWSTask<AWSCredentials *> *)credentials {
+    // Returns the cached credentials when they do not expire within the expiry window. Past the refresh-ahead point
+    // they are still returned while they are renewed in the background.
+    AWSAssumeRoleCredentialsCacheEntry *cacheEntry = self.cacheEntry;
+    AWSCredentials *credentials = cacheEntry.credentials;
+    if ([credentials.expiration timeIntervalSinceNow] > AWSAssumeRoleCredentialsProviderExpiryWindow) {
+        if ([[NSDate date] timeIntervalSince1970] >= cacheEntry.refreshAheadTime) {
+            [self refreshCredentials];
+        }
+        return [AWSTask taskWithResult:credentials];
+    }
+
+    return [self refreshCredentials];
+}
+
+- (void)invalidateCachedTemporaryCredentials {
+    AWSAssumeRoleCredentialsCacheEntry *cacheEntry = self.cacheEntry;
+    @synchronized(cacheEntry) {
+        cacheEntry.credentials = nil;
+        cacheEntry.refreshAheadTime = 0;
+    }
+}
+
+#pragma mark -
+
+- (AWSTask<AWSCredentials *> *)refreshCredentials {
+    // Only one refresh of a role session runs at a time, and every caller waits for the same one.
+    AWSAssumeRoleCredentialsCacheEntry *cacheEntry = self.cacheEntry;
+    AWSTaskCompletionSource<AWSCredentials *> *refreshCompletionSource = nil;
+    @synchronized(cacheEntry) {
+        if (cacheEntry.refreshTask) {
+            return cacheEntry.refreshTask;
+        }
+        refreshCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+        cacheEntry.refreshTask = refreshCompletionSource.task;
+    }
+
+    AWSSTSAssumeRoleRequest *assumeRoleRequest = [AWSSTSAssumeRoleRequest new];
+    assumeRoleRequest.roleArn = self.roleArn;
+    assumeRoleRequest.roleSessionName = self.roleSessionName;
+    assumeRoleRequest.policy = self.policy;
+    assumeRoleRequest.durationSeconds = self.durationSeconds;
+    double refreshAheadFraction = self.refreshAheadFraction;
+
+    [[self.sts assumeRole:assumeRoleRequest] continueWithBlock:^id _Nullable(AWSTask<AWSSTSAssumeRoleResponse *> * _Nonnull task) {
+        AWSSTSCredentials *stsCredentials = task.result.credentials;
+        AWSCredentials *credentials = nil;
+        if (stsCredentials.accessKeyId && stsCredentials.secretAccessKey && stsCredentials.expiration) {
+            credentials = [[AWSCredentials alloc] initWithAccessKey:stsCredentials.accessKeyId
+                                                          secretKey:stsCredentials.secretAccessKey
+                                                         sessionKey:stsCredentials.sessionToken
+                                                         expiration:stsCredentials.expiration];
+        }
+
+        NSTimeInterval now = [[NSDate date] timeIntervalSince1970];
+        @synchronized(cacheEntry) {
+            if (credentials) {
+                NSTimeInterval expirationTime = [credentials.expiration timeIntervalSince1970];
+                cacheEntry.credentials = credentials;
+                cacheEntry.refreshAheadTime = refreshAheadFraction < 1.0 ? now + MAX(expirationTime - now, 0) * refreshAheadFraction : expirationTime;
+            } else {
+                // Keep serving the current credentials and retry later rather than on every request.
+                cacheEntry.refreshAheadTime = now + AWSAssumeRoleCredentialsProviderRefreshAheadRetryInterval;
+            }
+            cacheEntry.refreshTask = nil;
+        }
+
+        if (credentials) {
+            [refreshCompletionSource setResult:credentials];
+        } else if (task.cancelled) {
+            [refreshCompletionSource cancel];
+        } else {
+            AWSDDLogError(@"Unable to assume role [%@]. Error is [%@]", self.roleArn, task.error);
+            [refreshCompletionSource setError:task.error ?: [NSError errorWithDomain:AWSSTSErrorDomain
+                                                                                 code:AWSSTSErrorUnknown
+                                                                             userInfo:@{NSLocalizedDescriptionKey : @"AssumeRole did not return credentials."}]];
+        }
+        return nil;
+    }];
+
+    return refreshCompletionSource.task;
+}
+
+@end
+
+@interface AWSCognitoCredentialsProviderMetrics() {
+    int64_t _cacheHitCount;
+    int64_t _staleHitCount;
+    int64_t _refreshCount;
+    int64_t _refreshFailureCount;
+    int64_t _totalRefreshLatencyInMicroseconds;
+    // Written on the refresh's completion and read from any thread, guarded by @synchronized(self).
+    int64_t _lastRefreshLatencyInMicroseconds;
+}
+
+- (void)recordCacheHit:(BOOL)stale;
+- (void)recordRefreshWithLatency:(NSTimeInterval)latency failed:(BOOL)failed;
+
+@end
+
+@implementation AWSCognitoCredentialsProviderMetrics
+
+- (void)recordCacheHit:(BOOL)stale {
+    OSAtomicIncrement64(&_cacheHitCount);
+    if (stale) {
+        OSAtomicIncrement64(&_staleHitCount);
+    }
+}
+
+- (void)recordRefreshWithLatency:(NSTimeInterval)latency failed:(BOOL)failed {
+    int64_t latencyInMicroseconds = (int64_t)(latency * USEC_PER_SEC);
+    OSAtomicAdd64(latencyInMicroseconds, &_totalRefreshLatencyInMicroseconds);
+    @synchronized(self) {
+        _lastRefreshLatencyInMicroseconds = latencyInMicroseconds;
+    }
+    OSAtomicIncrement64(&_refreshCount);
+    if (failed) {
+        OSAtomicIncrement64(&_refreshFailureCount);
+    }
+}
+
+- (NSTimeInterval)totalRefreshLatency {
+    return (NSTimeInterval)_totalRefreshLatencyInMicroseconds / USEC_PER_SEC;
+}
+
+- (NSTimeInterval)lastRefreshLatency {
+    @synchronized(self) {
+        return (NSTimeInterval)_lastRefreshLatencyInMicroseconds / USEC_PER_SEC;
+    }
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: cacheHits=%lld staleHits=%lld refreshes=%lld refreshFailures=%lld totalRefreshLatency=%.3fs>",
+            NSStringFromClass([self class]),
+            self.cacheHitCount,
+            self.staleHitCount,
+            self.refreshCount,
+            self.refreshFailureCount,
+            self.totalRefreshLatency];
+}
+
+@end
+
 @interface AWSCognitoCredentialsProvider()
 
 @property (nonatomic, strong) NSString *authRoleArn;
@@ -276,10 +556,15 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
 @property (nonatomic, strong) AWSCognitoIdentity *cognitoIdentity;
 @property (nonatomic, strong) AWSUICKeyChainStore *keychain;
 @property (nonatomic, strong) AWSExecutor *refreshExecutor;
-@property (nonatomic, strong) dispatch_semaphore_t semaphore;
 @property (atomic, assign) BOOL useEnhancedFlow;
 @property (nonatomic, strong) AWSCredentials *internalCredentials;
-@property (atomic, assign, getter=isRefreshingCredentials) BOOL refreshingCredentials;
+// The last credentials set, read without going through the keychain-backed `internalCredentials` on every request.
+@property (atomic, strong) AWSCredentials *credentialsSnapshot;
+// Seconds since 1970 after which `credentialsSnapshot` is refreshed in the background.
+@property (atomic, assign) NSTimeInterval refreshAheadTime;
+// The refresh in flight, if any. Guarded by `@synchronized(self)`.
+@property (nonatomic, strong) AWSTaskCompletionSource<AWSCredentials *> *refreshCompletionSource;
+@property (nonatomic, strong) AWSCognitoCredentialsProviderMetrics *metrics;
 @property (nonatomic, strong) NSDictionary<NSString *, NSString *> *cachedLogins;
 // This is a temporary solution to bypass the requirement of protocol check for `AWSIdentityProviderManager`.
 @property (nonatomic, strong) NSString *customRoleArnOverride;
@@ -387,8 +672,8 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
                 authRoleArn:(NSString *)authRoleArn
   identityPoolConfiguration:(AWSServiceConfiguration *)configuration {
     _refreshExecutor = [AWSExecutor executorWithOperationQueue:[NSOperationQueue new]];
-    _refreshingCredentials = NO;
-    _semaphore = dispatch_semaphore_create(0);
+    _refreshAheadFraction = AWSCognitoCredentialsProviderDefaultRefreshAheadFraction;
+    _metrics = [AWSCognitoCredentialsProviderMetrics new];
 
     _identityProvider = identityProvider;
     _unAuthRoleArn = unauthRoleArn;
@@ -415,6 +700,7 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
     }
 
     _internalCredentials = [[AWSCredentials alloc] initFromKeychain:self.keychain];
+    [self updateCredentialsSnapshot:_internalCredentials issuedNow:NO];
 }
 
 - (void)setUpWithRegionType:(AWSRegionType)regionType
@@ -603,11 +889,78 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
     // Returns cached credentials when all of the following conditions are true:
     // 1. The cached credentials are not nil.
     // 2. The credentials do not expire within 10 minutes.
-    if (self.internalCredentials
-        && [self.internalCredentials.expiration compare:[NSDate dateWithTimeIntervalSinceNow:10 * 60]] == NSOrderedDescending) {
-        return [AWSTask taskWithResult:self.internalCredentials];
+    // Past the refresh-ahead point the cached credentials are still returned while they are renewed in the background.
+    AWSCredentials *credentials = self.credentialsSnapshot;
+    if ([credentials.expiration timeIntervalSinceNow] > AWSCognitoCredentialsProviderExpiryWindow) {
+        BOOL refreshAheadDue = [[NSDate date] timeIntervalSince1970] >= self.refreshAheadTime;
+        [self.metrics recordCacheHit:refreshAheadDue];
+        if (refreshAheadDue) {
+            [self refreshCredentialsAheadOfExpiry];
+        }
+        return [AWSTask taskWithResult:credentials];
     }
-    
+
+    return [self refreshCredentialsWithCancellationToken:cancellationTokenSource
+                                            refreshAhead:NO];
+}
+
+- (void)refreshCredentialsAheadOfExpiry {
+    @synchronized(self) {
+        if (self.refreshCompletionSource) {
+            return;
+        }
+    }
+
+    AWSDDLogDebug(@"Refreshing credentials ahead of expiry.");
+    [[self refreshCredentialsWithCancellationToken:nil
+                                      refreshAhead:YES] continueWithBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
+        if (task.error) {
+            // Keep serving the current credentials and retry later rather than on every request.
+            self.refreshAheadTime = [[NSDate date] timeIntervalSince1970] + AWSCognitoCredentialsProviderRefreshAheadRetryInterval;
+        }
+        return nil;
+    }];
+}
+
+- (BOOL)canUseCachedCredentialsWithLogins:(NSDictionary<NSString *,NSString *> *)logins
+                             refreshAhead:(BOOL)refreshAhead {
+    if (self.cachedLogins && ![self.cachedLogins isEqualToDictionary:logins]) {
+        return NO;
+    }
+    if (!self.internalCredentials
+        || [self.internalCredentials.expiration compare:[NSDate dateWithTimeIntervalSinceNow:AWSCognitoCredentialsProviderExpiryWindow]] != NSOrderedDescending) {
+        return NO;
+    }
+    // A refresh ahead of expiry is only needed if nobody renewed the credentials in the meantime.
+    return !refreshAhead || [[NSDate date] timeIntervalSince1970] < self.refreshAheadTime;
+}
+
+- (AWSTask<AWSCredentials *> *)refreshCredentialsWithCancellationToken:(AWSCancellationTokenSource *)cancellationTokenSource
+                                                          refreshAhead:(BOOL)refreshAhead {
+    // Only one refresh runs at a time. It is claimed before anything asynchronous starts, so that
+    // concurrent callers cannot all find no refresh in flight. Instead of blocking a thread until
+    // it completes, later callers chain onto it and re-evaluate the cached credentials once it
+    // succeeds. A failed refresh fails every caller waiting on it.
+    AWSTaskCompletionSource<AWSCredentials *> *refreshCompletionSource = nil;
+    AWSTaskCompletionSource<AWSCredentials *> *inFlightRefresh = nil;
+    @synchronized(self) {
+        inFlightRefresh = self.refreshCompletionSource;
+        if (!inFlightRefresh) {
+            refreshCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+            self.refreshCompletionSource = refreshCompletionSource;
+        }
+    }
+    if (inFlightRefresh) {
+        if (refreshAhead) {
+            return inFlightRefresh.task;
+        }
+        return [inFlightRefresh.task continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
+            return [self credentialsWithCancellationToken:cancellationTokenSource];
+        }];
+    }
+
+    __block NSDate *refreshStartDate = nil;
+
     id<AWSCognitoCredentialsProviderHelper> providerRef = self.identityProvider;
     return [[[providerRef logins] continueWithExecutor:self.refreshExecutor withSuccessBlock:^id _Nullable(AWSTask<NSDictionary<NSString *,NSString *> *> * _Nonnull task) {
         
@@ -636,33 +989,15 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
             // 1. The cached logins are different from the one the identity provider provided.
             // 2. The cached credentials is nil.
             // 3. The credentials expire within 10 minutes.
-            if ((!self.cachedLogins || [self.cachedLogins isEqualToDictionary:logins])
-                && self.internalCredentials
-                && [self.internalCredentials.expiration compare:[NSDate dateWithTimeIntervalSinceNow:10 * 60]] == NSOrderedDescending) {
+            if ([self canUseCachedCredentialsWithLogins:logins refreshAhead:refreshAhead]) {
                 return [AWSTask taskWithResult:self.internalCredentials];
             }
             
-            if (self.isRefreshingCredentials) {
-                // Waits up to 60 seconds for the Google SDK to refresh a token.
-                if (dispatch_semaphore_wait(self.semaphore, dispatch_time(DISPATCH_TIME_NOW, 60 * NSEC_PER_SEC)) != 0) {
-                    NSError *error = [NSError errorWithDomain:AWSCognitoCredentialsProviderErrorDomain
-                                                         code:AWSCognitoCredentialsProviderCredentialsRefreshTimeout
-                                                     userInfo:nil];
-                    return [AWSTask taskWithError:error];
-                }
-            }
-            
             if (cancellationTokenSource.isCancellationRequested) {
                 return [AWSTask cancelledTask];
             }
             
-            if ((!self.cachedLogins || [self.cachedLogins isEqualToDictionary:logins])
-                && self.internalCredentials
-                && [self.internalCredentials.expiration compare:[NSDate dateWithTimeIntervalSinceNow:10 * 60]] == NSOrderedDescending) {
-                return [AWSTask taskWithResult:self.internalCredentials];
-            }
-            
-            self.refreshingCredentials = YES;
+            refreshStartDate = [NSDate date];
             self.cachedLogins = logins;
             
             if (self.useEnhancedFlow) {
@@ -689,8 +1024,20 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
             AWSDDLogError(@"Unable to refresh. Error is [%@]", task.error);
         }
         
-        self.refreshingCredentials = NO;
-        dispatch_semaphore_signal(self.semaphore);
+        if (refreshStartDate) {
+            [self.metrics recordRefreshWithLatency:-[refreshStartDate timeIntervalSinceNow]
+                                            failed:task.result == nil];
+        }
+        @synchronized(self) {
+            self.refreshCompletionSource = nil;
+        }
+        if (task.error) {
+            [refreshCompletionSource setError:task.error];
+        } else if (task.cancelled) {
+            [refreshCompletionSource cancel];
+        } else {
+            [refreshCompletionSource setResult:task.result];
+        }
         
         return task;
     }];
@@ -793,12 +1140,14 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
 - (AWSCredentials *)internalCredentials {
     if (! _internalCredentials) {
         _internalCredentials = [[AWSCredentials alloc] initFromKeychain:self.keychain];
+        [self updateCredentialsSnapshot:_internalCredentials issuedNow:NO];
     }
     return _internalCredentials;
 }
 
 - (void)setInternalCredentials:(AWSCredentials *)internalCredentials {
     _internalCredentials = internalCredentials;
+    [self updateCredentialsSnapshot:internalCredentials issuedNow:YES];
 
     self.keychain[AWSCredentialsProviderKeychainAccessKeyId] = internalCredentials.accessKey;
     self.keychain[AWSCredentialsProviderKeychainSecretAccessKey] = internalCredentials.secretKey;
@@ -810,4 +1159,17 @@ static NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
     }
 }
 
+- (void)updateCredentialsSnapshot:(AWSCredentials *)credentials issuedNow:(BOOL)issuedNow {
+    NSTimeInterval expirationTime = [credentials.expiration timeIntervalSince1970];
+    if (issuedNow && self.refreshAheadFraction < 1.0) {
+        NSTimeInterval now = [[NSDate date] timeIntervalSince1970];
+        self.refreshAheadTime = now + MAX(expirationTime - now, 0) * self.refreshAheadFraction;
+    } else {
+        // The issue time of credentials loaded from the keychain is unknown, so they are only
+        // refreshed on demand when about to expire.
+        self.refreshAheadTime = expirationTime;
+    }
+    self.credentialsSnapshot = credentials;
+}
+
 @end
@@ -20,6 +20,7 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Algorithm;
 FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 
 @class AWSEndpoint;
+@class AWSCredentials;
 
 @protocol AWSCredentialsProvider;
 
@@ -63,6 +64,23 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
                                                                      requestParameters:(NSDictionary<NSString *, id> * _Nullable)requestParameters
                                                                               signBody:(BOOL)signBody;
 
+/**
+ Returns the request that `generateQueryStringForSignatureV4WithCredentialProvider:httpMethod:expireDuration:endpoint:keyPath:requestHeaders:requestParameters:signBody:`
+ signs, for callers that sign it themselves with `sigV4SignedURLWithRequest:`.
+
+ @param endpoint the endpoint of the service for which the URL is being generated
+ @param httpMethod the HTTP method (e.g., "GET", "POST", etc)
+ @param keyPath the request path
+ @param requestHeaders the headers to sign as part of the request
+ @param requestParameters the URL parameters to sign
+ @return the request to sign
+ */
++ (NSURLRequest * _Nonnull)presignRequestWithEndpoint:(AWSEndpoint * _Nonnull)endpoint
+                                           httpMethod:(AWSHTTPMethod)httpMethod
+                                              keyPath:(NSString * _Nullable)keyPath
+                                       requestHeaders:(NSDictionary<NSString *, NSString *> * _Nullable)requestHeaders
+                                    requestParameters:(NSDictionary<NSString *, id> * _Nullable)requestParameters;
+
 /**
  Returns a URL signed using the SigV4 algorithm.
 
@@ -92,6 +110,34 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
                                                 signBody:(BOOL)signBody
                                         signSessionToken:(BOOL)signSessionToken;
 
+/**
+ Returns a URL signed using the SigV4 algorithm with credentials that were already resolved, without waiting on a
+ credentials provider. When signing many URLs, resolve the credentials and derive the signing key once, then call this
+ method for each URL.
+
+ @param request the NSURLRequest to sign
+ @param credentials the credentials to sign with
+ @param signingKey the key derived by `getV4DerivedKey:date:region:service:` from the secret key of `credentials`, the
+        date stamp of `date`, `regionName` and `serviceName`
+ @param regionName the string representing the AWS region of the endpoint to be signed.
+ @param serviceName the name of the AWS service the request is for
+ @param date the date of the signed credential
+ @param expireDuration the duration in seconds the signed URL will be valid for
+ @param signBody if true and the httpMethod is GET, sign an empty string as part of the signature content
+ @param signSessionToken if true, include the sessionKey of `credentials` in the signed payload.
+        If false, appends the X-AMZ-Security-Token to the end of the signed URL request parameters
+ @return the signed URL
+ */
++ (NSURL * _Nullable)sigV4SignedURLWithRequest:(NSURLRequest * _Nonnull)request
+                                   credentials:(AWSCredentials * _Nonnull)credentials
+                                    signingKey:(NSData * _Nonnull)signingKey
+                                    regionName:(NSString * _Nonnull)regionName
+                                   serviceName:(NSString * _Nonnull)serviceName
+                                          date:(NSDate * _Nonnull)date
+                                expireDuration:(int32_t)expireDuration
+                                      signBody:(BOOL)signBody
+                              signSessionToken:(BOOL)signSessionToken;
+
 + (NSString * _Nonnull)getCanonicalizedRequest:(NSString * _Nonnull)method
                                  path:(NSString * _Nonnull)path
                                 query:(NSString * _Nullable)query
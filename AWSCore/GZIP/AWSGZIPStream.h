@@ -0,0 +1,220 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString *const AWSGZIPErrorDomain;
+typedef NS_ENUM(NSInteger, AWSGZIPErrorType) {
+    AWSGZIPErrorUnknown,
+    AWSGZIPErrorInvalidData,
+    AWSGZIPErrorTruncatedData,
+    AWSGZIPErrorStreamFailed,
+};
+
+typedef NS_ENUM(NSInteger, AWSGZIPCodecMode) {
+    AWSGZIPCodecModeCompress,
+    AWSGZIPCodecModeDecompress,
+};
+
+/**
+ The maximum number of idle codecs kept for reuse, 4 codecs.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSGZIPCodecMaximumPooledCodecs;
+
+/**
+ Incrementally compresses data into, or decompresses data from, the GZIP format.
+
+ Unlike `NSData (AWSGZIP)`, a codec does not need the whole input or output in memory: input is pushed to it in pieces, and
+ output is handed back in pieces of up to 64KB. `AWSGZIPInputStream` pulls its input from a stream instead.
+
+ The zlib state of a codec is a few hundred kilobytes. Codecs returned by `+ compressorWithLevel:` and `+ decompressor`
+ come from a pool of idle codecs, and go back to it with `- recycle`, so the state is reset instead of allocated again for
+ every request. A codec is not thread-safe.
+ */
+@interface AWSGZIPCodec : NSObject
+
+/**
+ Whether the codec compresses or decompresses.
+ */
+@property (nonatomic, assign, readonly) AWSGZIPCodecMode mode;
+
+/**
+ The compression level, from `0.0` to `1.0`, or a negative value for the zlib default. It is ignored when decompressing.
+ */
+@property (nonatomic, assign, readonly) float level;
+
+/**
+ The number of bytes consumed since the codec was created or reset.
+ */
+@property (nonatomic, assign, readonly) unsigned long long totalIn;
+
+/**
+ The number of bytes produced since the codec was created or reset.
+ */
+@property (nonatomic, assign, readonly) unsigned long long totalOut;
+
+/**
+ Whether the end of the GZIP stream was written or read.
+ */
+@property (nonatomic, assign, readonly, getter=isFinished) BOOL finished;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a codec with new zlib state.
+
+ @param mode  Whether the codec compresses or decompresses.
+ @param level The compression level, from `0.0` to `1.0`, or a negative value for the zlib default.
+
+ @return A codec, or `nil` if zlib could not be initialized.
+ */
+- (nullable instancetype)initWithMode:(AWSGZIPCodecMode)mode
+                                level:(float)level NS_DESIGNATED_INITIALIZER;
+
+/**
+ Returns an idle compressor from the pool, or a new one.
+
+ @param level The compression level, from `0.0` to `1.0`, or a negative value for the zlib default.
+ */
++ (nullable instancetype)compressorWithLevel:(float)level;
+
+/**
+ Returns an idle decompressor from the pool, or a new one.
+ */
++ (nullable instancetype)decompressor;
+
+/**
+ Compresses or decompresses the next piece of input.
+
+ @param bytes         The input.
+ @param length        The length of the input.
+ @param finish        `YES` if this is the last piece of input.
+ @param outputHandler Called with each piece of output. The bytes are only valid during the call.
+ @param error         Set to an error with `AWSGZIPErrorDomain` domain when the input is not valid GZIP data, or ends before the GZIP stream does.
+
+ @return `YES` on success.
+ */
+- (BOOL)processBytes:(const void *)bytes
+              length:(NSUInteger)length
+              finish:(BOOL)finish
+       outputHandler:(void (^)(const uint8_t *bytes, NSUInteger length))outputHandler
+               error:(NSError *__autoreleasing *)error;
+
+/**
+ Compresses or decompresses the next piece of input, and returns the output it produced.
+
+ @param data   The input.
+ @param finish `YES` if this is the last piece of input.
+ @param error  Set to an error with `AWSGZIPErrorDomain` domain on failure.
+
+ @return The output, possibly empty, or `nil` on failure.
+ */
+- (nullable NSData *)processData:(NSData *)data
+                          finish:(BOOL)finish
+                           error:(NSError *__autoreleasing *)error;
+
+/**
+ Resets the codec to compress or decompress a new GZIP stream, keeping its zlib state allocated.
+ */
+- (void)reset;
+
+/**
+ Resets the codec and returns it to the pool. It must not be used afterwards.
+ */
+- (void)recycle;
+
+/**
+ Compresses data in one pass into a buffer allocated once, at zlib's bound for its length.
+
+ @param data  The data.
+ @param level The compression level, from `0.0` to `1.0`, or a negative value for the zlib default.
+ @param error Set to an error with `AWSGZIPErrorDomain` domain on failure.
+
+ @return The GZIP data, or `nil` on failure.
+ */
++ (nullable NSData *)gzippedData:(NSData *)data
+                           level:(float)level
+                           error:(NSError *__autoreleasing *)error;
+
+/**
+ Compresses the contents of a stream into a buffer allocated once, at zlib's bound for `length`. Only the output is held in memory.
+
+ @param stream A stream that has not been opened. It is opened, read to its end and closed.
+ @param length The length of the stream, used to size the output.
+ @param level  The compression level, from `0.0` to `1.0`, or a negative value for the zlib default.
+ @param error  Set to an error with `AWSGZIPErrorDomain` domain on failure.
+
+ @return The GZIP data, or `nil` on failure.
+ */
++ (nullable NSData *)gzippedDataWithContentsOfStream:(NSInputStream *)stream
+                                              length:(unsigned long long)length
+                                               level:(float)level
+                                               error:(NSError *__autoreleasing *)error;
+
+/**
+ Decompresses GZIP data in one pass. The output is allocated once, at the uncompressed length recorded at the end of the data, and only grows if that is not the actual length.
+
+ @param data  The GZIP data.
+ @param error Set to an error with `AWSGZIPErrorDomain` domain when the data is not valid or is truncated.
+
+ @return The data, or `nil` on failure.
+ */
++ (nullable NSData *)gunzippedData:(NSData *)data
+                             error:(NSError *__autoreleasing *)error;
+
+@end
+
+/**
+ A stream that compresses or decompresses another stream as it is read, through a pooled `AWSGZIPCodec`.
+
+ It only supports synchronous reads with `read:maxLength:`, as in `+[AWSGZIPCodec gzippedDataWithContentsOfStream:length:level:error:]` or when decoding a GZIP response body read from a stream. It is not scheduled in a run loop and sends no stream events, so it cannot be the `HTTPBodyStream` of a request: compress the body with `AWSGZIPCodec` instead.
+ */
+@interface AWSGZIPInputStream : NSInputStream
+
+/**
+ Whether the stream compresses or decompresses.
+ */
+@property (nonatomic, assign, readonly) AWSGZIPCodecMode mode;
+
+/**
+ The number of bytes read from the underlying stream.
+ */
+@property (nonatomic, assign, readonly) unsigned long long totalIn;
+
+/**
+ The number of bytes returned by the stream.
+ */
+@property (nonatomic, assign, readonly) unsigned long long totalOut;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a stream.
+
+ @param stream The stream to compress or decompress. It is opened and closed with this stream.
+ @param mode   Whether to compress or decompress.
+ @param level  The compression level, from `0.0` to `1.0`, or a negative value for the zlib default.
+
+ @return A stream.
+ */
+- (instancetype)initWithInputStream:(NSInputStream *)stream
+                               mode:(AWSGZIPCodecMode)mode
+                              level:(float)level NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
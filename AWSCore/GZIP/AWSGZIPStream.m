@@ -0,0 +1,585 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSGZIPStream.h"
+#import <zlib.h>
+#import "AWSCocoaLumberjack.h"
+
+NSString *const AWSGZIPErrorDomain = @"com.amazonaws.AWSGZIPErrorDomain";
+
+NSUInteger const AWSGZIPCodecMaximumPooledCodecs = 4;
+
+// The size of the buffers for output handed to an output handler, and for input read from a stream.
+static NSUInteger const AWSGZIPBufferSize = 64 * 1024;
+
+// The largest ratio deflate can achieve, used to bound the length recorded at the end of GZIP data.
+static NSUInteger const AWSGZIPMaximumCompressionRatio = 1032;
+
+// windowBits for the GZIP format, and for automatic detection of the GZIP and zlib formats.
+static int const AWSGZIPDeflateWindowBits = 15 + 16;
+static int const AWSGZIPInflateWindowBits = 15 + 32;
+
+static NSError *aws_gzipError(AWSGZIPErrorType code, NSString *description) {
+    return [NSError errorWithDomain:AWSGZIPErrorDomain
+                               code:code
+                           userInfo:@{NSLocalizedDescriptionKey : description}];
+}
+
+@interface AWSGZIPCodec()
+
+@property (nonatomic, assign) BOOL finished;
+
+// Compresses or decompresses from `*input` into `*output`, advancing both, until the output is full, the input is
+// consumed or the GZIP stream ends.
+- (BOOL)processInput:(const uint8_t **)input
+         inputLength:(NSUInteger *)inputLength
+              output:(uint8_t **)output
+        outputLength:(NSUInteger *)outputLength
+              finish:(BOOL)finish
+               error:(NSError *__autoreleasing *)error;
+
+// The largest GZIP stream a compressor can produce from `length` bytes.
+- (unsigned long long)compressedLengthBoundForLength:(unsigned long long)length;
+
+@end
+
+@implementation AWSGZIPCodec {
+    z_stream _stream;
+    uint8_t *_buffer;
+}
+
++ (NSMutableArray<AWSGZIPCodec *> *)pool {
+    static NSMutableArray<AWSGZIPCodec *> *_pool = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _pool = [NSMutableArray new];
+    });
+    return _pool;
+}
+
++ (instancetype)codecFromPoolWithMode:(AWSGZIPCodecMode)mode level:(float)level {
+    NSMutableArray<AWSGZIPCodec *> *pool = [self pool];
+    @synchronized(pool) {
+        for (NSUInteger i = 0; i < [pool count]; i++) {
+            AWSGZIPCodec *codec = pool[i];
+            if (codec.mode == mode && (mode == AWSGZIPCodecModeDecompress || codec.level == level)) {
+                [pool removeObjectAtIndex:i];
+                return codec;
+            }
+        }
+    }
+    return [[self alloc] initWithMode:mode level:level];
+}
+
++ (instancetype)compressorWithLevel:(float)level {
+    return [self codecFromPoolWithMode:AWSGZIPCodecModeCompress level:level];
+}
+
++ (instancetype)decompressor {
+    return [self codecFromPoolWithMode:AWSGZIPCodecModeDecompress level:-1.0f];
+}
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithMode:level:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithMode:(AWSGZIPCodecMode)mode
+                       level:(float)level {
+    if (self = [super init]) {
+        _mode = mode;
+        _level = level;
+
+        int status;
+        if (mode == AWSGZIPCodecModeCompress) {
+            int compression = (level < 0.0f) ? Z_DEFAULT_COMPRESSION : (int)roundf(MIN(level, 1.0f) * 9);
+            status = deflateInit2(&_stream, compression, Z_DEFLATED, AWSGZIPDeflateWindowBits, 8, Z_DEFAULT_STRATEGY);
+        } else {
+            status = inflateInit2(&_stream, AWSGZIPInflateWindowBits);
+        }
+        if (status != Z_OK) {
+            AWSDDLogError(@"Failed to initialize zlib: %d", status);
+            // Nothing to end in -dealloc.
+            _mode = -1;
+            return nil;
+        }
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    if (_mode == AWSGZIPCodecModeCompress) {
+        deflateEnd(&_stream);
+    } else if (_mode == AWSGZIPCodecModeDecompress) {
+        inflateEnd(&_stream);
+    }
+    free(_buffer);
+}
+
+- (unsigned long long)totalIn {
+    return _stream.total_in;
+}
+
+- (unsigned long long)totalOut {
+    return _stream.total_out;
+}
+
+- (unsigned long long)compressedLengthBoundForLength:(unsigned long long)length {
+    // deflateBound() takes a uLong, which is 32 bits on some platforms.
+    if (length > ULONG_MAX / 2) {
+        return length + length / 1000 + 64;
+    }
+    return deflateBound(&_stream, (uLong)length);
+}
+
+- (BOOL)processInput:(const uint8_t **)input
+         inputLength:(NSUInteger *)inputLength
+              output:(uint8_t **)output
+        outputLength:(NSUInteger *)outputLength
+              finish:(BOOL)finish
+               error:(NSError *__autoreleasing *)error {
+    while (!self.finished && *outputLength > 0) {
+        // avail_in and avail_out are 32 bits.
+        uInt availableIn = (uInt)MIN(*inputLength, (NSUInteger)UINT_MAX);
+        uInt availableOut = (uInt)MIN(*outputLength, (NSUInteger)UINT_MAX);
+        _stream.next_in = (Bytef *)*input;
+        _stream.avail_in = availableIn;
+        _stream.next_out = *output;
+        _stream.avail_out = availableOut;
+
+        int status;
+        if (self.mode == AWSGZIPCodecModeCompress) {
+            BOOL lastInput = finish && availableIn == *inputLength;
+            status = deflate(&_stream, lastInput ? Z_FINISH : Z_NO_FLUSH);
+        } else {
+            status = inflate(&_stream, Z_NO_FLUSH);
+        }
+
+        NSUInteger consumed = availableIn - _stream.avail_in;
+        NSUInteger produced = availableOut - _stream.avail_out;
+        *input += consumed;
+        *inputLength -= consumed;
+        *output += produced;
+        *outputLength -= produced;
+
+        if (status == Z_STREAM_END) {
+            self.finished = YES;
+        } else if (status == Z_BUF_ERROR || (status == Z_OK && consumed == 0 && produced == 0)) {
+            // No progress is possible until there is more input.
+            break;
+        } else if (status != Z_OK) {
+            if (error) {
+                if (status == Z_DATA_ERROR || status == Z_NEED_DICT) {
+                    *error = aws_gzipError(AWSGZIPErrorInvalidData, [NSString stringWithFormat:@"The data is not valid GZIP data: %s", _stream.msg ?: "unknown error"]);
+                } else {
+                    *error = aws_gzipError(AWSGZIPErrorUnknown, [NSString stringWithFormat:@"zlib failed with status %d.", status]);
+                }
+            }
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+- (BOOL)processBytes:(const void *)bytes
+              length:(NSUInteger)length
+              finish:(BOOL)finish
+       outputHandler:(void (^)(const uint8_t *bytes, NSUInteger length))outputHandler
+               error:(NSError *__autoreleasing *)error {
+    if (!_buffer) {
+        _buffer = malloc(AWSGZIPBufferSize);
+    }
+
+    const uint8_t *input = bytes;
+    NSUInteger inputLength = length;
+    NSUInteger outputLength;
+    do {
+        uint8_t *output = _buffer;
+        outputLength = AWSGZIPBufferSize;
+        if (![self processInput:&input
+                    inputLength:&inputLength
+                         output:&output
+                   outputLength:&outputLength
+                         finish:finish
+                          error:error]) {
+            return NO;
+        }
+        if (outputLength < AWSGZIPBufferSize) {
+            outputHandler(_buffer, AWSGZIPBufferSize - outputLength);
+        }
+        // A full buffer means there may be more output.
+    } while (outputLength == 0 && !self.finished);
+
+    if (finish && !self.finished) {
+        if (error) {
+            *error = aws_gzipError(AWSGZIPErrorTruncatedData, @"The GZIP data ended unexpectedly.");
+        }
+        return NO;
+    }
+
+    return YES;
+}
+
+- (NSData *)processData:(NSData *)data
+                 finish:(BOOL)finish
+                  error:(NSError *__autoreleasing *)error {
+    NSMutableData *output = [NSMutableData new];
+    if (![self processBytes:[data bytes]
+                     length:[data length]
+                     finish:finish
+              outputHandler:^(const uint8_t *bytes, NSUInteger length) {
+                  [output appendBytes:bytes length:length];
+              }
+                      error:error]) {
+        return nil;
+    }
+    return output;
+}
+
+- (void)reset {
+    if (self.mode == AWSGZIPCodecModeCompress) {
+        deflateReset(&_stream);
+    } else {
+        inflateReset(&_stream);
+    }
+    self.finished = NO;
+}
+
+- (void)recycle {
+    [self reset];
+
+    NSMutableArray<AWSGZIPCodec *> *pool = [AWSGZIPCodec pool];
+    @synchronized(pool) {
+        if ([pool count] < AWSGZIPCodecMaximumPooledCodecs && ![pool containsObject:self]) {
+            [pool addObject:self];
+        }
+    }
+}
+
+#pragma mark - One pass
+
++ (NSData *)gzippedData:(NSData *)data
+                  level:(float)level
+                  error:(NSError *__autoreleasing *)error {
+    AWSGZIPCodec *codec = [self compressorWithLevel:level];
+    if (!codec) {
+        if (error) {
+            *error = aws_gzipError(AWSGZIPErrorUnknown, @"Failed to initialize zlib.");
+        }
+        return nil;
+    }
+
+    NSMutableData *output = [NSMutableData dataWithLength:(NSUInteger)[codec compressedLengthBoundForLength:[data length]]];
+    const uint8_t *input = [data bytes];
+    NSUInteger inputLength = [data length];
+    uint8_t *outputBytes = [output mutableBytes];
+    NSUInteger outputLength = [output length];
+    BOOL succeeded = [codec processInput:&input
+                             inputLength:&inputLength
+                                  output:&outputBytes
+                            outputLength:&outputLength
+                                  finish:YES
+                                   error:error];
+    succeeded = succeeded && codec.finished;
+    if (succeeded) {
+        output.length -= outputLength;
+    } else if (error && !*error) {
+        *error = aws_gzipError(AWSGZIPErrorUnknown, @"The output exceeded zlib's bound.");
+    }
+    [codec recycle];
+
+    return succeeded ? output : nil;
+}
+
++ (NSData *)gzippedDataWithContentsOfStream:(NSInputStream *)stream
+                                     length:(unsigned long long)length
+                                      level:(float)level
+                                      error:(NSError *__autoreleasing *)error {
+    AWSGZIPInputStream *gzipStream = [[AWSGZIPInputStream alloc] initWithInputStream:stream
+                                                                                mode:AWSGZIPCodecModeCompress
+                                                                               level:level];
+    AWSGZIPCodec *codec = [self compressorWithLevel:level];
+    NSUInteger capacity = (NSUInteger)[codec compressedLengthBoundForLength:length];
+    [codec recycle];
+
+    NSMutableData *output = [NSMutableData dataWithLength:capacity];
+    NSUInteger outputLength = 0;
+    NSInteger read;
+    [gzipStream open];
+    do {
+        if (outputLength == [output length]) {
+            // The stream was longer than `length`.
+            output.length = MAX([output length] * 2, AWSGZIPBufferSize);
+        }
+        read = [gzipStream read:(uint8_t *)[output mutableBytes] + outputLength
+                      maxLength:[output length] - outputLength];
+        if (read > 0) {
+            outputLength += read;
+        }
+    } while (read > 0);
+    NSError *streamError = [gzipStream streamError];
+    [gzipStream close];
+
+    if (read < 0) {
+        if (error) {
+            *error = streamError ?: aws_gzipError(AWSGZIPErrorStreamFailed, @"Failed to read the stream.");
+        }
+        return nil;
+    }
+    output.length = outputLength;
+
+    return output;
+}
+
++ (NSData *)gunzippedData:(NSData *)data
+                    error:(NSError *__autoreleasing *)error {
+    AWSGZIPCodec *codec = [self decompressor];
+    if (!codec) {
+        if (error) {
+            *error = aws_gzipError(AWSGZIPErrorUnknown, @"Failed to initialize zlib.");
+        }
+        return nil;
+    }
+
+    // The last 4 bytes of a GZIP stream are its uncompressed length modulo 2^32, little endian. It is only a hint, so
+    // it is bounded by what deflate could have produced.
+    NSUInteger capacity = [data length] * 2;
+    if ([data length] >= 18) {
+        const uint8_t *trailer = (const uint8_t *)[data bytes] + [data length] - 4;
+        NSUInteger recordedLength = (NSUInteger)trailer[0] | (NSUInteger)trailer[1] << 8 | (NSUInteger)trailer[2] << 16 | (NSUInteger)trailer[3] << 24;
+        capacity = MIN(recordedLength, [data length] * AWSGZIPMaximumCompressionRatio);
+    }
+    capacity = MAX(capacity, (NSUInteger)1);
+
+    NSMutableData *output = [NSMutableData dataWithLength:capacity];
+    const uint8_t *input = [data bytes];
+    NSUInteger inputLength = [data length];
+    NSUInteger produced = 0;
+    BOOL succeeded = YES;
+    while (succeeded && !codec.finished) {
+        if (produced == [output length]) {
+            output.length = [output length] * 2;
+        }
+        uint8_t *outputBytes = (uint8_t *)[output mutableBytes] + produced;
+        NSUInteger outputLength = [output length] - produced;
+        NSUInteger availableOut = outputLength;
+        succeeded = [codec processInput:&input
+                            inputLength:&inputLength
+                                 output:&outputBytes
+                           outputLength:&outputLength
+                                 finish:YES
+                                  error:error];
+        produced += availableOut - outputLength;
+
+        if (succeeded && !codec.finished && outputLength > 0) {
+            if (error) {
+                *error = aws_gzipError(AWSGZIPErrorTruncatedData, @"The GZIP data ended unexpectedly.");
+            }
+            succeeded = NO;
+        }
+    }
+    [codec recycle];
+
+    if (!succeeded) {
+        return nil;
+    }
+    output.length = produced;
+
+    return output;
+}
+
+@end
+
+#pragma mark - AWSGZIPInputStream
+
+@interface AWSGZIPInputStream()
+
+@property (nonatomic, strong) NSInputStream *stream;
+@property (nonatomic, assign) float level;
+@property (nonatomic, strong) AWSGZIPCodec *codec;
+
+@property (nonatomic, assign) NSUInteger inputOffset;
+@property (nonatomic, assign) NSUInteger inputLength;
+@property (nonatomic, assign) BOOL endOfInput;
+
+@property (nonatomic, assign) NSStreamStatus status;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation AWSGZIPInputStream {
+    uint8_t *_inputBuffer;
+    unsigned long long _totalIn;
+    unsigned long long _totalOut;
+}
+
+@synthesize delegate = _delegate;
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithInputStream:mode:level:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream
+                               mode:(AWSGZIPCodecMode)mode
+                              level:(float)level {
+    if (self = [super init]) {
+        _stream = stream;
+        _mode = mode;
+        _level = level;
+        _status = NSStreamStatusNotOpen;
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    [self releaseResources];
+}
+
+- (void)releaseResources {
+    if (self.codec) {
+        _totalIn = self.codec.totalIn;
+        _totalOut = self.codec.totalOut;
+    }
+    [self.codec recycle];
+    self.codec = nil;
+    free(_inputBuffer);
+    _inputBuffer = NULL;
+}
+
+- (unsigned long long)totalIn {
+    return self.codec ? self.codec.totalIn : _totalIn;
+}
+
+- (unsigned long long)totalOut {
+    return self.codec ? self.codec.totalOut : _totalOut;
+}
+
+- (void)failWithError:(NSError *)error {
+    self.error = error;
+    self.status = NSStreamStatusError;
+}
+
+#pragma mark NSInputStream methods
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
+    if (self.status == NSStreamStatusAtEnd) {
+        return 0;
+    }
+    if (self.status != NSStreamStatusOpen) {
+        return -1;
+    }
+
+    uint8_t *output = buffer;
+    NSUInteger outputLength = len;
+    while (outputLength > 0 && !self.codec.finished) {
+        if (self.inputOffset == self.inputLength && !self.endOfInput) {
+            NSInteger read = [self.stream read:_inputBuffer maxLength:AWSGZIPBufferSize];
+            if (read < 0) {
+                [self failWithError:[self.stream streamError] ?: aws_gzipError(AWSGZIPErrorStreamFailed, @"Failed to read the underlying stream.")];
+                return -1;
+            }
+            self.inputOffset = 0;
+            self.inputLength = read;
+            self.endOfInput = (read == 0);
+        }
+
+        const uint8_t *input = _inputBuffer + self.inputOffset;
+        NSUInteger inputLength = self.inputLength - self.inputOffset;
+        NSUInteger availableOut = outputLength;
+        NSError *error = nil;
+        if (![self.codec processInput:&input
+                          inputLength:&inputLength
+                               output:&output
+                         outputLength:&outputLength
+                               finish:self.endOfInput
+                                error:&error]) {
+            [self failWithError:error];
+            return -1;
+        }
+        self.inputOffset = self.inputLength - inputLength;
+
+        if (self.endOfInput && !self.codec.finished && outputLength == availableOut && inputLength == 0) {
+            [self failWithError:aws_gzipError(AWSGZIPErrorTruncatedData, @"The GZIP data ended unexpectedly.")];
+            return -1;
+        }
+    }
+
+    if (self.codec.finished) {
+        self.status = NSStreamStatusAtEnd;
+    }
+
+    return len - outputLength;
+}
+
+- (BOOL)hasBytesAvailable {
+    return self.status == NSStreamStatusOpen;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
+    return NO;
+}
+
+- (void)open {
+    if (self.status != NSStreamStatusNotOpen) {
+        return;
+    }
+    self.codec = self.mode == AWSGZIPCodecModeCompress ? [AWSGZIPCodec compressorWithLevel:self.level] : [AWSGZIPCodec decompressor];
+    if (!self.codec) {
+        [self failWithError:aws_gzipError(AWSGZIPErrorUnknown, @"Failed to initialize zlib.")];
+        return;
+    }
+    _inputBuffer = malloc(AWSGZIPBufferSize);
+    [self.stream open];
+    self.status = NSStreamStatusOpen;
+}
+
+- (void)close {
+    [self.stream close];
+    [self releaseResources];
+    self.status = NSStreamStatusClosed;
+}
+
+// Only synchronous reads are supported, the stream is never scheduled.
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode {
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode {
+}
+
+- (id)propertyForKey:(NSString *)key {
+    return nil;
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSString *)key {
+    return NO;
+}
+
+- (NSStreamStatus)streamStatus {
+    return self.status;
+}
+
+- (NSError *)streamError {
+    return self.error;
+}
+
+@end
@@ -80,6 +80,7 @@
 #import "AWSDDASLLogger.h"
 #import "AWSDDFileLogger.h"
 #import "AWSDDOSLogger.h"
+#import "AWSDDAbstractDatabaseLogger.h"
 
 // CLI
 #if __has_include("CLIColor.h") && TARGET_OS_OSX
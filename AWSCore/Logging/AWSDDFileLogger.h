@@ -323,6 +323,9 @@ extern unsigned long long const kAWSDDDefaultLogFilesDiskQuota;
 
 /**
  *  Called when the logger wrote message. Call super after your implementation.
+ *
+ *  The message data is buffered and reaches the file once the logger queue finishes its current work,
+ *  so that a batch of messages is written with one write.
  */
 - (void)didLogMessage NS_REQUIRES_SUPER;
 
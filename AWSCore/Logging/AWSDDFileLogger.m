@@ -564,11 +564,14 @@ unsigned long long const kAWSDDDefaultLogFilesDiskQuota   = 20 * 1024 * 1024; //
     
     unsigned long long _maximumFileSize;
     NSTimeInterval _rollingFrequency;
+
+    NSMutableData *_pendingLogData;
 }
 
 - (void)rollLogFileNow;
 - (void)maybeRollLogFileDueToAge;
 - (void)maybeRollLogFileDueToSize;
+- (void)writePendingLogData;
 
 @end
 
@@ -595,6 +598,7 @@ unsigned long long const kAWSDDDefaultLogFilesDiskQuota   = 20 * 1024 * 1024; //
 }
 
 - (void)dealloc {
+    [self writePendingLogData];
     [_currentLogFileHandle synchronizeFile];
     [_currentLogFileHandle closeFile];
 
@@ -817,6 +821,7 @@ unsigned long long const kAWSDDDefaultLogFilesDiskQuota   = 20 * 1024 * 1024; //
         return;
     }
 
+    [self writePendingLogData];
     [_currentLogFileHandle synchronizeFile];
     [_currentLogFileHandle closeFile];
     _currentLogFileHandle = nil;
@@ -858,7 +863,7 @@ unsigned long long const kAWSDDDefaultLogFilesDiskQuota   = 20 * 1024 * 1024; //
     // We specifically wrote our own getter/setter method to allow us to do this (for performance reasons).
 
     if (_maximumFileSize > 0) {
-        unsigned long long fileSize = [_currentLogFileHandle offsetInFile];
+        unsigned long long fileSize = [_currentLogFileHandle offsetInFile] + _pendingLogData.length;
 
         if (fileSize >= _maximumFileSize) {
             NSLogVerbose(@"AWSDDFileLogger: Rolling log file due to size (%qu)...", fileSize);
@@ -1007,24 +1012,75 @@ static int exception_count = 0;
 
         @try {
             [self willLogMessage];
-			
-            [[self currentLogFileHandle] writeData:logData];
+
+            [self appendPendingLogData:logData];
 
             [self didLogMessage];
         } @catch (NSException *exception) {
-            exception_count++;
+            [self logWriteException:exception];
+        }
+    }
+}
 
-            if (exception_count <= 10) {
-                NSLogError(@"AWSDDFileLogger.logMessage: %@", exception);
+/**
+ * Lines are not written one by one. They are appended to a pending buffer that is written with a single write
+ * once the work currently running on the logger queue is done, or as soon as it grows past
+ * kAWSDDPendingLogDataLimit. When AWSDDLog delivers a batch of messages in one block, the whole batch becomes
+ * one write. Anything that later runs on the logger queue, including flush, sees the data on disk.
+ **/
+static const NSUInteger kAWSDDPendingLogDataLimit = 64 * 1024;
 
-                if (exception_count == 10) {
-                    NSLogError(@"AWSDDFileLogger.logMessage: Too many exceptions -- will not log any more of them.");
-                }
-            }
+- (void)appendPendingLogData:(NSData *)logData {
+    // Open the file now, so rolling and the vnode source behave as if the data had been written.
+    [self currentLogFileHandle];
+
+    if (_pendingLogData == nil) {
+        _pendingLogData = [NSMutableData dataWithCapacity:kAWSDDPendingLogDataLimit];
+    }
+
+    if (_pendingLogData.length == 0) {
+        dispatch_async(self.loggerQueue, ^{ @autoreleasepool {
+            [self writePendingLogData];
+        } });
+    }
+
+    [_pendingLogData appendData:logData];
+
+    if (_pendingLogData.length >= kAWSDDPendingLogDataLimit) {
+        [self writePendingLogData];
+    }
+}
+
+- (void)writePendingLogData {
+    if (_pendingLogData.length == 0) {
+        return;
+    }
+
+    @try {
+        [[self currentLogFileHandle] writeData:_pendingLogData];
+    } @catch (NSException *exception) {
+        [self logWriteException:exception];
+    }
+
+    _pendingLogData.length = 0;
+}
+
+- (void)logWriteException:(NSException *)exception {
+    exception_count++;
+
+    if (exception_count <= 10) {
+        NSLogError(@"AWSDDFileLogger.logMessage: %@", exception);
+
+        if (exception_count == 10) {
+            NSLogError(@"AWSDDFileLogger.logMessage: Too many exceptions -- will not log any more of them.");
         }
     }
 }
 
+- (void)flush {
+    [self writePendingLogData];
+}
+
 - (void)willLogMessage {
 	
 }
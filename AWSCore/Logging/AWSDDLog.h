@@ -172,6 +172,22 @@ NS_ASSUME_NONNULL_BEGIN
  */
 NSString * __nullable AWSDDExtractFileNameWithoutExtension(const char *filePath, BOOL copy);
 
+/**
+ * Mirror of `[AWSDDLog sharedInstance].logLevel`, kept up to date by the `logLevel` setter.
+ * Read it through `AWSDDLogSharedLogLevel()` rather than directly.
+ **/
+FOUNDATION_EXPORT NSUInteger _AWSDDLogSharedLevel;
+
+/**
+ * Returns the log level of the shared `AWSDDLog` instance.
+ *
+ * This is a single relaxed atomic load, so the logging macros can use it to decide whether a message
+ * would be logged before any of its format arguments are evaluated.
+ **/
+static inline AWSDDLogLevel AWSDDLogSharedLogLevel(void) {
+    return (AWSDDLogLevel)__atomic_load_n(&_AWSDDLogSharedLevel, __ATOMIC_RELAXED);
+}
+
 /**
  * The THIS_FILE macro gives you an NSString of the file name.
  * For simplicity and clarity, the file name does not include the full path or file extension.
@@ -228,6 +244,26 @@ NSString * __nullable AWSDDExtractFileNameWithoutExtension(const char *filePath,
  **/
 @property (class, nonatomic, DISPATCH_QUEUE_REFERENCE_TYPE, readonly) dispatch_queue_t loggingQueue;
 
+/**
+ * Whether asynchronous log messages are staged in per-thread buffers.
+ *
+ * When enabled, an asynchronous log statement appends its message to a lock-free ring buffer owned by the calling
+ * thread, instead of waiting on the queue semaphore and dispatching one block per message. The logging queue drains
+ * every thread buffer in one pass, orders the messages by time, and hands each logger the whole batch at once.
+ * Loggers still format messages on their own queues.
+ *
+ * A thread whose buffer is full does not block: the message is dropped and counted in `droppedMessageCount`.
+ * Synchronous messages and `flushLog` drain the buffers first, so they are not reordered ahead of earlier messages.
+ *
+ * Defaults to NO.
+ */
+@property (atomic, assign) BOOL usesThreadBuffers;
+
+/**
+ * The number of messages dropped because the issuing thread's buffer was full. See `usesThreadBuffers`.
+ */
+@property (nonatomic, assign, readonly) uint64_t droppedMessageCount;
+
 /**
  * Logging Primitive.
  *
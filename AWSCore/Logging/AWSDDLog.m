@@ -25,6 +25,7 @@
 #import <objc/runtime.h>
 #import <mach/mach_host.h>
 #import <mach/host_info.h>
+#import <mach/mach_time.h>
 #import <libkern/OSAtomic.h>
 #import <Availability.h>
 #if TARGET_OS_IOS
@@ -64,6 +65,13 @@
     #define AWSDDLOG_MAX_QUEUE_SIZE 1000 // Should not exceed INT32_MAX
 #endif
 
+// When usesThreadBuffers is enabled, each logging thread stages asynchronous messages in its own ring buffer
+// of this many slots. A thread that fills its buffer before the logging queue drains it drops messages.
+
+#ifndef AWSDDLOG_THREAD_BUFFER_SIZE
+    #define AWSDDLOG_THREAD_BUFFER_SIZE 1024 // Must be a power of two
+#endif
+
 // The "global logging queue" refers to [AWSDDLog loggingQueue].
 // It is the queue that all log statements go through.
 //
@@ -96,7 +104,26 @@ static void *const GlobalLoggingQueueIdentityKey = (void *)&GlobalLoggingQueueId
 #pragma mark -
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-@interface AWSDDLog ()
+// A single-producer single-consumer ring owned by one logging thread.
+// The owning thread only writes tail and the slots past it, the logging queue only writes head.
+typedef struct AWSDDLogThreadBuffer {
+    struct AWSDDLogThreadBuffer *next;
+    int abandoned;
+    uint64_t head __attribute__((aligned(64)));
+    uint64_t tail __attribute__((aligned(64)));
+    struct {
+        uint64_t time;
+        void *message;
+    } slots[AWSDDLOG_THREAD_BUFFER_SIZE];
+} AWSDDLogThreadBuffer;
+
+@interface AWSDDLog () {
+    pthread_key_t _threadBufferKey;
+    AWSDDLogThreadBuffer *_threadBuffers;
+    dispatch_source_t _threadBufferSource;
+    BOOL _usesThreadBuffers;
+    uint64_t _droppedMessageCount;
+}
 
 // An array used to manage all the individual loggers.
 // The array is only modified on the loggingQueue/loggingThread.
@@ -104,6 +131,14 @@ static void *const GlobalLoggingQueueIdentityKey = (void *)&GlobalLoggingQueueId
 
 @end
 
+// Called when a thread that has logged exits. The logging queue frees the buffer once it is drained.
+static void AWSDDLogThreadBufferDestructor(void *buffer) {
+    __atomic_store_n(&((AWSDDLogThreadBuffer *)buffer)->abandoned, 1, __ATOMIC_RELEASE);
+}
+
+// Mirror of the shared instance's log level, read by the logging macros without messaging AWSDDLog.
+NSUInteger _AWSDDLogSharedLevel = AWSDDLogLevelWarning;
+
 @implementation AWSDDLog
 
 // All logging statements are added to the same queue to ensure FIFO operation.
@@ -179,7 +214,7 @@ static NSUInteger _numProcessors;
     
     if (self) {
         self._loggers = [[NSMutableArray alloc] initWithCapacity:4];
-        self.logLevel = AWSDDLogLevelWarning;//default to warning
+        _logLevel = AWSDDLogLevelWarning;//default to warning, matching _AWSDDLogSharedLevel
         
 #if TARGET_OS_IOS
         NSString *notificationName = @"UIApplicationWillTerminateNotification";
@@ -216,6 +251,68 @@ static NSUInteger _numProcessors;
     return self;
 }
 
+- (void)setLogLevel:(AWSDDLogLevel)logLevel {
+    _logLevel = logLevel;
+    if (self == [AWSDDLog sharedInstance]) {
+        __atomic_store_n(&_AWSDDLogSharedLevel, (NSUInteger)logLevel, __ATOMIC_RELAXED);
+    }
+}
+
+- (void)dealloc {
+    if (_threadBufferSource) {
+        dispatch_source_cancel(_threadBufferSource);
+        pthread_key_delete(_threadBufferKey);
+
+        AWSDDLogThreadBuffer *buffer = _threadBuffers;
+        while (buffer != NULL) {
+            AWSDDLogThreadBuffer *next = buffer->next;
+            for (uint64_t i = buffer->head; i != buffer->tail; i++) {
+                CFRelease(buffer->slots[i & (AWSDDLOG_THREAD_BUFFER_SIZE - 1)].message);
+            }
+            free(buffer);
+            buffer = next;
+        }
+    }
+}
+
+- (BOOL)usesThreadBuffers {
+    return __atomic_load_n(&_usesThreadBuffers, __ATOMIC_ACQUIRE);
+}
+
+- (void)setUsesThreadBuffers:(BOOL)usesThreadBuffers {
+    @synchronized (self) {
+        if (usesThreadBuffers && _threadBufferSource == NULL) {
+            if (pthread_key_create(&_threadBufferKey, AWSDDLogThreadBufferDestructor) != 0) {
+                NSLogDebug(@"AWSDDLog: Unable to create the thread buffer key; thread buffers stay disabled.");
+                return;
+            }
+
+            // Producers merge into this source after every push. GCD coalesces the merges,
+            // so the logging queue runs one drain for however many messages arrived in the meantime.
+            _threadBufferSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_DATA_OR, 0, 0, _loggingQueue);
+
+            __weak AWSDDLog *weakSelf = self;
+            dispatch_source_set_event_handler(_threadBufferSource, ^{ @autoreleasepool {
+                [weakSelf lt_drainThreadBuffers];
+            } });
+            dispatch_resume(_threadBufferSource);
+        }
+
+        __atomic_store_n(&_usesThreadBuffers, usesThreadBuffers, __ATOMIC_RELEASE);
+    }
+
+    if (!usesThreadBuffers) {
+        // Deliver anything still sitting in the buffers.
+        dispatch_async(_loggingQueue, ^{ @autoreleasepool {
+            [self lt_drainThreadBuffers];
+        } });
+    }
+}
+
+- (uint64_t)droppedMessageCount {
+    return __atomic_load_n(&_droppedMessageCount, __ATOMIC_RELAXED);
+}
+
 /**
  * Provides access to the logging queue.
  **/
@@ -352,6 +449,11 @@ static NSUInteger _numProcessors;
     // Dispatch semaphores call down to the kernel only when the calling thread needs to be blocked.
     // If the calling semaphore does not need to block, no kernel call is made.
 
+    if (asyncFlag && __atomic_load_n(&_usesThreadBuffers, __ATOMIC_ACQUIRE)) {
+        [self queueLogMessageInThreadBuffer:logMessage];
+        return;
+    }
+
     dispatch_semaphore_wait(_queueSemaphore, DISPATCH_TIME_FOREVER);
 
     // We've now sure we won't overflow the queue.
@@ -359,6 +461,8 @@ static NSUInteger _numProcessors;
 
     dispatch_block_t logBlock = ^{
         @autoreleasepool {
+            // Messages staged in thread buffers were issued before this one.
+            [self lt_drainThreadBuffers];
             [self lt_log:logMessage];
         }
     };
@@ -370,6 +474,41 @@ static NSUInteger _numProcessors;
     }
 }
 
+- (void)queueLogMessageInThreadBuffer:(AWSDDLogMessage *)logMessage {
+    AWSDDLogThreadBuffer *buffer = pthread_getspecific(_threadBufferKey);
+
+    if (buffer == NULL) {
+        if (posix_memalign((void **)&buffer, 64, sizeof(AWSDDLogThreadBuffer)) != 0) {
+            __atomic_fetch_add(&_droppedMessageCount, 1, __ATOMIC_RELAXED);
+            return;
+        }
+        memset(buffer, 0, sizeof(AWSDDLogThreadBuffer));
+        pthread_setspecific(_threadBufferKey, buffer);
+
+        // Publish the buffer. Only the logging queue ever unlinks buffers, and it never touches the list head
+        // without a compare-and-swap, so pushing here needs no lock.
+        AWSDDLogThreadBuffer *head = __atomic_load_n(&_threadBuffers, __ATOMIC_RELAXED);
+        do {
+            buffer->next = head;
+        } while (!__atomic_compare_exchange_n(&_threadBuffers, &head, buffer, YES, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+
+    uint64_t tail = buffer->tail;
+    uint64_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+
+    if (tail - head >= AWSDDLOG_THREAD_BUFFER_SIZE) {
+        __atomic_fetch_add(&_droppedMessageCount, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    NSUInteger index = (NSUInteger)(tail & (AWSDDLOG_THREAD_BUFFER_SIZE - 1));
+    buffer->slots[index].time = mach_absolute_time();
+    buffer->slots[index].message = (__bridge_retained void *)logMessage;
+    __atomic_store_n(&buffer->tail, tail + 1, __ATOMIC_RELEASE);
+
+    dispatch_source_merge_data(_threadBufferSource, 1);
+}
+
 + (void)log:(BOOL)asynchronous
       level:(AWSDDLogLevel)level
        flag:(AWSDDLogFlag)flag
@@ -528,6 +667,7 @@ static NSUInteger _numProcessors;
 
 - (void)flushLog {
     dispatch_sync(_loggingQueue, ^{ @autoreleasepool {
+        [self lt_drainThreadBuffers];
         [self lt_flush];
     } });
 }
@@ -878,6 +1018,147 @@ static NSUInteger _numProcessors;
     dispatch_semaphore_signal(_queueSemaphore);
 }
 
+typedef struct {
+    uint64_t time;
+    NSUInteger order;
+    void *message;
+} AWSDDLogBufferedMessage;
+
+static int AWSDDLogBufferedMessageCompare(const void *a, const void *b) {
+    const AWSDDLogBufferedMessage *lhs = a;
+    const AWSDDLogBufferedMessage *rhs = b;
+
+    if (lhs->time != rhs->time) {
+        return lhs->time < rhs->time ? -1 : 1;
+    }
+    return lhs->order < rhs->order ? -1 : (lhs->order > rhs->order ? 1 : 0);
+}
+
+- (void)lt_unlinkThreadBuffer:(AWSDDLogThreadBuffer *)buffer previous:(AWSDDLogThreadBuffer *)previous {
+    if (previous != NULL) {
+        previous->next = buffer->next;
+        return;
+    }
+
+    AWSDDLogThreadBuffer *expected = buffer;
+    if (__atomic_compare_exchange_n(&_threadBuffers, &expected, buffer->next, NO, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    // New buffers were pushed in front of this one; it is no longer the head.
+    AWSDDLogThreadBuffer *node = expected;
+    while (node->next != buffer) {
+        node = node->next;
+    }
+    node->next = buffer->next;
+}
+
+- (void)lt_drainThreadBuffers {
+    // Collect every message staged in the thread buffers and deliver them as one batch.
+
+    NSAssert(dispatch_get_specific(GlobalLoggingQueueIdentityKey),
+             @"This method should only be run on the logging thread/queue");
+
+    AWSDDLogThreadBuffer *buffer = __atomic_load_n(&_threadBuffers, __ATOMIC_ACQUIRE);
+    if (buffer == NULL) {
+        return;
+    }
+
+    AWSDDLogBufferedMessage *pending = NULL;
+    NSUInteger count = 0;
+    NSUInteger capacity = 0;
+    AWSDDLogThreadBuffer *previous = NULL;
+
+    while (buffer != NULL) {
+        AWSDDLogThreadBuffer *next = buffer->next;
+
+        // Read abandoned before tail: once a thread has exited, everything it pushed is visible below.
+        int abandoned = __atomic_load_n(&buffer->abandoned, __ATOMIC_ACQUIRE);
+        uint64_t tail = __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE);
+        uint64_t head = buffer->head;
+
+        if (tail != head) {
+            NSUInteger needed = count + (NSUInteger)(tail - head);
+            if (needed > capacity) {
+                NSUInteger newCapacity = MAX(needed, capacity * 2);
+                AWSDDLogBufferedMessage *grown = realloc(pending, newCapacity * sizeof(AWSDDLogBufferedMessage));
+                if (grown == NULL) {
+                    // Deliver what was collected so far. The messages of this buffer and the ones after it stay
+                    // where they are, and the next drain picks them up.
+                    NSLog(@"AWSDDLog: Unable to allocate a drain batch of %lu messages; the remaining messages stay in their thread buffers.",
+                          (unsigned long)newCapacity);
+                    break;
+                }
+                pending = grown;
+                capacity = newCapacity;
+            }
+
+            for (; head != tail; head++) {
+                NSUInteger index = (NSUInteger)(head & (AWSDDLOG_THREAD_BUFFER_SIZE - 1));
+                pending[count].time = buffer->slots[index].time;
+                pending[count].order = count;
+                pending[count].message = buffer->slots[index].message;
+                count++;
+            }
+            __atomic_store_n(&buffer->head, head, __ATOMIC_RELEASE);
+        }
+
+        if (abandoned) {
+            [self lt_unlinkThreadBuffer:buffer previous:previous];
+            free(buffer);
+        } else {
+            previous = buffer;
+        }
+        buffer = next;
+    }
+
+    if (count == 0) {
+        free(pending);
+        return;
+    }
+
+    qsort(pending, count, sizeof(AWSDDLogBufferedMessage), AWSDDLogBufferedMessageCompare);
+
+    NSMutableArray<AWSDDLogMessage *> *logMessages = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [logMessages addObject:(__bridge_transfer AWSDDLogMessage *)pending[i].message];
+    }
+    free(pending);
+
+    [self lt_logBatch:logMessages];
+}
+
+- (void)lt_logBatch:(NSArray<AWSDDLogMessage *> *)logMessages {
+    // Like lt_log:, but each logger receives the whole batch in a single block on its queue.
+    // Batched messages never took the queue semaphore, so there is nothing to signal afterwards.
+
+    for (AWSDDLoggerNode *loggerNode in self._loggers) {
+        dispatch_block_t block = ^{
+            for (AWSDDLogMessage *logMessage in logMessages) {
+                // skip the messages this logger shouldn't write based on the log level
+
+                if (!(logMessage->_flag & loggerNode->_level)) {
+                    continue;
+                }
+
+                @autoreleasepool {
+                    [loggerNode->_logger logMessage:logMessage];
+                }
+            }
+        };
+
+        if (_numProcessors > 1) {
+            dispatch_group_async(_loggingGroup, loggerNode->_loggerQueue, block);
+        } else {
+            dispatch_sync(loggerNode->_loggerQueue, block);
+        }
+    }
+
+    if (_numProcessors > 1) {
+        dispatch_group_wait(_loggingGroup, DISPATCH_TIME_FOREVER);
+    }
+}
+
 - (void)lt_flush {
     // All log statements issued before the flush method was invoked have now been executed.
     //
@@ -41,6 +41,7 @@ FOUNDATION_EXPORT NSString *const AWSResponseObjectErrorUserInfoKey;
 
 typedef void (^AWSNetworkingUploadProgressBlock) (int64_t bytesSent, int64_t totalBytesSent, int64_t totalBytesExpectedToSend);
 typedef void (^AWSNetworkingDownloadProgressBlock) (int64_t bytesWritten, int64_t totalBytesWritten, int64_t totalBytesExpectedToWrite);
+typedef void (^AWSNetworkingResponseDataHandler) (NSData *data);
 
 #pragma mark - AWSHTTPMethod
 
@@ -186,6 +187,13 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
 @property (nonatomic, copy) AWSNetworkingUploadProgressBlock uploadProgress;
 @property (nonatomic, copy) AWSNetworkingDownloadProgressBlock downloadProgress;
 
+/**
+ When set, the body of a successful response is passed to the block piece by piece as it arrives instead of being buffered,
+ and the response serializer receives no data. The body of an error response is still buffered and parsed.
+ Once a piece has been passed to the block, the request is no longer retried.
+ */
+@property (nonatomic, copy) AWSNetworkingResponseDataHandler responseDataHandler;
+
 @property (readonly, nonatomic, strong) NSURLSessionTask *task;
 @property (readonly, nonatomic, assign, getter = isCancelled) BOOL cancelled;
 
@@ -199,6 +207,7 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
 
 @property (nonatomic, copy) AWSNetworkingUploadProgressBlock uploadProgress;
 @property (nonatomic, copy) AWSNetworkingDownloadProgressBlock downloadProgress;
+@property (nonatomic, copy) AWSNetworkingResponseDataHandler responseDataHandler;
 @property (nonatomic, assign, readonly, getter = isCancelled) BOOL cancelled;
 @property (nonatomic, strong) NSURL *downloadingFileURL;
 
@@ -279,6 +279,7 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
 
     encodingBehaviors[@"downloadProgress"] = @(AWSMTLModelEncodingBehaviorExcluded);
     encodingBehaviors[@"internalRequest"] = @(AWSMTLModelEncodingBehaviorExcluded);
+    encodingBehaviors[@"responseDataHandler"] = @(AWSMTLModelEncodingBehaviorExcluded);
     encodingBehaviors[@"uploadProgress"] = @(AWSMTLModelEncodingBehaviorExcluded);
 
     return encodingBehaviors;
@@ -313,6 +314,13 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     return NULL;
 }
 
+// This may be a bug in our version of Mantle--despite declaring these properties as "excluded",
+// Mantle attempts to decode them from an archive, and fails when it cannot find the field name.
+- (nullable id)decodeResponseDataHandlerWithCoder:(NSCoder *)coder
+                                     modelVersion:(NSUInteger)modelVersion {
+    return NULL;
+}
+
 - (void)setUploadProgress:(AWSNetworkingUploadProgressBlock)uploadProgress {
     self.internalRequest.uploadProgress = uploadProgress;
 }
@@ -321,6 +329,10 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     self.internalRequest.downloadProgress = downloadProgress;
 }
 
+- (void)setResponseDataHandler:(AWSNetworkingResponseDataHandler)responseDataHandler {
+    self.internalRequest.responseDataHandler = responseDataHandler;
+}
+
 - (BOOL)isCancelled {
     return [self.internalRequest isCancelled];
 }
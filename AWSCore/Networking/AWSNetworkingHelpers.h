@@ -32,6 +32,28 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (NSArray<NSURLQueryItem *> * _Nonnull)queryItemsFromDictionary:(NSDictionary<NSString *, id> * _Nonnull)requestParameters;
 
+/**
+ Appends URL encoded `key=value` pairs of the parameters to a query string, separated by `&`.
+
+ Values of nested dictionaries are appended as if they were parameters themselves. Strings and numbers are URL encoded,
+ and the encoded elements of arrays are joined by `,`. Any other value is appended as its URL encoded description.
+
+ @param parameters an NSDictionary of the parameters
+ @param queryString the query string to append the parameters to
+ */
++ (void)appendQueryStringFromParameters:(NSDictionary * _Nullable)parameters
+                          toQueryString:(NSMutableString * _Nonnull)queryString;
+
+/**
+ Appends a URL encoded value to a query string. Strings and numbers are URL encoded, and the encoded elements of arrays
+ are joined by `,`. Any other value is appended as its URL encoded description.
+
+ @param value the value to append
+ @param queryString the query string to append the value to
+ */
++ (void)appendQueryStringValue:(id _Nonnull)value
+                 toQueryString:(NSMutableString * _Nonnull)queryString;
+
 @end
 
 NS_ASSUME_NONNULL_END
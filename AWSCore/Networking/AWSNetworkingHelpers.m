@@ -14,6 +14,8 @@
 //
 
 #import "AWSNetworkingHelpers.h"
+#import "AWSCategory.h"
+#import "AWSCocoaLumberjack.h"
 
 @implementation AWSNetworkingHelpers
 
@@ -42,4 +44,43 @@
     return queryItems;
 }
 
++ (void)appendQueryStringFromParameters:(NSDictionary *)parameters
+                          toQueryString:(NSMutableString *)queryString {
+    for (NSString *key in parameters) {
+        id value = parameters[key];
+
+        if ([value isKindOfClass:[NSDictionary class]]) {
+            [self appendQueryStringFromParameters:value toQueryString:queryString];
+        } else {
+            if ([queryString length] > 0) {
+                [queryString appendString:@"&"];
+            }
+            [queryString appendString:[key aws_stringWithURLEncoding]];
+            [queryString appendString:@"="];
+            [self appendQueryStringValue:value toQueryString:queryString];
+        }
+    }
+}
+
++ (void)appendQueryStringValue:(id)value
+                 toQueryString:(NSMutableString *)queryString {
+    if ([value isKindOfClass:[NSString class]]) {
+        [queryString appendString:[value aws_stringWithURLEncoding]];
+    } else if ([value isKindOfClass:[NSNumber class]]) {
+        [queryString appendString:[[value stringValue] aws_stringWithURLEncoding]];
+    } else if ([value isKindOfClass:[NSArray class]]) {
+        BOOL isFirstElement = YES;
+        for (id element in value) {
+            if (!isFirstElement) {
+                [queryString appendString:@","];
+            }
+            isFirstElement = NO;
+            [self appendQueryStringValue:element toQueryString:queryString];
+        }
+    } else {
+        AWSDDLogError(@"value[%@] is invalid.", value);
+        [queryString appendString:[[value description] aws_stringWithURLEncoding]];
+    }
+}
+
 @end
@@ -20,6 +20,7 @@
 #import "AWSSignature.h"
 #import "AWSBolts.h"
 #import "AWSCredentialsProvider.h"
+#import "AWSSerialization.h"
 
 NSString* const AWSResponseObjectErrorUserInfoKey = @"ResponseObjectError";
 
@@ -50,6 +51,8 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 @property (nonatomic, strong) NSURL *tempDownloadedFileURL;
 @property (nonatomic, assign) BOOL shouldWriteDirectly;
 @property (nonatomic, assign) BOOL shouldWriteToFile;
+@property (nonatomic, assign) BOOL shouldStreamResponseData;
+@property (nonatomic, assign) BOOL didStreamResponseData;
 
 @property (atomic, assign) int64_t lastTotalLengthOfChunkSignatureSent;
 @property (atomic, assign) int64_t payloadTotalBytesWritten;
@@ -348,9 +351,11 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
             }
         }
 
+        // The caller has already consumed part of a streamed body; a retry would hand it the same bytes again.
         if (delegate.error
             && ([sessionTask.response isKindOfClass:[NSHTTPURLResponse class]] || sessionTask.response == nil)
-            && delegate.request.retryHandler) {
+            && delegate.request.retryHandler
+            && !delegate.didStreamResponseData) {
             AWSNetworkingRetryType retryType = [delegate.request.retryHandler shouldRetry:delegate.currentRetryCount
                                                                           originalRequest:delegate.request
                                                                                  response:(NSHTTPURLResponse *)sessionTask.response
@@ -440,6 +445,16 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
     }];
 }
 
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task needNewBodyStream:(void (^)(NSInputStream *bodyStream))completionHandler {
+    //The body has to be sent again, e.g. after a redirect. A JSON body stream can be read again from the start.
+    NSInputStream *inputStream = task.originalRequest.HTTPBodyStream;
+    if ([inputStream isKindOfClass:[AWSJSONBodyStream class]]) {
+        completionHandler([inputStream copy]);
+    } else {
+        completionHandler(nil);
+    }
+}
+
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didSendBodyData:(int64_t)bytesSent totalBytesSent:(int64_t)totalBytesSent totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend {
     AWSURLSessionManagerDelegate *delegate = [self.sessionManagerDelegates objectForKey:@(task.taskIdentifier)];
     AWSNetworkingUploadProgressBlock uploadProgress = delegate.request.uploadProgress;
@@ -476,9 +491,11 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
         
         if (httpResponse.statusCode >= 200 && httpResponse.statusCode < 300) {
             // status is good, we can keep value of shouldWriteToFile
+            delegate.shouldStreamResponseData = (delegate.request.responseDataHandler != nil);
         } else {
             // got error status code, avoid write data to disk
             delegate.shouldWriteToFile = NO;
+            delegate.shouldStreamResponseData = NO;
         }
     }
     
@@ -558,7 +575,10 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 - (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
     AWSURLSessionManagerDelegate *delegate = [self.sessionManagerDelegates objectForKey:@(dataTask.taskIdentifier)];
     
-    if (delegate.responseFilehandle) {
+    if (delegate.shouldStreamResponseData) {
+        delegate.didStreamResponseData = YES;
+        delegate.request.responseDataHandler(data);
+    } else if (delegate.responseFilehandle) {
         @try{
             [delegate.responseFilehandle writeData:data];
         }
@@ -604,7 +624,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
 - (void)printHTTPHeadersAndBodyForRequest:(NSURLRequest *)request {
     AWSDDLogDebug(@"Request headers:\n%@", request.allHTTPHeaderFields);
-    if([AWSDDLog sharedInstance].logLevel & AWSDDLogFlagDebug){
+    if(AWSDDLogSharedLogLevel() & AWSDDLogFlagDebug){
         if(request.HTTPBody) {
             NSMutableString *bodyString = [[NSMutableString alloc] initWithData:request.HTTPBody
                                                                        encoding:NSUTF8StringEncoding];
@@ -630,7 +650,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 }
 
 - (void)printHTTPHeadersForResponse:(NSURLResponse *)response {
-    if([AWSDDLog sharedInstance].logLevel & AWSDDLogFlagDebug){
+    if(AWSDDLogSharedLogLevel() & AWSDDLogFlagDebug){
         if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
             AWSDDLogDebug(@"Response headers:\n%@", ((NSHTTPURLResponse *)response).allHeaderFields);
         }
@@ -147,6 +147,30 @@ typedef NS_ENUM(NSInteger, AWSJSONParserErrorType) {
 
 @end
 
+/**
+ Blob members at least this long, 256KB, are base64 encoded while the body is read from an `AWSJSONBodyStream`, instead of in memory.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSJSONBuilderStreamingBlobThreshold;
+
+/**
+ A stream of a JSON body, whose large blob members are base64 encoded as they are read. Only the JSON around the blobs and one buffer of the body are held in memory, so a blob read from a memory mapped file is never copied as a whole.
+
+ The body is encoded on a background queue into a bound stream pair, and the stream forwards to its read side, so it can be the `HTTPBodyStream` of a request.
+ */
+@interface AWSJSONBodyStream : NSInputStream <NSCopying>
+
+/**
+ The length of the body in bytes.
+ */
+@property (nonatomic, assign, readonly) unsigned long long contentLength;
+
+/**
+ The SHA-256 digest of the body. It is computed by reading a copy of the stream the first time it is requested.
+ */
+@property (nonatomic, strong, readonly) NSData *contentSHA256;
+
+@end
+
 @interface AWSJSONBuilder : NSObject
 
 + (NSData *)jsonDataForDictionary:(NSDictionary *)params
@@ -154,6 +178,17 @@ typedef NS_ENUM(NSInteger, AWSJSONParserErrorType) {
             serviceDefinitionRule:(NSDictionary *)serviceDefinitionRule
                             error:(NSError *__autoreleasing *)error;
 
+/**
+ Builds the JSON body of a request. When `bodyStream` is not `NULL` and a blob member is at least `AWSJSONBuilderStreamingBlobThreshold` bytes long, the body is not built in memory: `*bodyStream` is set to a stream of the body, and `nil` is returned. Otherwise it returns the same data as `+ jsonDataForDictionary:actionName:serviceDefinitionRule:error:`.
+
+ A blob member can be an `NSData` mapped from a file with `NSDataReadingMappedIfSafe`, to stream it from the file.
+ */
++ (NSData *)jsonDataForDictionary:(NSDictionary *)params
+                       actionName:(NSString *)actionName
+            serviceDefinitionRule:(NSDictionary *)serviceDefinitionRule
+                       bodyStream:(AWSJSONBodyStream *__autoreleasing *)bodyStream
+                            error:(NSError *__autoreleasing *)error;
+
 @end
 
 @interface AWSJSONParser : NSObject
@@ -13,8 +13,9 @@
 // permissions and limitations under the License.
 //
 #import "AWSSerialization.h"
+#import <CommonCrypto/CommonCrypto.h>
 #import "AWSTimestampSerialization.h"
-#import "AWSXMLWriter.h"
+#import "AWSXMLDataWriter.h"
 #import "AWSCategory.h"
 #import "AWSCocoaLumberjack.h"
 #import "AWSXMLDictionary.h"
@@ -25,6 +26,11 @@ NSString *const AWSQueryParamBuilderErrorDomain = @"com.amazonaws.AWSQueryParamB
 NSString *const AWSEC2ParamBuilderErrorDomain = @"com.amazonaws.AWSEC2ParamBuilderErrorDomain";
 NSString *const AWSJSONBuilderErrorDomain = @"com.amazonaws.AWSJSONBuilderErrorDomain";
 NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDomain";
+
+NSUInteger const AWSJSONBuilderStreamingBlobThreshold = 256 * 1024;
+
+// The size of the buffers an AWSJSONBodyStream is encoded and hashed through.
+static NSUInteger const AWSJSONBodyStreamBufferSize = 64 * 1024;
 @interface AWSJSONDictionary()
 
 @property (nonatomic, strong) NSDictionary *embeddedDictionary;
@@ -93,6 +99,23 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
 
 @end
 
+// Whether a number holds a signed integer, which `- stringValue` formats the same way as `- writeInteger:` does.
+static BOOL aws_isSignedIntegerNumber(id value) {
+    if (![value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSDecimalNumber class]]) {
+        return NO;
+    }
+    switch (*[value objCType]) {
+        case 'c':
+        case 's':
+        case 'i':
+        case 'l':
+        case 'q':
+            return YES;
+        default:
+            return NO;
+    }
+}
+
 @implementation AWSXMLBuilder
 
 + (BOOL)failWithCode:(NSInteger)code description:(NSString *)description error:(NSError *__autoreleasing *)error {
@@ -118,7 +141,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     return resultData;
 }
 
-+ (AWSXMLWriter *)xmlBuildForDictionary:(NSDictionary *)params actionName:(NSString *)actionName serviceDefinitionRule:(NSDictionary *)serviceDefinitionRule error:(NSError *__autoreleasing *)error {
++ (AWSXMLDataWriter *)xmlBuildForDictionary:(NSDictionary *)params actionName:(NSString *)actionName serviceDefinitionRule:(NSDictionary *)serviceDefinitionRule error:(NSError *__autoreleasing *)error {
 
     NSDictionary *actionRule = [[[serviceDefinitionRule objectForKey:@"operations"] objectForKey:actionName] objectForKey:@"input"];
     NSDictionary *definitionRules = [serviceDefinitionRule objectForKey:@"shapes"];
@@ -136,7 +159,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     }
 
 
-    AWSXMLWriter* xmlWriter = [[AWSXMLWriter alloc]init];
+    AWSXMLDataWriter *xmlWriter = [AWSXMLDataWriter new];
     AWSJSONDictionary *rules = [[AWSJSONDictionary alloc] initWithDictionary:actionRule JSONDefinitionRule:definitionRules];
 
     NSString *xmlElementName = rules[@"locationName"];
@@ -154,7 +177,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     return xmlWriter;
 }
 
-+ (BOOL)serializeStructure:(NSDictionary *)params rules:(AWSJSONDictionary *)rules xmlWriter:(AWSXMLWriter *)xmlWriter error:(NSError *__autoreleasing *)error isRootRule:(BOOL)isRootRule {
++ (BOOL)serializeStructure:(NSDictionary *)params rules:(AWSJSONDictionary *)rules xmlWriter:(AWSXMLDataWriter *)xmlWriter error:(NSError *__autoreleasing *)error isRootRule:(BOOL)isRootRule {
 
     AWSJSONDictionary *structureMembersRule = rules[@"members"]?rules[@"members"]:@{};
 
@@ -204,7 +227,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     return isValid;
 }
 
-+ (BOOL)serializeList:(NSArray *)list name:(NSString *)name rules:(AWSJSONDictionary *)rules xmlWriter:(AWSXMLWriter *)xmlWriter error:(NSError *__autoreleasing *)error {
++ (BOOL)serializeList:(NSArray *)list name:(NSString *)name rules:(AWSJSONDictionary *)rules xmlWriter:(AWSXMLDataWriter *)xmlWriter error:(NSError *__autoreleasing *)error {
 
     AWSJSONDictionary *memberRules = rules[@"member"]?rules[@"member"]:@{};
     NSString *xmlListName = rules[@"locationName"]?rules[@"locationName"]:name;
@@ -242,7 +265,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     return isValid;
 }
 
-+ (BOOL)serializeMember:(id)params name:(NSString *)memberName rules:(AWSJSONDictionary *)rules isPayloadType:(Boolean)isPayloadType xmlWriter:(AWSXMLWriter *)xmlWriter error:(NSError *__autoreleasing *)error {
++ (BOOL)serializeMember:(id)params name:(NSString *)memberName rules:(AWSJSONDictionary *)rules isPayloadType:(Boolean)isPayloadType xmlWriter:(AWSXMLDataWriter *)xmlWriter error:(NSError *__autoreleasing *)error {
     NSString *xmlElementName = rules[@"locationName"]?rules[@"locationName"]:memberName;
     NSString *rulesType = rules[@"type"];
     if ([rulesType isEqualToString:@"structure"]) {
@@ -262,7 +285,11 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     } else if ([rulesType isEqualToString:@"integer"] || [rulesType isEqualToString:@"long"] || [rulesType isEqualToString:@"float"] || [rulesType isEqualToString:@"double"]) {
         NSNumber *numberValue = params;
         if (isPayloadType == NO) [xmlWriter writeStartElement:xmlElementName];
-        [xmlWriter writeCharacters:[numberValue stringValue]];
+        if (aws_isSignedIntegerNumber(numberValue)) {
+            [xmlWriter writeInteger:[numberValue longLongValue]];
+        } else {
+            [xmlWriter writeCharacters:[numberValue stringValue]];
+        }
         if (isPayloadType == NO) [xmlWriter writeEndElement:xmlElementName];
     } else if ([rulesType isEqualToString:@"blob"]) {
         //just handle the non-streaming body, streaming body will be handled in 'constructURIandHeadersAndBody' method
@@ -306,7 +333,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     return YES;
 }
 
-+ (void)applyNamespacesAndAttributesByRules:(NSDictionary *)rules params:(id)params xmlWriter:(AWSXMLWriter *)xmlWriter {
++ (void)applyNamespacesAndAttributesByRules:(NSDictionary *)rules params:(id)params xmlWriter:(AWSXMLDataWriter *)xmlWriter {
     id xmlNamespaceValue = rules[@"xmlNamespace"];
     if (xmlNamespaceValue) {
         if ([xmlNamespaceValue isKindOfClass:[NSDictionary class]]) {
@@ -1142,6 +1169,332 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
 
 @end
 
+#pragma mark - AWSJSONBodyStream
+
+static const uint8_t aws_base64EncodingTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Base64 encodes one group of up to 3 bytes into 4 bytes, padded with '='.
+static void aws_base64EncodeGroup(const uint8_t *input, NSUInteger length, uint8_t *output) {
+    uint32_t group = (uint32_t)input[0] << 16;
+    if (length > 1) {
+        group |= (uint32_t)input[1] << 8;
+    }
+    if (length > 2) {
+        group |= input[2];
+    }
+    output[0] = aws_base64EncodingTable[(group >> 18) & 0x3F];
+    output[1] = aws_base64EncodingTable[(group >> 12) & 0x3F];
+    output[2] = length > 1 ? aws_base64EncodingTable[(group >> 6) & 0x3F] : '=';
+    output[3] = length > 2 ? aws_base64EncodingTable[group & 0x3F] : '=';
+}
+
+// Base64 encodes the blobs of a JSON body as it is read.
+@interface AWSJSONBodyEncoder : NSObject
+
+// The JSON around the blobs at even indexes, and the blobs to base64 encode at odd indexes.
+@property (nonatomic, strong) NSArray<NSData *> *parts;
+@property (nonatomic, assign) NSUInteger partIndex;
+@property (nonatomic, assign) NSUInteger partOffset;
+
+// The end of a base64 group that did not fit in the caller's buffer.
+@property (nonatomic, assign) NSUInteger pendingLength;
+@property (nonatomic, assign) NSUInteger pendingOffset;
+
+- (instancetype)initWithParts:(NSArray<NSData *> *)parts;
+
+// Returns the number of bytes written to `buffer`, 0 at the end of the body.
+- (NSUInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len;
+
+@end
+
+@implementation AWSJSONBodyEncoder {
+    uint8_t _pending[4];
+}
+
+- (instancetype)initWithParts:(NSArray<NSData *> *)parts {
+    if (self = [super init]) {
+        _parts = parts;
+    }
+
+    return self;
+}
+
+- (NSUInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
+    NSUInteger written = 0;
+    NSUInteger partIndex = self.partIndex;
+    NSUInteger partOffset = self.partOffset;
+
+    while (written < len) {
+        if (self.pendingOffset < self.pendingLength) {
+            NSUInteger length = MIN(len - written, self.pendingLength - self.pendingOffset);
+            memcpy(buffer + written, _pending + self.pendingOffset, length);
+            self.pendingOffset += length;
+            written += length;
+            continue;
+        }
+        if (partIndex >= [self.parts count]) {
+            break;
+        }
+
+        NSData *part = self.parts[partIndex];
+        const uint8_t *bytes = [part bytes];
+        NSUInteger partLength = [part length];
+
+        if (partIndex % 2 == 0) {
+            NSUInteger length = MIN(len - written, partLength - partOffset);
+            memcpy(buffer + written, bytes + partOffset, length);
+            partOffset += length;
+            written += length;
+        } else {
+            NSUInteger groups = MIN((len - written) / 4, (partLength - partOffset + 2) / 3);
+            if (groups == 0 && partOffset < partLength) {
+                // Less than a group fits, keep the rest of it for the next read.
+                NSUInteger length = MIN(3, partLength - partOffset);
+                aws_base64EncodeGroup(bytes + partOffset, length, _pending);
+                partOffset += length;
+                self.pendingLength = 4;
+                self.pendingOffset = 0;
+                continue;
+            }
+            for (NSUInteger i = 0; i < groups; i++) {
+                NSUInteger length = MIN(3, partLength - partOffset);
+                aws_base64EncodeGroup(bytes + partOffset, length, buffer + written);
+                partOffset += length;
+                written += 4;
+            }
+        }
+
+        if (partOffset >= partLength) {
+            partIndex++;
+            partOffset = 0;
+        }
+    }
+
+    self.partIndex = partIndex;
+    self.partOffset = partOffset;
+
+    return written;
+}
+
+@end
+
+@interface AWSJSONBodyStream()
+
+@property (nonatomic, strong) NSArray<NSData *> *parts;
+@property (nonatomic, strong) NSData *contentSHA256;
+
+// The body is written to `outputStream` as it is read from `stream`, the other end of the bound pair.
+@property (nonatomic, strong) NSInputStream *stream;
+@property (nonatomic, strong) NSOutputStream *outputStream;
+
+- (instancetype)initWithJSONData:(NSData *)data blobs:(NSDictionary<NSString *, NSData *> *)blobs;
+
+@end
+
+@implementation AWSJSONBodyStream
+
+@synthesize delegate = _delegate;
+
+- (instancetype)initWithJSONData:(NSData *)data blobs:(NSDictionary<NSString *, NSData *> *)blobs {
+    // Find where each placeholder was written, the JSON string quotes around it are kept.
+    NSMutableArray<NSValue *> *ranges = [NSMutableArray arrayWithCapacity:[blobs count]];
+    NSMutableDictionary<NSValue *, NSData *> *blobsByRange = [NSMutableDictionary dictionaryWithCapacity:[blobs count]];
+    for (NSString *placeholder in blobs) {
+        NSRange range = [data rangeOfData:[placeholder dataUsingEncoding:NSUTF8StringEncoding]
+                                  options:0
+                                    range:NSMakeRange(0, [data length])];
+        if (range.location != NSNotFound) {
+            NSValue *rangeValue = [NSValue valueWithRange:range];
+            [ranges addObject:rangeValue];
+            blobsByRange[rangeValue] = blobs[placeholder];
+        }
+    }
+    [ranges sortUsingComparator:^NSComparisonResult(NSValue *range1, NSValue *range2) {
+        return [@([range1 rangeValue].location) compare:@([range2 rangeValue].location)];
+    }];
+
+    NSMutableArray<NSData *> *parts = [NSMutableArray arrayWithCapacity:[ranges count] * 2 + 1];
+    NSUInteger location = 0;
+    for (NSValue *rangeValue in ranges) {
+        NSRange range = [rangeValue rangeValue];
+        [parts addObject:[data subdataWithRange:NSMakeRange(location, range.location - location)]];
+        [parts addObject:blobsByRange[rangeValue]];
+        location = NSMaxRange(range);
+    }
+    [parts addObject:[data subdataWithRange:NSMakeRange(location, [data length] - location)]];
+
+    return [self initWithParts:parts];
+}
+
+- (instancetype)initWithParts:(NSArray<NSData *> *)parts {
+    if (self = [super init]) {
+        _parts = parts;
+
+        unsigned long long contentLength = 0;
+        for (NSUInteger i = 0; i < [parts count]; i++) {
+            NSUInteger length = [parts[i] length];
+            contentLength += (i % 2 == 0) ? length : (length + 2) / 3 * 4;
+        }
+        _contentLength = contentLength;
+
+        CFReadStreamRef readStream = NULL;
+        CFWriteStreamRef writeStream = NULL;
+        CFStreamCreateBoundPair(kCFAllocatorDefault, &readStream, &writeStream, AWSJSONBodyStreamBufferSize);
+        _stream = CFBridgingRelease(readStream);
+        _stream.delegate = self;
+        _outputStream = CFBridgingRelease(writeStream);
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    // Unblocks the writer if the body was not read to the end.
+    _stream.delegate = nil;
+    [_stream close];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    AWSJSONBodyStream *stream = [[[self class] allocWithZone:zone] initWithParts:self.parts];
+    @synchronized(self) {
+        stream.contentSHA256 = _contentSHA256;
+    }
+    return stream;
+}
+
+- (NSData *)contentSHA256 {
+    @synchronized(self) {
+        if (!_contentSHA256) {
+            AWSJSONBodyEncoder *encoder = [[AWSJSONBodyEncoder alloc] initWithParts:self.parts];
+            uint8_t *buffer = malloc(AWSJSONBodyStreamBufferSize);
+            CC_SHA256_CTX context;
+            CC_SHA256_Init(&context);
+
+            NSUInteger read;
+            while ((read = [encoder read:buffer maxLength:AWSJSONBodyStreamBufferSize]) > 0) {
+                CC_SHA256_Update(&context, buffer, (CC_LONG)read);
+            }
+            free(buffer);
+
+            NSMutableData *digest = [NSMutableData dataWithLength:CC_SHA256_DIGEST_LENGTH];
+            CC_SHA256_Final([digest mutableBytes], &context);
+            _contentSHA256 = digest;
+        }
+        return _contentSHA256;
+    }
+}
+
+// Encodes the body into the output stream. The writes block until the reader has taken the previous bytes, so only one
+// buffer of the body is in memory at a time. Closing the read side ends the writes.
+- (void)startWriting {
+    AWSJSONBodyEncoder *encoder = [[AWSJSONBodyEncoder alloc] initWithParts:self.parts];
+    NSOutputStream *outputStream = self.outputStream;
+    self.outputStream = nil;
+    [outputStream open];
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        uint8_t *buffer = malloc(AWSJSONBodyStreamBufferSize);
+        BOOL failed = NO;
+        NSUInteger length;
+        while (!failed && (length = [encoder read:buffer maxLength:AWSJSONBodyStreamBufferSize]) > 0) {
+            NSUInteger offset = 0;
+            while (offset < length) {
+                NSInteger written = [outputStream write:buffer + offset maxLength:length - offset];
+                if (written <= 0) {
+                    failed = YES;
+                    break;
+                }
+                offset += written;
+            }
+        }
+        free(buffer);
+        [outputStream close];
+    });
+}
+
+- (void)stream:(NSStream *)aStream handleEvent:(NSStreamEvent)eventCode {
+    id<NSStreamDelegate> delegate = self.delegate;
+    if (delegate != self && [delegate respondsToSelector:@selector(stream:handleEvent:)]) {
+        [delegate stream:self handleEvent:eventCode];
+    }
+}
+
+#pragma mark NSInputStream methods
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
+    return [self.stream read:buffer maxLength:len];
+}
+
+- (BOOL)hasBytesAvailable {
+    return [self.stream hasBytesAvailable];
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
+    return NO;
+}
+
+- (void)open {
+    if ([self.stream streamStatus] == NSStreamStatusNotOpen) {
+        [self.stream open];
+        [self startWriting];
+    }
+}
+
+- (void)close {
+    [self.stream close];
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode {
+    [self.stream scheduleInRunLoop:aRunLoop forMode:mode];
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode {
+    [self.stream removeFromRunLoop:aRunLoop forMode:mode];
+}
+
+- (id)propertyForKey:(NSString *)key {
+    return [self.stream propertyForKey:key];
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSString *)key {
+    return [self.stream setProperty:property forKey:key];
+}
+
+- (NSStreamStatus)streamStatus {
+    return [self.stream streamStatus];
+}
+
+- (NSError *)streamError {
+    return [self.stream streamError];
+}
+
+#pragma mark CFReadStream bridging
+
+// CFNetwork schedules an upload body with the CFReadStream functions, which call these methods on an `NSInputStream`
+// subclass. The bound stream delivers the events.
+
+- (void)_scheduleInCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode {
+    CFReadStreamScheduleWithRunLoop((__bridge CFReadStreamRef)self.stream, runLoop, mode);
+}
+
+- (void)_unscheduleFromCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode {
+    CFReadStreamUnscheduleFromRunLoop((__bridge CFReadStreamRef)self.stream, runLoop, mode);
+}
+
+- (BOOL)_setCFClientFlags:(CFOptionFlags)flags callback:(CFReadStreamClientCallBack)callback context:(CFStreamClientContext *)context {
+    return CFReadStreamSetClient((__bridge CFReadStreamRef)self.stream, flags, callback, context);
+}
+
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)aSelector {
+    return [self.stream methodSignatureForSelector:aSelector];
+}
+
+- (void)forwardInvocation:(NSInvocation *)anInvocation {
+    [anInvocation invokeWithTarget:self.stream];
+}
+
+@end
+
 @implementation AWSJSONBuilder
 
 + (BOOL)failWithCode:(NSInteger)code description:(NSString *)description error:(NSError *__autoreleasing *)error {
@@ -1157,8 +1510,25 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
                        actionName:(NSString *)actionName
             serviceDefinitionRule:(NSDictionary *)serviceDefinitionRule
                             error:(NSError *__autoreleasing *)error {
+    return [self jsonDataForDictionary:params
+                            actionName:actionName
+                 serviceDefinitionRule:serviceDefinitionRule
+                            bodyStream:NULL
+                                 error:error];
+}
 
-    id serializedJsonObject = [self buildJSONDictionary:params actionName:actionName serviceDefinitionRule:serviceDefinitionRule error:error];
++ (NSData *)jsonDataForDictionary:(NSDictionary *)params
+                       actionName:(NSString *)actionName
+            serviceDefinitionRule:(NSDictionary *)serviceDefinitionRule
+                       bodyStream:(AWSJSONBodyStream *__autoreleasing *)bodyStream
+                            error:(NSError *__autoreleasing *)error {
+    if (bodyStream) {
+        *bodyStream = nil;
+    }
+
+    // Large blobs are replaced by placeholders, and spliced back in by the body stream.
+    NSMutableDictionary<NSString *, NSData *> *blobs = bodyStream ? [NSMutableDictionary new] : nil;
+    id serializedJsonObject = [self buildJSONDictionary:params actionName:actionName serviceDefinitionRule:serviceDefinitionRule blobs:blobs error:error];
 
     if (!serializedJsonObject) {
         serializedJsonObject = @{};
@@ -1176,6 +1546,10 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
         NSData *bodyData = [NSJSONSerialization dataWithJSONObject:serializedJsonObject
                                                            options:0
                                                              error:error];
+        if (bodyData && [blobs count] > 0) {
+            *bodyStream = [[AWSJSONBodyStream alloc] initWithJSONData:bodyData blobs:blobs];
+            return nil;
+        }
         return bodyData;
     }
 
@@ -1185,6 +1559,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
 + (NSDictionary *)buildJSONDictionary:(NSDictionary *)params
                            actionName:(NSString *)actionName
                 serviceDefinitionRule:(NSDictionary *)serviceDefinitionRule
+                                blobs:(NSMutableDictionary<NSString *, NSData *> *)blobs
                                 error:(NSError *__autoreleasing *)error {
 
     if ([params count] == 0) {
@@ -1208,14 +1583,14 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
 
     AWSJSONDictionary *rules = [[AWSJSONDictionary alloc] initWithDictionary:actionRule JSONDefinitionRule:definitionRules];
 
-    id resultParams = [self serializeMember:rules value:params isPayloadType:NO error:error];
+    id resultParams = [self serializeMember:rules value:params isPayloadType:NO blobs:blobs error:error];
 
     return resultParams;
 
 
 }
 
-+ (NSDictionary *)serializeStructure:(NSDictionary *)structureRules values:(NSDictionary *)values error:(NSError *__autoreleasing *)error {
++ (NSDictionary *)serializeStructure:(NSDictionary *)structureRules values:(NSDictionary *)values blobs:(NSMutableDictionary<NSString *, NSData *> *)blobs error:(NSError *__autoreleasing *)error {
 
     NSMutableDictionary *data = [NSMutableDictionary new];
 
@@ -1231,7 +1606,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
 
         if (memberShape && value) {
             NSString *name = memberShape[@"locationName"]?memberShape[@"locationName"]:key;
-            data[name] = [self serializeMember:memberShape value:value isPayloadType:NO error:error];
+            data[name] = [self serializeMember:memberShape value:value isPayloadType:NO blobs:blobs error:error];
         }
 
     }
@@ -1239,31 +1614,31 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     return data;
 }
 
-+ (NSArray *)serializeList:(NSDictionary *)listRules values:(NSArray *)values error:(NSError *__autoreleasing *)error {
++ (NSArray *)serializeList:(NSDictionary *)listRules values:(NSArray *)values blobs:(NSMutableDictionary<NSString *, NSData *> *)blobs error:(NSError *__autoreleasing *)error {
     NSMutableArray *dataArray = [NSMutableArray new];
 
     for (id value in values) {
 
-        [dataArray addObject:[self serializeMember:listRules[@"member"] value:value isPayloadType:NO error:error]];
+        [dataArray addObject:[self serializeMember:listRules[@"member"] value:value isPayloadType:NO blobs:blobs error:error]];
 
     }
 
     return dataArray;
 }
 
-+ (NSDictionary *)serializeMap:(NSDictionary *)mapRules values:(NSDictionary *)values error:(NSError *__autoreleasing *)error {
++ (NSDictionary *)serializeMap:(NSDictionary *)mapRules values:(NSDictionary *)values blobs:(NSMutableDictionary<NSString *, NSData *> *)blobs error:(NSError *__autoreleasing *)error {
 
     NSMutableDictionary *data = [NSMutableDictionary new];
 
     for (NSString *key in values) {
         id value = values[key];
-        data[key] = [self serializeMember:mapRules[@"value"] value:value isPayloadType:NO error:error];
+        data[key] = [self serializeMember:mapRules[@"value"] value:value isPayloadType:NO blobs:blobs error:error];
     }
 
     return data;
 }
 
-+ (id)serializeMember:(NSDictionary *)shape value:(id)value isPayloadType:(BOOL)isPayloadType error:(NSError *__autoreleasing *)error {
++ (id)serializeMember:(NSDictionary *)shape value:(id)value isPayloadType:(BOOL)isPayloadType blobs:(NSMutableDictionary<NSString *, NSData *> *)blobs error:(NSError *__autoreleasing *)error {
     NSString *payloadMemberName = shape[@"payload"];
     if (payloadMemberName) {
         id payload = value[payloadMemberName];
@@ -1271,7 +1646,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
             AWSJSONDictionary *structureMembersRule = shape[@"members"]?shape[@"members"]:@{};
             AWSJSONDictionary *payloadMemberRules = structureMembersRule[payloadMemberName];
 
-            return [self serializeMember:payloadMemberRules value:payload isPayloadType:YES error:error];
+            return [self serializeMember:payloadMemberRules value:payload isPayloadType:YES blobs:blobs error:error];
         }
     }
 
@@ -1285,7 +1660,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
             return @{};
         } else {
 
-            return [self serializeStructure:shape values:value error:error];
+            return [self serializeStructure:shape values:value blobs:blobs error:error];
         }
 
     } else if ([rulesType isEqualToString:@"list"]) {
@@ -1296,7 +1671,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
             }
             return @[];
         } else {
-            return [self serializeList:shape values:value error:error];
+            return [self serializeList:shape values:value blobs:blobs error:error];
         }
 
 
@@ -1308,7 +1683,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
             }
             return @{};
         } else {
-            return [self serializeMap:shape values:value error:error];
+            return [self serializeMap:shape values:value blobs:blobs error:error];
         }
 
     } else if ([rulesType isEqualToString:@"timestamp"]) {
@@ -1331,6 +1706,11 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
             if (isPayloadType) {
                 //Do not base64 encoding if it is payload type
                 return value;
+            } else if (blobs && [value length] >= AWSJSONBuilderStreamingBlobThreshold) {
+                //Leave a placeholder, the body stream base64 encodes the blob as it is read
+                NSString *placeholder = [[NSUUID UUID] UUIDString];
+                blobs[placeholder] = value;
+                return placeholder;
             } else {
                 NSString *base64encodedStr = [value base64EncodedStringWithOptions:0];
                 return base64encodedStr?base64encodedStr:@"";
@@ -15,6 +15,7 @@
 #import "AWSURLRequestSerialization.h"
 
 #import "AWSGZIP.h"
+#import "AWSGZIPStream.h"
 #import "AWSBolts.h"
 #import "AWSNetworking.h"
 #import "AWSValidation.h"
@@ -22,6 +23,7 @@
 #import "AWSCategory.h"
 #import "AWSCocoaLumberjack.h"
 #import "AWSClientContext.h"
+#import "AWSNetworkingHelpers.h"
 
 @interface NSMutableURLRequest (AWSRequestSerializer)
 
@@ -110,11 +112,28 @@
 
     //construct HTTPBody only if HTTPBodyStream is nil
     if (!request.HTTPBodyStream) {
-        NSData *bodyData = [AWSJSONBuilder jsonDataForDictionary:parameters actionName:self.actionName serviceDefinitionRule:self.serviceDefinitionJSON error:&error];
+        BOOL shouldGzip = headers[@"Content-Encoding"] && [headers[@"Content-Encoding"] rangeOfString:@"gzip"].location != NSNotFound;
+        AWSJSONBodyStream *bodyStream = nil;
+        NSData *bodyData = [AWSJSONBuilder jsonDataForDictionary:parameters
+                                                      actionName:self.actionName
+                                           serviceDefinitionRule:self.serviceDefinitionJSON
+                                                      bodyStream:&bodyStream
+                                                           error:&error];
         if (!error) {
-            if (headers[@"Content-Encoding"] && [headers[@"Content-Encoding"] rangeOfString:@"gzip"].location != NSNotFound) {
-                //gzip the body
-                request.HTTPBody = [bodyData awsgzip_gzippedData];
+            if (shouldGzip) {
+                //gzip the body, a body with large blobs is compressed as it is read so only the gzipped body is in memory
+                if (bodyStream) {
+                    request.HTTPBody = [AWSGZIPCodec gzippedDataWithContentsOfStream:bodyStream
+                                                                              length:bodyStream.contentLength
+                                                                               level:-1.0f
+                                                                               error:&error];
+                } else {
+                    request.HTTPBody = [AWSGZIPCodec gzippedData:bodyData level:-1.0f error:&error];
+                }
+            } else if (bodyStream) {
+                request.HTTPBodyStream = bodyStream;
+                [request setValue:[NSString stringWithFormat:@"%llu", bodyStream.contentLength]
+               forHTTPHeaderField:@"Content-Length"];
             } else {
                 request.HTTPBody = bodyData;
             }
@@ -491,38 +510,6 @@
 
 }
 
-- (void)processParameters:(NSDictionary *)parameters queryString:(NSMutableString *)queryString {
-    for (NSString *key in parameters) {
-        id obj = parameters[key];
-
-        if ([obj isKindOfClass:[NSDictionary class]]) {
-            [self processParameters:obj queryString:queryString];
-        } else {
-
-            if ([queryString length] > 0) {
-                [queryString appendString:@"&"];
-            }
-
-            if ([obj isKindOfClass:[NSString class]]) {
-                [queryString appendString:[key aws_stringWithURLEncoding]];
-                [queryString appendString:@"="];
-                NSString *urlEncodedString = [obj aws_stringWithURLEncoding];
-                [queryString appendString:urlEncodedString];
-            } else if ([obj isKindOfClass:[NSNumber class]]) {
-                [queryString appendString:[key aws_stringWithURLEncoding]];
-                [queryString appendString:@"="];
-                [queryString appendString:[[obj stringValue] aws_stringWithURLEncoding]];
-            } else {
-                AWSDDLogError(@"key[%@] is invalid.", key);
-                [queryString appendString:[key aws_stringWithURLEncoding]];
-                [queryString appendString:@"="];
-                [queryString appendString:[[obj description]aws_stringWithURLEncoding]];
-            }
-        }
-    }
-
-}
-
 - (AWSTask *)serializeRequest:(NSMutableURLRequest *)request
                       headers:(NSDictionary *)headers
                    parameters:(NSDictionary *)parameters {
@@ -543,10 +530,19 @@
     }
 
     NSMutableString *queryString = [NSMutableString new];
-    [self processParameters:formattedParams queryString:queryString];
+    [AWSNetworkingHelpers appendQueryStringFromParameters:formattedParams toQueryString:queryString];
 
     if ([queryString length] > 0) {
-        request.HTTPBody = [queryString dataUsingEncoding:NSUTF8StringEncoding];
+        NSData *bodyData = [queryString dataUsingEncoding:NSUTF8StringEncoding];
+        if (headers[@"Content-Encoding"] && [headers[@"Content-Encoding"] rangeOfString:@"gzip"].location != NSNotFound) {
+            //gzip the body
+            request.HTTPBody = [AWSGZIPCodec gzippedData:bodyData level:-1.0f error:&error];
+            if (error) {
+                return [AWSTask taskWithError:error];
+            }
+        } else {
+            request.HTTPBody = bodyData;
+        }
     }
 
     //contruct additional headers
@@ -55,7 +55,7 @@
                  currentRequest:(NSURLRequest *)currentRequest
                            data:(id)data
                           error:(NSError *__autoreleasing *)error {
-    if([AWSDDLog sharedInstance].logLevel & AWSDDLogFlagDebug){
+    if(AWSDDLogSharedLogLevel() & AWSDDLogFlagDebug){
         if ([data isKindOfClass:[NSData class]]) {
             if ([data length] <= 100 * 1024) {
                 AWSDDLogDebug(@"Response body:\n%@", [[NSString alloc] initWithData:data
@@ -233,7 +233,7 @@
                  currentRequest:(NSURLRequest *)currentRequest
                            data:(id)data
                           error:(NSError *__autoreleasing *)error {
-    if([AWSDDLog sharedInstance].logLevel & AWSDDLogFlagDebug){
+    if(AWSDDLogSharedLogLevel() & AWSDDLogFlagDebug){
         if ([data isKindOfClass:[NSData class]]) {
             if ([data length] <= 100 * 1024) {
                 AWSDDLogDebug(@"Response body:\n%@", [[NSString alloc] initWithData:data
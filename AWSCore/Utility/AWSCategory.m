@@ -46,6 +46,324 @@ NSString *const AWSDateShortDateFormat2 = @"yyyy-MM-dd";
 
 @end
 
+#pragma mark - Fixed-format timestamps
+
+// The formats in `AWSDateRFC822DateFormat1`, `AWSDateISO8601DateFormat1-3` and `AWSDateShortDateFormat1-2` have a fixed
+// layout, so they are parsed and formatted here directly on ASCII bytes instead of going through `NSDateFormatter`.
+// The functions below are pure and therefore thread-safe. Anything they do not accept in its canonical form
+// (other time zones, out of range fields, years outside 1583-9999 where ICU switches to the Julian calendar)
+// falls back to `NSDateFormatter`, so the results are identical to the formatter's.
+
+typedef NS_ENUM(NSInteger, AWSFixedDateFormat) {
+    AWSFixedDateFormatUnknown,
+    AWSFixedDateFormatRFC822,
+    AWSFixedDateFormatISO8601Extended,
+    AWSFixedDateFormatISO8601Basic,
+    AWSFixedDateFormatISO8601ExtendedMilliseconds,
+    AWSFixedDateFormatShortBasic,
+    AWSFixedDateFormatShortExtended,
+};
+
+static const int AWSFixedDateMinYear = 1583;
+static const int AWSFixedDateMaxYear = 9999;
+static const size_t AWSFixedDateMaxLength = 32;
+
+static const char *const AWSFixedDateWeekdays[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+static const char *const AWSFixedDateMonths[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+static AWSFixedDateFormat aws_fixedDateFormat(NSString *dateFormat) {
+    // Pointer comparison first, callers almost always pass the constants.
+    if (dateFormat == AWSDateISO8601DateFormat1 || [dateFormat isEqualToString:AWSDateISO8601DateFormat1]) {
+        return AWSFixedDateFormatISO8601Extended;
+    }
+    if (dateFormat == AWSDateISO8601DateFormat2 || [dateFormat isEqualToString:AWSDateISO8601DateFormat2]) {
+        return AWSFixedDateFormatISO8601Basic;
+    }
+    if (dateFormat == AWSDateRFC822DateFormat1 || [dateFormat isEqualToString:AWSDateRFC822DateFormat1]) {
+        return AWSFixedDateFormatRFC822;
+    }
+    if (dateFormat == AWSDateISO8601DateFormat3 || [dateFormat isEqualToString:AWSDateISO8601DateFormat3]) {
+        return AWSFixedDateFormatISO8601ExtendedMilliseconds;
+    }
+    if (dateFormat == AWSDateShortDateFormat1 || [dateFormat isEqualToString:AWSDateShortDateFormat1]) {
+        return AWSFixedDateFormatShortBasic;
+    }
+    if (dateFormat == AWSDateShortDateFormat2 || [dateFormat isEqualToString:AWSDateShortDateFormat2]) {
+        return AWSFixedDateFormatShortExtended;
+    }
+    return AWSFixedDateFormatUnknown;
+}
+
+// Days since 1970-01-01 of a date in the proleptic Gregorian calendar.
+static int64_t aws_daysFromCivil(int64_t year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static void aws_civilFromDays(int64_t days, int *year, int *month, int *day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    *day = (int)(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    *month = (int)(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    *year = (int)(yearOfEra + era * 400 + (*month <= 2));
+}
+
+static int aws_daysInMonth(int year, int month) {
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month == 2 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) {
+        return 29;
+    }
+    return days[month - 1];
+}
+
+// Reads `count` decimal digits, returns -1 if any of them is not a digit.
+static int aws_readDigits(const char *bytes, int count) {
+    int value = 0;
+    for (int i = 0; i < count; i++) {
+        char c = bytes[i];
+        if (c < '0' || c > '9') {
+            return -1;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+static int aws_indexOfName(const char *bytes, const char *const *names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (memcmp(bytes, names[i], 3) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void aws_writeDigits(char *bytes, int value, int count) {
+    for (int i = count - 1; i >= 0; i--) {
+        bytes[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+static BOOL aws_parseFixedDate(const char *bytes, size_t length, AWSFixedDateFormat format, int64_t *millisecondsSince1970) {
+    int year, month, day, hour = 0, minute = 0, second = 0, millisecond = 0;
+    switch (format) {
+        case AWSFixedDateFormatISO8601Extended:
+        case AWSFixedDateFormatISO8601ExtendedMilliseconds: {
+            // yyyy-MM-dd'T'HH:mm:ss'Z' / yyyy-MM-dd'T'HH:mm:ss.SSS'Z'
+            BOOL hasMilliseconds = format == AWSFixedDateFormatISO8601ExtendedMilliseconds;
+            if (length != (hasMilliseconds ? 24 : 20)
+                || bytes[4] != '-' || bytes[7] != '-' || bytes[10] != 'T' || bytes[13] != ':' || bytes[16] != ':'
+                || bytes[length - 1] != 'Z' || (hasMilliseconds && bytes[19] != '.')) {
+                return NO;
+            }
+            year = aws_readDigits(bytes, 4);
+            month = aws_readDigits(bytes + 5, 2);
+            day = aws_readDigits(bytes + 8, 2);
+            hour = aws_readDigits(bytes + 11, 2);
+            minute = aws_readDigits(bytes + 14, 2);
+            second = aws_readDigits(bytes + 17, 2);
+            if (hasMilliseconds) {
+                millisecond = aws_readDigits(bytes + 20, 3);
+            }
+            break;
+        }
+        case AWSFixedDateFormatISO8601Basic:
+            // yyyyMMdd'T'HHmmss'Z'
+            if (length != 16 || bytes[8] != 'T' || bytes[15] != 'Z') {
+                return NO;
+            }
+            year = aws_readDigits(bytes, 4);
+            month = aws_readDigits(bytes + 4, 2);
+            day = aws_readDigits(bytes + 6, 2);
+            hour = aws_readDigits(bytes + 9, 2);
+            minute = aws_readDigits(bytes + 11, 2);
+            second = aws_readDigits(bytes + 13, 2);
+            break;
+        case AWSFixedDateFormatShortBasic:
+            // yyyyMMdd
+            if (length != 8) {
+                return NO;
+            }
+            year = aws_readDigits(bytes, 4);
+            month = aws_readDigits(bytes + 4, 2);
+            day = aws_readDigits(bytes + 6, 2);
+            break;
+        case AWSFixedDateFormatShortExtended:
+            // yyyy-MM-dd
+            if (length != 10 || bytes[4] != '-' || bytes[7] != '-') {
+                return NO;
+            }
+            year = aws_readDigits(bytes, 4);
+            month = aws_readDigits(bytes + 5, 2);
+            day = aws_readDigits(bytes + 8, 2);
+            break;
+        case AWSFixedDateFormatRFC822: {
+            // EEE, dd MMM yyyy HH:mm:ss z, only for GMT/UTC. The day may have one or two digits.
+            size_t dayLength = (length == 29) ? 2 : 1;
+            if ((length != 29 && length != 28)
+                || aws_indexOfName(bytes, AWSFixedDateWeekdays, 7) < 0
+                || bytes[3] != ',' || bytes[4] != ' ') {
+                return NO;
+            }
+            const char *rest = bytes + 5 + dayLength;
+            if (rest[0] != ' ' || rest[4] != ' ' || rest[9] != ' ' || rest[12] != ':' || rest[15] != ':' || rest[18] != ' '
+                || (memcmp(rest + 19, "GMT", 3) != 0 && memcmp(rest + 19, "UTC", 3) != 0)) {
+                return NO;
+            }
+            day = aws_readDigits(bytes + 5, (int)dayLength);
+            int monthIndex = aws_indexOfName(rest + 1, AWSFixedDateMonths, 12);
+            month = monthIndex < 0 ? -1 : monthIndex + 1;
+            year = aws_readDigits(rest + 5, 4);
+            hour = aws_readDigits(rest + 10, 2);
+            minute = aws_readDigits(rest + 13, 2);
+            second = aws_readDigits(rest + 16, 2);
+            break;
+        }
+        default:
+            return NO;
+    }
+
+    if (year < AWSFixedDateMinYear || year > AWSFixedDateMaxYear
+        || month < 1 || month > 12
+        || day < 1 || day > aws_daysInMonth(year, month)
+        || hour < 0 || hour > 23
+        || minute < 0 || minute > 59
+        || second < 0 || second > 59
+        || millisecond < 0) {
+        return NO;
+    }
+
+    int64_t seconds = aws_daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    *millisecondsSince1970 = seconds * 1000 + millisecond;
+    return YES;
+}
+
+static size_t aws_formatFixedDate(int64_t millisecondsSince1970, AWSFixedDateFormat format, char *bytes) {
+    int64_t days = millisecondsSince1970 / 86400000;
+    int64_t millisecondOfDay = millisecondsSince1970 % 86400000;
+    if (millisecondOfDay < 0) {
+        millisecondOfDay += 86400000;
+        days -= 1;
+    }
+    int year, month, day;
+    aws_civilFromDays(days, &year, &month, &day);
+    if (year < AWSFixedDateMinYear || year > AWSFixedDateMaxYear) {
+        return 0;
+    }
+    int hour = (int)(millisecondOfDay / 3600000);
+    int minute = (int)(millisecondOfDay / 60000 % 60);
+    int second = (int)(millisecondOfDay / 1000 % 60);
+    int millisecond = (int)(millisecondOfDay % 1000);
+
+    switch (format) {
+        case AWSFixedDateFormatISO8601Extended:
+        case AWSFixedDateFormatISO8601ExtendedMilliseconds: {
+            aws_writeDigits(bytes, year, 4);
+            bytes[4] = '-';
+            aws_writeDigits(bytes + 5, month, 2);
+            bytes[7] = '-';
+            aws_writeDigits(bytes + 8, day, 2);
+            bytes[10] = 'T';
+            aws_writeDigits(bytes + 11, hour, 2);
+            bytes[13] = ':';
+            aws_writeDigits(bytes + 14, minute, 2);
+            bytes[16] = ':';
+            aws_writeDigits(bytes + 17, second, 2);
+            if (format == AWSFixedDateFormatISO8601Extended) {
+                bytes[19] = 'Z';
+                return 20;
+            }
+            bytes[19] = '.';
+            aws_writeDigits(bytes + 20, millisecond, 3);
+            bytes[23] = 'Z';
+            return 24;
+        }
+        case AWSFixedDateFormatISO8601Basic:
+            aws_writeDigits(bytes, year, 4);
+            aws_writeDigits(bytes + 4, month, 2);
+            aws_writeDigits(bytes + 6, day, 2);
+            bytes[8] = 'T';
+            aws_writeDigits(bytes + 9, hour, 2);
+            aws_writeDigits(bytes + 11, minute, 2);
+            aws_writeDigits(bytes + 13, second, 2);
+            bytes[15] = 'Z';
+            return 16;
+        case AWSFixedDateFormatShortBasic:
+            aws_writeDigits(bytes, year, 4);
+            aws_writeDigits(bytes + 4, month, 2);
+            aws_writeDigits(bytes + 6, day, 2);
+            return 8;
+        case AWSFixedDateFormatShortExtended:
+            aws_writeDigits(bytes, year, 4);
+            bytes[4] = '-';
+            aws_writeDigits(bytes + 5, month, 2);
+            bytes[7] = '-';
+            aws_writeDigits(bytes + 8, day, 2);
+            return 10;
+        case AWSFixedDateFormatRFC822: {
+            // 1970-01-01 was a Thursday.
+            int weekday = (int)(((days % 7) + 7 + 4) % 7);
+            memcpy(bytes, AWSFixedDateWeekdays[weekday], 3);
+            bytes[3] = ',';
+            bytes[4] = ' ';
+            aws_writeDigits(bytes + 5, day, 2);
+            bytes[7] = ' ';
+            memcpy(bytes + 8, AWSFixedDateMonths[month - 1], 3);
+            bytes[11] = ' ';
+            aws_writeDigits(bytes + 12, year, 4);
+            bytes[16] = ' ';
+            aws_writeDigits(bytes + 17, hour, 2);
+            bytes[19] = ':';
+            aws_writeDigits(bytes + 20, minute, 2);
+            bytes[22] = ':';
+            aws_writeDigits(bytes + 23, second, 2);
+            memcpy(bytes + 25, " GMT", 4);
+            return 29;
+        }
+        default:
+            return 0;
+    }
+}
+
+// Same conversion as `CFDateFormatter` uses between `NSDate` and ICU's millisecond based `UDate`.
+static int64_t aws_millisecondsSince1970FromDate(NSDate *date) {
+    return (int64_t)floor(([date timeIntervalSinceReferenceDate] + NSTimeIntervalSince1970) * 1000.0);
+}
+
+static NSDate *aws_dateFromMillisecondsSince1970(int64_t milliseconds) {
+    return [NSDate dateWithTimeIntervalSinceReferenceDate:(double)milliseconds / 1000.0 - NSTimeIntervalSince1970];
+}
+
+static BOOL aws_getASCIIBytes(NSString *string, char *bytes, size_t *length) {
+    NSUInteger stringLength = [string length];
+    if (stringLength == 0 || stringLength >= AWSFixedDateMaxLength) {
+        return NO;
+    }
+    if (![string getCString:bytes maxLength:AWSFixedDateMaxLength encoding:NSASCIIStringEncoding]) {
+        return NO;
+    }
+    *length = stringLength;
+    return YES;
+}
+
+static BOOL aws_containsLetter(const char *bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if ((bytes[i] >= 'A' && bytes[i] <= 'Z') || (bytes[i] >= 'a' && bytes[i] <= 'z')) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
 @implementation NSDate (AWS)
 
 static NSTimeInterval _clockskew = 0.0;
@@ -55,6 +373,26 @@ static NSTimeInterval _clockskew = 0.0;
 }
 
 + (NSDate *)aws_dateFromString:(NSString *)string {
+    char bytes[AWSFixedDateMaxLength];
+    size_t length = 0;
+    if (aws_getASCIIBytes(string, bytes, &length)) {
+        // The supported formats have distinct layouts, so at most one of them can match.
+        static const AWSFixedDateFormat formats[] = {AWSFixedDateFormatRFC822,
+                                                     AWSFixedDateFormatISO8601Extended,
+                                                     AWSFixedDateFormatISO8601Basic,
+                                                     AWSFixedDateFormatISO8601ExtendedMilliseconds};
+        for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+            int64_t milliseconds = 0;
+            if (aws_parseFixedDate(bytes, length, formats[i], &milliseconds)) {
+                return aws_dateFromMillisecondsSince1970(milliseconds);
+            }
+        }
+        // Every format contains letters, e.g. epoch seconds cannot match any of them.
+        if (!aws_containsLetter(bytes, length)) {
+            return nil;
+        }
+    }
+
     NSDate *parsedDate = nil;
     NSArray *arrayOfDateFormat = @[AWSDateRFC822DateFormat1,
                                    AWSDateISO8601DateFormat1,
@@ -63,7 +401,7 @@ static NSTimeInterval _clockskew = 0.0;
 
     for (NSString *dateFormat in arrayOfDateFormat) {
         if (!parsedDate) {
-            parsedDate = [NSDate aws_dateFromString:string format:dateFormat];
+            parsedDate = [NSDate aws_formatterDateFromString:string format:dateFormat];
         } else {
             break;
         }
@@ -73,6 +411,32 @@ static NSTimeInterval _clockskew = 0.0;
 }
 
 + (NSDate *)aws_dateFromString:(NSString *)string format:(NSString *)dateFormat {
+    AWSFixedDateFormat fixedDateFormat = aws_fixedDateFormat(dateFormat);
+    if (fixedDateFormat != AWSFixedDateFormatUnknown) {
+        char bytes[AWSFixedDateMaxLength];
+        size_t length = 0;
+        int64_t milliseconds = 0;
+        if (aws_getASCIIBytes(string, bytes, &length)
+            && aws_parseFixedDate(bytes, length, fixedDateFormat, &milliseconds)) {
+            return aws_dateFromMillisecondsSince1970(milliseconds);
+        }
+    }
+    return [NSDate aws_formatterDateFromString:string format:dateFormat];
+}
+
+- (NSString *)aws_stringValue:(NSString *)dateFormat {
+    AWSFixedDateFormat fixedDateFormat = aws_fixedDateFormat(dateFormat);
+    if (fixedDateFormat != AWSFixedDateFormatUnknown) {
+        char bytes[AWSFixedDateMaxLength];
+        size_t length = aws_formatFixedDate(aws_millisecondsSince1970FromDate(self), fixedDateFormat, bytes);
+        if (length > 0) {
+            return [[NSString alloc] initWithBytes:bytes length:length encoding:NSASCIIStringEncoding];
+        }
+    }
+    return [self aws_formatterStringValue:dateFormat];
+}
+
++ (NSDate *)aws_formatterDateFromString:(NSString *)string format:(NSString *)dateFormat {
     if ([dateFormat isEqualToString:AWSDateRFC822DateFormat1]) {
         return [[NSDate aws_RFC822Date1Formatter] dateFromString:string];
     }
@@ -92,15 +456,10 @@ static NSTimeInterval _clockskew = 0.0;
         return [[NSDate aws_ShortDateFormat2Formatter] dateFromString:string];
     }
 
-    NSDateFormatter *dateFormatter = [NSDateFormatter new];
-    dateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"GMT"];
-    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
-    dateFormatter.dateFormat = dateFormat;
-
-    return [dateFormatter dateFromString:string];
+    return [[NSDate aws_dateFormatterWithFormat:dateFormat] dateFromString:string];
 }
 
-- (NSString *)aws_stringValue:(NSString *)dateFormat {
+- (NSString *)aws_formatterStringValue:(NSString *)dateFormat {
     if ([dateFormat isEqualToString:AWSDateRFC822DateFormat1]) {
         return [[NSDate aws_RFC822Date1Formatter] stringFromDate:self];
     }
@@ -120,12 +479,27 @@ static NSTimeInterval _clockskew = 0.0;
         return [[NSDate aws_ShortDateFormat2Formatter] stringFromDate:self];
     }
 
-    NSDateFormatter *dateFormatter = [NSDateFormatter new];
-    dateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"GMT"];
-    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
-    dateFormatter.dateFormat = dateFormat;
+    return [[NSDate aws_dateFormatterWithFormat:dateFormat] stringFromDate:self];
+}
 
-    return [dateFormatter stringFromDate:self];
+// Formatters for custom formats are kept per thread, `NSDateFormatter` is expensive to create.
++ (NSDateFormatter *)aws_dateFormatterWithFormat:(NSString *)dateFormat {
+    static NSString *const AWSDateFormattersThreadKey = @"com.amazonaws.AWSDateFormatters";
+    NSMutableDictionary<NSString *, NSDateFormatter *> *dateFormatters = [NSThread currentThread].threadDictionary[AWSDateFormattersThreadKey];
+    if (!dateFormatters) {
+        dateFormatters = [NSMutableDictionary new];
+        [NSThread currentThread].threadDictionary[AWSDateFormattersThreadKey] = dateFormatters;
+    }
+
+    NSDateFormatter *dateFormatter = dateFormatters[dateFormat];
+    if (!dateFormatter) {
+        dateFormatter = [NSDateFormatter new];
+        dateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"GMT"];
+        dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        dateFormatter.dateFormat = dateFormat;
+        dateFormatters[[dateFormat copy]] = dateFormatter;
+    }
+    return dateFormatter;
 }
 
 + (NSDateFormatter *)aws_RFC822Date1Formatter {
@@ -346,7 +720,7 @@ static NSTimeInterval _clockskew = 0.0;
              * Ref. https://developer.apple.com/library/ios/documentation/Cocoa/Conceptual/ObjCRuntimeGuide/Articles/ocrtPropertyIntrospection.html#//apple_ref/doc/uid/TP40008048-CH101-SW1
              */
             if ([attributes rangeOfString:@",R,"].location == NSNotFound) {
-                if (![key isEqualToString:@"uploadProgress"] && ![key isEqualToString:@"downloadProgress"]) {
+                if (![key isEqualToString:@"uploadProgress"] && ![key isEqualToString:@"downloadProgress"] && ![key isEqualToString:@"responseDataHandler"]) {
                     //do not copy progress block since they do not have getter method and they have already been copied via internalRequest. copy it again will result in overwrite the current value to nil.
                     [self setValue:[object valueForKey:key]
                             forKey:key];
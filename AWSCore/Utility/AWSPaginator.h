@@ -0,0 +1,129 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSNetworking.h"
+#import "AWSTask.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The default value of `lookahead`, 1 page.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSPaginatorLookaheadDefault;
+
+/**
+ Fetches one page.
+
+ @param token The pagination token returned with the previous page, or `nil` for the first page.
+
+ @return A task whose result is the output of the page.
+ */
+typedef AWSTask * _Nonnull (^AWSPaginatorPageBlock)(id _Nullable token);
+
+/**
+ Walks the pages of a paginated operation, fetching the next page while the caller processes the current one.
+
+ Pages are fetched one after another, each with the token returned by the previous one. Up to `lookahead` pages are
+ fetched ahead of the caller and held until they are consumed, so the number of buffered pages is bounded whatever the
+ length of the result. The walk ends after a page without a token, or with the first error.
+
+     AWSPaginator<AWSS3Object *> *paginator = [[AWSS3 defaultS3] listObjectsV2Paginator:listObjectsV2Request];
+     [[paginator enumerateItemsUsingBlock:^(AWSS3Object *object, BOOL *stop) {
+         ...
+     }] continueWithBlock:^id(AWSTask *task) {
+         ...
+     }];
+ */
+@interface AWSPaginator<__covariant ObjectType> : NSObject
+
+/**
+ The number of pages fetched ahead of the caller. `0` fetches a page only when it is asked for.
+ The default value is `AWSPaginatorLookaheadDefault`.
+ */
+@property (atomic, assign) NSUInteger lookahead;
+
+/**
+ The number of pages received so far.
+ */
+@property (atomic, assign, readonly) NSUInteger pageCount;
+
+/**
+ The error that ended the walk, or `nil`.
+ */
+@property (atomic, strong, readonly, nullable) NSError *error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a paginator.
+
+ @param outputTokenKey The key of the token for the next page in the page output.
+ @param resultKey      The key of the items in the page output.
+ @param pageBlock      Fetches one page.
+
+ @return A paginator.
+ */
+- (instancetype)initWithOutputTokenKey:(NSString *)outputTokenKey
+                             resultKey:(NSString *)resultKey
+                             pageBlock:(AWSPaginatorPageBlock)pageBlock NS_DESIGNATED_INITIALIZER;
+
+/**
+ Creates a paginator for a service operation. Every page is fetched with a copy of `request` in which `inputTokenKey`
+ is set to the token returned with the previous page; the first page uses `request` as it is.
+
+ @param request        The request of the first page.
+ @param inputTokenKey  The key of the pagination token in the request.
+ @param outputTokenKey The key of the token for the next page in the page output.
+ @param resultKey      The key of the items in the page output.
+ @param operation      Calls the operation with the request of a page.
+
+ @return A paginator.
+ */
++ (instancetype)paginatorWithRequest:(AWSRequest *)request
+                       inputTokenKey:(NSString *)inputTokenKey
+                      outputTokenKey:(NSString *)outputTokenKey
+                           resultKey:(NSString *)resultKey
+                           operation:(AWSTask * (^)(id request))operation;
+
+/**
+ Returns the items of the next page.
+
+ @return An instance of `AWSTask`. On successful execution, `task.result` will contain the items of the next page, or
+ `nil` once all of the pages have been returned.
+ */
+- (AWSTask<NSArray<ObjectType> *> *)nextPage;
+
+/**
+ Calls `block` for every remaining item, in order. The next page is fetched while `block` processes the current one.
+
+ @param block Called with every item. Set `stop` to `YES` to end the enumeration.
+
+ @return An instance of `AWSTask` that completes after the last item. `task.result` will be `nil`.
+ */
+- (AWSTask *)enumerateItemsUsingBlock:(void (^)(ObjectType item, BOOL *stop))block;
+
+/**
+ Returns an enumerator over the remaining items that fetches pages as they are needed. `nextObject` blocks while the
+ next page is being fetched, so it must not be used on the main thread. It returns `nil` at the end of the walk and
+ after an error; check `error` to tell them apart.
+
+ @return An enumerator over the remaining items.
+ */
+- (NSEnumerator<ObjectType> *)itemEnumerator;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,238 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSPaginator.h"
+#import "AWSTaskCompletionSource.h"
+
+NSUInteger const AWSPaginatorLookaheadDefault = 1;
+
+@interface AWSPaginatorItemEnumerator : NSEnumerator
+
+@property (nonatomic, strong) AWSPaginator *paginator;
+@property (nonatomic, strong) NSArray *items;
+@property (nonatomic, assign) NSUInteger index;
+
+@end
+
+@implementation AWSPaginatorItemEnumerator
+
+- (id)nextObject {
+    while (self.index >= [self.items count]) {
+        if (!self.paginator) {
+            return nil;
+        }
+        AWSTask<NSArray *> *task = [self.paginator nextPage];
+        [task waitUntilFinished];
+        if (!task.result) {
+            self.paginator = nil;
+            self.items = nil;
+            return nil;
+        }
+        self.items = task.result;
+        self.index = 0;
+    }
+    return self.items[self.index++];
+}
+
+@end
+
+@interface AWSPaginator()
+
+@property (nonatomic, strong) NSString *outputTokenKey;
+@property (nonatomic, strong) NSString *resultKey;
+@property (nonatomic, copy) AWSPaginatorPageBlock pageBlock;
+
+@property (atomic, assign, readwrite) NSUInteger pageCount;
+@property (atomic, strong, readwrite) NSError *error;
+
+// The state below is guarded by @synchronized(self).
+@property (nonatomic, strong) id nextToken;
+@property (nonatomic, assign, getter=isFetching) BOOL fetching;
+// YES once a page came back without a token or with an error.
+@property (nonatomic, assign, getter=isFinished) BOOL finished;
+// Pages received ahead of the caller, at most `lookahead`.
+@property (nonatomic, strong) NSMutableArray<AWSTask *> *receivedPages;
+// Callers waiting for a page that has not been received yet.
+@property (nonatomic, strong) NSMutableArray<AWSTaskCompletionSource *> *waitingCallers;
+
+@end
+
+@implementation AWSPaginator
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithOutputTokenKey:resultKey:pageBlock:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithOutputTokenKey:(NSString *)outputTokenKey
+                             resultKey:(NSString *)resultKey
+                             pageBlock:(AWSPaginatorPageBlock)pageBlock {
+    if (self = [super init]) {
+        _outputTokenKey = outputTokenKey;
+        _resultKey = resultKey;
+        _pageBlock = pageBlock;
+        _lookahead = AWSPaginatorLookaheadDefault;
+        _receivedPages = [NSMutableArray new];
+        _waitingCallers = [NSMutableArray new];
+    }
+    return self;
+}
+
++ (instancetype)paginatorWithRequest:(AWSRequest *)request
+                       inputTokenKey:(NSString *)inputTokenKey
+                      outputTokenKey:(NSString *)outputTokenKey
+                           resultKey:(NSString *)resultKey
+                           operation:(AWSTask * (^)(id request))operation {
+    return [[self alloc] initWithOutputTokenKey:outputTokenKey
+                                      resultKey:resultKey
+                                      pageBlock:^AWSTask *(id token) {
+        // Every page gets its own copy of the request, leaving the caller's untouched. The copy also gets its own
+        // networking request, so pages in flight together do not overwrite each other's parameters.
+        AWSRequest *pageRequest = [request copy];
+        if (token) {
+            [pageRequest setValue:token forKey:inputTokenKey];
+        }
+        return operation(pageRequest);
+    }];
+}
+
+- (AWSTask<NSArray *> *)nextPage {
+    AWSTask *page = nil;
+    @synchronized(self) {
+        if ([self.receivedPages count] > 0) {
+            page = [self.receivedPages firstObject];
+            [self.receivedPages removeObjectAtIndex:0];
+        } else if (self.isFinished) {
+            page = [AWSTask taskWithResult:nil];
+        } else {
+            AWSTaskCompletionSource *waitingCaller = [AWSTaskCompletionSource taskCompletionSource];
+            [self.waitingCallers addObject:waitingCaller];
+            page = waitingCaller.task;
+        }
+    }
+    [self fetchPageIfNeeded];
+    return page;
+}
+
+- (AWSTask *)enumerateItemsUsingBlock:(void (^)(id item, BOOL *stop))block {
+    return [[self nextPage] continueWithSuccessBlock:^id(AWSTask<NSArray *> *task) {
+        NSArray *items = task.result;
+        if (!items) {
+            return nil;
+        }
+        BOOL stop = NO;
+        for (id item in items) {
+            block(item, &stop);
+            if (stop) {
+                return nil;
+            }
+        }
+        return [self enumerateItemsUsingBlock:block];
+    }];
+}
+
+- (NSEnumerator *)itemEnumerator {
+    AWSPaginatorItemEnumerator *enumerator = [AWSPaginatorItemEnumerator new];
+    enumerator.paginator = self;
+    return enumerator;
+}
+
+#pragma mark - Fetching
+
+- (void)fetchPageIfNeeded {
+    id token = nil;
+    @synchronized(self) {
+        if (self.isFetching || self.isFinished) {
+            return;
+        }
+        if ([self.waitingCallers count] == 0 && [self.receivedPages count] >= self.lookahead) {
+            return;
+        }
+        self.fetching = YES;
+        token = self.nextToken;
+    }
+
+    [self.pageBlock(token) continueWithBlock:^id(AWSTask *task) {
+        [self didReceivePage:task];
+        return nil;
+    }];
+}
+
+- (void)didReceivePage:(AWSTask *)task {
+    AWSTask *page = nil;
+    id token = nil;
+    if (task.error) {
+        page = [AWSTask taskWithError:task.error];
+    } else {
+        NSArray *items = [task.result valueForKey:self.resultKey];
+        token = [task.result valueForKey:self.outputTokenKey];
+        page = [AWSTask taskWithResult:[items isKindOfClass:[NSArray class]] ? items : @[]];
+    }
+
+    AWSTaskCompletionSource *waitingCaller = nil;
+    NSArray<AWSTaskCompletionSource *> *callersPastTheEnd = nil;
+    @synchronized(self) {
+        self.fetching = NO;
+        if (task.error) {
+            self.error = task.error;
+            self.finished = YES;
+        } else {
+            self.pageCount++;
+            if ([self isEmptyToken:token]) {
+                self.finished = YES;
+            } else {
+                self.nextToken = token;
+            }
+        }
+
+        if ([self.waitingCallers count] > 0) {
+            waitingCaller = [self.waitingCallers firstObject];
+            [self.waitingCallers removeObjectAtIndex:0];
+        } else {
+            [self.receivedPages addObject:page];
+        }
+        if (self.isFinished) {
+            callersPastTheEnd = [self.waitingCallers copy];
+            [self.waitingCallers removeAllObjects];
+        }
+    }
+
+    if (page.error) {
+        [waitingCaller setError:page.error];
+    } else {
+        [waitingCaller setResult:page.result];
+    }
+    for (AWSTaskCompletionSource *caller in callersPastTheEnd) {
+        [caller setResult:nil];
+    }
+    [self fetchPageIfNeeded];
+}
+
+- (BOOL)isEmptyToken:(id)token {
+    if (!token || token == [NSNull null]) {
+        return YES;
+    }
+    if ([token isKindOfClass:[NSString class]]) {
+        return [token length] == 0;
+    }
+    if ([token respondsToSelector:@selector(count)]) {
+        return [token count] == 0;
+    }
+    return NO;
+}
+
+@end
@@ -0,0 +1,103 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Writes an XML document as UTF-8 directly into a growable byte buffer.
+
+ It writes the same bytes as `AWSXMLWriter` with its default settings for the subset of calls the REST-XML request
+ serializer makes, without building an `NSMutableString` first: names are copied from the string's own storage when it
+ is ASCII, and text is escaped and encoded in a single pass. Unlike `AWSXMLWriter`, characters outside the Basic
+ Multilingual Plane are kept, and only unpaired surrogates are dropped.
+
+ A writer is not thread-safe.
+ */
+@interface AWSXMLDataWriter : NSObject
+
+/**
+ The string written once per level before a start element, or `nil` for none. The default is a tab.
+ */
+@property (nonatomic, copy, nullable) NSString *indentation;
+
+/**
+ The string written before a start element, or `nil` for none. The default is a newline.
+ */
+@property (nonatomic, copy, nullable) NSString *lineBreak;
+
+/**
+ The number of elements started and not yet ended.
+ */
+@property (nonatomic, assign, readonly) NSUInteger level;
+
+/**
+ The number of bytes written.
+ */
+@property (nonatomic, assign, readonly) NSUInteger length;
+
+/**
+ Creates a writer with a 4KB buffer.
+ */
+- (instancetype)init;
+
+/**
+ Creates a writer.
+
+ @param capacity The initial size of the buffer, in bytes. The buffer doubles whenever it is full.
+
+ @return A writer.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+/**
+ Writes a start element, closing the previous start element if it is still open.
+ */
+- (void)writeStartElement:(NSString *)localName;
+
+/**
+ Writes an attribute of the open start element. Throws an `XMLWriterException` if there is no open start element.
+ */
+- (void)writeAttribute:(NSString *)localName value:(NSString *)value;
+
+/**
+ Writes escaped character data. Characters that are not allowed in XML are dropped.
+ */
+- (void)writeCharacters:(nullable NSString *)text;
+
+/**
+ Writes the decimal representation of an integer as character data, without creating a string for it.
+ */
+- (void)writeInteger:(long long)value;
+
+/**
+ Writes an end element. Throws an `XMLWriterException` if there are more end elements than start elements.
+ */
+- (void)writeEndElement:(NSString *)localName;
+
+/**
+ Returns a copy of the bytes written.
+ */
+- (NSData *)toData;
+
+/**
+ Returns the document written as a string.
+ */
+- (NSString *)toString;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,356 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSXMLDataWriter.h"
+
+static NSUInteger const AWSXMLDataWriterDefaultCapacity = 4 * 1024;
+
+// The number of UTF-16 units escaped at a time. Each one is written as at most 6 bytes, `&quot;`.
+static NSUInteger const AWSXMLDataWriterEscapeWindow = 1024;
+static NSUInteger const AWSXMLDataWriterMaximumEscapedLength = 6;
+
+typedef struct {
+    uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger capacity;
+} AWSXMLByteBuffer;
+
+// 0 for ASCII characters that are written as they are, 1 for those that are escaped or dropped.
+static const uint8_t aws_xmlSpecialCharacters[128] = {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 1, 1, 0, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static void aws_xmlBufferReserve(AWSXMLByteBuffer *buffer, NSUInteger additional) {
+    if (buffer->capacity - buffer->length >= additional) {
+        return;
+    }
+    NSUInteger capacity = MAX(buffer->capacity * 2, buffer->length + additional);
+    uint8_t *bytes = realloc(buffer->bytes, capacity);
+    if (!bytes) {
+        @throw([NSException exceptionWithName:@"XMLWriterException"
+                                       reason:[NSString stringWithFormat:@"Could not allocate a buffer of %lu bytes", (unsigned long)capacity]
+                                     userInfo:nil]);
+    }
+    buffer->bytes = bytes;
+    buffer->capacity = capacity;
+}
+
+static void aws_xmlBufferAppend(AWSXMLByteBuffer *buffer, const void *bytes, NSUInteger length) {
+    aws_xmlBufferReserve(buffer, length);
+    memcpy(buffer->bytes + buffer->length, bytes, length);
+    buffer->length += length;
+}
+
+// Writes the escape sequence of a special ASCII character, or nothing if it is not allowed in XML, without reserving space.
+static void aws_xmlWriteSpecialCharacter(AWSXMLByteBuffer *buffer, uint8_t c) {
+    const char *escaped;
+    NSUInteger length;
+    switch (c) {
+        case '"':
+            escaped = "&quot;";
+            length = 6;
+            break;
+        case '&':
+            escaped = "&amp;";
+            length = 5;
+            break;
+        case '<':
+            escaped = "&lt;";
+            length = 4;
+            break;
+        case '>':
+            escaped = "&gt;";
+            length = 4;
+            break;
+        default:
+            return;
+    }
+    memcpy(buffer->bytes + buffer->length, escaped, length);
+    buffer->length += length;
+}
+
+// Escapes ASCII text, copying runs of characters that need no escaping at once. Returns NO, with nothing written, if the text is not ASCII.
+static BOOL aws_xmlAppendEscapedASCII(AWSXMLByteBuffer *buffer, const uint8_t *characters, NSUInteger length) {
+    NSUInteger start = buffer->length;
+    NSUInteger runStart = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        uint8_t c = characters[i];
+        if (c >= 0x80) {
+            buffer->length = start;
+            return NO;
+        }
+        if (!aws_xmlSpecialCharacters[c]) {
+            continue;
+        }
+        aws_xmlBufferReserve(buffer, i - runStart + AWSXMLDataWriterMaximumEscapedLength);
+        memcpy(buffer->bytes + buffer->length, characters + runStart, i - runStart);
+        buffer->length += i - runStart;
+        aws_xmlWriteSpecialCharacter(buffer, c);
+        runStart = i + 1;
+    }
+    aws_xmlBufferAppend(buffer, characters + runStart, length - runStart);
+    return YES;
+}
+
+// Escapes and encodes UTF-16 text to UTF-8. A high surrogate at the end of the characters is left unconsumed unless `last`
+// is YES, so that a pair split across two calls is kept. Returns the number of characters consumed.
+static NSUInteger aws_xmlAppendEscapedCharacters(AWSXMLByteBuffer *buffer, const UniChar *characters, NSUInteger length, BOOL last) {
+    aws_xmlBufferReserve(buffer, length * AWSXMLDataWriterMaximumEscapedLength);
+    uint8_t *output = buffer->bytes + buffer->length;
+    NSUInteger i = 0;
+    for (; i < length; i++) {
+        UniChar c = characters[i];
+        if (c < 0x80) {
+            if (aws_xmlSpecialCharacters[c]) {
+                buffer->length = output - buffer->bytes;
+                aws_xmlWriteSpecialCharacter(buffer, (uint8_t)c);
+                output = buffer->bytes + buffer->length;
+            } else {
+                *output++ = (uint8_t)c;
+            }
+        } else if (c < 0x800) {
+            *output++ = (uint8_t)(0xC0 | (c >> 6));
+            *output++ = (uint8_t)(0x80 | (c & 0x3F));
+        } else if (c >= 0xD800 && c <= 0xDBFF) {
+            if (i + 1 == length) {
+                if (!last) {
+                    break;
+                }
+                // An unpaired high surrogate is dropped.
+            } else if (characters[i + 1] >= 0xDC00 && characters[i + 1] <= 0xDFFF) {
+                uint32_t codePoint = 0x10000 + (((uint32_t)c - 0xD800) << 10) + (characters[i + 1] - 0xDC00);
+                *output++ = (uint8_t)(0xF0 | (codePoint >> 18));
+                *output++ = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3F));
+                *output++ = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+                *output++ = (uint8_t)(0x80 | (codePoint & 0x3F));
+                i++;
+            }
+        } else if ((c >= 0xDC00 && c <= 0xDFFF) || c >= 0xFFFE) {
+            // An unpaired low surrogate, U+FFFE and U+FFFF are not allowed in XML, and are dropped.
+        } else {
+            *output++ = (uint8_t)(0xE0 | (c >> 12));
+            *output++ = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+            *output++ = (uint8_t)(0x80 | (c & 0x3F));
+        }
+    }
+    buffer->length = output - buffer->bytes;
+    return i;
+}
+
+@interface AWSXMLDataWriter() {
+    AWSXMLByteBuffer _buffer;
+    BOOL _openElement;
+    BOOL _emptyElement;
+}
+
+@property (nonatomic, assign) NSUInteger level;
+@property (nonatomic, strong) NSData *indentationData;
+@property (nonatomic, strong) NSData *lineBreakData;
+
+@end
+
+@implementation AWSXMLDataWriter
+
+- (instancetype)init {
+    return [self initWithCapacity:AWSXMLDataWriterDefaultCapacity];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    if (self = [super init]) {
+        _buffer.capacity = MAX(capacity, AWSXMLDataWriterMaximumEscapedLength);
+        _buffer.bytes = malloc(_buffer.capacity);
+        if (!_buffer.bytes) {
+            return nil;
+        }
+        self.indentation = @"\t";
+        self.lineBreak = @"\n";
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_buffer.bytes);
+}
+
+- (void)setIndentation:(NSString *)indentation {
+    _indentation = [indentation copy];
+    _indentationData = [_indentation dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (void)setLineBreak:(NSString *)lineBreak {
+    _lineBreak = [lineBreak copy];
+    _lineBreakData = [_lineBreak dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (NSUInteger)length {
+    return _buffer.length;
+}
+
+#pragma mark - Writing
+
+- (void)writeStartElement:(NSString *)localName {
+    [self closeOpenElement];
+
+    [self writeLinebreakAndIndentation];
+    aws_xmlBufferAppend(&_buffer, "<", 1);
+    [self writeName:localName];
+
+    _openElement = YES;
+    _emptyElement = YES;
+    self.level += 1;
+}
+
+- (void)writeAttribute:(NSString *)localName value:(NSString *)value {
+    if (!_openElement) {
+        @throw([NSException exceptionWithName:@"XMLWriterException" reason:@"No open start element" userInfo:nil]);
+    }
+
+    aws_xmlBufferAppend(&_buffer, " ", 1);
+    [self writeName:localName];
+    aws_xmlBufferAppend(&_buffer, "=\"", 2);
+    [self writeEscaped:value];
+    aws_xmlBufferAppend(&_buffer, "\"", 1);
+}
+
+- (void)writeCharacters:(NSString *)text {
+    [self closeOpenElement];
+
+    [self writeEscaped:text];
+
+    _emptyElement = NO;
+}
+
+- (void)writeInteger:(long long)value {
+    [self closeOpenElement];
+
+    // Enough for the 19 digits and the sign of LLONG_MIN.
+    char digits[20];
+    NSUInteger index = sizeof(digits);
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        digits[--index] = '0' + (char)(magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        digits[--index] = '-';
+    }
+    aws_xmlBufferAppend(&_buffer, digits + index, sizeof(digits) - index);
+
+    _emptyElement = NO;
+}
+
+- (void)writeEndElement:(NSString *)localName {
+    if (self.level == 0) {
+        @throw([NSException exceptionWithName:@"XMLWriterException" reason:@"Cannot write more end elements than start elements." userInfo:nil]);
+    }
+
+    self.level -= 1;
+
+    if (_openElement) {
+        // <START><END>
+        [self closeOpenElement];
+    } else if (_emptyElement) {
+        // <START>, child elements, then a linebreak and indentation before <END>
+        [self writeLinebreakAndIndentation];
+    }
+
+    aws_xmlBufferAppend(&_buffer, "</", 2);
+    [self writeName:localName];
+    aws_xmlBufferAppend(&_buffer, ">", 1);
+
+    _emptyElement = YES;
+    _openElement = NO;
+}
+
+- (NSData *)toData {
+    return [NSData dataWithBytes:_buffer.bytes length:_buffer.length];
+}
+
+- (NSString *)toString {
+    return [[NSString alloc] initWithBytes:_buffer.bytes length:_buffer.length encoding:NSUTF8StringEncoding];
+}
+
+#pragma mark - Internal
+
+- (void)closeOpenElement {
+    if (_openElement) {
+        aws_xmlBufferAppend(&_buffer, ">", 1);
+        _openElement = NO;
+    }
+}
+
+- (void)writeLinebreakAndIndentation {
+    NSData *lineBreakData = self.lineBreakData;
+    if (lineBreakData) {
+        aws_xmlBufferAppend(&_buffer, [lineBreakData bytes], [lineBreakData length]);
+    }
+    NSData *indentationData = self.indentationData;
+    if (indentationData) {
+        for (NSUInteger i = 0; i < self.level; i++) {
+            aws_xmlBufferAppend(&_buffer, [indentationData bytes], [indentationData length]);
+        }
+    }
+}
+
+// Names are written as they are. Most are ASCII, and copied straight from the string's storage.
+- (void)writeName:(NSString *)name {
+    CFStringRef string = (__bridge CFStringRef)name;
+    CFIndex length = CFStringGetLength(string);
+    const char *characters = CFStringGetCStringPtr(string, kCFStringEncodingASCII);
+    if (characters) {
+        aws_xmlBufferAppend(&_buffer, characters, length);
+        return;
+    }
+
+    CFIndex maximumLength = CFStringGetMaximumSizeForEncoding(length, kCFStringEncodingUTF8);
+    aws_xmlBufferReserve(&_buffer, maximumLength);
+    CFIndex usedLength = 0;
+    CFStringGetBytes(string, CFRangeMake(0, length), kCFStringEncodingUTF8, 0, false, _buffer.bytes + _buffer.length, maximumLength, &usedLength);
+    _buffer.length += usedLength;
+}
+
+- (void)writeEscaped:(NSString *)text {
+    if ([text length] == 0) {
+        return;
+    }
+
+    CFStringRef string = (__bridge CFStringRef)text;
+    NSUInteger length = CFStringGetLength(string);
+    const char *asciiCharacters = CFStringGetCStringPtr(string, kCFStringEncodingASCII);
+    if (asciiCharacters && aws_xmlAppendEscapedASCII(&_buffer, (const uint8_t *)asciiCharacters, length)) {
+        return;
+    }
+
+    const UniChar *characters = CFStringGetCharactersPtr(string);
+    UniChar window[AWSXMLDataWriterEscapeWindow];
+    NSUInteger location = 0;
+    while (location < length) {
+        NSUInteger windowLength = MIN(length - location, AWSXMLDataWriterEscapeWindow);
+        const UniChar *windowCharacters = characters ? characters + location : window;
+        if (!characters) {
+            CFStringGetCharacters(string, CFRangeMake(location, windowLength), window);
+        }
+        location += aws_xmlAppendEscapedCharacters(&_buffer, windowCharacters, windowLength, location + windowLength == length);
+    }
+}
+
+@end
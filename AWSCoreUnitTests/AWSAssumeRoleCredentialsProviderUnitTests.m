@@ -0,0 +1,323 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+
+static NSString *const AWSAssumeRoleCredentialsProviderUnitTestsRoleArn = @"arn:aws:iam::123456789012:role/TestRole";
+
+@interface AWSSTS()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSAssumeRoleCredentialsProvider()
+
+- (id)cacheEntry;
+
+@end
+
+// Assumes roles after a fixed latency, with a new access key every time.
+@interface AWSAssumeRoleCredentialsProviderTestSTS : AWSSTS
+
+@property (nonatomic, assign) NSTimeInterval requestLatency;
+@property (nonatomic, assign) NSTimeInterval credentialsLifetime;
+@property (atomic, assign) BOOL failsRequests;
+@property (atomic, assign) NSUInteger requestCount;
+@property (atomic, strong) AWSSTSAssumeRoleRequest *lastRequest;
+
+@end
+
+@implementation AWSAssumeRoleCredentialsProviderTestSTS
+
+- (AWSTask<AWSSTSAssumeRoleResponse *> *)assumeRole:(AWSSTSAssumeRoleRequest *)request {
+    NSUInteger requestCount = 0;
+    @synchronized(self) {
+        requestCount = ++self.requestCount;
+    }
+    self.lastRequest = request;
+
+    AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource taskCompletionSource];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.requestLatency * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        if (self.failsRequests) {
+            [completionSource setError:[NSError errorWithDomain:AWSSTSErrorDomain
+                                                           code:AWSSTSErrorUnknown
+                                                       userInfo:nil]];
+            return;
+        }
+        AWSSTSCredentials *credentials = [AWSSTSCredentials new];
+        credentials.accessKeyId = [NSString stringWithFormat:@"accessKey%lu", (unsigned long)requestCount];
+        credentials.secretAccessKey = @"secretKey";
+        credentials.sessionToken = @"sessionToken";
+        credentials.expiration = [NSDate dateWithTimeIntervalSinceNow:self.credentialsLifetime];
+        AWSSTSAssumeRoleResponse *response = [AWSSTSAssumeRoleResponse new];
+        response.credentials = credentials;
+        [completionSource setResult:response];
+    });
+    return completionSource.task;
+}
+
+@end
+
+@interface AWSAssumeRoleCredentialsProviderUnitTests : XCTestCase
+
+@property (nonatomic, strong) AWSAssumeRoleCredentialsProviderTestSTS *sts;
+
+@end
+
+@implementation AWSAssumeRoleCredentialsProviderUnitTests
+
+- (void)setUp {
+    [super setUp];
+    // A new source credentials provider per test, so that the tests do not share cached credentials.
+    AWSStaticCredentialsProvider *sourceCredentialsProvider = [[AWSStaticCredentialsProvider alloc] initWithAccessKey:@"sourceAccessKey"
+                                                                                                            secretKey:@"sourceSecretKey"];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:sourceCredentialsProvider];
+    self.sts = [[AWSAssumeRoleCredentialsProviderTestSTS alloc] initWithConfiguration:configuration];
+    self.sts.requestLatency = 0.05;
+    self.sts.credentialsLifetime = 60 * 60;
+}
+
+- (AWSAssumeRoleCredentialsProvider *)credentialsProviderWithPolicy:(NSString *)policy {
+    return [[AWSAssumeRoleCredentialsProvider alloc] initWithSTS:self.sts
+                                                         roleArn:AWSAssumeRoleCredentialsProviderUnitTestsRoleArn
+                                                 roleSessionName:@"session"
+                                                          policy:policy];
+}
+
+- (NSArray<AWSTask<AWSCredentials *> *> *)requestCredentialsConcurrently:(NSUInteger)count
+                                                             fromProvider:(AWSAssumeRoleCredentialsProvider *)provider {
+    NSMutableArray<AWSTask<AWSCredentials *> *> *tasks = [NSMutableArray new];
+    dispatch_apply(count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        AWSTask<AWSCredentials *> *task = [provider credentials];
+        @synchronized(tasks) {
+            [tasks addObject:task];
+        }
+    });
+    return tasks;
+}
+
+- (void)makeRefreshAheadDueForProvider:(AWSAssumeRoleCredentialsProvider *)provider {
+    [[provider cacheEntry] setValue:@0 forKey:@"refreshAheadTime"];
+}
+
+- (void)waitForRequestCount:(NSUInteger)requestCount {
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (self.sts.requestCount < requestCount && [timeout timeIntervalSinceNow] > 0) {
+        [NSThread sleepForTimeInterval:0.01];
+    }
+    // Let the request complete.
+    [NSThread sleepForTimeInterval:self.sts.requestLatency * 2];
+}
+
+- (void)testConcurrentRequestsShareOneAssumeRole {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    provider.durationSeconds = @900;
+
+    NSArray<AWSTask<AWSCredentials *> *> *tasks = [self requestCredentialsConcurrently:1000 fromProvider:provider];
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+
+    XCTAssertEqual(self.sts.requestCount, 1);
+    AWSCredentials *credentials = [tasks firstObject].result;
+    XCTAssertEqualObjects(credentials.accessKey, @"accessKey1");
+    XCTAssertEqualObjects(credentials.sessionKey, @"sessionToken");
+    for (AWSTask<AWSCredentials *> *task in tasks) {
+        XCTAssertEqual(task.result, credentials);
+    }
+    XCTAssertEqualObjects(self.sts.lastRequest.roleArn, AWSAssumeRoleCredentialsProviderUnitTestsRoleArn);
+    XCTAssertEqualObjects(self.sts.lastRequest.roleSessionName, @"session");
+    XCTAssertEqualObjects(self.sts.lastRequest.durationSeconds, @900);
+}
+
+- (void)testCachedCredentialsAreReturnedWithoutWaiting {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    [[provider credentials] waitUntilFinished];
+
+    NSArray<AWSTask<AWSCredentials *> *> *tasks = [self requestCredentialsConcurrently:1000 fromProvider:provider];
+    for (AWSTask<AWSCredentials *> *task in tasks) {
+        XCTAssertTrue(task.completed);
+        XCTAssertEqualObjects(task.result.accessKey, @"accessKey1");
+    }
+    XCTAssertEqual(self.sts.requestCount, 1);
+}
+
+- (void)testCredentialsAreServedWhileRefreshingAhead {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    [[provider credentials] waitUntilFinished];
+    [self makeRefreshAheadDueForProvider:provider];
+
+    // The refresh is due, but the still valid credentials are returned without waiting for it.
+    NSArray<AWSTask<AWSCredentials *> *> *tasks = [self requestCredentialsConcurrently:1000 fromProvider:provider];
+    for (AWSTask<AWSCredentials *> *task in tasks) {
+        XCTAssertTrue(task.completed);
+        XCTAssertEqualObjects(task.result.accessKey, @"accessKey1");
+    }
+
+    [self waitForRequestCount:2];
+    XCTAssertEqual(self.sts.requestCount, 2);
+    XCTAssertEqualObjects([provider credentials].result.accessKey, @"accessKey2");
+}
+
+- (void)testFailedRefreshAheadKeepsServingCredentials {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    [[provider credentials] waitUntilFinished];
+    [self makeRefreshAheadDueForProvider:provider];
+    self.sts.failsRequests = YES;
+
+    XCTAssertEqualObjects([provider credentials].result.accessKey, @"accessKey1");
+    [self waitForRequestCount:2];
+
+    // The failed refresh is retried later rather than on every request.
+    NSArray<AWSTask<AWSCredentials *> *> *tasks = [self requestCredentialsConcurrently:1000 fromProvider:provider];
+    for (AWSTask<AWSCredentials *> *task in tasks) {
+        XCTAssertEqualObjects(task.result.accessKey, @"accessKey1");
+    }
+    XCTAssertEqual(self.sts.requestCount, 2);
+}
+
+- (void)testExpiringCredentialsAreRefreshedOnDemand {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    provider.refreshAheadFraction = 1.0;
+    self.sts.credentialsLifetime = 30;
+
+    AWSTask<AWSCredentials *> *task = [provider credentials];
+    [task waitUntilFinished];
+    XCTAssertEqualObjects(task.result.accessKey, @"accessKey1");
+
+    task = [provider credentials];
+    XCTAssertFalse(task.completed);
+    [task waitUntilFinished];
+    XCTAssertEqualObjects(task.result.accessKey, @"accessKey2");
+}
+
+- (void)testFailureIsReturnedToEveryCaller {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    self.sts.failsRequests = YES;
+
+    NSArray<AWSTask<AWSCredentials *> *> *tasks = [self requestCredentialsConcurrently:100 fromProvider:provider];
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+    for (AWSTask<AWSCredentials *> *task in tasks) {
+        XCTAssertEqualObjects(task.error.domain, AWSSTSErrorDomain);
+    }
+    XCTAssertEqual(self.sts.requestCount, 1);
+
+    // A failure is not cached.
+    self.sts.failsRequests = NO;
+    AWSTask<AWSCredentials *> *task = [provider credentials];
+    [task waitUntilFinished];
+    XCTAssertEqualObjects(task.result.accessKey, @"accessKey2");
+}
+
+- (void)testProvidersShareCredentialsOfTheSameSession {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    AWSAssumeRoleCredentialsProvider *otherProvider = [self credentialsProviderWithPolicy:nil];
+    AWSAssumeRoleCredentialsProvider *policyProvider = [self credentialsProviderWithPolicy:@"{\"Version\":\"2012-10-17\"}"];
+    AWSAssumeRoleCredentialsProvider *sessionProvider = [[AWSAssumeRoleCredentialsProvider alloc] initWithSTS:self.sts
+                                                                                                      roleArn:AWSAssumeRoleCredentialsProviderUnitTestsRoleArn
+                                                                                              roleSessionName:@"otherSession"
+                                                                                                       policy:nil];
+
+    [[provider credentials] waitUntilFinished];
+    XCTAssertEqualObjects([otherProvider credentials].result.accessKey, @"accessKey1");
+    XCTAssertEqual(self.sts.requestCount, 1);
+
+    [[policyProvider credentials] waitUntilFinished];
+    XCTAssertEqualObjects(self.sts.lastRequest.policy, @"{\"Version\":\"2012-10-17\"}");
+    [[sessionProvider credentials] waitUntilFinished];
+    XCTAssertEqual(self.sts.requestCount, 3);
+
+    // Switching back to a role reuses its credentials.
+    XCTAssertEqualObjects([provider credentials].result.accessKey, @"accessKey1");
+    XCTAssertEqual(self.sts.requestCount, 3);
+}
+
+- (void)testProvidersWithDifferentDurationsDoNotShareCredentials {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    provider.durationSeconds = @900;
+    AWSAssumeRoleCredentialsProvider *longerProvider = [self credentialsProviderWithPolicy:nil];
+    longerProvider.durationSeconds = @3600;
+
+    [[provider credentials] waitUntilFinished];
+    AWSTask<AWSCredentials *> *task = [[longerProvider credentials] waitUntilFinished];
+    XCTAssertEqualObjects(task.result.accessKey, @"accessKey2");
+    XCTAssertEqualObjects(self.sts.lastRequest.durationSeconds, @3600);
+    XCTAssertEqual(self.sts.requestCount, 2);
+
+    // Changing the duration switches to the credentials of that session.
+    provider.durationSeconds = @3600;
+    XCTAssertEqualObjects([provider credentials].result.accessKey, @"accessKey2");
+    XCTAssertEqual(self.sts.requestCount, 2);
+}
+
+- (void)testCacheEntriesAreReleasedWithTheSourceCredentialsProvider {
+    __weak id weakCacheEntry = nil;
+    @autoreleasepool {
+        AWSStaticCredentialsProvider *sourceCredentialsProvider = [[AWSStaticCredentialsProvider alloc] initWithAccessKey:@"otherAccessKey"
+                                                                                                                secretKey:@"otherSecretKey"];
+        AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                             credentialsProvider:sourceCredentialsProvider];
+        AWSAssumeRoleCredentialsProviderTestSTS *sts = [[AWSAssumeRoleCredentialsProviderTestSTS alloc] initWithConfiguration:configuration];
+        AWSAssumeRoleCredentialsProvider *provider = [[AWSAssumeRoleCredentialsProvider alloc] initWithSTS:sts
+                                                                                                    roleArn:AWSAssumeRoleCredentialsProviderUnitTestsRoleArn
+                                                                                            roleSessionName:@"session"
+                                                                                                     policy:nil];
+        [[provider credentials] waitUntilFinished];
+        weakCacheEntry = [provider cacheEntry];
+        XCTAssertNotNil(weakCacheEntry);
+    }
+
+    // The test STS releases itself, and with it the source credentials provider, once its response has been delivered.
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (weakCacheEntry && [timeout timeIntervalSinceNow] > 0) {
+        [NSThread sleepForTimeInterval:0.01];
+    }
+    XCTAssertNil(weakCacheEntry);
+}
+
+- (void)testInvalidateCachedTemporaryCredentials {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+    [[provider credentials] waitUntilFinished];
+
+    [provider invalidateCachedTemporaryCredentials];
+    AWSTask<AWSCredentials *> *task = [provider credentials];
+    [task waitUntilFinished];
+    XCTAssertEqualObjects(task.result.accessKey, @"accessKey2");
+    XCTAssertEqual(self.sts.requestCount, 2);
+}
+
+- (void)testConcurrentRequestsPerformance {
+    AWSAssumeRoleCredentialsProvider *provider = [self credentialsProviderWithPolicy:nil];
+
+    NSDate *start = [NSDate date];
+    NSArray<AWSTask<AWSCredentials *> *> *tasks = [self requestCredentialsConcurrently:1000 fromProvider:provider];
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+    NSTimeInterval coldDuration = -[start timeIntervalSinceNow];
+
+    start = [NSDate date];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [self requestCredentialsConcurrently:1000 fromProvider:provider];
+    }
+    NSTimeInterval warmDuration = -[start timeIntervalSinceNow];
+
+    NSLog(@"1k concurrent requests: %.3fs with an empty cache, %.1fus per request with a warm cache, %lu AssumeRole requests for 101k requests",
+          coldDuration,
+          warmDuration / 100000 * USEC_PER_SEC,
+          (unsigned long)self.sts.requestCount);
+    XCTAssertEqual(self.sts.requestCount, 1);
+}
+
+@end
@@ -0,0 +1,133 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSCore.h"
+
+static NSString *const AWSCognitoCredentialsProviderUnitTestsIdentityPoolId = @"us-east-1:aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee";
+
+@interface AWSCognitoCredentialsProviderUnitTests : XCTestCase
+
+@property (nonatomic, strong) id mockNetworking;
+
+@end
+
+@implementation AWSCognitoCredentialsProviderUnitTests
+
+- (void)setUp {
+    [super setUp];
+    self.mockNetworking = OCMClassMock([AWSNetworking class]);
+    AWSTask *errorTask = [AWSTask taskWithError:[NSError errorWithDomain:@"OCMockExpectedNetworkingError" code:8848 userInfo:nil]];
+    OCMStub([self.mockNetworking sendRequest:[OCMArg isKindOfClass:[AWSNetworkingRequest class]]]).andReturn(errorTask);
+}
+
+- (void)tearDown {
+    [self.mockNetworking stopMocking];
+    [super tearDown];
+}
+
+- (AWSCognitoCredentialsProvider *)credentialsProviderWithRefreshAheadFraction:(double)refreshAheadFraction {
+    AWSCognitoCredentialsProvider *provider = [[AWSCognitoCredentialsProvider alloc] initWithRegionType:AWSRegionUSEast1
+                                                                                         identityPoolId:AWSCognitoCredentialsProviderUnitTestsIdentityPoolId];
+    [provider clearKeychain];
+    provider.refreshAheadFraction = refreshAheadFraction;
+    return provider;
+}
+
+- (AWSCredentials *)credentialsExpiringIn:(NSTimeInterval)interval {
+    return [[AWSCredentials alloc] initWithAccessKey:@"accessKey"
+                                           secretKey:@"secretKey"
+                                          sessionKey:@"sessionKey"
+                                          expiration:[NSDate dateWithTimeIntervalSinceNow:interval]];
+}
+
+- (void)testCachedCredentialsAreReturnedWithoutRefresh {
+    AWSCognitoCredentialsProvider *provider = [self credentialsProviderWithRefreshAheadFraction:0.75];
+    AWSCredentials *credentials = [self credentialsExpiringIn:60 * 60];
+    [provider setValue:credentials forKey:@"internalCredentials"];
+
+    for (int i = 0; i < 10; i++) {
+        AWSTask<AWSCredentials *> *task = [provider credentials];
+        XCTAssertTrue(task.completed);
+        XCTAssertEqual(task.result, credentials);
+    }
+
+    XCTAssertEqual(provider.metrics.cacheHitCount, 10);
+    XCTAssertEqual(provider.metrics.staleHitCount, 0);
+    XCTAssertEqual(provider.metrics.refreshCount, 0);
+}
+
+- (void)testCredentialsAreServedWhileRefreshingAhead {
+    AWSCognitoCredentialsProvider *provider = [self credentialsProviderWithRefreshAheadFraction:0];
+    AWSCredentials *credentials = [self credentialsExpiringIn:60 * 60];
+    [provider setValue:credentials forKey:@"internalCredentials"];
+
+    // The refresh is due right away, but the still valid credentials are returned without waiting for it.
+    AWSTask<AWSCredentials *> *task = [provider credentials];
+    XCTAssertTrue(task.completed);
+    XCTAssertEqual(task.result, credentials);
+    XCTAssertEqual(provider.metrics.cacheHitCount, 1);
+    XCTAssertEqual(provider.metrics.staleHitCount, 1);
+}
+
+- (void)testRefreshAheadIsDisabled {
+    AWSCognitoCredentialsProvider *provider = [self credentialsProviderWithRefreshAheadFraction:1.0];
+    AWSCredentials *credentials = [self credentialsExpiringIn:11 * 60];
+    [provider setValue:credentials forKey:@"internalCredentials"];
+
+    AWSTask<AWSCredentials *> *task = [provider credentials];
+    XCTAssertEqual(task.result, credentials);
+    XCTAssertEqual(provider.metrics.staleHitCount, 0);
+}
+
+- (void)testConcurrentCallersShareOneRefresh {
+    AWSCognitoCredentialsProvider *provider = [self credentialsProviderWithRefreshAheadFraction:0.75];
+    provider.identityProvider.identityId = @"us-east-1:11111111-2222-3333-4444-555555555555";
+    [provider setValue:[self credentialsExpiringIn:60] forKey:@"internalCredentials"];
+    // Holds the refresh back until every caller has asked for credentials.
+    NSOperationQueue *refreshQueue = [NSOperationQueue new];
+    refreshQueue.suspended = YES;
+    [provider setValue:[AWSExecutor executorWithOperationQueue:refreshQueue] forKey:@"refreshExecutor"];
+
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    dispatch_apply(20, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        AWSTask *task = [provider credentials];
+        @synchronized(tasks) {
+            [tasks addObject:task];
+        }
+    });
+    refreshQueue.suspended = NO;
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+
+    // Every caller fails with the stubbed networking error of the one refresh request made.
+    for (AWSTask *task in tasks) {
+        XCTAssertNotNil(task.error);
+    }
+    XCTAssertEqual(provider.metrics.refreshCount, 1);
+}
+
+- (void)testCachedCredentialsPerformance {
+    AWSCognitoCredentialsProvider *provider = [self credentialsProviderWithRefreshAheadFraction:1.0];
+    [provider setValue:[self credentialsExpiringIn:60 * 60] forKey:@"internalCredentials"];
+
+    [self measureBlock:^{
+        dispatch_apply(100000, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+            [provider credentials];
+        });
+    }];
+}
+
+@end
@@ -0,0 +1,190 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSCore.h>
+
+@interface AWSDDLogTestCapturingLogger : AWSDDAbstractLogger
+
+@property (nonatomic, strong) NSMutableArray<AWSDDLogMessage *> *messages;
+
+@end
+
+@implementation AWSDDLogTestCapturingLogger
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _messages = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (void)logMessage:(AWSDDLogMessage *)logMessage {
+    [self.messages addObject:logMessage];
+}
+
+@end
+
+@interface AWSDDLogTests : XCTestCase
+
+@property (nonatomic, assign) AWSDDLogLevel originalLogLevel;
+@property (nonatomic, assign) NSUInteger evaluationCount;
+
+@end
+
+@implementation AWSDDLogTests
+
+- (void)setUp {
+    [super setUp];
+    self.originalLogLevel = [AWSDDLog sharedInstance].logLevel;
+    self.evaluationCount = 0;
+}
+
+- (void)tearDown {
+    [AWSDDLog sharedInstance].logLevel = self.originalLogLevel;
+    [super tearDown];
+}
+
+- (NSString *)countedArgument {
+    self.evaluationCount++;
+    return @"argument";
+}
+
+- (void)testSharedLogLevelTracksSharedInstance {
+    [AWSDDLog sharedInstance].logLevel = AWSDDLogLevelInfo;
+    XCTAssertEqual(AWSDDLogSharedLogLevel(), AWSDDLogLevelInfo);
+
+    [AWSDDLog sharedInstance].logLevel = AWSDDLogLevelOff;
+    XCTAssertEqual(AWSDDLogSharedLogLevel(), AWSDDLogLevelOff);
+
+    AWSDDLog *otherLog = [AWSDDLog new];
+    otherLog.logLevel = AWSDDLogLevelVerbose;
+    XCTAssertEqual(AWSDDLogSharedLogLevel(), AWSDDLogLevelOff);
+}
+
+- (void)testDisabledLogStatementsDoNotEvaluateArguments {
+    [AWSDDLog sharedInstance].logLevel = AWSDDLogLevelWarning;
+
+    AWSDDLogVerbose(@"%@", [self countedArgument]);
+    AWSDDLogDebug(@"%@", [self countedArgument]);
+    AWSDDLogInfo(@"%@", [self countedArgument]);
+    XCTAssertEqual(self.evaluationCount, 0);
+
+    AWSDDLogWarn(@"%@", [self countedArgument]);
+    XCTAssertEqual(self.evaluationCount, 1);
+
+    [AWSDDLog sharedInstance].logLevel = AWSDDLogLevelVerbose;
+    AWSDDLogVerbose(@"%@", [self countedArgument]);
+    XCTAssertEqual(self.evaluationCount, 2);
+}
+
+#pragma mark - Thread buffers
+
+- (void)logFromThreads:(NSUInteger)threadCount
+       messagesPerThread:(NSUInteger)messageCount
+                   toLog:(AWSDDLog *)log {
+    dispatch_group_t group = dispatch_group_create();
+    for (NSUInteger thread = 0; thread < threadCount; thread++) {
+        dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            for (NSUInteger i = 0; i < messageCount; i++) {
+                [log log:YES
+                   level:AWSDDLogLevelAll
+                    flag:AWSDDLogFlagDebug
+                 context:0
+                    file:__FILE__
+                function:__PRETTY_FUNCTION__
+                    line:__LINE__
+                     tag:nil
+                  format:@"%lu %lu", (unsigned long)thread, (unsigned long)i];
+            }
+        });
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    [log flushLog];
+}
+
+- (void)testThreadBuffersDeliverEveryMessageInPerThreadOrder {
+    AWSDDLog *log = [AWSDDLog new];
+    log.usesThreadBuffers = YES;
+    AWSDDLogTestCapturingLogger *logger = [AWSDDLogTestCapturingLogger new];
+    [log addLogger:logger];
+
+    NSUInteger threadCount = 4;
+    NSUInteger messageCount = 200;
+    [self logFromThreads:threadCount messagesPerThread:messageCount toLog:log];
+
+    XCTAssertEqual(logger.messages.count + log.droppedMessageCount, threadCount * messageCount);
+
+    NSMutableDictionary<NSString *, NSNumber *> *lastIndexByThread = [NSMutableDictionary new];
+    for (AWSDDLogMessage *message in logger.messages) {
+        NSArray<NSString *> *parts = [message.message componentsSeparatedByString:@" "];
+        NSInteger index = [parts[1] integerValue];
+        NSNumber *lastIndex = lastIndexByThread[parts[0]];
+        if (lastIndex) {
+            XCTAssertGreaterThan(index, [lastIndex integerValue]);
+        }
+        lastIndexByThread[parts[0]] = @(index);
+    }
+
+    [log removeAllLoggers];
+}
+
+- (void)testSynchronousMessageIsDeliveredAfterBufferedMessages {
+    AWSDDLog *log = [AWSDDLog new];
+    log.usesThreadBuffers = YES;
+    AWSDDLogTestCapturingLogger *logger = [AWSDDLogTestCapturingLogger new];
+    [log addLogger:logger];
+
+    [log log:YES level:AWSDDLogLevelAll flag:AWSDDLogFlagInfo context:0 file:__FILE__ function:__PRETTY_FUNCTION__ line:__LINE__ tag:nil format:@"first"];
+    [log log:NO level:AWSDDLogLevelAll flag:AWSDDLogFlagError context:0 file:__FILE__ function:__PRETTY_FUNCTION__ line:__LINE__ tag:nil format:@"second"];
+
+    [log flushLog];
+    XCTAssertEqual(logger.messages.count, 2);
+    XCTAssertEqualObjects(logger.messages.firstObject.message, @"first");
+    XCTAssertEqualObjects(logger.messages.lastObject.message, @"second");
+
+    [log removeAllLoggers];
+}
+
+// Compares the default path (semaphore and one dispatch per message, one write per line)
+// with thread buffers feeding the file logger in batches.
+- (void)measureFileLoggingThroughputUsingThreadBuffers:(BOOL)usesThreadBuffers {
+    NSString *logsDirectory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    AWSDDLogFileManagerDefault *logFileManager = [[AWSDDLogFileManagerDefault alloc] initWithLogsDirectory:logsDirectory];
+    AWSDDFileLogger *fileLogger = [[AWSDDFileLogger alloc] initWithLogFileManager:logFileManager];
+    fileLogger.maximumFileSize = 0;
+    fileLogger.rollingFrequency = 0;
+
+    AWSDDLog *log = [AWSDDLog new];
+    log.usesThreadBuffers = usesThreadBuffers;
+    [log addLogger:fileLogger];
+
+    [self measureBlock:^{
+        [self logFromThreads:4 messagesPerThread:2500 toLog:log];
+    }];
+
+    [log removeAllLoggers];
+    [[NSFileManager defaultManager] removeItemAtPath:logsDirectory error:nil];
+}
+
+- (void)testFileLoggingThroughputWithDispatchPerMessage {
+    [self measureFileLoggingThroughputUsingThreadBuffers:NO];
+}
+
+- (void)testFileLoggingThroughputWithThreadBuffers {
+    [self measureFileLoggingThroughputUsingThreadBuffers:YES];
+}
+
+@end
@@ -158,4 +158,67 @@
     XCTAssertEqual([components second], 01);
 }
 
+#pragma mark - Fixed formats match NSDateFormatter
+
+- (NSDateFormatter *)referenceFormatterWithFormat:(NSString *)dateFormat {
+    NSDateFormatter *dateFormatter = [NSDateFormatter new];
+    dateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"GMT"];
+    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    dateFormatter.dateFormat = dateFormat;
+    return dateFormatter;
+}
+
+- (void)test_aws_stringValue_matchesDateFormatterForFixedFormats {
+    NSArray<NSString *> *dateFormats = @[AWSDateRFC822DateFormat1,
+                                         AWSDateISO8601DateFormat1,
+                                         AWSDateISO8601DateFormat2,
+                                         AWSDateISO8601DateFormat3,
+                                         AWSDateShortDateFormat1,
+                                         AWSDateShortDateFormat2];
+    // 1600-01-01 through 9000-01-01, with sub-millisecond fractions and leap days.
+    NSTimeInterval lowerBound = -11676096000.0;
+    NSTimeInterval upperBound = 221845392000.0;
+    for (NSString *dateFormat in dateFormats) {
+        NSDateFormatter *referenceFormatter = [self referenceFormatterWithFormat:dateFormat];
+        for (int i = 0; i < 2000; i++) {
+            double fraction = (double)arc4random() / UINT32_MAX;
+            NSDate *date = [NSDate dateWithTimeIntervalSince1970:lowerBound + fraction * (upperBound - lowerBound)];
+            NSString *expected = [referenceFormatter stringFromDate:date];
+            XCTAssertEqualObjects([date aws_stringValue:dateFormat], expected);
+            XCTAssertEqualObjects([NSDate aws_dateFromString:expected format:dateFormat],
+                                  [referenceFormatter dateFromString:expected]);
+        }
+    }
+
+    NSDate *leapDay = [NSDate dateWithTimeIntervalSince1970:951782400.0];
+    XCTAssertEqualObjects([leapDay aws_stringValue:AWSDateISO8601DateFormat1], @"2000-02-29T00:00:00Z");
+    XCTAssertEqualObjects([leapDay aws_stringValue:AWSDateRFC822DateFormat1], @"Tue, 29 Feb 2000 00:00:00 GMT");
+}
+
+- (void)test_aws_dateFromString_fallsBackToDateFormatter {
+    // Day 30 of February is not accepted by the fixed-format parser and goes through NSDateFormatter.
+    NSString *string = @"2019-02-30T03:45:06Z";
+    NSDateFormatter *referenceFormatter = [self referenceFormatterWithFormat:AWSDateISO8601DateFormat1];
+    XCTAssertEqualObjects([NSDate aws_dateFromString:string format:AWSDateISO8601DateFormat1],
+                          [referenceFormatter dateFromString:string]);
+
+    XCTAssertEqualObjects([NSDate aws_dateFromString:@"Wed, 2 Jan 2019 03:45:06 GMT"],
+                          [NSDate dateWithTimeIntervalSince1970:1546400706.0]);
+    XCTAssertEqualObjects([NSDate aws_dateFromString:@"Wed, 02 Jan 2019 03:45:06 UTC"],
+                          [NSDate dateWithTimeIntervalSince1970:1546400706.0]);
+    XCTAssertNil([NSDate aws_dateFromString:@"1546400706.123"]);
+    XCTAssertNil([NSDate aws_dateFromString:@""]);
+}
+
+- (void)testFixedFormatPerformance {
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:1546400706.789];
+    [self measureBlock:^{
+        for (int i = 0; i < 10000; i++) {
+            NSString *string = [date aws_stringValue:AWSDateISO8601DateFormat3];
+            [NSDate aws_dateFromString:string format:AWSDateISO8601DateFormat3];
+            [NSDate aws_dateFromString:[date aws_stringValue:AWSDateRFC822DateFormat1]];
+        }
+    }];
+}
+
 @end
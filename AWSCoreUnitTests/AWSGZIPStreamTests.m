@@ -0,0 +1,279 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <mach/mach.h>
+#import "AWSCore.h"
+#import "AWSGZIP.h"
+#import "AWSGZIPStream.h"
+
+@interface AWSGZIPStreamTests : XCTestCase
+
+@end
+
+@implementation AWSGZIPStreamTests
+
+// JSON-like records, which compress about as well as request bodies do.
+- (NSData *)recordsOfLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithCapacity:length];
+    NSUInteger index = 0;
+    while ([data length] < length) {
+        NSString *record = [NSString stringWithFormat:@"{\"PartitionKey\":\"key-%u\",\"SequenceNumber\":%lu,\"Data\":\"%08x%08x\"},",
+                            arc4random_uniform(100), (unsigned long)index++, arc4random(), arc4random()];
+        [data appendData:[record dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    data.length = length;
+    return data;
+}
+
+- (NSData *)readStream:(NSInputStream *)stream bufferSize:(NSUInteger)bufferSize error:(NSError **)error {
+    NSMutableData *data = [NSMutableData new];
+    uint8_t *buffer = malloc(bufferSize);
+    [stream open];
+    NSInteger read;
+    while ((read = [stream read:buffer maxLength:bufferSize]) > 0) {
+        [data appendBytes:buffer length:read];
+    }
+    if (error) {
+        *error = [stream streamError];
+    }
+    [stream close];
+    free(buffer);
+    return read < 0 ? nil : data;
+}
+
+- (uint64_t)physicalFootprint {
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.phys_footprint;
+}
+
+- (void)testOnePassMatchesCategory {
+    for (NSNumber *length in @[@0, @1, @1000, @(1024 * 1024)]) {
+        NSData *data = [self recordsOfLength:[length unsignedIntegerValue]];
+
+        NSError *error = nil;
+        NSData *gzippedData = [AWSGZIPCodec gzippedData:data level:-1.0f error:&error];
+        XCTAssertNil(error);
+        XCTAssertNotNil(gzippedData);
+        XCTAssertEqualObjects([AWSGZIPCodec gunzippedData:gzippedData error:&error], data, @"Length %@", length);
+        XCTAssertNil(error);
+
+        if ([data length] > 0) {
+            XCTAssertEqualObjects([gzippedData awsgzip_gunzippedData], data, @"Length %@", length);
+            XCTAssertEqualObjects([AWSGZIPCodec gunzippedData:[data awsgzip_gzippedData] error:nil], data, @"Length %@", length);
+        }
+    }
+}
+
+- (void)testProcessInPieces {
+    NSData *data = [self recordsOfLength:300 * 1024];
+
+    AWSGZIPCodec *compressor = [[AWSGZIPCodec alloc] initWithMode:AWSGZIPCodecModeCompress level:0.5f];
+    NSMutableData *gzippedData = [NSMutableData new];
+    for (NSUInteger location = 0; location < [data length]; location += 1000) {
+        NSData *piece = [data subdataWithRange:NSMakeRange(location, MIN(1000, [data length] - location))];
+        [gzippedData appendData:[compressor processData:piece finish:NO error:nil]];
+    }
+    [gzippedData appendData:[compressor processData:[NSData data] finish:YES error:nil]];
+    XCTAssertTrue(compressor.finished);
+    XCTAssertEqual(compressor.totalIn, (unsigned long long)[data length]);
+    XCTAssertEqual(compressor.totalOut, (unsigned long long)[gzippedData length]);
+
+    AWSGZIPCodec *decompressor = [[AWSGZIPCodec alloc] initWithMode:AWSGZIPCodecModeDecompress level:-1.0f];
+    NSMutableData *gunzippedData = [NSMutableData new];
+    for (NSUInteger location = 0; location < [gzippedData length]; location += 7) {
+        NSUInteger length = MIN(7, [gzippedData length] - location);
+        NSError *error = nil;
+        XCTAssertTrue([decompressor processBytes:(const uint8_t *)[gzippedData bytes] + location
+                                          length:length
+                                          finish:location + length == [gzippedData length]
+                                   outputHandler:^(const uint8_t *bytes, NSUInteger length) {
+                                       [gunzippedData appendBytes:bytes length:length];
+                                   }
+                                           error:&error]);
+        XCTAssertNil(error);
+    }
+    XCTAssertTrue(decompressor.finished);
+    XCTAssertEqualObjects(gunzippedData, data);
+}
+
+- (void)testInvalidAndTruncatedData {
+    NSData *gzippedData = [AWSGZIPCodec gzippedData:[self recordsOfLength:10000] level:-1.0f error:nil];
+
+    NSError *error = nil;
+    XCTAssertNil([AWSGZIPCodec gunzippedData:[gzippedData subdataWithRange:NSMakeRange(0, [gzippedData length] - 3)] error:&error]);
+    XCTAssertEqualObjects(error.domain, AWSGZIPErrorDomain);
+    XCTAssertEqual(error.code, AWSGZIPErrorTruncatedData);
+
+    NSMutableData *corruptedData = [gzippedData mutableCopy];
+    ((uint8_t *)[corruptedData mutableBytes])[[corruptedData length] - 6] ^= 0xFF;
+    error = nil;
+    XCTAssertNil([AWSGZIPCodec gunzippedData:corruptedData error:&error]);
+    XCTAssertEqualObjects(error.domain, AWSGZIPErrorDomain);
+    XCTAssertEqual(error.code, AWSGZIPErrorInvalidData);
+
+    AWSGZIPInputStream *stream = [[AWSGZIPInputStream alloc] initWithInputStream:[NSInputStream inputStreamWithData:[gzippedData subdataWithRange:NSMakeRange(0, 100)]]
+                                                                            mode:AWSGZIPCodecModeDecompress
+                                                                           level:-1.0f];
+    error = nil;
+    XCTAssertNil([self readStream:stream bufferSize:4096 error:&error]);
+    XCTAssertEqual(error.code, AWSGZIPErrorTruncatedData);
+    XCTAssertEqual([stream streamStatus], NSStreamStatusClosed);
+}
+
+- (void)testInputStream {
+    NSData *data = [self recordsOfLength:500 * 1024];
+
+    for (NSNumber *bufferSize in @[@1, @13, @(64 * 1024)]) {
+        AWSGZIPInputStream *compressingStream = [[AWSGZIPInputStream alloc] initWithInputStream:[NSInputStream inputStreamWithData:data]
+                                                                                           mode:AWSGZIPCodecModeCompress
+                                                                                          level:-1.0f];
+        NSData *gzippedData = [self readStream:compressingStream bufferSize:[bufferSize unsignedIntegerValue] error:nil];
+        XCTAssertEqualObjects([gzippedData awsgzip_gunzippedData], data, @"Buffer size %@", bufferSize);
+        XCTAssertEqual(compressingStream.totalIn, (unsigned long long)[data length]);
+        XCTAssertEqual(compressingStream.totalOut, (unsigned long long)[gzippedData length]);
+
+        AWSGZIPInputStream *decompressingStream = [[AWSGZIPInputStream alloc] initWithInputStream:[NSInputStream inputStreamWithData:gzippedData]
+                                                                                             mode:AWSGZIPCodecModeDecompress
+                                                                                            level:-1.0f];
+        XCTAssertEqualObjects([self readStream:decompressingStream bufferSize:[bufferSize unsignedIntegerValue] error:nil], data, @"Buffer size %@", bufferSize);
+    }
+
+    NSError *error = nil;
+    NSData *gzippedData = [AWSGZIPCodec gzippedDataWithContentsOfStream:[NSInputStream inputStreamWithData:data]
+                                                                 length:[data length]
+                                                                  level:-1.0f
+                                                                  error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects([AWSGZIPCodec gunzippedData:gzippedData error:nil], data);
+
+    // A wrong length only costs a reallocation.
+    gzippedData = [AWSGZIPCodec gzippedDataWithContentsOfStream:[NSInputStream inputStreamWithData:data]
+                                                         length:10
+                                                          level:-1.0f
+                                                          error:&error];
+    XCTAssertEqualObjects([AWSGZIPCodec gunzippedData:gzippedData error:nil], data);
+}
+
+- (void)testCodecsAreReused {
+    AWSGZIPCodec *codec = [AWSGZIPCodec compressorWithLevel:0.3f];
+    [codec processData:[self recordsOfLength:1000] finish:YES error:nil];
+    XCTAssertTrue(codec.finished);
+    [codec recycle];
+
+    AWSGZIPCodec *reusedCodec = [AWSGZIPCodec compressorWithLevel:0.3f];
+    XCTAssertEqual(reusedCodec, codec);
+    XCTAssertFalse(reusedCodec.finished);
+    XCTAssertEqual(reusedCodec.totalIn, 0ULL);
+    XCTAssertEqual(reusedCodec.totalOut, 0ULL);
+
+    NSData *data = [self recordsOfLength:1000];
+    XCTAssertEqualObjects([AWSGZIPCodec gunzippedData:[reusedCodec processData:data finish:YES error:nil] error:nil], data);
+    [reusedCodec recycle];
+
+    XCTAssertNotEqual([AWSGZIPCodec compressorWithLevel:0.7f], codec);
+    XCTAssertNotEqual([AWSGZIPCodec decompressor], codec);
+}
+
+- (void)testSerializerGzipsStreamedBody {
+    NSDictionary *definition = @{
+        @"operations" : @{@"PutRecord" : @{@"http" : @{@"method" : @"POST", @"requestUri" : @"/"},
+                                           @"input" : @{@"shape" : @"PutRecordInput"}}},
+        @"shapes" : @{@"PutRecordInput" : @{@"type" : @"structure",
+                                            @"members" : @{@"Data" : @{@"shape" : @"Data"}}},
+                      @"Data" : @{@"type" : @"blob"}},
+    };
+    NSDictionary *parameters = @{@"Data" : [self recordsOfLength:AWSJSONBuilderStreamingBlobThreshold * 4]};
+    AWSJSONRequestSerializer *serializer = [[AWSJSONRequestSerializer alloc] initWithJSONDefinition:definition
+                                                                                         actionName:@"PutRecord"];
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://kinesis.us-east-1.amazonaws.com"]];
+    request.HTTPMethod = @"POST";
+    AWSTask *task = [serializer serializeRequest:request headers:@{@"Content-Encoding" : @"gzip"} parameters:parameters];
+    XCTAssertNil(task.error);
+    XCTAssertNil(request.HTTPBodyStream);
+
+    NSData *expectedData = [AWSJSONBuilder jsonDataForDictionary:parameters
+                                                      actionName:@"PutRecord"
+                                           serviceDefinitionRule:definition
+                                                           error:nil];
+    XCTAssertEqualObjects([request.HTTPBody awsgzip_gunzippedData], expectedData);
+}
+
+- (void)testThroughputAndMemoryBenchmark {
+    for (NSNumber *megabytes in @[@1, @10, @50]) {
+        @autoreleasepool {
+            NSData *data = [self recordsOfLength:[megabytes unsignedIntegerValue] * 1024 * 1024];
+            double size = [data length] / (1024.0 * 1024.0);
+
+            uint64_t baseline = [self physicalFootprint];
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            NSData *categoryGzipped = [data awsgzip_gzippedData];
+            NSData *categoryGunzipped = [categoryGzipped awsgzip_gunzippedData];
+            CFAbsoluteTime categoryTime = CFAbsoluteTimeGetCurrent() - start;
+            uint64_t categoryGrowth = [self physicalFootprint] - baseline;
+            XCTAssertEqualObjects(categoryGunzipped, data);
+            categoryGzipped = nil;
+            categoryGunzipped = nil;
+
+            baseline = [self physicalFootprint];
+            start = CFAbsoluteTimeGetCurrent();
+            NSData *codecGzipped = [AWSGZIPCodec gzippedData:data level:-1.0f error:nil];
+            NSData *codecGunzipped = [AWSGZIPCodec gunzippedData:codecGzipped error:nil];
+            CFAbsoluteTime codecTime = CFAbsoluteTimeGetCurrent() - start;
+            uint64_t codecGrowth = [self physicalFootprint] - baseline;
+            XCTAssertEqualObjects(codecGunzipped, data);
+            codecGzipped = nil;
+            codecGunzipped = nil;
+
+            // Compress and decompress through streams, keeping only a 64KB buffer of output.
+            baseline = [self physicalFootprint];
+            uint64_t peak = baseline;
+            start = CFAbsoluteTimeGetCurrent();
+            AWSGZIPInputStream *stream = [[AWSGZIPInputStream alloc] initWithInputStream:[[AWSGZIPInputStream alloc] initWithInputStream:[NSInputStream inputStreamWithData:data]
+                                                                                                                                   mode:AWSGZIPCodecModeCompress
+                                                                                                                                  level:-1.0f]
+                                                                                    mode:AWSGZIPCodecModeDecompress
+                                                                                   level:-1.0f];
+            uint8_t *buffer = malloc(64 * 1024);
+            unsigned long long total = 0;
+            NSInteger read;
+            [stream open];
+            while ((read = [stream read:buffer maxLength:64 * 1024]) > 0) {
+                XCTAssertEqual(memcmp(buffer, (const uint8_t *)[data bytes] + total, read), 0);
+                total += read;
+                if (total % (1024 * 1024) < 64 * 1024) {
+                    peak = MAX(peak, [self physicalFootprint]);
+                }
+            }
+            [stream close];
+            free(buffer);
+            CFAbsoluteTime streamTime = CFAbsoluteTimeGetCurrent() - start;
+            XCTAssertEqual(total, (unsigned long long)[data length]);
+
+            NSLog(@"%.0fMB round trip: category %.0f MB/s, %.1fMB footprint growth; one pass %.0f MB/s, %.1fMB; streams %.0f MB/s, %.1fMB peak",
+                  size,
+                  size / categoryTime, categoryGrowth / (1024.0 * 1024.0),
+                  size / codecTime, codecGrowth / (1024.0 * 1024.0),
+                  size / streamTime, (peak - baseline) / (1024.0 * 1024.0));
+        }
+    }
+}
+
+@end
@@ -0,0 +1,201 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSCore.h>
+
+@interface AWSPaginatorTestRequest : AWSRequest
+
+@property (nonatomic, strong) NSString *name;
+@property (nonatomic, strong) NSString *nextToken;
+
+@end
+
+@implementation AWSPaginatorTestRequest
+
+@end
+
+@interface AWSPaginatorTests : XCTestCase
+
+@end
+
+@implementation AWSPaginatorTests
+
+// Serves `pageCount` pages of `pageSize` numbered items, each after `latency` seconds.
+- (AWSPaginator<NSNumber *> *)paginatorWithPageCount:(NSUInteger)pageCount
+                                            pageSize:(NSUInteger)pageSize
+                                             latency:(NSTimeInterval)latency
+                                          fetchCount:(NSUInteger *)fetchCount {
+    return [[AWSPaginator alloc] initWithOutputTokenKey:@"nextToken"
+                                              resultKey:@"items"
+                                              pageBlock:^AWSTask *(NSNumber *token) {
+        NSUInteger pageIndex = [token unsignedIntegerValue];
+        if (fetchCount) {
+            @synchronized(self) {
+                (*fetchCount)++;
+            }
+        }
+
+        NSMutableArray<NSNumber *> *items = [NSMutableArray new];
+        for (NSUInteger i = 0; i < pageSize; i++) {
+            [items addObject:@(pageIndex * pageSize + i)];
+        }
+        NSMutableDictionary *page = [NSMutableDictionary new];
+        page[@"items"] = items;
+        if (pageIndex + 1 < pageCount) {
+            page[@"nextToken"] = @(pageIndex + 1);
+        }
+
+        if (latency == 0) {
+            return [AWSTask taskWithResult:page];
+        }
+        AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            taskCompletionSource.result = page;
+        });
+        return taskCompletionSource.task;
+    }];
+}
+
+- (void)testEnumeratesItemsOfAllPages {
+    AWSPaginator<NSNumber *> *paginator = [self paginatorWithPageCount:10 pageSize:10 latency:0.001 fetchCount:NULL];
+
+    NSMutableArray<NSNumber *> *items = [NSMutableArray new];
+    AWSTask *task = [[paginator enumerateItemsUsingBlock:^(NSNumber *item, BOOL *stop) {
+        [items addObject:item];
+    }] waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([items count], 100);
+    for (NSUInteger i = 0; i < [items count]; i++) {
+        XCTAssertEqualObjects(items[i], @(i));
+    }
+    XCTAssertEqual(paginator.pageCount, 10);
+    XCTAssertNil([[paginator nextPage] waitUntilFinished].result);
+}
+
+- (void)testStopsEnumerating {
+    NSUInteger fetchCount = 0;
+    AWSPaginator<NSNumber *> *paginator = [self paginatorWithPageCount:100 pageSize:10 latency:0 fetchCount:&fetchCount];
+    paginator.lookahead = 0;
+
+    __block NSUInteger itemCount = 0;
+    [[paginator enumerateItemsUsingBlock:^(NSNumber *item, BOOL *stop) {
+        itemCount++;
+        *stop = [item integerValue] == 14;
+    }] waitUntilFinished];
+
+    XCTAssertEqual(itemCount, 15);
+    XCTAssertEqual(fetchCount, 2);
+}
+
+- (void)testLookaheadBoundsPrefetchedPages {
+    NSUInteger fetchCount = 0;
+    AWSPaginator<NSNumber *> *paginator = [self paginatorWithPageCount:100 pageSize:10 latency:0 fetchCount:&fetchCount];
+    paginator.lookahead = 3;
+
+    AWSTask *task = [[paginator nextPage] waitUntilFinished];
+    XCTAssertEqual([task.result count], 10);
+
+    // The first page, then three pages ahead of the caller, and no more.
+    XCTAssertEqual(fetchCount, 4);
+    XCTAssertEqual(paginator.pageCount, 4);
+
+    [[paginator nextPage] waitUntilFinished];
+    XCTAssertEqual(fetchCount, 5);
+}
+
+- (void)testErrorEndsWalk {
+    __block NSUInteger fetchCount = 0;
+    AWSPaginator *paginator = [[AWSPaginator alloc] initWithOutputTokenKey:@"nextToken"
+                                                                 resultKey:@"items"
+                                                                 pageBlock:^AWSTask *(id token) {
+        fetchCount++;
+        if (token) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:@"AWSPaginatorTests" code:1 userInfo:nil]];
+        }
+        return [AWSTask taskWithResult:@{@"items" : @[@1, @2], @"nextToken" : @"token"}];
+    }];
+
+    XCTAssertEqualObjects([[paginator nextPage] waitUntilFinished].result, (@[@1, @2]));
+    AWSTask *task = [[paginator nextPage] waitUntilFinished];
+    XCTAssertEqualObjects(task.error.domain, @"AWSPaginatorTests");
+    XCTAssertEqualObjects(paginator.error.domain, @"AWSPaginatorTests");
+    XCTAssertNil([[paginator nextPage] waitUntilFinished].result);
+    XCTAssertEqual(fetchCount, 2);
+}
+
+- (void)testItemEnumerator {
+    AWSPaginator<NSNumber *> *paginator = [self paginatorWithPageCount:5 pageSize:3 latency:0.001 fetchCount:NULL];
+
+    NSUInteger expected = 0;
+    for (NSNumber *item in [paginator itemEnumerator]) {
+        XCTAssertEqualObjects(item, @(expected));
+        expected++;
+    }
+    XCTAssertEqual(expected, 15);
+    XCTAssertNil(paginator.error);
+}
+
+- (void)testPaginatorWithRequestCopiesRequest {
+    AWSPaginatorTestRequest *request = [AWSPaginatorTestRequest new];
+    request.name = @"name";
+
+    NSMutableArray<AWSPaginatorTestRequest *> *pageRequests = [NSMutableArray new];
+    AWSPaginator *paginator = [AWSPaginator paginatorWithRequest:request
+                                                   inputTokenKey:@"nextToken"
+                                                  outputTokenKey:@"nextToken"
+                                                       resultKey:@"items"
+                                                       operation:^AWSTask *(AWSPaginatorTestRequest *pageRequest) {
+        [pageRequests addObject:pageRequest];
+        NSString *nextToken = [pageRequests count] < 3 ? [NSString stringWithFormat:@"token%lu", (unsigned long)[pageRequests count]] : @"";
+        return [AWSTask taskWithResult:@{@"items" : @[pageRequest.name], @"nextToken" : nextToken}];
+    }];
+    [[paginator enumerateItemsUsingBlock:^(id item, BOOL *stop) {}] waitUntilFinished];
+
+    XCTAssertEqual([pageRequests count], 3);
+    XCTAssertNil(pageRequests[0].nextToken);
+    XCTAssertEqualObjects(pageRequests[1].nextToken, @"token1");
+    XCTAssertEqualObjects(pageRequests[2].nextToken, @"token2");
+    XCTAssertEqualObjects(pageRequests[2].name, @"name");
+    XCTAssertNil(request.nextToken);
+}
+
+- (NSTimeInterval)walkOneHundredThousandItemsWithLookahead:(NSUInteger)lookahead {
+    AWSPaginator<NSNumber *> *paginator = [self paginatorWithPageCount:100 pageSize:1000 latency:0.02 fetchCount:NULL];
+    paginator.lookahead = lookahead;
+
+    NSDate *start = [NSDate date];
+    NSUInteger itemCount = 0;
+    NSArray<NSNumber *> *items = nil;
+    while ((items = [[paginator nextPage] waitUntilFinished].result)) {
+        itemCount += [items count];
+        // Processing a page takes about as long as fetching one.
+        [NSThread sleepForTimeInterval:0.02];
+    }
+    XCTAssertEqual(itemCount, 100000);
+    return [[NSDate date] timeIntervalSinceDate:start];
+}
+
+- (void)testWalkingOneHundredThousandItemsBenchmark {
+    NSTimeInterval withoutLookahead = [self walkOneHundredThousandItemsWithLookahead:0];
+    NSTimeInterval withLookahead = [self walkOneHundredThousandItemsWithLookahead:AWSPaginatorLookaheadDefault];
+    NSLog(@"Walked 100,000 items in 100 pages in %.2fs without lookahead and %.2fs with a lookahead of %lu.",
+          withoutLookahead, withLookahead, (unsigned long)AWSPaginatorLookaheadDefault);
+
+    XCTAssertLessThan(withLookahead, withoutLookahead * 0.75);
+}
+
+@end
@@ -0,0 +1,257 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <malloc/malloc.h>
+#import "AWSSerialization.h"
+#import "AWSXMLWriter.h"
+#import "AWSXMLDataWriter.h"
+
+static NSString *const AWSXMLDataWriterTestsNamespace = @"http://s3.amazonaws.com/doc/2006-03-01/";
+
+@interface AWSXMLDataWriterTests : XCTestCase
+
+@end
+
+@implementation AWSXMLDataWriterTests
+
+// Drives either writer through the calls the REST-XML serializer makes.
+- (void)writeDocument:(id)writer text:(NSString *)text {
+    [writer writeStartElement:@"Delete"];
+    [writer writeAttribute:@"xmlns" value:AWSXMLDataWriterTestsNamespace];
+    [writer writeStartElement:@"Quiet"];
+    [writer writeCharacters:@"true"];
+    [writer writeEndElement:@"Quiet"];
+    [writer writeStartElement:@"Object"];
+    [writer writeStartElement:@"Key"];
+    [writer writeCharacters:text];
+    [writer writeEndElement:@"Key"];
+    [writer writeStartElement:@"VersionId"];
+    [writer writeEndElement:@"VersionId"];
+    [writer writeEndElement:@"Object"];
+    [writer writeStartElement:@"Tagging"];
+    [writer writeAttribute:@"Type" value:text];
+    [writer writeEndElement:@"Tagging"];
+    [writer writeEndElement:@"Delete"];
+}
+
+- (void)testMatchesXMLWriter {
+    NSMutableString *longText = [NSMutableString new];
+    for (NSUInteger i = 0; i < 500; i++) {
+        [longText appendFormat:@"photos/%lu/été \"<&>\" 日本.jpg\t", (unsigned long)i];
+    }
+    NSArray<NSString *> *texts = @[@"",
+                                   @"photos/2021/summer.jpg",
+                                   @"a < b && c > \"d\" 'e'",
+                                   @"line\nbreak\r\ttab\x01\x1f",
+                                   @"café ÆØÅ ñ 日本語 �",
+                                   [@"x" stringByPaddingToLength:5000 withString:@"&<\"" startingAtIndex:0],
+                                   longText];
+
+    for (NSString *text in texts) {
+        AWSXMLWriter *xmlWriter = [AWSXMLWriter new];
+        [self writeDocument:xmlWriter text:text];
+        AWSXMLDataWriter *dataWriter = [[AWSXMLDataWriter alloc] initWithCapacity:16];
+        [self writeDocument:dataWriter text:text];
+
+        XCTAssertEqualObjects([dataWriter toData], [xmlWriter toData]);
+        XCTAssertEqualObjects([dataWriter toString], [xmlWriter toString]);
+        XCTAssertEqual(dataWriter.level, (NSUInteger)0);
+        XCTAssertEqual(dataWriter.length, [[dataWriter toData] length]);
+    }
+}
+
+- (void)testIndentationAndLineBreak {
+    AWSXMLDataWriter *writer = [AWSXMLDataWriter new];
+    writer.indentation = nil;
+    writer.lineBreak = nil;
+    [self writeDocument:writer text:@"key"];
+
+    XCTAssertEqualObjects([writer toString], @"<Delete xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\"><Quiet>true</Quiet><Object><Key>key</Key><VersionId></VersionId></Object><Tagging Type=\"key\"></Tagging></Delete>");
+}
+
+- (void)testCharactersOutsideTheBasicMultilingualPlane {
+    AWSXMLDataWriter *writer = [AWSXMLDataWriter new];
+    writer.lineBreak = nil;
+    [writer writeStartElement:@"Value"];
+    // A pair, an unpaired high and low surrogate, and U+FFFE and U+FFFF, which are not allowed in XML.
+    UniChar characters[] = {'a', 0xD83D, 0xDE00, 'b', 0xD800, 'c', 0xDC00, 0xFFFE, 0xFFFF, 'd'};
+    [writer writeCharacters:[NSString stringWithCharacters:characters length:sizeof(characters) / sizeof(UniChar)]];
+    [writer writeEndElement:@"Value"];
+
+    XCTAssertEqualObjects([writer toString], @"<Value>a\U0001F600bcd</Value>");
+
+    // Pairs that straddle the characters escaped at a time are kept.
+    NSMutableString *text = [NSMutableString new];
+    for (NSUInteger i = 0; i < 3000; i++) {
+        [text appendString:i % 3 == 0 ? @"é" : @"\U0001F600"];
+    }
+    writer = [AWSXMLDataWriter new];
+    [writer writeCharacters:text];
+    XCTAssertEqualObjects([writer toData], [text dataUsingEncoding:NSUTF8StringEncoding]);
+}
+
+- (void)testWriteInteger {
+    AWSXMLDataWriter *writer = [AWSXMLDataWriter new];
+    writer.lineBreak = nil;
+    for (NSNumber *number in @[@0, @7, @-42, @10000, @(LLONG_MAX), @(LLONG_MIN)]) {
+        [writer writeStartElement:@"PartNumber"];
+        [writer writeInteger:[number longLongValue]];
+        [writer writeEndElement:@"PartNumber"];
+    }
+
+    XCTAssertEqualObjects([writer toString], @"<PartNumber>0</PartNumber><PartNumber>7</PartNumber><PartNumber>-42</PartNumber><PartNumber>10000</PartNumber><PartNumber>9223372036854775807</PartNumber><PartNumber>-9223372036854775808</PartNumber>");
+}
+
+- (void)testUnbalancedElements {
+    AWSXMLDataWriter *writer = [AWSXMLDataWriter new];
+    XCTAssertThrowsSpecificNamed([writer writeAttribute:@"xmlns" value:@"uri"], NSException, @"XMLWriterException");
+    XCTAssertThrowsSpecificNamed([writer writeEndElement:@"Delete"], NSException, @"XMLWriterException");
+}
+
+#pragma mark - CompleteMultipartUpload
+
+- (NSDictionary *)completeMultipartUploadDefinition {
+    return @{@"operations" : @{@"CompleteMultipartUpload" : @{@"input" : @{@"shape" : @"CompleteMultipartUploadRequest"}}},
+             @"shapes" : @{@"CompleteMultipartUploadRequest" : @{@"type" : @"structure",
+                                                                @"members" : @{@"Bucket" : @{@"shape" : @"BucketName",
+                                                                                             @"location" : @"uri",
+                                                                                             @"locationName" : @"Bucket"},
+                                                                               @"MultipartUpload" : @{@"shape" : @"CompletedMultipartUpload",
+                                                                                                      @"locationName" : @"CompleteMultipartUpload",
+                                                                                                      @"xmlNamespace" : @{@"uri" : AWSXMLDataWriterTestsNamespace}}},
+                                                                @"payload" : @"MultipartUpload"},
+                           @"CompletedMultipartUpload" : @{@"type" : @"structure",
+                                                           @"members" : @{@"Parts" : @{@"shape" : @"CompletedPartList",
+                                                                                       @"locationName" : @"Part"}}},
+                           @"CompletedPartList" : @{@"type" : @"list",
+                                                    @"member" : @{@"shape" : @"CompletedPart"},
+                                                    @"flattened" : @YES},
+                           @"CompletedPart" : @{@"type" : @"structure",
+                                                @"members" : @{@"ETag" : @{@"shape" : @"ETag"},
+                                                               @"PartNumber" : @{@"shape" : @"PartNumber"}}},
+                           @"BucketName" : @{@"type" : @"string"},
+                           @"ETag" : @{@"type" : @"string"},
+                           @"PartNumber" : @{@"type" : @"integer"}}};
+}
+
+- (NSDictionary *)completeMultipartUploadParametersWithPartCount:(NSUInteger)partCount {
+    NSMutableArray *parts = [NSMutableArray arrayWithCapacity:partCount];
+    for (NSUInteger i = 1; i <= partCount; i++) {
+        [parts addObject:@{@"ETag" : [NSString stringWithFormat:@"\"%016lx\"", (unsigned long)i * 2654435761u],
+                           @"PartNumber" : @(i)}];
+    }
+    return @{@"Bucket" : @"bucket",
+             @"MultipartUpload" : @{@"Parts" : parts}};
+}
+
+- (void)writeCompleteMultipartUpload:(id)writer parts:(NSArray<NSDictionary *> *)parts {
+    [writer writeStartElement:@"CompleteMultipartUpload"];
+    [writer writeAttribute:@"xmlns" value:AWSXMLDataWriterTestsNamespace];
+    for (NSDictionary *part in parts) {
+        [writer writeStartElement:@"Part"];
+        [writer writeStartElement:@"ETag"];
+        [writer writeCharacters:part[@"ETag"]];
+        [writer writeEndElement:@"ETag"];
+        [writer writeStartElement:@"PartNumber"];
+        if ([writer isKindOfClass:[AWSXMLDataWriter class]]) {
+            [writer writeInteger:[part[@"PartNumber"] longLongValue]];
+        } else {
+            [writer writeCharacters:[part[@"PartNumber"] stringValue]];
+        }
+        [writer writeEndElement:@"PartNumber"];
+        [writer writeEndElement:@"Part"];
+    }
+    [writer writeEndElement:@"CompleteMultipartUpload"];
+}
+
+- (void)testBuilderCompleteMultipartUpload {
+    NSError *error = nil;
+    NSData *body = [AWSXMLBuilder xmlDataForDictionary:[self completeMultipartUploadParametersWithPartCount:2]
+                                            actionName:@"CompleteMultipartUpload"
+                                 serviceDefinitionRule:[self completeMultipartUploadDefinition]
+                                                 error:&error];
+    XCTAssertNil(error);
+
+    // The members of a structure are written in the order of the dictionary that holds their rules.
+    NSString *format = @"\n<CompleteMultipartUpload xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">%@%@\n</CompleteMultipartUpload>";
+    NSString *first = @"\n\t<Part>\n\t\t<ETag>&quot;000000009e3779b1&quot;</ETag>\n\t\t<PartNumber>1</PartNumber>\n\t</Part>";
+    NSString *firstReversed = @"\n\t<Part>\n\t\t<PartNumber>1</PartNumber>\n\t\t<ETag>&quot;000000009e3779b1&quot;</ETag>\n\t</Part>";
+    NSString *second = @"\n\t<Part>\n\t\t<ETag>&quot;000000013c6ef362&quot;</ETag>\n\t\t<PartNumber>2</PartNumber>\n\t</Part>";
+    NSString *secondReversed = @"\n\t<Part>\n\t\t<PartNumber>2</PartNumber>\n\t\t<ETag>&quot;000000013c6ef362&quot;</ETag>\n\t</Part>";
+    NSString *bodyString = [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding];
+    XCTAssertTrue([bodyString isEqualToString:[NSString stringWithFormat:format, first, second]]
+                  || [bodyString isEqualToString:[NSString stringWithFormat:format, firstReversed, secondReversed]], @"%@", bodyString);
+}
+
+- (void)testCompleteMultipartUploadBenchmark {
+    NSUInteger const partCount = 10000;
+    NSDictionary *parameters = [self completeMultipartUploadParametersWithPartCount:partCount];
+    NSArray *parts = parameters[@"MultipartUpload"][@"Parts"];
+    NSDictionary *definition = [self completeMultipartUploadDefinition];
+
+    for (NSUInteger run = 0; run < 3; run++) {
+        malloc_statistics_t before;
+        malloc_statistics_t after;
+        NSData *xmlWriterBody = nil;
+        NSData *dataWriterBody = nil;
+
+        CFAbsoluteTime xmlWriterTime;
+        double xmlWriterBytes;
+        @autoreleasepool {
+            malloc_zone_statistics(NULL, &before);
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            AWSXMLWriter *writer = [AWSXMLWriter new];
+            [self writeCompleteMultipartUpload:writer parts:parts];
+            xmlWriterBody = [writer toData];
+            xmlWriterTime = CFAbsoluteTimeGetCurrent() - start;
+            malloc_zone_statistics(NULL, &after);
+            xmlWriterBytes = (double)after.size_in_use - (double)before.size_in_use;
+        }
+
+        CFAbsoluteTime dataWriterTime;
+        double dataWriterBytes;
+        @autoreleasepool {
+            malloc_zone_statistics(NULL, &before);
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            AWSXMLDataWriter *writer = [AWSXMLDataWriter new];
+            [self writeCompleteMultipartUpload:writer parts:parts];
+            dataWriterBody = [writer toData];
+            dataWriterTime = CFAbsoluteTimeGetCurrent() - start;
+            malloc_zone_statistics(NULL, &after);
+            dataWriterBytes = (double)after.size_in_use - (double)before.size_in_use;
+        }
+        XCTAssertEqualObjects(dataWriterBody, xmlWriterBody);
+
+        CFAbsoluteTime builderTime;
+        @autoreleasepool {
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            NSData *body = [AWSXMLBuilder xmlDataForDictionary:parameters
+                                                    actionName:@"CompleteMultipartUpload"
+                                         serviceDefinitionRule:definition
+                                                         error:nil];
+            builderTime = CFAbsoluteTimeGetCurrent() - start;
+            XCTAssertEqual([body length], [dataWriterBody length]);
+        }
+
+        NSLog(@"CompleteMultipartUpload with %lu parts, %.0fKB: AWSXMLWriter %.1fms, %.1fMB in use; AWSXMLDataWriter %.1fms, %.1fMB in use; AWSXMLBuilder %.1fms",
+              (unsigned long)partCount, [dataWriterBody length] / 1024.0,
+              xmlWriterTime * 1000, xmlWriterBytes / (1024.0 * 1024.0),
+              dataWriterTime * 1000, dataWriterBytes / (1024.0 * 1024.0),
+              builderTime * 1000);
+    }
+}
+
+@end
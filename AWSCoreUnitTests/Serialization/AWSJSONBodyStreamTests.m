@@ -0,0 +1,391 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <CommonCrypto/CommonCrypto.h>
+#import <mach/mach.h>
+#import "AWSCore.h"
+#import "AWSSerialization.h"
+#import "AWSURLRequestSerialization.h"
+
+static NSString *const AWSJSONBodyStreamTestsActionName = @"PutRecords";
+
+// Reads the body of every request, and responds with it.
+@interface AWSJSONBodyStreamTestsURLProtocol : NSURLProtocol
+
+@end
+
+@implementation AWSJSONBodyStreamTestsURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    return YES;
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    return request;
+}
+
+- (void)startLoading {
+    NSInputStream *bodyStream = self.request.HTTPBodyStream;
+    NSMutableData *body = [NSMutableData new];
+    uint8_t buffer[4096];
+    [bodyStream open];
+    NSInteger read;
+    while ((read = [bodyStream read:buffer maxLength:sizeof(buffer)]) > 0) {
+        [body appendBytes:buffer length:read];
+    }
+    [bodyStream close];
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                              statusCode:200
+                                                             HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{}];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    [self.client URLProtocol:self didLoadData:body];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading {
+}
+
+@end
+
+@interface AWSJSONBodyStreamTests : XCTestCase
+
+@end
+
+@implementation AWSJSONBodyStreamTests
+
+- (NSDictionary *)serviceDefinition {
+    return @{
+        @"operations" : @{
+                AWSJSONBodyStreamTestsActionName : @{
+                        @"http" : @{@"method" : @"POST", @"requestUri" : @"/"},
+                        @"input" : @{@"shape" : @"PutRecordsInput"},
+                },
+        },
+        @"shapes" : @{
+                @"PutRecordsInput" : @{
+                        @"type" : @"structure",
+                        @"members" : @{
+                                @"Records" : @{@"shape" : @"RecordList"},
+                                @"StreamName" : @{@"shape" : @"String"},
+                        },
+                },
+                @"RecordList" : @{
+                        @"type" : @"list",
+                        @"member" : @{@"shape" : @"Record"},
+                },
+                @"Record" : @{
+                        @"type" : @"structure",
+                        @"members" : @{
+                                @"Data" : @{@"shape" : @"Data"},
+                                @"PartitionKey" : @{@"shape" : @"String"},
+                        },
+                },
+                @"Data" : @{@"type" : @"blob"},
+                @"String" : @{@"type" : @"string"},
+        },
+    };
+}
+
+- (NSData *)randomDataOfLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    arc4random_buf([data mutableBytes], length);
+    return data;
+}
+
+- (NSDictionary *)parametersWithBlobs:(NSArray<NSData *> *)blobs {
+    NSMutableArray *records = [NSMutableArray new];
+    for (NSData *blob in blobs) {
+        [records addObject:@{@"Data" : blob, @"PartitionKey" : [NSString stringWithFormat:@"key-%lu", (unsigned long)[records count]]}];
+    }
+    return @{@"StreamName" : @"stream", @"Records" : records};
+}
+
+- (NSData *)readStream:(NSInputStream *)stream bufferSize:(NSUInteger)bufferSize {
+    NSMutableData *data = [NSMutableData new];
+    uint8_t *buffer = malloc(bufferSize);
+    [stream open];
+    NSInteger read;
+    while ((read = [stream read:buffer maxLength:bufferSize]) > 0) {
+        [data appendBytes:buffer length:read];
+    }
+    [stream close];
+    free(buffer);
+    return data;
+}
+
+- (NSData *)sha256:(NSData *)data {
+    NSMutableData *digest = [NSMutableData dataWithLength:CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256([data bytes], (CC_LONG)[data length], [digest mutableBytes]);
+    return digest;
+}
+
+- (uint64_t)physicalFootprint {
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.phys_footprint;
+}
+
+- (void)testStreamedBodyMatchesJSONData {
+    NSArray *blobs = @[[self randomDataOfLength:AWSJSONBuilderStreamingBlobThreshold + 1],
+                       [self randomDataOfLength:16],
+                       [self randomDataOfLength:AWSJSONBuilderStreamingBlobThreshold * 3 + 2]];
+    NSDictionary *parameters = [self parametersWithBlobs:blobs];
+
+    NSError *error = nil;
+    NSData *expectedData = [AWSJSONBuilder jsonDataForDictionary:parameters
+                                                      actionName:AWSJSONBodyStreamTestsActionName
+                                           serviceDefinitionRule:[self serviceDefinition]
+                                                           error:&error];
+    XCTAssertNil(error);
+
+    AWSJSONBodyStream *bodyStream = nil;
+    NSData *data = [AWSJSONBuilder jsonDataForDictionary:parameters
+                                              actionName:AWSJSONBodyStreamTestsActionName
+                                   serviceDefinitionRule:[self serviceDefinition]
+                                              bodyStream:&bodyStream
+                                                   error:&error];
+    XCTAssertNil(error);
+    XCTAssertNil(data);
+    XCTAssertNotNil(bodyStream);
+    XCTAssertEqual(bodyStream.contentLength, (unsigned long long)[expectedData length]);
+    XCTAssertEqualObjects(bodyStream.contentSHA256, [self sha256:expectedData]);
+
+    // Buffers smaller than a base64 group, and not a multiple of it.
+    for (NSNumber *bufferSize in @[@1, @3, @7, @4096, @65537]) {
+        NSData *streamedData = [self readStream:[bodyStream copy] bufferSize:[bufferSize unsignedIntegerValue]];
+        XCTAssertEqualObjects(streamedData, expectedData, @"Buffer size %@", bufferSize);
+    }
+
+    NSDictionary *JSONObject = [NSJSONSerialization JSONObjectWithData:[self readStream:bodyStream bufferSize:1024] options:0 error:nil];
+    XCTAssertEqualObjects([[NSData alloc] initWithBase64EncodedString:JSONObject[@"Records"][2][@"Data"] options:0], blobs[2]);
+}
+
+- (void)testSmallBlobsAreNotStreamed {
+    NSDictionary *parameters = [self parametersWithBlobs:@[[self randomDataOfLength:AWSJSONBuilderStreamingBlobThreshold - 1]]];
+
+    NSError *error = nil;
+    AWSJSONBodyStream *bodyStream = nil;
+    NSData *data = [AWSJSONBuilder jsonDataForDictionary:parameters
+                                              actionName:AWSJSONBodyStreamTestsActionName
+                                   serviceDefinitionRule:[self serviceDefinition]
+                                              bodyStream:&bodyStream
+                                                   error:&error];
+    XCTAssertNil(error);
+    XCTAssertNil(bodyStream);
+    XCTAssertEqualObjects(data, [AWSJSONBuilder jsonDataForDictionary:parameters
+                                                           actionName:AWSJSONBodyStreamTestsActionName
+                                                serviceDefinitionRule:[self serviceDefinition]
+                                                                error:nil]);
+}
+
+- (void)testStreamStatus {
+    NSDictionary *parameters = [self parametersWithBlobs:@[[self randomDataOfLength:AWSJSONBuilderStreamingBlobThreshold]]];
+    AWSJSONBodyStream *bodyStream = nil;
+    [AWSJSONBuilder jsonDataForDictionary:parameters
+                               actionName:AWSJSONBodyStreamTestsActionName
+                    serviceDefinitionRule:[self serviceDefinition]
+                               bodyStream:&bodyStream
+                                    error:nil];
+
+    uint8_t buffer[1024];
+    XCTAssertEqual([bodyStream streamStatus], NSStreamStatusNotOpen);
+    XCTAssertEqual([bodyStream read:buffer maxLength:sizeof(buffer)], -1);
+
+    [bodyStream open];
+    XCTAssertEqual([bodyStream streamStatus], NSStreamStatusOpen);
+
+    unsigned long long length = 0;
+    NSInteger read;
+    while ((read = [bodyStream read:buffer maxLength:sizeof(buffer)]) > 0) {
+        length += read;
+    }
+    XCTAssertEqual(read, 0);
+    XCTAssertEqual(length, bodyStream.contentLength);
+    XCTAssertEqual([bodyStream streamStatus], NSStreamStatusAtEnd);
+    XCTAssertFalse([bodyStream hasBytesAvailable]);
+
+    [bodyStream close];
+    XCTAssertEqual([bodyStream streamStatus], NSStreamStatusClosed);
+}
+
+- (void)testSerializerStreamsLargeBlobs {
+    NSData *blob = [self randomDataOfLength:AWSJSONBuilderStreamingBlobThreshold * 2];
+    NSDictionary *parameters = [self parametersWithBlobs:@[blob]];
+    AWSJSONRequestSerializer *serializer = [[AWSJSONRequestSerializer alloc] initWithJSONDefinition:[self serviceDefinition]
+                                                                                         actionName:AWSJSONBodyStreamTestsActionName];
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://kinesis.us-east-1.amazonaws.com"]];
+    request.HTTPMethod = @"POST";
+    AWSTask *task = [serializer serializeRequest:request headers:@{} parameters:parameters];
+    XCTAssertNil(task.error);
+    XCTAssertNil(request.HTTPBody);
+    XCTAssertTrue([request.HTTPBodyStream isKindOfClass:[AWSJSONBodyStream class]]);
+
+    NSData *expectedData = [AWSJSONBuilder jsonDataForDictionary:parameters
+                                                      actionName:AWSJSONBodyStreamTestsActionName
+                                           serviceDefinitionRule:[self serviceDefinition]
+                                                           error:nil];
+    XCTAssertEqualObjects([request valueForHTTPHeaderField:@"Content-Length"], ([NSString stringWithFormat:@"%lu", (unsigned long)[expectedData length]]));
+    XCTAssertEqualObjects([self readStream:request.HTTPBodyStream bufferSize:32 * 1024], expectedData);
+
+    // A gzipped body is built in memory.
+    NSMutableURLRequest *gzipRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://kinesis.us-east-1.amazonaws.com"]];
+    gzipRequest.HTTPMethod = @"POST";
+    task = [serializer serializeRequest:gzipRequest headers:@{@"Content-Encoding" : @"gzip"} parameters:parameters];
+    XCTAssertNil(task.error);
+    XCTAssertNil(gzipRequest.HTTPBodyStream);
+    XCTAssertNotNil(gzipRequest.HTTPBody);
+}
+
+- (void)testBodyIsUploadedThroughURLSession {
+    NSDictionary *parameters = [self parametersWithBlobs:@[[self randomDataOfLength:AWSJSONBuilderStreamingBlobThreshold * 2 + 1],
+                                                           [self randomDataOfLength:AWSJSONBuilderStreamingBlobThreshold]]];
+    AWSJSONRequestSerializer *serializer = [[AWSJSONRequestSerializer alloc] initWithJSONDefinition:[self serviceDefinition]
+                                                                                         actionName:AWSJSONBodyStreamTestsActionName];
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://kinesis.us-east-1.amazonaws.com"]];
+    request.HTTPMethod = @"POST";
+    XCTAssertNil([serializer serializeRequest:request headers:@{} parameters:parameters].error);
+    XCTAssertTrue([request.HTTPBodyStream isKindOfClass:[AWSJSONBodyStream class]]);
+
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    configuration.protocolClasses = @[[AWSJSONBodyStreamTestsURLProtocol class]];
+    NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"The body is uploaded."];
+    __block NSData *receivedData = nil;
+    __block NSError *receivedError = nil;
+    [[session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        receivedData = data;
+        receivedError = error;
+        [expectation fulfill];
+    }] resume];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    [session finishTasksAndInvalidate];
+
+    XCTAssertNil(receivedError);
+    XCTAssertEqualObjects(receivedData, [AWSJSONBuilder jsonDataForDictionary:parameters
+                                                                   actionName:AWSJSONBodyStreamTestsActionName
+                                                        serviceDefinitionRule:[self serviceDefinition]
+                                                                        error:nil]);
+}
+
+- (void)testSignatureOfStreamedBody {
+    NSDictionary *parameters = [self parametersWithBlobs:@[[self randomDataOfLength:AWSJSONBuilderStreamingBlobThreshold * 2]]];
+    AWSJSONBodyStream *bodyStream = nil;
+    [AWSJSONBuilder jsonDataForDictionary:parameters
+                               actionName:AWSJSONBodyStreamTestsActionName
+                    serviceDefinitionRule:[self serviceDefinition]
+                               bodyStream:&bodyStream
+                                    error:nil];
+    NSData *bodyData = [AWSJSONBuilder jsonDataForDictionary:parameters
+                                                  actionName:AWSJSONBodyStreamTestsActionName
+                                       serviceDefinitionRule:[self serviceDefinition]
+                                                       error:nil];
+
+    AWSStaticCredentialsProvider *credentialsProvider = [[AWSStaticCredentialsProvider alloc] initWithAccessKey:@"AKIDEXAMPLE"
+                                                                                                      secretKey:@"wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"];
+    AWSEndpoint *endpoint = [[AWSEndpoint alloc] initWithRegion:AWSRegionUSEast1
+                                                        service:AWSServiceKinesis
+                                                   useUnsafeURL:NO];
+    AWSSignatureV4Signer *signer = [[AWSSignatureV4Signer alloc] initWithCredentialsProvider:credentialsProvider
+                                                                                    endpoint:endpoint];
+
+    NSMutableURLRequest *dataRequest = [NSMutableURLRequest requestWithURL:endpoint.URL];
+    dataRequest.HTTPMethod = @"POST";
+    [dataRequest setValue:@"20210101T000000Z" forHTTPHeaderField:@"X-Amz-Date"];
+    NSMutableURLRequest *streamRequest = [dataRequest mutableCopy];
+    dataRequest.HTTPBody = bodyData;
+    streamRequest.HTTPBodyStream = bodyStream;
+
+    AWSTask *dataTask = [signer interceptRequest:dataRequest];
+    [dataTask waitUntilFinished];
+    XCTAssertNil(dataTask.error);
+    AWSTask *streamTask = [signer interceptRequest:streamRequest];
+    [streamTask waitUntilFinished];
+    XCTAssertNil(streamTask.error);
+    XCTAssertNotNil([streamRequest valueForHTTPHeaderField:@"Authorization"]);
+    XCTAssertEqualObjects([streamRequest valueForHTTPHeaderField:@"Authorization"], [dataRequest valueForHTTPHeaderField:@"Authorization"]);
+}
+
+- (void)testStreamingMemoryBenchmark {
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+
+    for (NSNumber *megabytes in @[@5, @20, @50]) {
+        @autoreleasepool {
+            NSUInteger length = [megabytes unsignedIntegerValue] * 1024 * 1024;
+            XCTAssertTrue([[self randomDataOfLength:length] writeToFile:filePath atomically:NO]);
+            NSData *blob = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedIfSafe error:nil];
+            NSDictionary *parameters = [self parametersWithBlobs:@[blob]];
+
+            uint64_t baseline = [self physicalFootprint];
+            uint64_t peak = baseline;
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+
+            AWSJSONBodyStream *bodyStream = nil;
+            [AWSJSONBuilder jsonDataForDictionary:parameters
+                                       actionName:AWSJSONBodyStreamTestsActionName
+                            serviceDefinitionRule:[self serviceDefinition]
+                                       bodyStream:&bodyStream
+                                            error:nil];
+            XCTAssertNotNil(bodyStream.contentSHA256);
+
+            uint8_t buffer[32 * 1024];
+            unsigned long long total = 0;
+            [bodyStream open];
+            NSInteger read;
+            while ((read = [bodyStream read:buffer maxLength:sizeof(buffer)]) > 0) {
+                total += read;
+                if (total % (1024 * 1024) < sizeof(buffer)) {
+                    peak = MAX(peak, [self physicalFootprint]);
+                }
+            }
+            [bodyStream close];
+            CFAbsoluteTime streamTime = CFAbsoluteTimeGetCurrent() - start;
+            uint64_t streamPeak = peak - baseline;
+            XCTAssertEqual(total, bodyStream.contentLength);
+
+            baseline = [self physicalFootprint];
+            start = CFAbsoluteTimeGetCurrent();
+            NSData *bodyData = [AWSJSONBuilder jsonDataForDictionary:parameters
+                                                          actionName:AWSJSONBodyStreamTestsActionName
+                                               serviceDefinitionRule:[self serviceDefinition]
+                                                               error:nil];
+            CC_SHA256([bodyData bytes], (CC_LONG)[bodyData length], buffer);
+            CFAbsoluteTime dataTime = CFAbsoluteTimeGetCurrent() - start;
+            uint64_t dataPeak = [self physicalFootprint] - baseline;
+            XCTAssertEqual((unsigned long long)[bodyData length], bodyStream.contentLength);
+
+            // The mapped blob pages are counted while they are read, but the base64 body is never held in memory.
+            XCTAssertLessThan(streamPeak, dataPeak);
+
+            NSLog(@"%@MB blob: streamed and hashed in %.0f ms with %.1fMB peak footprint growth, built in memory in %.0f ms with %.1fMB",
+                  megabytes,
+                  streamTime * 1000,
+                  streamPeak / (1024.0 * 1024.0),
+                  dataTime * 1000,
+                  dataPeak / (1024.0 * 1024.0));
+        }
+    }
+
+    [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+}
+
+@end
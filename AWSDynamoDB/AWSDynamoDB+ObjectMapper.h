@@ -0,0 +1,42 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSDynamoDBService.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The operations `AWSDynamoDBObjectMapper` reads items with. Each sends the same request as the `AWSDynamoDB` method of the
+ same name, but parses the response into `outputClass`, a subclass of the operation's output that keeps the items as
+ DynamoDB JSON.
+ */
+@interface AWSDynamoDB (ObjectMapper)
+
+- (AWSTask<AWSDynamoDBGetItemOutput *> *)aws_getItem:(AWSDynamoDBGetItemInput *)request
+                                         outputClass:(Class)outputClass;
+
+- (AWSTask<AWSDynamoDBQueryOutput *> *)aws_query:(AWSDynamoDBQueryInput *)request
+                                     outputClass:(Class)outputClass;
+
+- (AWSTask<AWSDynamoDBScanOutput *> *)aws_scan:(AWSDynamoDBScanInput *)request
+                                   outputClass:(Class)outputClass;
+
+- (AWSTask<AWSDynamoDBBatchGetItemOutput *> *)aws_batchGetItem:(AWSDynamoDBBatchGetItemInput *)request
+                                                   outputClass:(Class)outputClass;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,61 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSDynamoDBService.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface AWSDynamoDB (Paginators)
+
+/**
+ Returns a paginator over the items of the Query operation. The `lastEvaluatedKey` of each page is passed as the `exclusiveStartKey` of the next, and the next page is fetched while the current one is processed.
+
+ @param request A container for the necessary parameters to execute the Query service method.
+
+ @return A paginator over the `items` of the pages.
+
+ @see AWSDynamoDBQueryInput
+ @see AWSPaginator
+ */
+- (AWSPaginator<NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *> *)queryPaginator:(AWSDynamoDBQueryInput *)request;
+
+/**
+ Returns a paginator over the items of the Scan operation. The `lastEvaluatedKey` of each page is passed as the `exclusiveStartKey` of the next, and the next page is fetched while the current one is processed.
+
+ @param request A container for the necessary parameters to execute the Scan service method.
+
+ @return A paginator over the `items` of the pages.
+
+ @see AWSDynamoDBScanInput
+ @see AWSPaginator
+ */
+- (AWSPaginator<NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *> *)scanPaginator:(AWSDynamoDBScanInput *)request;
+
+/**
+ Returns a paginator over the table names of the ListTables operation. The `lastEvaluatedTableName` of each page is passed as the `exclusiveStartTableName` of the next, and the next page is fetched while the current one is processed.
+
+ @param request A container for the necessary parameters to execute the ListTables service method.
+
+ @return A paginator over the `tableNames` of the pages.
+
+ @see AWSDynamoDBListTablesInput
+ @see AWSPaginator
+ */
+- (AWSPaginator<NSString *> *)listTablesPaginator:(AWSDynamoDBListTablesInput *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,50 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSDynamoDB+Paginators.h"
+
+@implementation AWSDynamoDB (Paginators)
+
+- (AWSPaginator *)queryPaginator:(AWSDynamoDBQueryInput *)request {
+    return [AWSPaginator paginatorWithRequest:request
+                                inputTokenKey:@"exclusiveStartKey"
+                               outputTokenKey:@"lastEvaluatedKey"
+                                    resultKey:@"items"
+                                    operation:^AWSTask *(AWSDynamoDBQueryInput *pageRequest) {
+        return [self query:pageRequest];
+    }];
+}
+
+- (AWSPaginator *)scanPaginator:(AWSDynamoDBScanInput *)request {
+    return [AWSPaginator paginatorWithRequest:request
+                                inputTokenKey:@"exclusiveStartKey"
+                               outputTokenKey:@"lastEvaluatedKey"
+                                    resultKey:@"items"
+                                    operation:^AWSTask *(AWSDynamoDBScanInput *pageRequest) {
+        return [self scan:pageRequest];
+    }];
+}
+
+- (AWSPaginator *)listTablesPaginator:(AWSDynamoDBListTablesInput *)request {
+    return [AWSPaginator paginatorWithRequest:request
+                                inputTokenKey:@"exclusiveStartTableName"
+                               outputTokenKey:@"lastEvaluatedTableName"
+                                    resultKey:@"tableNames"
+                                    operation:^AWSTask *(AWSDynamoDBListTablesInput *pageRequest) {
+        return [self listTables:pageRequest];
+    }];
+}
+
+@end
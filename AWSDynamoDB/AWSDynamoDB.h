@@ -40,4 +40,6 @@ FOUNDATION_EXPORT const unsigned char AWSDynamoDBVersionString[] DEPRECATED_MSG_
 
 #import <AWSCore/AWSCore.h>
 #import "AWSDynamoDBService.h"
+#import "AWSDynamoDB+Paginators.h"
 #import "AWSDynamoDBObjectMapper.h"
+#import "AWSDynamoDBItemCache.h"
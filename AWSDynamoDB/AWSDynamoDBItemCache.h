@@ -0,0 +1,114 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The default value of `maximumBytes`, 4MB.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSDynamoDBItemCacheDefaultMaximumBytes;
+
+/**
+ The default value of `defaultTimeToLive`, 60 seconds.
+ */
+FOUNDATION_EXPORT NSTimeInterval const AWSDynamoDBItemCacheDefaultTimeToLive;
+
+/**
+ An in-memory cache of the items read by `- load:hashKey:rangeKey:` of `AWSDynamoDBObjectMapper`.
+
+ Set it as the `itemCache` of an `AWSDynamoDBObjectMapperConfiguration` to turn it on. Items are cached by table and
+ primary key as they were returned by Amazon DynamoDB, and every hit returns a new object. When the total size of the
+ cached items exceeds `maximumBytes`, the least recently used items are evicted. An item expires after the time to
+ live of its table.
+
+ `save:` and `remove:` through the same object mapper invalidate the item they write. Writes made any other way, by
+ other clients or through other object mappers, are only seen once the cached item expires, so choose the time to live
+ of a table according to how stale its items may be. Loads with `consistentRead` set to `@YES` bypass the cache.
+ */
+@interface AWSDynamoDBItemCache : NSObject
+
+/**
+ The maximum total size of the cached items, in bytes. Sizes are estimated the way Amazon DynamoDB measures item size.
+ */
+@property (nonatomic, assign, readonly) NSUInteger maximumBytes;
+
+/**
+ The time to live of items of tables without their own time to live. The default value is `AWSDynamoDBItemCacheDefaultTimeToLive`.
+ */
+@property (atomic, assign) NSTimeInterval defaultTimeToLive;
+
+/**
+ When set to `YES`, keys without an item are cached too, so loading a missing item again does not make a request. The default value is `YES`.
+ */
+@property (atomic, assign) BOOL cachesMissingItems;
+
+/**
+ The number of loads answered from the cache, including loads of cached missing items.
+ */
+@property (atomic, assign, readonly) NSUInteger hitCount;
+
+/**
+ The number of loads not answered from the cache, including loads of expired items.
+ */
+@property (atomic, assign, readonly) NSUInteger missCount;
+
+/**
+ The number of items evicted to stay within `maximumBytes`.
+ */
+@property (atomic, assign, readonly) NSUInteger evictionCount;
+
+/**
+ The number of cached items.
+ */
+@property (atomic, assign, readonly) NSUInteger count;
+
+/**
+ The total size of the cached items, in bytes.
+ */
+@property (atomic, assign, readonly) NSUInteger totalBytes;
+
+/**
+ Creates a cache of `AWSDynamoDBItemCacheDefaultMaximumBytes`.
+ */
+- (instancetype)init;
+
+/**
+ Creates a cache.
+
+ @param maximumBytes The maximum total size of the cached items, in bytes.
+
+ @return A cache.
+ */
+- (instancetype)initWithMaximumBytes:(NSUInteger)maximumBytes NS_DESIGNATED_INITIALIZER;
+
+/**
+ Sets the time to live of the items of a table.
+
+ @param timeToLive The time to live, in seconds. `0` disables caching for the table.
+ @param tableName  The table name.
+ */
+- (void)setTimeToLive:(NSTimeInterval)timeToLive
+         forTableName:(NSString *)tableName;
+
+/**
+ Removes all of the cached items. The counters are not reset.
+ */
+- (void)removeAllItems;
+
+@end
+
+NS_ASSUME_NONNULL_END
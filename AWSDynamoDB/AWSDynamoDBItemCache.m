@@ -0,0 +1,263 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSDynamoDBItemCache.h"
+
+NSUInteger const AWSDynamoDBItemCacheDefaultMaximumBytes = 4 * 1024 * 1024;
+NSTimeInterval const AWSDynamoDBItemCacheDefaultTimeToLive = 60;
+
+@interface AWSDynamoDBItemCacheEntry : NSObject
+
+@property (nonatomic, strong) NSString *key;
+// `nil` for a key without an item.
+@property (nonatomic, strong) NSDictionary *item;
+@property (nonatomic, assign) NSUInteger bytes;
+@property (nonatomic, assign) NSTimeInterval expirationTime;
+
+// The recency list, from the most to the least recently used entry.
+@property (nonatomic, weak) AWSDynamoDBItemCacheEntry *previous;
+@property (nonatomic, strong) AWSDynamoDBItemCacheEntry *next;
+
+@end
+
+@implementation AWSDynamoDBItemCacheEntry
+
+@end
+
+@interface AWSDynamoDBItemCache()
+
+@property (atomic, assign, readwrite) NSUInteger hitCount;
+@property (atomic, assign, readwrite) NSUInteger missCount;
+@property (atomic, assign, readwrite) NSUInteger evictionCount;
+
+// The state below is guarded by @synchronized(self).
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSDynamoDBItemCacheEntry *> *entries;
+@property (nonatomic, strong) AWSDynamoDBItemCacheEntry *head;
+@property (nonatomic, weak) AWSDynamoDBItemCacheEntry *tail;
+@property (nonatomic, assign) NSUInteger bytes;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *timeToLiveByTableName;
+// Incremented by every invalidation, so that a load that started before a write does not cache what it read.
+@property (nonatomic, assign) NSUInteger generation;
+
+@end
+
+@implementation AWSDynamoDBItemCache
+
+- (instancetype)init {
+    return [self initWithMaximumBytes:AWSDynamoDBItemCacheDefaultMaximumBytes];
+}
+
+- (instancetype)initWithMaximumBytes:(NSUInteger)maximumBytes {
+    if (self = [super init]) {
+        _maximumBytes = maximumBytes;
+        _defaultTimeToLive = AWSDynamoDBItemCacheDefaultTimeToLive;
+        _cachesMissingItems = YES;
+        _entries = [NSMutableDictionary new];
+        _timeToLiveByTableName = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    @synchronized(self) {
+        return [self.entries count];
+    }
+}
+
+- (NSUInteger)totalBytes {
+    @synchronized(self) {
+        return self.bytes;
+    }
+}
+
+- (void)setTimeToLive:(NSTimeInterval)timeToLive
+         forTableName:(NSString *)tableName {
+    @synchronized(self) {
+        self.timeToLiveByTableName[tableName] = @(timeToLive);
+    }
+}
+
+- (void)removeAllItems {
+    @synchronized(self) {
+        self.generation++;
+        // Unlinks the entries one by one, as releasing the head would release the list recursively.
+        while (self.head) {
+            [self removeEntry:self.head];
+        }
+    }
+}
+
+#pragma mark - Object mapper
+
+- (NSUInteger)currentGeneration {
+    @synchronized(self) {
+        return self.generation;
+    }
+}
+
+- (BOOL)cachedItem:(NSDictionary **)item
+            forKey:(NSString *)key {
+    @synchronized(self) {
+        AWSDynamoDBItemCacheEntry *entry = self.entries[key];
+        if (entry && entry.expirationTime <= [NSDate timeIntervalSinceReferenceDate]) {
+            [self removeEntry:entry];
+            entry = nil;
+        }
+        if (!entry) {
+            self.missCount++;
+            return NO;
+        }
+
+        [self unlinkEntry:entry];
+        [self linkEntryAtHead:entry];
+        self.hitCount++;
+        *item = entry.item;
+        return YES;
+    }
+}
+
+- (void)setItem:(NSDictionary *)item
+         forKey:(NSString *)key
+      tableName:(NSString *)tableName
+     generation:(NSUInteger)generation {
+    @synchronized(self) {
+        if (generation != self.generation || (!item && !self.cachesMissingItems)) {
+            return;
+        }
+        NSNumber *tableTimeToLive = self.timeToLiveByTableName[tableName];
+        NSTimeInterval timeToLive = tableTimeToLive ? [tableTimeToLive doubleValue] : self.defaultTimeToLive;
+        if (timeToLive <= 0) {
+            return;
+        }
+
+        AWSDynamoDBItemCacheEntry *entry = [AWSDynamoDBItemCacheEntry new];
+        entry.key = key;
+        entry.item = item;
+        entry.bytes = [key lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + [[self class] sizeOfItem:item];
+        entry.expirationTime = [NSDate timeIntervalSinceReferenceDate] + timeToLive;
+        if (entry.bytes > self.maximumBytes) {
+            return;
+        }
+
+        AWSDynamoDBItemCacheEntry *existingEntry = self.entries[key];
+        if (existingEntry) {
+            [self removeEntry:existingEntry];
+        }
+        self.entries[key] = entry;
+        [self linkEntryAtHead:entry];
+        self.bytes += entry.bytes;
+
+        while (self.bytes > self.maximumBytes && self.tail) {
+            [self removeEntry:self.tail];
+            self.evictionCount++;
+        }
+    }
+}
+
+- (void)removeItemForKey:(NSString *)key {
+    @synchronized(self) {
+        self.generation++;
+        AWSDynamoDBItemCacheEntry *entry = self.entries[key];
+        if (entry) {
+            [self removeEntry:entry];
+        }
+    }
+}
+
+#pragma mark - Recency list
+
+- (void)linkEntryAtHead:(AWSDynamoDBItemCacheEntry *)entry {
+    entry.previous = nil;
+    entry.next = self.head;
+    self.head.previous = entry;
+    self.head = entry;
+    if (!self.tail) {
+        self.tail = entry;
+    }
+}
+
+- (void)unlinkEntry:(AWSDynamoDBItemCacheEntry *)entry {
+    AWSDynamoDBItemCacheEntry *previous = entry.previous;
+    AWSDynamoDBItemCacheEntry *next = entry.next;
+    if (previous) {
+        previous.next = next;
+    } else {
+        self.head = next;
+    }
+    if (next) {
+        next.previous = previous;
+    } else {
+        self.tail = previous;
+    }
+    entry.previous = nil;
+    entry.next = nil;
+}
+
+- (void)removeEntry:(AWSDynamoDBItemCacheEntry *)entry {
+    [self unlinkEntry:entry];
+    [self.entries removeObjectForKey:entry.key];
+    self.bytes -= entry.bytes;
+}
+
+#pragma mark - Item size
+
+// Follows the item size rules of Amazon DynamoDB: attribute names and values count their UTF-8 bytes, numbers about
+// one byte per two digits, and lists and maps 3 bytes plus 1 byte per element.
++ (NSUInteger)sizeOfItem:(NSDictionary<NSString *, NSDictionary *> *)item {
+    NSUInteger size = 0;
+    for (NSString *attributeName in item) {
+        size += [attributeName lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + [self sizeOfAttributeValue:item[attributeName]];
+    }
+    return size;
+}
+
++ (NSUInteger)sizeOfAttributeValue:(NSDictionary *)attributeValue {
+    NSUInteger size = 0;
+    for (NSString *type in attributeValue) {
+        id value = attributeValue[type];
+        if ([type isEqualToString:@"L"] && [value isKindOfClass:[NSArray class]]) {
+            size += 3;
+            for (NSDictionary *listItem in value) {
+                size += 1 + [self sizeOfAttributeValue:listItem];
+            }
+        } else if ([type isEqualToString:@"M"] && [value isKindOfClass:[NSDictionary class]]) {
+            size += 3;
+            for (NSString *mapItemKey in value) {
+                size += 1 + [mapItemKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + [self sizeOfAttributeValue:value[mapItemKey]];
+            }
+        } else if ([value isKindOfClass:[NSArray class]]) {
+            for (id setItem in value) {
+                size += [self sizeOfScalar:setItem type:type];
+            }
+        } else {
+            size += [self sizeOfScalar:value type:type];
+        }
+    }
+    return size;
+}
+
++ (NSUInteger)sizeOfScalar:(id)value
+                      type:(NSString *)type {
+    if ([value isKindOfClass:[NSData class]]) {
+        return [(NSData *)value length];
+    }
+    if ([value isKindOfClass:[NSString class]]) {
+        NSUInteger length = [value lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        return [type hasPrefix:@"N"] ? length / 2 + 1 : length;
+    }
+    return 1;
+}
+
+@end
@@ -15,6 +15,7 @@
 
 #import <Foundation/Foundation.h>
 #import "AWSDynamoDBService.h"
+#import "AWSDynamoDBItemCache.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -68,6 +69,11 @@ typedef NS_ENUM(NSInteger, AWSDynamoDBObjectMapperSaveBehavior) {
 @class AWSDynamoDBScanExpression;
 @class AWSDynamoDBPaginatedOutput;
 
+/**
+ The maximum number of `BatchGetItem` or `BatchWriteItem` calls a `batchLoad:` or `batchSave:` call has in flight, 4.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSDynamoDBObjectMapperBatchMaxConcurrentRequests;
+
 /**
  A DynamoDB Modeling protocol. All objects mapped to an Amazon DynamoDB table row need to conform to this protocol.
  */
@@ -526,6 +532,114 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
 configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
 completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable response, NSError * _Nullable error))completionHandler;
 
+/**
+ Returns a paginator over the objects matching a query, using the default configuration. The next page is fetched while the current one is processed.
+
+ @param resultClass The class of the result object.
+ @param expression  An expression object. It is read once, when the first page is fetched.
+
+ @return A paginator over the model objects.
+ */
+- (AWSPaginator<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)queryPaginator:(Class)resultClass
+                                                                              expression:(AWSDynamoDBQueryExpression *)expression;
+
+/**
+ Returns a paginator over the objects matching a query. The next page is fetched while the current one is processed.
+
+ @param resultClass   The class of the result object.
+ @param expression    An expression object. It is read once, when the first page is fetched.
+ @param configuration A configuration.
+
+ @return A paginator over the model objects.
+ */
+- (AWSPaginator<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)queryPaginator:(Class)resultClass
+                                                                              expression:(AWSDynamoDBQueryExpression *)expression
+                                                                           configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Returns a paginator over the objects of a scan, using the default configuration. The next page is fetched while the current one is processed.
+
+ @param resultClass The class of the result object.
+ @param expression  An expression object. It is read once, when the first page is fetched.
+
+ @return A paginator over the model objects.
+ */
+- (AWSPaginator<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)scanPaginator:(Class)resultClass
+                                                                             expression:(AWSDynamoDBScanExpression *)expression;
+
+/**
+ Returns a paginator over the objects of a scan. The next page is fetched while the current one is processed.
+
+ @param resultClass   The class of the result object.
+ @param expression    An expression object. It is read once, when the first page is fetched.
+ @param configuration A configuration.
+
+ @return A paginator over the model objects.
+ */
+- (AWSPaginator<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)scanPaginator:(Class)resultClass
+                                                                             expression:(AWSDynamoDBScanExpression *)expression
+                                                                          configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Loads the objects with the given keys with `BatchGetItem`, using the default configuration. The keys are sent 100 at a
+ time with up to `AWSDynamoDBObjectMapperBatchMaxConcurrentRequests` calls in flight, and unprocessed keys are retried
+ with exponential backoff.
+
+ @param models Model objects whose hash key and range key, if any, are set. They may belong to different tables.
+
+ @return AWSTask. On successful execution, `task.result` will contain the loaded objects, in the order of `models`.
+         Keys without an item are left out.
+ */
+- (AWSTask<NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *> *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models;
+
+/**
+ Loads the objects with the given keys with `BatchGetItem`.
+
+ @param models        Model objects whose hash key and range key, if any, are set. They may belong to different tables.
+ @param configuration A configuration. Only `consistentRead` applies.
+
+ @return AWSTask. On successful execution, `task.result` will contain the loaded objects, in the order of `models`.
+         Keys without an item are left out.
+ */
+- (AWSTask<NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *> *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                                            configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Saves the given objects with `BatchWriteItem`. The objects are sent 25 at a time with up to
+ `AWSDynamoDBObjectMapperBatchMaxConcurrentRequests` calls in flight, and unprocessed items are retried with exponential
+ backoff.
+
+ `BatchWriteItem` only puts whole items, so every object replaces the stored item as with
+ `AWSDynamoDBObjectMapperSaveBehaviorClobber`, whatever the configured save behavior. When several objects have the same
+ key, the last one is saved.
+
+ @param models Model objects. They may belong to different tables.
+
+ @return AWSTask. `task.result` will be `nil`. When unprocessed items remain after the last retry, `task.error` is
+         `AWSDynamoDBErrorProvisionedThroughputExceeded` in `AWSDynamoDBErrorDomain`.
+ */
+- (AWSTask *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models;
+
+/**
+ Scans a table in `totalSegments` parallel segments and hands out the objects as the pages arrive, using the default
+ configuration. At most `maxConcurrentSegments` segments are scanned at a time.
+
+ @param resultClass           The class of the result object.
+ @param expression            An expression object. `exclusiveStartKey` is ignored.
+ @param totalSegments         The number of segments the table is divided into, between 1 and 1,000,000.
+ @param maxConcurrentSegments The maximum number of segments scanned at a time.
+ @param pageHandler           Called with the objects of every page. Calls never overlap, but they come from
+                              different threads and the pages of different segments are interleaved.
+
+ @return AWSTask that completes when every segment has been scanned. `task.result` will be `nil`. After a segment fails,
+         no further segments are started and `task.error` is the first error.
+ */
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+    maxConcurrentSegments:(NSUInteger)maxConcurrentSegments
+              pageHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))pageHandler;
+
 @end
 
 /**
@@ -543,6 +657,13 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
  */
 @property (nonatomic, strong, nullable) NSNumber *consistentRead;
 
+/**
+ The cache of the items read by `- load:hashKey:rangeKey:`, or `nil` to read every item from the table. Copies of the configuration share the cache. The default value is `nil`.
+
+ @see AWSDynamoDBItemCache
+ */
+@property (nonatomic, strong, nullable) AWSDynamoDBItemCache *itemCache;
+
 @end
 
 /**
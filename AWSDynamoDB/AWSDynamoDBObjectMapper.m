@@ -14,7 +14,9 @@
 //
 
 #import "AWSDynamoDBObjectMapper.h"
+#import "AWSDynamoDBObjectModelCodec.h"
 #import "AWSDynamoDB.h"
+#import "AWSDynamoDB+ObjectMapper.h"
 #import "AWSBolts.h"
 #import "AWSCocoaLumberjack.h"
 #import "AWSSynchronizedMutableDictionary.h"
@@ -24,6 +26,12 @@ static NSString *const AWSInfoDynamoDBObjectMapper = @"DynamoDBObjectMapper";
 
 static const NSString *AWSDynamoDBObjectMapperHashKeyAttributePlaceHolder = @":awsddbomhashvalueplaceholder";
 NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
+NSUInteger const AWSDynamoDBObjectMapperBatchMaxConcurrentRequests = 4;
+
+static NSUInteger const AWSDynamoDBObjectMapperBatchGetItemMaxKeys = 100;
+static NSUInteger const AWSDynamoDBObjectMapperBatchWriteItemMaxItems = 25;
+static NSUInteger const AWSDynamoDBObjectMapperBatchMaxRetries = 8;
+static uint32_t const AWSDynamoDBObjectMapperBatchBackoffBaseMillis = 50;
 
 @interface NSString (AWSDynamoDBObjectMapperSaveBehavior)
 
@@ -103,8 +111,6 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
 
 @interface AWSDynamoDBObjectModel ()
 
-- (NSDictionary *)itemForPutItemInput;
-- (NSDictionary *)itemForUpdateItemInput:(AWSDynamoDBObjectMapperSaveBehavior)behavior;
 - (NSDictionary *)key;
 
 @end
@@ -127,6 +133,97 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
 
 @end
 
+// The requests and outputs below keep items as DynamoDB JSON, which `AWSDynamoDBObjectModelCodec` reads and writes
+// directly, instead of transforming them to and from `AWSDynamoDBAttributeValue` objects.
+
+@interface AWSDynamoDBObjectMapperPutItemInput : AWSDynamoDBPutItemInput
+
+@end
+
+@implementation AWSDynamoDBObjectMapperPutItemInput
+
++ (NSValueTransformer *)itemJSONTransformer {
+    return nil;
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperUpdateItemInput : AWSDynamoDBUpdateItemInput
+
+@end
+
+@implementation AWSDynamoDBObjectMapperUpdateItemInput
+
++ (NSValueTransformer *)attributeUpdatesJSONTransformer {
+    return nil;
+}
+
++ (NSValueTransformer *)keyJSONTransformer {
+    return nil;
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperPutRequest : AWSDynamoDBPutRequest
+
+@end
+
+@implementation AWSDynamoDBObjectMapperPutRequest
+
++ (NSValueTransformer *)itemJSONTransformer {
+    return nil;
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperGetItemOutput : AWSDynamoDBGetItemOutput
+
+@end
+
+@implementation AWSDynamoDBObjectMapperGetItemOutput
+
++ (NSValueTransformer *)itemJSONTransformer {
+    return nil;
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperQueryOutput : AWSDynamoDBQueryOutput
+
+@end
+
+@implementation AWSDynamoDBObjectMapperQueryOutput
+
++ (NSValueTransformer *)itemsJSONTransformer {
+    return nil;
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperScanOutput : AWSDynamoDBScanOutput
+
+@end
+
+@implementation AWSDynamoDBObjectMapperScanOutput
+
++ (NSValueTransformer *)itemsJSONTransformer {
+    return nil;
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperBatchGetItemOutput : AWSDynamoDBBatchGetItemOutput
+
+@end
+
+@implementation AWSDynamoDBObjectMapperBatchGetItemOutput
+
++ (NSValueTransformer *)responsesJSONTransformer {
+    return nil;
+}
+
+@end
+
 @interface AWSDynamoDBAttributeValue (AWSDynamoDBObjectMapper)
 
 - (void)aws_setAttributeValue:(id)attributeValue;
@@ -223,6 +320,19 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
 
 @end
 
+@interface AWSDynamoDBItemCache()
+
+- (NSUInteger)currentGeneration;
+- (BOOL)cachedItem:(NSDictionary **)item
+            forKey:(NSString *)key;
+- (void)setItem:(NSDictionary *)item
+         forKey:(NSString *)key
+      tableName:(NSString *)tableName
+     generation:(NSUInteger)generation;
+- (void)removeItemForKey:(NSString *)key;
+
+@end
+
 @interface AWSDynamoDBObjectMapper()
 
 @property (nonatomic, strong) AWSDynamoDB *dynamoDB;
@@ -347,26 +457,29 @@ completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandl
 
 - (AWSTask *)save:(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *)model
     configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    AWSTask *task = nil;
     switch (configuration.saveBehavior) {
         case AWSDynamoDBObjectMapperSaveBehaviorClobber: {
 
-            AWSDynamoDBPutItemInput *putItemInput = [AWSDynamoDBPutItemInput new];
+            AWSDynamoDBPutItemInput *putItemInput = [AWSDynamoDBObjectMapperPutItemInput new];
             putItemInput.tableName = [[model class] performSelector:@selector(dynamoDBTableName)];
-            putItemInput.item = [model itemForPutItemInput];
+            putItemInput.item = (NSDictionary *)[[AWSDynamoDBObjectModelCodec codecForClass:[model class]] itemFromModel:model];
 
-            return [self.dynamoDB putItem:putItemInput];
+            task = [self.dynamoDB putItem:putItemInput];
             break;
         }
         case AWSDynamoDBObjectMapperSaveBehaviorAppendSet:
         case AWSDynamoDBObjectMapperSaveBehaviorUpdateSkipNullAttributes:
         case AWSDynamoDBObjectMapperSaveBehaviorUpdate: {
 
-            AWSDynamoDBUpdateItemInput *updateItemInput = [AWSDynamoDBUpdateItemInput new];
+            AWSDynamoDBObjectModelCodec *codec = [AWSDynamoDBObjectModelCodec codecForClass:[model class]];
+            AWSDynamoDBUpdateItemInput *updateItemInput = [AWSDynamoDBObjectMapperUpdateItemInput new];
             updateItemInput.tableName = [[model class] performSelector:@selector(dynamoDBTableName)];
-            updateItemInput.attributeUpdates = [model itemForUpdateItemInput:configuration.saveBehavior];
-            updateItemInput.key = [model key];
+            updateItemInput.attributeUpdates = (NSDictionary *)[codec attributeUpdatesFromModel:model
+                                                                                  saveBehavior:configuration.saveBehavior];
+            updateItemInput.key = (NSDictionary *)[codec keyFromModel:model];
 
-            return [self.dynamoDB updateItem:updateItemInput];
+            task = [self.dynamoDB updateItem:updateItemInput];
             break;
         }
 
@@ -374,7 +487,12 @@ completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandl
         default:
             break;
     }
-    return [AWSTask taskWithError:[NSError errorWithDomain:AWSDynamoDBErrorDomain code:AWSDynamoDBErrorUnknown userInfo:nil]];
+    if (!task) {
+        return [AWSTask taskWithError:[NSError errorWithDomain:AWSDynamoDBErrorDomain code:AWSDynamoDBErrorUnknown userInfo:nil]];
+    }
+    return [self aws_invalidateCachedItemOfModel:model
+                                   configuration:configuration
+                                       afterTask:task];
 }
 
 - (void)save:(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *)model
@@ -407,7 +525,9 @@ completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandl
     deleteItemInput.tableName = [[model class] performSelector:@selector(dynamoDBTableName)];
     deleteItemInput.key = [model key];
 
-    return [self.dynamoDB deleteItem:deleteItemInput];
+    return [self aws_invalidateCachedItemOfModel:model
+                                   configuration:configuration
+                                       afterTask:[self.dynamoDB deleteItem:deleteItemInput]];
 }
 
 - (void)remove:(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *)model
@@ -467,23 +587,35 @@ completionHandler:completionHandler];
                 forKey:rangeKeyAttribute];
     }
     getItemInput.key = key;
+    getItemInput.consistentRead = configuration.consistentRead;
+
+    // Strongly consistent reads bypass the cache.
+    AWSDynamoDBItemCache *itemCache = [configuration.consistentRead boolValue] ? nil : configuration.itemCache;
+    NSString *cacheKey = nil;
+    NSUInteger cacheGeneration = 0;
+    if (itemCache) {
+        cacheKey = [self aws_identifierForItem:key
+                                     tableName:getItemInput.tableName
+                                   resultClass:resultClass];
+        NSDictionary *cachedItem = nil;
+        if ([itemCache cachedItem:&cachedItem forKey:cacheKey]) {
+            return [self aws_modelOfClass:resultClass
+                                 fromItem:cachedItem];
+        }
+        cacheGeneration = [itemCache currentGeneration];
+    }
 
-    return [[self.dynamoDB getItem:getItemInput] continueWithSuccessBlock:^id(AWSTask *task) {
+    return [[self.dynamoDB aws_getItem:getItemInput
+                           outputClass:[AWSDynamoDBObjectMapperGetItemOutput class]] continueWithSuccessBlock:^id(AWSTask *task) {
         AWSDynamoDBGetItemOutput *getItemOutput = task.result;
-
-        NSError *error = nil;
-        NSDictionary *itemsDictionary = [self removeAttributes:getItemOutput.item];
-
-        id responseObject = nil;
-        if ([itemsDictionary count] > 0) {
-            responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
-                                          fromJSONDictionary:itemsDictionary
-                                                       error:&error];
-            if (error) {
-                return [AWSTask taskWithError:error];
-            }
-        }
-        return responseObject;
+        NSDictionary *item = [getItemOutput.item count] > 0 ? (NSDictionary *)getItemOutput.item : nil;
+        [itemCache setItem:item
+                    forKey:cacheKey
+                 tableName:getItemInput.tableName
+                generation:cacheGeneration];
+
+        return [self aws_modelOfClass:resultClass
+                             fromItem:item];
     }];
 }
 
@@ -586,18 +718,16 @@ completionHandler:completionHandler];
 // Internal class
 - (AWSTask<AWSDynamoDBPaginatedOutput *> *)query:(Class)resultClass
                                       queryInput:(AWSDynamoDBQueryInput *)queryInput {
-    return [[self.dynamoDB query:queryInput] continueWithSuccessBlock:^id(AWSTask *task) {
+    return [[self.dynamoDB aws_query:queryInput
+                         outputClass:[AWSDynamoDBObjectMapperQueryOutput class]] continueWithSuccessBlock:^id(AWSTask *task) {
         AWSDynamoDBQueryOutput *queryOutput = task.result;
 
-        NSMutableArray *items = [NSMutableArray new];
+        AWSDynamoDBObjectModelCodec *codec = [AWSDynamoDBObjectModelCodec codecForClass:resultClass];
+        NSMutableArray *items = [NSMutableArray arrayWithCapacity:[queryOutput.items count]];
         NSError *error = nil;
         for (id item in queryOutput.items) {
-
-            NSDictionary *itemsDictionary = [self removeAttributes:item];
-
-            id responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
-                                             fromJSONDictionary:itemsDictionary
-                                                          error:&error];
+            id responseObject = [codec modelFromItem:item
+                                               error:&error];
             if (error) {
                 return [AWSTask taskWithError:error];
             }
@@ -651,6 +781,14 @@ completionHandler:completionHandler];
 - (AWSTask<AWSDynamoDBPaginatedOutput *> *)scan:(Class)resultClass
                                      expression:(AWSDynamoDBScanExpression *)expression
                                   configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    return [self scan:resultClass
+            scanInput:[self scanInput:resultClass
+                           expression:expression]];
+}
+
+// Internal method
+- (AWSDynamoDBScanInput *)scanInput:(Class)resultClass
+                         expression:(AWSDynamoDBScanExpression *)expression {
     AWSDynamoDBScanInput *scanInput = [AWSDynamoDBScanInput new];
     scanInput.tableName = [resultClass performSelector:@selector(dynamoDBTableName)];
     scanInput.limit = expression.limit;
@@ -676,24 +814,22 @@ completionHandler:completionHandler];
     scanInput.projectionExpression = expression.projectionExpression;
     scanInput.expressionAttributeNames = expression.expressionAttributeNames;
 
-    return [self scan:resultClass
-            scanInput:scanInput];
+    return scanInput;
 }
 
 // Internal class
 - (AWSTask<AWSDynamoDBPaginatedOutput *> *)scan:(Class)resultClass
                                       scanInput:(AWSDynamoDBScanInput *)scanInput {
-    return [[self.dynamoDB scan:scanInput] continueWithSuccessBlock:^id(AWSTask *task) {
+    return [[self.dynamoDB aws_scan:scanInput
+                        outputClass:[AWSDynamoDBObjectMapperScanOutput class]] continueWithSuccessBlock:^id(AWSTask *task) {
         AWSDynamoDBScanOutput *scanOutput = task.result;
 
-        NSMutableArray *items = [NSMutableArray new];
+        AWSDynamoDBObjectModelCodec *codec = [AWSDynamoDBObjectModelCodec codecForClass:resultClass];
+        NSMutableArray *items = [NSMutableArray arrayWithCapacity:[scanOutput.items count]];
         NSError *error = nil;
         for (id item in scanOutput.items) {
-
-            NSDictionary *itemsDictionary = [self removeAttributes:item];
-            id responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
-                                             fromJSONDictionary:itemsDictionary
-                                                          error:&error];
+            id responseObject = [codec modelFromItem:item
+                                               error:&error];
             if (error) {
                 return [AWSTask taskWithError:error];
             }
@@ -728,129 +864,442 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
     }];
 }
 
-#pragma mark - Utility
+- (AWSPaginator *)queryPaginator:(Class)resultClass
+                      expression:(AWSDynamoDBQueryExpression *)expression {
+    return [self queryPaginator:resultClass
+                     expression:expression
+                  configuration:self.objectMapperConfiguration];
+}
 
-- (NSDictionary *)removeAttributes:(NSDictionary *)item {
-    NSMutableDictionary *mutableItem = [NSMutableDictionary new];
-    [item enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
-        if ([obj respondsToSelector:@selector(aws_getAttributeValue)]) {
-            id value = [obj aws_getAttributeValue];
-            if (value) {
-                [mutableItem setObject:value
-                                forKey:key];
-            }
+- (AWSPaginator *)queryPaginator:(Class)resultClass
+                      expression:(AWSDynamoDBQueryExpression *)expression
+                   configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    // The first page is built from the expression; the later pages reuse its query input.
+    __block AWSDynamoDBQueryInput *queryInput = nil;
+    return [[AWSPaginator alloc] initWithOutputTokenKey:@"lastEvaluatedKey"
+                                              resultKey:@"items"
+                                              pageBlock:^AWSTask *(id token) {
+        if (!queryInput) {
+            return [[self query:resultClass
+                     expression:expression
+                  configuration:configuration] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBPaginatedOutput *> *task) {
+                queryInput = task.result.queryInput;
+                return task;
+            }];
         }
+        AWSDynamoDBQueryInput *pageInput = [queryInput copy];
+        pageInput.exclusiveStartKey = token;
+        return [self query:resultClass
+                queryInput:pageInput];
     }];
+}
 
-    return mutableItem;
+- (AWSPaginator *)scanPaginator:(Class)resultClass
+                     expression:(AWSDynamoDBScanExpression *)expression {
+    return [self scanPaginator:resultClass
+                    expression:expression
+                 configuration:self.objectMapperConfiguration];
 }
 
-@end
+- (AWSPaginator *)scanPaginator:(Class)resultClass
+                     expression:(AWSDynamoDBScanExpression *)expression
+                  configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    // The first page is built from the expression; the later pages reuse its scan input.
+    __block AWSDynamoDBScanInput *scanInput = nil;
+    return [[AWSPaginator alloc] initWithOutputTokenKey:@"lastEvaluatedKey"
+                                              resultKey:@"items"
+                                              pageBlock:^AWSTask *(id token) {
+        if (!scanInput) {
+            return [[self scan:resultClass
+                    expression:expression
+                 configuration:configuration] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBPaginatedOutput *> *task) {
+                scanInput = task.result.scanInput;
+                return task;
+            }];
+        }
+        AWSDynamoDBScanInput *pageInput = [scanInput copy];
+        pageInput.exclusiveStartKey = token;
+        return [self scan:resultClass
+                scanInput:pageInput];
+    }];
+}
 
-@implementation AWSDynamoDBObjectModel
+#pragma mark - Batch operations
 
-+ (NSDictionary *)JSONKeyPathsByPropertyKey {
-    return nil;
+- (AWSTask *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    return [self batchLoad:models
+             configuration:self.objectMapperConfiguration];
 }
 
-- (NSDictionary *)removeIgnoredAttributesFromJSONDictionary:(NSDictionary *)JSONDictionary {
-    if ([[self class] respondsToSelector:@selector(ignoreAttributes)] == NO) {
-        return JSONDictionary;
+- (AWSTask *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+         configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    // Items are matched to the requested keys by table and key values.
+    NSMutableArray<NSString *> *identifiers = [NSMutableArray new];
+    NSMutableDictionary<NSString *, Class> *classesByTableName = [NSMutableDictionary new];
+    NSMutableArray<NSArray *> *requests = [NSMutableArray new];
+    NSMutableSet<NSString *> *requestedIdentifiers = [NSMutableSet new];
+    for (AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model in models) {
+        NSString *tableName = [[model class] performSelector:@selector(dynamoDBTableName)];
+        NSDictionary *key = [model key];
+        NSString *identifier = [self aws_identifierForItem:key
+                                                 tableName:tableName
+                                               resultClass:[model class]];
+        [identifiers addObject:identifier];
+        if (!classesByTableName[tableName]) {
+            classesByTableName[tableName] = [model class];
+        }
+        // BatchGetItem rejects a call that asks for the same key twice.
+        if (![requestedIdentifiers containsObject:identifier]) {
+            [requestedIdentifiers addObject:identifier];
+            [requests addObject:@[tableName, key]];
+        }
     }
 
-    NSArray *ignoredAttrArray = [[self class] performSelector:@selector(ignoreAttributes)];
-    NSMutableDictionary *resultDictionary = [JSONDictionary mutableCopy];
-    [resultDictionary removeObjectsForKeys:ignoredAttrArray];
-    return resultDictionary;
-}
+    NSMutableDictionary<NSString *, id> *loadedObjects = [NSMutableDictionary new];
+    return [[self aws_runRequests:requests
+                        batchSize:AWSDynamoDBObjectMapperBatchGetItemMaxKeys
+             maxConcurrentBatches:AWSDynamoDBObjectMapperBatchMaxConcurrentRequests
+                            block:^AWSTask *(NSArray<NSArray *> *batch) {
+        NSMutableDictionary<NSString *, AWSDynamoDBKeysAndAttributes *> *requestItems = [NSMutableDictionary new];
+        for (NSArray *request in batch) {
+            AWSDynamoDBKeysAndAttributes *keysAndAttributes = requestItems[request[0]];
+            if (!keysAndAttributes) {
+                keysAndAttributes = [AWSDynamoDBKeysAndAttributes new];
+                keysAndAttributes.consistentRead = configuration.consistentRead;
+                keysAndAttributes.keys = [NSMutableArray new];
+                requestItems[request[0]] = keysAndAttributes;
+            }
+            [(NSMutableArray *)keysAndAttributes.keys addObject:request[1]];
+        }
 
-- (NSDictionary *)itemForPutItemInput {
-    NSMutableDictionary *item = [NSMutableDictionary new];
-    NSMutableArray *keyArray = [NSMutableArray new];
+        return [[self aws_batchGetItem:requestItems
+                               attempt:0] continueWithSuccessBlock:^id(AWSTask<NSDictionary<NSString *, NSArray *> *> *task) {
+            for (NSString *tableName in task.result) {
+                Class resultClass = classesByTableName[tableName];
+                AWSDynamoDBObjectModelCodec *codec = [AWSDynamoDBObjectModelCodec codecForClass:resultClass];
+                for (NSDictionary *item in task.result[tableName]) {
+                    NSError *error = nil;
+                    id responseObject = [codec modelFromItem:item
+                                                       error:&error];
+                    if (error) {
+                        return [AWSTask taskWithError:error];
+                    }
+                    NSString *identifier = [self aws_identifierForItem:item
+                                                             tableName:tableName
+                                                           resultClass:resultClass];
+                    @synchronized(loadedObjects) {
+                        loadedObjects[identifier] = responseObject;
+                    }
+                }
+            }
+            return nil;
+        }];
+    }] continueWithSuccessBlock:^id(AWSTask *task) {
+        NSMutableArray *results = [NSMutableArray new];
+        for (NSString *identifier in identifiers) {
+            id responseObject = loadedObjects[identifier];
+            if (responseObject) {
+                [results addObject:responseObject];
+            }
+        }
+        return results;
+    }];
+}
 
-    NSString *hashKeyAttribute = [self aws_hashKeyAttributeForClass:[self class]];
-    [keyArray addObject:hashKeyAttribute];
+- (AWSTask *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    // BatchWriteItem rejects a call that writes the same key twice, so only the last object with a key is kept.
+    NSMutableArray<NSString *> *identifiers = [NSMutableArray new];
+    NSMutableDictionary<NSString *, NSArray *> *requestsByIdentifier = [NSMutableDictionary new];
+    for (AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model in models) {
+        NSString *tableName = [[model class] performSelector:@selector(dynamoDBTableName)];
+        AWSDynamoDBPutRequest *putRequest = [AWSDynamoDBObjectMapperPutRequest new];
+        putRequest.item = (NSDictionary *)[[AWSDynamoDBObjectModelCodec codecForClass:[model class]] itemFromModel:model];
+        NSString *identifier = [self aws_identifierForItem:putRequest.item
+                                                 tableName:tableName
+                                               resultClass:[model class]];
+        AWSDynamoDBWriteRequest *writeRequest = [AWSDynamoDBWriteRequest new];
+        writeRequest.putRequest = putRequest;
+
+        if (!requestsByIdentifier[identifier]) {
+            [identifiers addObject:identifier];
+        }
+        requestsByIdentifier[identifier] = @[tableName, writeRequest];
+    }
+    NSArray<NSArray *> *requests = [requestsByIdentifier objectsForKeys:identifiers
+                                                         notFoundMarker:[NSNull null]];
+
+    AWSTask *task = [[self aws_runRequests:requests
+                                 batchSize:AWSDynamoDBObjectMapperBatchWriteItemMaxItems
+                      maxConcurrentBatches:AWSDynamoDBObjectMapperBatchMaxConcurrentRequests
+                                     block:^AWSTask *(NSArray<NSArray *> *batch) {
+        NSMutableDictionary<NSString *, NSMutableArray<AWSDynamoDBWriteRequest *> *> *requestItems = [NSMutableDictionary new];
+        for (NSArray *request in batch) {
+            if (!requestItems[request[0]]) {
+                requestItems[request[0]] = [NSMutableArray new];
+            }
+            [requestItems[request[0]] addObject:request[1]];
+        }
+        return [self aws_batchWriteItem:requestItems
+                                attempt:0];
+    }] continueWithSuccessBlock:^id(AWSTask *task) {
+        return nil;
+    }];
+    if (!self.objectMapperConfiguration.itemCache) {
+        return task;
+    }
+    // The identifiers are the cache keys of the items.
+    return [self aws_invalidateCacheKeys:identifiers
+                            inItemCaches:@[self.objectMapperConfiguration.itemCache]
+                               afterTask:task];
+}
 
-    NSString *rangeKeyAttribute = [self aws_rangeKeyAttributeForClass:[self class]];
-    if (rangeKeyAttribute) {
-        [keyArray addObject:rangeKeyAttribute];
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+    maxConcurrentSegments:(NSUInteger)maxConcurrentSegments
+              pageHandler:(void (^)(NSArray *items))pageHandler {
+    AWSDynamoDBScanInput *scanInput = [self scanInput:resultClass
+                                           expression:expression];
+    scanInput.exclusiveStartKey = nil;
+    scanInput.totalSegments = @(totalSegments);
+
+    NSMutableArray<NSNumber *> *segments = [NSMutableArray new];
+    for (NSUInteger segment = 0; segment < totalSegments; segment++) {
+        [segments addObject:@(segment)];
     }
 
-    NSDictionary *dictionaryValue = [AWSMTLJSONAdapter JSONDictionaryFromModel:self];
-    dictionaryValue = [self removeIgnoredAttributesFromJSONDictionary:dictionaryValue];
-
-    for (id key in dictionaryValue) {
-        if ([keyArray containsObject:key]) {
-            // For key attributes
-            AWSDynamoDBAttributeValue *keyAttributeValue = [AWSDynamoDBAttributeValue new];
-            [keyAttributeValue aws_setAttributeValue:dictionaryValue[key]];
-            item[key] = keyAttributeValue;
-        } else if (dictionaryValue[key]) {
-            // For other attributes
-            if (dictionaryValue[key] == [NSNull null]) {
-                //when doing a putItem, we can safely ignore the null-valvued attributes
-            } else {
-                AWSDynamoDBAttributeValue *attributeValue = [AWSDynamoDBAttributeValue new];
-                [attributeValue aws_setAttributeValue:dictionaryValue[key]];
-                item[key] = attributeValue;
+    NSObject *pageHandlerLock = [NSObject new];
+    return [self aws_runRequests:segments
+                       batchSize:1
+            maxConcurrentBatches:maxConcurrentSegments
+                           block:^AWSTask *(NSArray<NSNumber *> *batch) {
+        // A copy gets its own networking request, so concurrent segments do not overwrite each other's parameters.
+        AWSDynamoDBScanInput *segmentInput = [scanInput copy];
+        segmentInput.segment = [batch firstObject];
+        return [self aws_scanSegment:resultClass
+                           scanInput:segmentInput
+                         pageHandler:^(NSArray *items) {
+            @synchronized(pageHandlerLock) {
+                pageHandler(items);
             }
+        }];
+    }];
+}
+
+// Internal method
+- (AWSTask *)aws_scanSegment:(Class)resultClass
+                   scanInput:(AWSDynamoDBScanInput *)scanInput
+                 pageHandler:(void (^)(NSArray *items))pageHandler {
+    return [[self scan:resultClass
+             scanInput:scanInput] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBPaginatedOutput *> *task) {
+        pageHandler(task.result.items);
+        if ([task.result.lastEvaluatedKey count] == 0) {
+            return nil;
         }
-    }
 
-    return item;
+        AWSDynamoDBScanInput *nextInput = [scanInput copy];
+        nextInput.exclusiveStartKey = task.result.lastEvaluatedKey;
+        return [self aws_scanSegment:resultClass
+                           scanInput:nextInput
+                         pageHandler:pageHandler];
+    }];
 }
 
-- (NSDictionary *)itemForUpdateItemInput:(AWSDynamoDBObjectMapperSaveBehavior)behavior {
-    // TODO: update this method to use UpdateExpression instead of AWSDynamoDBAttributeValueUpdate.
-    NSMutableDictionary *item = [NSMutableDictionary new];
-    NSArray *keyArray = [[self key] allKeys];
-    NSDictionary *dictionaryValue = [AWSMTLJSONAdapter JSONDictionaryFromModel:self];
-    dictionaryValue = [self removeIgnoredAttributesFromJSONDictionary:dictionaryValue];
-
-    for (id key in dictionaryValue) {
-        if (![keyArray containsObject:key]) {
-            // For other attributes
-
-            if (dictionaryValue[key] == [NSNull null]) {
-                //If attribute value is null
-                if (behavior == AWSDynamoDBObjectMapperSaveBehaviorUpdateSkipNullAttributes
-                    || behavior == AWSDynamoDBObjectMapperSaveBehaviorAppendSet) {
-                    /*
-                     * If UPDATE_SKIP_NULL_ATTRIBUTES or APPEND_SET is
-                     * configured, we don't delete null value attributes.
-                     */
-                } else {
-                    /* Delete attributes that are set as null in the object. */
-                    AWSDynamoDBAttributeValueUpdate *attributeValueUpdate = [AWSDynamoDBAttributeValueUpdate new];
-                    attributeValueUpdate.action = AWSDynamoDBAttributeActionDelete;
-
-                    item[key] = attributeValueUpdate;
-                }
+// Internal method. Splits `requests` into batches and runs them with at most `maxConcurrentBatches` in flight.
+// After a batch fails no further batches are started, and the task fails with the first error.
+- (AWSTask *)aws_runRequests:(NSArray *)requests
+                   batchSize:(NSUInteger)batchSize
+        maxConcurrentBatches:(NSUInteger)maxConcurrentBatches
+                       block:(AWSTask *(^)(NSArray *batch))block {
+    NSMutableArray<NSArray *> *batches = [NSMutableArray new];
+    for (NSUInteger location = 0; location < [requests count]; location += batchSize) {
+        [batches addObject:[requests subarrayWithRange:NSMakeRange(location, MIN(batchSize, [requests count] - location))]];
+    }
 
-            } else {
-                //If attribute value is not null
-                AWSDynamoDBAttributeValueUpdate *attributeValueUpdate = [AWSDynamoDBAttributeValueUpdate new];
-                AWSDynamoDBAttributeValue *attributeValue = [AWSDynamoDBAttributeValue new];
-                [attributeValue aws_setAttributeValue:dictionaryValue[key]];
-                attributeValueUpdate.value = attributeValue;
-                if (behavior == AWSDynamoDBObjectMapperSaveBehaviorAppendSet &&
-                    (attributeValue.BS != nil || attributeValue.NS != nil || attributeValue.SS != nil)) {
-
-                    /* If it's a set attribute and the mapper is configured with APPEND_SET,
-                     * we do an "ADD" update instead of the default "PUT".
-                     */
-                    attributeValueUpdate.action = AWSDynamoDBAttributeActionAdd;
-                } else {
-                    /* Otherwise, we do the default "PUT" update. */
-                    attributeValueUpdate.action = AWSDynamoDBAttributeActionPut;
+    NSMutableArray<NSError *> *errors = [NSMutableArray new];
+    NSMutableArray<AWSTask *> *lanes = [NSMutableArray new];
+    NSUInteger laneCount = MIN(MAX(maxConcurrentBatches, 1), [batches count]);
+    for (NSUInteger lane = 0; lane < laneCount; lane++) {
+        AWSTask *laneTask = [AWSTask taskWithResult:nil];
+        for (NSUInteger index = lane; index < [batches count]; index += laneCount) {
+            NSArray *batch = batches[index];
+            laneTask = [laneTask continueWithSuccessBlock:^id(AWSTask *task) {
+                @synchronized(errors) {
+                    if ([errors count] > 0) {
+                        return nil;
+                    }
                 }
+                return [block(batch) continueWithBlock:^id(AWSTask *batchTask) {
+                    if (batchTask.error) {
+                        @synchronized(errors) {
+                            [errors addObject:batchTask.error];
+                        }
+                    }
+                    return batchTask;
+                }];
+            }];
+        }
+        [lanes addObject:laneTask];
+    }
 
-                item[key] = attributeValueUpdate;
+    return [[AWSTask taskForCompletionOfAllTasks:lanes] continueWithBlock:^id(AWSTask *task) {
+        @synchronized(errors) {
+            if ([errors count] > 0) {
+                return [AWSTask taskWithError:[errors firstObject]];
             }
         }
+        return nil;
+    }];
+}
+
+// Internal method. The task result is the items of every table, including those of retried keys.
+- (AWSTask<NSDictionary<NSString *, NSArray *> *> *)aws_batchGetItem:(NSDictionary<NSString *, AWSDynamoDBKeysAndAttributes *> *)requestItems
+                                                             attempt:(NSUInteger)attempt {
+    AWSDynamoDBBatchGetItemInput *batchGetItemInput = [AWSDynamoDBBatchGetItemInput new];
+    batchGetItemInput.requestItems = requestItems;
+
+    return [[self.dynamoDB aws_batchGetItem:batchGetItemInput
+                                outputClass:[AWSDynamoDBObjectMapperBatchGetItemOutput class]] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBBatchGetItemOutput *> *task) {
+        NSDictionary<NSString *, NSArray *> *responses = task.result.responses ?: @{};
+        NSDictionary<NSString *, AWSDynamoDBKeysAndAttributes *> *unprocessedKeys = task.result.unprocessedKeys;
+        if ([unprocessedKeys count] == 0) {
+            return responses;
+        }
+        if (attempt >= AWSDynamoDBObjectMapperBatchMaxRetries) {
+            return [AWSTask taskWithError:[self aws_unprocessedRequestsError]];
+        }
+
+        return [[[AWSTask taskWithDelay:[self aws_backoffMillisForAttempt:attempt]] continueWithSuccessBlock:^id(AWSTask *delayTask) {
+            return [self aws_batchGetItem:unprocessedKeys
+                                  attempt:attempt + 1];
+        }] continueWithSuccessBlock:^id(AWSTask<NSDictionary<NSString *, NSArray *> *> *retryTask) {
+            NSMutableDictionary<NSString *, NSArray *> *mergedResponses = [responses mutableCopy];
+            [retryTask.result enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, NSArray *items, BOOL *stop) {
+                mergedResponses[tableName] = mergedResponses[tableName] ? [mergedResponses[tableName] arrayByAddingObjectsFromArray:items] : items;
+            }];
+            return mergedResponses;
+        }];
+    }];
+}
+
+// Internal method
+- (AWSTask *)aws_batchWriteItem:(NSDictionary<NSString *, NSArray<AWSDynamoDBWriteRequest *> *> *)requestItems
+                        attempt:(NSUInteger)attempt {
+    AWSDynamoDBBatchWriteItemInput *batchWriteItemInput = [AWSDynamoDBBatchWriteItemInput new];
+    batchWriteItemInput.requestItems = requestItems;
+
+    return [[self.dynamoDB batchWriteItem:batchWriteItemInput] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBBatchWriteItemOutput *> *task) {
+        NSDictionary<NSString *, NSArray<AWSDynamoDBWriteRequest *> *> *unprocessedItems = task.result.unprocessedItems;
+        if ([unprocessedItems count] == 0) {
+            return nil;
+        }
+        if (attempt >= AWSDynamoDBObjectMapperBatchMaxRetries) {
+            return [AWSTask taskWithError:[self aws_unprocessedRequestsError]];
+        }
+
+        return [[AWSTask taskWithDelay:[self aws_backoffMillisForAttempt:attempt]] continueWithSuccessBlock:^id(AWSTask *delayTask) {
+            return [self aws_batchWriteItem:unprocessedItems
+                                    attempt:attempt + 1];
+        }];
+    }];
+}
+
+// Exponential backoff with full jitter: a random delay of up to 50ms, 100ms, 200ms, ...
+- (int)aws_backoffMillisForAttempt:(NSUInteger)attempt {
+    return (int)arc4random_uniform(AWSDynamoDBObjectMapperBatchBackoffBaseMillis << attempt) + 1;
+}
+
+- (NSError *)aws_unprocessedRequestsError {
+    return [NSError errorWithDomain:AWSDynamoDBErrorDomain
+                               code:AWSDynamoDBErrorProvisionedThroughputExceeded
+                           userInfo:@{NSLocalizedDescriptionKey : @"Some items remained unprocessed after the maximum number of retries."}];
+}
+
+// Internal method. Items may hold `AWSDynamoDBAttributeValue` objects or DynamoDB JSON; both answer `valueForKey:`.
+- (NSString *)aws_identifierForItem:(NSDictionary<NSString *, id> *)item
+                          tableName:(NSString *)tableName
+                        resultClass:(Class)resultClass {
+    NSMutableString *identifier = [NSMutableString stringWithString:tableName];
+    NSString *rangeKeyAttribute = [self aws_rangeKeyAttributeForClass:resultClass];
+    NSArray<NSString *> *keyAttributes = rangeKeyAttribute ? @[[self aws_hashKeyAttributeForClass:resultClass], rangeKeyAttribute] : @[[self aws_hashKeyAttributeForClass:resultClass]];
+    for (NSString *keyAttribute in keyAttributes) {
+        id value = item[keyAttribute];
+        NSString *valueString = [value valueForKey:@"S"] ?: [value valueForKey:@"N"] ?: [[value valueForKey:@"B"] base64EncodedStringWithOptions:0] ?: @"";
+        [identifier appendFormat:@"\n%lu:%@", (unsigned long)[valueString length], valueString];
+    }
+    return identifier;
+}
+
+#pragma mark - Utility
+
+// Internal method. The task result is the object of the item, or `nil` without an item.
+- (AWSTask *)aws_modelOfClass:(Class)resultClass
+                     fromItem:(NSDictionary *)item {
+    if (!item) {
+        return [AWSTask taskWithResult:nil];
     }
+    NSError *error = nil;
+    id responseObject = [[AWSDynamoDBObjectModelCodec codecForClass:resultClass] modelFromItem:item
+                                                                                        error:&error];
+    if (error) {
+        return [AWSTask taskWithError:error];
+    }
+    return [AWSTask taskWithResult:responseObject];
+}
 
-    return item;
+// Internal method. Invalidates the cached item of the model in the caches of the object mapper and of the
+// configuration, when the write starts and again when it completes, so that no load racing the write caches what it read.
+- (AWSTask *)aws_invalidateCachedItemOfModel:(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *)model
+                               configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+                                   afterTask:(AWSTask *)task {
+    NSMutableArray<AWSDynamoDBItemCache *> *itemCaches = [NSMutableArray new];
+    if (self.objectMapperConfiguration.itemCache) {
+        [itemCaches addObject:self.objectMapperConfiguration.itemCache];
+    }
+    if (configuration.itemCache && configuration.itemCache != self.objectMapperConfiguration.itemCache) {
+        [itemCaches addObject:configuration.itemCache];
+    }
+    if ([itemCaches count] == 0) {
+        return task;
+    }
+
+    return [self aws_invalidateCacheKeys:@[[self aws_cacheKeyOfModel:model]]
+                            inItemCaches:itemCaches
+                               afterTask:task];
+}
+
+// Internal method
+- (AWSTask *)aws_invalidateCacheKeys:(NSArray<NSString *> *)cacheKeys
+                        inItemCaches:(NSArray<AWSDynamoDBItemCache *> *)itemCaches
+                           afterTask:(AWSTask *)task {
+    for (AWSDynamoDBItemCache *itemCache in itemCaches) {
+        for (NSString *cacheKey in cacheKeys) {
+            [itemCache removeItemForKey:cacheKey];
+        }
+    }
+    return [task continueWithBlock:^id(AWSTask *writeTask) {
+        for (AWSDynamoDBItemCache *itemCache in itemCaches) {
+            for (NSString *cacheKey in cacheKeys) {
+                [itemCache removeItemForKey:cacheKey];
+            }
+        }
+        return writeTask;
+    }];
+}
+
+// Internal method
+- (NSString *)aws_cacheKeyOfModel:(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *)model {
+    return [self aws_identifierForItem:[[AWSDynamoDBObjectModelCodec codecForClass:[model class]] keyFromModel:model]
+                             tableName:[[model class] performSelector:@selector(dynamoDBTableName)]
+                           resultClass:[model class]];
+}
+
+@end
+
+@implementation AWSDynamoDBObjectModel
+
++ (NSDictionary *)JSONKeyPathsByPropertyKey {
+    return nil;
 }
 
 - (NSDictionary *)key {
@@ -893,6 +1342,7 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
     AWSDynamoDBObjectMapperConfiguration *configuration = [[[self class] allocWithZone:zone] init];
     configuration.saveBehavior = self.saveBehavior;
     configuration.consistentRead = [self.consistentRead copy];
+    configuration.itemCache = self.itemCache;
     
     return configuration;
 }
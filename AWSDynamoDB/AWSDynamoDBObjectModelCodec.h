@@ -0,0 +1,83 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSDynamoDBObjectMapper.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Converts objects mapped to an Amazon DynamoDB table directly to and from DynamoDB JSON items, without building
+ `AWSDynamoDBAttributeValue` objects.
+
+ An item is a dictionary from attribute names to attribute values in the form the JSON serializer takes and the JSON
+ parser returns, e.g. `@{@"S" : @"value"}`, `@{@"N" : @"1"}`, `@{@"B" : data}` or `@{@"L" : @[...]}`. The property
+ names, attribute names and value transformers of a class are looked up once and cached. The items produced are the
+ same as those produced through `AWSDynamoDBAttributeValue`.
+ */
+@interface AWSDynamoDBObjectModelCodec : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns the codec of a model class, creating it on first use.
+
+ @param modelClass A subclass of `AWSDynamoDBObjectModel` conforming to `AWSDynamoDBModeling`.
+
+ @return The codec of the class.
+ */
++ (instancetype)codecForClass:(Class)modelClass;
+
+/**
+ Returns the item of `PutItem` for an object. Attributes with a `nil` value and ignored attributes are left out.
+ */
+- (NSDictionary<NSString *, NSDictionary *> *)itemFromModel:(AWSDynamoDBObjectModel *)model;
+
+/**
+ Returns the attribute updates of `UpdateItem` for an object, as the save behavior requires.
+ */
+- (NSDictionary<NSString *, NSDictionary *> *)attributeUpdatesFromModel:(AWSDynamoDBObjectModel *)model
+                                                           saveBehavior:(AWSDynamoDBObjectMapperSaveBehavior)saveBehavior;
+
+/**
+ Returns the hash and range key attributes of an object.
+ */
+- (NSDictionary<NSString *, NSDictionary *> *)keyFromModel:(AWSDynamoDBObjectModel *)model;
+
+/**
+ Creates an object from an item.
+
+ @param item  An item returned by Amazon DynamoDB.
+ @param error Set when the object cannot be created.
+
+ @return An object of the class of the codec, or `nil` on error.
+ */
+- (nullable id)modelFromItem:(NSDictionary<NSString *, NSDictionary *> *)item
+                       error:(NSError **)error;
+
+/**
+ Returns the attribute value of an `NSString`, `NSNumber`, `NSData`, `NSSet`, `NSArray` or `NSDictionary`. An empty
+ dictionary is returned for empty sets, lists and maps, and for other types.
+ */
++ (NSDictionary *)attributeValueFromObject:(id)object;
+
+/**
+ Returns the object of an attribute value, or `nil` for a `NULL` value.
+ */
++ (nullable id)objectFromAttributeValue:(NSDictionary *)attributeValue;
+
+@end
+
+NS_ASSUME_NONNULL_END
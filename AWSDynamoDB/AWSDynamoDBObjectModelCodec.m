@@ -0,0 +1,350 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSDynamoDBObjectModelCodec.h"
+#import "AWSCategory.h"
+
+@interface AWSDynamoDBObjectModelCodecProperty : NSObject
+
+@property (nonatomic, strong) NSString *propertyKey;
+@property (nonatomic, strong) NSString *attributeName;
+@property (nonatomic, strong) NSValueTransformer *transformer;
+@property (nonatomic, assign) BOOL reversible;
+
+@end
+
+@implementation AWSDynamoDBObjectModelCodecProperty
+
+@end
+
+@interface AWSDynamoDBObjectModelCodec()
+
+@property (nonatomic, assign) Class modelClass;
+// The mapped properties. Properties mapped to `NSNull` are left out.
+@property (nonatomic, strong) NSArray<AWSDynamoDBObjectModelCodecProperty *> *properties;
+@property (nonatomic, strong) NSSet<NSString *> *ignoredAttributes;
+@property (nonatomic, strong) NSArray<NSString *> *keyAttributes;
+// YES when the class maps properties to nested key paths or picks the class to parse, which only
+// `AWSMTLJSONAdapter` understands. The values of the attributes are still converted directly.
+@property (nonatomic, assign) BOOL usesJSONAdapter;
+
+@end
+
+@implementation AWSDynamoDBObjectModelCodec
+
+static NSMutableDictionary<NSString *, AWSDynamoDBObjectModelCodec *> *_codecs = nil;
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `+ codecForClass:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
++ (instancetype)codecForClass:(Class)modelClass {
+    NSString *className = NSStringFromClass(modelClass);
+    @synchronized(self) {
+        if (!_codecs) {
+            _codecs = [NSMutableDictionary new];
+        }
+        AWSDynamoDBObjectModelCodec *codec = _codecs[className];
+        if (!codec) {
+            codec = [[self alloc] initWithModelClass:modelClass];
+            _codecs[className] = codec;
+        }
+        return codec;
+    }
+}
+
+- (instancetype)initWithModelClass:(Class)modelClass {
+    if (self = [super init]) {
+        _modelClass = modelClass;
+
+        NSDictionary *JSONKeyPathsByPropertyKey = [modelClass JSONKeyPathsByPropertyKey];
+        NSMutableArray<AWSDynamoDBObjectModelCodecProperty *> *properties = [NSMutableArray new];
+        for (NSString *propertyKey in [modelClass propertyKeys]) {
+            id JSONKeyPath = JSONKeyPathsByPropertyKey[propertyKey] ?: propertyKey;
+            if (JSONKeyPath == [NSNull null]) {
+                continue;
+            }
+            if ([JSONKeyPath rangeOfString:@"."].location != NSNotFound) {
+                _usesJSONAdapter = YES;
+            }
+
+            AWSDynamoDBObjectModelCodecProperty *property = [AWSDynamoDBObjectModelCodecProperty new];
+            property.propertyKey = propertyKey;
+            property.attributeName = JSONKeyPath;
+            property.transformer = [self transformerForPropertyKey:propertyKey];
+            property.reversible = [[property.transformer class] allowsReverseTransformation];
+            [properties addObject:property];
+        }
+        _properties = properties;
+
+        if ([modelClass respondsToSelector:@selector(classForParsingJSONDictionary:)]) {
+            _usesJSONAdapter = YES;
+        }
+
+        if ([modelClass respondsToSelector:@selector(ignoreAttributes)]) {
+            _ignoredAttributes = [NSSet setWithArray:[modelClass performSelector:@selector(ignoreAttributes)]];
+        }
+
+        NSMutableArray<NSString *> *keyAttributes = [NSMutableArray new];
+        for (NSString *selectorName in @[@"hashKeyAttribute", @"rangeKeyAttribute"]) {
+            SEL selector = NSSelectorFromString(selectorName);
+            if ([modelClass respondsToSelector:selector]) {
+                NSString *keyAttribute = [modelClass performSelector:selector];
+                [keyAttributes addObject:JSONKeyPathsByPropertyKey[keyAttribute] ?: keyAttribute];
+            }
+        }
+        _keyAttributes = keyAttributes;
+    }
+    return self;
+}
+
+// Looks the transformer up the way `AWSMTLJSONAdapter` does.
+- (NSValueTransformer *)transformerForPropertyKey:(NSString *)propertyKey {
+    NSString *selectorName = [NSString stringWithFormat:@"%@JSONTransformer", propertyKey];
+    SEL selector = NSSelectorFromString(selectorName);
+    if ([self.modelClass respondsToSelector:selector]) {
+        return [self.modelClass performSelector:selector];
+    }
+    if ([self.modelClass respondsToSelector:@selector(JSONTransformerForKey:)]) {
+        return [self.modelClass JSONTransformerForKey:propertyKey];
+    }
+    return nil;
+}
+
+#pragma mark - Encoding
+
+// Attribute names and transformed property values, with `NSNull` for `nil`.
+- (NSDictionary<NSString *, id> *)JSONValuesFromModel:(AWSDynamoDBObjectModel *)model {
+    if (self.usesJSONAdapter) {
+        return [AWSMTLJSONAdapter JSONDictionaryFromModel:model];
+    }
+
+    NSMutableDictionary<NSString *, id> *values = [NSMutableDictionary dictionaryWithCapacity:[self.properties count]];
+    for (AWSDynamoDBObjectModelCodecProperty *property in self.properties) {
+        id value = [model valueForKey:property.propertyKey];
+        if (property.reversible) {
+            value = [property.transformer reverseTransformedValue:value];
+        }
+        values[property.attributeName] = value ?: [NSNull null];
+    }
+    return values;
+}
+
+- (NSDictionary<NSString *, NSDictionary *> *)itemFromModel:(AWSDynamoDBObjectModel *)model {
+    NSDictionary<NSString *, id> *values = [self JSONValuesFromModel:model];
+    NSMutableDictionary<NSString *, NSDictionary *> *item = [NSMutableDictionary dictionaryWithCapacity:[values count]];
+    for (NSString *attributeName in values) {
+        if ([self.ignoredAttributes containsObject:attributeName]) {
+            continue;
+        }
+        id value = values[attributeName];
+        if (value == [NSNull null] && ![self.keyAttributes containsObject:attributeName]) {
+            // When doing a putItem, we can safely ignore the null-valued attributes.
+            continue;
+        }
+        item[attributeName] = [[self class] attributeValueFromObject:value];
+    }
+    return item;
+}
+
+- (NSDictionary<NSString *, NSDictionary *> *)attributeUpdatesFromModel:(AWSDynamoDBObjectModel *)model
+                                                           saveBehavior:(AWSDynamoDBObjectMapperSaveBehavior)saveBehavior {
+    NSDictionary<NSString *, id> *values = [self JSONValuesFromModel:model];
+    NSMutableDictionary<NSString *, NSDictionary *> *attributeUpdates = [NSMutableDictionary dictionaryWithCapacity:[values count]];
+    for (NSString *attributeName in values) {
+        if ([self.ignoredAttributes containsObject:attributeName]
+            || [self.keyAttributes containsObject:attributeName]) {
+            continue;
+        }
+
+        id value = values[attributeName];
+        if (value == [NSNull null]) {
+            // UPDATE_SKIP_NULL_ATTRIBUTES and APPEND_SET keep the attributes that are null in the object.
+            if (saveBehavior != AWSDynamoDBObjectMapperSaveBehaviorUpdateSkipNullAttributes
+                && saveBehavior != AWSDynamoDBObjectMapperSaveBehaviorAppendSet) {
+                attributeUpdates[attributeName] = @{@"Action" : @"DELETE"};
+            }
+            continue;
+        }
+
+        NSDictionary *attributeValue = [[self class] attributeValueFromObject:value];
+        BOOL isSet = attributeValue[@"SS"] || attributeValue[@"NS"] || attributeValue[@"BS"];
+        // APPEND_SET adds to set attributes instead of replacing them.
+        NSString *action = (saveBehavior == AWSDynamoDBObjectMapperSaveBehaviorAppendSet && isSet) ? @"ADD" : @"PUT";
+        attributeUpdates[attributeName] = @{@"Action" : action,
+                                            @"Value" : attributeValue};
+    }
+    return attributeUpdates;
+}
+
+- (NSDictionary<NSString *, NSDictionary *> *)keyFromModel:(AWSDynamoDBObjectModel *)model {
+    NSMutableDictionary<NSString *, NSDictionary *> *key = [NSMutableDictionary dictionaryWithCapacity:[self.keyAttributes count]];
+    if (self.usesJSONAdapter) {
+        NSDictionary<NSString *, id> *values = [self JSONValuesFromModel:model];
+        for (NSString *keyAttribute in self.keyAttributes) {
+            key[keyAttribute] = [[self class] attributeValueFromObject:values[keyAttribute]];
+        }
+        return key;
+    }
+
+    for (AWSDynamoDBObjectModelCodecProperty *property in self.properties) {
+        if (![self.keyAttributes containsObject:property.attributeName]) {
+            continue;
+        }
+        id value = [model valueForKey:property.propertyKey];
+        if (property.reversible) {
+            value = [property.transformer reverseTransformedValue:value];
+        }
+        key[property.attributeName] = [[self class] attributeValueFromObject:value];
+    }
+    return key;
+}
+
++ (NSDictionary *)attributeValueFromObject:(id)object {
+    static Class booleanClass = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        booleanClass = [[NSNumber numberWithBool:YES] class];
+    });
+
+    // NULL is not supported. Booleans must be checked ahead of NSNumber.
+    if ([object isKindOfClass:booleanClass]) {
+        return @{@"BOOL" : object};
+    } else if ([object isKindOfClass:[NSString class]]) {
+        return @{@"S" : object};
+    } else if ([object isKindOfClass:[NSNumber class]]) {
+        return @{@"N" : [object stringValue]};
+    } else if ([object isKindOfClass:[NSData class]]) {
+        return @{@"B" : object};
+    } else if ([object isKindOfClass:[NSSet class]] && [(NSSet *)object count] > 0) {
+        id anyObject = [object anyObject];
+        if ([anyObject isKindOfClass:[NSString class]]) {
+            return @{@"SS" : [object allObjects]};
+        } else if ([anyObject isKindOfClass:[NSNumber class]]) {
+            NSMutableArray<NSString *> *numbers = [NSMutableArray arrayWithCapacity:[(NSSet *)object count]];
+            for (NSNumber *number in object) {
+                [numbers addObject:[number stringValue]];
+            }
+            return @{@"NS" : numbers};
+        } else if ([anyObject isKindOfClass:[NSData class]]) {
+            return @{@"BS" : [object allObjects]};
+        }
+    } else if ([object isKindOfClass:[NSArray class]] && [(NSArray *)object count] > 0) {
+        NSMutableArray<NSDictionary *> *list = [NSMutableArray arrayWithCapacity:[(NSArray *)object count]];
+        for (id listItem in object) {
+            [list addObject:[self attributeValueFromObject:listItem]];
+        }
+        return @{@"L" : list};
+    } else if ([object isKindOfClass:[NSDictionary class]] && [(NSDictionary *)object count] > 0) {
+        NSMutableDictionary<NSString *, NSDictionary *> *map = [NSMutableDictionary dictionaryWithCapacity:[(NSDictionary *)object count]];
+        [(NSDictionary *)object enumerateKeysAndObjectsUsingBlock:^(NSString *mapItemKey, id mapItemValue, BOOL *stop) {
+            map[mapItemKey] = [self attributeValueFromObject:mapItemValue];
+        }];
+        return @{@"M" : map};
+    }
+
+    return @{};
+}
+
+#pragma mark - Decoding
+
+- (id)modelFromItem:(NSDictionary<NSString *, NSDictionary *> *)item
+              error:(NSError **)error {
+    if (self.usesJSONAdapter) {
+        NSMutableDictionary<NSString *, id> *JSONDictionary = [NSMutableDictionary dictionaryWithCapacity:[item count]];
+        [item enumerateKeysAndObjectsUsingBlock:^(NSString *attributeName, NSDictionary *attributeValue, BOOL *stop) {
+            id value = [[self class] objectFromAttributeValue:attributeValue];
+            if (value) {
+                JSONDictionary[attributeName] = value;
+            }
+        }];
+        return [AWSMTLJSONAdapter modelOfClass:self.modelClass
+                            fromJSONDictionary:JSONDictionary
+                                         error:error];
+    }
+
+    NSMutableDictionary<NSString *, id> *dictionaryValue = [NSMutableDictionary dictionaryWithCapacity:[item count]];
+    for (AWSDynamoDBObjectModelCodecProperty *property in self.properties) {
+        NSDictionary *attributeValue = item[property.attributeName];
+        if (![attributeValue isKindOfClass:[NSDictionary class]]) {
+            continue;
+        }
+        id value = [[self class] objectFromAttributeValue:attributeValue];
+        if (!value) {
+            continue;
+        }
+        if (property.transformer) {
+            value = [property.transformer transformedValue:value] ?: [NSNull null];
+        }
+        dictionaryValue[property.propertyKey] = value;
+    }
+    return [self.modelClass modelWithDictionary:dictionaryValue
+                                          error:error];
+}
+
+// Returns the member of an attribute value, treating `NSNull` as missing.
+static id AWSDynamoDBAttributeValueMember(NSDictionary *attributeValue, NSString *type) {
+    id member = attributeValue[type];
+    return member == [NSNull null] ? nil : member;
+}
+
++ (id)objectFromAttributeValue:(NSDictionary *)attributeValue {
+    id value = nil;
+    // NULL is not supported.
+    if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"BOOL"))) {
+        return value;
+    } else if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"S"))) {
+        return value;
+    } else if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"N"))) {
+        return [NSNumber aws_numberFromString:value];
+    } else if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"B"))) {
+        return value;
+    } else if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"SS"))) {
+        return [NSSet setWithArray:value];
+    } else if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"NS"))) {
+        NSMutableSet<NSNumber *> *numbers = [NSMutableSet setWithCapacity:[(NSArray *)value count]];
+        for (NSString *number in value) {
+            [numbers addObject:[NSNumber aws_numberFromString:number]];
+        }
+        return numbers;
+    } else if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"BS"))) {
+        return [NSSet setWithArray:value];
+    } else if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"L"))) {
+        NSMutableArray *list = [NSMutableArray arrayWithCapacity:[(NSArray *)value count]];
+        for (NSDictionary *listItemAttributeValue in value) {
+            id listItem = [self objectFromAttributeValue:listItemAttributeValue];
+            if (listItem) {
+                [list addObject:listItem];
+            }
+        }
+        return list;
+    } else if ((value = AWSDynamoDBAttributeValueMember(attributeValue, @"M"))) {
+        NSMutableDictionary<NSString *, id> *map = [NSMutableDictionary dictionaryWithCapacity:[(NSDictionary *)value count]];
+        [(NSDictionary *)value enumerateKeysAndObjectsUsingBlock:^(NSString *mapItemKey, NSDictionary *mapItemAttributeValue, BOOL *stop) {
+            id mapItem = [self objectFromAttributeValue:mapItemAttributeValue];
+            if (mapItem) {
+                map[mapItemKey] = mapItem;
+            }
+        }];
+        return map;
+    }
+
+    return nil;
+}
+
+@end
@@ -14,6 +14,7 @@
 //
 
 #import "AWSDynamoDBService.h"
+#import "AWSDynamoDB+ObjectMapper.h"
 #import <AWSCore/AWSCategory.h>
 #import <AWSCore/AWSNetworking.h>
 #import <AWSCore/AWSSignature.h>
@@ -1447,3 +1448,51 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 #pragma mark -
 
 @end
+
+@implementation AWSDynamoDB (ObjectMapper)
+
+- (AWSTask<AWSDynamoDBGetItemOutput *> *)aws_getItem:(AWSDynamoDBGetItemInput *)request
+                                         outputClass:(Class)outputClass {
+    NSParameterAssert([outputClass isSubclassOfClass:[AWSDynamoDBGetItemOutput class]]);
+    return [self invokeRequest:request
+                    HTTPMethod:AWSHTTPMethodPOST
+                     URLString:@""
+                  targetPrefix:@"DynamoDB_20120810"
+                 operationName:@"GetItem"
+                   outputClass:outputClass];
+}
+
+- (AWSTask<AWSDynamoDBQueryOutput *> *)aws_query:(AWSDynamoDBQueryInput *)request
+                                     outputClass:(Class)outputClass {
+    NSParameterAssert([outputClass isSubclassOfClass:[AWSDynamoDBQueryOutput class]]);
+    return [self invokeRequest:request
+                    HTTPMethod:AWSHTTPMethodPOST
+                     URLString:@""
+                  targetPrefix:@"DynamoDB_20120810"
+                 operationName:@"Query"
+                   outputClass:outputClass];
+}
+
+- (AWSTask<AWSDynamoDBScanOutput *> *)aws_scan:(AWSDynamoDBScanInput *)request
+                                   outputClass:(Class)outputClass {
+    NSParameterAssert([outputClass isSubclassOfClass:[AWSDynamoDBScanOutput class]]);
+    return [self invokeRequest:request
+                    HTTPMethod:AWSHTTPMethodPOST
+                     URLString:@""
+                  targetPrefix:@"DynamoDB_20120810"
+                 operationName:@"Scan"
+                   outputClass:outputClass];
+}
+
+- (AWSTask<AWSDynamoDBBatchGetItemOutput *> *)aws_batchGetItem:(AWSDynamoDBBatchGetItemInput *)request
+                                                   outputClass:(Class)outputClass {
+    NSParameterAssert([outputClass isSubclassOfClass:[AWSDynamoDBBatchGetItemOutput class]]);
+    return [self invokeRequest:request
+                    HTTPMethod:AWSHTTPMethodPOST
+                     URLString:@""
+                  targetPrefix:@"DynamoDB_20120810"
+                 operationName:@"BatchGetItem"
+                   outputClass:outputClass];
+}
+
+@end
@@ -2109,6 +2109,105 @@ static NSString *tableNameKeyOnly = nil;
     }] waitUntilFinished];
 }
 
+- (void)testBatchSaveBatchLoadAndParallelScan {
+    AWSDynamoDBObjectMapper *dynamoDBObjectMapper = [AWSDynamoDBObjectMapper defaultDynamoDBObjectMapper];
+
+    NSMutableArray<TestObject *> *testObjects = [NSMutableArray new];
+    for (int32_t i = 0; i < 500; i++) {
+        TestObject *testObject = [TestObject new];
+        testObject.hashKey = [NSString stringWithFormat:@"batch-hash-key-%02d", i % 10];
+        testObject.rangeKey = [NSString stringWithFormat:@"range-%03d", i];
+        testObject.stringAttribute = [NSString stringWithFormat:@"string-attr-%03d", i];
+        testObject.numberAttribute = @(i);
+        [testObjects addObject:testObject];
+    }
+
+    NSDate *start = [NSDate date];
+    AWSTask *task = [[dynamoDBObjectMapper batchSave:testObjects] waitUntilFinished];
+    XCTAssertNil(task.error);
+    NSLog(@"batchSave: %.0f items/sec", [testObjects count] / [[NSDate date] timeIntervalSinceDate:start]);
+
+    start = [NSDate date];
+    task = [[dynamoDBObjectMapper batchLoad:testObjects] waitUntilFinished];
+    XCTAssertNil(task.error);
+    NSLog(@"batchLoad: %.0f items/sec", [testObjects count] / [[NSDate date] timeIntervalSinceDate:start]);
+    NSArray<TestObject *> *loadedObjects = task.result;
+    XCTAssertEqual([loadedObjects count], [testObjects count]);
+    XCTAssertEqualObjects(loadedObjects[42].rangeKey, @"range-042");
+    XCTAssertEqualObjects(loadedObjects[42].stringAttribute, @"string-attr-042");
+
+    AWSDynamoDBScanExpression *scanExpression = [AWSDynamoDBScanExpression new];
+    scanExpression.filterExpression = @"begins_with(hashKey1, :prefix)";
+    scanExpression.expressionAttributeValues = @{@":prefix" : @"batch-hash-key-"};
+    NSMutableSet<NSString *> *scannedRangeKeys = [NSMutableSet new];
+    start = [NSDate date];
+    task = [[dynamoDBObjectMapper parallelScan:[TestObject class]
+                                    expression:scanExpression
+                                 totalSegments:8
+                         maxConcurrentSegments:4
+                                   pageHandler:^(NSArray<TestObject *> *items) {
+        for (TestObject *testObject in items) {
+            [scannedRangeKeys addObject:testObject.rangeKey];
+        }
+    }] waitUntilFinished];
+    XCTAssertNil(task.error);
+    NSLog(@"parallelScan: %.0f items/sec", [scannedRangeKeys count] / [[NSDate date] timeIntervalSinceDate:start]);
+    XCTAssertEqual([scannedRangeKeys count], [testObjects count]);
+
+    NSMutableArray *tasks = [NSMutableArray new];
+    for (TestObject *testObject in testObjects) {
+        [tasks addObject:[dynamoDBObjectMapper remove:testObject]];
+    }
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+}
+
+- (void)testLoadLatencyWithItemCache {
+    AWSDynamoDBObjectMapper *dynamoDBObjectMapper = [AWSDynamoDBObjectMapper defaultDynamoDBObjectMapper];
+
+    NSMutableArray<TestObject *> *testObjects = [NSMutableArray new];
+    for (int32_t i = 0; i < 20; i++) {
+        TestObject *testObject = [TestObject new];
+        testObject.hashKey = @"cache-hash-key";
+        testObject.rangeKey = [NSString stringWithFormat:@"range-%02d", i];
+        testObject.stringAttribute = [NSString stringWithFormat:@"string-attr-%02d", i];
+        testObject.numberAttribute = @(i);
+        [testObjects addObject:testObject];
+    }
+    XCTAssertNil([[dynamoDBObjectMapper batchSave:testObjects] waitUntilFinished].error);
+
+    AWSDynamoDBItemCache *itemCache = [AWSDynamoDBItemCache new];
+    for (NSNumber *usesItemCache in @[@NO, @YES]) {
+        AWSDynamoDBObjectMapperConfiguration *configuration = [AWSDynamoDBObjectMapperConfiguration new];
+        configuration.itemCache = [usesItemCache boolValue] ? itemCache : nil;
+
+        NSMutableArray<NSNumber *> *latencies = [NSMutableArray new];
+        for (NSUInteger i = 0; i < 200; i++) {
+            TestObject *testObject = testObjects[i % [testObjects count]];
+            NSDate *start = [NSDate date];
+            AWSTask *task = [[dynamoDBObjectMapper load:[TestObject class]
+                                                hashKey:testObject.hashKey
+                                               rangeKey:testObject.rangeKey
+                                          configuration:configuration] waitUntilFinished];
+            [latencies addObject:@([[NSDate date] timeIntervalSinceDate:start] * 1000)];
+            XCTAssertNil(task.error);
+            XCTAssertEqualObjects([task.result stringAttribute], testObject.stringAttribute);
+        }
+        [latencies sortUsingSelector:@selector(compare:)];
+        NSLog(@"load %@ item cache: p50 %.2f ms, p99 %.2f ms",
+              configuration.itemCache ? @"with" : @"without",
+              [latencies[[latencies count] / 2] doubleValue],
+              [latencies[[latencies count] * 99 / 100] doubleValue]);
+    }
+    XCTAssertEqual(itemCache.missCount, [testObjects count]);
+    XCTAssertEqual(itemCache.hitCount, 200 - [testObjects count]);
+
+    NSMutableArray *tasks = [NSMutableArray new];
+    for (TestObject *testObject in testObjects) {
+        [tasks addObject:[dynamoDBObjectMapper remove:testObject]];
+    }
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+}
+
 - (void)testError {
     AWSDynamoDBObjectMapper *dynamoDBObjectMapper = [AWSDynamoDBObjectMapper defaultDynamoDBObjectMapper];
     
@@ -0,0 +1,287 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSDynamoDB.h"
+
+static NSString *const AWSDynamoDBItemCacheTestTableName = @"AWSDynamoDBItemCacheTestTable";
+
+@interface AWSDynamoDB()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+- (AWSTask *)invokeRequest:(AWSRequest *)request
+               HTTPMethod:(AWSHTTPMethod)HTTPMethod
+                URLString:(NSString *) URLString
+             targetPrefix:(NSString *)targetPrefix
+            operationName:(NSString *)operationName
+              outputClass:(Class)outputClass;
+
+@end
+
+@interface AWSDynamoDBItemCache()
+
+- (NSUInteger)currentGeneration;
+- (BOOL)cachedItem:(NSDictionary **)item
+            forKey:(NSString *)key;
+- (void)setItem:(NSDictionary *)item
+         forKey:(NSString *)key
+      tableName:(NSString *)tableName
+     generation:(NSUInteger)generation;
+- (void)removeItemForKey:(NSString *)key;
+
+@end
+
+@interface AWSDynamoDBItemCacheTestItem : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *itemId;
+@property (nonatomic, strong) NSString *value;
+
+@end
+
+@implementation AWSDynamoDBItemCacheTestItem
+
++ (NSString *)dynamoDBTableName {
+    return AWSDynamoDBItemCacheTestTableName;
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"itemId";
+}
+
+@end
+
+// An in-memory table that counts GetItem calls.
+@interface AWSDynamoDBItemCacheTestDynamoDB : AWSDynamoDB
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *items;
+@property (nonatomic, assign) NSUInteger getItemCount;
+@property (nonatomic, strong) NSDictionary *lastGetItemParameters;
+
+@end
+
+@implementation AWSDynamoDBItemCacheTestDynamoDB
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration {
+    if (self = [super initWithConfiguration:configuration]) {
+        _items = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (AWSTask *)invokeRequest:(AWSRequest *)request
+               HTTPMethod:(AWSHTTPMethod)HTTPMethod
+                URLString:(NSString *) URLString
+             targetPrefix:(NSString *)targetPrefix
+            operationName:(NSString *)operationName
+              outputClass:(Class)outputClass {
+    NSDictionary *parameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:request] aws_removeNullValues];
+    NSDictionary *response = @{};
+    @synchronized(self) {
+        if ([operationName isEqualToString:@"GetItem"]) {
+            self.getItemCount++;
+            self.lastGetItemParameters = parameters;
+            NSDictionary *item = self.items[parameters[@"Key"][@"itemId"][@"S"]];
+            response = item ? @{@"Item" : item} : @{};
+        } else if ([operationName isEqualToString:@"PutItem"]) {
+            self.items[parameters[@"Item"][@"itemId"][@"S"]] = parameters[@"Item"];
+        } else if ([operationName isEqualToString:@"UpdateItem"]) {
+            NSString *itemId = parameters[@"Key"][@"itemId"][@"S"];
+            NSMutableDictionary *item = [self.items[itemId] mutableCopy] ?: [parameters[@"Key"] mutableCopy];
+            [parameters[@"AttributeUpdates"] enumerateKeysAndObjectsUsingBlock:^(NSString *attributeName, NSDictionary *update, BOOL *stop) {
+                if ([update[@"Action"] isEqualToString:@"DELETE"]) {
+                    [item removeObjectForKey:attributeName];
+                } else {
+                    item[attributeName] = update[@"Value"];
+                }
+            }];
+            self.items[itemId] = item;
+        } else if ([operationName isEqualToString:@"DeleteItem"]) {
+            [self.items removeObjectForKey:parameters[@"Key"][@"itemId"][@"S"]];
+        } else if ([operationName isEqualToString:@"BatchWriteItem"]) {
+            for (NSDictionary *writeRequest in parameters[@"RequestItems"][AWSDynamoDBItemCacheTestTableName]) {
+                NSDictionary *item = writeRequest[@"PutRequest"][@"Item"];
+                self.items[item[@"itemId"][@"S"]] = item;
+            }
+        }
+    }
+    return [AWSTask taskWithResult:[AWSMTLJSONAdapter modelOfClass:outputClass
+                                                fromJSONDictionary:response
+                                                             error:nil]];
+}
+
+@end
+
+@interface AWSDynamoDBItemCacheTests : XCTestCase
+
+@property (nonatomic, strong) AWSDynamoDBItemCache *itemCache;
+@property (nonatomic, strong) AWSDynamoDBObjectMapper *objectMapper;
+@property (nonatomic, strong) AWSDynamoDBItemCacheTestDynamoDB *dynamoDB;
+
+@end
+
+@implementation AWSDynamoDBItemCacheTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    self.itemCache = [AWSDynamoDBItemCache new];
+    AWSDynamoDBObjectMapperConfiguration *objectMapperConfiguration = [AWSDynamoDBObjectMapperConfiguration new];
+    objectMapperConfiguration.itemCache = self.itemCache;
+
+    AWSServiceConfiguration *configuration = [AWSServiceManager defaultServiceManager].defaultServiceConfiguration;
+    [AWSDynamoDBObjectMapper registerDynamoDBObjectMapperWithConfiguration:configuration
+                                                 objectMapperConfiguration:objectMapperConfiguration
+                                                                    forKey:NSStringFromClass([self class])];
+    self.objectMapper = [AWSDynamoDBObjectMapper DynamoDBObjectMapperForKey:NSStringFromClass([self class])];
+    self.dynamoDB = [[AWSDynamoDBItemCacheTestDynamoDB alloc] initWithConfiguration:configuration];
+    [self.objectMapper setValue:self.dynamoDB forKey:@"dynamoDB"];
+}
+
+- (void)tearDown {
+    [AWSDynamoDBObjectMapper removeDynamoDBObjectMapperForKey:NSStringFromClass([self class])];
+    [super tearDown];
+}
+
+- (AWSDynamoDBItemCacheTestItem *)loadItemWithId:(NSString *)itemId {
+    AWSTask *task = [[self.objectMapper load:[AWSDynamoDBItemCacheTestItem class]
+                                     hashKey:itemId
+                                    rangeKey:nil] waitUntilFinished];
+    XCTAssertNil(task.error);
+    return task.result;
+}
+
+- (void)saveItemWithId:(NSString *)itemId
+                 value:(NSString *)value {
+    AWSDynamoDBItemCacheTestItem *item = [AWSDynamoDBItemCacheTestItem new];
+    item.itemId = itemId;
+    item.value = value;
+    XCTAssertNil([[self.objectMapper save:item] waitUntilFinished].error);
+}
+
+- (void)testLoadIsAnsweredFromCache {
+    [self saveItemWithId:@"item-1" value:@"value-1"];
+
+    AWSDynamoDBItemCacheTestItem *first = [self loadItemWithId:@"item-1"];
+    AWSDynamoDBItemCacheTestItem *second = [self loadItemWithId:@"item-1"];
+
+    XCTAssertEqual(self.dynamoDB.getItemCount, 1);
+    XCTAssertEqualObjects(second.value, @"value-1");
+    XCTAssertEqualObjects(first, second);
+    XCTAssertNotEqual(first, second);
+    XCTAssertEqual(self.itemCache.hitCount, 1);
+    XCTAssertEqual(self.itemCache.missCount, 1);
+}
+
+- (void)testMissingItemsAreCached {
+    XCTAssertNil([self loadItemWithId:@"missing"]);
+    XCTAssertNil([self loadItemWithId:@"missing"]);
+    XCTAssertEqual(self.dynamoDB.getItemCount, 1);
+
+    self.itemCache.cachesMissingItems = NO;
+    XCTAssertNil([self loadItemWithId:@"other-missing"]);
+    XCTAssertNil([self loadItemWithId:@"other-missing"]);
+    XCTAssertEqual(self.dynamoDB.getItemCount, 3);
+}
+
+- (void)testSaveAndRemoveInvalidate {
+    [self saveItemWithId:@"item-1" value:@"value-1"];
+    XCTAssertEqualObjects([self loadItemWithId:@"item-1"].value, @"value-1");
+
+    [self saveItemWithId:@"item-1" value:@"value-2"];
+    XCTAssertEqualObjects([self loadItemWithId:@"item-1"].value, @"value-2");
+    XCTAssertEqual(self.dynamoDB.getItemCount, 2);
+
+    XCTAssertNil([[self.objectMapper remove:[self loadItemWithId:@"item-1"]] waitUntilFinished].error);
+    XCTAssertNil([self loadItemWithId:@"item-1"]);
+    XCTAssertEqual(self.dynamoDB.getItemCount, 3);
+
+    AWSDynamoDBItemCacheTestItem *item = [AWSDynamoDBItemCacheTestItem new];
+    item.itemId = @"item-1";
+    item.value = @"value-3";
+    XCTAssertNil([[self.objectMapper batchSave:@[item]] waitUntilFinished].error);
+    XCTAssertEqualObjects([self loadItemWithId:@"item-1"].value, @"value-3");
+    XCTAssertEqual(self.dynamoDB.getItemCount, 4);
+}
+
+- (void)testConsistentReadBypassesCache {
+    [self saveItemWithId:@"item-1" value:@"value-1"];
+    AWSDynamoDBObjectMapperConfiguration *configuration = [self.objectMapper.objectMapperConfiguration copy];
+    configuration.consistentRead = @YES;
+    XCTAssertEqual(configuration.itemCache, self.itemCache);
+
+    for (NSUInteger i = 0; i < 2; i++) {
+        AWSTask *task = [[self.objectMapper load:[AWSDynamoDBItemCacheTestItem class]
+                                         hashKey:@"item-1"
+                                        rangeKey:nil
+                                   configuration:configuration] waitUntilFinished];
+        XCTAssertEqualObjects([task.result value], @"value-1");
+    }
+    XCTAssertEqual(self.dynamoDB.getItemCount, 2);
+    XCTAssertEqualObjects(self.dynamoDB.lastGetItemParameters[@"ConsistentRead"], @YES);
+    XCTAssertEqual(self.itemCache.hitCount + self.itemCache.missCount, 0);
+}
+
+- (void)testLeastRecentlyUsedItemsAreEvicted {
+    AWSDynamoDBItemCache *itemCache = [[AWSDynamoDBItemCache alloc] initWithMaximumBytes:100];
+    NSDictionary *item = @{@"value" : @{@"S" : @"0123456789"}};
+    for (NSUInteger i = 0; i < 10; i++) {
+        [itemCache setItem:item
+                    forKey:[NSString stringWithFormat:@"key-%lu", (unsigned long)i]
+                 tableName:AWSDynamoDBItemCacheTestTableName
+                generation:[itemCache currentGeneration]];
+        // Keeps the first key recently used.
+        NSDictionary *cachedItem = nil;
+        XCTAssertTrue([itemCache cachedItem:&cachedItem forKey:@"key-0"]);
+    }
+
+    XCTAssertLessThanOrEqual(itemCache.totalBytes, 100);
+    XCTAssertGreaterThan(itemCache.evictionCount, 0);
+    XCTAssertEqual(itemCache.count + itemCache.evictionCount, 10);
+    NSDictionary *cachedItem = nil;
+    XCTAssertTrue([itemCache cachedItem:&cachedItem forKey:@"key-0"]);
+    XCTAssertEqualObjects(cachedItem, item);
+    XCTAssertTrue([itemCache cachedItem:&cachedItem forKey:@"key-9"]);
+    XCTAssertFalse([itemCache cachedItem:&cachedItem forKey:@"key-1"]);
+}
+
+- (void)testItemsExpire {
+    AWSDynamoDBItemCache *itemCache = [AWSDynamoDBItemCache new];
+    [itemCache setTimeToLive:0.1 forTableName:@"ShortLived"];
+    [itemCache setTimeToLive:0 forTableName:@"Uncached"];
+    NSDictionary *item = @{@"value" : @{@"S" : @"value"}};
+    for (NSString *tableName in @[@"ShortLived", @"Uncached", AWSDynamoDBItemCacheTestTableName]) {
+        [itemCache setItem:item forKey:tableName tableName:tableName generation:[itemCache currentGeneration]];
+    }
+    XCTAssertEqual(itemCache.count, 2);
+
+    [NSThread sleepForTimeInterval:0.2];
+    NSDictionary *cachedItem = nil;
+    XCTAssertFalse([itemCache cachedItem:&cachedItem forKey:@"ShortLived"]);
+    XCTAssertTrue([itemCache cachedItem:&cachedItem forKey:AWSDynamoDBItemCacheTestTableName]);
+}
+
+- (void)testLoadRacingWriteIsNotCached {
+    NSUInteger generation = [self.itemCache currentGeneration];
+    [self.itemCache removeItemForKey:@"key"];
+    [self.itemCache setItem:@{} forKey:@"key" tableName:AWSDynamoDBItemCacheTestTableName generation:generation];
+
+    NSDictionary *cachedItem = nil;
+    XCTAssertFalse([self.itemCache cachedItem:&cachedItem forKey:@"key"]);
+}
+
+@end
@@ -0,0 +1,289 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSDynamoDB.h"
+
+static NSString *const AWSDynamoDBBatchTestTableName = @"AWSDynamoDBBatchTestTable";
+
+@interface AWSDynamoDB()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+- (AWSTask *)invokeRequest:(AWSRequest *)request
+               HTTPMethod:(AWSHTTPMethod)HTTPMethod
+                URLString:(NSString *) URLString
+             targetPrefix:(NSString *)targetPrefix
+            operationName:(NSString *)operationName
+              outputClass:(Class)outputClass;
+
+@end
+
+@interface AWSDynamoDBBatchTestItem : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *itemId;
+@property (nonatomic, strong) NSNumber *value;
+
+@end
+
+@implementation AWSDynamoDBBatchTestItem
+
++ (NSString *)dynamoDBTableName {
+    return AWSDynamoDBBatchTestTableName;
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"itemId";
+}
+
+@end
+
+// An in-memory table that leaves half of every first batch unprocessed and pages scans by 10 items. Requests and
+// responses go through their JSON form, the way they would over the network.
+@interface AWSDynamoDBBatchTestDynamoDB : AWSDynamoDB
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *items;
+@property (nonatomic, assign) NSUInteger batchGetItemCount;
+@property (nonatomic, assign) NSUInteger batchWriteItemCount;
+@property (nonatomic, assign) NSUInteger scanCount;
+@property (nonatomic, assign) NSUInteger maximumBatchGetItemKeys;
+@property (nonatomic, assign) NSUInteger maximumBatchWriteItemItems;
+@property (nonatomic, strong) NSMutableSet<NSNumber *> *scannedSegments;
+@property (nonatomic, assign) BOOL leavesUnprocessed;
+
+@end
+
+@implementation AWSDynamoDBBatchTestDynamoDB
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration {
+    if (self = [super initWithConfiguration:configuration]) {
+        _items = [NSMutableDictionary new];
+        _scannedSegments = [NSMutableSet new];
+        _leavesUnprocessed = YES;
+    }
+    return self;
+}
+
+- (AWSTask *)invokeRequest:(AWSRequest *)request
+               HTTPMethod:(AWSHTTPMethod)HTTPMethod
+                URLString:(NSString *) URLString
+             targetPrefix:(NSString *)targetPrefix
+            operationName:(NSString *)operationName
+              outputClass:(Class)outputClass {
+    NSDictionary *parameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:request] aws_removeNullValues];
+    NSDictionary *response = nil;
+    @synchronized(self) {
+        if ([operationName isEqualToString:@"BatchWriteItem"]) {
+            response = [self batchWriteItemResponse:parameters];
+        } else if ([operationName isEqualToString:@"BatchGetItem"]) {
+            response = [self batchGetItemResponse:parameters];
+        } else if ([operationName isEqualToString:@"Scan"]) {
+            response = [self scanResponse:parameters];
+        } else {
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSDynamoDBErrorDomain
+                                                              code:AWSDynamoDBErrorUnknown
+                                                          userInfo:nil]];
+        }
+    }
+
+    NSError *error = nil;
+    id output = [AWSMTLJSONAdapter modelOfClass:outputClass
+                             fromJSONDictionary:response
+                                          error:&error];
+    return error ? [AWSTask taskWithError:error] : [AWSTask taskWithResult:output];
+}
+
+- (NSDictionary *)batchWriteItemResponse:(NSDictionary *)parameters {
+    self.batchWriteItemCount++;
+    NSArray<NSDictionary *> *writeRequests = parameters[@"RequestItems"][AWSDynamoDBBatchTestTableName];
+    self.maximumBatchWriteItemItems = MAX(self.maximumBatchWriteItemItems, [writeRequests count]);
+
+    NSUInteger processedCount = self.leavesUnprocessed && [writeRequests count] > 1 ? [writeRequests count] / 2 : [writeRequests count];
+    for (NSDictionary *writeRequest in [writeRequests subarrayWithRange:NSMakeRange(0, processedCount)]) {
+        NSDictionary *item = writeRequest[@"PutRequest"][@"Item"];
+        self.items[item[@"itemId"][@"S"]] = item;
+    }
+    if (processedCount == [writeRequests count]) {
+        return @{};
+    }
+    return @{@"UnprocessedItems" : @{AWSDynamoDBBatchTestTableName : [writeRequests subarrayWithRange:NSMakeRange(processedCount, [writeRequests count] - processedCount)]}};
+}
+
+- (NSDictionary *)batchGetItemResponse:(NSDictionary *)parameters {
+    self.batchGetItemCount++;
+    NSArray<NSDictionary *> *keys = parameters[@"RequestItems"][AWSDynamoDBBatchTestTableName][@"Keys"];
+    self.maximumBatchGetItemKeys = MAX(self.maximumBatchGetItemKeys, [keys count]);
+
+    NSUInteger processedCount = self.leavesUnprocessed && [keys count] > 1 ? [keys count] / 2 : [keys count];
+    NSMutableArray<NSDictionary *> *responses = [NSMutableArray new];
+    for (NSDictionary *key in [keys subarrayWithRange:NSMakeRange(0, processedCount)]) {
+        NSDictionary *item = self.items[key[@"itemId"][@"S"]];
+        if (item) {
+            [responses addObject:item];
+        }
+    }
+    if (processedCount == [keys count]) {
+        return @{@"Responses" : @{AWSDynamoDBBatchTestTableName : responses}};
+    }
+    return @{@"Responses" : @{AWSDynamoDBBatchTestTableName : responses},
+             @"UnprocessedKeys" : @{AWSDynamoDBBatchTestTableName : @{@"Keys" : [keys subarrayWithRange:NSMakeRange(processedCount, [keys count] - processedCount)]}}};
+}
+
+- (NSDictionary *)scanResponse:(NSDictionary *)parameters {
+    self.scanCount++;
+    NSUInteger segment = [parameters[@"Segment"] unsignedIntegerValue];
+    NSUInteger totalSegments = [parameters[@"TotalSegments"] unsignedIntegerValue];
+    [self.scannedSegments addObject:@(segment)];
+
+    NSMutableArray<NSString *> *segmentIds = [NSMutableArray new];
+    for (NSString *itemId in [[self.items allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+        if ([itemId hash] % totalSegments == segment) {
+            [segmentIds addObject:itemId];
+        }
+    }
+    NSUInteger start = 0;
+    if (parameters[@"ExclusiveStartKey"]) {
+        start = [segmentIds indexOfObject:parameters[@"ExclusiveStartKey"][@"itemId"][@"S"]] + 1;
+    }
+    NSUInteger end = MIN(start + 10, [segmentIds count]);
+    NSMutableArray<NSDictionary *> *items = [NSMutableArray new];
+    for (NSUInteger i = start; i < end; i++) {
+        [items addObject:self.items[segmentIds[i]]];
+    }
+    if (end == [segmentIds count]) {
+        return @{@"Items" : items};
+    }
+    return @{@"Items" : items,
+             @"LastEvaluatedKey" : @{@"itemId" : self.items[segmentIds[end - 1]][@"itemId"]}};
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperBatchTests : XCTestCase
+
+@property (nonatomic, strong) AWSDynamoDBObjectMapper *objectMapper;
+@property (nonatomic, strong) AWSDynamoDBBatchTestDynamoDB *dynamoDB;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperBatchTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [AWSServiceManager defaultServiceManager].defaultServiceConfiguration;
+    [AWSDynamoDBObjectMapper registerDynamoDBObjectMapperWithConfiguration:configuration
+                                                 objectMapperConfiguration:[AWSDynamoDBObjectMapperConfiguration new]
+                                                                    forKey:NSStringFromClass([self class])];
+    self.objectMapper = [AWSDynamoDBObjectMapper DynamoDBObjectMapperForKey:NSStringFromClass([self class])];
+    self.dynamoDB = [[AWSDynamoDBBatchTestDynamoDB alloc] initWithConfiguration:configuration];
+    [self.objectMapper setValue:self.dynamoDB forKey:@"dynamoDB"];
+}
+
+- (void)tearDown {
+    [AWSDynamoDBObjectMapper removeDynamoDBObjectMapperForKey:NSStringFromClass([self class])];
+    [super tearDown];
+}
+
+- (NSArray<AWSDynamoDBBatchTestItem *> *)itemsWithCount:(NSUInteger)count {
+    NSMutableArray<AWSDynamoDBBatchTestItem *> *items = [NSMutableArray new];
+    for (NSUInteger i = 0; i < count; i++) {
+        AWSDynamoDBBatchTestItem *item = [AWSDynamoDBBatchTestItem new];
+        item.itemId = [NSString stringWithFormat:@"item-%04lu", (unsigned long)i];
+        item.value = @(i);
+        [items addObject:item];
+    }
+    return items;
+}
+
+- (void)testBatchSaveRetriesUnprocessedItems {
+    AWSTask *task = [[self.objectMapper batchSave:[self itemsWithCount:100]] waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([self.dynamoDB.items count], 100);
+    XCTAssertEqualObjects(self.dynamoDB.items[@"item-0042"][@"value"][@"N"], @"42");
+    XCTAssertEqual(self.dynamoDB.maximumBatchWriteItemItems, 25);
+    // Four batches of 25, each retried until its last item was processed.
+    XCTAssertGreaterThan(self.dynamoDB.batchWriteItemCount, 4);
+}
+
+- (void)testBatchSaveKeepsLastObjectWithSameKey {
+    NSArray<AWSDynamoDBBatchTestItem *> *items = [self itemsWithCount:3];
+    AWSDynamoDBBatchTestItem *duplicate = [AWSDynamoDBBatchTestItem new];
+    duplicate.itemId = items[1].itemId;
+    duplicate.value = @100;
+    self.dynamoDB.leavesUnprocessed = NO;
+
+    AWSTask *task = [[self.objectMapper batchSave:[items arrayByAddingObject:duplicate]] waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual(self.dynamoDB.batchWriteItemCount, 1);
+    XCTAssertEqualObjects(self.dynamoDB.items[@"item-0001"][@"value"][@"N"], @"100");
+}
+
+- (void)testBatchLoadReturnsObjectsInOrder {
+    [[self.objectMapper batchSave:[self itemsWithCount:250]] waitUntilFinished];
+
+    NSMutableArray<AWSDynamoDBBatchTestItem *> *keys = [NSMutableArray new];
+    for (NSInteger i = 249; i >= 0; i -= 2) {
+        AWSDynamoDBBatchTestItem *key = [AWSDynamoDBBatchTestItem new];
+        key.itemId = [NSString stringWithFormat:@"item-%04ld", (long)i];
+        [keys addObject:key];
+    }
+    AWSDynamoDBBatchTestItem *missingKey = [AWSDynamoDBBatchTestItem new];
+    missingKey.itemId = @"missing";
+    [keys insertObject:missingKey atIndex:3];
+
+    AWSTask<NSArray<AWSDynamoDBBatchTestItem *> *> *task = [[self.objectMapper batchLoad:keys] waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([task.result count], 125);
+    XCTAssertEqualObjects(task.result[0].itemId, @"item-0249");
+    XCTAssertEqualObjects(task.result[0].value, @249);
+    XCTAssertEqualObjects(task.result[3].itemId, @"item-0243");
+    XCTAssertEqual(self.dynamoDB.maximumBatchGetItemKeys, 100);
+}
+
+- (void)testBatchSaveRetriesUntilAllItemsAreProcessed {
+    // Every call leaves half of its items unprocessed, so two items take a single retry.
+    AWSTask *task = [[self.objectMapper batchSave:[self itemsWithCount:2]] waitUntilFinished];
+    XCTAssertNil(task.error);
+    XCTAssertEqual(self.dynamoDB.batchWriteItemCount, 2);
+}
+
+- (void)testParallelScanVisitsEverySegment {
+    self.dynamoDB.leavesUnprocessed = NO;
+    [[self.objectMapper batchSave:[self itemsWithCount:300]] waitUntilFinished];
+
+    NSMutableSet<NSString *> *itemIds = [NSMutableSet new];
+    AWSTask *task = [[self.objectMapper parallelScan:[AWSDynamoDBBatchTestItem class]
+                                          expression:[AWSDynamoDBScanExpression new]
+                                       totalSegments:8
+                               maxConcurrentSegments:3
+                                         pageHandler:^(NSArray<AWSDynamoDBBatchTestItem *> *items) {
+        for (AWSDynamoDBBatchTestItem *item in items) {
+            [itemIds addObject:item.itemId];
+        }
+    }] waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([itemIds count], 300);
+    XCTAssertEqual([self.dynamoDB.scannedSegments count], 8);
+    XCTAssertGreaterThanOrEqual(self.dynamoDB.scanCount, 30);
+}
+
+@end
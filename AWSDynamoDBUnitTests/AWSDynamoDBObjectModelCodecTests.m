@@ -0,0 +1,316 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSDynamoDB.h"
+#import "AWSDynamoDBObjectModelCodec.h"
+
+@interface AWSDynamoDBAttributeValue (AWSDynamoDBObjectMapper)
+
+- (void)aws_setAttributeValue:(id)attributeValue;
+- (id)aws_getAttributeValue;
+
+@end
+
+@interface AWSDynamoDBCodecTestItem : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *itemId;
+@property (nonatomic, strong) NSNumber *version;
+@property (nonatomic, strong) NSString *name;
+@property (nonatomic, strong) NSNumber *count;
+@property (nonatomic, strong) NSNumber *enabled;
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, strong) NSSet<NSString *> *tags;
+@property (nonatomic, strong) NSSet<NSNumber *> *scores;
+@property (nonatomic, strong) NSArray *list;
+@property (nonatomic, strong) NSDictionary *map;
+@property (nonatomic, strong) NSDate *createdAt;
+@property (nonatomic, strong) NSString *localOnly;
+
+@end
+
+@implementation AWSDynamoDBCodecTestItem
+
++ (NSString *)dynamoDBTableName {
+    return @"AWSDynamoDBCodecTestTable";
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"itemId";
+}
+
++ (NSString *)rangeKeyAttribute {
+    return @"version";
+}
+
++ (NSArray<NSString *> *)ignoreAttributes {
+    return @[@"localOnly"];
+}
+
++ (NSDictionary *)JSONKeyPathsByPropertyKey {
+    return @{@"name" : @"displayName"};
+}
+
++ (NSValueTransformer *)createdAtJSONTransformer {
+    return [AWSMTLValueTransformer reversibleTransformerWithForwardBlock:^id(NSNumber *seconds) {
+        return [NSDate dateWithTimeIntervalSince1970:[seconds doubleValue]];
+    } reverseBlock:^id(NSDate *date) {
+        return @((long long)[date timeIntervalSince1970]);
+    }];
+}
+
+@end
+
+@interface AWSDynamoDBObjectModelCodecTests : XCTestCase
+
+@end
+
+@implementation AWSDynamoDBObjectModelCodecTests
+
+- (AWSDynamoDBCodecTestItem *)testItem {
+    AWSDynamoDBCodecTestItem *item = [AWSDynamoDBCodecTestItem new];
+    item.itemId = @"item-1";
+    item.version = @3;
+    item.name = @"name";
+    item.count = @42.5;
+    item.enabled = @YES;
+    item.data = [@"data" dataUsingEncoding:NSUTF8StringEncoding];
+    item.tags = [NSSet setWithArray:@[@"a", @"b", @"c"]];
+    item.scores = [NSSet setWithArray:@[@1, @2, @3]];
+    item.list = @[@"one", @2, @{@"three" : @[@NO, @"four"]}];
+    item.map = @{@"key" : @"value", @"nested" : @{@"number" : @7}};
+    item.createdAt = [NSDate dateWithTimeIntervalSince1970:1600000000];
+    return item;
+}
+
+// The item the mapper built through `AWSDynamoDBAttributeValue` before the codec, in JSON form.
+- (NSDictionary *)attributeValueItemFromModel:(AWSDynamoDBObjectModel *)model
+                       attributeValueCount:(NSUInteger *)attributeValueCount {
+    NSDictionary *dictionaryValue = [AWSMTLJSONAdapter JSONDictionaryFromModel:model];
+    NSMutableDictionary *item = [NSMutableDictionary new];
+    for (NSString *key in dictionaryValue) {
+        if (dictionaryValue[key] == [NSNull null]
+            || ([[model class] respondsToSelector:@selector(ignoreAttributes)] && [[[model class] ignoreAttributes] containsObject:key])) {
+            continue;
+        }
+        AWSDynamoDBAttributeValue *attributeValue = [AWSDynamoDBAttributeValue new];
+        [attributeValue aws_setAttributeValue:dictionaryValue[key]];
+        if (attributeValueCount) {
+            *attributeValueCount += [self countOfAttributeValues:attributeValue];
+        }
+        item[key] = attributeValue;
+    }
+    return [AWSModelUtility JSONDictionaryFromMapMTLDictionary:item];
+}
+
+- (NSUInteger)countOfAttributeValues:(AWSDynamoDBAttributeValue *)attributeValue {
+    NSUInteger count = 1;
+    for (AWSDynamoDBAttributeValue *listItem in attributeValue.L) {
+        count += [self countOfAttributeValues:listItem];
+    }
+    for (AWSDynamoDBAttributeValue *mapItem in [attributeValue.M allValues]) {
+        count += [self countOfAttributeValues:mapItem];
+    }
+    return count;
+}
+
+// The model the mapper read through `AWSDynamoDBAttributeValue` before the codec.
+- (id)attributeValueModelOfClass:(Class)modelClass
+                        fromItem:(NSDictionary *)item {
+    NSDictionary *attributeValues = [AWSModelUtility mapMTLDictionaryFromJSONDictionary:item
+                                                                          withModelClass:[AWSDynamoDBAttributeValue class]];
+    NSMutableDictionary *JSONDictionary = [NSMutableDictionary new];
+    for (NSString *key in attributeValues) {
+        id value = [attributeValues[key] aws_getAttributeValue];
+        if (value) {
+            JSONDictionary[key] = value;
+        }
+    }
+    return [AWSMTLJSONAdapter modelOfClass:modelClass
+                        fromJSONDictionary:JSONDictionary
+                                     error:nil];
+}
+
+- (void)testItemMatchesAttributeValueMapping {
+    AWSDynamoDBCodecTestItem *model = [self testItem];
+    model.localOnly = @"local";
+    NSDictionary *item = [[AWSDynamoDBObjectModelCodec codecForClass:[AWSDynamoDBCodecTestItem class]] itemFromModel:model];
+
+    NSDictionary *expectedItem = [self attributeValueItemFromModel:model
+                                               attributeValueCount:NULL];
+    XCTAssertEqualObjects([AWSModelUtility mapMTLDictionaryFromJSONDictionary:item withModelClass:[AWSDynamoDBAttributeValue class]],
+                          [AWSModelUtility mapMTLDictionaryFromJSONDictionary:expectedItem withModelClass:[AWSDynamoDBAttributeValue class]]);
+
+    XCTAssertEqualObjects(item[@"displayName"], @{@"S" : @"name"});
+    XCTAssertEqualObjects(item[@"count"], @{@"N" : @"42.5"});
+    XCTAssertEqualObjects(item[@"enabled"], @{@"BOOL" : @YES});
+    XCTAssertEqualObjects(item[@"createdAt"], @{@"N" : @"1600000000"});
+    XCTAssertEqualObjects(item[@"map"][@"M"][@"nested"], @{@"M" : @{@"number" : @{@"N" : @"7"}}});
+    XCTAssertNil(item[@"localOnly"]);
+    XCTAssertNil(item[@"name"]);
+}
+
+- (void)testModelRoundTrip {
+    AWSDynamoDBObjectModelCodec *codec = [AWSDynamoDBObjectModelCodec codecForClass:[AWSDynamoDBCodecTestItem class]];
+    AWSDynamoDBCodecTestItem *model = [self testItem];
+
+    NSError *error = nil;
+    AWSDynamoDBCodecTestItem *decodedModel = [codec modelFromItem:[codec itemFromModel:model]
+                                                            error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(decodedModel, model);
+    XCTAssertEqualObjects(decodedModel, [self attributeValueModelOfClass:[AWSDynamoDBCodecTestItem class]
+                                                                fromItem:[codec itemFromModel:model]]);
+}
+
+- (void)testModelFromItemSkipsNullAndUnknownAttributes {
+    AWSDynamoDBObjectModelCodec *codec = [AWSDynamoDBObjectModelCodec codecForClass:[AWSDynamoDBCodecTestItem class]];
+    NSError *error = nil;
+    AWSDynamoDBCodecTestItem *model = [codec modelFromItem:@{@"itemId" : @{@"S" : @"item-1"},
+                                                             @"version" : @{@"N" : @"1"},
+                                                             @"displayName" : @{@"NULL" : @YES},
+                                                             @"unknown" : @{@"S" : @"unknown"}}
+                                                     error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(model.itemId, @"item-1");
+    XCTAssertEqualObjects(model.version, @1);
+    XCTAssertNil(model.name);
+}
+
+- (void)testKeyAndAttributeUpdates {
+    AWSDynamoDBObjectModelCodec *codec = [AWSDynamoDBObjectModelCodec codecForClass:[AWSDynamoDBCodecTestItem class]];
+    AWSDynamoDBCodecTestItem *model = [self testItem];
+    model.name = nil;
+
+    XCTAssertEqualObjects([codec keyFromModel:model], (@{@"itemId" : @{@"S" : @"item-1"},
+                                                         @"version" : @{@"N" : @"3"}}));
+
+    NSDictionary *updates = [codec attributeUpdatesFromModel:model
+                                                saveBehavior:AWSDynamoDBObjectMapperSaveBehaviorUpdate];
+    XCTAssertNil(updates[@"itemId"]);
+    XCTAssertNil(updates[@"localOnly"]);
+    XCTAssertEqualObjects(updates[@"displayName"], @{@"Action" : @"DELETE"});
+    XCTAssertEqualObjects(updates[@"count"], (@{@"Action" : @"PUT", @"Value" : @{@"N" : @"42.5"}}));
+    XCTAssertEqualObjects(updates[@"tags"][@"Action"], @"PUT");
+
+    updates = [codec attributeUpdatesFromModel:model
+                                  saveBehavior:AWSDynamoDBObjectMapperSaveBehaviorUpdateSkipNullAttributes];
+    XCTAssertNil(updates[@"displayName"]);
+
+    updates = [codec attributeUpdatesFromModel:model
+                                  saveBehavior:AWSDynamoDBObjectMapperSaveBehaviorAppendSet];
+    XCTAssertNil(updates[@"displayName"]);
+    XCTAssertEqualObjects(updates[@"tags"][@"Action"], @"ADD");
+    XCTAssertEqualObjects(updates[@"scores"][@"Action"], @"ADD");
+    XCTAssertEqualObjects(updates[@"count"][@"Action"], @"PUT");
+}
+
+- (void)testAttributeValues {
+    XCTAssertEqualObjects([AWSDynamoDBObjectModelCodec attributeValueFromObject:@[]], @{});
+    XCTAssertEqualObjects([AWSDynamoDBObjectModelCodec attributeValueFromObject:[NSSet set]], @{});
+    XCTAssertEqualObjects([AWSDynamoDBObjectModelCodec attributeValueFromObject:[NSDate date]], @{});
+    XCTAssertEqualObjects([AWSDynamoDBObjectModelCodec attributeValueFromObject:@[@[@1]]], (@{@"L" : @[@{@"L" : @[@{@"N" : @"1"}]}]}));
+    XCTAssertNil([AWSDynamoDBObjectModelCodec objectFromAttributeValue:@{@"NULL" : @YES}]);
+    XCTAssertEqualObjects([AWSDynamoDBObjectModelCodec objectFromAttributeValue:(@{@"NS" : @[@"1", @"2.5"]})], ([NSSet setWithArray:@[@1, @2.5]]));
+    XCTAssertEqualObjects([AWSDynamoDBObjectModelCodec objectFromAttributeValue:(@{@"S" : @"value", @"N" : [NSNull null]})], @"value");
+}
+
+#pragma mark - Benchmarks
+
+- (NSDictionary *)nestedMapWithDepth:(NSUInteger)depth {
+    if (depth == 0) {
+        return @{@"leaf" : @"value", @"number" : @(depth)};
+    }
+    return @{@"level" : @(depth),
+             @"name" : [NSString stringWithFormat:@"level-%lu", (unsigned long)depth],
+             @"values" : @[@1, @2, @3],
+             @"child" : [self nestedMapWithDepth:depth - 1]};
+}
+
+- (void)benchmarkModel:(AWSDynamoDBCodecTestItem *)model
+                  name:(NSString *)name {
+    NSUInteger iterations = 200;
+    AWSDynamoDBObjectModelCodec *codec = [AWSDynamoDBObjectModelCodec codecForClass:[AWSDynamoDBCodecTestItem class]];
+
+    NSUInteger attributeValueCount = 0;
+    [self attributeValueItemFromModel:model attributeValueCount:&attributeValueCount];
+
+    NSDate *start = [NSDate date];
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            [self attributeValueItemFromModel:model attributeValueCount:NULL];
+        }
+    }
+    NSTimeInterval attributeValueEncoding = [[NSDate date] timeIntervalSinceDate:start] / iterations;
+
+    start = [NSDate date];
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            [codec itemFromModel:model];
+        }
+    }
+    NSTimeInterval codecEncoding = [[NSDate date] timeIntervalSinceDate:start] / iterations;
+
+    NSDictionary *item = [codec itemFromModel:model];
+    start = [NSDate date];
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            [self attributeValueModelOfClass:[AWSDynamoDBCodecTestItem class] fromItem:item];
+        }
+    }
+    NSTimeInterval attributeValueDecoding = [[NSDate date] timeIntervalSinceDate:start] / iterations;
+
+    start = [NSDate date];
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            [codec modelFromItem:item error:nil];
+        }
+    }
+    NSTimeInterval codecDecoding = [[NSDate date] timeIntervalSinceDate:start] / iterations;
+
+    NSLog(@"%@ item, %lu AWSDynamoDBAttributeValue objects per item: encoding %.1fus -> %.1fus, decoding %.1fus -> %.1fus",
+          name, (unsigned long)attributeValueCount,
+          attributeValueEncoding * 1000000, codecEncoding * 1000000,
+          attributeValueDecoding * 1000000, codecDecoding * 1000000);
+    XCTAssertEqualObjects([codec modelFromItem:item error:nil], [self attributeValueModelOfClass:[AWSDynamoDBCodecTestItem class] fromItem:item]);
+}
+
+- (void)testBenchmarkWideItem {
+    AWSDynamoDBCodecTestItem *model = [self testItem];
+    NSMutableArray *list = [NSMutableArray new];
+    NSMutableDictionary *map = [NSMutableDictionary new];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [list addObject:[NSString stringWithFormat:@"value-%lu", (unsigned long)i]];
+        map[[NSString stringWithFormat:@"key-%lu", (unsigned long)i]] = @(i);
+    }
+    model.list = list;
+    model.map = map;
+
+    [self benchmarkModel:model name:@"Wide"];
+}
+
+- (void)testBenchmarkDeeplyNestedItem {
+    AWSDynamoDBCodecTestItem *model = [self testItem];
+    NSMutableArray *list = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 20; i++) {
+        [list addObject:[self nestedMapWithDepth:16]];
+    }
+    model.list = list;
+    model.map = [self nestedMapWithDepth:31];
+
+    [self benchmarkModel:model name:@"Deeply nested"];
+}
+
+@end
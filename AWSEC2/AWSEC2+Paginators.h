@@ -0,0 +1,37 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSEC2Service.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface AWSEC2 (Paginators)
+
+/**
+ Returns a paginator over the reservations of the DescribeInstances operation. The `nextToken` of each page is passed as the `nextToken` of the next, and the next page is fetched while the current one is processed.
+
+ @param request A container for the necessary parameters to execute the DescribeInstances service method.
+
+ @return A paginator over the `reservations` of the pages.
+
+ @see AWSEC2DescribeInstancesRequest
+ @see AWSPaginator
+ */
+- (AWSPaginator<AWSEC2Reservation *> *)describeInstancesPaginator:(AWSEC2DescribeInstancesRequest *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -40,3 +40,4 @@ FOUNDATION_EXPORT const unsigned char AWSEC2VersionString[] DEPRECATED_MSG_ATTRI
 
 #import <AWSCore/AWSCore.h>
 #import "AWSEC2Service.h"
+#import "AWSEC2+Paginators.h"
@@ -43,8 +43,6 @@
 @property (nonatomic, strong) NSDictionary *serviceDefinitionJSON;
 @property (nonatomic, strong) NSString *actionName;
 
-- (void)processParameters:(NSDictionary *)parameters queryString:(NSMutableString *)queryString;
-
 @end
 
 @implementation AWSEC2RequestSerializer
@@ -70,7 +68,7 @@
     }
     
     NSMutableString *queryString = [NSMutableString new];
-    [self processParameters:formattedParams queryString:queryString];
+    [AWSNetworkingHelpers appendQueryStringFromParameters:formattedParams toQueryString:queryString];
     
     if ([queryString length] > 0) {
         request.HTTPBody = [queryString dataUsingEncoding:NSUTF8StringEncoding];
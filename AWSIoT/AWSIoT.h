@@ -40,5 +40,6 @@ FOUNDATION_EXPORT const unsigned char AWSIoTVersionString[] DEPRECATED_MSG_ATTRI
 
 #import <AWSCore/AWSCore.h>
 #import "AWSIoTService.h"
+#import "AWSIoT+Paginators.h"
 #import "AWSIoTManager.h"
 #import "AWSIoTData.h"
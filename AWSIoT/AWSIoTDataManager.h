@@ -740,6 +740,8 @@ enableStaleDiscards: BOOL, set to NO to disable discarding stale updates (defaul
 enableIgnoreDeltas: BOOL, set to YES to disable delta updates (default NO)
 QoS: AWSIoTMQTTQoS (default AWSIoTMQTTQoSMessageDeliveryAttemptedAtMostOnce)
 shadowOperationTimeoutSeconds: double, device shadow operation timeout (default 10.0)
+enableLocalDocument: BOOL, set to YES to keep a parsed copy of the shadow state, see localShadowDocument: (default NO)
+updateCoalescingInterval: double, seconds during which updateShadow: calls are merged and then published as one update containing only the changes against the local document; implies enableLocalDocument (default 0.0, disabled)
  
  @param callback The function to call when updates are received for the device shadow.
  
@@ -781,6 +783,10 @@ shadowOperationTimeoutSeconds: double, device shadow operation timeout (default
  will be published. If the json data is valid, it publishes the data on
  $aws/things/thingName/shadow/update topic, then return true.
 
+ If the shadow was registered with `updateCoalescingInterval`, the update is
+ queued instead and published together with the other updates of the interval;
+ the last client token given during the interval is used.
+
  @param name The name of the device shadow to be updated
 
  @param jsonString The shadow state in format of JSON string
@@ -796,6 +802,19 @@ shadowOperationTimeoutSeconds: double, device shadow operation timeout (default
            jsonString:(NSString *)jsonString
           clientToken:(NSString  * _Nullable)clientToken;
 
+/**
+ Returns the local copy of a device shadow's state object, i.e. its `desired` and `reported` sections, as last
+ received from AWS IoT. Deltas, documents and accepted updates are merged into it as they arrive, so it can be
+ read from the event callback instead of parsing the payload again.
+
+ @param name The device shadow registered with the `enableLocalDocument` or `updateCoalescingInterval` option.
+
+ @return The shadow state, empty until the first get or update is received, or nil if the shadow is not registered
+ with a local document.
+
+ */
+- (NSDictionary * _Nullable) localShadowDocument:(NSString *)name;
+
 /**
  Get a device shadow
  
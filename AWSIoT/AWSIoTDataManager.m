@@ -37,6 +37,80 @@
 }
 @end
 
+//
+// Shadow documents kept for enableLocalDocument are immutable trees; merges copy
+// only the dictionaries along the changed paths, so readers can hold on to a
+// document without copying it.
+//
+// Returns value with every nested dictionary and array copied into an immutable
+// container, so that nothing parsed with NSJSONReadingMutableContainers ends up
+// shared with a stored document.
+//
+static id AWSIoTShadowImmutableCopy(id value) {
+    if ([value isKindOfClass:[NSDictionary class]]) {
+        NSMutableDictionary *copy = [NSMutableDictionary dictionaryWithCapacity:[value count]];
+        [value enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+            copy[key] = AWSIoTShadowImmutableCopy(object);
+        }];
+        return [copy copy];
+    }
+    if ([value isKindOfClass:[NSArray class]]) {
+        NSMutableArray *copy = [NSMutableArray arrayWithCapacity:[value count]];
+        for (id object in value) {
+            [copy addObject:AWSIoTShadowImmutableCopy(object)];
+        }
+        return [copy copy];
+    }
+    return [value copy];
+}
+
+//
+// Merges the JSON object patch into base.  With removeNulls, null values delete
+// the key as the service does; otherwise they are kept so that a pending update
+// still carries the deletion.
+//
+static NSDictionary *AWSIoTShadowMergeState(NSDictionary *base, NSDictionary *patch, BOOL removeNulls) {
+    if (![patch isKindOfClass:[NSDictionary class]]) {
+        return base;
+    }
+    NSMutableDictionary *merged = [base isKindOfClass:[NSDictionary class]] ? [base mutableCopy] : [NSMutableDictionary new];
+    [patch enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+        if ([value isKindOfClass:[NSNull class]] && removeNulls) {
+            [merged removeObjectForKey:key];
+        } else if ([value isKindOfClass:[NSDictionary class]] && [merged[key] isKindOfClass:[NSDictionary class]]) {
+            merged[key] = AWSIoTShadowMergeState(merged[key], value, removeNulls);
+        } else if ([value isKindOfClass:[NSDictionary class]] && removeNulls) {
+            merged[key] = AWSIoTShadowMergeState(nil, value, removeNulls);
+        } else {
+            merged[key] = AWSIoTShadowImmutableCopy(value);
+        }
+    }];
+    return [merged copy];
+}
+
+//
+// Returns the part of patch that would change base, or nil if nothing would.
+//
+static NSDictionary *AWSIoTShadowDiffState(NSDictionary *patch, NSDictionary *base) {
+    NSMutableDictionary *diff = [NSMutableDictionary new];
+    [patch enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+        id baseValue = [base isKindOfClass:[NSDictionary class]] ? base[key] : nil;
+        if ([value isKindOfClass:[NSNull class]]) {
+            if (baseValue != nil) {
+                diff[key] = value;
+            }
+        } else if ([value isKindOfClass:[NSDictionary class]] && [baseValue isKindOfClass:[NSDictionary class]]) {
+            NSDictionary *nested = AWSIoTShadowDiffState(value, baseValue);
+            if (nested != nil) {
+                diff[key] = nested;
+            }
+        } else if (![value isEqual:baseValue]) {
+            diff[key] = value;
+        }
+    }];
+    return [diff count] > 0 ? diff : nil;
+}
+
 @interface AWSIoTDataShadow:NSObject
 //
 // Each shadow has the following properties
@@ -56,6 +130,16 @@
 @property(nonatomic, strong) NSTimer *timer;
 @property(atomic, assign) NSTimeInterval operationTimeout;
 @property(atomic, assign) AWSIoTShadowOperationType operation;
+//
+// Local document and update coalescing; document, pendingState and
+// pendingClientToken are guarded by @synchronized on the shadow.
+//
+@property(atomic, assign) BOOL enableLocalDocument;
+@property(atomic, assign) NSTimeInterval updateCoalescingInterval;
+@property(nonatomic, strong) NSDictionary *document;
+@property(nonatomic, strong) NSDictionary *pendingState;
+@property(nonatomic, strong) NSString *pendingClientToken;
+@property(nonatomic, strong) NSTimer *coalescingTimer;
 @end
 
 @implementation AWSIoTDataShadow
@@ -970,6 +1054,10 @@ static NSString * const AWSIoTShadowOperationStatusTypeStrings[] = {
         }
     }
 
+    if (shadow.enableLocalDocument == YES && status != AWSIoTShadowOperationStatusTypeRejected) {
+        [self applyMessage:jsonDictionary toDocumentOfShadow:shadow operation:operation status:status];
+    }
+
     //
     // If this is a 'delta' or 'documents' message, call the user's callback
     //
@@ -1014,6 +1102,56 @@ static NSString * const AWSIoTShadowOperationStatusTypeStrings[] = {
     return rc;
 }
 
+//
+// Keep the local copy of the shadow's state object in step with the service.
+// Only called for messages that passed the version checks above.
+//
+- (void)applyMessage:(NSDictionary *)jsonDictionary
+  toDocumentOfShadow:(AWSIoTDataShadow *)shadow
+           operation:(AWSIoTShadowOperationType)operation
+              status:(AWSIoTShadowOperationStatusType)status {
+    NSDictionary *state = jsonDictionary[@"state"];
+    @synchronized(shadow) {
+        switch (status) {
+            case AWSIoTShadowOperationStatusTypeAccepted:
+                if (operation == AWSIoTShadowOperationTypeGet) {
+                    // 'delta' is derived from desired and reported, don't keep it.
+                    NSMutableDictionary *document = [state isKindOfClass:[NSDictionary class]] ? [state mutableCopy] : [NSMutableDictionary new];
+                    [document removeObjectForKey:@"delta"];
+                    shadow.document = AWSIoTShadowImmutableCopy(document);
+                } else if (operation == AWSIoTShadowOperationTypeUpdate) {
+                    shadow.document = AWSIoTShadowMergeState(shadow.document, state, YES);
+                } else if (operation == AWSIoTShadowOperationTypeDelete) {
+                    shadow.document = nil;
+                }
+                break;
+            case AWSIoTShadowOperationStatusTypeDelta:
+                shadow.document = AWSIoTShadowMergeState(shadow.document, @{@"desired" : state ?: @{}}, YES);
+                break;
+            case AWSIoTShadowOperationStatusTypeDocuments: {
+                // 'documents' carries the version inside 'current' rather than at the top level.
+                NSDictionary *current = jsonDictionary[@"current"];
+                if (![current isKindOfClass:[NSDictionary class]]) {
+                    break;
+                }
+                UInt32 versionNumber = (UInt32)[current[@"version"] integerValue];
+                if (versionNumber < shadow.version && shadow.enableStaleDiscards == YES) {
+                    AWSDDLogDebug(@"ignoring out-of-date document version '%u' on '%@'", (unsigned int)versionNumber, shadow.name);
+                    break;
+                }
+                if (versionNumber > shadow.version) {
+                    shadow.version = versionNumber;
+                }
+                NSDictionary *currentState = current[@"state"];
+                shadow.document = [currentState isKindOfClass:[NSDictionary class]] ? AWSIoTShadowImmutableCopy(currentState) : nil;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
 static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, NSData *data) = ^(NSObject *mqttClient, NSString *topic, NSData *data) {
     AWSIoTDataManager *iotDataManager = (AWSIoTDataManager *)(((AWSIoTMQTTClient *)mqttClient).associatedObject);
     //
@@ -1103,6 +1241,78 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
     shadow.timer = nil;
 }
 
+//
+// Collect updates for shadows registered with updateCoalescingInterval; the
+// collected state is published as one update once the interval has passed.
+//
+- (BOOL) coalesceUpdateForShadow:(AWSIoTDataShadow *)shadow
+                 stateDictionary:(NSDictionary *)stateDictionary {
+    NSDictionary *state = stateDictionary[@"state"];
+    if (![state isKindOfClass:[NSDictionary class]]) {
+        AWSDDLogError(@"json for (%@) has no state object", shadow.name);
+        return NO;
+    }
+    @synchronized(shadow) {
+        shadow.pendingState = AWSIoTShadowMergeState(shadow.pendingState, state, NO);
+        if (stateDictionary[@"clientToken"] != nil) {
+            shadow.pendingClientToken = stateDictionary[@"clientToken"];
+        }
+        if (shadow.coalescingTimer == nil) {
+            shadow.coalescingTimer = [NSTimer timerWithTimeInterval:shadow.updateCoalescingInterval
+                                                             target:self
+                                                           selector:@selector(shadowCoalescingTimerFired:)
+                                                           userInfo:shadow.name
+                                                            repeats:NO];
+            [[NSRunLoop mainRunLoop] addTimer:shadow.coalescingTimer forMode:NSRunLoopCommonModes];
+        }
+    }
+    return YES;
+}
+
+- (void) shadowCoalescingTimerFired:(NSTimer *)timer {
+    NSString *shadowName = (NSString *)[timer userInfo];
+    AWSIoTDataShadow *shadow = [self.shadows objectForKey:shadowName];
+    NSMutableDictionary *stateDictionary = nil;
+
+    @synchronized(shadow) {
+        shadow.coalescingTimer = nil;
+        if (shadow.pendingState == nil) {
+            return;
+        }
+        if (shadow.timer != nil) {
+            //
+            // An operation is still in progress; try again after another interval
+            // so that the update is made against the version it returns.
+            //
+            shadow.coalescingTimer = [NSTimer timerWithTimeInterval:shadow.updateCoalescingInterval
+                                                             target:self
+                                                           selector:@selector(shadowCoalescingTimerFired:)
+                                                           userInfo:shadowName
+                                                            repeats:NO];
+            [[NSRunLoop mainRunLoop] addTimer:shadow.coalescingTimer forMode:NSRunLoopCommonModes];
+            return;
+        }
+        //
+        // Publish only what differs from the last known document.
+        //
+        NSDictionary *diff = AWSIoTShadowDiffState(shadow.pendingState, shadow.document);
+        if (diff != nil) {
+            stateDictionary = [NSMutableDictionary dictionaryWithObject:diff forKey:@"state"];
+            if (shadow.pendingClientToken != nil) {
+                stateDictionary[@"clientToken"] = shadow.pendingClientToken;
+            }
+        }
+        shadow.pendingState = nil;
+        shadow.pendingClientToken = nil;
+    }
+
+    if (stateDictionary != nil) {
+        [self operationWithShadow:shadowName operation:AWSIoTShadowOperationTypeUpdate stateDictionary:stateDictionary];
+    } else {
+        AWSDDLogDebug(@"coalesced update for (%@) matches the local document, nothing to publish", shadowName);
+    }
+}
+
 - (BOOL) operationWithShadow:(NSString *)name
                    operation:(AWSIoTShadowOperationType)operation
              stateDictionary:(NSMutableDictionary *)stateDictionary {
@@ -1235,6 +1445,20 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
                 if (numberOptionValue != nil) {
                     shadow.operationTimeout = [numberOptionValue doubleValue];
                 }
+                numberOptionValue = [options valueForKey:@"enableLocalDocument"];
+                if (numberOptionValue != nil) {
+                    shadow.enableLocalDocument = [numberOptionValue integerValue];
+                }
+                numberOptionValue = [options valueForKey:@"updateCoalescingInterval"];
+                if (numberOptionValue != nil) {
+                    shadow.updateCoalescingInterval = [numberOptionValue doubleValue];
+                }
+                if (shadow.updateCoalescingInterval > 0) {
+                    //
+                    // Coalesced updates are diffed against the local document.
+                    //
+                    shadow.enableLocalDocument = YES;
+                }
             }
             if (shadow.enableIgnoreDeltas == NO) {
                 [self createSubscriptionsForShadow:shadow
@@ -1284,6 +1508,11 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
         //invalidate the timer as the shadow is being unregistered.
         [shadow.timer invalidate];
         shadow.timer = nil;
+        @synchronized(shadow) {
+            [shadow.coalescingTimer invalidate];
+            shadow.coalescingTimer = nil;
+            shadow.pendingState = nil;
+        }
         //
         // Remove the shadow from the dictionary
         //
@@ -1325,9 +1554,16 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
                 [jsonDictionary setValue:clientToken forKey:@"clientToken"];
             }
             //
-            // Perform the shadow update operation.
+            // Perform the shadow update operation, or queue it if the shadow
+            // coalesces updates.
             //
-            rc = [self operationWithShadow:name operation:AWSIoTShadowOperationTypeUpdate stateDictionary:jsonDictionary];
+            AWSIoTDataShadow *shadow = [self.shadows objectForKey:name];
+            if (shadow != nil && shadow.updateCoalescingInterval > 0) {
+                rc = [self coalesceUpdateForShadow:shadow stateDictionary:jsonDictionary];
+            }
+            else {
+                rc = [self operationWithShadow:name operation:AWSIoTShadowOperationTypeUpdate stateDictionary:jsonDictionary];
+            }
         }
         else {
             AWSDDLogError(@"json for (%@) cannot contain a version property", name);
@@ -1339,6 +1575,16 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
     return rc;
 }
 
+- (NSDictionary *) localShadowDocument:(NSString *)name {
+    AWSIoTDataShadow *shadow = [self.shadows objectForKey:name];
+    if (shadow == nil || shadow.enableLocalDocument == NO) {
+        return nil;
+    }
+    @synchronized(shadow) {
+        return shadow.document ?: @{};
+    }
+}
+
 - (BOOL) getShadow:(NSString *)name {
     return [self getShadow:name clientToken:nil];
 }
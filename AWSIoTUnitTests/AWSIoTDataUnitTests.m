@@ -20,6 +20,15 @@
 
 static id mockNetworking = nil;
 
+@interface AWSIoTDataManager (ShadowTesting)
+
+- (BOOL)handleMessagesForShadow:(NSString *)name
+                      operation:(AWSIoTShadowOperationType)operation
+                         status:(AWSIoTShadowOperationStatusType)status
+                        payload:(NSData *)payload;
+
+@end
+
 @interface AWSIoTDataUnitTests : XCTestCase
 
 @end
@@ -450,4 +459,109 @@ static id mockNetworking = nil;
     [AWSIoTData removeIoTDataForKey:key];
 }
 
+- (void)testShadowUpdatesAreCoalescedIntoMinimalDiff {
+    NSString *key = @"testShadowUpdatesAreCoalescedIntoMinimalDiff";
+    NSString *shadowName = @"coalescedThing";
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:nil];
+    [AWSIoTDataManager registerIoTDataManagerWithConfiguration:configuration forKey:key];
+    AWSIoTDataManager *dataManager = [AWSIoTDataManager IoTDataManagerForKey:key];
+    id partialMock = OCMPartialMock(dataManager);
+
+    //
+    // Broker stand-in: accepts updates made against its current version and
+    // answers with update/accepted followed by update/documents.
+    //
+    __block NSDictionary *brokerState = @{@"reported" : @{@"temp" : @20, @"mode" : @"auto"}};
+    __block NSInteger brokerVersion = 3;
+    NSMutableArray<NSDictionary *> *published = [NSMutableArray new];
+    OCMStub([partialMock publishData:[OCMArg any] onTopic:[OCMArg any] QoS:AWSIoTMQTTQoSMessageDeliveryAttemptedAtMostOnce]).andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSData *data;
+        [invocation getArgument:&data atIndex:2];
+        NSDictionary *update = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+        [published addObject:update];
+        XCTAssertEqual([update[@"version"] integerValue], brokerVersion);
+
+        NSMutableDictionary *previous = [@{@"state" : brokerState, @"version" : @(brokerVersion)} mutableCopy];
+        NSMutableDictionary *state = [brokerState mutableCopy];
+        [update[@"state"] enumerateKeysAndObjectsUsingBlock:^(NSString *section, NSDictionary *values, BOOL *stop) {
+            NSMutableDictionary *merged = [state[section] mutableCopy] ?: [NSMutableDictionary new];
+            [merged addEntriesFromDictionary:values];
+            state[section] = merged;
+        }];
+        brokerState = state;
+        brokerVersion++;
+
+        NSDictionary *accepted = @{@"state" : update[@"state"], @"version" : @(brokerVersion), @"clientToken" : update[@"clientToken"]};
+        NSDictionary *documents = @{@"previous" : previous,
+                                    @"current" : @{@"state" : brokerState, @"version" : @(brokerVersion)},
+                                    @"clientToken" : update[@"clientToken"]};
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [dataManager handleMessagesForShadow:shadowName
+                                       operation:AWSIoTShadowOperationTypeUpdate
+                                          status:AWSIoTShadowOperationStatusTypeAccepted
+                                         payload:[NSJSONSerialization dataWithJSONObject:accepted options:0 error:nil]];
+            [dataManager handleMessagesForShadow:shadowName
+                                       operation:AWSIoTShadowOperationTypeUpdate
+                                          status:AWSIoTShadowOperationStatusTypeDocuments
+                                         payload:[NSJSONSerialization dataWithJSONObject:documents options:0 error:nil]];
+        });
+    });
+
+    XCTestExpectation *acceptedExpectation = [self expectationWithDescription:@"coalesced update accepted"];
+    [dataManager registerWithShadow:shadowName
+                            options:@{@"enableVersioning" : @YES, @"updateCoalescingInterval" : @0.2}
+                      eventCallback:^(NSString *name, AWSIoTShadowOperationType operation, AWSIoTShadowOperationStatusType status, NSString *clientToken, NSData *payload) {
+        if (operation == AWSIoTShadowOperationTypeUpdate && status == AWSIoTShadowOperationStatusTypeAccepted) {
+            [acceptedExpectation fulfill];
+        }
+    }];
+    XCTAssertEqualObjects([dataManager localShadowDocument:shadowName], @{});
+
+    NSDictionary *getAccepted = @{@"state" : @{@"reported" : brokerState[@"reported"]}, @"version" : @3};
+    [dataManager handleMessagesForShadow:shadowName
+                               operation:AWSIoTShadowOperationTypeGet
+                                  status:AWSIoTShadowOperationStatusTypeAccepted
+                                 payload:[NSJSONSerialization dataWithJSONObject:getAccepted options:0 error:nil]];
+    XCTAssertEqualObjects([dataManager localShadowDocument:shadowName], brokerState);
+    XCTAssertThrows([(NSMutableDictionary *)[dataManager localShadowDocument:shadowName][@"reported"] removeAllObjects]);
+
+    XCTAssertTrue([dataManager updateShadow:shadowName jsonString:@"{\"state\":{\"reported\":{\"temp\":21}}}"]);
+    XCTAssertTrue([dataManager updateShadow:shadowName jsonString:@"{\"state\":{\"reported\":{\"temp\":22,\"mode\":\"auto\"}}}"]);
+    XCTAssertTrue([dataManager updateShadow:shadowName jsonString:@"{\"state\":{\"desired\":{\"fan\":\"on\"}}}"]);
+    XCTAssertTrue([dataManager updateShadow:shadowName jsonString:@"{\"state\":{\"reported\":{\"temp\":23}}}"]);
+    XCTAssertEqual([published count], 0);
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    // One publish, without the unchanged 'mode', made against version 3.
+    XCTAssertEqual([published count], 1);
+    NSDictionary *expectedState = @{@"reported" : @{@"temp" : @23}, @"desired" : @{@"fan" : @"on"}};
+    XCTAssertEqualObjects(published[0][@"state"], expectedState);
+
+    NSDictionary *expectedDocument = @{@"reported" : @{@"temp" : @23, @"mode" : @"auto"}, @"desired" : @{@"fan" : @"on"}};
+    XCTAssertEqualObjects([dataManager localShadowDocument:shadowName], expectedDocument);
+    // The document and the containers nested in it are immutable, whether parsed from a message or merged.
+    XCTAssertThrows([(NSMutableDictionary *)[dataManager localShadowDocument:shadowName] removeAllObjects]);
+    XCTAssertThrows([(NSMutableDictionary *)[dataManager localShadowDocument:shadowName][@"reported"] removeAllObjects]);
+    XCTAssertThrows([(NSMutableDictionary *)[dataManager localShadowDocument:shadowName][@"desired"] removeAllObjects]);
+
+    // Deltas are merged into 'desired'; stale ones are discarded.
+    NSDictionary *delta = @{@"state" : @{@"fan" : @"off"}, @"version" : @5};
+    [dataManager handleMessagesForShadow:shadowName
+                               operation:AWSIoTShadowOperationTypeUpdate
+                                  status:AWSIoTShadowOperationStatusTypeDelta
+                                 payload:[NSJSONSerialization dataWithJSONObject:delta options:0 error:nil]];
+    NSDictionary *staleDelta = @{@"state" : @{@"fan" : @"auto"}, @"version" : @2};
+    [dataManager handleMessagesForShadow:shadowName
+                               operation:AWSIoTShadowOperationTypeUpdate
+                                  status:AWSIoTShadowOperationStatusTypeDelta
+                                 payload:[NSJSONSerialization dataWithJSONObject:staleDelta options:0 error:nil]];
+    XCTAssertEqualObjects([dataManager localShadowDocument:shadowName][@"desired"], @{@"fan" : @"off"});
+
+    [dataManager unregisterFromShadow:shadowName];
+    XCTAssertNil([dataManager localShadowDocument:shadowName]);
+    [partialMock stopMocking];
+}
+
 @end
@@ -14,6 +14,7 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <AWSCore/AWSCore.h>
 #import "AWSMQTTSession.h"
 
 #import "MQTTDecoderTestHelpers.h"
@@ -112,4 +113,38 @@
     [writerThread cancel];
 }
 
+// Publishes without a connected encoder, so every call takes the queueing path in -[AWSMQTTSession send:] and
+// its verbose logging. With the level set to Off the log statements should cost nothing measurable.
+- (void)measurePublishLoopAtLogLevel:(AWSDDLogLevel)logLevel {
+    AWSDDLogLevel originalLogLevel = [AWSDDLog sharedInstance].logLevel;
+    [AWSDDLog sharedInstance].logLevel = logLevel;
+
+    NSData *payload = [@"{\"state\":{\"reported\":{\"temperature\":21}}}" dataUsingEncoding:NSUTF8StringEncoding];
+    [self measureBlock:^{
+        AWSMQTTSession *session = [[AWSMQTTSession alloc] initWithClientId:@"testPublishLoop"
+                                                                  userName:@"testPublishLoopUser"
+                                                                  password:@"testPublishLoopPass"
+                                                                 keepAlive:60
+                                                              cleanSession:YES
+                                                                 willTopic:nil
+                                                                   willMsg:nil
+                                                                   willQoS:0
+                                                            willRetainFlag:NO
+                                                      publishRetryThrottle:10];
+        for (int i = 0; i < 5000; i++) {
+            [session publishDataAtMostOnce:payload onTopic:@"$aws/things/TEST/shadow/update"];
+        }
+    }];
+
+    [AWSDDLog sharedInstance].logLevel = originalLogLevel;
+}
+
+- (void)testPublishLoopPerformanceWithLoggingOff {
+    [self measurePublishLoopAtLogLevel:AWSDDLogLevelOff];
+}
+
+- (void)testPublishLoopPerformanceWithVerboseLogging {
+    [self measurePublishLoopAtLogLevel:AWSDDLogLevelVerbose];
+}
+
 @end
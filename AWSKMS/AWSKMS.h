@@ -40,3 +40,4 @@ FOUNDATION_EXPORT const unsigned char AWSKMSVersionString[] DEPRECATED_MSG_ATTRI
 
 #import <AWSCore/AWSCore.h>
 #import "AWSKMSService.h"
+#import "AWSKMSEnvelopeEncryptor.h"
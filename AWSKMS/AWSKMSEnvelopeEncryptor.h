@@ -0,0 +1,155 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import <AWSCore/AWSCore.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class AWSKMS;
+
+FOUNDATION_EXPORT NSString *const AWSKMSEnvelopeEncryptorErrorDomain;
+typedef NS_ENUM(NSInteger, AWSKMSEnvelopeEncryptorErrorType) {
+    AWSKMSEnvelopeEncryptorErrorUnknown,
+    AWSKMSEnvelopeEncryptorErrorInvalidEnvelope,
+    AWSKMSEnvelopeEncryptorErrorAuthenticationFailed,
+    AWSKMSEnvelopeEncryptorErrorInvalidDataKey,
+};
+
+/**
+ The default value of `maximumKeyAge`, 300 seconds.
+ */
+FOUNDATION_EXPORT NSTimeInterval const AWSKMSEnvelopeEncryptorDefaultMaximumKeyAge;
+
+/**
+ The default value of `maximumMessagesPerKey`, 1000 messages.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSKMSEnvelopeEncryptorDefaultMaximumMessagesPerKey;
+
+/**
+ The default value of `maximumBytesPerKey`, 64MB.
+ */
+FOUNDATION_EXPORT unsigned long long const AWSKMSEnvelopeEncryptorDefaultMaximumBytesPerKey;
+
+/**
+ The default value of `maximumCachedKeys`, 100 keys.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSKMSEnvelopeEncryptorDefaultMaximumCachedKeys;
+
+/**
+ Encrypts and decrypts data locally with AES-GCM, under data keys generated and protected by AWS KMS.
+
+ Every envelope holds the encrypted data key it was encrypted with, so it can be decrypted anywhere the customer master
+ key can be used. Data keys are cached, so that most messages are encrypted and decrypted without a request to AWS KMS:
+
+ - The data key used for encryption is reused until it is `maximumKeyAge` seconds old, or has encrypted
+   `maximumMessagesPerKey` messages or `maximumBytesPerKey` bytes. A new one is then generated with `GenerateDataKey`.
+ - Data keys decrypted with `Decrypt`, and the data keys generated by this encryptor, are kept by encrypted data key, up
+   to `maximumCachedKeys` keys and for `maximumKeyAge` seconds.
+
+ Concurrent messages that need the same data key wait for the same request. The plaintext of a data key is zeroed when
+ it leaves the cache, and after every message that used it.
+
+ A decrypted data key is reused without a request to AWS KMS, so every envelope decrypted by an encryptor must have been
+ encrypted with the same `encryptionContext`.
+ */
+@interface AWSKMSEnvelopeEncryptor : NSObject
+
+/**
+ The AWS KMS client that generates and decrypts the data keys.
+ */
+@property (nonatomic, strong, readonly) AWSKMS *kms;
+
+/**
+ The customer master key that protects the data keys.
+ */
+@property (nonatomic, strong, readonly) NSString *keyId;
+
+/**
+ The encryption context of the data keys, or `nil` for none.
+ */
+@property (nonatomic, strong, readonly, nullable) NSDictionary<NSString *, NSString *> *encryptionContext;
+
+/**
+ The maximum time a data key is used and cached, in seconds. The default value is `AWSKMSEnvelopeEncryptorDefaultMaximumKeyAge`.
+ */
+@property (nonatomic, assign) NSTimeInterval maximumKeyAge;
+
+/**
+ The maximum number of messages encrypted with a data key. The default value is `AWSKMSEnvelopeEncryptorDefaultMaximumMessagesPerKey`.
+ */
+@property (nonatomic, assign) NSUInteger maximumMessagesPerKey;
+
+/**
+ The maximum number of bytes encrypted with a data key. A message larger than this is encrypted with a data key of its own. The default value is `AWSKMSEnvelopeEncryptorDefaultMaximumBytesPerKey`.
+ */
+@property (nonatomic, assign) unsigned long long maximumBytesPerKey;
+
+/**
+ The maximum number of data keys cached for decryption. When it is exceeded, the least recently used key is removed. The default value is `AWSKMSEnvelopeEncryptorDefaultMaximumCachedKeys`.
+ */
+@property (nonatomic, assign) NSUInteger maximumCachedKeys;
+
+/**
+ The number of messages encrypted or decrypted with a cached data key, or with a data key requested for another message.
+ */
+@property (atomic, assign, readonly) NSUInteger hitCount;
+
+/**
+ The number of requests made to AWS KMS for a data key.
+ */
+@property (atomic, assign, readonly) NSUInteger missCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates an envelope encryptor.
+
+ @param kms               The AWS KMS client that generates and decrypts the data keys.
+ @param keyId             The customer master key that protects the data keys. A key ID, key ARN, alias name or alias ARN.
+ @param encryptionContext The encryption context of the data keys, or `nil` for none.
+
+ @return An envelope encryptor.
+ */
+- (instancetype)initWithKMS:(AWSKMS *)kms
+                      keyId:(NSString *)keyId
+          encryptionContext:(nullable NSDictionary<NSString *, NSString *> *)encryptionContext NS_DESIGNATED_INITIALIZER;
+
+/**
+ Encrypts data into an envelope.
+
+ @param data The data.
+
+ @return An instance of `AWSTask`. On successful execution, `task.result` will contain the envelope, which holds the encrypted data key, the initialization vector, the encrypted data and its authentication tag. On failed execution, `task.error` may contain an `NSError` with `AWSKMSErrorDomain` or `AWSKMSEnvelopeEncryptorErrorDomain` domain.
+ */
+- (AWSTask<NSData *> *)encryptData:(NSData *)data;
+
+/**
+ Decrypts an envelope.
+
+ @param envelope An envelope returned by `- encryptData:`.
+
+ @return An instance of `AWSTask`. On successful execution, `task.result` will contain the data. On failed execution, `task.error` may contain an `NSError` with `AWSKMSErrorDomain` or `AWSKMSEnvelopeEncryptorErrorDomain` domain, and `AWSKMSEnvelopeEncryptorErrorAuthenticationFailed` when the envelope was modified.
+ */
+- (AWSTask<NSData *> *)decryptData:(NSData *)envelope;
+
+/**
+ Zeroes and removes all of the cached data keys. The counters are not reset.
+ */
+- (void)removeAllCachedKeys;
+
+@end
+
+NS_ASSUME_NONNULL_END
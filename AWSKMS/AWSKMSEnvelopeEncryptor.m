@@ -0,0 +1,602 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSKMSEnvelopeEncryptor.h"
+#import <CommonCrypto/CommonCryptor.h>
+#import "AWSKMSService.h"
+
+NSString *const AWSKMSEnvelopeEncryptorErrorDomain = @"com.amazonaws.AWSKMSEnvelopeEncryptorErrorDomain";
+
+NSTimeInterval const AWSKMSEnvelopeEncryptorDefaultMaximumKeyAge = 300;
+NSUInteger const AWSKMSEnvelopeEncryptorDefaultMaximumMessagesPerKey = 1000;
+unsigned long long const AWSKMSEnvelopeEncryptorDefaultMaximumBytesPerKey = 64 * 1024 * 1024;
+NSUInteger const AWSKMSEnvelopeEncryptorDefaultMaximumCachedKeys = 100;
+
+// An envelope is the version, the length of the encrypted data key in two bytes, the encrypted data key and the IV,
+// which are all authenticated, followed by the encrypted data and the tag.
+static uint8_t const AWSKMSEnvelopeVersion = 1;
+static size_t const AWSKMSEnvelopeIVLength = 12;
+static size_t const AWSKMSEnvelopeTagLength = 16;
+
+#pragma mark - AES-GCM
+
+// CommonCrypto has no public AES-GCM, so it is built on AES-ECB as specified by NIST SP 800-38D, for 96-bit IVs.
+// GHASH uses 4-bit tables.
+
+typedef struct {
+    uint64_t high[16];
+    uint64_t low[16];
+} aws_ghashTable;
+
+static const uint64_t aws_ghashReduction[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static uint64_t aws_load64(const uint8_t *bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static void aws_store64(uint8_t *bytes, uint64_t value) {
+    for (int i = 7; i >= 0; i--) {
+        bytes[i] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+static void aws_ghashInit(aws_ghashTable *table, const uint8_t hashKey[16]) {
+    uint64_t high = aws_load64(hashKey);
+    uint64_t low = aws_load64(hashKey + 8);
+    table->high[0] = 0;
+    table->low[0] = 0;
+    table->high[8] = high;
+    table->low[8] = low;
+    for (int i = 4; i > 0; i >>= 1) {
+        uint64_t reduction = (low & 1) * 0xe100000000000000ULL;
+        low = (high << 63) | (low >> 1);
+        high = (high >> 1) ^ reduction;
+        table->high[i] = high;
+        table->low[i] = low;
+    }
+    for (int i = 2; i <= 8; i *= 2) {
+        for (int j = 1; j < i; j++) {
+            table->high[i + j] = table->high[i] ^ table->high[j];
+            table->low[i + j] = table->low[i] ^ table->low[j];
+        }
+    }
+}
+
+static void aws_ghashMultiply(const aws_ghashTable *table, uint8_t block[16]) {
+    uint8_t index = block[15] & 0xf;
+    uint64_t high = table->high[index];
+    uint64_t low = table->low[index];
+    for (int i = 15; i >= 0; i--) {
+        if (i != 15) {
+            index = block[i] & 0xf;
+            uint8_t remainder = low & 0xf;
+            low = (high << 60) | (low >> 4);
+            high = (high >> 4) ^ (aws_ghashReduction[remainder] << 48);
+            high ^= table->high[index];
+            low ^= table->low[index];
+        }
+        index = block[i] >> 4;
+        uint8_t remainder = low & 0xf;
+        low = (high << 60) | (low >> 4);
+        high = (high >> 4) ^ (aws_ghashReduction[remainder] << 48);
+        high ^= table->high[index];
+        low ^= table->low[index];
+    }
+    aws_store64(block, high);
+    aws_store64(block + 8, low);
+}
+
+static void aws_ghashUpdate(const aws_ghashTable *table, uint8_t hash[16], const uint8_t *bytes, size_t length) {
+    while (length > 0) {
+        size_t blockLength = MIN(length, 16);
+        for (size_t i = 0; i < blockLength; i++) {
+            hash[i] ^= bytes[i];
+        }
+        aws_ghashMultiply(table, hash);
+        bytes += blockLength;
+        length -= blockLength;
+    }
+}
+
+static BOOL aws_aesEncryptBlocks(CCCryptorRef cryptor, const uint8_t *input, uint8_t *output, size_t length) {
+    size_t outputLength = 0;
+    return CCCryptorUpdate(cryptor, input, length, output, length, &outputLength) == kCCSuccess && outputLength == length;
+}
+
+// Encrypts or decrypts `length` bytes of `input` into `output`, and computes the tag of the additional data and the ciphertext.
+static BOOL aws_gcmCrypt(BOOL encrypt,
+                         const uint8_t *key, size_t keyLength,
+                         const uint8_t iv[12],
+                         const uint8_t *additionalData, size_t additionalDataLength,
+                         const uint8_t *input, uint8_t *output, size_t length,
+                         uint8_t tag[16]) {
+    CCCryptorRef cryptor = NULL;
+    if (CCCryptorCreate(kCCEncrypt, kCCAlgorithmAES, kCCOptionECBMode, key, keyLength, NULL, &cryptor) != kCCSuccess) {
+        return NO;
+    }
+
+    uint8_t hashKey[16] = {0};
+    uint8_t counter[16] = {0};
+    uint8_t tagMask[16];
+    memcpy(counter, iv, 12);
+    counter[15] = 1;
+    BOOL succeeded = aws_aesEncryptBlocks(cryptor, hashKey, hashKey, 16) && aws_aesEncryptBlocks(cryptor, counter, tagMask, 16);
+
+    aws_ghashTable table;
+    uint8_t hash[16] = {0};
+    aws_ghashInit(&table, hashKey);
+    aws_ghashUpdate(&table, hash, additionalData, additionalDataLength);
+    if (!encrypt) {
+        aws_ghashUpdate(&table, hash, input, length);
+    }
+
+    // The key stream is encrypted 256 counter blocks at a time. The counter is the low 32 bits of the block.
+    uint8_t keyStream[4096];
+    uint32_t counterValue = 1;
+    for (size_t offset = 0; succeeded && offset < length; offset += sizeof(keyStream)) {
+        size_t chunkLength = MIN(sizeof(keyStream), length - offset);
+        size_t blockCount = (chunkLength + 15) / 16;
+        for (size_t i = 0; i < blockCount; i++) {
+            uint8_t *block = keyStream + i * 16;
+            counterValue++;
+            memcpy(block, iv, 12);
+            block[12] = (uint8_t)(counterValue >> 24);
+            block[13] = (uint8_t)(counterValue >> 16);
+            block[14] = (uint8_t)(counterValue >> 8);
+            block[15] = (uint8_t)counterValue;
+        }
+        succeeded = aws_aesEncryptBlocks(cryptor, keyStream, keyStream, blockCount * 16);
+        for (size_t i = 0; succeeded && i < chunkLength; i++) {
+            output[offset + i] = input[offset + i] ^ keyStream[i];
+        }
+    }
+
+    if (succeeded) {
+        if (encrypt) {
+            aws_ghashUpdate(&table, hash, output, length);
+        }
+        uint8_t lengths[16];
+        aws_store64(lengths, (uint64_t)additionalDataLength * 8);
+        aws_store64(lengths + 8, (uint64_t)length * 8);
+        aws_ghashUpdate(&table, hash, lengths, 16);
+        for (int i = 0; i < 16; i++) {
+            tag[i] = hash[i] ^ tagMask[i];
+        }
+    }
+
+    memset_s(keyStream, sizeof(keyStream), 0, sizeof(keyStream));
+    memset_s(&table, sizeof(table), 0, sizeof(table));
+    memset_s(hashKey, sizeof(hashKey), 0, sizeof(hashKey));
+    memset_s(tagMask, sizeof(tagMask), 0, sizeof(tagMask));
+    CCCryptorRelease(cryptor);
+    return succeeded;
+}
+
+static BOOL aws_constantTimeEqual(const uint8_t *bytes, const uint8_t *otherBytes, size_t length) {
+    uint8_t difference = 0;
+    for (size_t i = 0; i < length; i++) {
+        difference |= bytes[i] ^ otherBytes[i];
+    }
+    return difference == 0;
+}
+
+#pragma mark - AWSKMSDataKey
+
+// Moves the plaintext key out of an AWS KMS response into a buffer of our own, which `aws_wipeData` zeroes once the key
+// has been copied into an `AWSKMSDataKey`. The response's data is immutable, so it is released instead of written to.
+static NSMutableData *aws_takePlaintext(id response) {
+    NSMutableData *plaintext = [[response plaintext] mutableCopy];
+    [response setPlaintext:nil];
+    return plaintext;
+}
+
+static void aws_wipeData(NSMutableData *data) {
+    if ([data length] > 0) {
+        memset_s([data mutableBytes], [data length], 0, [data length]);
+    }
+}
+
+// A data key and its usage. The plaintext key is zeroed by `- wipe` and on deallocation. Every message is encrypted or
+// decrypted with a copy of a cached key, so a key can be wiped while it is in use.
+@interface AWSKMSDataKey : NSObject <NSCopying>
+
+@property (nonatomic, strong, readonly) NSData *encryptedKey;
+@property (nonatomic, strong, readonly) NSDate *creationDate;
+@property (nonatomic, assign, readonly) size_t plaintextKeyLength;
+@property (nonatomic, assign) NSUInteger messageCount;
+@property (nonatomic, assign) unsigned long long byteCount;
+
+- (instancetype)initWithPlaintextKey:(NSData *)plaintextKey
+                        encryptedKey:(NSData *)encryptedKey
+                        creationDate:(NSDate *)creationDate;
+
+- (const uint8_t *)plaintextKey;
+
+- (void)wipe;
+
+@end
+
+@implementation AWSKMSDataKey {
+    uint8_t _plaintextKey[kCCKeySizeAES256];
+}
+
+- (instancetype)initWithPlaintextKey:(NSData *)plaintextKey
+                        encryptedKey:(NSData *)encryptedKey
+                        creationDate:(NSDate *)creationDate {
+    if (self = [super init]) {
+        _plaintextKeyLength = MIN([plaintextKey length], sizeof(_plaintextKey));
+        memcpy(_plaintextKey, [plaintextKey bytes], _plaintextKeyLength);
+        _encryptedKey = encryptedKey;
+        _creationDate = creationDate;
+    }
+    return self;
+}
+
+- (instancetype)initWithDataKey:(AWSKMSDataKey *)dataKey {
+    if (self = [super init]) {
+        _plaintextKeyLength = dataKey.plaintextKeyLength;
+        memcpy(_plaintextKey, [dataKey plaintextKey], _plaintextKeyLength);
+        _encryptedKey = dataKey.encryptedKey;
+        _creationDate = dataKey.creationDate;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return [[AWSKMSDataKey allocWithZone:zone] initWithDataKey:self];
+}
+
+- (const uint8_t *)plaintextKey {
+    return _plaintextKey;
+}
+
+- (void)wipe {
+    memset_s(_plaintextKey, sizeof(_plaintextKey), 0, sizeof(_plaintextKey));
+}
+
+- (void)dealloc {
+    [self wipe];
+}
+
+@end
+
+#pragma mark - AWSKMSEnvelopeEncryptor
+
+@interface AWSKMSEnvelopeEncryptor()
+
+@property (nonatomic, strong) AWSKMS *kms;
+@property (nonatomic, strong) NSString *keyId;
+@property (nonatomic, strong) NSDictionary<NSString *, NSString *> *encryptionContext;
+@property (atomic, assign) NSUInteger hitCount;
+@property (atomic, assign) NSUInteger missCount;
+
+// The data key used for encryption, and the request for the next one.
+@property (nonatomic, strong) AWSKMSDataKey *encryptionKey;
+@property (nonatomic, strong) AWSTask *encryptionKeyTask;
+
+// The data keys used for decryption by encrypted key, from the least to the most recently used, and the pending requests.
+@property (nonatomic, strong) NSMutableDictionary<NSData *, AWSKMSDataKey *> *decryptionKeys;
+@property (nonatomic, strong) NSMutableOrderedSet<NSData *> *decryptionKeyOrder;
+@property (nonatomic, strong) NSMutableDictionary<NSData *, AWSTask<AWSKMSDataKey *> *> *decryptionKeyTasks;
+
+@end
+
+@implementation AWSKMSEnvelopeEncryptor
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithKMS:keyId:encryptionContext:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithKMS:(AWSKMS *)kms
+                      keyId:(NSString *)keyId
+          encryptionContext:(NSDictionary<NSString *, NSString *> *)encryptionContext {
+    if (self = [super init]) {
+        _kms = kms;
+        _keyId = keyId;
+        _encryptionContext = encryptionContext;
+        _maximumKeyAge = AWSKMSEnvelopeEncryptorDefaultMaximumKeyAge;
+        _maximumMessagesPerKey = AWSKMSEnvelopeEncryptorDefaultMaximumMessagesPerKey;
+        _maximumBytesPerKey = AWSKMSEnvelopeEncryptorDefaultMaximumBytesPerKey;
+        _maximumCachedKeys = AWSKMSEnvelopeEncryptorDefaultMaximumCachedKeys;
+        _decryptionKeys = [NSMutableDictionary new];
+        _decryptionKeyOrder = [NSMutableOrderedSet new];
+        _decryptionKeyTasks = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+#pragma mark - Encryption
+
+- (AWSTask<NSData *> *)encryptData:(NSData *)data {
+    return [[self encryptionKeyForMessageOfLength:[data length] waited:NO] continueWithSuccessBlock:^id(AWSTask<AWSKMSDataKey *> *task) {
+        AWSKMSDataKey *dataKey = task.result;
+        NSData *envelope = [self sealData:data withDataKey:dataKey];
+        [dataKey wipe];
+        if (!envelope) {
+            return [AWSTask taskWithError:[self errorWithType:AWSKMSEnvelopeEncryptorErrorUnknown
+                                                  description:@"Failed to encrypt the data."]];
+        }
+        return envelope;
+    }];
+}
+
+// Returns a copy of the data key used for encryption after counting the message against it, or waits for a new one.
+- (AWSTask<AWSKMSDataKey *> *)encryptionKeyForMessageOfLength:(NSUInteger)length
+                                                       waited:(BOOL)waited {
+    AWSTask *encryptionKeyTask = nil;
+    @synchronized(self) {
+        AWSKMSDataKey *dataKey = self.encryptionKey;
+        // A new key encrypts at least one message, whatever its length.
+        if (dataKey
+            && (dataKey.messageCount == 0
+                || (![self isDataKeyExpired:dataKey]
+                    && dataKey.messageCount < self.maximumMessagesPerKey
+                    && dataKey.byteCount + length <= self.maximumBytesPerKey))) {
+            dataKey.messageCount++;
+            dataKey.byteCount += length;
+            if (!waited) {
+                self.hitCount++;
+            }
+            return [AWSTask taskWithResult:[dataKey copy]];
+        }
+
+        if (dataKey) {
+            [dataKey wipe];
+            self.encryptionKey = nil;
+        }
+        if (!self.encryptionKeyTask || self.encryptionKeyTask.completed) {
+            self.missCount++;
+            self.encryptionKeyTask = [self generateDataKey];
+        } else if (!waited) {
+            self.hitCount++;
+        }
+        encryptionKeyTask = self.encryptionKeyTask;
+    }
+
+    return [encryptionKeyTask continueWithSuccessBlock:^id(AWSTask *task) {
+        return [self encryptionKeyForMessageOfLength:length waited:YES];
+    }];
+}
+
+- (AWSTask *)generateDataKey {
+    AWSKMSGenerateDataKeyRequest *request = [AWSKMSGenerateDataKeyRequest new];
+    request.keyId = self.keyId;
+    request.keySpec = AWSKMSDataKeySpecAes256;
+    request.encryptionContext = self.encryptionContext;
+
+    return [[self.kms generateDataKey:request] continueWithSuccessBlock:^id(AWSTask<AWSKMSGenerateDataKeyResponse *> *task) {
+        AWSKMSGenerateDataKeyResponse *response = task.result;
+        NSMutableData *plaintext = aws_takePlaintext(response);
+        if ([plaintext length] != kCCKeySizeAES256
+            || [response.ciphertextBlob length] == 0
+            || [response.ciphertextBlob length] > UINT16_MAX) {
+            aws_wipeData(plaintext);
+            return [AWSTask taskWithError:[self errorWithType:AWSKMSEnvelopeEncryptorErrorInvalidDataKey
+                                                  description:@"AWS KMS returned an invalid data key."]];
+        }
+
+        AWSKMSDataKey *dataKey = [[AWSKMSDataKey alloc] initWithPlaintextKey:plaintext
+                                                                encryptedKey:response.ciphertextBlob
+                                                                creationDate:[NSDate date]];
+        aws_wipeData(plaintext);
+        @synchronized(self) {
+            [self.encryptionKey wipe];
+            self.encryptionKey = dataKey;
+            [self cacheDecryptionKey:[dataKey copy]];
+        }
+        return nil;
+    }];
+}
+
+- (NSData *)sealData:(NSData *)data withDataKey:(AWSKMSDataKey *)dataKey {
+    NSData *encryptedKey = dataKey.encryptedKey;
+    size_t encryptedKeyLength = [encryptedKey length];
+    size_t headerLength = 3 + encryptedKeyLength + AWSKMSEnvelopeIVLength;
+    size_t dataLength = [data length];
+
+    NSMutableData *envelope = [NSMutableData dataWithLength:headerLength + dataLength + AWSKMSEnvelopeTagLength];
+    uint8_t *bytes = [envelope mutableBytes];
+    bytes[0] = AWSKMSEnvelopeVersion;
+    bytes[1] = (uint8_t)(encryptedKeyLength >> 8);
+    bytes[2] = (uint8_t)encryptedKeyLength;
+    memcpy(bytes + 3, [encryptedKey bytes], encryptedKeyLength);
+    uint8_t *iv = bytes + 3 + encryptedKeyLength;
+    arc4random_buf(iv, AWSKMSEnvelopeIVLength);
+
+    if (!aws_gcmCrypt(YES,
+                      [dataKey plaintextKey], dataKey.plaintextKeyLength,
+                      iv,
+                      bytes, headerLength,
+                      [data bytes], bytes + headerLength, dataLength,
+                      bytes + headerLength + dataLength)) {
+        return nil;
+    }
+    return envelope;
+}
+
+#pragma mark - Decryption
+
+- (AWSTask<NSData *> *)decryptData:(NSData *)envelope {
+    const uint8_t *bytes = [envelope bytes];
+    size_t envelopeLength = [envelope length];
+    size_t encryptedKeyLength = envelopeLength >= 3 ? ((size_t)bytes[1] << 8) | bytes[2] : 0;
+    size_t headerLength = 3 + encryptedKeyLength + AWSKMSEnvelopeIVLength;
+    if (envelopeLength < 3
+        || bytes[0] != AWSKMSEnvelopeVersion
+        || encryptedKeyLength == 0
+        || envelopeLength < headerLength + AWSKMSEnvelopeTagLength) {
+        return [AWSTask taskWithError:[self errorWithType:AWSKMSEnvelopeEncryptorErrorInvalidEnvelope
+                                              description:@"The envelope is not valid."]];
+    }
+
+    NSData *encryptedKey = [envelope subdataWithRange:NSMakeRange(3, encryptedKeyLength)];
+    return [[self decryptionKeyForEncryptedKey:encryptedKey] continueWithSuccessBlock:^id(AWSTask<AWSKMSDataKey *> *task) {
+        AWSKMSDataKey *dataKey = task.result;
+        NSError *error = nil;
+        NSData *data = [self openEnvelope:envelope headerLength:headerLength withDataKey:dataKey error:&error];
+        [dataKey wipe];
+        if (!data) {
+            return [AWSTask taskWithError:error];
+        }
+        return data;
+    }];
+}
+
+// Returns a copy of the cached data key of an encrypted key, or waits for AWS KMS to decrypt it.
+- (AWSTask<AWSKMSDataKey *> *)decryptionKeyForEncryptedKey:(NSData *)encryptedKey {
+    AWSTask<AWSKMSDataKey *> *decryptionKeyTask = nil;
+    @synchronized(self) {
+        AWSKMSDataKey *dataKey = self.decryptionKeys[encryptedKey];
+        if (dataKey && [self isDataKeyExpired:dataKey]) {
+            [self removeDecryptionKey:encryptedKey];
+            dataKey = nil;
+        }
+        if (dataKey) {
+            [self.decryptionKeyOrder removeObject:encryptedKey];
+            [self.decryptionKeyOrder addObject:encryptedKey];
+            self.hitCount++;
+            return [AWSTask taskWithResult:[dataKey copy]];
+        }
+
+        decryptionKeyTask = self.decryptionKeyTasks[encryptedKey];
+        if (decryptionKeyTask) {
+            self.hitCount++;
+        } else {
+            self.missCount++;
+            decryptionKeyTask = [self decryptDataKey:encryptedKey];
+            if (!decryptionKeyTask.completed) {
+                self.decryptionKeyTasks[encryptedKey] = decryptionKeyTask;
+            }
+        }
+    }
+
+    return [decryptionKeyTask continueWithSuccessBlock:^id(AWSTask<AWSKMSDataKey *> *task) {
+        return [task.result copy];
+    }];
+}
+
+- (AWSTask<AWSKMSDataKey *> *)decryptDataKey:(NSData *)encryptedKey {
+    AWSKMSDecryptRequest *request = [AWSKMSDecryptRequest new];
+    request.ciphertextBlob = encryptedKey;
+    request.keyId = self.keyId;
+    request.encryptionContext = self.encryptionContext;
+
+    return [[self.kms decrypt:request] continueWithBlock:^id(AWSTask<AWSKMSDecryptResponse *> *task) {
+        @synchronized(self) {
+            [self.decryptionKeyTasks removeObjectForKey:encryptedKey];
+        }
+        if (task.error) {
+            return task;
+        }
+
+        NSMutableData *plaintext = aws_takePlaintext(task.result);
+        if ([plaintext length] != kCCKeySizeAES256) {
+            aws_wipeData(plaintext);
+            return [AWSTask taskWithError:[self errorWithType:AWSKMSEnvelopeEncryptorErrorInvalidDataKey
+                                                  description:@"AWS KMS returned an invalid data key."]];
+        }
+
+        AWSKMSDataKey *dataKey = [[AWSKMSDataKey alloc] initWithPlaintextKey:plaintext
+                                                                encryptedKey:encryptedKey
+                                                                creationDate:[NSDate date]];
+        aws_wipeData(plaintext);
+        @synchronized(self) {
+            [self cacheDecryptionKey:[dataKey copy]];
+        }
+        return dataKey;
+    }];
+}
+
+- (NSData *)openEnvelope:(NSData *)envelope
+            headerLength:(size_t)headerLength
+             withDataKey:(AWSKMSDataKey *)dataKey
+                   error:(NSError **)error {
+    const uint8_t *bytes = [envelope bytes];
+    size_t dataLength = [envelope length] - headerLength - AWSKMSEnvelopeTagLength;
+    NSMutableData *data = [NSMutableData dataWithLength:dataLength];
+    uint8_t tag[AWSKMSEnvelopeTagLength];
+
+    if (!aws_gcmCrypt(NO,
+                      [dataKey plaintextKey], dataKey.plaintextKeyLength,
+                      bytes + headerLength - AWSKMSEnvelopeIVLength,
+                      bytes, headerLength,
+                      bytes + headerLength, [data mutableBytes], dataLength,
+                      tag)) {
+        *error = [self errorWithType:AWSKMSEnvelopeEncryptorErrorUnknown
+                         description:@"Failed to decrypt the envelope."];
+        return nil;
+    }
+    if (!aws_constantTimeEqual(tag, bytes + headerLength + dataLength, AWSKMSEnvelopeTagLength)) {
+        memset_s([data mutableBytes], dataLength, 0, dataLength);
+        *error = [self errorWithType:AWSKMSEnvelopeEncryptorErrorAuthenticationFailed
+                         description:@"The envelope failed authentication."];
+        return nil;
+    }
+    return data;
+}
+
+#pragma mark - Cache
+
+- (BOOL)isDataKeyExpired:(AWSKMSDataKey *)dataKey {
+    return -[dataKey.creationDate timeIntervalSinceNow] >= self.maximumKeyAge;
+}
+
+- (void)cacheDecryptionKey:(AWSKMSDataKey *)dataKey {
+    NSData *encryptedKey = dataKey.encryptedKey;
+    [self.decryptionKeys[encryptedKey] wipe];
+    self.decryptionKeys[encryptedKey] = dataKey;
+    [self.decryptionKeyOrder removeObject:encryptedKey];
+    [self.decryptionKeyOrder addObject:encryptedKey];
+    while ([self.decryptionKeyOrder count] > self.maximumCachedKeys) {
+        [self removeDecryptionKey:[self.decryptionKeyOrder firstObject]];
+    }
+}
+
+- (void)removeDecryptionKey:(NSData *)encryptedKey {
+    [self.decryptionKeys[encryptedKey] wipe];
+    [self.decryptionKeys removeObjectForKey:encryptedKey];
+    [self.decryptionKeyOrder removeObject:encryptedKey];
+}
+
+- (void)removeAllCachedKeys {
+    @synchronized(self) {
+        [self.encryptionKey wipe];
+        self.encryptionKey = nil;
+        for (AWSKMSDataKey *dataKey in [self.decryptionKeys allValues]) {
+            [dataKey wipe];
+        }
+        [self.decryptionKeys removeAllObjects];
+        [self.decryptionKeyOrder removeAllObjects];
+    }
+}
+
+- (NSError *)errorWithType:(AWSKMSEnvelopeEncryptorErrorType)type description:(NSString *)description {
+    return [NSError errorWithDomain:AWSKMSEnvelopeEncryptorErrorDomain
+                               code:type
+                           userInfo:@{NSLocalizedDescriptionKey : description}];
+}
+
+@end
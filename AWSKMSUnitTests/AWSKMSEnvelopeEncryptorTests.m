@@ -0,0 +1,417 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSKMS.h"
+#import "AWSKMSEnvelopeEncryptor.h"
+
+@interface AWSKMS()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSKMSDataKey : NSObject
+
+@property (nonatomic, assign, readonly) size_t plaintextKeyLength;
+
+- (const uint8_t *)plaintextKey;
+
+@end
+
+@interface AWSKMSEnvelopeEncryptor()
+
+@property (nonatomic, strong) AWSKMSDataKey *encryptionKey;
+@property (nonatomic, strong) NSMutableDictionary<NSData *, AWSKMSDataKey *> *decryptionKeys;
+
+@end
+
+// Generates random data keys, and decrypts the ones it generated, after a fixed latency.
+@interface AWSKMSEnvelopeEncryptorTestKMS : AWSKMS
+
+@property (nonatomic, assign) NSTimeInterval requestLatency;
+@property (nonatomic, assign) BOOL failsRequests;
+@property (atomic, assign) NSUInteger generateDataKeyCount;
+@property (atomic, assign) NSUInteger decryptCount;
+@property (nonatomic, strong) NSMutableDictionary<NSData *, NSData *> *plaintextKeys;
+// Every response returned.
+@property (nonatomic, strong) NSMutableArray *responses;
+
+@end
+
+@implementation AWSKMSEnvelopeEncryptorTestKMS
+
+- (AWSTask *)respondWithBlock:(id (^)(void))block {
+    AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource taskCompletionSource];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.requestLatency * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        id result = block();
+        if ([result isKindOfClass:[NSError class]]) {
+            [completionSource setError:result];
+        } else {
+            [completionSource setResult:result];
+        }
+    });
+    return completionSource.task;
+}
+
+- (AWSTask<AWSKMSGenerateDataKeyResponse *> *)generateDataKey:(AWSKMSGenerateDataKeyRequest *)request {
+    self.generateDataKeyCount++;
+    return [self respondWithBlock:^id{
+        if (self.failsRequests) {
+            return [NSError errorWithDomain:AWSKMSErrorDomain code:AWSKMSErrorKMSInternal userInfo:nil];
+        }
+        NSMutableData *plaintextKey = [NSMutableData dataWithLength:32];
+        arc4random_buf([plaintextKey mutableBytes], [plaintextKey length]);
+        NSMutableData *encryptedKey = [[@"encrypted-data-key-" dataUsingEncoding:NSUTF8StringEncoding] mutableCopy];
+        [encryptedKey increaseLengthBy:16];
+        arc4random_buf((uint8_t *)[encryptedKey mutableBytes] + [encryptedKey length] - 16, 16);
+        @synchronized(self) {
+            self.plaintextKeys[encryptedKey] = plaintextKey;
+        }
+
+        AWSKMSGenerateDataKeyResponse *response = [AWSKMSGenerateDataKeyResponse new];
+        response.keyId = request.keyId;
+        response.plaintext = plaintextKey;
+        response.ciphertextBlob = encryptedKey;
+        @synchronized(self) {
+            [self.responses addObject:response];
+        }
+        return response;
+    }];
+}
+
+- (AWSTask<AWSKMSDecryptResponse *> *)decrypt:(AWSKMSDecryptRequest *)request {
+    self.decryptCount++;
+    return [self respondWithBlock:^id{
+        NSData *plaintextKey = nil;
+        @synchronized(self) {
+            plaintextKey = self.plaintextKeys[request.ciphertextBlob];
+        }
+        if (self.failsRequests || !plaintextKey) {
+            return [NSError errorWithDomain:AWSKMSErrorDomain code:AWSKMSErrorInvalidCiphertext userInfo:nil];
+        }
+
+        AWSKMSDecryptResponse *response = [AWSKMSDecryptResponse new];
+        response.keyId = request.keyId;
+        response.plaintext = plaintextKey;
+        @synchronized(self) {
+            [self.responses addObject:response];
+        }
+        return response;
+    }];
+}
+
+@end
+
+@interface AWSKMSEnvelopeEncryptorTests : XCTestCase
+
+@property (nonatomic, strong) AWSKMSEnvelopeEncryptorTestKMS *kms;
+
+@end
+
+@implementation AWSKMSEnvelopeEncryptorTests
+
+- (void)setUp {
+    [super setUp];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:nil];
+    self.kms = [[AWSKMSEnvelopeEncryptorTestKMS alloc] initWithConfiguration:configuration];
+    self.kms.plaintextKeys = [NSMutableDictionary new];
+    self.kms.responses = [NSMutableArray new];
+    self.kms.requestLatency = 0.005;
+}
+
+- (AWSKMSEnvelopeEncryptor *)encryptor {
+    return [[AWSKMSEnvelopeEncryptor alloc] initWithKMS:self.kms
+                                                  keyId:@"alias/test"
+                                      encryptionContext:@{@"store" : @"test"}];
+}
+
+- (NSData *)randomDataOfLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    arc4random_buf([data mutableBytes], length);
+    return data;
+}
+
+- (NSData *)encryptData:(NSData *)data withEncryptor:(AWSKMSEnvelopeEncryptor *)encryptor {
+    AWSTask<NSData *> *task = [encryptor encryptData:data];
+    [task waitUntilFinished];
+    XCTAssertNil(task.error);
+    return task.result;
+}
+
+- (AWSTask<NSData *> *)decryptEnvelope:(NSData *)envelope withEncryptor:(AWSKMSEnvelopeEncryptor *)encryptor {
+    AWSTask<NSData *> *task = [encryptor decryptData:envelope];
+    [task waitUntilFinished];
+    return task;
+}
+
+- (BOOL)isZeroed:(AWSKMSDataKey *)dataKey {
+    for (size_t i = 0; i < dataKey.plaintextKeyLength; i++) {
+        if ([dataKey plaintextKey][i] != 0) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (void)testRoundTrip {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    AWSKMSEnvelopeEncryptor *otherEncryptor = [self encryptor];
+
+    for (NSNumber *length in @[@0, @1, @15, @16, @17, @4095, @4096, @4097, @100000]) {
+        NSData *data = [self randomDataOfLength:[length unsignedIntegerValue]];
+        NSData *envelope = [self encryptData:data withEncryptor:encryptor];
+        XCTAssertNotNil(envelope);
+        XCTAssertFalse([length unsignedIntegerValue] > 16 && [envelope rangeOfData:data options:0 range:NSMakeRange(0, [envelope length])].location != NSNotFound);
+
+        XCTAssertEqualObjects([self decryptEnvelope:envelope withEncryptor:encryptor].result, data);
+        XCTAssertEqualObjects([self decryptEnvelope:envelope withEncryptor:otherEncryptor].result, data);
+    }
+
+    // The data key was generated once and decrypted once, by the other encryptor.
+    XCTAssertEqual(self.kms.generateDataKeyCount, 1);
+    XCTAssertEqual(self.kms.decryptCount, 1);
+}
+
+- (void)testEncryptionIsRandomized {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    NSData *data = [@"The same message." dataUsingEncoding:NSUTF8StringEncoding];
+
+    XCTAssertNotEqualObjects([self encryptData:data withEncryptor:encryptor], [self encryptData:data withEncryptor:encryptor]);
+}
+
+- (void)testDataKeyIsReplacedAfterMaximumMessages {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    encryptor.maximumMessagesPerKey = 10;
+
+    for (NSUInteger i = 0; i < 25; i++) {
+        [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    }
+
+    XCTAssertEqual(self.kms.generateDataKeyCount, 3);
+    XCTAssertEqual(encryptor.missCount, 3);
+    XCTAssertEqual(encryptor.hitCount, 22);
+}
+
+- (void)testDataKeyIsReplacedAfterMaximumBytes {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    encryptor.maximumBytesPerKey = 1000;
+
+    for (NSUInteger i = 0; i < 6; i++) {
+        [self encryptData:[self randomDataOfLength:400] withEncryptor:encryptor];
+    }
+    XCTAssertEqual(self.kms.generateDataKeyCount, 3);
+
+    // A message larger than the limit gets a key of its own.
+    [self encryptData:[self randomDataOfLength:5000] withEncryptor:encryptor];
+    [self encryptData:[self randomDataOfLength:400] withEncryptor:encryptor];
+    XCTAssertEqual(self.kms.generateDataKeyCount, 5);
+}
+
+- (void)testDataKeyIsReplacedAfterMaximumAge {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+
+    NSData *envelope = [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    XCTAssertEqual(self.kms.generateDataKeyCount, 1);
+
+    // With no maximum age, every key is expired as soon as it has encrypted its first message.
+    encryptor.maximumKeyAge = 0;
+
+    [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    XCTAssertEqual(self.kms.generateDataKeyCount, 2);
+    [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    XCTAssertEqual(self.kms.generateDataKeyCount, 3);
+
+    // The expired key is decrypted again.
+    XCTAssertNotNil([self decryptEnvelope:envelope withEncryptor:encryptor].result);
+    XCTAssertEqual(self.kms.decryptCount, 1);
+}
+
+- (void)testConcurrentMessagesShareOneRequest {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    self.kms.requestLatency = 0.1;
+
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 50; i++) {
+        [tasks addObject:[encryptor encryptData:[self randomDataOfLength:100]]];
+    }
+    [[AWSTask taskForCompletionOfAllTasksWithResults:tasks] waitUntilFinished];
+    XCTAssertEqual(self.kms.generateDataKeyCount, 1);
+    XCTAssertEqual(encryptor.missCount, 1);
+    XCTAssertEqual(encryptor.hitCount, 49);
+
+    AWSKMSEnvelopeEncryptor *otherEncryptor = [self encryptor];
+    NSMutableArray<AWSTask *> *decryptionTasks = [NSMutableArray new];
+    for (AWSTask *task in tasks) {
+        [decryptionTasks addObject:[otherEncryptor decryptData:task.result]];
+    }
+    AWSTask *decryptionTask = [AWSTask taskForCompletionOfAllTasksWithResults:decryptionTasks];
+    [decryptionTask waitUntilFinished];
+    XCTAssertNil(decryptionTask.error);
+    XCTAssertEqual(self.kms.decryptCount, 1);
+}
+
+- (void)testDecryptionKeysAreCachedByEncryptedKey {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    encryptor.maximumMessagesPerKey = 10;
+    NSMutableArray<NSData *> *envelopes = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [envelopes addObject:[self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor]];
+    }
+    XCTAssertEqual(self.kms.generateDataKeyCount, 10);
+
+    AWSKMSEnvelopeEncryptor *otherEncryptor = [self encryptor];
+    for (NSData *envelope in envelopes) {
+        XCTAssertNotNil([self decryptEnvelope:envelope withEncryptor:otherEncryptor].result);
+    }
+    XCTAssertEqual(self.kms.decryptCount, 10);
+    XCTAssertEqual(otherEncryptor.missCount, 10);
+    XCTAssertEqual(otherEncryptor.hitCount, 90);
+
+    // With one cached key, alternating between two keys decrypts every time.
+    AWSKMSEnvelopeEncryptor *smallEncryptor = [self encryptor];
+    smallEncryptor.maximumCachedKeys = 1;
+    for (NSUInteger i = 0; i < 4; i++) {
+        [self decryptEnvelope:envelopes[(i % 2) * 10] withEncryptor:smallEncryptor];
+    }
+    XCTAssertEqual(self.kms.decryptCount, 14);
+}
+
+- (void)testPlaintextKeysAreZeroed {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    encryptor.maximumMessagesPerKey = 1;
+    encryptor.maximumCachedKeys = 1;
+
+    [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    AWSKMSDataKey *encryptionKey = encryptor.encryptionKey;
+    AWSKMSDataKey *decryptionKey = [[encryptor.decryptionKeys allValues] firstObject];
+    XCTAssertEqual(encryptionKey.plaintextKeyLength, 32);
+    XCTAssertFalse([self isZeroed:encryptionKey]);
+    XCTAssertFalse([self isZeroed:decryptionKey]);
+
+    [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    XCTAssertTrue([self isZeroed:encryptionKey]);
+    XCTAssertTrue([self isZeroed:decryptionKey]);
+
+    encryptionKey = encryptor.encryptionKey;
+    decryptionKey = [[encryptor.decryptionKeys allValues] firstObject];
+    [encryptor removeAllCachedKeys];
+    XCTAssertTrue([self isZeroed:encryptionKey]);
+    XCTAssertTrue([self isZeroed:decryptionKey]);
+    XCTAssertEqual([encryptor.decryptionKeys count], 0);
+}
+
+- (void)testResponsePlaintextKeysAreReleased {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+
+    NSData *envelope = [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    [encryptor removeAllCachedKeys];
+    XCTAssertNotNil([self decryptEnvelope:envelope withEncryptor:encryptor].result);
+
+    // The responses no longer hold the plaintext keys, and the keys the test KMS keeps were never written to.
+    XCTAssertEqual([self.kms.responses count], 2);
+    for (id response in self.kms.responses) {
+        XCTAssertNil([response plaintext]);
+    }
+    for (NSData *plaintextKey in [self.kms.plaintextKeys allValues]) {
+        XCTAssertNotEqualObjects(plaintextKey, [NSMutableData dataWithLength:32]);
+    }
+}
+
+- (void)testModifiedEnvelopeFailsAuthentication {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    NSData *envelope = [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+
+    // The IV, the encrypted data and the tag.
+    for (NSNumber *offsetFromEnd in @[@120, @50, @1]) {
+        NSMutableData *modifiedEnvelope = [envelope mutableCopy];
+        ((uint8_t *)[modifiedEnvelope mutableBytes])[[envelope length] - [offsetFromEnd unsignedIntegerValue]] ^= 1;
+        AWSTask *task = [self decryptEnvelope:modifiedEnvelope withEncryptor:encryptor];
+        XCTAssertNil(task.result);
+        XCTAssertEqualObjects(task.error.domain, AWSKMSEnvelopeEncryptorErrorDomain);
+        XCTAssertEqual(task.error.code, AWSKMSEnvelopeEncryptorErrorAuthenticationFailed);
+    }
+
+    for (NSData *invalidEnvelope in @[[NSData data], [envelope subdataWithRange:NSMakeRange(0, 40)]]) {
+        AWSTask *task = [self decryptEnvelope:invalidEnvelope withEncryptor:encryptor];
+        XCTAssertEqualObjects(task.error.domain, AWSKMSEnvelopeEncryptorErrorDomain);
+        XCTAssertEqual(task.error.code, AWSKMSEnvelopeEncryptorErrorInvalidEnvelope);
+    }
+}
+
+- (void)testKMSErrorIsReturned {
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    NSData *envelope = [self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor];
+    self.kms.failsRequests = YES;
+
+    AWSTask *task = [encryptor encryptData:[self randomDataOfLength:100]];
+    [task waitUntilFinished];
+    XCTAssertNotNil(task.result);
+
+    [encryptor removeAllCachedKeys];
+    task = [encryptor encryptData:[self randomDataOfLength:100]];
+    [task waitUntilFinished];
+    XCTAssertEqualObjects(task.error.domain, AWSKMSErrorDomain);
+
+    task = [self decryptEnvelope:envelope withEncryptor:encryptor];
+    XCTAssertEqualObjects(task.error.domain, AWSKMSErrorDomain);
+
+    // A failed request is not cached.
+    self.kms.failsRequests = NO;
+    XCTAssertNotNil([self encryptData:[self randomDataOfLength:100] withEncryptor:encryptor]);
+    XCTAssertNotNil([self decryptEnvelope:envelope withEncryptor:encryptor].result);
+}
+
+- (void)testPerformance {
+    NSUInteger messageCount = 200;
+    NSData *message = [self randomDataOfLength:1024];
+    self.kms.requestLatency = 0.01;
+
+    for (NSNumber *cached in @[@NO, @YES]) {
+        AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+        AWSKMSEnvelopeEncryptor *otherEncryptor = [self encryptor];
+        if (![cached boolValue]) {
+            encryptor.maximumMessagesPerKey = 1;
+            otherEncryptor.maximumCachedKeys = 0;
+        }
+        NSUInteger requestCount = self.kms.generateDataKeyCount + self.kms.decryptCount;
+
+        NSDate *start = [NSDate date];
+        for (NSUInteger i = 0; i < messageCount; i++) {
+            NSData *envelope = [self encryptData:message withEncryptor:encryptor];
+            XCTAssertEqualObjects([self decryptEnvelope:envelope withEncryptor:otherEncryptor].result, message);
+        }
+        NSTimeInterval duration = -[start timeIntervalSinceNow];
+
+        NSLog(@"%@: %lu messages of 1KB encrypted and decrypted in %.3fs, %.0f messages/s, %lu KMS requests",
+              [cached boolValue] ? @"Cached" : @"Uncached",
+              (unsigned long)messageCount,
+              duration,
+              messageCount / duration,
+              (unsigned long)(self.kms.generateDataKeyCount + self.kms.decryptCount - requestCount));
+    }
+
+    AWSKMSEnvelopeEncryptor *encryptor = [self encryptor];
+    NSData *largeMessage = [self randomDataOfLength:1024 * 1024];
+    NSDate *start = [NSDate date];
+    for (NSUInteger i = 0; i < 16; i++) {
+        [self decryptEnvelope:[self encryptData:largeMessage withEncryptor:encryptor] withEncryptor:encryptor];
+    }
+    NSLog(@"AES-GCM: %.1f MB/s encrypted and decrypted", 16 / -[start timeIntervalSinceNow]);
+}
+
+@end
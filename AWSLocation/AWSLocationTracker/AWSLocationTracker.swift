@@ -34,6 +34,8 @@ public class AWSLocationTracker {
     let trackerName: String
     let locationService: AWSLocationBehavior
     let locationsQueue: AtomicValue<[CLLocation]> = AtomicValue(initialValue: [])
+    let locationsQueueStore: LocationsQueueStore
+    let lastQueuedLocation: AtomicValue<CLLocation?> = AtomicValue(initialValue: nil)
     var trackerOptions: TrackerOptions?
     var trackingEnabled: AtomicValue<Bool> = AtomicValue(initialValue: false)
     
@@ -67,9 +69,11 @@ public class AWSLocationTracker {
     
     /// Internal constructor for testing
     init(trackerName: String,
-         locationService: AWSLocationBehavior) {
+         locationService: AWSLocationBehavior,
+         locationsQueueStore: LocationsQueueStore? = nil) {
         self.trackerName = trackerName
         self.locationService = locationService
+        self.locationsQueueStore = locationsQueueStore ?? LocationsQueueStore(trackerName: trackerName)
         self.operationQueue = OperationQueue()
         operationQueue.name = "com.amazonaws.AWSLocationTrackerOperationQueue"
         operationQueue.maxConcurrentOperationCount = 1
@@ -98,6 +102,7 @@ public class AWSLocationTracker {
         self.trackerOptions = getDefaultTrackerOptions(options: options)
         self.delegate = delegate
         self.listener = listener
+        self.restoreLocationsQueue()
         self.setUpRetrieveLocationsTimer()
         self.setUpEmitLocationsTimer()
         self.trackingEnabled.set(true)
@@ -113,8 +118,20 @@ public class AWSLocationTracker {
             AWSLocationTrackerLogger.info("Locations intercepted, do nothing. Tracking is stopped.")
             return
         }
-        AWSLocationTrackerLogger.info("Adding \(locations.count) locations to the queue.")
-        locationsQueue.append(contentsOf: locations)
+        var queuedLocations = locations
+        if let positionFilter = trackerOptions?.positionFilter {
+            lastQueuedLocation.with { lastQueuedLocation in
+                let filtered = positionFilter.filter(locations, lastKeptLocation: lastQueuedLocation)
+                queuedLocations = filtered.locations
+                lastQueuedLocation = filtered.lastKeptLocation
+            }
+        }
+        AWSLocationTrackerLogger.info("Adding \(queuedLocations.count) of \(locations.count) locations to the queue.")
+        let droppedCount = locationsQueue.append(contentsOf: queuedLocations, maximumCount: maximumQueuedLocations)
+        if droppedCount > 0 {
+            AWSLocationTrackerLogger.info("Locations queue is full, dropped the \(droppedCount) oldest locations.")
+        }
+        saveLocationsQueue()
     }
     
     /// True if this tracker instance is currently monitoring and sending the device's location. False otherwise.
@@ -134,7 +151,10 @@ public class AWSLocationTracker {
             listener(.onStop)
         }
         
+        // An emit operation still running must not queue its failed locations again once the queue is emptied
+        operationQueue.cancelAllOperations()
         reset()
+        locationsQueueStore.remove()
     }
     
     // MARK: - Internal methods
@@ -154,11 +174,14 @@ public class AWSLocationTracker {
             return trackerOptions
         }
         
-        // `customDeviceId` is to be generated, reuse existing retrieve and emit location frequenceies
+        // `customDeviceId` is to be generated, reuse the other passed in options
         return TrackerOptions(customDeviceId: tryGetDeviceId(for: trackerName,
                                                              userDefaults: userDefaults),
                               retrieveLocationFrequency: trackerOptions.retrieveLocationFrequency,
-                              emitLocationFrequency: trackerOptions.emitLocationFrequency)
+                              emitLocationFrequency: trackerOptions.emitLocationFrequency,
+                              positionFilter: trackerOptions.positionFilter,
+                              maximumQueuedLocations: trackerOptions.maximumQueuedLocations,
+                              persistsQueuedLocations: trackerOptions.persistsQueuedLocations)
     }
     
     func tryGetDeviceId(for trackerName: String,
@@ -202,14 +225,51 @@ public class AWSLocationTracker {
                 let operation = EmitLocationsOperation(trackerName: self.trackerName,
                                                        deviceId: deviceId,
                                                        locationsQueue: self.locationsQueue,
+                                                       maximumQueuedLocations: options.maximumQueuedLocations,
                                                        locationService: self.locationService,
                                                        listener: self.listener)
+                operation.completionBlock = { [weak self] in
+                    // Locations that failed to be published may have been queued again
+                    self?.saveLocationsQueue()
+                }
                 self.operationQueue.addOperation(operation)
                 
             })
         emitLocationsTimer?.resume()
     }
     
+    var maximumQueuedLocations: Int {
+        return trackerOptions?.maximumQueuedLocations ?? TrackerOptions.defaultMaximumQueuedLocations
+    }
+    
+    /// Queues the locations saved when the app last ran, ahead of any locations retrieved since.
+    func restoreLocationsQueue() {
+        guard trackerOptions?.persistsQueuedLocations == true else {
+            return
+        }
+        let savedLocations = locationsQueueStore.load()
+        guard !savedLocations.isEmpty else {
+            return
+        }
+        AWSLocationTrackerLogger.info("Restoring \(savedLocations.count) saved locations to the queue.")
+        locationsQueue.prepend(contentsOf: savedLocations, maximumCount: maximumQueuedLocations)
+    }
+    
+    /// Saves the locations queue while tracking. The queue is read when the save runs on the store's serial queue, so
+    /// the saves requested by a burst of retrievals are written once. A save that runs after `stopTracking` has
+    /// requested the removal of the saved locations finds tracking stopped, and writes nothing.
+    func saveLocationsQueue() {
+        guard trackerOptions?.persistsQueuedLocations == true else {
+            return
+        }
+        locationsQueueStore.save { [weak self] in
+            guard let self = self, self.trackingEnabled.get() else {
+                return nil
+            }
+            return self.locationsQueue.get()
+        }
+    }
+    
     private func reset() {
         if delegate != nil {
             delegate = nil
@@ -229,6 +289,7 @@ public class AWSLocationTracker {
         }
         
         locationsQueue.set([])
+        lastQueuedLocation.set(nil)
         trackingEnabled.set(false)
     }
     
@@ -17,8 +17,10 @@ import CoreLocation
 class EmitLocationsOperation: AsynchronousOperation {
     private static let locationExpiryTime = TimeInterval(60*60) // 1 hour before a location update is considered expired.
     private static let maximumBatchSize = 10 // 10 position updates per request as per service validation logic
+    private static let maximumConcurrentBatches = 3 // Requests in flight at once
     
     private let locationsQueue: AtomicValue<[CLLocation]>
+    private let maximumQueuedLocations: Int
     private let deviceId: String
     private let trackerName: String
     private let listener: ((TrackingListener) -> Void)?
@@ -30,12 +32,14 @@ class EmitLocationsOperation: AsynchronousOperation {
     init(trackerName: String,
          deviceId: String,
          locationsQueue: AtomicValue<[CLLocation]>,
+         maximumQueuedLocations: Int = TrackerOptions.defaultMaximumQueuedLocations,
          locationService: AWSLocationBehavior,
          isCalledFromBackgroundTask: Bool = false,
          listener: ((TrackingListener) -> Void)?) {
         self.trackerName = trackerName
         self.deviceId = deviceId
         self.locationsQueue = locationsQueue
+        self.maximumQueuedLocations = maximumQueuedLocations
         self.locationService = locationService
         self.isCalledFromBackgroundTask = isCalledFromBackgroundTask
         self.listener = listener
@@ -49,51 +53,59 @@ class EmitLocationsOperation: AsynchronousOperation {
             return
         }
         
+        let now = Date()
         let unexpiredLocations = self.locationsQueue.getAndSet([]).filter { (location) -> Bool in
-            return Date().timeIntervalSince(location.timestamp) < EmitLocationsOperation.locationExpiryTime
+            return now.timeIntervalSince(location.timestamp) < EmitLocationsOperation.locationExpiryTime
         }
         
-        let totalPositionUpdates = unexpiredLocations.map { (location) -> AWSLocationDevicePositionUpdate in
-            location.toAWSLocationDevicePositionUpdate(deviceId: deviceId)
-        }
-        
-        guard totalPositionUpdates.count != 0 else {
+        guard unexpiredLocations.count != 0 else {
             AWSLocationTrackerLogger.info("No locations to emit")
             finish()
             return
         }
         
-        AWSLocationTrackerLogger.info("Emitting \(totalPositionUpdates.count) locations to Amazon Location Service.")
+        AWSLocationTrackerLogger.info("Emitting \(unexpiredLocations.count) locations to Amazon Location Service.")
         
-        let positionUpdateBatches = totalPositionUpdates.chunked(into: EmitLocationsOperation.maximumBatchSize)
-        for (index, positionUpdates) in positionUpdateBatches.enumerated() {
+        // Up to `maximumConcurrentBatches` requests are in flight at once, each with its own locations so that only
+        // those are queued again when the request fails.
+        let batchesInFlight = DispatchSemaphore(value: EmitLocationsOperation.maximumConcurrentBatches)
+        let locationBatches = unexpiredLocations.chunked(into: EmitLocationsOperation.maximumBatchSize)
+        for (index, locations) in locationBatches.enumerated() {
+            guard !isCancelled else {
+                AWSLocationTrackerLogger.info("Emitting cancelled, \(locationBatches.count - index) batches not sent.")
+                break
+            }
             AWSLocationTrackerLogger.verbose(
-                "Emitting locations to Amazon Location Service. Batch \(index + 1) of \(positionUpdates.count)")
+                "Emitting locations to Amazon Location Service. Batch \(index + 1) of \(locationBatches.count)")
 
             guard let request = AWSLocationBatchUpdateDevicePositionRequest() else {
                 fatalError("Could not instantiate `AWSLocationBatchUpdateDevicePositionRequest()`")
             }
             request.trackerName = trackerName
-            request.updates = positionUpdates
+            request.updates = locations.map { (location) -> AWSLocationDevicePositionUpdate in
+                location.toAWSLocationDevicePositionUpdate(deviceId: deviceId)
+            }
         
+            batchesInFlight.wait()
             group.enter()
             locationService.batchUpdateDevicePosition(request) { (response, error) in
-                self.positionsUpdatedCompletionHandler(unexpiredLocations: unexpiredLocations,
+                self.positionsUpdatedCompletionHandler(locations: locations,
                                                        request: request,
                                                        response: response,
                                                        error: error,
                                                        onComplete: {
+                                                        batchesInFlight.signal()
                                                         self.group.leave()
                                                        })
             }
-            group.wait()
         }
+        group.wait()
         finish()
     }
 
     // MARK: - Response Handling
     
-    private func positionsUpdatedCompletionHandler(unexpiredLocations: [CLLocation],
+    private func positionsUpdatedCompletionHandler(locations: [CLLocation],
                                                    request: AWSLocationBatchUpdateDevicePositionRequest,
                                                    response: AWSLocationBatchUpdateDevicePositionResponse?,
                                                    error: Error?,
@@ -101,25 +113,81 @@ class EmitLocationsOperation: AsynchronousOperation {
         if let error = error as NSError? {
             AWSLocationTrackerLogger.debug("Error: \(error)")
             if let urlError = error as? URLError {
-                self.handleURLError(urlError, unexpiredLocations: unexpiredLocations)
+                self.handleURLError(urlError, locations: locations)
             } else if error.domain == AWSLocationErrorDomain,
                       let errorType = AWSLocationErrorType.init(rawValue: error.code) {
-                self.handleAWSLocationError(errorType, error: error)
+                self.handleAWSLocationError(errorType, error: error, locations: locations)
             } else {
                 self.listener?(.onDataPublicationError(.init(errorType: .serviceError(error),
                                                              message: getDefaultError(error),
                                                              recoverySuggestion: "Unknown Error occured")))
             }
         } else if let response = response {
+            self.requeueFailedUpdates(response.errors, request: request, locations: locations)
             self.listener?(.onDataPublished(.init(request: request,
                                                   response: response)))
         }
         onComplete()
     }
     
-    private func handleURLError(_ urlError: URLError, unexpiredLocations: [CLLocation]) {
+    /// Queues again the locations of the updates that failed for a reason that may not happen on the next attempt.
+    /// The service identifies a failed update by its sample time, to the second, so each error is matched to the index
+    /// of one update in the request: the first one sampled in that second that no earlier error matched. When several
+    /// locations were sampled in the same second, only as many as failed are queued again.
+    private func requeueFailedUpdates(_ errors: [AWSLocationBatchUpdateDevicePositionError]?,
+                                      request: AWSLocationBatchUpdateDevicePositionRequest,
+                                      locations: [CLLocation]) {
+        guard let errors = errors, !errors.isEmpty else {
+            return
+        }
+        let updateSampleTimes = (request.updates ?? []).map { $0.sampleTime.map(EmitLocationsOperation.wholeSeconds) }
+        var matchedIndexes = Set<Int>()
+        var retryableIndexes = [Int]()
+        for error in errors {
+            guard let sampleTime = error.sampleTime.map(EmitLocationsOperation.wholeSeconds),
+                  let index = updateSampleTimes.indices.first(where: { (index) -> Bool in
+                    !matchedIndexes.contains(index) && updateSampleTimes[index] == sampleTime
+                  }) else {
+                continue
+            }
+            matchedIndexes.insert(index)
+            if let code = error.error?.code, code == .throttlingError || code == .internalServerError {
+                retryableIndexes.append(index)
+            }
+        }
+        let failedLocations = retryableIndexes.sorted().filter { $0 < locations.count }.map { locations[$0] }
+        AWSLocationTrackerLogger.info("\(errors.count) position updates failed, \(failedLocations.count) will be retried.")
+        requeue(failedLocations)
+    }
+
+    private static func wholeSeconds(_ date: Date) -> Int64 {
+        return Int64(date.timeIntervalSince1970.rounded(.down))
+    }
+    
+    /// Puts locations back at the front of the queue, ahead of the locations retrieved since they were taken from it.
+    /// A cancelled operation puts nothing back. Cancellation is checked under the lock of the queue, so that once the
+    /// tracker has cancelled the operation and emptied the queue, it stays empty.
+    private func requeue(_ locations: [CLLocation]) {
+        guard !locations.isEmpty else {
+            return
+        }
+        var droppedCount = 0
+        locationsQueue.with { queuedLocations in
+            guard !isCancelled else {
+                return
+            }
+            queuedLocations.insert(contentsOf: locations, at: 0)
+            droppedCount = max(queuedLocations.count - maximumQueuedLocations, 0)
+            queuedLocations.removeFirst(droppedCount)
+        }
+        if droppedCount > 0 {
+            AWSLocationTrackerLogger.info("Locations queue is full, dropped the \(droppedCount) oldest locations.")
+        }
+    }
+    
+    private func handleURLError(_ urlError: URLError, locations: [CLLocation]) {
         if urlError.code.rawValue == NSURLErrorNotConnectedToInternet {
-            self.locationsQueue.append(contentsOf: unexpiredLocations)
+            self.requeue(locations)
         }
         
         self.listener?(.onDataPublicationError(
@@ -128,7 +196,11 @@ class EmitLocationsOperation: AsynchronousOperation {
                               recoverySuggestion: "See the underlying URLError in `.serviceError(let error)` from `errorType` for more details.")))
     }
     
-    private func handleAWSLocationError(_ errorType: AWSLocationErrorType, error: Error) {
+    private func handleAWSLocationError(_ errorType: AWSLocationErrorType, error: Error, locations: [CLLocation]) {
+        if case .throttling = errorType {
+            self.requeue(locations)
+        }
+        
         if case .resourceNotFound = errorType {
             self.listener?(.onDataPublicationError(
                             .init(errorType: .invalidTrackerName,
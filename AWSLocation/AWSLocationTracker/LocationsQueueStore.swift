@@ -0,0 +1,109 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import CoreLocation
+
+/// Saves the locations waiting to be published to a file, so that they are not lost when the app is terminated.
+/// Saving and removing happen in order on a serial queue, off the caller's thread.
+class LocationsQueueStore {
+    let fileURL: URL
+    private let queue: DispatchQueue
+    private let savePending: AtomicValue<Bool> = AtomicValue(initialValue: false)
+
+    init(trackerName: String, directoryURL: URL? = nil) {
+        let directoryURL = directoryURL ?? FileManager.default.urls(for: .applicationSupportDirectory,
+                                                                    in: .userDomainMask)[0]
+            .appendingPathComponent("com.amazonaws.AWSLocationTracker", isDirectory: true)
+        self.fileURL = directoryURL.appendingPathComponent("\(trackerName).locations")
+        self.queue = DispatchQueue(label: "com.amazonaws.AWSLocationTrackerLocationsQueueStore.\(trackerName)")
+    }
+
+    /// Returns the locations saved, or an empty array if there are none or they cannot be read.
+    func load() -> [CLLocation] {
+        return queue.sync {
+            guard let data = try? Data(contentsOf: fileURL) else {
+                return []
+            }
+            let locations: [CLLocation]?
+            if #available(iOS 11.0, *) {
+                locations = (try? NSKeyedUnarchiver.unarchivedObject(ofClasses: [NSArray.self, CLLocation.self],
+                                                                     from: data)) as? [CLLocation]
+            } else {
+                locations = NSKeyedUnarchiver.unarchiveObject(with: data) as? [CLLocation]
+            }
+            if locations == nil {
+                AWSLocationTrackerLogger.error("Could not read the saved locations at \(fileURL.path)")
+            }
+            return locations ?? []
+        }
+    }
+
+    /// Replaces the locations saved with the ones `locations` returns when the save runs on the serial queue, or keeps
+    /// them when it returns `nil`. A save requested while another one is waiting to run is coalesced into it, so a
+    /// burst of changes is written once.
+    func save(_ locations: @escaping () -> [CLLocation]?) {
+        guard !savePending.getAndSet(true) else {
+            return
+        }
+        queue.async {
+            self.savePending.set(false)
+            guard let locations = locations() else {
+                return
+            }
+            guard !locations.isEmpty else {
+                self.removeFile()
+                return
+            }
+            do {
+                let data: Data
+                if #available(iOS 11.0, *) {
+                    data = try NSKeyedArchiver.archivedData(withRootObject: locations, requiringSecureCoding: true)
+                } else {
+                    data = NSKeyedArchiver.archivedData(withRootObject: locations)
+                }
+                try FileManager.default.createDirectory(at: self.fileURL.deletingLastPathComponent(),
+                                                        withIntermediateDirectories: true)
+                try data.write(to: self.fileURL, options: [.atomic, .completeFileProtectionUntilFirstUserAuthentication])
+            } catch {
+                AWSLocationTrackerLogger.error("Could not save \(locations.count) locations: \(error)")
+            }
+        }
+    }
+
+    /// Removes the locations saved. A save requested afterwards is not coalesced into one waiting to run before the
+    /// removal.
+    func remove() {
+        savePending.set(false)
+        queue.async {
+            self.removeFile()
+        }
+    }
+
+    /// Blocks until the saves and removals already requested are done.
+    func waitUntilDone() {
+        queue.sync {}
+    }
+
+    private func removeFile() {
+        guard FileManager.default.fileExists(atPath: fileURL.path) else {
+            return
+        }
+        do {
+            try FileManager.default.removeItem(at: fileURL)
+        } catch {
+            AWSLocationTrackerLogger.error("Could not remove the saved locations: \(error)")
+        }
+    }
+}
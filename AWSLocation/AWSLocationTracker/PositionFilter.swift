@@ -0,0 +1,80 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import CoreLocation
+
+/// Decides which of the retrieved locations are queued to be sent to Amazon Location Service, so that a device that has
+/// not moved does not send a near-duplicate position on every retrieval.
+///
+/// A location is kept when it is accurate enough, and it is either far enough from the last location kept, or long
+/// enough after it.
+public struct PositionFilter {
+    static let defaultDistanceThreshold = CLLocationDistance(30) // 30 meters
+    static let defaultTimeThreshold = TimeInterval(300) // 5 minutes
+    static let defaultMaximumHorizontalAccuracy = CLLocationAccuracy(100) // 100 meters
+
+    /// The distance in meters a location must be from the last location kept. A location must also be farther than its
+    /// own horizontal accuracy, so that GPS noise is not mistaken for movement.
+    public let distanceThreshold: CLLocationDistance
+
+    /// The time in seconds after the last location kept from which a location is kept even if it has not moved, so that
+    /// a stationary device still reports its position.
+    public let timeThreshold: TimeInterval
+
+    /// The largest horizontal accuracy in meters of a location that is kept. Locations with a larger or an invalid
+    /// horizontal accuracy are dropped.
+    public let maximumHorizontalAccuracy: CLLocationAccuracy
+
+    public init(distanceThreshold: CLLocationDistance? = nil,
+                timeThreshold: TimeInterval? = nil,
+                maximumHorizontalAccuracy: CLLocationAccuracy? = nil) {
+        self.distanceThreshold = distanceThreshold ?? PositionFilter.defaultDistanceThreshold
+        self.timeThreshold = timeThreshold ?? PositionFilter.defaultTimeThreshold
+        self.maximumHorizontalAccuracy = maximumHorizontalAccuracy ?? PositionFilter.defaultMaximumHorizontalAccuracy
+    }
+
+    /// Returns whether `location` should be kept, given the last location kept.
+    func shouldKeep(_ location: CLLocation, lastKeptLocation: CLLocation?) -> Bool {
+        guard location.horizontalAccuracy >= 0,
+              location.horizontalAccuracy <= maximumHorizontalAccuracy else {
+            return false
+        }
+        guard let lastKeptLocation = lastKeptLocation else {
+            return true
+        }
+
+        let elapsedTime = location.timestamp.timeIntervalSince(lastKeptLocation.timestamp)
+        guard elapsedTime > 0 else {
+            // Out of order or a repeat of the last location kept
+            return false
+        }
+        if elapsedTime >= timeThreshold {
+            return true
+        }
+        return location.distance(from: lastKeptLocation) >= max(distanceThreshold, location.horizontalAccuracy)
+    }
+
+    /// Returns the locations to keep, in order, and the last location kept after them.
+    func filter(_ locations: [CLLocation],
+                lastKeptLocation: CLLocation?) -> (locations: [CLLocation], lastKeptLocation: CLLocation?) {
+        var keptLocations = [CLLocation]()
+        var lastKeptLocation = lastKeptLocation
+        for location in locations where shouldKeep(location, lastKeptLocation: lastKeptLocation) {
+            keptLocations.append(location)
+            lastKeptLocation = location
+        }
+        return (keptLocations, lastKeptLocation)
+    }
+}
@@ -17,6 +17,7 @@
 public struct TrackerOptions {
     static let defaultRetrieveLocationFrequency = TimeInterval(30) // 30 seconds
     static let defaultEmitLocationFrequency = TimeInterval(300) // 5 minutes
+    static let defaultMaximumQueuedLocations = 1_000
     
     /// The custom ID chosen to identify this device on the chosen tracker resource.
     public let customDeviceId: String?
@@ -27,11 +28,28 @@ public struct TrackerOptions {
     /// The frequency in seconds to publish a batch of locations to Amazon Location Service.
     public let emitLocationFrequency: TimeInterval
     
+    /// Drops retrieved locations that are too close to the last location queued, or not accurate enough. All retrieved
+    /// locations are queued when `nil`.
+    public let positionFilter: PositionFilter?
+    
+    /// The maximum number of locations waiting to be published. The oldest locations are dropped when there are more.
+    public let maximumQueuedLocations: Int
+    
+    /// Whether locations waiting to be published are saved to disk, so that they are published after the app is
+    /// relaunched. They are deleted when `stopTracking` is called.
+    public let persistsQueuedLocations: Bool
+    
     public init(customDeviceId: String? = nil,
                 retrieveLocationFrequency: TimeInterval? = nil,
-                emitLocationFrequency: TimeInterval? = nil) {
+                emitLocationFrequency: TimeInterval? = nil,
+                positionFilter: PositionFilter? = nil,
+                maximumQueuedLocations: Int? = nil,
+                persistsQueuedLocations: Bool = false) {
         self.customDeviceId = customDeviceId
         self.retrieveLocationFrequency = retrieveLocationFrequency ?? TrackerOptions.defaultRetrieveLocationFrequency
         self.emitLocationFrequency = emitLocationFrequency ?? TrackerOptions.defaultEmitLocationFrequency
+        self.positionFilter = positionFilter
+        self.maximumQueuedLocations = max(maximumQueuedLocations ?? TrackerOptions.defaultMaximumQueuedLocations, 1)
+        self.persistsQueuedLocations = persistsQueuedLocations
     }
 }
@@ -32,6 +32,30 @@ extension AtomicValue where Value: RangeReplaceableCollection {
         value.append(contentsOf: sequence)
     }
 
+    /// Appends `sequence`, then removes the first elements so that at most `maximumCount` remain. Returns the number of
+    /// elements removed.
+    @discardableResult
+    func append<S>(contentsOf sequence: S, maximumCount: Int) -> Int where S: Sequence, S.Element == Value.Element {
+        lock.lock()
+        defer {
+            lock.unlock()
+        }
+        value.append(contentsOf: sequence)
+        return trim(toMaximumCount: maximumCount)
+    }
+
+    /// Inserts `collection` before the first element, then removes the first elements so that at most `maximumCount`
+    /// remain. Returns the number of elements removed.
+    @discardableResult
+    func prepend<C>(contentsOf collection: C, maximumCount: Int) -> Int where C: Collection, C.Element == Value.Element {
+        lock.lock()
+        defer {
+            lock.unlock()
+        }
+        value.insert(contentsOf: collection, at: value.startIndex)
+        return trim(toMaximumCount: maximumCount)
+    }
+
     func removeFirst() -> Value.Element {
         lock.lock()
         defer {
@@ -47,4 +71,13 @@ extension AtomicValue where Value: RangeReplaceableCollection {
         }
         return value[key]
     }
+
+    private func trim(toMaximumCount maximumCount: Int) -> Int {
+        let overflow = value.count - maximumCount
+        guard overflow > 0 else {
+            return 0
+        }
+        value.removeFirst(overflow)
+        return overflow
+    }
 }
@@ -129,6 +129,63 @@ class AWSLocationTrackerTests: XCTestCase {
         XCTAssertFalse(locationTracker.isTracking())
     }
     
+    // Locations that fail to be published after tracking stopped are neither queued nor saved again
+    func testStopTrackingWhileEmittingLocations() {
+        let store = LocationsQueueStore(trackerName: UUID().uuidString,
+                                        directoryURL: FileManager.default.temporaryDirectory)
+        let locationService = MockAWSLocation()
+        let emitting = DispatchSemaphore(value: 0)
+        let stopped = DispatchSemaphore(value: 0)
+        locationService.batchUpdateDevicePositionHandler = { _ in
+            emitting.signal()
+            stopped.wait()
+            return (nil, NSError(domain: AWSLocationErrorDomain, code: AWSLocationErrorType.throttling.rawValue))
+        }
+        let locationTracker = AWSLocationTracker(trackerName: trackerName,
+                                                 locationService: locationService,
+                                                 locationsQueueStore: store)
+        _ = locationTracker.startTracking(delegate: MockAWSLocationTrackerDelegate(),
+                                          options: TrackerOptions(emitLocationFrequency: 0.1,
+                                                                  persistsQueuedLocations: true))
+        locationTracker.interceptLocationsRetrieved([CLLocation(latitude: 47.608013, longitude: -122.335167)])
+        XCTAssertEqual(emitting.wait(timeout: .now() + 1), .success)
+
+        locationTracker.stopTracking()
+        stopped.signal()
+        locationTracker.operationQueue.waitUntilAllOperationsAreFinished()
+        store.waitUntilDone()
+
+        XCTAssertEqual(locationService.batchUpdateDevicePositionRequests.get().count, 1)
+        XCTAssertTrue(locationTracker.locationsQueue.get().isEmpty)
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.fileURL.path))
+    }
+    
+    // A listener can pass on a final location when tracking stops, while the tracker is stopping
+    func testStopTrackingListenerCanInterceptLocations() {
+        let store = LocationsQueueStore(trackerName: UUID().uuidString,
+                                        directoryURL: FileManager.default.temporaryDirectory)
+        let locationTracker = AWSLocationTracker(trackerName: trackerName,
+                                                 locationService: MockAWSLocation(),
+                                                 locationsQueueStore: store)
+        _ = locationTracker.startTracking(delegate: MockAWSLocationTrackerDelegate(),
+                                          options: TrackerOptions(persistsQueuedLocations: true)) { [weak locationTracker] event in
+            if case .onStop = event {
+                locationTracker?.interceptLocationsRetrieved([CLLocation(latitude: 47.608013, longitude: -122.335167)])
+            }
+        }
+
+        let stoppedExpectation = expectation(description: "Tracking stopped")
+        DispatchQueue.global().async {
+            locationTracker.stopTracking()
+            stoppedExpectation.fulfill()
+        }
+        wait(for: [stoppedExpectation], timeout: 1)
+        store.waitUntilDone()
+
+        XCTAssertFalse(locationTracker.isTracking())
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.fileURL.path))
+    }
+    
     // MARK: - InterceptLocationsRetrieved
     
     func testInterceptLocationsRetrieved() {
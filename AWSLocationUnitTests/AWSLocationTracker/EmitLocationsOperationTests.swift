@@ -382,8 +382,147 @@ class EmitLocationsOperationTests: XCTestCase {
         XCTAssertTrue(locationsQueue.get().isEmpty)
     }
 
+    // MARK: - Retry tests
+
+    // Updates that failed with a throttling or internal server error are queued again, and other failed updates are not
+    func testEmitLocationsPartialFailureRequeuesRetryableUpdates() {
+        let locationsQueue = AtomicValue<[CLLocation]>(initialValue: [])
+        let throttledLocation = createCLLocation(byAdding: .minute, value: -5)
+        let invalidLocation = createCLLocation(byAdding: .minute, value: -4)
+        let publishedLocation = createCLLocation(byAdding: .minute, value: -3)
+        locationsQueue.append(contentsOf: [throttledLocation, invalidLocation, publishedLocation])
+        let locationService = MockAWSLocation()
+        let response = AWSLocationBatchUpdateDevicePositionResponse()
+        response?.errors = [createBatchUpdateDevicePositionError(location: throttledLocation, code: .throttlingError),
+                            createBatchUpdateDevicePositionError(location: invalidLocation, code: .validationError)]
+        locationService.batchUpdateDevicePositionCompletionEvent = (response, nil)
+        let onDataPublishedExpectation = expectation(description: "Data was published")
+        let operation = EmitLocationsOperation(trackerName: trackerName,
+                                               deviceId: deviceId,
+                                               locationsQueue: locationsQueue,
+                                               locationService: locationService,
+                                               isCalledFromBackgroundTask: false) { (event) in
+            guard case .onDataPublished = event else {
+                XCTFail("Unexpected event \(event)")
+                return
+            }
+            onDataPublishedExpectation.fulfill()
+        }
+
+        operation.start()
+
+        wait(for: [onDataPublishedExpectation], timeout: 1)
+        XCTAssertEqual(locationsQueue.get(), [throttledLocation])
+    }
+
+    // Of several locations sampled in the same second, only as many as failed are queued again
+    func testEmitLocationsPartialFailureMatchesUpdatesSampledInTheSameSecond() {
+        let locationsQueue = AtomicValue<[CLLocation]>(initialValue: [])
+        let sampleTime = Date(timeIntervalSince1970: Date().addingTimeInterval(-60).timeIntervalSince1970.rounded(.down))
+        let locations = (0..<3).map { (index) -> CLLocation in
+            CLLocation(coordinate: CLLocationCoordinate2D(latitude: 10 + Double(index), longitude: 20),
+                       altitude: CLLocationDistance(),
+                       horizontalAccuracy: CLLocationAccuracy(),
+                       verticalAccuracy: CLLocationAccuracy(),
+                       timestamp: sampleTime.addingTimeInterval(0.25 * Double(index)))
+        }
+        locationsQueue.append(contentsOf: locations)
+        let locationService = MockAWSLocation()
+        let response = AWSLocationBatchUpdateDevicePositionResponse()
+        response?.errors = [createBatchUpdateDevicePositionError(location: locations[0], code: .validationError),
+                            createBatchUpdateDevicePositionError(location: locations[1], code: .throttlingError)]
+        locationService.batchUpdateDevicePositionCompletionEvent = (response, nil)
+        let onDataPublishedExpectation = expectation(description: "Data was published")
+        let operation = EmitLocationsOperation(trackerName: trackerName,
+                                               deviceId: deviceId,
+                                               locationsQueue: locationsQueue,
+                                               locationService: locationService,
+                                               isCalledFromBackgroundTask: false) { (event) in
+            guard case .onDataPublished = event else {
+                XCTFail("Unexpected event \(event)")
+                return
+            }
+            onDataPublishedExpectation.fulfill()
+        }
+
+        operation.start()
+
+        wait(for: [onDataPublishedExpectation], timeout: 1)
+        XCTAssertEqual(locationsQueue.get(), [locations[1]])
+    }
+
+    // A throttled request queues its locations again, ahead of the locations retrieved since
+    func testEmitLocationsThrottlingRequeuesLocations() {
+        let locationsQueue = AtomicValue<[CLLocation]>(initialValue: [])
+        let location = createCLLocation(byAdding: .minute, value: -3)
+        locationsQueue.append(location)
+        let newLocation = createCLLocation(byAdding: .minute, value: -1)
+        let locationService = MockAWSLocation()
+        locationService.batchUpdateDevicePositionHandler = { _ in
+            locationsQueue.append(newLocation)
+            return (nil, NSError(domain: AWSLocationErrorDomain, code: AWSLocationErrorType.throttling.rawValue))
+        }
+        let onDataPublicationErrorExpectation = expectation(description: "Data publication error")
+        let operation = EmitLocationsOperation(trackerName: trackerName,
+                                               deviceId: deviceId,
+                                               locationsQueue: locationsQueue,
+                                               locationService: locationService,
+                                               isCalledFromBackgroundTask: false) { (event) in
+            guard case .onDataPublicationError = event else {
+                XCTFail("Unexpected event \(event)")
+                return
+            }
+            onDataPublicationErrorExpectation.fulfill()
+        }
+
+        operation.start()
+
+        wait(for: [onDataPublicationErrorExpectation], timeout: 1)
+        XCTAssertEqual(locationsQueue.get(), [location, newLocation])
+    }
+
+    // Each failed batch queues only its own locations again, and the queue does not grow past its maximum
+    func testEmitLocationsNotConnectedToInternetRequeuesEachBatchOnce() {
+        let locationsQueue = AtomicValue<[CLLocation]>(initialValue: [])
+        let locations = (1...25).map { createCLLocation(byAdding: .second, value: -$0) }
+        locationsQueue.append(contentsOf: locations)
+        let locationService = MockAWSLocation()
+        locationService.batchUpdateDevicePositionCompletionEvent = (nil, URLError(.notConnectedToInternet))
+        let operationCompleted = expectation(description: "Operation completed")
+        let operation = EmitLocationsOperation(trackerName: trackerName,
+                                               deviceId: deviceId,
+                                               locationsQueue: locationsQueue,
+                                               maximumQueuedLocations: 22,
+                                               locationService: locationService,
+                                               isCalledFromBackgroundTask: false,
+                                               listener: nil)
+        operation.completionBlock = {
+            operationCompleted.fulfill()
+        }
+
+        operation.start()
+
+        wait(for: [operationCompleted], timeout: 1)
+        XCTAssertEqual(locationService.batchUpdateDevicePositionRequests.get().count, 3)
+        XCTAssertEqual(Set(locationsQueue.get()).count, 22)
+    }
+
     // MARK: - Helpers
-    
+
+    func createBatchUpdateDevicePositionError(location: CLLocation,
+                                              code: AWSLocationBatchItemErrorCode) -> AWSLocationBatchUpdateDevicePositionError {
+        guard let error = AWSLocationBatchUpdateDevicePositionError(),
+              let itemError = AWSLocationBatchItemError() else {
+            fatalError("Could not instantiate `AWSLocationBatchUpdateDevicePositionError()`")
+        }
+        itemError.code = code
+        error.deviceId = deviceId
+        // The service returns sample times to the second
+        error.sampleTime = Date(timeIntervalSince1970: location.timestamp.timeIntervalSince1970.rounded(.down))
+        error.error = itemError
+        return error
+    }
+
     func createCLLocation(latitude: Double? = nil,
                           longitide: Double? = nil,
                           byAdding: Calendar.Component,
@@ -18,11 +18,16 @@ import XCTest
 
 class MockAWSLocation: AWSLocationBehavior {
     var batchUpdateDevicePositionCompletionEvent: BatchUpdateDevicePositionCompletionEvent?
+    var batchUpdateDevicePositionHandler: ((AWSLocationBatchUpdateDevicePositionRequest) -> BatchUpdateDevicePositionCompletionEvent)?
+    let batchUpdateDevicePositionRequests = AtomicValue<[AWSLocationBatchUpdateDevicePositionRequest]>(initialValue: [])
     var expectation: XCTestExpectation?
     
     func batchUpdateDevicePosition(_ request: AWSLocationBatchUpdateDevicePositionRequest,
                                    completionHandler: BatchUpdateDevicePositionCompletionHandler?) {
-        if let event = batchUpdateDevicePositionCompletionEvent {
+        batchUpdateDevicePositionRequests.append(request)
+        if let handler = batchUpdateDevicePositionHandler {
+            completionHandler?(handler(request))
+        } else if let event = batchUpdateDevicePositionCompletionEvent {
             completionHandler?(event)
         }
         expectation?.fulfill()
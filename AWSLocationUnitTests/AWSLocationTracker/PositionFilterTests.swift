@@ -0,0 +1,187 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import XCTest
+@testable import AWSLocation
+
+class PositionFilterTests: XCTestCase {
+
+    let origin = CLLocationCoordinate2D(latitude: 47.608013, longitude: -122.335167)
+    let startDate = Date().addingTimeInterval(-3_000)
+
+    func testFirstAccurateLocationIsKept() {
+        let filter = PositionFilter()
+
+        XCTAssertTrue(filter.shouldKeep(createLocation(), lastKeptLocation: nil))
+        XCTAssertFalse(filter.shouldKeep(createLocation(horizontalAccuracy: 150), lastKeptLocation: nil))
+        XCTAssertFalse(filter.shouldKeep(createLocation(horizontalAccuracy: -1), lastKeptLocation: nil))
+    }
+
+    func testDistanceThreshold() {
+        let filter = PositionFilter(distanceThreshold: 50, timeThreshold: 600)
+        let lastKeptLocation = createLocation()
+
+        XCTAssertFalse(filter.shouldKeep(createLocation(north: 20, seconds: 30), lastKeptLocation: lastKeptLocation))
+        XCTAssertTrue(filter.shouldKeep(createLocation(north: 60, seconds: 30), lastKeptLocation: lastKeptLocation))
+        // Movement within the accuracy of the location is noise
+        XCTAssertFalse(filter.shouldKeep(createLocation(north: 60, seconds: 30, horizontalAccuracy: 80),
+                                         lastKeptLocation: lastKeptLocation))
+    }
+
+    func testTimeThreshold() {
+        let filter = PositionFilter(distanceThreshold: 50, timeThreshold: 120)
+        let lastKeptLocation = createLocation()
+
+        XCTAssertFalse(filter.shouldKeep(createLocation(seconds: 119), lastKeptLocation: lastKeptLocation))
+        XCTAssertTrue(filter.shouldKeep(createLocation(seconds: 120), lastKeptLocation: lastKeptLocation))
+        // Locations older than the last location kept are dropped, however far they are
+        XCTAssertFalse(filter.shouldKeep(createLocation(north: 1_000, seconds: -10), lastKeptLocation: lastKeptLocation))
+    }
+
+    func testFilterKeepsLocationsInOrder() {
+        let filter = PositionFilter(distanceThreshold: 50, timeThreshold: 120)
+        let locations = [createLocation(),
+                         createLocation(north: 10, seconds: 30),
+                         createLocation(north: 70, seconds: 60),
+                         createLocation(north: 80, seconds: 90),
+                         createLocation(north: 80, seconds: 180)]
+
+        let filtered = filter.filter(locations, lastKeptLocation: nil)
+
+        XCTAssertEqual(filtered.locations, [locations[0], locations[2], locations[4]])
+        XCTAssertEqual(filtered.lastKeptLocation, locations[4])
+    }
+
+    func testInterceptLocationsRetrievedAppliesPositionFilter() {
+        let locationTracker = AWSLocationTracker(trackerName: "trackerName",
+                                                 locationService: MockAWSLocation())
+        _ = locationTracker.startTracking(delegate: MockAWSLocationTrackerDelegate(),
+                                          options: TrackerOptions(positionFilter: PositionFilter(distanceThreshold: 50),
+                                                                  maximumQueuedLocations: 2))
+
+        locationTracker.interceptLocationsRetrieved([createLocation(), createLocation(north: 10, seconds: 30)])
+        locationTracker.interceptLocationsRetrieved([createLocation(north: 100, seconds: 60)])
+        locationTracker.interceptLocationsRetrieved([createLocation(north: 200, seconds: 90)])
+
+        // The second location is filtered out, and the first dropped from the full queue
+        let queuedLocations = locationTracker.locationsQueue.get()
+        XCTAssertEqual(queuedLocations.count, 2)
+        XCTAssertEqual(queuedLocations.first!.timestamp, startDate.addingTimeInterval(60))
+        locationTracker.stopTracking()
+    }
+
+    func testQueuedLocationsAreRestored() {
+        let trackerName = UUID().uuidString
+        let store = LocationsQueueStore(trackerName: trackerName,
+                                        directoryURL: FileManager.default.temporaryDirectory)
+        let options = TrackerOptions(persistsQueuedLocations: true)
+        let locationTracker = AWSLocationTracker(trackerName: trackerName,
+                                                 locationService: MockAWSLocation(),
+                                                 locationsQueueStore: store)
+        _ = locationTracker.startTracking(delegate: MockAWSLocationTrackerDelegate(), options: options)
+        locationTracker.interceptLocationsRetrieved([createLocation(), createLocation(north: 100, seconds: 60)])
+        store.waitUntilDone()
+
+        let relaunchedTracker = AWSLocationTracker(trackerName: trackerName,
+                                                   locationService: MockAWSLocation(),
+                                                   locationsQueueStore: store)
+        _ = relaunchedTracker.startTracking(delegate: MockAWSLocationTrackerDelegate(), options: options)
+
+        let restoredLocations = relaunchedTracker.locationsQueue.get()
+        XCTAssertEqual(restoredLocations.map { $0.timestamp }, [startDate, startDate.addingTimeInterval(60)])
+        XCTAssertEqual(restoredLocations.last!.coordinate.latitude,
+                       createLocation(north: 100).coordinate.latitude,
+                       accuracy: 0.000_001)
+
+        relaunchedTracker.stopTracking()
+        store.waitUntilDone()
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.fileURL.path))
+    }
+
+    // MARK: - Benchmark
+
+    /// Emits an hour of 1Hz positions through `EmitLocationsOperation`, with and without a position filter, and logs the
+    /// position updates and requests sent and the CPU time spent.
+    func testRecordedTraceBenchmark() {
+        let trace = recordedTrace()
+        for positionFilter in [nil, PositionFilter(), PositionFilter(distanceThreshold: 100, timeThreshold: 600)] {
+            let startCPUTime = clock()
+            var queuedLocations = trace
+            if let positionFilter = positionFilter {
+                queuedLocations = positionFilter.filter(trace, lastKeptLocation: nil).locations
+            }
+            let locationService = MockAWSLocation()
+            locationService.batchUpdateDevicePositionCompletionEvent = (AWSLocationBatchUpdateDevicePositionResponse(), nil)
+            let operation = EmitLocationsOperation(trackerName: "trackerName",
+                                                   deviceId: "deviceId",
+                                                   locationsQueue: AtomicValue(initialValue: queuedLocations),
+                                                   locationService: locationService,
+                                                   listener: nil)
+            operation.start()
+            operation.waitUntilFinished()
+            let cpuTime = Double(clock() - startCPUTime) / Double(CLOCKS_PER_SEC)
+
+            let requests = locationService.batchUpdateDevicePositionRequests.get()
+            let updateCount = requests.reduce(0) { $0 + ($1.updates?.count ?? 0) }
+            XCTAssertEqual(updateCount, queuedLocations.count)
+            XCTAssertEqual(requests.count, (queuedLocations.count + 9) / 10)
+            let filterDescription = positionFilter.map {
+                "\(Int($0.distanceThreshold))m/\(Int($0.timeThreshold))s/\(Int($0.maximumHorizontalAccuracy))m"
+            } ?? "none"
+            NSLog("Position filter %@: %ld of %ld positions sent in %ld requests per hour, %.1fms CPU",
+                  filterDescription, updateCount, trace.count, requests.count, cpuTime * 1_000)
+        }
+    }
+
+    // MARK: - Helpers
+
+    func createLocation(north: CLLocationDistance = 0,
+                        east: CLLocationDistance = 0,
+                        seconds: TimeInterval = 0,
+                        horizontalAccuracy: CLLocationAccuracy = 10) -> CLLocation {
+        let latitude = origin.latitude + north / 111_320
+        let longitude = origin.longitude + east / (111_320 * cos(origin.latitude * .pi / 180))
+        return CLLocation(coordinate: CLLocationCoordinate2D(latitude: latitude, longitude: longitude),
+                          altitude: CLLocationDistance(),
+                          horizontalAccuracy: horizontalAccuracy,
+                          verticalAccuracy: CLLocationAccuracy(),
+                          timestamp: startDate.addingTimeInterval(seconds))
+    }
+
+    /// An hour of positions sampled every second, generated the same way on every run: 20 minutes parked with GPS
+    /// jitter, 20 minutes walking and 20 minutes driving, with an occasional inaccurate fix.
+    func recordedTrace() -> [CLLocation] {
+        var seed: UInt32 = 2_021
+        func jitter(_ meters: Double) -> Double {
+            seed = seed &* 1_664_525 &+ 1_013_904_223
+            return (Double(seed) / Double(UInt32.max) * 2 - 1) * meters
+        }
+
+        var north = 0.0
+        var east = 0.0
+        return (0..<3_600).map { (second) -> CLLocation in
+            if second >= 2_400 {
+                north += 15 // 54 km/h
+            } else if second >= 1_200 {
+                east += 1.4 // 5 km/h
+            }
+            let horizontalAccuracy = second % 97 == 0 ? 250 : 5 + abs(jitter(5))
+            return createLocation(north: north + jitter(horizontalAccuracy / 2),
+                                  east: east + jitter(horizontalAccuracy / 2),
+                                  seconds: TimeInterval(second),
+                                  horizontalAccuracy: horizontalAccuracy)
+        }
+    }
+}
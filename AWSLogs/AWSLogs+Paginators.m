@@ -0,0 +1,50 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSLogs+Paginators.h"
+
+@implementation AWSLogs (Paginators)
+
+- (AWSPaginator *)describeLogGroupsPaginator:(AWSLogsDescribeLogGroupsRequest *)request {
+    return [AWSPaginator paginatorWithRequest:request
+                                inputTokenKey:@"nextToken"
+                               outputTokenKey:@"nextToken"
+                                    resultKey:@"logGroups"
+                                    operation:^AWSTask *(AWSLogsDescribeLogGroupsRequest *pageRequest) {
+        return [self describeLogGroups:pageRequest];
+    }];
+}
+
+- (AWSPaginator *)describeLogStreamsPaginator:(AWSLogsDescribeLogStreamsRequest *)request {
+    return [AWSPaginator paginatorWithRequest:request
+                                inputTokenKey:@"nextToken"
+                               outputTokenKey:@"nextToken"
+                                    resultKey:@"logStreams"
+                                    operation:^AWSTask *(AWSLogsDescribeLogStreamsRequest *pageRequest) {
+        return [self describeLogStreams:pageRequest];
+    }];
+}
+
+- (AWSPaginator *)filterLogEventsPaginator:(AWSLogsFilterLogEventsRequest *)request {
+    return [AWSPaginator paginatorWithRequest:request
+                                inputTokenKey:@"nextToken"
+                               outputTokenKey:@"nextToken"
+                                    resultKey:@"events"
+                                    operation:^AWSTask *(AWSLogsFilterLogEventsRequest *pageRequest) {
+        return [self filterLogEvents:pageRequest];
+    }];
+}
+
+@end
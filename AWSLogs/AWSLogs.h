@@ -40,3 +40,5 @@ FOUNDATION_EXPORT const unsigned char AWSLogsVersionString[] DEPRECATED_MSG_ATTR
 
 #import <AWSCore/AWSCore.h>
 #import "AWSLogsService.h"
+#import "AWSLogs+Paginators.h"
+#import "AWSLogsLogger.h"
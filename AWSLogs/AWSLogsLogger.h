@@ -0,0 +1,93 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import <AWSCore/AWSCore.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class AWSLogs;
+
+/**
+ The default value of `diskByteLimit`, 5MB.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSLogsLoggerDiskByteLimitDefault;
+
+/**
+ An `AWSDDLogger` that ships log messages to a CloudWatch Logs log stream with `PutLogEvents`.
+
+ Messages are formatted by the logger's `logFormatter` (the raw message when there is none) and kept in memory until they
+ are saved to a SQLite database, according to the `saveThreshold` and `saveInterval` inherited from
+ `AWSDDAbstractDatabaseLogger`. The in-memory buffer is also saved whenever it reaches 512KB. Every save schedules an upload.
+
+ Uploads send the saved events oldest first, in batches that follow the `PutLogEvents` rules: at most 10,000 events and
+ 1,048,576 bytes per batch, counting 26 bytes of overhead per event, and no more than 24 hours between the first and the last
+ event. Messages longer than a single event allows are truncated. The logger tracks the sequence token and recovers from
+ `AWSLogsErrorInvalidSequenceToken` and `AWSLogsErrorDataAlreadyAccepted`. It creates the log group and log stream when they
+ do not exist.
+
+ Events that cannot be uploaded, for example while the device is offline, stay in the database and are retried with the
+ next save. The database is kept in the Application Support directory, which the system does not purge. It keeps at most
+ `diskByteLimit` bytes of events and drops the oldest ones beyond that. Events older than `maxAge` are deleted as well.
+
+     AWSLogsLogger *logger = [[AWSLogsLogger alloc] initWithLogs:[AWSLogs defaultLogs]
+                                                    logGroupName:@"MyApp"
+                                                   logStreamName:[[UIDevice currentDevice] identifierForVendor].UUIDString];
+     [AWSDDLog addLogger:logger withLevel:AWSDDLogLevelInfo];
+ */
+@interface AWSLogsLogger : AWSDDAbstractDatabaseLogger
+
+/**
+ The log group the events are sent to.
+ */
+@property (nonatomic, strong, readonly) NSString *logGroupName;
+
+/**
+ The log stream the events are sent to.
+ */
+@property (nonatomic, strong, readonly) NSString *logStreamName;
+
+/**
+ The maximum number of bytes of events kept on disk. The oldest events are dropped once it is exceeded.
+ The default value is `AWSLogsLoggerDiskByteLimitDefault`.
+ */
+@property (atomic, assign) NSUInteger diskByteLimit;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a logger that sends events to the given log stream with the given client.
+
+ @param logs          The CloudWatch Logs client used to call `PutLogEvents`.
+ @param logGroupName  The name of the log group.
+ @param logStreamName The name of the log stream.
+
+ @return A logger. Add it to `AWSDDLog` to start shipping messages.
+ */
+- (instancetype)initWithLogs:(AWSLogs *)logs
+                logGroupName:(NSString *)logGroupName
+               logStreamName:(NSString *)logStreamName NS_DESIGNATED_INITIALIZER;
+
+/**
+ Uploads every event saved to disk so far. Messages still in memory are not included; call
+ `savePendingLogEntries` or `[AWSDDLog flushLog]` first to include them.
+
+ @return An instance of `AWSTask`. `task.error` is set when an upload failed. The events that were not uploaded stay on disk.
+ */
+- (AWSTask *)submitAllEvents;
+
+@end
+
+NS_ASSUME_NONNULL_END
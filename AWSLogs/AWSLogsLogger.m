@@ -0,0 +1,400 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <CommonCrypto/CommonDigest.h>
+#import "AWSLogsLogger.h"
+#import "AWSLogsService.h"
+
+NSUInteger const AWSLogsLoggerDiskByteLimitDefault = 5 * 1024 * 1024; // 5MB
+NSString *const AWSLogsLoggerDatabasePathPrefix = @"com/amazonaws/AWSLogsLogger";
+
+// PutLogEvents limits. Each event counts its UTF-8 message length plus 26 bytes.
+static NSUInteger const AWSLogsLoggerBatchByteLimit = 1048576;
+static NSUInteger const AWSLogsLoggerBatchEventLimit = 10000;
+static NSUInteger const AWSLogsLoggerEventOverhead = 26;
+static NSUInteger const AWSLogsLoggerEventByteLimit = 256 * 1024 - 26;
+static int64_t const AWSLogsLoggerBatchSpanLimit = 24 * 60 * 60 * 1000; // 24 hours in milliseconds
+
+// Bounds the messages held in memory between saves.
+static NSUInteger const AWSLogsLoggerUnsavedByteLimit = 512 * 1024;
+
+@interface AWSLogsLogger() {
+    // Only accessed on the logger queue.
+    NSMutableArray<NSArray *> *_unsavedEvents;
+    NSUInteger _unsavedBytes;
+
+    // Only accessed on the upload queue.
+    NSString *_sequenceToken;
+
+    BOOL _uploadScheduled;
+}
+
+@property (nonatomic, strong) AWSLogs *logs;
+@property (nonatomic, strong) AWSFMDatabaseQueue *databaseQueue;
+@property (nonatomic, strong) dispatch_queue_t uploadQueue;
+
+@end
+
+@implementation AWSLogsLogger
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithLogs:logGroupName:logStreamName:` instead."
+                                 userInfo:nil];
+}
+
+- (instancetype)initWithLogs:(AWSLogs *)logs
+                logGroupName:(NSString *)logGroupName
+               logStreamName:(NSString *)logStreamName {
+    if (self = [super init]) {
+        _logs = logs;
+        _logGroupName = [logGroupName copy];
+        _logStreamName = [logStreamName copy];
+        _diskByteLimit = AWSLogsLoggerDiskByteLimitDefault;
+        _unsavedEvents = [NSMutableArray new];
+        _uploadQueue = dispatch_queue_create("com.amazonaws.AWSLogsLogger", DISPATCH_QUEUE_SERIAL);
+
+        // Application Support is not purged by the system, so saved events survive until they are uploaded.
+        NSString *applicationSupportDirectory = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+        NSString *databaseDirectoryPath = [applicationSupportDirectory stringByAppendingPathComponent:AWSLogsLoggerDatabasePathPrefix];
+        NSString *databasePath = [databaseDirectoryPath stringByAppendingPathComponent:[AWSLogsLogger databaseNameForLogGroupName:_logGroupName
+                                                                                                                    logStreamName:_logStreamName]];
+
+        // Creates a directory for storing databases if it doesn't exist.
+        if (![[NSFileManager defaultManager] fileExistsAtPath:databaseDirectoryPath]) {
+            NSError *error = nil;
+            BOOL success = [[NSFileManager defaultManager] createDirectoryAtPath:databaseDirectoryPath
+                                                     withIntermediateDirectories:YES
+                                                                      attributes:nil
+                                                                           error:&error];
+            if (!success) {
+                AWSDDLogError(@"AWSLogsLogger: Failed to create a directory for database. [%@]", error);
+            }
+        }
+
+        _databaseQueue = [AWSFMDatabaseQueue serialDatabaseQueueWithPath:databasePath];
+        [_databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            if (![db executeUpdate:
+                  @"CREATE TABLE IF NOT EXISTS event ("
+                  @"timestamp INTEGER NOT NULL,"
+                  @"message TEXT NOT NULL,"
+                  @"size INTEGER NOT NULL)"]) {
+                AWSDDLogError(@"AWSLogsLogger: SQLite error. [%@]", db.lastError);
+            }
+        }];
+    }
+    return self;
+}
+
+- (NSString *)loggerName {
+    return @"com.amazonaws.AWSLogsLogger";
+}
+
+// Errors are reported with AWSDDLog. The messages logged from this file are not shipped, so that a failing upload
+// does not feed its own errors back into the logger.
+
+#pragma mark - AWSDDAbstractDatabaseLogger
+
+- (BOOL)db_log:(AWSDDLogMessage *)logMessage {
+    if ([logMessage->_file isEqualToString:@(__FILE__)]) {
+        return NO;
+    }
+
+    NSString *message = logMessage->_message;
+    if (_logFormatter) {
+        message = [_logFormatter formatLogMessage:logMessage];
+    }
+    if ([message length] == 0) {
+        return NO;
+    }
+
+    NSUInteger size = [message lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    if (size > AWSLogsLoggerEventByteLimit) {
+        message = [AWSLogsLogger truncatedMessage:message];
+        size = [message lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    }
+
+    int64_t timestamp = (int64_t)floor([logMessage->_timestamp timeIntervalSince1970] * 1000);
+    [_unsavedEvents addObject:@[@(timestamp), message, @(size + AWSLogsLoggerEventOverhead)]];
+    _unsavedBytes += size + AWSLogsLoggerEventOverhead;
+
+    if (_unsavedBytes >= AWSLogsLoggerUnsavedByteLimit) {
+        [self db_save];
+    }
+
+    return YES;
+}
+
+- (void)db_save {
+    if ([_unsavedEvents count] == 0) {
+        return;
+    }
+
+    NSArray<NSArray *> *events = _unsavedEvents;
+    _unsavedEvents = [NSMutableArray new];
+    _unsavedBytes = 0;
+
+    NSUInteger diskByteLimit = self.diskByteLimit;
+    [self.databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        for (NSArray *event in events) {
+            if (![db executeUpdate:@"INSERT INTO event (timestamp, message, size) VALUES (?, ?, ?)", event[0], event[1], event[2]]) {
+                AWSDDLogError(@"AWSLogsLogger: SQLite error. Rolling back... [%@]", db.lastError);
+                *rollback = YES;
+                return;
+            }
+        }
+
+        // Drops the oldest events beyond the disk limit.
+        long long excess = (long long)[db longForQuery:@"SELECT IFNULL(SUM(size), 0) FROM event"] - (long long)diskByteLimit;
+        if (excess > 0) {
+            NSMutableArray<NSNumber *> *rowIds = [NSMutableArray new];
+            AWSFMResultSet *rs = [db executeQuery:@"SELECT rowid, size FROM event ORDER BY timestamp ASC, rowid ASC"];
+            while (excess > 0 && [rs next]) {
+                [rowIds addObject:@([rs longLongIntForColumnIndex:0])];
+                excess -= [rs longLongIntForColumnIndex:1];
+            }
+            [rs close];
+
+            for (NSNumber *rowId in rowIds) {
+                if (![db executeUpdate:@"DELETE FROM event WHERE rowid = ?", rowId]) {
+                    AWSDDLogError(@"AWSLogsLogger: SQLite error. [%@]", db.lastError);
+                    break;
+                }
+            }
+        }
+    }];
+
+    [self scheduleUpload];
+}
+
+- (void)db_delete {
+    int64_t cutoff = (int64_t)floor(([[NSDate date] timeIntervalSince1970] - self->_maxAge) * 1000);
+    [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        if (![db executeUpdate:@"DELETE FROM event WHERE timestamp < ?", @(cutoff)]) {
+            AWSDDLogError(@"AWSLogsLogger: SQLite error. [%@]", db.lastError);
+        }
+    }];
+}
+
+- (void)db_saveAndDelete {
+    [self db_save];
+    [self db_delete];
+}
+
+#pragma mark - Uploading
+
+- (void)scheduleUpload {
+    @synchronized(self) {
+        if (_uploadScheduled) {
+            return;
+        }
+        _uploadScheduled = YES;
+    }
+
+    dispatch_async(self.uploadQueue, ^{
+        // Cleared before reading the database, so a save that happens during this pass schedules another one.
+        @synchronized(self) {
+            self->_uploadScheduled = NO;
+        }
+        NSError *error = [self uploadSavedEvents];
+        if (error) {
+            AWSDDLogWarn(@"AWSLogsLogger: Upload failed, events are kept for the next attempt. [%@]", error);
+        }
+    });
+}
+
+- (AWSTask *)submitAllEvents {
+    return [AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:self.uploadQueue] withBlock:^id _Nullable{
+        NSError *error = [self uploadSavedEvents];
+        if (error) {
+            return [AWSTask taskWithError:error];
+        }
+        return nil;
+    }];
+}
+
+- (NSError *)uploadSavedEvents {
+    while (YES) {
+        NSMutableArray<NSNumber *> *rowIds = [NSMutableArray new];
+        NSMutableArray<AWSLogsInputLogEvent *> *logEvents = [NSMutableArray new];
+        __block NSError *error = nil;
+
+        [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            AWSFMResultSet *rs = [db executeQuery:@"SELECT rowid, timestamp, message, size FROM event ORDER BY timestamp ASC, rowid ASC LIMIT ?",
+                                  @(AWSLogsLoggerBatchEventLimit)];
+            if (!rs) {
+                error = db.lastError;
+                return;
+            }
+
+            NSUInteger batchBytes = 0;
+            int64_t firstTimestamp = 0;
+            while ([rs next]) {
+                int64_t timestamp = [rs longLongIntForColumnIndex:1];
+                NSUInteger size = (NSUInteger)[rs longLongIntForColumnIndex:3];
+                if ([logEvents count] > 0
+                    && (batchBytes + size > AWSLogsLoggerBatchByteLimit || timestamp - firstTimestamp >= AWSLogsLoggerBatchSpanLimit)) {
+                    break;
+                }
+                if ([logEvents count] == 0) {
+                    firstTimestamp = timestamp;
+                }
+
+                AWSLogsInputLogEvent *logEvent = [AWSLogsInputLogEvent new];
+                logEvent.timestamp = @(timestamp);
+                logEvent.message = [rs stringForColumnIndex:2];
+                [logEvents addObject:logEvent];
+                [rowIds addObject:@([rs longLongIntForColumnIndex:0])];
+                batchBytes += size;
+            }
+            [rs close];
+        }];
+
+        if (error) {
+            return error;
+        }
+        if ([logEvents count] == 0) {
+            return nil;
+        }
+
+        error = [self putLogEvents:logEvents];
+        if (error) {
+            return error;
+        }
+
+        [self.databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+            for (NSNumber *rowId in rowIds) {
+                if (![db executeUpdate:@"DELETE FROM event WHERE rowid = ?", rowId]) {
+                    error = db.lastError;
+                    *rollback = YES;
+                    return;
+                }
+            }
+        }];
+
+        if (error) {
+            return error;
+        }
+    }
+}
+
+- (NSError *)putLogEvents:(NSArray<AWSLogsInputLogEvent *> *)logEvents {
+    // A missing stream, a stale sequence token and a missing group can each cost one extra attempt.
+    NSError *error = nil;
+    for (NSUInteger attempt = 0; attempt < 4; attempt++) {
+        AWSLogsPutLogEventsRequest *request = [AWSLogsPutLogEventsRequest new];
+        request.logGroupName = self.logGroupName;
+        request.logStreamName = self.logStreamName;
+        request.logEvents = logEvents;
+        request.sequenceToken = _sequenceToken;
+
+        AWSTask<AWSLogsPutLogEventsResponse *> *task = [self.logs putLogEvents:request];
+        [task waitUntilFinished];
+
+        if (!task.error) {
+            AWSLogsPutLogEventsResponse *response = task.result;
+            _sequenceToken = response.nextSequenceToken;
+            if (response.rejectedLogEventsInfo) {
+                AWSDDLogWarn(@"AWSLogsLogger: Some events were rejected. [%@]", response.rejectedLogEventsInfo);
+            }
+            return nil;
+        }
+
+        error = task.error;
+        if (![error.domain isEqualToString:AWSLogsErrorDomain]) {
+            return error;
+        }
+
+        switch (error.code) {
+            case AWSLogsErrorInvalidSequenceToken:
+                _sequenceToken = error.userInfo[@"expectedSequenceToken"];
+                break;
+            case AWSLogsErrorDataAlreadyAccepted:
+                // A previous attempt got through even though its response was lost.
+                _sequenceToken = error.userInfo[@"expectedSequenceToken"];
+                return nil;
+            case AWSLogsErrorResourceNotFound: {
+                NSError *createError = [self createLogStream];
+                if (createError) {
+                    return createError;
+                }
+                _sequenceToken = nil;
+                break;
+            }
+            default:
+                return error;
+        }
+    }
+
+    return error;
+}
+
+- (NSError *)createLogStream {
+    AWSLogsCreateLogStreamRequest *streamRequest = [AWSLogsCreateLogStreamRequest new];
+    streamRequest.logGroupName = self.logGroupName;
+    streamRequest.logStreamName = self.logStreamName;
+
+    AWSTask *task = [self.logs createLogStream:streamRequest];
+    [task waitUntilFinished];
+
+    if ([task.error.domain isEqualToString:AWSLogsErrorDomain] && task.error.code == AWSLogsErrorResourceNotFound) {
+        AWSLogsCreateLogGroupRequest *groupRequest = [AWSLogsCreateLogGroupRequest new];
+        groupRequest.logGroupName = self.logGroupName;
+
+        AWSTask *groupTask = [self.logs createLogGroup:groupRequest];
+        [groupTask waitUntilFinished];
+        if (groupTask.error && !([groupTask.error.domain isEqualToString:AWSLogsErrorDomain] && groupTask.error.code == AWSLogsErrorResourceAlreadyExists)) {
+            return groupTask.error;
+        }
+
+        task = [self.logs createLogStream:streamRequest];
+        [task waitUntilFinished];
+    }
+
+    if (task.error && !([task.error.domain isEqualToString:AWSLogsErrorDomain] && task.error.code == AWSLogsErrorResourceAlreadyExists)) {
+        return task.error;
+    }
+    return nil;
+}
+
+#pragma mark - Helpers
+
++ (NSString *)truncatedMessage:(NSString *)message {
+    NSData *data = [message dataUsingEncoding:NSUTF8StringEncoding];
+    const uint8_t *bytes = data.bytes;
+    NSUInteger length = AWSLogsLoggerEventByteLimit;
+
+    // Back off to the start of a UTF-8 sequence so the prefix stays valid.
+    while (length > 0 && (bytes[length] & 0xC0) == 0x80) {
+        length--;
+    }
+
+    return [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+}
+
++ (NSString *)databaseNameForLogGroupName:(NSString *)logGroupName
+                            logStreamName:(NSString *)logStreamName {
+    NSData *data = [[NSString stringWithFormat:@"%@\n%@", logGroupName, logStreamName] dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256([data bytes], (CC_LONG)[data length], digest);
+
+    NSMutableString *name = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [name appendFormat:@"%02x", digest[i]];
+    }
+    return name;
+}
+
+@end
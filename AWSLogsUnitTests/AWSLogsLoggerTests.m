@@ -0,0 +1,236 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSLogsService.h"
+#import "AWSLogsLogger.h"
+
+@interface AWSLogs()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+// Stands in for the CloudWatch Logs endpoint. It accepts PutLogEvents calls, checks the sequence token
+// the way the service does, and can be switched offline.
+@interface AWSLogsLoggerTestClient : AWSLogs
+
+@property (atomic, assign) BOOL offline;
+@property (atomic, assign) BOOL logStreamExists;
+@property (atomic, strong) NSString *expectedSequenceToken;
+@property (nonatomic, strong) NSMutableArray<AWSLogsPutLogEventsRequest *> *acceptedRequests;
+@property (atomic, assign) NSUInteger invalidSequenceTokenCount;
+
+@end
+
+@implementation AWSLogsLoggerTestClient
+
+- (AWSTask<AWSLogsPutLogEventsResponse *> *)putLogEvents:(AWSLogsPutLogEventsRequest *)request {
+    @synchronized(self) {
+        if (self.offline) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil]];
+        }
+        if (!self.logStreamExists) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSLogsErrorDomain code:AWSLogsErrorResourceNotFound userInfo:nil]];
+        }
+        if (self.expectedSequenceToken && ![request.sequenceToken isEqualToString:self.expectedSequenceToken]) {
+            self.invalidSequenceTokenCount++;
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSLogsErrorDomain
+                                                              code:AWSLogsErrorInvalidSequenceToken
+                                                          userInfo:@{@"expectedSequenceToken" : self.expectedSequenceToken}]];
+        }
+
+        [self.acceptedRequests addObject:request];
+        self.expectedSequenceToken = [NSUUID UUID].UUIDString;
+
+        AWSLogsPutLogEventsResponse *response = [AWSLogsPutLogEventsResponse new];
+        response.nextSequenceToken = self.expectedSequenceToken;
+        return [AWSTask taskWithResult:response];
+    }
+}
+
+- (AWSTask *)createLogStream:(AWSLogsCreateLogStreamRequest *)request {
+    self.logStreamExists = YES;
+    return [AWSTask taskWithResult:nil];
+}
+
+- (AWSTask *)createLogGroup:(AWSLogsCreateLogGroupRequest *)request {
+    return [AWSTask taskWithResult:nil];
+}
+
+- (NSArray<AWSLogsInputLogEvent *> *)acceptedEvents {
+    NSMutableArray *events = [NSMutableArray new];
+    @synchronized(self) {
+        for (AWSLogsPutLogEventsRequest *request in self.acceptedRequests) {
+            [events addObjectsFromArray:request.logEvents];
+        }
+    }
+    return events;
+}
+
+@end
+
+@interface AWSLogsLoggerTests : XCTestCase
+
+@property (nonatomic, strong) AWSLogsLoggerTestClient *client;
+@property (nonatomic, strong) AWSLogsLogger *logger;
+@property (nonatomic, strong) AWSDDLog *log;
+
+@end
+
+@implementation AWSLogsLoggerTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1 credentialsProvider:nil];
+    self.client = [[AWSLogsLoggerTestClient alloc] initWithConfiguration:configuration];
+    self.client.acceptedRequests = [NSMutableArray new];
+    self.client.logStreamExists = YES;
+
+    self.logger = [[AWSLogsLogger alloc] initWithLogs:self.client
+                                         logGroupName:@"AWSLogsLoggerTests"
+                                        logStreamName:[NSUUID UUID].UUIDString];
+    self.log = [AWSDDLog new];
+    [self.log addLogger:self.logger];
+}
+
+- (void)tearDown {
+    [self.log removeAllLoggers];
+    [super tearDown];
+}
+
+- (void)logMessage:(NSString *)message timestamp:(NSDate *)timestamp {
+    AWSDDLogMessage *logMessage = [[AWSDDLogMessage alloc] initWithMessage:message
+                                                                     level:AWSDDLogLevelAll
+                                                                      flag:AWSDDLogFlagInfo
+                                                                   context:0
+                                                                      file:@__FILE__
+                                                                  function:@(__PRETTY_FUNCTION__)
+                                                                      line:__LINE__
+                                                                       tag:nil
+                                                                   options:(AWSDDLogMessageOptions)0
+                                                                 timestamp:timestamp];
+    [self.log log:YES message:logMessage];
+}
+
+- (void)flushAndSubmit {
+    [self.log flushLog];
+    AWSTask *task = [self.logger submitAllEvents];
+    [task waitUntilFinished];
+    XCTAssertNil(task.error);
+}
+
+- (void)testBatchesRespectPutLogEventsLimits {
+    NSString *longMessage = [@"" stringByPaddingToLength:2000 withString:@"x" startingAtIndex:0];
+    for (NSUInteger i = 0; i < 12000; i++) {
+        [self logMessage:(i % 10 == 0 ? longMessage : [NSString stringWithFormat:@"message %lu", (unsigned long)i]) timestamp:[NSDate date]];
+    }
+    [self flushAndSubmit];
+
+    XCTAssertEqual([self.client acceptedEvents].count, 12000);
+    for (AWSLogsPutLogEventsRequest *request in self.client.acceptedRequests) {
+        XCTAssertLessThanOrEqual(request.logEvents.count, 10000);
+
+        NSUInteger bytes = 0;
+        for (AWSLogsInputLogEvent *event in request.logEvents) {
+            bytes += [event.message lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + 26;
+        }
+        XCTAssertLessThanOrEqual(bytes, 1048576);
+    }
+}
+
+- (void)testBatchesDoNotSpanMoreThanOneDay {
+    NSDate *now = [NSDate date];
+    [self logMessage:@"two days ago" timestamp:[now dateByAddingTimeInterval:-2 * 24 * 60 * 60]];
+    [self logMessage:@"yesterday" timestamp:[now dateByAddingTimeInterval:-24 * 60 * 60 + 1]];
+    [self logMessage:@"now" timestamp:now];
+    [self flushAndSubmit];
+
+    XCTAssertEqual(self.client.acceptedRequests.count, 2);
+    XCTAssertEqualObjects(self.client.acceptedRequests[0].logEvents.firstObject.message, @"two days ago");
+    XCTAssertEqual(self.client.acceptedRequests[0].logEvents.count, 1);
+    XCTAssertEqual(self.client.acceptedRequests[1].logEvents.count, 2);
+}
+
+- (void)testInvalidSequenceTokenIsRetriedWithExpectedToken {
+    self.client.expectedSequenceToken = @"49590302887285891438536";
+
+    [self logMessage:@"message" timestamp:[NSDate date]];
+    [self flushAndSubmit];
+
+    XCTAssertEqual(self.client.invalidSequenceTokenCount, 1);
+    XCTAssertEqual(self.client.acceptedRequests.count, 1);
+    XCTAssertEqualObjects(self.client.acceptedRequests[0].sequenceToken, @"49590302887285891438536");
+}
+
+- (void)testMissingLogStreamIsCreated {
+    self.client.logStreamExists = NO;
+
+    [self logMessage:@"message" timestamp:[NSDate date]];
+    [self flushAndSubmit];
+
+    XCTAssertTrue(self.client.logStreamExists);
+    XCTAssertEqual([self.client acceptedEvents].count, 1);
+}
+
+- (void)testEventsAreKeptOnDiskWhileOffline {
+    self.client.offline = YES;
+    [self logMessage:@"first" timestamp:[NSDate date]];
+    [self.log flushLog];
+
+    AWSTask *task = [self.logger submitAllEvents];
+    [task waitUntilFinished];
+    XCTAssertNotNil(task.error);
+    XCTAssertEqual([self.client acceptedEvents].count, 0);
+
+    // The database is kept where the system does not purge it.
+    NSString *applicationSupportDirectory = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+    NSString *databaseDirectoryPath = [applicationSupportDirectory stringByAppendingPathComponent:@"com/amazonaws/AWSLogsLogger"];
+    XCTAssertGreaterThan([[[NSFileManager defaultManager] contentsOfDirectoryAtPath:databaseDirectoryPath error:nil] count], 0);
+
+    self.client.offline = NO;
+    [self logMessage:@"second" timestamp:[NSDate date]];
+    [self flushAndSubmit];
+
+    NSArray<AWSLogsInputLogEvent *> *events = [self.client acceptedEvents];
+    XCTAssertEqual(events.count, 2);
+    XCTAssertEqualObjects(events[0].message, @"first");
+    XCTAssertEqualObjects(events[1].message, @"second");
+}
+
+- (void)testOversizedMessageIsTruncated {
+    NSString *hugeMessage = [@"" stringByPaddingToLength:300 * 1024 withString:@"é" startingAtIndex:0];
+    [self logMessage:hugeMessage timestamp:[NSDate date]];
+    [self flushAndSubmit];
+
+    NSString *message = [self.client acceptedEvents].firstObject.message;
+    XCTAssertNotNil(message);
+    XCTAssertLessThanOrEqual([message lengthOfBytesUsingEncoding:NSUTF8StringEncoding], 256 * 1024 - 26);
+}
+
+// Sustained lines per second through the logger, the database and the stub endpoint.
+- (void)testSustainedThroughputPerformance {
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 20000; i++) {
+            [self logMessage:[NSString stringWithFormat:@"performance line %lu", (unsigned long)i] timestamp:[NSDate date]];
+        }
+        [self flushAndSubmit];
+    }];
+}
+
+@end
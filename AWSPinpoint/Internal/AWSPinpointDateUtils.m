@@ -14,36 +14,16 @@
 //
 
 #import "AWSPinpointDateUtils.h"
-
-#define kISODateTimeFormat @"yyyy-MM-dd'T'HH:mm:ss.SSS'Z'"
-#define kDateTimeFormat @"yyyyMMdd'T'HHmmss'Z'"
-#define kDateStampFormat @"yyyyMMdd"
+#import <AWSCore/AWSCategory.h>
 
 @implementation AWSPinpointDateUtils
 
-+(NSLocale *)isoTimestampLocale {
-    static NSLocale *_tsLoc = nil;
-    
-    if (nil == _tsLoc) {
-        _tsLoc = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US"];
-    }
-    return _tsLoc;
-}
-
 + (NSString *)isoDateTimeWithTimestamp:(UTCTimeMillis) theTimeStamp {
     return [AWSPinpointDateUtils isoDateTime:[NSDate dateWithTimeIntervalSince1970:((NSTimeInterval)theTimeStamp)/1000]];
 }
 
 + (NSString *)isoDateTime:(NSDate *)theDate {
-    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
-    
-    [dateFormatter setTimeZone:[NSTimeZone timeZoneWithName:@"GMT"]];
-    [dateFormatter setDateFormat:kISODateTimeFormat];
-    [dateFormatter setLocale:[AWSPinpointDateUtils isoTimestampLocale]];
-    
-    NSString *formatted = [dateFormatter stringFromDate:theDate];
-    
-    return formatted;
+    return [theDate aws_stringValue:AWSDateISO8601DateFormat3];
 }
 
 + (UTCTimeMillis)utcTimeMillisNow {
@@ -62,49 +42,16 @@
     return [NSDate dateWithTimeIntervalSince1970:(utcMillis/1000.0)];
 }
 
-+(NSLocale *)timestampLocale {
-    static NSLocale *_tsLoc = nil;
-    
-    if (nil == _tsLoc) {
-        _tsLoc = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US"];
-    }
-    return _tsLoc;
-}
-
 + (NSString *)iso8061FormatDateStamp:(NSDate *)theDate {
-    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
-    
-    [dateFormatter setTimeZone:[NSTimeZone timeZoneWithName:@"GMT"]];
-    [dateFormatter setDateFormat:kDateStampFormat];
-    [dateFormatter setLocale:[AWSPinpointDateUtils timestampLocale]];
-    
-    NSString *formatted = [dateFormatter stringFromDate:theDate];
-    
-    return formatted;
+    return [theDate aws_stringValue:AWSDateShortDateFormat1];
 }
 
 + (NSString *)iso8061FormatDateTime:(NSDate *)theDate {
-    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
-    
-    [dateFormatter setTimeZone:[NSTimeZone timeZoneWithName:@"GMT"]];
-    [dateFormatter setDateFormat:kDateTimeFormat];
-    [dateFormatter setLocale:[AWSPinpointDateUtils timestampLocale]];
-    
-    NSString *formatted = [dateFormatter stringFromDate:theDate];
-    
-    return formatted;
+    return [theDate aws_stringValue:AWSDateISO8601DateFormat2];
 }
 
 + (NSDate*) dateFromISO8061String:(NSString*)dateString {
-    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
-    
-    [dateFormatter setTimeZone:[NSTimeZone timeZoneWithName:@"GMT"]];
-    [dateFormatter setDateFormat:kISODateTimeFormat];
-    [dateFormatter setLocale:[AWSPinpointDateUtils timestampLocale]];
-    
-    NSDate *date = [dateFormatter dateFromString:dateString];
-    
-    return date;
+    return [NSDate aws_dateFromString:dateString format:AWSDateISO8601DateFormat3];
 }
 
 @end
@@ -41,4 +41,5 @@ FOUNDATION_EXPORT const unsigned char AWSPollyVersionString[] DEPRECATED_MSG_ATT
 #import <AWSCore/AWSCore.h>
 #import "AWSPollyService.h"
 #import "AWSPollySynthesizeSpeechURLBuilder.h"
+#import "AWSPollySpeechSynthesizer.h"
 #import "AWSPollyEnumTranslatorUtility.h"
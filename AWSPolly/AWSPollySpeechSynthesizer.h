@@ -0,0 +1,125 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import <AWSCore/AWSCore.h>
+#import "AWSPollyModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class AWSPolly;
+
+/**
+ The default value of `maximumSegmentLength`, 1500 characters.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSPollySpeechSynthesizerDefaultMaximumSegmentLength;
+
+/**
+ The default value of `maximumConcurrentRequests`, 4.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSPollySpeechSynthesizerDefaultMaximumConcurrentRequests;
+
+/**
+ The default value of `cacheCapacity`, 20MB.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSPollySpeechSynthesizerDefaultCacheCapacity;
+
+/**
+ Called with every chunk of audio, in order, one at a time, on a background queue.
+
+ @param audioChunk The audio stream of the segment.
+ @param index      The index of the segment, from 0.
+ @param count      The number of segments of the text.
+ */
+typedef void (^AWSPollySpeechSynthesizerAudioChunkBlock)(NSData *audioChunk, NSUInteger index, NSUInteger count);
+
+/**
+ Synthesizes long texts as a stream of audio chunks.
+
+ `- synthesizeSpeech:audioChunkHandler:` splits the text of the request at sentence boundaries into segments of at most
+ `maximumSegmentLength` characters, and synthesizes up to `maximumConcurrentRequests` segments at a time. The audio of
+ every segment is delivered as soon as it and the segments before it are synthesized, so playback can start after the
+ first segment rather than after the whole text.
+
+ The audio streams of `mp3`, `ogg_vorbis` and `pcm` segments may be played or written one after the other. The time
+ offsets of speech marks are relative to the start of their segment.
+ */
+@interface AWSPollySpeechSynthesizer : NSObject
+
+/**
+ The Amazon Polly client that synthesizes the segments.
+ */
+@property (nonatomic, strong, readonly) AWSPolly *polly;
+
+/**
+ The maximum length of a segment, in characters. A sentence longer than this is split between words. The default value is `AWSPollySpeechSynthesizerDefaultMaximumSegmentLength`.
+ */
+@property (nonatomic, assign) NSUInteger maximumSegmentLength;
+
+/**
+ The maximum number of segments synthesized at a time, which also bounds the number of synthesized segments waiting for the segments before them. The default value is `AWSPollySpeechSynthesizerDefaultMaximumConcurrentRequests`.
+ */
+@property (nonatomic, assign) NSUInteger maximumConcurrentRequests;
+
+/**
+ The directory of the cached audio of segments, by voice, engine, output format and text. Segments that are cached are not synthesized again. The default value is `nil`, and no audio is cached.
+ */
+@property (nonatomic, strong, nullable) NSString *cacheDirectoryPath;
+
+/**
+ The maximum total size of the cached audio, in bytes. When it is exceeded, the least recently used audio is removed. The default value is `AWSPollySpeechSynthesizerDefaultCacheCapacity`.
+ */
+@property (nonatomic, assign) NSUInteger cacheCapacity;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a speech synthesizer.
+
+ @param polly The Amazon Polly client that synthesizes the segments.
+
+ @return A speech synthesizer.
+ */
+- (instancetype)initWithPolly:(AWSPolly *)polly NS_DESIGNATED_INITIALIZER;
+
+/**
+ Synthesizes the text of a request as a stream of audio chunks, one per segment of the text.
+
+ @param request           The request. Its `text` is split into segments, and every segment is synthesized with the other parameters of the request.
+ @param audioChunkHandler The block called with the audio of every segment, in order.
+
+ @return An instance of `AWSTask`. On successful execution, `task.result` will contain the number of segments, after every chunk was delivered. On failed execution, `task.error` contains the error of the first segment that failed, and no chunk is delivered after it.
+ */
+- (AWSTask<NSNumber *> *)synthesizeSpeech:(AWSPollySynthesizeSpeechInput *)request
+                        audioChunkHandler:(AWSPollySpeechSynthesizerAudioChunkBlock)audioChunkHandler;
+
+/**
+ Splits a text at sentence boundaries into segments of at most `maximumLength` characters.
+
+ SSML is split between the sentences of the `<speak>` element, outside of any other element, and every segment is wrapped in its own `<speak>` element.
+
+ @param text          The text.
+ @param textType      The type of the text, plain text or SSML.
+ @param maximumLength The maximum length of a segment, in characters.
+
+ @return The segments of the text.
+ */
++ (NSArray<NSString *> *)segmentsOfText:(NSString *)text
+                               textType:(AWSPollyTextType)textType
+                          maximumLength:(NSUInteger)maximumLength;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,492 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSPollySpeechSynthesizer.h"
+#import <CommonCrypto/CommonCrypto.h>
+#import "AWSPollyService.h"
+
+NSUInteger const AWSPollySpeechSynthesizerDefaultMaximumSegmentLength = 1500;
+NSUInteger const AWSPollySpeechSynthesizerDefaultMaximumConcurrentRequests = 4;
+NSUInteger const AWSPollySpeechSynthesizerDefaultCacheCapacity = 20 * 1024 * 1024;
+
+static NSString *const AWSPollySpeechSynthesizerSSMLSpeakTag = @"<speak>";
+static NSString *const AWSPollySpeechSynthesizerSSMLSpeakEndTag = @"</speak>";
+
+@interface AWSPollySpeechSynthesizer()
+
+// The cache index is only accessed on `cacheQueue`. `cacheFileNames` is ordered from the least to the most recently used file.
+@property (nonatomic, strong) dispatch_queue_t cacheQueue;
+@property (nonatomic, strong) NSString *indexedCacheDirectoryPath;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *cacheFileSizes;
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *cacheFileNames;
+@property (nonatomic, assign) NSUInteger cacheUsage;
+
+- (NSData *)cachedAudioForKey:(NSString *)key;
+- (void)cacheAudio:(NSData *)audio forKey:(NSString *)key;
+
+@end
+
+#pragma mark - AWSPollySpeechSynthesisOperation
+
+// Synthesizes the segments of one request. Its state is only accessed on `queue`.
+@interface AWSPollySpeechSynthesisOperation : NSObject
+
+@property (nonatomic, strong) AWSPollySpeechSynthesizer *synthesizer;
+@property (nonatomic, strong) AWSPollySynthesizeSpeechInput *request;
+@property (nonatomic, strong) NSArray<NSString *> *segments;
+@property (nonatomic, copy) AWSPollySpeechSynthesizerAudioChunkBlock audioChunkHandler;
+@property (nonatomic, assign) NSUInteger maximumConcurrentRequests;
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) AWSTaskCompletionSource<NSNumber *> *completionSource;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSData *> *synthesizedChunks;
+@property (nonatomic, assign) NSUInteger nextSegmentToStart;
+@property (nonatomic, assign) NSUInteger nextSegmentToDeliver;
+@property (nonatomic, assign) BOOL finished;
+
+@end
+
+@implementation AWSPollySpeechSynthesisOperation
+
+- (AWSTask<NSNumber *> *)start {
+    self.queue = dispatch_queue_create("com.amazonaws.AWSPollySpeechSynthesisOperation", DISPATCH_QUEUE_SERIAL);
+    self.completionSource = [AWSTaskCompletionSource taskCompletionSource];
+    self.synthesizedChunks = [NSMutableDictionary new];
+
+    dispatch_async(self.queue, ^{
+        if ([self.segments count] == 0) {
+            self.finished = YES;
+            [self.completionSource setResult:@0];
+            return;
+        }
+        [self startSegments];
+    });
+
+    return self.completionSource.task;
+}
+
+// Starts segments until `maximumConcurrentRequests` segments are being synthesized or waiting to be delivered.
+- (void)startSegments {
+    while (!self.finished
+           && self.nextSegmentToStart < [self.segments count]
+           && self.nextSegmentToStart < self.nextSegmentToDeliver + self.maximumConcurrentRequests) {
+        NSUInteger index = self.nextSegmentToStart;
+        self.nextSegmentToStart++;
+
+        NSString *segment = self.segments[index];
+        NSString *cacheKey = [self cacheKeyForSegment:segment];
+        NSData *cachedAudio = [self.synthesizer cachedAudioForKey:cacheKey];
+        if (cachedAudio) {
+            [self completeSegmentAtIndex:index audio:cachedAudio error:nil];
+            continue;
+        }
+
+        [[self.synthesizer.polly synthesizeSpeech:[self requestForSegment:segment]] continueWithBlock:^id(AWSTask<AWSPollySynthesizeSpeechOutput *> *task) {
+            NSData *audio = task.result.audioStream ?: [NSData data];
+            if (!task.error) {
+                [self.synthesizer cacheAudio:audio forKey:cacheKey];
+            }
+            dispatch_async(self.queue, ^{
+                [self completeSegmentAtIndex:index audio:audio error:task.error];
+                [self startSegments];
+            });
+            return nil;
+        }];
+    }
+}
+
+- (void)completeSegmentAtIndex:(NSUInteger)index
+                         audio:(NSData *)audio
+                         error:(NSError *)error {
+    if (self.finished) {
+        return;
+    }
+    if (error) {
+        self.finished = YES;
+        [self.synthesizedChunks removeAllObjects];
+        [self.completionSource setError:error];
+        return;
+    }
+
+    self.synthesizedChunks[@(index)] = audio;
+    NSUInteger count = [self.segments count];
+    NSData *chunk = nil;
+    while ((chunk = self.synthesizedChunks[@(self.nextSegmentToDeliver)])) {
+        [self.synthesizedChunks removeObjectForKey:@(self.nextSegmentToDeliver)];
+        self.audioChunkHandler(chunk, self.nextSegmentToDeliver, count);
+        self.nextSegmentToDeliver++;
+    }
+
+    if (self.nextSegmentToDeliver == count) {
+        self.finished = YES;
+        [self.completionSource setResult:@(count)];
+    }
+}
+
+- (AWSPollySynthesizeSpeechInput *)requestForSegment:(NSString *)segment {
+    AWSPollySynthesizeSpeechInput *segmentRequest = [AWSPollySynthesizeSpeechInput new];
+    segmentRequest.engine = self.request.engine;
+    segmentRequest.languageCode = self.request.languageCode;
+    segmentRequest.lexiconNames = self.request.lexiconNames;
+    segmentRequest.outputFormat = self.request.outputFormat;
+    segmentRequest.sampleRate = self.request.sampleRate;
+    segmentRequest.speechMarkTypes = self.request.speechMarkTypes;
+    segmentRequest.text = segment;
+    segmentRequest.textType = self.request.textType;
+    segmentRequest.voiceId = self.request.voiceId;
+    return segmentRequest;
+}
+
+// Every parameter that changes the audio of a segment is part of its key.
+- (NSString *)cacheKeyForSegment:(NSString *)segment {
+    AWSPollySynthesizeSpeechInput *request = self.request;
+    return [NSString stringWithFormat:@"%ld|%ld|%ld|%@|%ld|%ld|%@|%@|%@",
+            (long)request.voiceId,
+            (long)request.engine,
+            (long)request.outputFormat,
+            request.sampleRate ?: @"",
+            (long)request.languageCode,
+            (long)request.textType,
+            [request.lexiconNames componentsJoinedByString:@","] ?: @"",
+            [request.speechMarkTypes componentsJoinedByString:@","] ?: @"",
+            segment];
+}
+
+@end
+
+#pragma mark - AWSPollySpeechSynthesizer
+
+@implementation AWSPollySpeechSynthesizer
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithPolly:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithPolly:(AWSPolly *)polly {
+    if (self = [super init]) {
+        _polly = polly;
+        _maximumSegmentLength = AWSPollySpeechSynthesizerDefaultMaximumSegmentLength;
+        _maximumConcurrentRequests = AWSPollySpeechSynthesizerDefaultMaximumConcurrentRequests;
+        _cacheCapacity = AWSPollySpeechSynthesizerDefaultCacheCapacity;
+        _cacheQueue = dispatch_queue_create("com.amazonaws.AWSPollySpeechSynthesizer.cache", DISPATCH_QUEUE_SERIAL);
+        _cacheFileSizes = [NSMutableDictionary new];
+        _cacheFileNames = [NSMutableOrderedSet new];
+    }
+    return self;
+}
+
+- (AWSTask<NSNumber *> *)synthesizeSpeech:(AWSPollySynthesizeSpeechInput *)request
+                        audioChunkHandler:(AWSPollySpeechSynthesizerAudioChunkBlock)audioChunkHandler {
+    AWSPollySpeechSynthesisOperation *operation = [AWSPollySpeechSynthesisOperation new];
+    operation.synthesizer = self;
+    operation.request = request;
+    operation.segments = [AWSPollySpeechSynthesizer segmentsOfText:request.text ?: @""
+                                                          textType:request.textType
+                                                     maximumLength:self.maximumSegmentLength];
+    operation.audioChunkHandler = audioChunkHandler;
+    operation.maximumConcurrentRequests = MAX(self.maximumConcurrentRequests, 1);
+    return [operation start];
+}
+
+#pragma mark - Segments
+
++ (NSArray<NSString *> *)segmentsOfText:(NSString *)text
+                               textType:(AWSPollyTextType)textType
+                          maximumLength:(NSUInteger)maximumLength {
+    if (textType != AWSPollyTextTypeSsml) {
+        NSMutableArray<NSString *> *sentences = [NSMutableArray new];
+        [text enumerateSubstringsInRange:NSMakeRange(0, [text length])
+                                 options:NSStringEnumerationBySentences | NSStringEnumerationSubstringNotRequired
+                              usingBlock:^(NSString *substring, NSRange substringRange, NSRange enclosingRange, BOOL *stop) {
+            [sentences addObject:[text substringWithRange:enclosingRange]];
+        }];
+        return [self segmentsOfSentences:sentences
+                                  isSSML:NO
+                           maximumLength:MAX(maximumLength, 1)];
+    }
+
+    // Splits the content of the <speak> element, and wraps every segment in the same <speak> tag.
+    NSString *trimmedText = [text stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    NSString *speakTag = AWSPollySpeechSynthesizerSSMLSpeakTag;
+    NSString *content = trimmedText;
+    if ([trimmedText hasPrefix:@"<speak"] && [trimmedText hasSuffix:AWSPollySpeechSynthesizerSSMLSpeakEndTag]) {
+        NSRange speakTagEndRange = [trimmedText rangeOfString:@">"];
+        speakTag = [trimmedText substringToIndex:NSMaxRange(speakTagEndRange)];
+        content = [trimmedText substringWithRange:NSMakeRange(NSMaxRange(speakTagEndRange),
+                                                              [trimmedText length] - NSMaxRange(speakTagEndRange) - [AWSPollySpeechSynthesizerSSMLSpeakEndTag length])];
+    }
+    NSUInteger wrapperLength = [speakTag length] + [AWSPollySpeechSynthesizerSSMLSpeakEndTag length];
+    NSArray<NSString *> *contentSegments = [self segmentsOfSentences:[self sentencesOfSSMLContent:content]
+                                                              isSSML:YES
+                                                       maximumLength:maximumLength > wrapperLength ? maximumLength - wrapperLength : 1];
+
+    NSMutableArray<NSString *> *segments = [NSMutableArray arrayWithCapacity:[contentSegments count]];
+    for (NSString *contentSegment in contentSegments) {
+        [segments addObject:[NSString stringWithFormat:@"%@%@%@", speakTag, contentSegment, AWSPollySpeechSynthesizerSSMLSpeakEndTag]];
+    }
+    return segments;
+}
+
+// Packs consecutive sentences into segments, and splits the sentences longer than a segment between words.
++ (NSArray<NSString *> *)segmentsOfSentences:(NSArray<NSString *> *)sentences
+                                      isSSML:(BOOL)isSSML
+                               maximumLength:(NSUInteger)maximumLength {
+    NSMutableArray<NSString *> *segments = [NSMutableArray new];
+    NSMutableString *segment = [NSMutableString new];
+    for (NSString *sentence in sentences) {
+        NSString *remainder = sentence;
+        while ([remainder length] > 0) {
+            if ([segment length] + [remainder length] <= maximumLength) {
+                [segment appendString:remainder];
+                break;
+            }
+            if ([segment length] > 0) {
+                [segments addObject:[segment copy]];
+                [segment setString:@""];
+                continue;
+            }
+
+            NSUInteger splitIndex = isSSML
+            ? [self splitIndexOfSSML:remainder maximumLength:maximumLength]
+            : [self splitIndexOfPlainText:remainder maximumLength:maximumLength];
+            if (splitIndex == 0 || splitIndex >= [remainder length]) {
+                [segment appendString:remainder];
+                break;
+            }
+            [segments addObject:[remainder substringToIndex:splitIndex]];
+            remainder = [remainder substringFromIndex:splitIndex];
+        }
+    }
+
+    NSString *lastSegment = [segment stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    if ([lastSegment length] > 0) {
+        [segments addObject:[segment copy]];
+    }
+    return segments;
+}
+
+// Splits after the last whitespace that fits, or between composed characters when a word is longer than a segment.
++ (NSUInteger)splitIndexOfPlainText:(NSString *)text
+                      maximumLength:(NSUInteger)maximumLength {
+    NSRange whitespaceRange = [text rangeOfCharacterFromSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]
+                                                    options:NSBackwardsSearch
+                                                      range:NSMakeRange(0, maximumLength)];
+    if (whitespaceRange.location != NSNotFound && whitespaceRange.location > 0) {
+        return NSMaxRange(whitespaceRange);
+    }
+    return [text rangeOfComposedCharacterSequenceAtIndex:maximumLength].location;
+}
+
+// Splits after the last whitespace that fits outside of any element. Returns 0 when there is none, as SSML cannot be
+// split inside an element.
++ (NSUInteger)splitIndexOfSSML:(NSString *)SSML
+                 maximumLength:(NSUInteger)maximumLength {
+    NSUInteger splitIndex = 0;
+    NSInteger depth = 0;
+    NSUInteger length = MIN([SSML length], maximumLength);
+    NSCharacterSet *whitespaceCharacterSet = [NSCharacterSet whitespaceAndNewlineCharacterSet];
+    for (NSUInteger i = 0; i < length; i++) {
+        unichar character = [SSML characterAtIndex:i];
+        if (character == '<') {
+            NSUInteger tagEnd = [self endOfSSMLTagAtIndex:i inString:SSML];
+            depth += [self depthChangeOfSSMLTag:[SSML substringWithRange:NSMakeRange(i, tagEnd - i)]];
+            i = tagEnd - 1;
+        } else if (depth == 0 && i > 0 && [whitespaceCharacterSet characterIsMember:character]) {
+            splitIndex = i + 1;
+        }
+    }
+    return splitIndex;
+}
+
+// Splits SSML content after sentence terminators and after <p> and <s> elements, outside of any other element.
++ (NSArray<NSString *> *)sentencesOfSSMLContent:(NSString *)content {
+    NSMutableArray<NSString *> *sentences = [NSMutableArray new];
+    NSCharacterSet *whitespaceCharacterSet = [NSCharacterSet whitespaceAndNewlineCharacterSet];
+    NSCharacterSet *terminatorCharacterSet = [NSCharacterSet characterSetWithCharactersInString:@".!?。！？"];
+    NSUInteger length = [content length];
+    NSUInteger sentenceStart = 0;
+    NSInteger depth = 0;
+
+    NSUInteger i = 0;
+    while (i < length) {
+        unichar character = [content characterAtIndex:i];
+        BOOL endsSentence = NO;
+        if (character == '<') {
+            NSUInteger tagEnd = [self endOfSSMLTagAtIndex:i inString:content];
+            NSString *tag = [content substringWithRange:NSMakeRange(i, tagEnd - i)];
+            depth += [self depthChangeOfSSMLTag:tag];
+            NSString *tagName = [[tag stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"</> \t\r\n"]] lowercaseString];
+            endsSentence = depth == 0 && [tag hasPrefix:@"</"] && ([tagName isEqualToString:@"p"] || [tagName isEqualToString:@"s"]);
+            i = tagEnd;
+        } else {
+            endsSentence = depth == 0 && [terminatorCharacterSet characterIsMember:character];
+            i++;
+        }
+
+        if (endsSentence) {
+            while (i < length && [whitespaceCharacterSet characterIsMember:[content characterAtIndex:i]]) {
+                i++;
+            }
+            [sentences addObject:[content substringWithRange:NSMakeRange(sentenceStart, i - sentenceStart)]];
+            sentenceStart = i;
+        }
+    }
+    if (sentenceStart < length) {
+        [sentences addObject:[content substringFromIndex:sentenceStart]];
+    }
+    return sentences;
+}
+
+// Returns the index after the `>` of the tag starting at `index`, or the length of the string for an unterminated tag.
++ (NSUInteger)endOfSSMLTagAtIndex:(NSUInteger)index
+                         inString:(NSString *)string {
+    NSRange tagEndRange = [string rangeOfString:@">"
+                                        options:NSLiteralSearch
+                                          range:NSMakeRange(index, [string length] - index)];
+    return tagEndRange.location == NSNotFound ? [string length] : NSMaxRange(tagEndRange);
+}
+
++ (NSInteger)depthChangeOfSSMLTag:(NSString *)tag {
+    if ([tag hasPrefix:@"</"]) {
+        return -1;
+    }
+    if ([tag hasSuffix:@"/>"] || [tag hasPrefix:@"<!"] || [tag hasPrefix:@"<?"]) {
+        return 0;
+    }
+    return 1;
+}
+
+#pragma mark - Cache
+
+- (NSData *)cachedAudioForKey:(NSString *)key {
+    NSString *cacheDirectoryPath = self.cacheDirectoryPath;
+    if (!cacheDirectoryPath) {
+        return nil;
+    }
+
+    __block NSData *audio = nil;
+    dispatch_sync(self.cacheQueue, ^{
+        [self loadCacheIndexForDirectoryPath:cacheDirectoryPath];
+        NSString *fileName = [self cacheFileNameForKey:key];
+        if (!self.cacheFileSizes[fileName]) {
+            return;
+        }
+        NSString *filePath = [cacheDirectoryPath stringByAppendingPathComponent:fileName];
+        audio = [NSData dataWithContentsOfFile:filePath];
+        if (audio) {
+            [self.cacheFileNames removeObject:fileName];
+            [self.cacheFileNames addObject:fileName];
+            [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate : [NSDate date]}
+                                             ofItemAtPath:filePath
+                                                    error:nil];
+        } else {
+            [self removeCacheFileName:fileName];
+        }
+    });
+    return audio;
+}
+
+- (void)cacheAudio:(NSData *)audio
+            forKey:(NSString *)key {
+    NSString *cacheDirectoryPath = self.cacheDirectoryPath;
+    NSUInteger cacheCapacity = self.cacheCapacity;
+    if (!cacheDirectoryPath || [audio length] == 0 || [audio length] > cacheCapacity) {
+        return;
+    }
+
+    dispatch_async(self.cacheQueue, ^{
+        [self loadCacheIndexForDirectoryPath:cacheDirectoryPath];
+        NSString *fileName = [self cacheFileNameForKey:key];
+        [self removeCacheFileName:fileName];
+        if (![audio writeToFile:[cacheDirectoryPath stringByAppendingPathComponent:fileName] atomically:YES]) {
+            AWSDDLogError(@"Failed to write synthesized audio to %@.", cacheDirectoryPath);
+            return;
+        }
+        self.cacheFileSizes[fileName] = @([audio length]);
+        [self.cacheFileNames addObject:fileName];
+        self.cacheUsage += [audio length];
+
+        while (self.cacheUsage > cacheCapacity && [self.cacheFileNames count] > 0) {
+            [self removeCacheFileName:[self.cacheFileNames firstObject]];
+        }
+    });
+}
+
+// Must be called on `cacheQueue`. Orders the files of a previous launch by their modification date, which is updated on every use.
+- (void)loadCacheIndexForDirectoryPath:(NSString *)cacheDirectoryPath {
+    if ([self.indexedCacheDirectoryPath isEqualToString:cacheDirectoryPath]) {
+        return;
+    }
+    self.indexedCacheDirectoryPath = cacheDirectoryPath;
+    [self.cacheFileSizes removeAllObjects];
+    [self.cacheFileNames removeAllObjects];
+    self.cacheUsage = 0;
+
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSError *error = nil;
+    if (![fileManager createDirectoryAtPath:cacheDirectoryPath
+                withIntermediateDirectories:YES
+                                 attributes:nil
+                                      error:&error]) {
+        AWSDDLogError(@"Failed to create the synthesized audio cache directory %@. %@", cacheDirectoryPath, error);
+        return;
+    }
+
+    NSArray<NSURL *> *fileURLs = [fileManager contentsOfDirectoryAtURL:[NSURL fileURLWithPath:cacheDirectoryPath isDirectory:YES]
+                                            includingPropertiesForKeys:@[NSURLFileSizeKey, NSURLContentModificationDateKey]
+                                                               options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                 error:nil];
+    NSMutableDictionary<NSString *, NSDate *> *modificationDates = [NSMutableDictionary new];
+    for (NSURL *fileURL in fileURLs) {
+        NSNumber *size = nil;
+        NSDate *modificationDate = nil;
+        [fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+        [fileURL getResourceValue:&modificationDate forKey:NSURLContentModificationDateKey error:nil];
+        NSString *fileName = [fileURL lastPathComponent];
+        self.cacheFileSizes[fileName] = size ?: @0;
+        modificationDates[fileName] = modificationDate ?: [NSDate distantPast];
+        self.cacheUsage += [size unsignedIntegerValue];
+    }
+    [self.cacheFileNames addObjectsFromArray:[modificationDates keysSortedByValueUsingSelector:@selector(compare:)]];
+}
+
+// Must be called on `cacheQueue`.
+- (void)removeCacheFileName:(NSString *)fileName {
+    NSNumber *size = self.cacheFileSizes[fileName];
+    if (size) {
+        [self.cacheFileSizes removeObjectForKey:fileName];
+        [self.cacheFileNames removeObject:fileName];
+        self.cacheUsage -= [size unsignedIntegerValue];
+        [[NSFileManager defaultManager] removeItemAtPath:[self.indexedCacheDirectoryPath stringByAppendingPathComponent:fileName]
+                                                   error:nil];
+    }
+}
+
+- (NSString *)cacheFileNameForKey:(NSString *)key {
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256([keyData bytes], (CC_LONG)[keyData length], digest);
+
+    NSMutableString *fileName = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [fileName appendFormat:@"%02x", digest[i]];
+    }
+    return fileName;
+}
+
+@end
@@ -0,0 +1,271 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSPolly.h"
+
+@interface AWSPolly()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSPollySpeechSynthesizer()
+
+@property (nonatomic, strong) dispatch_queue_t cacheQueue;
+
+@end
+
+// Synthesizes the UTF-8 bytes of the text, taking a fixed time per request plus a time per character.
+@interface AWSPollySpeechSynthesizerTestPolly : AWSPolly
+
+@property (nonatomic, assign) NSTimeInterval requestLatency;
+@property (nonatomic, assign) NSTimeInterval characterLatency;
+@property (atomic, assign) NSUInteger requestCount;
+@property (atomic, assign) NSUInteger concurrentRequestCount;
+@property (atomic, assign) NSUInteger maximumConcurrentRequestCount;
+
+@end
+
+@implementation AWSPollySpeechSynthesizerTestPolly
+
+- (AWSTask<AWSPollySynthesizeSpeechOutput *> *)synthesizeSpeech:(AWSPollySynthesizeSpeechInput *)request {
+    @synchronized(self) {
+        self.requestCount++;
+        self.concurrentRequestCount++;
+        self.maximumConcurrentRequestCount = MAX(self.maximumConcurrentRequestCount, self.concurrentRequestCount);
+    }
+
+    AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource taskCompletionSource];
+    NSTimeInterval latency = self.requestLatency + self.characterLatency * [request.text length];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @synchronized(self) {
+            self.concurrentRequestCount--;
+        }
+        if ([request.text containsString:@"FAIL"]) {
+            [completionSource setError:[NSError errorWithDomain:AWSPollyErrorDomain
+                                                           code:AWSPollyErrorInvalidSsml
+                                                       userInfo:nil]];
+            return;
+        }
+        AWSPollySynthesizeSpeechOutput *output = [AWSPollySynthesizeSpeechOutput new];
+        output.audioStream = [request.text dataUsingEncoding:NSUTF8StringEncoding];
+        [completionSource setResult:output];
+    });
+    return completionSource.task;
+}
+
+@end
+
+@interface AWSPollySpeechSynthesizerTests : XCTestCase
+
+@property (nonatomic, strong) AWSPollySpeechSynthesizerTestPolly *polly;
+@property (nonatomic, strong) NSString *cacheDirectoryPath;
+
+@end
+
+@implementation AWSPollySpeechSynthesizerTests
+
+- (void)setUp {
+    [super setUp];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:nil];
+    self.polly = [[AWSPollySpeechSynthesizerTestPolly alloc] initWithConfiguration:configuration];
+    self.polly.requestLatency = 0.005;
+    self.cacheDirectoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.cacheDirectoryPath error:nil];
+    [super tearDown];
+}
+
+- (NSString *)documentOfLength:(NSUInteger)length {
+    NSMutableString *document = [NSMutableString new];
+    NSUInteger sentenceIndex = 0;
+    while ([document length] < length) {
+        [document appendFormat:@"This is sentence number %lu of the document, and it is read aloud. ", (unsigned long)sentenceIndex++];
+    }
+    return document;
+}
+
+- (AWSPollySynthesizeSpeechInput *)requestWithText:(NSString *)text {
+    AWSPollySynthesizeSpeechInput *request = [AWSPollySynthesizeSpeechInput new];
+    request.outputFormat = AWSPollyOutputFormatMp3;
+    request.voiceId = AWSPollyVoiceIdJoanna;
+    request.engine = AWSPollyEngineNeural;
+    request.text = text;
+    return request;
+}
+
+- (void)testPlainTextIsSplitAtSentences {
+    NSString *text = [self documentOfLength:5000];
+    NSArray<NSString *> *segments = [AWSPollySpeechSynthesizer segmentsOfText:text
+                                                                     textType:AWSPollyTextTypeText
+                                                                maximumLength:500];
+
+    XCTAssertGreaterThan([segments count], 10);
+    XCTAssertEqualObjects([segments componentsJoinedByString:@""], text);
+    for (NSString *segment in segments) {
+        XCTAssertLessThanOrEqual([segment length], 500);
+        XCTAssertTrue([segment hasPrefix:@"This is sentence"]);
+        XCTAssertTrue([segment hasSuffix:@"aloud. "]);
+    }
+}
+
+- (void)testLongSentenceIsSplitBetweenWords {
+    NSString *text = [@"" stringByPaddingToLength:1000 withString:@"word " startingAtIndex:0];
+    NSArray<NSString *> *segments = [AWSPollySpeechSynthesizer segmentsOfText:text
+                                                                     textType:AWSPollyTextTypeText
+                                                                maximumLength:96];
+
+    XCTAssertEqualObjects([segments componentsJoinedByString:@""], text);
+    for (NSString *segment in segments) {
+        XCTAssertLessThanOrEqual([segment length], 96);
+        XCTAssertTrue([segment hasSuffix:@" "]);
+    }
+}
+
+- (void)testSSMLIsSplitOutsideOfElements {
+    NSString *text = @"<speak xml:lang=\"en-US\"><p>First paragraph.</p><p>Second paragraph.</p>"
+                     @"<prosody rate=\"slow\">One. Two. Three.</prosody> Last sentence.</speak>";
+    NSArray<NSString *> *segments = [AWSPollySpeechSynthesizer segmentsOfText:text
+                                                                     textType:AWSPollyTextTypeSsml
+                                                                maximumLength:94];
+
+    NSArray<NSString *> *expectedSegments = @[@"<speak xml:lang=\"en-US\"><p>First paragraph.</p><p>Second paragraph.</p></speak>",
+                                              @"<speak xml:lang=\"en-US\"><prosody rate=\"slow\">One. Two. Three.</prosody> Last sentence.</speak>"];
+    XCTAssertEqualObjects(segments, expectedSegments);
+}
+
+- (void)testChunksAreDeliveredInOrderWithBoundedConcurrency {
+    // Later segments are shorter, so they finish first.
+    NSMutableString *text = [NSMutableString new];
+    for (NSUInteger i = 0; i < 20; i++) {
+        [text appendString:[@"" stringByPaddingToLength:(20 - i) * 10 withString:@"a" startingAtIndex:0]];
+        [text appendString:@". "];
+    }
+    self.polly.characterLatency = 0.0001;
+    AWSPollySpeechSynthesizer *synthesizer = [[AWSPollySpeechSynthesizer alloc] initWithPolly:self.polly];
+    synthesizer.maximumSegmentLength = 210;
+    synthesizer.maximumConcurrentRequests = 3;
+
+    NSMutableData *audio = [NSMutableData new];
+    NSMutableArray<NSNumber *> *indexes = [NSMutableArray new];
+    AWSTask<NSNumber *> *task = [[synthesizer synthesizeSpeech:[self requestWithText:text]
+                                             audioChunkHandler:^(NSData *audioChunk, NSUInteger index, NSUInteger count) {
+        [audio appendData:audioChunk];
+        [indexes addObject:@(index)];
+        XCTAssertEqual(count, 20);
+    }] waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqualObjects(task.result, @20);
+    XCTAssertEqual([indexes count], 20);
+    for (NSUInteger i = 0; i < [indexes count]; i++) {
+        XCTAssertEqualObjects(indexes[i], @(i));
+    }
+    XCTAssertEqualObjects(audio, [text dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertEqual(self.polly.requestCount, 20);
+    XCTAssertLessThanOrEqual(self.polly.maximumConcurrentRequestCount, 3);
+    XCTAssertGreaterThan(self.polly.maximumConcurrentRequestCount, 1);
+}
+
+- (void)testNoChunkIsDeliveredAfterFailedSegment {
+    NSString *text = @"First sentence. Second sentence. FAIL sentence. Last sentence.";
+    AWSPollySpeechSynthesizer *synthesizer = [[AWSPollySpeechSynthesizer alloc] initWithPolly:self.polly];
+    synthesizer.maximumSegmentLength = 20;
+
+    NSMutableArray<NSNumber *> *indexes = [NSMutableArray new];
+    AWSTask<NSNumber *> *task = [[synthesizer synthesizeSpeech:[self requestWithText:text]
+                                             audioChunkHandler:^(NSData *audioChunk, NSUInteger index, NSUInteger count) {
+        [indexes addObject:@(index)];
+    }] waitUntilFinished];
+
+    XCTAssertEqualObjects(task.error.domain, AWSPollyErrorDomain);
+    XCTAssertNil(task.result);
+    for (NSNumber *index in indexes) {
+        XCTAssertLessThan([index unsignedIntegerValue], 2);
+    }
+}
+
+- (void)testRepeatedSegmentsAreCached {
+    NSString *text = [self documentOfLength:3000];
+    AWSPollySpeechSynthesizer *synthesizer = [[AWSPollySpeechSynthesizer alloc] initWithPolly:self.polly];
+    synthesizer.maximumSegmentLength = 500;
+    synthesizer.cacheDirectoryPath = self.cacheDirectoryPath;
+
+    NSMutableData *audio = [NSMutableData new];
+    XCTAssertNil([[synthesizer synthesizeSpeech:[self requestWithText:text]
+                              audioChunkHandler:^(NSData *audioChunk, NSUInteger index, NSUInteger count) {
+        [audio appendData:audioChunk];
+    }] waitUntilFinished].error);
+    NSUInteger requestCount = self.polly.requestCount;
+
+    // A new synthesizer reads the cache of the previous one.
+    AWSPollySpeechSynthesizer *cachedSynthesizer = [[AWSPollySpeechSynthesizer alloc] initWithPolly:self.polly];
+    cachedSynthesizer.maximumSegmentLength = 500;
+    cachedSynthesizer.cacheDirectoryPath = self.cacheDirectoryPath;
+    // Wait for the previous synthesizer to write the audio it has cached.
+    dispatch_sync(synthesizer.cacheQueue, ^{});
+
+    NSMutableData *cachedAudio = [NSMutableData new];
+    XCTAssertNil([[cachedSynthesizer synthesizeSpeech:[self requestWithText:text]
+                                    audioChunkHandler:^(NSData *audioChunk, NSUInteger index, NSUInteger count) {
+        [cachedAudio appendData:audioChunk];
+    }] waitUntilFinished].error);
+    XCTAssertEqual(self.polly.requestCount, requestCount);
+    XCTAssertEqualObjects(cachedAudio, audio);
+
+    // Another voice is not cached.
+    AWSPollySynthesizeSpeechInput *request = [self requestWithText:text];
+    request.voiceId = AWSPollyVoiceIdMatthew;
+    XCTAssertNil([[cachedSynthesizer synthesizeSpeech:request
+                                    audioChunkHandler:^(NSData *audioChunk, NSUInteger index, NSUInteger count) {
+    }] waitUntilFinished].error);
+    XCTAssertEqual(self.polly.requestCount, requestCount * 2);
+}
+
+- (void)testStreamingSynthesisLatency {
+    NSString *text = [self documentOfLength:20000];
+    self.polly.requestLatency = 0.05;
+    self.polly.characterLatency = 0.0002;
+
+    // One request per 3000 characters, one after the other, is what synthesizing the document with `- synthesizeSpeech:` costs at best.
+    NSArray<NSNumber *> *maximumSegmentLengths = @[@3000, @(AWSPollySpeechSynthesizerDefaultMaximumSegmentLength), @500];
+    NSArray<NSNumber *> *maximumConcurrentRequests = @[@1, @(AWSPollySpeechSynthesizerDefaultMaximumConcurrentRequests), @(AWSPollySpeechSynthesizerDefaultMaximumConcurrentRequests)];
+    for (NSUInteger i = 0; i < [maximumSegmentLengths count]; i++) {
+        AWSPollySpeechSynthesizer *synthesizer = [[AWSPollySpeechSynthesizer alloc] initWithPolly:self.polly];
+        synthesizer.maximumSegmentLength = [maximumSegmentLengths[i] unsignedIntegerValue];
+        synthesizer.maximumConcurrentRequests = [maximumConcurrentRequests[i] unsignedIntegerValue];
+
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        __block CFAbsoluteTime firstChunkTime = 0;
+        AWSTask<NSNumber *> *task = [[synthesizer synthesizeSpeech:[self requestWithText:text]
+                                                 audioChunkHandler:^(NSData *audioChunk, NSUInteger index, NSUInteger count) {
+            if (index == 0) {
+                firstChunkTime = CFAbsoluteTimeGetCurrent();
+            }
+        }] waitUntilFinished];
+        CFAbsoluteTime totalTime = CFAbsoluteTimeGetCurrent() - start;
+        XCTAssertNil(task.error);
+
+        NSLog(@"Synthesized %lu characters in %@ segments of up to %@ characters, %@ at a time: first chunk after %.0f ms, total %.0f ms",
+              (unsigned long)[text length], task.result, maximumSegmentLengths[i], maximumConcurrentRequests[i],
+              (firstChunkTime - start) * 1000, totalTime * 1000);
+    }
+}
+
+@end
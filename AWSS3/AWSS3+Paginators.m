@@ -0,0 +1,30 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSS3+Paginators.h"
+
+@implementation AWSS3 (Paginators)
+
+- (AWSPaginator *)listObjectsV2Paginator:(AWSS3ListObjectsV2Request *)request {
+    return [AWSPaginator paginatorWithRequest:request
+                                inputTokenKey:@"continuationToken"
+                               outputTokenKey:@"nextContinuationToken"
+                                    resultKey:@"contents"
+                                    operation:^AWSTask *(AWSS3ListObjectsV2Request *pageRequest) {
+        return [self listObjectsV2:pageRequest];
+    }];
+}
+
+@end
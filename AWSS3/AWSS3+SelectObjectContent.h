@@ -0,0 +1,47 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSS3Service.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface AWSS3 (SelectObjectContent)
+
+/**
+ Runs a `SelectObjectContent` request and hands out its events as they arrive, instead of buffering the whole response.
+
+ The response is decoded incrementally with `AWSS3EventStreamDecoder`, so memory use is bounded by the largest event,
+ not by the size of the result. Each event is passed to `eventHandler` with exactly one of `records`, `stats`,
+ `progress`, `cont` or `end` set. The `payload` of a records event is only valid until `eventHandler` returns; copy it
+ to keep it. Events are delivered in order, on a background thread.
+
+ @param request       A container for the necessary parameters to execute the SelectObjectContent service method.
+ @param eventHandler  Called for every event of the response.
+
+ @return An instance of `AWSTask` that completes after the last event. On successful execution, `task.result` will contain
+ an instance of `AWSS3SelectObjectContentOutput` whose `payload` is `nil`. An error event fails the task with an error in
+ `AWSS3ErrorDomain` whose `userInfo` holds its `Code` and `Message`; a malformed or truncated response fails it with an
+ error in `AWSS3EventStreamErrorDomain`.
+
+ @see AWSS3SelectObjectContentRequest
+ @see AWSS3SelectObjectContentEventStream
+ */
+- (AWSTask<AWSS3SelectObjectContentOutput *> *)selectObjectContent:(AWSS3SelectObjectContentRequest *)request
+                                                      eventHandler:(void (^)(AWSS3SelectObjectContentEventStream *event))eventHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
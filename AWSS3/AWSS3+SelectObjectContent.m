@@ -0,0 +1,149 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSS3+SelectObjectContent.h"
+#import "AWSS3EventStreamDecoder.h"
+#import <AWSCore/AWSXMLDictionary.h>
+
+static NSString *const AWSS3EventStreamMessageTypeHeader = @":message-type";
+static NSString *const AWSS3EventStreamEventTypeHeader = @":event-type";
+static NSString *const AWSS3EventStreamErrorCodeHeader = @":error-code";
+static NSString *const AWSS3EventStreamErrorMessageHeader = @":error-message";
+
+@interface AWSS3SelectObjectContentStreamState : NSObject
+
+@property (nonatomic, strong) AWSS3EventStreamDecoder *decoder;
+@property (nonatomic, strong) NSError *error;
+@property (nonatomic, assign) BOOL receivedEnd;
+
+@end
+
+@implementation AWSS3SelectObjectContentStreamState
+
+@end
+
+@implementation AWSS3 (SelectObjectContent)
+
+- (AWSTask<AWSS3SelectObjectContentOutput *> *)selectObjectContent:(AWSS3SelectObjectContentRequest *)request
+                                                      eventHandler:(void (^)(AWSS3SelectObjectContentEventStream *event))eventHandler {
+    AWSS3SelectObjectContentStreamState *state = [AWSS3SelectObjectContentStreamState new];
+    __weak AWSS3SelectObjectContentStreamState *weakState = state;
+    __weak AWSS3SelectObjectContentRequest *weakRequest = request;
+
+    // The decoder only ever runs on the delegate queue of the session, one piece of the body at a time. The state owns
+    // the decoder, so the message handler only holds on to the state weakly.
+    state.decoder = [[AWSS3EventStreamDecoder alloc] initWithMessageHandler:^(NSDictionary<NSString *, id> *headers, NSData *payload) {
+        AWSS3SelectObjectContentStreamState *state = weakState;
+        if (!state || state.error) {
+            return;
+        }
+        NSString *messageType = headers[AWSS3EventStreamMessageTypeHeader];
+        if ([messageType isEqualToString:@"error"]) {
+            NSMutableDictionary *userInfo = [NSMutableDictionary new];
+            userInfo[@"Code"] = headers[AWSS3EventStreamErrorCodeHeader];
+            userInfo[@"Message"] = headers[AWSS3EventStreamErrorMessageHeader];
+            state.error = [NSError errorWithDomain:AWSS3ErrorDomain
+                                              code:AWSS3ErrorUnknown
+                                          userInfo:userInfo];
+            [weakRequest cancel];
+            return;
+        }
+        if (![messageType isEqualToString:@"event"]) {
+            return;
+        }
+
+        AWSS3SelectObjectContentEventStream *event = [AWSS3 aws_selectObjectContentEventWithType:headers[AWSS3EventStreamEventTypeHeader]
+                                                                                         payload:payload];
+        if (event.end) {
+            state.receivedEnd = YES;
+        }
+        if (event && eventHandler) {
+            eventHandler(event);
+        }
+    }];
+
+    request.responseDataHandler = ^(NSData *data) {
+        if (state.error) {
+            return;
+        }
+        NSError *error = nil;
+        if (![state.decoder appendData:data error:&error]) {
+            state.error = error;
+            [weakRequest cancel];
+        }
+    };
+
+    return [[self selectObjectContent:request] continueWithBlock:^id _Nullable(AWSTask<AWSS3SelectObjectContentOutput *> *task) {
+        // The request may outlive the call; release the decoder, its buffered data and the event handler now.
+        BOOL isAtMessageBoundary = state.decoder.isAtMessageBoundary;
+        state.decoder = nil;
+
+        if (state.error) {
+            return [AWSTask taskWithError:state.error];
+        }
+        if (task.error) {
+            return task;
+        }
+        if (!state.receivedEnd || !isAtMessageBoundary) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3EventStreamErrorDomain
+                                                              code:AWSS3EventStreamErrorIncompleteMessage
+                                                          userInfo:@{NSLocalizedDescriptionKey : @"The response ended before the End event."}]];
+        }
+        return task;
+    }];
+}
+
++ (AWSS3SelectObjectContentEventStream *)aws_selectObjectContentEventWithType:(NSString *)eventType
+                                                                      payload:(NSData *)payload {
+    AWSS3SelectObjectContentEventStream *event = [AWSS3SelectObjectContentEventStream new];
+    if ([eventType isEqualToString:@"Records"]) {
+        event.records = [AWSS3RecordsEvent new];
+        event.records.payload = payload;
+    } else if ([eventType isEqualToString:@"Stats"]) {
+        NSDictionary *details = [[AWSXMLDictionaryParser sharedInstance] dictionaryWithData:payload];
+        AWSS3Stats *stats = [AWSS3Stats new];
+        stats.bytesScanned = [self aws_numberForKey:@"BytesScanned" inDictionary:details];
+        stats.bytesProcessed = [self aws_numberForKey:@"BytesProcessed" inDictionary:details];
+        stats.bytesReturned = [self aws_numberForKey:@"BytesReturned" inDictionary:details];
+        event.stats = [AWSS3StatsEvent new];
+        event.stats.details = stats;
+    } else if ([eventType isEqualToString:@"Progress"]) {
+        NSDictionary *details = [[AWSXMLDictionaryParser sharedInstance] dictionaryWithData:payload];
+        AWSS3Progress *progress = [AWSS3Progress new];
+        progress.bytesScanned = [self aws_numberForKey:@"BytesScanned" inDictionary:details];
+        progress.bytesProcessed = [self aws_numberForKey:@"BytesProcessed" inDictionary:details];
+        progress.bytesReturned = [self aws_numberForKey:@"BytesReturned" inDictionary:details];
+        event.progress = [AWSS3ProgressEvent new];
+        event.progress.details = progress;
+    } else if ([eventType isEqualToString:@"Cont"]) {
+        event.cont = [AWSS3ContinuationEvent new];
+    } else if ([eventType isEqualToString:@"End"]) {
+        event.end = [AWSS3EndEvent new];
+    } else {
+        // Unknown events are skipped, as new event types may be added to the stream.
+        return nil;
+    }
+    return event;
+}
+
++ (NSNumber *)aws_numberForKey:(NSString *)key inDictionary:(NSDictionary *)dictionary {
+    id value = dictionary[key];
+    if ([value isKindOfClass:[NSString class]]) {
+        return @([value longLongValue]);
+    }
+    return nil;
+}
+
+@end
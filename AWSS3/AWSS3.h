@@ -40,5 +40,8 @@ FOUNDATION_EXPORT const unsigned char AWSS3VersionString[] DEPRECATED_MSG_ATTRIB
 
 #import <AWSCore/AWSCore.h>
 #import "AWSS3Service.h"
+#import "AWSS3+Paginators.h"
+#import "AWSS3EventStreamDecoder.h"
+#import "AWSS3+SelectObjectContent.h"
 #import "AWSS3PreSignedURL.h"
 #import "AWSS3TransferUtility.h"
@@ -0,0 +1,88 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString *const AWSS3EventStreamErrorDomain;
+typedef NS_ENUM(NSInteger, AWSS3EventStreamErrorType) {
+    AWSS3EventStreamErrorUnknown,
+    AWSS3EventStreamErrorPreludeChecksumMismatch,
+    AWSS3EventStreamErrorMessageChecksumMismatch,
+    AWSS3EventStreamErrorInvalidMessageLength,
+    AWSS3EventStreamErrorInvalidHeader,
+    AWSS3EventStreamErrorIncompleteMessage,
+};
+
+/**
+ The largest message the decoder accepts, 16MB.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSS3EventStreamMaximumMessageLength;
+
+/**
+ Called for every decoded message.
+
+ @param headers The headers of the message. Values are `NSNumber` for booleans and integers, `NSString`, `NSData`,
+                `NSDate` for timestamps and `NSUUID`.
+ @param payload The payload of the message. To avoid a copy it may point into the data passed to `appendData:error:`,
+                and it is only valid until the block returns. Copy it to keep it.
+ */
+typedef void (^AWSS3EventStreamMessageHandler)(NSDictionary<NSString *, id> *headers, NSData *payload);
+
+/**
+ An incremental decoder for the `application/vnd.amazon.eventstream` format used by `SelectObjectContent`.
+
+ Data is appended as it arrives and messages are handed to the handler as soon as they are complete. The prelude CRC
+ of every message is checked before its length is trusted, and the message CRC before the message is handed out.
+ Messages contained in one appended piece of data are decoded in place; only a message that spans two pieces is
+ buffered, so memory use is bounded by the largest message, not by the length of the stream.
+ */
+@interface AWSS3EventStreamDecoder : NSObject
+
+/**
+ The number of bytes of an incomplete message currently buffered.
+ */
+@property (nonatomic, assign, readonly) NSUInteger bufferedLength;
+
+/**
+ `YES` when no partial message is buffered, i.e. the data so far ended on a message boundary.
+ */
+@property (nonatomic, assign, readonly, getter=isAtMessageBoundary) BOOL atMessageBoundary;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a decoder.
+
+ @param messageHandler Called on the thread calling `appendData:error:` for every decoded message, in order.
+
+ @return A decoder.
+ */
+- (instancetype)initWithMessageHandler:(AWSS3EventStreamMessageHandler)messageHandler NS_DESIGNATED_INITIALIZER;
+
+/**
+ Decodes the given data.
+
+ @param data  The next piece of the stream.
+ @param error Set to an error in `AWSS3EventStreamErrorDomain` when the data is not a valid event stream.
+
+ @return `NO` if the stream is invalid. The decoder rejects all data after an error.
+ */
+- (BOOL)appendData:(NSData *)data error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
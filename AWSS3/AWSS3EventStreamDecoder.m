@@ -0,0 +1,312 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSS3EventStreamDecoder.h"
+#import <zlib.h>
+
+NSString *const AWSS3EventStreamErrorDomain = @"com.amazonaws.AWSS3EventStreamErrorDomain";
+NSUInteger const AWSS3EventStreamMaximumMessageLength = 16 * 1024 * 1024;
+
+// Every message starts with its total length, the length of its headers and a CRC of those two fields, and ends with a
+// CRC of everything before it.
+static NSUInteger const AWSS3EventStreamPreludeLength = 12;
+static NSUInteger const AWSS3EventStreamChecksumLength = 4;
+
+typedef NS_ENUM(uint8_t, AWSS3EventStreamHeaderType) {
+    AWSS3EventStreamHeaderTypeBoolTrue = 0,
+    AWSS3EventStreamHeaderTypeBoolFalse = 1,
+    AWSS3EventStreamHeaderTypeByte = 2,
+    AWSS3EventStreamHeaderTypeShort = 3,
+    AWSS3EventStreamHeaderTypeInteger = 4,
+    AWSS3EventStreamHeaderTypeLong = 5,
+    AWSS3EventStreamHeaderTypeByteArray = 6,
+    AWSS3EventStreamHeaderTypeString = 7,
+    AWSS3EventStreamHeaderTypeTimestamp = 8,
+    AWSS3EventStreamHeaderTypeUUID = 9,
+};
+
+static uint16_t AWSS3EventStreamReadUInt16(const uint8_t *bytes) {
+    return (uint16_t)(((uint16_t)bytes[0] << 8) | bytes[1]);
+}
+
+static uint32_t AWSS3EventStreamReadUInt32(const uint8_t *bytes) {
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | bytes[3];
+}
+
+static uint64_t AWSS3EventStreamReadUInt64(const uint8_t *bytes) {
+    return ((uint64_t)AWSS3EventStreamReadUInt32(bytes) << 32) | AWSS3EventStreamReadUInt32(bytes + 4);
+}
+
+static NSError *AWSS3EventStreamError(AWSS3EventStreamErrorType code, NSString *description) {
+    return [NSError errorWithDomain:AWSS3EventStreamErrorDomain
+                               code:code
+                           userInfo:@{NSLocalizedDescriptionKey : description}];
+}
+
+@interface AWSS3EventStreamDecoder()
+
+@property (nonatomic, copy) AWSS3EventStreamMessageHandler messageHandler;
+// The start of a message that continues in the next piece of data.
+@property (nonatomic, strong) NSMutableData *buffer;
+// The length of the buffered message, once its prelude has been read and checked.
+@property (nonatomic, assign) NSUInteger bufferedMessageLength;
+@property (nonatomic, strong) NSError *streamError;
+
+@end
+
+@implementation AWSS3EventStreamDecoder
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithMessageHandler:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithMessageHandler:(AWSS3EventStreamMessageHandler)messageHandler {
+    if (self = [super init]) {
+        _messageHandler = messageHandler;
+        _buffer = [NSMutableData new];
+    }
+    return self;
+}
+
+- (NSUInteger)bufferedLength {
+    return self.buffer.length;
+}
+
+- (BOOL)isAtMessageBoundary {
+    return self.buffer.length == 0;
+}
+
+- (BOOL)appendData:(NSData *)data error:(NSError **)error {
+    if (!self.streamError) {
+        __block NSError *decodingError = nil;
+        [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+            if (![self appendBytes:bytes length:byteRange.length error:&decodingError]) {
+                *stop = YES;
+            }
+        }];
+        if (decodingError) {
+            self.streamError = decodingError;
+            self.buffer = nil;
+        }
+    }
+
+    if (self.streamError) {
+        if (error) {
+            *error = self.streamError;
+        }
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)appendBytes:(const uint8_t *)bytes length:(NSUInteger)length error:(NSError **)error {
+    NSUInteger offset = 0;
+
+    // Complete the message started by the previous piece first.
+    while (self.buffer.length > 0 && offset < length) {
+        NSUInteger wantedLength = self.bufferedMessageLength > 0 ? self.bufferedMessageLength : AWSS3EventStreamPreludeLength;
+        NSUInteger count = MIN(wantedLength - self.buffer.length, length - offset);
+        [self.buffer appendBytes:bytes + offset length:count];
+        offset += count;
+        if (self.buffer.length < wantedLength) {
+            return YES;
+        }
+
+        if (self.bufferedMessageLength == 0) {
+            NSUInteger messageLength = 0;
+            if (![self readPrelude:self.buffer.bytes messageLength:&messageLength error:error]) {
+                return NO;
+            }
+            self.bufferedMessageLength = messageLength;
+        } else {
+            if (![self decodeMessage:self.buffer.bytes length:self.bufferedMessageLength error:error]) {
+                return NO;
+            }
+            self.buffer.length = 0;
+            self.bufferedMessageLength = 0;
+        }
+    }
+
+    // Decode the messages contained in this piece in place.
+    while (length - offset >= AWSS3EventStreamPreludeLength) {
+        NSUInteger messageLength = 0;
+        if (![self readPrelude:bytes + offset messageLength:&messageLength error:error]) {
+            return NO;
+        }
+        if (length - offset < messageLength) {
+            self.bufferedMessageLength = messageLength;
+            break;
+        }
+        if (![self decodeMessage:bytes + offset length:messageLength error:error]) {
+            return NO;
+        }
+        offset += messageLength;
+    }
+
+    if (offset < length) {
+        [self.buffer appendBytes:bytes + offset length:length - offset];
+    }
+    return YES;
+}
+
+- (BOOL)readPrelude:(const uint8_t *)bytes messageLength:(NSUInteger *)messageLength error:(NSError **)error {
+    uint32_t totalLength = AWSS3EventStreamReadUInt32(bytes);
+    uint32_t headersLength = AWSS3EventStreamReadUInt32(bytes + 4);
+    uint32_t preludeChecksum = AWSS3EventStreamReadUInt32(bytes + 8);
+
+    if (crc32(0, bytes, 8) != preludeChecksum) {
+        *error = AWSS3EventStreamError(AWSS3EventStreamErrorPreludeChecksumMismatch, @"The prelude checksum of the message does not match.");
+        return NO;
+    }
+    if (totalLength < AWSS3EventStreamPreludeLength + AWSS3EventStreamChecksumLength
+        || totalLength > AWSS3EventStreamMaximumMessageLength
+        || headersLength > totalLength - AWSS3EventStreamPreludeLength - AWSS3EventStreamChecksumLength) {
+        *error = AWSS3EventStreamError(AWSS3EventStreamErrorInvalidMessageLength,
+                                       [NSString stringWithFormat:@"Invalid message length %u with headers length %u.", totalLength, headersLength]);
+        return NO;
+    }
+
+    *messageLength = totalLength;
+    return YES;
+}
+
+- (BOOL)decodeMessage:(const uint8_t *)bytes length:(NSUInteger)length error:(NSError **)error {
+    uint32_t messageChecksum = AWSS3EventStreamReadUInt32(bytes + length - AWSS3EventStreamChecksumLength);
+    if (crc32(0, bytes, (uInt)(length - AWSS3EventStreamChecksumLength)) != messageChecksum) {
+        *error = AWSS3EventStreamError(AWSS3EventStreamErrorMessageChecksumMismatch, @"The checksum of the message does not match.");
+        return NO;
+    }
+
+    NSUInteger headersLength = AWSS3EventStreamReadUInt32(bytes + 4);
+    NSDictionary<NSString *, id> *headers = [self headersFromBytes:bytes + AWSS3EventStreamPreludeLength length:headersLength error:error];
+    if (!headers) {
+        return NO;
+    }
+
+    const uint8_t *payloadBytes = bytes + AWSS3EventStreamPreludeLength + headersLength;
+    NSUInteger payloadLength = length - AWSS3EventStreamPreludeLength - headersLength - AWSS3EventStreamChecksumLength;
+    NSData *payload = [[NSData alloc] initWithBytesNoCopy:(void *)payloadBytes length:payloadLength freeWhenDone:NO];
+    self.messageHandler(headers, payload);
+    return YES;
+}
+
+- (NSDictionary<NSString *, id> *)headersFromBytes:(const uint8_t *)bytes length:(NSUInteger)length error:(NSError **)error {
+    NSMutableDictionary<NSString *, id> *headers = [NSMutableDictionary new];
+    NSUInteger offset = 0;
+
+    while (offset < length) {
+        NSUInteger nameLength = bytes[offset++];
+        // The name, then the type.
+        if (nameLength == 0 || length - offset < nameLength + 1) {
+            break;
+        }
+        NSString *name = [[NSString alloc] initWithBytes:bytes + offset length:nameLength encoding:NSUTF8StringEncoding];
+        offset += nameLength;
+        AWSS3EventStreamHeaderType type = bytes[offset++];
+
+        NSUInteger valueLength = 0;
+        switch (type) {
+            case AWSS3EventStreamHeaderTypeBoolTrue:
+            case AWSS3EventStreamHeaderTypeBoolFalse:
+                valueLength = 0;
+                break;
+            case AWSS3EventStreamHeaderTypeByte:
+                valueLength = 1;
+                break;
+            case AWSS3EventStreamHeaderTypeShort:
+                valueLength = 2;
+                break;
+            case AWSS3EventStreamHeaderTypeInteger:
+                valueLength = 4;
+                break;
+            case AWSS3EventStreamHeaderTypeLong:
+            case AWSS3EventStreamHeaderTypeTimestamp:
+                valueLength = 8;
+                break;
+            case AWSS3EventStreamHeaderTypeUUID:
+                valueLength = 16;
+                break;
+            case AWSS3EventStreamHeaderTypeByteArray:
+            case AWSS3EventStreamHeaderTypeString:
+                if (length - offset < 2) {
+                    valueLength = NSUIntegerMax;
+                    break;
+                }
+                valueLength = AWSS3EventStreamReadUInt16(bytes + offset);
+                offset += 2;
+                break;
+            default:
+                valueLength = NSUIntegerMax;
+                break;
+        }
+        if (valueLength > length - offset) {
+            name = nil;
+        }
+
+        id value = nil;
+        const uint8_t *valueBytes = bytes + offset;
+        if (name) {
+            switch (type) {
+                case AWSS3EventStreamHeaderTypeBoolTrue:
+                    value = @YES;
+                    break;
+                case AWSS3EventStreamHeaderTypeBoolFalse:
+                    value = @NO;
+                    break;
+                case AWSS3EventStreamHeaderTypeByte:
+                    value = @((int8_t)valueBytes[0]);
+                    break;
+                case AWSS3EventStreamHeaderTypeShort:
+                    value = @((int16_t)AWSS3EventStreamReadUInt16(valueBytes));
+                    break;
+                case AWSS3EventStreamHeaderTypeInteger:
+                    value = @((int32_t)AWSS3EventStreamReadUInt32(valueBytes));
+                    break;
+                case AWSS3EventStreamHeaderTypeLong:
+                    value = @((int64_t)AWSS3EventStreamReadUInt64(valueBytes));
+                    break;
+                case AWSS3EventStreamHeaderTypeByteArray:
+                    value = [NSData dataWithBytes:valueBytes length:valueLength];
+                    break;
+                case AWSS3EventStreamHeaderTypeString:
+                    value = [[NSString alloc] initWithBytes:valueBytes length:valueLength encoding:NSUTF8StringEncoding];
+                    break;
+                case AWSS3EventStreamHeaderTypeTimestamp:
+                    value = [NSDate dateWithTimeIntervalSince1970:(int64_t)AWSS3EventStreamReadUInt64(valueBytes) / 1000.0];
+                    break;
+                case AWSS3EventStreamHeaderTypeUUID:
+                    value = [[NSUUID alloc] initWithUUIDBytes:valueBytes];
+                    break;
+            }
+        }
+        if (!name || !value) {
+            break;
+        }
+
+        headers[name] = value;
+        offset += valueLength;
+    }
+
+    if (offset != length) {
+        *error = AWSS3EventStreamError(AWSS3EventStreamErrorInvalidHeader, @"The headers of the message are malformed.");
+        return nil;
+    }
+    return headers;
+}
+
+@end
@@ -196,6 +196,15 @@ typedef NS_ENUM(NSInteger, AWSS3PresignedURLErrorType) {
  */
 - (AWSTask<NSURL *> *)getPreSignedURL:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest;
 
+/**
+ Build time-limited pre-signed URLs for many requests at once. The credentials are resolved once, and the URLs are signed for the same date, sharing the signing key of their region, so this is much faster than calling `- getPreSignedURL:` for every request.
+
+ @param getPreSignedURLRequests The AWSS3GetPreSignedURLRequest objects that define the parameters of the URLs.
+ @return The pre-signed NSURL objects, in the order of the requests. The task fails with the error of the first invalid request, and then no URL is built.
+ @see AWSS3GetPreSignedURLRequest
+ */
+- (AWSTask<NSArray<NSURL *> *> *)getPreSignedURLs:(NSArray<AWSS3GetPreSignedURLRequest *> *)getPreSignedURLRequests;
+
 @end
 
 /** The GetPreSignedURLRequest contains the parameters used to create
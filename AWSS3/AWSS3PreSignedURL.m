@@ -153,101 +153,14 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 }
 
 - (AWSTask<NSURL *> *)getPreSignedURL:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest {
-    //retrive parameters from request;
-    NSString *bucketName = getPreSignedURLRequest.bucket;
-    NSString *keyName = getPreSignedURLRequest.key;
     AWSHTTPMethod httpMethod = getPreSignedURLRequest.HTTPMethod;
-    AWSServiceConfiguration *configuration = self.configuration;
-    id<AWSCredentialsProvider>credentialsProvider = configuration.credentialsProvider;
-    AWSEndpoint *endpoint = self.configuration.endpoint;
-    BOOL isAccelerateModeEnabled = getPreSignedURLRequest.isAccelerateModeEnabled;
-
+    id<AWSCredentialsProvider>credentialsProvider = self.configuration.credentialsProvider;
     NSDate *expires = getPreSignedURLRequest.expires;
 
     return [[[AWSTask taskWithResult:nil] continueWithBlock:^id(AWSTask *task) {
-
-        //validate additionalParams
-        for (id key in getPreSignedURLRequest.requestParameters) {
-            id value = getPreSignedURLRequest.requestParameters[key];
-            if (![key isKindOfClass:[NSString class]]
-                || ![value isKindOfClass:[NSString class]]) {
-                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                                  code:AWSS3PresignedURLErrorInvalidRequestParameters
-                                                              userInfo:@{NSLocalizedDescriptionKey: @"requestParameters can only contain key-value pairs in NSString type."}]
-                        ];
-            }
-        }
-
-        //validate endpoint
-        if (!endpoint) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorEndpointIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"endpoint in configuration can not be nil"}]
-                    ];
-        } else if (endpoint.serviceType != AWSServiceS3) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidServiceType
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"Invalid serviceType: serviceType in endpoint must be AWSServiceS3"}]
-                    ];
-        }
-
-        //validate credentialsProvider
-        if (!credentialsProvider) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PreSignedURLErrorCredentialProviderIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"credentialsProvider in configuration can not be nil"}]
-                    ];
-        }
-
-        //validate bucketName
-        if (!bucketName || [bucketName length] < 1) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorBucketNameIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"S3 bucket can not be nil or empty"}]];
-        }
-
-        // Validates the buket name for transfer acceleration.
-        if (isAccelerateModeEnabled && ![bucketName aws_isVirtualHostedStyleCompliant]) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidBucketNameForAccelerateModeEnabled
-                                                          userInfo:@{
-                                                                     NSLocalizedDescriptionKey: @"For your bucket to work with transfer acceleration, the bucket name must conform to DNS naming requirements and must not contain periods."}]];
-        }
-
-        //validate keyName
-        if (!keyName || [keyName length] < 1) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorKeyNameIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"S3 key can not be nil or empty"}]
-                    ];
-        }
-
-        //validate expires Date
-        if (!expires) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidExpiresDate
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"expires can not be nil"}]
-                    ];
-        }else if ([expires timeIntervalSinceNow] < 0.0) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidExpiresDate
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"expires can not be in past"}]
-                    ];
-        }
-
-        //validate httpMethod
-        switch (httpMethod) {
-            case AWSHTTPMethodGET:
-            case AWSHTTPMethodPUT:
-            case AWSHTTPMethodHEAD:
-            case AWSHTTPMethodDELETE:
-                break;
-            default:
-                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                                  code:AWSS3PresignedURLErrorUnsupportedHTTPVerbs
-                                                              userInfo:@{NSLocalizedDescriptionKey: @"unsupported HTTP Method, currently only support AWSHTTPMethodGET, AWSHTTPMethodPUT, AWSHTTPMethodHEAD, AWSHTTPMethodDELETE"}]
-                        ];
-                break;
+        NSError *error = [self validateGetPreSignedURLRequest:getPreSignedURLRequest];
+        if (error) {
+            return [AWSTask taskWithError:error];
         }
 
         return [[credentialsProvider credentials] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
@@ -259,50 +172,10 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             return credentialsProvider;
         }];
     }] continueWithSuccessBlock:^id _Nullable(AWSTask * _Nonnull task) {
-        //generate baseURL String (use virtualHostStyle if possible)
-        //base url is not url encoded.
         NSString *keyPath = nil;
-        if (bucketName == nil || [bucketName aws_isVirtualHostedStyleCompliant]) {
-            keyPath = (keyName == nil ? @"" : [NSString stringWithFormat:@"%@", [keyName aws_stringWithURLEncodingPath]]);
-        } else {
-            keyPath = (keyName == nil ? [NSString stringWithFormat:@"%@", bucketName] : [NSString stringWithFormat:@"%@/%@", bucketName, [keyName aws_stringWithURLEncodingPath]]);
-        }
-
-        //generate correct hostName (use virtualHostStyle if possible)
-        NSString *host = nil;
-        if (!self.configuration.localTestingEnabled &&
-            bucketName &&
-            [bucketName aws_isVirtualHostedStyleCompliant]) {
-            if (isAccelerateModeEnabled) {
-                host = [NSString stringWithFormat:@"%@.%@", bucketName, AWSS3PreSignedURLBuilderAcceleratedEndpoint];
-            } else {
-                host = [NSString stringWithFormat:@"%@.%@", bucketName, endpoint.hostName];
-            }
-        } else {
-            host = endpoint.hostName;
-        }
-        [getPreSignedURLRequest setValue:host forRequestHeader:@"host"];
-        
-        //If this is a presigned request for a multipart upload, set the uploadID and partNumber on the request.
-        if (getPreSignedURLRequest.uploadID
-            && getPreSignedURLRequest.partNumber) {
-            
-            [getPreSignedURLRequest setValue:getPreSignedURLRequest.uploadID
-                         forRequestParameter:@"uploadId"];
-            
-            [getPreSignedURLRequest setValue:[NSString stringWithFormat:@"%@", getPreSignedURLRequest.partNumber]
-                         forRequestParameter:@"partNumber"];
-        }
-        NSString *portNumber = endpoint.portNumber != nil ? [NSString stringWithFormat:@":%@", endpoint.portNumber.stringValue]: @"";
-        AWSEndpoint *newEndpoint = [[AWSEndpoint alloc]initWithRegion:configuration.regionType service:AWSServiceS3 URL:[NSURL URLWithString:[NSString stringWithFormat:@"%@://%@%@", endpoint.useUnsafeURL?@"http":@"https", host, portNumber]]];
-        
+        AWSEndpoint *newEndpoint = [self prepareGetPreSignedURLRequest:getPreSignedURLRequest
+                                                               keyPath:&keyPath];
         int32_t expireDuration = [expires timeIntervalSinceNow];
-        if (expireDuration > 604800) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidExpiresDate
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"Invalid ExpiresDate, must be less than seven days in future"}]
-                    ];
-        }
 
         return [AWSSignatureV4Signer  generateQueryStringForSignatureV4WithCredentialProvider:task.result
                                                                                    httpMethod:httpMethod
@@ -315,6 +188,224 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     }];
 }
 
+- (AWSTask<NSArray<NSURL *> *> *)getPreSignedURLs:(NSArray<AWSS3GetPreSignedURLRequest *> *)getPreSignedURLRequests {
+    id<AWSCredentialsProvider>credentialsProvider = self.configuration.credentialsProvider;
+
+    return [[[AWSTask taskWithResult:nil] continueWithBlock:^id(AWSTask *task) {
+        NSTimeInterval minimumCredentialsExpirationInterval = 0;
+        for (AWSS3GetPreSignedURLRequest *getPreSignedURLRequest in getPreSignedURLRequests) {
+            NSError *error = [self validateGetPreSignedURLRequest:getPreSignedURLRequest];
+            if (error) {
+                return [AWSTask taskWithError:error];
+            }
+            minimumCredentialsExpirationInterval = MAX(minimumCredentialsExpirationInterval, getPreSignedURLRequest.minimumCredentialsExpirationInterval);
+        }
+
+        //Resolve the credentials once for all of the URLs
+        return [[credentialsProvider credentials] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
+            AWSCredentials *credentials = task.result;
+            if ([credentials.expiration timeIntervalSinceNow] < minimumCredentialsExpirationInterval) {
+                [credentialsProvider invalidateCachedTemporaryCredentials];
+                return [credentialsProvider credentials];
+            }
+
+            return credentials;
+        }];
+    }] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
+        AWSCredentials *credentials = task.result;
+        if (!credentials) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                                              code:AWSS3PreSignedURLErrorInternalError
+                                                          userInfo:@{NSLocalizedDescriptionKey: @"Credentials result unexpectedly nil generating presigned URL"}]];
+        }
+
+        //All of the URLs are signed for the same date, so they share the signing key of their region and service.
+        NSDate *date = [NSDate aws_clockSkewFixedDate];
+        NSString *dateStamp = [date aws_stringValue:AWSDateShortDateFormat1];
+        NSMutableDictionary<NSString *, NSData *> *signingKeys = [NSMutableDictionary new];
+
+        NSMutableArray<NSURL *> *URLs = [NSMutableArray arrayWithCapacity:[getPreSignedURLRequests count]];
+        for (AWSS3GetPreSignedURLRequest *getPreSignedURLRequest in getPreSignedURLRequests) {
+            NSString *keyPath = nil;
+            AWSEndpoint *newEndpoint = [self prepareGetPreSignedURLRequest:getPreSignedURLRequest
+                                                                   keyPath:&keyPath];
+
+            NSString *scope = [NSString stringWithFormat:@"%@/%@", newEndpoint.regionName, newEndpoint.serviceName];
+            NSData *signingKey = signingKeys[scope];
+            if (!signingKey) {
+                signingKey = [AWSSignatureV4Signer getV4DerivedKey:credentials.secretKey
+                                                              date:dateStamp
+                                                            region:newEndpoint.regionName
+                                                           service:newEndpoint.serviceName];
+                signingKeys[scope] = signingKey;
+            }
+
+            NSURLRequest *urlRequest = [AWSSignatureV4Signer presignRequestWithEndpoint:newEndpoint
+                                                                             httpMethod:getPreSignedURLRequest.HTTPMethod
+                                                                                keyPath:keyPath
+                                                                         requestHeaders:getPreSignedURLRequest.requestHeaders
+                                                                      requestParameters:getPreSignedURLRequest.requestParameters];
+
+            NSURL *URL = [AWSSignatureV4Signer sigV4SignedURLWithRequest:urlRequest
+                                                             credentials:credentials
+                                                              signingKey:signingKey
+                                                              regionName:newEndpoint.regionName
+                                                             serviceName:newEndpoint.serviceName
+                                                                    date:date
+                                                          expireDuration:[getPreSignedURLRequest.expires timeIntervalSinceNow]
+                                                                signBody:NO
+                                                        signSessionToken:YES];
+            if (!URL) {
+                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                                                  code:AWSS3PreSignedURLErrorInternalError
+                                                              userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Failed to sign the URL of key %@", getPreSignedURLRequest.key]}]];
+            }
+            [URLs addObject:URL];
+        }
+
+        return URLs;
+    }];
+}
+
+#pragma mark - Internal
+
+// Returns the error of an invalid request, or nil.
+- (NSError *)validateGetPreSignedURLRequest:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest {
+    NSString *bucketName = getPreSignedURLRequest.bucket;
+    NSString *keyName = getPreSignedURLRequest.key;
+    AWSHTTPMethod httpMethod = getPreSignedURLRequest.HTTPMethod;
+    id<AWSCredentialsProvider>credentialsProvider = self.configuration.credentialsProvider;
+    AWSEndpoint *endpoint = self.configuration.endpoint;
+    BOOL isAccelerateModeEnabled = getPreSignedURLRequest.isAccelerateModeEnabled;
+    NSDate *expires = getPreSignedURLRequest.expires;
+
+    //validate additionalParams
+    for (id key in getPreSignedURLRequest.requestParameters) {
+        id value = getPreSignedURLRequest.requestParameters[key];
+        if (![key isKindOfClass:[NSString class]]
+            || ![value isKindOfClass:[NSString class]]) {
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorInvalidRequestParameters
+                                   userInfo:@{NSLocalizedDescriptionKey: @"requestParameters can only contain key-value pairs in NSString type."}];
+        }
+    }
+
+    //validate endpoint
+    if (!endpoint) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorEndpointIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"endpoint in configuration can not be nil"}];
+    } else if (endpoint.serviceType != AWSServiceS3) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidServiceType
+                               userInfo:@{NSLocalizedDescriptionKey: @"Invalid serviceType: serviceType in endpoint must be AWSServiceS3"}];
+    }
+
+    //validate credentialsProvider
+    if (!credentialsProvider) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PreSignedURLErrorCredentialProviderIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"credentialsProvider in configuration can not be nil"}];
+    }
+
+    //validate bucketName
+    if (!bucketName || [bucketName length] < 1) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorBucketNameIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"S3 bucket can not be nil or empty"}];
+    }
+
+    // Validates the buket name for transfer acceleration.
+    if (isAccelerateModeEnabled && ![bucketName aws_isVirtualHostedStyleCompliant]) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidBucketNameForAccelerateModeEnabled
+                               userInfo:@{
+                                          NSLocalizedDescriptionKey: @"For your bucket to work with transfer acceleration, the bucket name must conform to DNS naming requirements and must not contain periods."}];
+    }
+
+    //validate keyName
+    if (!keyName || [keyName length] < 1) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorKeyNameIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"S3 key can not be nil or empty"}];
+    }
+
+    //validate expires Date
+    if (!expires) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidExpiresDate
+                               userInfo:@{NSLocalizedDescriptionKey: @"expires can not be nil"}];
+    } else if ([expires timeIntervalSinceNow] < 0.0) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidExpiresDate
+                               userInfo:@{NSLocalizedDescriptionKey: @"expires can not be in past"}];
+    } else if ([expires timeIntervalSinceNow] > 604800) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidExpiresDate
+                               userInfo:@{NSLocalizedDescriptionKey: @"Invalid ExpiresDate, must be less than seven days in future"}];
+    }
+
+    //validate httpMethod
+    switch (httpMethod) {
+        case AWSHTTPMethodGET:
+        case AWSHTTPMethodPUT:
+        case AWSHTTPMethodHEAD:
+        case AWSHTTPMethodDELETE:
+            break;
+        default:
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorUnsupportedHTTPVerbs
+                                   userInfo:@{NSLocalizedDescriptionKey: @"unsupported HTTP Method, currently only support AWSHTTPMethodGET, AWSHTTPMethodPUT, AWSHTTPMethodHEAD, AWSHTTPMethodDELETE"}];
+    }
+
+    return nil;
+}
+
+// Sets the host header and the multipart upload parameters of a validated request. Returns the endpoint to sign the
+// request for, and its key path.
+- (AWSEndpoint *)prepareGetPreSignedURLRequest:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest
+                                       keyPath:(NSString **)keyPath {
+    NSString *bucketName = getPreSignedURLRequest.bucket;
+    NSString *keyName = getPreSignedURLRequest.key;
+    AWSEndpoint *endpoint = self.configuration.endpoint;
+
+    //generate baseURL String (use virtualHostStyle if possible)
+    //base url is not url encoded.
+    if (bucketName == nil || [bucketName aws_isVirtualHostedStyleCompliant]) {
+        *keyPath = (keyName == nil ? @"" : [NSString stringWithFormat:@"%@", [keyName aws_stringWithURLEncodingPath]]);
+    } else {
+        *keyPath = (keyName == nil ? [NSString stringWithFormat:@"%@", bucketName] : [NSString stringWithFormat:@"%@/%@", bucketName, [keyName aws_stringWithURLEncodingPath]]);
+    }
+
+    //generate correct hostName (use virtualHostStyle if possible)
+    NSString *host = nil;
+    if (!self.configuration.localTestingEnabled &&
+        bucketName &&
+        [bucketName aws_isVirtualHostedStyleCompliant]) {
+        if (getPreSignedURLRequest.isAccelerateModeEnabled) {
+            host = [NSString stringWithFormat:@"%@.%@", bucketName, AWSS3PreSignedURLBuilderAcceleratedEndpoint];
+        } else {
+            host = [NSString stringWithFormat:@"%@.%@", bucketName, endpoint.hostName];
+        }
+    } else {
+        host = endpoint.hostName;
+    }
+    [getPreSignedURLRequest setValue:host forRequestHeader:@"host"];
+
+    //If this is a presigned request for a multipart upload, set the uploadID and partNumber on the request.
+    if (getPreSignedURLRequest.uploadID
+        && getPreSignedURLRequest.partNumber) {
+
+        [getPreSignedURLRequest setValue:getPreSignedURLRequest.uploadID
+                     forRequestParameter:@"uploadId"];
+
+        [getPreSignedURLRequest setValue:[NSString stringWithFormat:@"%@", getPreSignedURLRequest.partNumber]
+                     forRequestParameter:@"partNumber"];
+    }
+    NSString *portNumber = endpoint.portNumber != nil ? [NSString stringWithFormat:@":%@", endpoint.portNumber.stringValue]: @"";
+    return [[AWSEndpoint alloc]initWithRegion:self.configuration.regionType service:AWSServiceS3 URL:[NSURL URLWithString:[NSString stringWithFormat:@"%@://%@%@", endpoint.useUnsafeURL?@"http":@"https", host, portNumber]]];
+}
+
 @end
 
 @implementation AWSS3GetPreSignedURLRequest
@@ -192,6 +192,11 @@ static int const AWSS3TransferUtilityMultiPartDefaultConcurrencyLimit = 5;
                       taskIdentifier: (NSUInteger) taskIdentifier
                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
 
++ (void) deleteTransferRequestsFromDB:(NSArray<NSString *> *) transferIDs
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) flushPendingChangesToDB: (AWSFMDatabaseQueue *) databaseQueue;
+
 + (void) updateTransferRequestInDB: (NSString *) transferID
                         partNumber: (NSNumber *) partNumber
                     taskIdentifier: (NSUInteger) taskIdentifier
@@ -520,6 +525,8 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
 {
     //Get All Tasks from DB
     NSMutableArray *tasks = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:_sessionIdentifier databaseQueue:_databaseQueue];
+    //Transfers to clean up from the DB, all at once after the loop
+    NSMutableArray<NSString *> *transferIDsToDelete = [NSMutableArray new];
     
     //Iterate through the tasks and populate transferRequests and Multipart dictionary.
     for( NSMutableDictionary *task in tasks ) {
@@ -532,7 +539,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             //If task is completed, no more processing is required.
             if (transferUtilityUploadTask.status == AWSS3TransferUtilityTransferStatusCompleted ) {
                 [self.completedTaskDictionary setObject:transferUtilityUploadTask forKey:transferUtilityUploadTask.transferID];
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:transferUtilityUploadTask.transferID databaseQueue:self->_databaseQueue];
+                [transferIDsToDelete addObject:transferUtilityUploadTask.transferID];
                 continue;
             }
             //Lodge in temporary Dictionary
@@ -545,7 +552,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             //If task is completed, no more processing is required.
             if (transferUtilityDownloadTask.status == AWSS3TransferUtilityTransferStatusCompleted ) {
                 [self.completedTaskDictionary setObject:transferUtilityDownloadTask forKey:transferUtilityDownloadTask.transferID];
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:transferUtilityDownloadTask.transferID databaseQueue:self->_databaseQueue];
+                [transferIDsToDelete addObject:transferUtilityDownloadTask.transferID];
                 continue;
             }
             //Lodge in temporary Dictionary for linking
@@ -561,7 +568,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
                 transferUtilityMultiPartUploadTask.status == AWSS3TransferUtilityTransferStatusCancelled ||
                 transferUtilityMultiPartUploadTask.status == AWSS3TransferUtilityTransferStatusError) {
                 [self.completedTaskDictionary setObject:transferUtilityMultiPartUploadTask forKey:transferUtilityMultiPartUploadTask.transferID];
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:transferUtilityMultiPartUploadTask.transferID databaseQueue:self->_databaseQueue];
+                [transferIDsToDelete addObject:transferUtilityMultiPartUploadTask.transferID];
                 continue;
             }
             
@@ -577,7 +584,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             AWSS3TransferUtilityMultiPartUploadTask *multiPartUploadTask = [tempMultiPartMasterTaskDictionary objectForKey:subTask.uploadID];
             if ( !multiPartUploadTask ) {
                 //Couldn't find the multipart upload master record. Must be an orphan part record. Clean up the DB and continue.
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:subTask.transferID databaseQueue:self->_databaseQueue];
+                [transferIDsToDelete addObject:subTask.transferID];
                 continue;
             }
             //Check if the subTask is is already completed. If it is, add it to the completed parts list, update the progress object and go to the next iteration of the loop
@@ -590,6 +597,8 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             [tempTransferDictionary setObject:subTask forKey:@(sessionTaskID)];
         }
     }
+    
+    [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestsFromDB:transferIDsToDelete databaseQueue:self->_databaseQueue];
 }
 
 - (void) linkTransfersToNSURLSession:(NSMutableDictionary *) tempMultiPartMasterTaskDictionary
@@ -1140,6 +1149,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
                                                           retry_count:transferUtilityUploadTask.retryCount
                                                         databaseQueue:self->_databaseQueue];
         if (startTransfer) {
+            [AWSS3TransferUtilityDatabaseHelper flushPendingChangesToDB:self->_databaseQueue];
             [uploadTask resume];
         }
         
@@ -1411,7 +1421,8 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             
         }
         
-        //Start the subTasks
+        //Save all of the parts in a single transaction, then start the subTasks
+        [AWSS3TransferUtilityDatabaseHelper flushPendingChangesToDB:self.databaseQueue];
         for(id taskIdentifier in transferUtilityMultiPartUploadTask.inProgressPartsDictionary) {
             AWSS3TransferUtilityUploadSubTask *subTask = [transferUtilityMultiPartUploadTask.inProgressPartsDictionary objectForKey:taskIdentifier];
             AWSDDLogDebug(@"Starting subTask %@", @(subTask.taskIdentifier));
@@ -1583,6 +1594,7 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
 
         if (startTransfer) {
             AWSDDLogDebug(@"[CreateUploadSubTask] startTransfer is true, Starting subTask %@", @(subTask.taskIdentifier));
+            [AWSS3TransferUtilityDatabaseHelper flushPendingChangesToDB:self.databaseQueue];
             [subTask.sessionTask resume];
         }
        
@@ -1775,6 +1787,7 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
                                                         databaseQueue:self.databaseQueue];
         
         if ( startTransfer) {
+            [AWSS3TransferUtilityDatabaseHelper flushPendingChangesToDB:self.databaseQueue];
             [downloadTask resume];
         }
         return [AWSTask taskWithResult:transferUtilityDownloadTask];
@@ -22,6 +22,11 @@
 NSString *const AWSS3TransferUtilityDatabaseDirectory = @"/com/amazonaws/AWSS3TransferUtility/";
 NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
 
+//Changes are committed together once this interval has passed since the first pending change.
+static NSTimeInterval const AWSS3TransferUtilityDatabaseCommitInterval = 0.1;
+//Writers commit the pending changes themselves past this count, which bounds the memory of the journal.
+static NSUInteger const AWSS3TransferUtilityDatabaseMaxPendingChanges = 1000;
+
 @interface AWSS3TransferUtilityTask()
 @property NSString *nsURLSessionID;
 @property NSString *file;
@@ -62,6 +67,201 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
 @property NSString *transferType;
 @end
 
+#pragma mark - AWSS3 Transfer Utility Database Journal
+
+//A pending change to the awstransfer table.
+@interface AWSS3TransferUtilityDatabaseChange : NSObject
+
+@property (nonatomic, strong) NSString *statement;
+@property (nonatomic, strong) NSMutableDictionary *parameters;
+@property (nonatomic, strong) NSString *transferID;
+//Identifies the row of an insert or an update. nil for deletes.
+@property (nonatomic, strong) NSString *rowKey;
+//Set when a delete of the transfer made the change moot.
+@property (nonatomic, assign) BOOL cancelled;
+
+@end
+
+@implementation AWSS3TransferUtilityDatabaseChange
+
+@end
+
+//Collects the changes to one database and commits them together in a single transaction, instead of one transaction
+//per change. Updates to a row that is still pending are folded into it, and transfers that are deleted before their
+//insert was committed never reach the database.
+@interface AWSS3TransferUtilityDatabaseJournal : NSObject
+
+@property (nonatomic, strong) NSMutableArray<AWSS3TransferUtilityDatabaseChange *> *changes;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSS3TransferUtilityDatabaseChange *> *pendingInserts;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSS3TransferUtilityDatabaseChange *> *pendingUpdates;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<AWSS3TransferUtilityDatabaseChange *> *> *changesByTransferID;
+@property (nonatomic, assign) BOOL commitScheduled;
+//Held for the whole commit, so that commits reach the database in the order their changes were made.
+@property (nonatomic, strong) NSObject *commitLock;
+
+//The number of changes recorded, of statements executed and of transactions committed.
+@property (atomic, assign) NSUInteger changeCount;
+@property (atomic, assign) NSUInteger statementCount;
+@property (atomic, assign) NSUInteger transactionCount;
+
+@end
+
+@implementation AWSS3TransferUtilityDatabaseJournal
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _changes = [NSMutableArray new];
+        _pendingInserts = [NSMutableDictionary new];
+        _pendingUpdates = [NSMutableDictionary new];
+        _changesByTransferID = [NSMutableDictionary new];
+        _commitLock = [NSObject new];
+    }
+    return self;
+}
+
++ (NSString *) rowKey:(NSString *) transferID
+           partNumber:(NSNumber *) partNumber {
+    return [NSString stringWithFormat:@"%@/%@", transferID, partNumber];
+}
+
+- (void) appendChange:(AWSS3TransferUtilityDatabaseChange *) change {
+    [self.changes addObject:change];
+    NSMutableArray *changesOfTransfer = self.changesByTransferID[change.transferID];
+    if (!changesOfTransfer) {
+        changesOfTransfer = [NSMutableArray new];
+        self.changesByTransferID[change.transferID] = changesOfTransfer;
+    }
+    [changesOfTransfer addObject:change];
+    self.changeCount++;
+}
+
+- (void) insertRow:(NSString *) transferID
+        partNumber:(NSNumber *) partNumber
+         statement:(NSString *) statement
+        parameters:(NSDictionary *) parameters {
+    NSString *rowKey = [AWSS3TransferUtilityDatabaseJournal rowKey:transferID partNumber:partNumber];
+    AWSS3TransferUtilityDatabaseChange *change = [AWSS3TransferUtilityDatabaseChange new];
+    change.statement = statement;
+    change.parameters = [parameters mutableCopy];
+    change.transferID = transferID;
+    change.rowKey = rowKey;
+    @synchronized(self) {
+        [self.pendingUpdates removeObjectForKey:rowKey];
+        self.pendingInserts[rowKey] = change;
+        [self appendChange:change];
+    }
+}
+
+- (void) updateRow:(NSString *) transferID
+        partNumber:(NSNumber *) partNumber
+         statement:(NSString *) statement
+        parameters:(NSDictionary *) parameters {
+    NSString *rowKey = [AWSS3TransferUtilityDatabaseJournal rowKey:transferID partNumber:partNumber];
+    @synchronized(self) {
+        //The update parameters are named after the columns they set, so they can be folded into a pending insert.
+        AWSS3TransferUtilityDatabaseChange *pendingInsert = self.pendingInserts[rowKey];
+        if (pendingInsert) {
+            [pendingInsert.parameters addEntriesFromDictionary:parameters];
+            self.changeCount++;
+            return;
+        }
+        AWSS3TransferUtilityDatabaseChange *pendingUpdate = self.pendingUpdates[rowKey];
+        if (pendingUpdate) {
+            pendingUpdate.parameters = [parameters mutableCopy];
+            self.changeCount++;
+            return;
+        }
+
+        AWSS3TransferUtilityDatabaseChange *change = [AWSS3TransferUtilityDatabaseChange new];
+        change.statement = statement;
+        change.parameters = [parameters mutableCopy];
+        change.transferID = transferID;
+        change.rowKey = rowKey;
+        self.pendingUpdates[rowKey] = change;
+        [self appendChange:change];
+    }
+}
+
+- (void) deleteTransfer:(NSString *) transferID
+              statement:(NSString *) statement
+             parameters:(NSDictionary *) parameters
+     replacesAllChanges:(BOOL) replacesAllChanges {
+    AWSS3TransferUtilityDatabaseChange *change = [AWSS3TransferUtilityDatabaseChange new];
+    change.statement = statement;
+    change.parameters = [parameters mutableCopy];
+    change.transferID = transferID;
+    @synchronized(self) {
+        if (replacesAllChanges) {
+            //Every row of a transfer is inserted after its first row, so the transfer has no committed row while that insert is pending.
+            BOOL committed = self.pendingInserts[[AWSS3TransferUtilityDatabaseJournal rowKey:transferID partNumber:@0]] == nil;
+            for (AWSS3TransferUtilityDatabaseChange *pendingChange in self.changesByTransferID[transferID]) {
+                pendingChange.cancelled = YES;
+                if (pendingChange.rowKey) {
+                    [self.pendingInserts removeObjectForKey:pendingChange.rowKey];
+                    [self.pendingUpdates removeObjectForKey:pendingChange.rowKey];
+                }
+            }
+            [self.changesByTransferID removeObjectForKey:transferID];
+            if (!committed) {
+                self.changeCount++;
+                return;
+            }
+        }
+        [self appendChange:change];
+    }
+}
+
+- (void) commitAfterChangeToDatabaseQueue:(AWSFMDatabaseQueue *) databaseQueue {
+    BOOL commitsNow = NO;
+    BOOL schedulesCommit = NO;
+    @synchronized(self) {
+        if ([self.changes count] >= AWSS3TransferUtilityDatabaseMaxPendingChanges) {
+            commitsNow = YES;
+        } else if (!self.commitScheduled && [self.changes count] > 0) {
+            self.commitScheduled = YES;
+            schedulesCommit = YES;
+        }
+    }
+    if (commitsNow) {
+        [self commitToDatabaseQueue:databaseQueue];
+    } else if (schedulesCommit) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(AWSS3TransferUtilityDatabaseCommitInterval * NSEC_PER_SEC)),
+                       dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [self commitToDatabaseQueue:databaseQueue];
+        });
+    }
+}
+
+- (void) commitToDatabaseQueue:(AWSFMDatabaseQueue *) databaseQueue {
+    @synchronized(self.commitLock) {
+        NSMutableArray<AWSS3TransferUtilityDatabaseChange *> *changes = nil;
+        @synchronized(self) {
+            changes = self.changes;
+            self.changes = [NSMutableArray new];
+            [self.pendingInserts removeAllObjects];
+            [self.pendingUpdates removeAllObjects];
+            [self.changesByTransferID removeAllObjects];
+            self.commitScheduled = NO;
+        }
+        [changes filterUsingPredicate:[NSPredicate predicateWithFormat:@"cancelled == NO"]];
+        if ([changes count] == 0) {
+            return;
+        }
+
+        [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+            for (AWSS3TransferUtilityDatabaseChange *change in changes) {
+                if (![db executeUpdate:change.statement withParameterDictionary:change.parameters]) {
+                    AWSDDLogError(@"Failed to save transfer_request [%@] in Database. [%@]", change.transferID, db.lastError);
+                }
+            }
+        }];
+        self.statementCount += [changes count];
+        self.transactionCount++;
+    }
+}
+
+@end
+
 #pragma mark - AWSS3 Transfer Utility Database Functions
 
 @implementation AWSS3TransferUtilityDatabaseHelper
@@ -85,6 +285,9 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     @"retry_count INTEGER NOT NULL,"
     @"request_headers TEXT,"
     @"request_parameters TEXT)";
+    //Updates and deletes look rows up by transfer, so that they do not scan the whole table.
+    NSString *const AWSS3TransferUtilityCreateAWSTransferIndex = @"CREATE INDEX IF NOT EXISTS awstransfer_transfer_id "
+    @"ON awstransfer (transfer_id, part_number)";
     
     NSString *dbDirPath = [cacheDirectoryPath stringByAppendingString:AWSS3TransferUtilityDatabaseDirectory];
     BOOL fileExistsAtPath = [[NSFileManager defaultManager] fileExistsAtPath:dbDirPath];
@@ -112,10 +315,38 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
         if (! [db executeUpdate: AWSS3TransferUtilityCreateAWSTransfer]) {
             AWSDDLogError(@"Failed to create awstransfer Database table. [%@]", db.lastError);
         }
+        if (! [db executeUpdate: AWSS3TransferUtilityCreateAWSTransferIndex]) {
+            AWSDDLogError(@"Failed to create awstransfer Database index. [%@]", db.lastError);
+        }
     }];
     return databaseQueue;
 }
 
++ (AWSS3TransferUtilityDatabaseJournal *) journalForDatabaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    if (!databaseQueue) {
+        return nil;
+    }
+    static NSMapTable<AWSFMDatabaseQueue *, AWSS3TransferUtilityDatabaseJournal *> *journals = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        journals = [NSMapTable weakToStrongObjectsMapTable];
+    });
+    @synchronized(journals) {
+        AWSS3TransferUtilityDatabaseJournal *journal = [journals objectForKey:databaseQueue];
+        if (!journal) {
+            journal = [AWSS3TransferUtilityDatabaseJournal new];
+            [journals setObject:journal forKey:databaseQueue];
+        }
+        return journal;
+    }
+}
+
+//Commits the pending changes. Call it before starting an NSURLSession task, so that the transfer can be recovered
+//if the app is terminated while the task runs.
++ (void) flushPendingChangesToDB: (AWSFMDatabaseQueue *) databaseQueue {
+    [[self journalForDatabaseQueue:databaseQueue] commitToDatabaseQueue:databaseQueue];
+}
+
 
 //Delete a transfer request given its transfer ID
 + (void) deleteTransferRequestFromDB:(NSString *) transferID
@@ -123,19 +354,26 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     NSString *const AWSS3TransferUtilityDeleteTransfer =  @"DELETE FROM awstransfer "
     @"WHERE transfer_id=:transfer_id";
     
-    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-        BOOL result = [db executeUpdate: AWSS3TransferUtilityDeleteTransfer
-                withParameterDictionary:@{
-                                          @"transfer_id": transferID
-                                          }];
-        
-        if (!result) {
-            AWSDDLogError(@"Failed to delete transfer_request [%@] in Database. [%@]", transferID,
-                          db.lastError);
-            return;
-        }
-        
-    }];
+    AWSS3TransferUtilityDatabaseJournal *journal = [self journalForDatabaseQueue:databaseQueue];
+    [journal deleteTransfer:transferID
+                  statement:AWSS3TransferUtilityDeleteTransfer
+                 parameters:@{
+                              @"transfer_id": transferID
+                              }
+         replacesAllChanges:YES];
+    [journal commitAfterChangeToDatabaseQueue:databaseQueue];
+}
+
+//Delete transfer requests given their transfer IDs, in a single transaction.
++ (void) deleteTransferRequestsFromDB:(NSArray<NSString *> *) transferIDs
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    if ([transferIDs count] == 0) {
+        return;
+    }
+    for (NSString *transferID in transferIDs) {
+        [self deleteTransferRequestFromDB:transferID databaseQueue:databaseQueue];
+    }
+    [self flushPendingChangesToDB:databaseQueue];
 }
 
 //Delete a transfer request given its transfer ID and task Identifier.
@@ -145,17 +383,15 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     NSString *const AWSS3TransferUtilityDeleteATask =  @"DELETE FROM awstransfer "
     @"WHERE transfer_id=:transfer_id and "
     @"      session_task_id=:session_task_id ";
-    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-        BOOL result = [db executeUpdate:AWSS3TransferUtilityDeleteATask
-                withParameterDictionary:@{
-                                          @"transfer_id": transferID,
-                                          @"session_task_id": @(taskIdentifier)
-                                          }];
-        if (!result) {
-            AWSDDLogError(@"Failed to delete transfer_request [%@] in Database. [%@]", transferID,
-                          db.lastError);
-        }
-    }];
+    AWSS3TransferUtilityDatabaseJournal *journal = [self journalForDatabaseQueue:databaseQueue];
+    [journal deleteTransfer:transferID
+                  statement:AWSS3TransferUtilityDeleteATask
+                 parameters:@{
+                              @"transfer_id": transferID,
+                              @"session_task_id": @(taskIdentifier)
+                              }
+         replacesAllChanges:NO];
+    [journal commitAfterChangeToDatabaseQueue:databaseQueue];
 }
 
 // update transfer record given transferID and partNumber
@@ -170,22 +406,19 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     @"SET status=:status, etag = :etag, session_task_id = :session_task_id, retry_count = :retry_count "
     @"WHERE transfer_id=:transfer_id and "
     @"      part_number =:part_number ";
-    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-        BOOL result = [db executeUpdate: AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag
-                withParameterDictionary:@{
-                                          @"transfer_id": transferID,
-                                          @"session_task_id": @(taskIdentifier),
-                                          @"etag": eTag,
-                                          @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:status],
-                                          @"part_number": partNumber,
-                                          @"retry_count": @(retryCount)
-                                          }];
-        
-        if (!result) {
-            AWSDDLogError(@"Failed to update transfer_request [%@] in Database. [%@]", transferID,
-                          db.lastError);
-        }
-    }];
+    AWSS3TransferUtilityDatabaseJournal *journal = [self journalForDatabaseQueue:databaseQueue];
+    [journal updateRow:transferID
+            partNumber:partNumber
+             statement:AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag
+            parameters:@{
+                         @"transfer_id": transferID,
+                         @"session_task_id": @(taskIdentifier),
+                         @"etag": eTag,
+                         @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:status],
+                         @"part_number": partNumber,
+                         @"retry_count": @(retryCount)
+                         }];
+    [journal commitAfterChangeToDatabaseQueue:databaseQueue];
 }
 
 
@@ -257,6 +490,7 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
                                                     databaseQueue:databaseQueue];
 }
 
+//Parts are recovered from the record of their multipart upload, so they do not repeat its request headers and parameters.
 + (void) insertMultiPartUploadRequestSubTaskInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
                                          subTask:(AWSS3TransferUtilityUploadSubTask *) subTask
                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
@@ -274,8 +508,8 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
                                                     contentLength:@(subTask.totalBytesExpectedToSend)
                                                            status:subTask.status
                                                        retryCount:@(0)
-                                               requestHeadersJSON:[self getJSONRepresentation:task.expression.requestHeaders]
-                                            requestParametersJSON:[self getJSONRepresentation:task.expression.requestParameters]
+                                               requestHeadersJSON:nil
+                                            requestParametersJSON:nil
                                                     databaseQueue:databaseQueue];
 }
 
@@ -309,31 +543,29 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
         tempFileCreated = [NSNumber numberWithInt:1];
     }
     
-    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-        BOOL result = [db executeUpdate: AWSS3TransferUtiltyInsertIntoAWSTransfer
-                withParameterDictionary:@{
-                                          @"transfer_id": transferID,
-                                          @"ns_url_session_id": nsURLSessionID,
-                                          @"session_task_id":taskIdentifier,
-                                          @"transfer_type": transferType,
-                                          @"bucket_name": bucket,
-                                          @"key": key,
-                                          @"part_number": partNumber,
-                                          @"multi_part_id": multiPartID,
-                                          @"etag": eTag,
-                                          @"file": file,
-                                          @"temporary_file_created": tempFileCreated,
-                                          @"content_length": contentLength,
-                                          @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:status],
-                                          @"request_headers": requestHeadersJSON,
-                                          @"request_parameters": requestParametersJSON,
-                                          @"retry_count": retryCount
-                                          }];
-        
-        if (!result) {
-            AWSDDLogError(@"Failed to save Transfer [%@] in awstransfer database table. [%@]", transferID, db.lastError);
-        }
-    }];
+    AWSS3TransferUtilityDatabaseJournal *journal = [self journalForDatabaseQueue:databaseQueue];
+    [journal insertRow:transferID
+            partNumber:partNumber
+             statement:AWSS3TransferUtiltyInsertIntoAWSTransfer
+            parameters:@{
+                         @"transfer_id": transferID,
+                         @"ns_url_session_id": nsURLSessionID,
+                         @"session_task_id":taskIdentifier,
+                         @"transfer_type": transferType,
+                         @"bucket_name": bucket,
+                         @"key": key,
+                         @"part_number": partNumber,
+                         @"multi_part_id": multiPartID,
+                         @"etag": eTag,
+                         @"file": file,
+                         @"temporary_file_created": tempFileCreated,
+                         @"content_length": contentLength,
+                         @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:status],
+                         @"request_headers": requestHeadersJSON ?: [NSNull null],
+                         @"request_parameters": requestParametersJSON ?: [NSNull null],
+                         @"retry_count": retryCount
+                         }];
+    [journal commitAfterChangeToDatabaseQueue:databaseQueue];
 }
 
 + (NSMutableArray *) getTransferTaskDataFromDB:(NSString *)nsURLSessionID
@@ -345,6 +577,9 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     @"From awstransfer "
     @"Where ns_url_session_id=:ns_url_session_id order by transfer_id, part_number";
     
+    //Read the pending changes too
+    [self flushPendingChangesToDB:databaseQueue];
+
     NSMutableArray *tasks = [NSMutableArray new];
     //Read from DB
     [databaseQueue inDatabase:^(AWSFMDatabase *db) {
@@ -367,8 +602,9 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
             [transfer setObject:@([rs intForColumn:@"temporary_file_created"]) forKey:@"temporary_file_created"];
             [transfer setObject:@([rs intForColumn:@"content_length"]) forKey:@"content_length"];
             [transfer setObject:@([rs intForColumn:@"retry_count"]) forKey:@"retry_count"];
-            [transfer setObject:[rs stringForColumn:@"request_headers"] forKey:@"request_headers"];
-            [transfer setObject:[rs stringForColumn:@"request_parameters"] forKey:@"request_parameters"];
+            //NULL for parts of multipart uploads
+            transfer[@"request_headers"] = [rs stringForColumn:@"request_headers"];
+            transfer[@"request_parameters"] = [rs stringForColumn:@"request_parameters"];
             NSNumber *statusValue = [ NSNumber numberWithInteger:[AWSS3TransferUtilityDatabaseHelper getEnumRepresentation:[rs stringForColumn:@"status"]]];
             [transfer setObject: statusValue forKey:@"status"];
             [tasks addObject:transfer];
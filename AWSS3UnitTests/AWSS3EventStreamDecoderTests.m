@@ -0,0 +1,328 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSS3Service.h"
+#import "AWSS3EventStreamDecoder.h"
+#import "AWSS3+SelectObjectContent.h"
+
+@interface AWSS3()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+// Replays a recorded response body through the response data handler instead of calling S3.
+@interface AWSS3EventStreamTestS3 : AWSS3
+
+@property (nonatomic, strong) NSArray<NSData *> *responsePieces;
+
+@end
+
+@implementation AWSS3EventStreamTestS3
+
+- (AWSTask<AWSS3SelectObjectContentOutput *> *)selectObjectContent:(AWSS3SelectObjectContentRequest *)request {
+    for (NSData *piece in self.responsePieces) {
+        if (request.isCancelled) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]];
+        }
+        request.responseDataHandler(piece);
+    }
+    return [AWSTask taskWithResult:[AWSS3SelectObjectContentOutput new]];
+}
+
+@end
+
+static uint32_t AWSS3EventStreamTestCRC32(const uint8_t *bytes, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void AWSS3EventStreamTestAppendUInt16(NSMutableData *data, uint16_t value) {
+    uint8_t bytes[2] = {(uint8_t)(value >> 8), (uint8_t)value};
+    [data appendBytes:bytes length:2];
+}
+
+static void AWSS3EventStreamTestAppendUInt32(NSMutableData *data, uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value};
+    [data appendBytes:bytes length:4];
+}
+
+@interface AWSS3EventStreamDecoderTests : XCTestCase
+
+@end
+
+@implementation AWSS3EventStreamDecoderTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+}
+
+#pragma mark - Helpers
+
+- (NSData *)stringHeaderNamed:(NSString *)name value:(NSString *)value {
+    NSMutableData *header = [NSMutableData new];
+    NSData *nameData = [name dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *valueData = [value dataUsingEncoding:NSUTF8StringEncoding];
+    uint8_t nameLength = (uint8_t)nameData.length;
+    uint8_t type = 7;
+    [header appendBytes:&nameLength length:1];
+    [header appendData:nameData];
+    [header appendBytes:&type length:1];
+    AWSS3EventStreamTestAppendUInt16(header, (uint16_t)valueData.length);
+    [header appendData:valueData];
+    return header;
+}
+
+- (NSData *)messageWithHeaders:(NSData *)headers payload:(NSData *)payload {
+    NSMutableData *message = [NSMutableData new];
+    AWSS3EventStreamTestAppendUInt32(message, (uint32_t)(16 + headers.length + payload.length));
+    AWSS3EventStreamTestAppendUInt32(message, (uint32_t)headers.length);
+    AWSS3EventStreamTestAppendUInt32(message, AWSS3EventStreamTestCRC32(message.bytes, 8));
+    [message appendData:headers];
+    [message appendData:payload];
+    AWSS3EventStreamTestAppendUInt32(message, AWSS3EventStreamTestCRC32(message.bytes, message.length));
+    return message;
+}
+
+- (NSData *)eventMessageOfType:(NSString *)eventType payload:(NSData *)payload {
+    NSMutableData *headers = [NSMutableData new];
+    [headers appendData:[self stringHeaderNamed:@":message-type" value:@"event"]];
+    [headers appendData:[self stringHeaderNamed:@":event-type" value:eventType]];
+    return [self messageWithHeaders:headers payload:payload];
+}
+
+- (NSArray<NSData *> *)piecesOfData:(NSData *)data length:(NSUInteger)length {
+    NSMutableArray<NSData *> *pieces = [NSMutableArray new];
+    for (NSUInteger offset = 0; offset < data.length; offset += length) {
+        [pieces addObject:[data subdataWithRange:NSMakeRange(offset, MIN(length, data.length - offset))]];
+    }
+    return pieces;
+}
+
+#pragma mark - Decoder
+
+- (void)testDecodesMessagesSplitAtEveryByte {
+    NSMutableData *stream = [NSMutableData new];
+    [stream appendData:[self eventMessageOfType:@"Records" payload:[@"a,b\n" dataUsingEncoding:NSUTF8StringEncoding]]];
+    [stream appendData:[self eventMessageOfType:@"Records" payload:[@"c,d\n" dataUsingEncoding:NSUTF8StringEncoding]]];
+    [stream appendData:[self eventMessageOfType:@"End" payload:[NSData data]]];
+
+    NSMutableArray<NSString *> *eventTypes = [NSMutableArray new];
+    NSMutableString *records = [NSMutableString new];
+    AWSS3EventStreamDecoder *decoder = [[AWSS3EventStreamDecoder alloc] initWithMessageHandler:^(NSDictionary<NSString *, id> *headers, NSData *payload) {
+        [eventTypes addObject:headers[@":event-type"]];
+        [records appendString:[[NSString alloc] initWithData:payload encoding:NSUTF8StringEncoding]];
+    }];
+
+    for (NSData *piece in [self piecesOfData:stream length:1]) {
+        NSError *error = nil;
+        XCTAssertTrue([decoder appendData:piece error:&error]);
+        XCTAssertNil(error);
+    }
+
+    XCTAssertEqualObjects(eventTypes, (@[@"Records", @"Records", @"End"]));
+    XCTAssertEqualObjects(records, @"a,b\nc,d\n");
+    XCTAssertTrue(decoder.isAtMessageBoundary);
+    XCTAssertEqual(decoder.bufferedLength, 0);
+}
+
+- (void)testDecodesHeaderTypes {
+    NSMutableData *headers = [NSMutableData new];
+    uint8_t boolHeader[] = {4, 't', 'r', 'u', 'e', 0};
+    uint8_t intHeader[] = {3, 'i', 'n', 't', 4, 0xFF, 0xFF, 0xFF, 0xFE};
+    uint8_t timestampHeader[] = {4, 't', 'i', 'm', 'e', 8, 0, 0, 0, 0, 0, 0, 0x03, 0xE8};
+    [headers appendBytes:boolHeader length:sizeof(boolHeader)];
+    [headers appendBytes:intHeader length:sizeof(intHeader)];
+    [headers appendBytes:timestampHeader length:sizeof(timestampHeader)];
+    [headers appendData:[self stringHeaderNamed:@"string" value:@"value"]];
+
+    __block NSDictionary *decodedHeaders = nil;
+    AWSS3EventStreamDecoder *decoder = [[AWSS3EventStreamDecoder alloc] initWithMessageHandler:^(NSDictionary<NSString *, id> *headers, NSData *payload) {
+        decodedHeaders = headers;
+    }];
+    XCTAssertTrue([decoder appendData:[self messageWithHeaders:headers payload:[NSData data]] error:nil]);
+
+    XCTAssertEqualObjects(decodedHeaders[@"true"], @YES);
+    XCTAssertEqualObjects(decodedHeaders[@"int"], @(-2));
+    XCTAssertEqualObjects(decodedHeaders[@"time"], [NSDate dateWithTimeIntervalSince1970:1]);
+    XCTAssertEqualObjects(decodedHeaders[@"string"], @"value");
+}
+
+- (void)testPreludeChecksumMismatch {
+    NSMutableData *message = [[self eventMessageOfType:@"End" payload:[NSData data]] mutableCopy];
+    ((uint8_t *)message.mutableBytes)[3] ^= 0x01;
+
+    __block NSUInteger messageCount = 0;
+    AWSS3EventStreamDecoder *decoder = [[AWSS3EventStreamDecoder alloc] initWithMessageHandler:^(NSDictionary<NSString *, id> *headers, NSData *payload) {
+        messageCount++;
+    }];
+    NSError *error = nil;
+    XCTAssertFalse([decoder appendData:message error:&error]);
+    XCTAssertEqualObjects(error.domain, AWSS3EventStreamErrorDomain);
+    XCTAssertEqual(error.code, AWSS3EventStreamErrorPreludeChecksumMismatch);
+    XCTAssertEqual(messageCount, 0);
+}
+
+- (void)testMessageChecksumMismatchRejectsLaterData {
+    NSMutableData *message = [[self eventMessageOfType:@"Records" payload:[@"a,b\n" dataUsingEncoding:NSUTF8StringEncoding]] mutableCopy];
+    ((uint8_t *)message.mutableBytes)[message.length - 6] ^= 0x01;
+
+    __block NSUInteger messageCount = 0;
+    AWSS3EventStreamDecoder *decoder = [[AWSS3EventStreamDecoder alloc] initWithMessageHandler:^(NSDictionary<NSString *, id> *headers, NSData *payload) {
+        messageCount++;
+    }];
+    NSError *error = nil;
+    XCTAssertFalse([decoder appendData:message error:&error]);
+    XCTAssertEqual(error.code, AWSS3EventStreamErrorMessageChecksumMismatch);
+
+    error = nil;
+    XCTAssertFalse([decoder appendData:[self eventMessageOfType:@"End" payload:[NSData data]] error:&error]);
+    XCTAssertEqual(error.code, AWSS3EventStreamErrorMessageChecksumMismatch);
+    XCTAssertEqual(messageCount, 0);
+}
+
+- (void)testBufferedLengthIsBoundedByMessageLength {
+    NSMutableData *recordsPayload = [NSMutableData new];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [recordsPayload appendData:[[NSString stringWithFormat:@"%lu,row\n", (unsigned long)i] dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    NSData *message = [self eventMessageOfType:@"Records" payload:recordsPayload];
+    NSMutableData *stream = [NSMutableData new];
+    for (NSUInteger i = 0; i < 5000; i++) {
+        [stream appendData:message];
+    }
+
+    __block NSUInteger messageCount = 0;
+    __block NSUInteger payloadLength = 0;
+    AWSS3EventStreamDecoder *decoder = [[AWSS3EventStreamDecoder alloc] initWithMessageHandler:^(NSDictionary<NSString *, id> *headers, NSData *payload) {
+        messageCount++;
+        payloadLength += payload.length;
+    }];
+    NSUInteger maximumBufferedLength = 0;
+    // Pieces of an odd size, so that most messages span two pieces.
+    for (NSData *piece in [self piecesOfData:stream length:1447]) {
+        XCTAssertTrue([decoder appendData:piece error:nil]);
+        maximumBufferedLength = MAX(maximumBufferedLength, decoder.bufferedLength);
+    }
+
+    XCTAssertEqual(messageCount, 5000);
+    XCTAssertEqual(payloadLength, recordsPayload.length * 5000);
+    XCTAssertLessThan(maximumBufferedLength, message.length);
+    NSLog(@"Decoded %lu bytes buffering at most %lu bytes.", (unsigned long)stream.length, (unsigned long)maximumBufferedLength);
+}
+
+#pragma mark - SelectObjectContent
+
+- (void)testSelectObjectContentStreamsEvents {
+    NSData *stats = [@"<Stats><BytesScanned>100</BytesScanned><BytesProcessed>100</BytesProcessed><BytesReturned>8</BytesReturned></Stats>" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableData *stream = [NSMutableData new];
+    [stream appendData:[self eventMessageOfType:@"Records" payload:[@"a,b\n" dataUsingEncoding:NSUTF8StringEncoding]]];
+    [stream appendData:[self eventMessageOfType:@"Cont" payload:[NSData data]]];
+    [stream appendData:[self eventMessageOfType:@"Records" payload:[@"c,d\n" dataUsingEncoding:NSUTF8StringEncoding]]];
+    [stream appendData:[self eventMessageOfType:@"Stats" payload:stats]];
+    [stream appendData:[self eventMessageOfType:@"End" payload:[NSData data]]];
+
+    AWSS3EventStreamTestS3 *s3 = [[AWSS3EventStreamTestS3 alloc] initWithConfiguration:[AWSServiceManager defaultServiceManager].defaultServiceConfiguration];
+    s3.responsePieces = [self piecesOfData:stream length:7];
+
+    NSMutableString *records = [NSMutableString new];
+    __block AWSS3Stats *receivedStats = nil;
+    __block NSUInteger continuationCount = 0;
+    __block BOOL receivedEnd = NO;
+    AWSTask *task = [[s3 selectObjectContent:[AWSS3SelectObjectContentRequest new]
+                                eventHandler:^(AWSS3SelectObjectContentEventStream *event) {
+        if (event.records) {
+            [records appendString:[[NSString alloc] initWithData:event.records.payload encoding:NSUTF8StringEncoding]];
+        } else if (event.stats) {
+            receivedStats = event.stats.details;
+        } else if (event.cont) {
+            continuationCount++;
+        } else if (event.end) {
+            receivedEnd = YES;
+        }
+    }] waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertNotNil(task.result);
+    XCTAssertEqualObjects(records, @"a,b\nc,d\n");
+    XCTAssertEqual(continuationCount, 1);
+    XCTAssertEqualObjects(receivedStats.bytesScanned, @100);
+    XCTAssertEqualObjects(receivedStats.bytesReturned, @8);
+    XCTAssertTrue(receivedEnd);
+}
+
+- (void)testSelectObjectContentReleasesEventHandler {
+    AWSS3EventStreamTestS3 *s3 = [[AWSS3EventStreamTestS3 alloc] initWithConfiguration:[AWSServiceManager defaultServiceManager].defaultServiceConfiguration];
+    s3.responsePieces = @[[self eventMessageOfType:@"End" payload:[NSData data]]];
+    AWSS3SelectObjectContentRequest *request = [AWSS3SelectObjectContentRequest new];
+
+    // The object stands for the caller captured by the event handler; it goes away once the stream state does.
+    __weak NSObject *weakCaller = nil;
+    @autoreleasepool {
+        NSObject *caller = [NSObject new];
+        weakCaller = caller;
+        AWSTask *task = [[s3 selectObjectContent:request
+                                    eventHandler:^(AWSS3SelectObjectContentEventStream *event) {
+            [caller description];
+        }] waitUntilFinished];
+        XCTAssertNil(task.error);
+    }
+
+    XCTAssertNil(weakCaller);
+}
+
+- (void)testSelectObjectContentErrorEvent {
+    NSMutableData *headers = [NSMutableData new];
+    [headers appendData:[self stringHeaderNamed:@":message-type" value:@"error"]];
+    [headers appendData:[self stringHeaderNamed:@":error-code" value:@"InternalError"]];
+    [headers appendData:[self stringHeaderNamed:@":error-message" value:@"We encountered an internal error."]];
+    NSMutableData *stream = [NSMutableData new];
+    [stream appendData:[self eventMessageOfType:@"Records" payload:[@"a,b\n" dataUsingEncoding:NSUTF8StringEncoding]]];
+    [stream appendData:[self messageWithHeaders:headers payload:[NSData data]]];
+
+    AWSS3EventStreamTestS3 *s3 = [[AWSS3EventStreamTestS3 alloc] initWithConfiguration:[AWSServiceManager defaultServiceManager].defaultServiceConfiguration];
+    s3.responsePieces = @[stream];
+
+    AWSTask *task = [[s3 selectObjectContent:[AWSS3SelectObjectContentRequest new]
+                                eventHandler:^(AWSS3SelectObjectContentEventStream *event) {}] waitUntilFinished];
+
+    XCTAssertEqualObjects(task.error.domain, AWSS3ErrorDomain);
+    XCTAssertEqualObjects(task.error.userInfo[@"Code"], @"InternalError");
+    XCTAssertEqualObjects(task.error.userInfo[@"Message"], @"We encountered an internal error.");
+}
+
+- (void)testSelectObjectContentWithoutEndEvent {
+    NSData *message = [self eventMessageOfType:@"Records" payload:[@"a,b\n" dataUsingEncoding:NSUTF8StringEncoding]];
+
+    AWSS3EventStreamTestS3 *s3 = [[AWSS3EventStreamTestS3 alloc] initWithConfiguration:[AWSServiceManager defaultServiceManager].defaultServiceConfiguration];
+    s3.responsePieces = @[message, [message subdataWithRange:NSMakeRange(0, 10)]];
+
+    AWSTask *task = [[s3 selectObjectContent:[AWSS3SelectObjectContentRequest new]
+                                eventHandler:^(AWSS3SelectObjectContentEventStream *event) {}] waitUntilFinished];
+
+    XCTAssertEqualObjects(task.error.domain, AWSS3EventStreamErrorDomain);
+    XCTAssertEqual(task.error.code, AWSS3EventStreamErrorIncompleteMessage);
+}
+
+@end
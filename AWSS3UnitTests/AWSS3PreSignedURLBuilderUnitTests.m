@@ -0,0 +1,143 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSS3PreSignedURL.h"
+
+static NSString *const AWSS3PreSignedURLBuilderUnitTestsKey = @"AWSS3PreSignedURLBuilderUnitTests";
+
+@interface AWSS3PreSignedURLBuilderUnitTests : XCTestCase
+
+@property (nonatomic, strong) AWSS3PreSignedURLBuilder *preSignedURLBuilder;
+
+@end
+
+@implementation AWSS3PreSignedURLBuilderUnitTests
+
+- (void)setUp {
+    [super setUp];
+    AWSStaticCredentialsProvider *credentialsProvider = [[AWSStaticCredentialsProvider alloc] initWithAccessKey:@"AKIDEXAMPLE"
+                                                                                                     secretKey:@"wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSWest2
+                                                                         credentialsProvider:credentialsProvider];
+    [AWSS3PreSignedURLBuilder registerS3PreSignedURLBuilderWithConfiguration:configuration
+                                                                      forKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+    self.preSignedURLBuilder = [AWSS3PreSignedURLBuilder S3PreSignedURLBuilderForKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+}
+
+- (void)tearDown {
+    [AWSS3PreSignedURLBuilder removeS3PreSignedURLBuilderForKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+    [super tearDown];
+}
+
+- (AWSS3GetPreSignedURLRequest *)requestWithBucket:(NSString *)bucket
+                                               key:(NSString *)key {
+    AWSS3GetPreSignedURLRequest *request = [AWSS3GetPreSignedURLRequest new];
+    request.bucket = bucket;
+    request.key = key;
+    request.HTTPMethod = AWSHTTPMethodGET;
+    request.expires = [NSDate dateWithTimeIntervalSinceNow:3600];
+    return request;
+}
+
+// The query items of a URL, without the ones that depend on the time of signing.
+- (NSDictionary<NSString *, NSString *> *)stableQueryItemsOfURL:(NSURL *)URL {
+    NSURLComponents *components = [NSURLComponents componentsWithURL:URL resolvingAgainstBaseURL:NO];
+    NSMutableDictionary<NSString *, NSString *> *queryItems = [NSMutableDictionary new];
+    for (NSURLQueryItem *queryItem in components.queryItems) {
+        queryItems[queryItem.name] = queryItem.value;
+    }
+    [queryItems removeObjectsForKeys:@[@"X-Amz-Date", @"X-Amz-Expires", @"X-Amz-Signature"]];
+    return queryItems;
+}
+
+- (void)testGetPreSignedURLsMatchesGetPreSignedURL {
+    NSArray<AWSS3GetPreSignedURLRequest *> *requests = @[[self requestWithBucket:@"bucket" key:@"photos/cat.jpg"],
+                                                         [self requestWithBucket:@"bucket.with.periods" key:@"a key with spaces"],
+                                                         [self requestWithBucket:@"bucket" key:@"upload"]];
+    requests[2].HTTPMethod = AWSHTTPMethodPUT;
+    requests[2].contentType = @"text/plain";
+    [requests[2] setValue:@"value" forRequestParameter:@"x-custom-parameter"];
+
+    AWSTask<NSArray<NSURL *> *> *task = [[self.preSignedURLBuilder getPreSignedURLs:requests] waitUntilFinished];
+    XCTAssertNil(task.error);
+    NSArray<NSURL *> *URLs = task.result;
+    XCTAssertEqual([URLs count], [requests count]);
+
+    NSString *date = nil;
+    for (NSUInteger i = 0; i < [requests count]; i++) {
+        AWSTask<NSURL *> *singleTask = [[self.preSignedURLBuilder getPreSignedURL:requests[i]] waitUntilFinished];
+        XCTAssertNil(singleTask.error);
+        NSURL *URL = URLs[i];
+        XCTAssertEqualObjects(URL.host, singleTask.result.host);
+        XCTAssertEqualObjects(URL.path, singleTask.result.path);
+        XCTAssertEqualObjects([self stableQueryItemsOfURL:URL], [self stableQueryItemsOfURL:singleTask.result]);
+
+        // Every URL is signed for the same date.
+        NSURLComponents *components = [NSURLComponents componentsWithURL:URL resolvingAgainstBaseURL:NO];
+        for (NSURLQueryItem *queryItem in components.queryItems) {
+            if ([queryItem.name isEqualToString:@"X-Amz-Date"]) {
+                XCTAssertTrue(date == nil || [date isEqualToString:queryItem.value]);
+                date = queryItem.value;
+            }
+        }
+    }
+    XCTAssertNotNil(date);
+    XCTAssertEqualObjects(URLs[0].host, @"bucket.s3.us-west-2.amazonaws.com");
+    XCTAssertEqualObjects(URLs[1].host, @"s3.us-west-2.amazonaws.com");
+}
+
+- (void)testGetPreSignedURLsFailsWithTheFirstInvalidRequest {
+    AWSS3GetPreSignedURLRequest *invalidRequest = [self requestWithBucket:@"bucket" key:@"key"];
+    invalidRequest.expires = [NSDate dateWithTimeIntervalSinceNow:-60];
+    NSArray<AWSS3GetPreSignedURLRequest *> *requests = @[[self requestWithBucket:@"bucket" key:@"key"],
+                                                         invalidRequest,
+                                                         [self requestWithBucket:@"" key:@"key"]];
+
+    AWSTask<NSArray<NSURL *> *> *task = [[self.preSignedURLBuilder getPreSignedURLs:requests] waitUntilFinished];
+    XCTAssertNil(task.result);
+    XCTAssertEqualObjects(task.error.domain, AWSS3PresignedURLErrorDomain);
+    XCTAssertEqual(task.error.code, AWSS3PresignedURLErrorInvalidExpiresDate);
+}
+
+- (void)testGetPreSignedURLsWithoutRequests {
+    AWSTask<NSArray<NSURL *> *> *task = [[self.preSignedURLBuilder getPreSignedURLs:@[]] waitUntilFinished];
+    XCTAssertNil(task.error);
+    XCTAssertEqualObjects(task.result, @[]);
+}
+
+- (void)testGetPreSignedURLsThroughput {
+    NSUInteger count = 10000;
+    NSMutableArray<AWSS3GetPreSignedURLRequest *> *requests = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [requests addObject:[self requestWithBucket:@"bucket" key:[NSString stringWithFormat:@"photos/%lu.jpg", (unsigned long)i]]];
+    }
+
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for (AWSS3GetPreSignedURLRequest *request in requests) {
+        XCTAssertNotNil([[self.preSignedURLBuilder getPreSignedURL:request] waitUntilFinished].result);
+    }
+    CFAbsoluteTime singleDuration = CFAbsoluteTimeGetCurrent() - start;
+
+    start = CFAbsoluteTimeGetCurrent();
+    AWSTask<NSArray<NSURL *> *> *task = [[self.preSignedURLBuilder getPreSignedURLs:requests] waitUntilFinished];
+    CFAbsoluteTime bulkDuration = CFAbsoluteTimeGetCurrent() - start;
+    XCTAssertEqual([task.result count], count);
+
+    NSLog(@"Presigned %lu URLs: getPreSignedURL: %.0f URLs/sec, getPreSignedURLs: %.0f URLs/sec",
+          (unsigned long)count, count / singleDuration, count / bulkDuration);
+}
+
+@end
@@ -0,0 +1,250 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSFMDB.h>
+#import "AWSS3TransferUtility.h"
+
+@interface AWSS3TransferUtilityDatabaseJournal : NSObject
+
+@property (atomic, assign) NSUInteger changeCount;
+@property (atomic, assign) NSUInteger statementCount;
+@property (atomic, assign) NSUInteger transactionCount;
+
+@end
+
+@interface AWSS3TransferUtilityDatabaseHelper : NSObject
+
++ (AWSFMDatabaseQueue *) createDatabase:(NSString*) cacheDirectoryPath;
+
++ (AWSS3TransferUtilityDatabaseJournal *) journalForDatabaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) flushPendingChangesToDB: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) deleteTransferRequestFromDB:(NSString *) transferID
+                       databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) deleteTransferRequestsFromDB:(NSArray<NSString *> *) transferIDs
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) updateTransferRequestInDB: (NSString *) transferID
+                        partNumber: (NSNumber *) partNumber
+                    taskIdentifier: (NSUInteger) taskIdentifier
+                              eTag: (NSString *) eTag
+                            status: (AWSS3TransferUtilityTransferStatusType) status
+                       retry_count: (NSUInteger) retryCount
+                     databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) insertTransferRequestInDB: (NSString *) transferID
+                    nsURLSessionID: (NSString *) nsURLSessionID
+                    taskIdentifier: (NSNumber *) taskIdentifier
+                      transferType: (NSString *) transferType
+                            bucket: (NSString *) bucket
+                               key: (NSString *) key
+                        partNumber: (NSNumber *) partNumber
+                       multiPartID: (NSString *) multiPartID
+                              eTag: (NSString *) eTag
+                              file: (NSString *) file
+              temporaryFileCreated: (BOOL) temporaryFileCreated
+                     contentLength: (NSNumber *) contentLength
+                            status: (AWSS3TransferUtilityTransferStatusType) status
+                        retryCount: (NSNumber *) retryCount
+                requestHeadersJSON: (NSString *) requestHeadersJSON
+             requestParametersJSON: (NSString *) requestParametersJSON
+                     databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (NSMutableArray *) getTransferTaskDataFromDB:(NSString *)nsURLSessionID
+                                 databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
+@end
+
+static NSString *const AWSS3TransferUtilityDatabaseHelperTestSessionID = @"AWSS3TransferUtilityDatabaseHelperTests";
+
+@interface AWSS3TransferUtilityDatabaseHelperTests : XCTestCase
+
+@property (nonatomic, strong) NSString *cacheDirectoryPath;
+@property (nonatomic, strong) AWSFMDatabaseQueue *databaseQueue;
+@property (nonatomic, strong) AWSS3TransferUtilityDatabaseJournal *journal;
+
+@end
+
+@implementation AWSS3TransferUtilityDatabaseHelperTests
+
+- (void)setUp {
+    [super setUp];
+    self.cacheDirectoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    self.databaseQueue = [AWSS3TransferUtilityDatabaseHelper createDatabase:self.cacheDirectoryPath];
+    XCTAssertNotNil(self.databaseQueue);
+    self.journal = [AWSS3TransferUtilityDatabaseHelper journalForDatabaseQueue:self.databaseQueue];
+}
+
+- (void)tearDown {
+    [self.databaseQueue close];
+    [[NSFileManager defaultManager] removeItemAtPath:self.cacheDirectoryPath error:nil];
+    [super tearDown];
+}
+
+- (void)insertTransfer:(NSString *)transferID
+            partNumber:(NSNumber *)partNumber
+          transferType:(NSString *)transferType {
+    BOOL isPart = [partNumber integerValue] > 0;
+    [AWSS3TransferUtilityDatabaseHelper insertTransferRequestInDB:transferID
+                                                   nsURLSessionID:AWSS3TransferUtilityDatabaseHelperTestSessionID
+                                                   taskIdentifier:@0
+                                                     transferType:transferType
+                                                           bucket:@"bucket"
+                                                              key:[NSString stringWithFormat:@"key/%@", transferID]
+                                                       partNumber:partNumber
+                                                      multiPartID:@""
+                                                             eTag:@""
+                                                             file:@"/tmp/file"
+                                             temporaryFileCreated:NO
+                                                    contentLength:@(5 * 1024 * 1024)
+                                                           status:AWSS3TransferUtilityTransferStatusWaiting
+                                                       retryCount:@0
+                                               requestHeadersJSON:isPart ? nil : @"{\"Content-Type\":\"text/plain\"}"
+                                            requestParametersJSON:isPart ? nil : @"{}"
+                                                    databaseQueue:self.databaseQueue];
+}
+
+- (void)updateTransfer:(NSString *)transferID
+            partNumber:(NSNumber *)partNumber
+                  eTag:(NSString *)eTag
+                status:(AWSS3TransferUtilityTransferStatusType)status {
+    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:transferID
+                                                       partNumber:partNumber
+                                                   taskIdentifier:42
+                                                             eTag:eTag
+                                                           status:status
+                                                      retry_count:0
+                                                    databaseQueue:self.databaseQueue];
+}
+
+- (NSArray<NSDictionary *> *)transfers {
+    return [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:AWSS3TransferUtilityDatabaseHelperTestSessionID
+                                                           databaseQueue:self.databaseQueue];
+}
+
+- (void)testUpdatesAreFoldedIntoPendingInsert {
+    [self insertTransfer:@"transfer" partNumber:@0 transferType:@"UPLOAD"];
+    [self updateTransfer:@"transfer" partNumber:@0 eTag:@"" status:AWSS3TransferUtilityTransferStatusInProgress];
+    [self updateTransfer:@"transfer" partNumber:@0 eTag:@"etag" status:AWSS3TransferUtilityTransferStatusCompleted];
+
+    NSArray<NSDictionary *> *transfers = [self transfers];
+    XCTAssertEqual([transfers count], 1);
+    XCTAssertEqualObjects(transfers[0][@"status"], @(AWSS3TransferUtilityTransferStatusCompleted));
+    XCTAssertEqualObjects(transfers[0][@"etag"], @"etag");
+    XCTAssertEqualObjects(transfers[0][@"session_task_id"], @42);
+    XCTAssertEqualObjects(transfers[0][@"request_headers"], @"{\"Content-Type\":\"text/plain\"}");
+    XCTAssertEqual(self.journal.changeCount, 3);
+    XCTAssertEqual(self.journal.statementCount, 1);
+    XCTAssertEqual(self.journal.transactionCount, 1);
+}
+
+- (void)testUpdatesOfCommittedRowAreCoalesced {
+    [self insertTransfer:@"transfer" partNumber:@0 transferType:@"UPLOAD"];
+    [AWSS3TransferUtilityDatabaseHelper flushPendingChangesToDB:self.databaseQueue];
+    for (NSUInteger i = 0; i < 10; i++) {
+        [self updateTransfer:@"transfer" partNumber:@0 eTag:[NSString stringWithFormat:@"etag-%lu", (unsigned long)i] status:AWSS3TransferUtilityTransferStatusInProgress];
+    }
+
+    XCTAssertEqualObjects([self transfers][0][@"etag"], @"etag-9");
+    XCTAssertEqual(self.journal.statementCount, 2);
+    XCTAssertEqual(self.journal.transactionCount, 2);
+}
+
+- (void)testTransferDeletedBeforeCommitIsNeverWritten {
+    [self insertTransfer:@"multipart" partNumber:@0 transferType:@"MULTI_PART_UPLOAD"];
+    for (int32_t i = 1; i <= 10; i++) {
+        [self insertTransfer:@"multipart" partNumber:@(i) transferType:@"MULTI_PART_UPLOAD_SUB_TASK"];
+        [self updateTransfer:@"multipart" partNumber:@(i) eTag:@"" status:AWSS3TransferUtilityTransferStatusInProgress];
+    }
+    [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:@"multipart" databaseQueue:self.databaseQueue];
+
+    XCTAssertEqual([[self transfers] count], 0);
+    XCTAssertEqual(self.journal.statementCount, 0);
+}
+
+- (void)testDeleteOfCommittedTransferDropsPendingChanges {
+    [self insertTransfer:@"multipart" partNumber:@0 transferType:@"MULTI_PART_UPLOAD"];
+    [self insertTransfer:@"multipart" partNumber:@1 transferType:@"MULTI_PART_UPLOAD_SUB_TASK"];
+    [AWSS3TransferUtilityDatabaseHelper flushPendingChangesToDB:self.databaseQueue];
+    [self insertTransfer:@"multipart" partNumber:@2 transferType:@"MULTI_PART_UPLOAD_SUB_TASK"];
+    [self updateTransfer:@"multipart" partNumber:@1 eTag:@"etag" status:AWSS3TransferUtilityTransferStatusCompleted];
+    [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:@"multipart" databaseQueue:self.databaseQueue];
+
+    XCTAssertEqual([[self transfers] count], 0);
+    XCTAssertEqual(self.journal.statementCount, 3);
+}
+
+- (void)testPartsDoNotRepeatRequestHeaders {
+    [self insertTransfer:@"multipart" partNumber:@0 transferType:@"MULTI_PART_UPLOAD"];
+    [self insertTransfer:@"multipart" partNumber:@1 transferType:@"MULTI_PART_UPLOAD_SUB_TASK"];
+
+    NSArray<NSDictionary *> *transfers = [self transfers];
+    XCTAssertEqual([transfers count], 2);
+    XCTAssertNotNil(transfers[0][@"request_headers"]);
+    XCTAssertNil(transfers[1][@"request_headers"]);
+    XCTAssertNil(transfers[1][@"request_parameters"]);
+}
+
+- (void)testChangesAreCommittedAfterInterval {
+    [self insertTransfer:@"transfer" partNumber:@0 transferType:@"DOWNLOAD"];
+    [self updateTransfer:@"transfer" partNumber:@0 eTag:@"" status:AWSS3TransferUtilityTransferStatusInProgress];
+    XCTAssertEqual(self.journal.transactionCount, 0);
+
+    [NSThread sleepForTimeInterval:0.5];
+    XCTAssertEqual(self.journal.transactionCount, 1);
+    XCTAssertEqual(self.journal.statementCount, 1);
+}
+
+- (void)testWriteAmplificationAndRecoveryOf10kTransfers {
+    NSUInteger const transferCount = 10000;
+    NSMutableArray<NSString *> *transferIDs = [NSMutableArray new];
+
+    NSDate *start = [NSDate date];
+    for (NSUInteger i = 0; i < transferCount; i++) {
+        NSString *transferID = [[NSUUID UUID] UUIDString];
+        [transferIDs addObject:transferID];
+        [self insertTransfer:transferID partNumber:@0 transferType:@"UPLOAD"];
+        [self updateTransfer:transferID partNumber:@0 eTag:@"" status:AWSS3TransferUtilityTransferStatusInProgress];
+        [self updateTransfer:transferID partNumber:@0 eTag:@"" status:AWSS3TransferUtilityTransferStatusPaused];
+    }
+    [AWSS3TransferUtilityDatabaseHelper flushPendingChangesToDB:self.databaseQueue];
+    NSLog(@"Persisted %lu transfers in %.3f sec: %lu changes, %lu statements, %lu transactions",
+          (unsigned long)transferCount,
+          [[NSDate date] timeIntervalSinceDate:start],
+          (unsigned long)self.journal.changeCount,
+          (unsigned long)self.journal.statementCount,
+          (unsigned long)self.journal.transactionCount);
+    XCTAssertEqual(self.journal.changeCount, transferCount * 3);
+    // A commit may land between the insert of a transfer and its updates, which then take one more statement.
+    XCTAssertLessThanOrEqual(self.journal.statementCount, transferCount + self.journal.transactionCount);
+    XCTAssertLessThan(self.journal.transactionCount, transferCount / 10);
+
+    // What recovery does on a cold start: one read of every transfer, then one cleanup.
+    start = [NSDate date];
+    NSArray<NSDictionary *> *transfers = [self transfers];
+    NSTimeInterval readTime = [[NSDate date] timeIntervalSinceDate:start];
+    [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestsFromDB:transferIDs databaseQueue:self.databaseQueue];
+    NSLog(@"Recovered %lu transfers in %.3f sec, cleaned them up in %.3f sec",
+          (unsigned long)[transfers count],
+          readTime,
+          [[NSDate date] timeIntervalSinceDate:start] - readTime);
+    XCTAssertEqual([transfers count], transferCount);
+    XCTAssertEqual([[self transfers] count], 0);
+}
+
+@end
@@ -0,0 +1,153 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import <AWSCore/AWSCore.h>
+#import "AWSSQSModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class AWSSQS;
+
+/**
+ The default value of `maxBatchOpenTime`, 0.2 seconds.
+ */
+FOUNDATION_EXPORT NSTimeInterval const AWSSQSBufferedClientMaxBatchOpenTimeDefault;
+
+/**
+ The default value of `maxPrefetchedMessages`, 10.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSSQSBufferedClientMaxPrefetchedMessagesDefault;
+
+/**
+ The default value of `prefetchVisibilityTimeout`, 30 seconds.
+ */
+FOUNDATION_EXPORT NSInteger const AWSSQSBufferedClientPrefetchVisibilityTimeoutDefault;
+
+/**
+ A client that batches single SQS calls and prefetches messages.
+
+ `sendMessage:`, `deleteMessage:` and `changeMessageVisibility:` calls for the same queue are collected for up to
+ `maxBatchOpenTime` and sent as one `SendMessageBatch`, `DeleteMessageBatch` or `ChangeMessageVisibilityBatch` call of
+ at most 10 entries. A batch is sent early when it is full. Each call still gets its own task, completed with the
+ outcome of its entry. Batches for FIFO queues are sent one at a time, so messages keep their order.
+
+ `receiveMessage:` is served from a buffer of up to `maxPrefetchedMessages` messages per queue. The buffer is filled in
+ the background with long polling, for as long as the queue is being read. A prefetched message is handed out only
+ during the first half of its `prefetchVisibilityTimeout`, so that the caller has time to process and delete it; older
+ messages are discarded and become visible on the queue again. Requests that set `visibilityTimeout` or
+ `receiveRequestAttemptId` are passed through to `AWSSQS`.
+
+     AWSSQSBufferedClient *client = [[AWSSQSBufferedClient alloc] initWithSQS:[AWSSQS defaultSQS]];
+     [[client receiveMessage:receiveMessageRequest] continueWithSuccessBlock:^id(AWSTask<AWSSQSReceiveMessageResult *> *task) {
+         ...
+         return [client deleteMessage:deleteMessageRequest];
+     }];
+ */
+@interface AWSSQSBufferedClient : NSObject
+
+/**
+ The client the batched calls are made with.
+ */
+@property (nonatomic, strong, readonly) AWSSQS *sqs;
+
+/**
+ The longest time a call waits for other calls to share its batch. The default value is `AWSSQSBufferedClientMaxBatchOpenTimeDefault`.
+ */
+@property (atomic, assign) NSTimeInterval maxBatchOpenTime;
+
+/**
+ The maximum number of entries per batch, between 1 and 10. The default value is 10.
+ */
+@property (atomic, assign) NSUInteger maxBatchSize;
+
+/**
+ The maximum number of messages prefetched per queue. Set it to `0` to pass every `receiveMessage:` call through.
+ The default value is `AWSSQSBufferedClientMaxPrefetchedMessagesDefault`.
+ */
+@property (atomic, assign) NSUInteger maxPrefetchedMessages;
+
+/**
+ The visibility timeout, in seconds, requested for prefetched messages. The default value is `AWSSQSBufferedClientPrefetchVisibilityTimeoutDefault`.
+ */
+@property (atomic, assign) NSInteger prefetchVisibilityTimeout;
+
+/**
+ The long polling wait time, in seconds, of the prefetching `ReceiveMessage` calls. The default value is 20.
+ */
+@property (atomic, assign) NSInteger prefetchWaitTimeSeconds;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a buffered client on top of the given client.
+
+ @param sqs The client used to call SQS.
+
+ @return A buffered client.
+ */
+- (instancetype)initWithSQS:(AWSSQS *)sqs NS_DESIGNATED_INITIALIZER;
+
+/**
+ Sends a message as part of a `SendMessageBatch` call.
+
+ @param request A container for the necessary parameters to execute the SendMessage service method.
+
+ @return An instance of `AWSTask`. On successful execution, `task.result` will contain an instance of `AWSSQSSendMessageResult`.
+ When the entry fails, `task.error` is in `AWSSQSErrorDomain` and its `userInfo` holds the `Code` and `Message` of the entry.
+ */
+- (AWSTask<AWSSQSSendMessageResult *> *)sendMessage:(AWSSQSSendMessageRequest *)request;
+
+/**
+ Deletes a message as part of a `DeleteMessageBatch` call.
+
+ @param request A container for the necessary parameters to execute the DeleteMessage service method.
+
+ @return An instance of `AWSTask`. On successful execution, `task.result` will be `nil`.
+ When the entry fails, `task.error` is in `AWSSQSErrorDomain` and its `userInfo` holds the `Code` and `Message` of the entry.
+ */
+- (AWSTask *)deleteMessage:(AWSSQSDeleteMessageRequest *)request;
+
+/**
+ Changes the visibility timeout of a message as part of a `ChangeMessageVisibilityBatch` call.
+
+ @param request A container for the necessary parameters to execute the ChangeMessageVisibility service method.
+
+ @return An instance of `AWSTask`. On successful execution, `task.result` will be `nil`.
+ When the entry fails, `task.error` is in `AWSSQSErrorDomain` and its `userInfo` holds the `Code` and `Message` of the entry.
+ */
+- (AWSTask *)changeMessageVisibility:(AWSSQSChangeMessageVisibilityRequest *)request;
+
+/**
+ Receives messages from the prefetch buffer of the queue. When the buffer is empty, the call waits up to
+ `waitTimeSeconds` for prefetched messages; without a wait time it is passed through to `AWSSQS`.
+ Prefetched messages carry all of their attributes and message attributes.
+
+ @param request A container for the necessary parameters to execute the ReceiveMessage service method.
+
+ @return An instance of `AWSTask`. On successful execution, `task.result` will contain an instance of `AWSSQSReceiveMessageResult`.
+ */
+- (AWSTask<AWSSQSReceiveMessageResult *> *)receiveMessage:(AWSSQSReceiveMessageRequest *)request;
+
+/**
+ Sends every open batch without waiting for `maxBatchOpenTime`.
+
+ @return An instance of `AWSTask` that completes when the batches have been sent. `task.result` will be `nil`.
+ */
+- (AWSTask *)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
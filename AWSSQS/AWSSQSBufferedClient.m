@@ -0,0 +1,627 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSSQSBufferedClient.h"
+#import "AWSSQSService.h"
+
+NSTimeInterval const AWSSQSBufferedClientMaxBatchOpenTimeDefault = 0.2;
+NSUInteger const AWSSQSBufferedClientMaxPrefetchedMessagesDefault = 10;
+NSInteger const AWSSQSBufferedClientPrefetchVisibilityTimeoutDefault = 30;
+
+// SQS limits.
+static NSUInteger const AWSSQSMaxBatchEntries = 10;
+static NSUInteger const AWSSQSMaxBatchPayloadBytes = 256 * 1024;
+
+static NSTimeInterval const AWSSQSPrefetchRetryInterval = 1.0;
+
+static NSError *AWSSQSBatchEntryError(AWSSQSBatchResultErrorEntry *errorEntry) {
+    static NSDictionary *errorCodeDictionary = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        errorCodeDictionary = @{
+                                @"InvalidMessageContents" : @(AWSSQSErrorInvalidMessageContents),
+                                @"AWS.SimpleQueueService.MessageNotInflight" : @(AWSSQSErrorMessageNotInflight),
+                                @"ReceiptHandleIsInvalid" : @(AWSSQSErrorReceiptHandleIsInvalid),
+                                };
+    });
+
+    NSMutableDictionary *userInfo = [NSMutableDictionary new];
+    userInfo[@"Code"] = errorEntry.code;
+    userInfo[@"Message"] = errorEntry.message;
+    userInfo[@"SenderFault"] = errorEntry.senderFault;
+    NSNumber *code = errorEntry.code ? errorCodeDictionary[errorEntry.code] : nil;
+    return [NSError errorWithDomain:AWSSQSErrorDomain
+                               code:code ? [code integerValue] : AWSSQSErrorUnknown
+                           userInfo:userInfo];
+}
+
+static NSUInteger AWSSQSMessagePayloadBytes(AWSSQSSendMessageRequest *request) {
+    __block NSUInteger bytes = [request.messageBody lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    [request.messageAttributes enumerateKeysAndObjectsUsingBlock:^(NSString *name, AWSSQSMessageAttributeValue *value, BOOL *stop) {
+        bytes += [name lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        bytes += [value.dataType lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        bytes += [value.stringValue lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        bytes += value.binaryValue.length;
+    }];
+    return bytes;
+}
+
+#pragma mark - AWSSQSBufferedRequest
+
+// A single call waiting in a batch.
+@interface AWSSQSBufferedRequest : NSObject
+
+@property (nonatomic, strong) id request;
+@property (nonatomic, assign) NSUInteger bytes;
+@property (nonatomic, strong) AWSTaskCompletionSource *taskCompletionSource;
+
+@end
+
+@implementation AWSSQSBufferedRequest
+
+@end
+
+// Completes the calls of a batch from the `Successful` and `Failed` entries of its result.
+static void AWSSQSCompleteBatch(NSArray<AWSSQSBufferedRequest *> *batch,
+                                NSError *error,
+                                NSArray *successful,
+                                NSArray<AWSSQSBatchResultErrorEntry *> *failed,
+                                id (^resultBlock)(id successfulEntry)) {
+    if (error) {
+        for (AWSSQSBufferedRequest *bufferedRequest in batch) {
+            [bufferedRequest.taskCompletionSource trySetError:error];
+        }
+        return;
+    }
+
+    for (id successfulEntry in successful) {
+        NSInteger index = [[successfulEntry identifier] integerValue];
+        if (index >= 0 && index < batch.count) {
+            [batch[index].taskCompletionSource trySetResult:resultBlock(successfulEntry)];
+        }
+    }
+    for (AWSSQSBatchResultErrorEntry *errorEntry in failed) {
+        NSInteger index = [errorEntry.identifier integerValue];
+        if (index >= 0 && index < batch.count) {
+            [batch[index].taskCompletionSource trySetError:AWSSQSBatchEntryError(errorEntry)];
+        }
+    }
+
+    // Entries missing from the result should not happen; do not leave their callers waiting.
+    for (AWSSQSBufferedRequest *bufferedRequest in batch) {
+        [bufferedRequest.taskCompletionSource trySetError:[NSError errorWithDomain:AWSSQSErrorDomain
+                                                                              code:AWSSQSErrorUnknown
+                                                                          userInfo:@{@"Message" : @"The batch result has no entry for this request."}]];
+    }
+}
+
+#pragma mark - AWSSQSOutboundBatcher
+
+typedef AWSTask * _Nonnull (^AWSSQSBatchSendBlock)(NSArray<AWSSQSBufferedRequest *> *batch);
+
+// Collects calls of one kind for one queue into batches.
+@interface AWSSQSOutboundBatcher : NSObject
+
+@property (nonatomic, weak) AWSSQSBufferedClient *client;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, copy) AWSSQSBatchSendBlock sendBlock;
+@property (nonatomic, assign) BOOL sendsSerially;
+
+// Confined to `queue`.
+@property (nonatomic, strong) NSMutableArray<AWSSQSBufferedRequest *> *openBatch;
+@property (nonatomic, assign) NSUInteger openBatchBytes;
+@property (nonatomic, assign) NSUInteger openBatchGeneration;
+@property (nonatomic, strong) NSMutableArray<AWSTask *> *sendTasks;
+
+@end
+
+@implementation AWSSQSOutboundBatcher
+
+- (instancetype)initWithClient:(AWSSQSBufferedClient *)client
+                         queue:(dispatch_queue_t)queue
+                 sendsSerially:(BOOL)sendsSerially
+                     sendBlock:(AWSSQSBatchSendBlock)sendBlock {
+    if (self = [super init]) {
+        _client = client;
+        _queue = queue;
+        _sendsSerially = sendsSerially;
+        _sendBlock = sendBlock;
+        _openBatch = [NSMutableArray new];
+        _sendTasks = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (AWSTask *)addRequest:(id)request bytes:(NSUInteger)bytes {
+    AWSSQSBufferedRequest *bufferedRequest = [AWSSQSBufferedRequest new];
+    bufferedRequest.request = request;
+    bufferedRequest.bytes = bytes;
+    bufferedRequest.taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+
+    NSUInteger maxBatchSize = MAX(1, MIN(self.client.maxBatchSize, AWSSQSMaxBatchEntries));
+    NSTimeInterval maxBatchOpenTime = self.client.maxBatchOpenTime;
+
+    dispatch_async(self.queue, ^{
+        if (self.openBatch.count > 0 && self.openBatchBytes + bytes > AWSSQSMaxBatchPayloadBytes) {
+            [self sendOpenBatch];
+        }
+        [self.openBatch addObject:bufferedRequest];
+        self.openBatchBytes += bytes;
+
+        if (self.openBatch.count >= maxBatchSize || maxBatchOpenTime <= 0) {
+            [self sendOpenBatch];
+        } else if (self.openBatch.count == 1) {
+            NSUInteger generation = self.openBatchGeneration;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(maxBatchOpenTime * NSEC_PER_SEC)), self.queue, ^{
+                if (self.openBatchGeneration == generation) {
+                    [self sendOpenBatch];
+                }
+            });
+        }
+    });
+
+    return bufferedRequest.taskCompletionSource.task;
+}
+
+// Must be called on `queue`.
+- (void)sendOpenBatch {
+    if (self.openBatch.count == 0) {
+        return;
+    }
+
+    NSArray<AWSSQSBufferedRequest *> *batch = self.openBatch;
+    self.openBatch = [NSMutableArray new];
+    self.openBatchBytes = 0;
+    self.openBatchGeneration++;
+
+    AWSTask *sendTask = nil;
+    AWSTask *previousSendTask = self.sendTasks.lastObject;
+    if (self.sendsSerially && previousSendTask) {
+        sendTask = [previousSendTask continueWithBlock:^id(AWSTask *task) {
+            return self.sendBlock(batch);
+        }];
+    } else {
+        sendTask = self.sendBlock(batch);
+    }
+
+    if (!sendTask) {
+        return;
+    }
+    [self.sendTasks addObject:sendTask];
+    [sendTask continueWithBlock:^id(AWSTask *task) {
+        dispatch_async(self.queue, ^{
+            [self.sendTasks removeObject:sendTask];
+        });
+        return nil;
+    }];
+}
+
+- (AWSTask *)flush {
+    AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    dispatch_async(self.queue, ^{
+        [self sendOpenBatch];
+        [[AWSTask taskForCompletionOfAllTasks:[self.sendTasks copy]] continueWithBlock:^id(AWSTask *task) {
+            [taskCompletionSource setResult:nil];
+            return nil;
+        }];
+    });
+    return taskCompletionSource.task;
+}
+
+@end
+
+#pragma mark - AWSSQSQueueBuffer
+
+@interface AWSSQSPrefetchedMessage : NSObject
+
+@property (nonatomic, strong) AWSSQSMessage *message;
+@property (nonatomic, strong) NSDate *expirationDate;
+
+@end
+
+@implementation AWSSQSPrefetchedMessage
+
+@end
+
+@interface AWSSQSReceiveWaiter : NSObject
+
+@property (nonatomic, assign) NSUInteger maxNumberOfMessages;
+@property (nonatomic, strong) AWSTaskCompletionSource<AWSSQSReceiveMessageResult *> *taskCompletionSource;
+
+@end
+
+@implementation AWSSQSReceiveWaiter
+
+@end
+
+// The batchers and the prefetch buffer of one queue.
+@interface AWSSQSQueueBuffer : NSObject
+
+@property (nonatomic, weak) AWSSQSBufferedClient *client;
+@property (nonatomic, strong) NSString *queueUrl;
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+@property (nonatomic, strong) AWSSQSOutboundBatcher *sendBatcher;
+@property (nonatomic, strong) AWSSQSOutboundBatcher *deleteBatcher;
+@property (nonatomic, strong) AWSSQSOutboundBatcher *visibilityBatcher;
+
+// Confined to `queue`.
+@property (nonatomic, strong) NSMutableArray<AWSSQSPrefetchedMessage *> *prefetchedMessages;
+@property (nonatomic, strong) NSMutableArray<AWSSQSReceiveWaiter *> *waiters;
+@property (nonatomic, assign) NSUInteger requestedMessageCount;
+@property (nonatomic, strong) NSDate *lastReceiveDate;
+@property (nonatomic, assign) BOOL prefetchPaused;
+
+@end
+
+@implementation AWSSQSQueueBuffer
+
+- (instancetype)initWithClient:(AWSSQSBufferedClient *)client queueUrl:(NSString *)queueUrl {
+    if (self = [super init]) {
+        _client = client;
+        _queueUrl = queueUrl;
+        _queue = dispatch_queue_create("com.amazonaws.AWSSQSBufferedClient.queue", DISPATCH_QUEUE_SERIAL);
+        _prefetchedMessages = [NSMutableArray new];
+        _waiters = [NSMutableArray new];
+
+        __weak AWSSQSQueueBuffer *weakSelf = self;
+        BOOL isFIFOQueue = [queueUrl hasSuffix:@".fifo"];
+        _sendBatcher = [[AWSSQSOutboundBatcher alloc] initWithClient:client queue:_queue sendsSerially:isFIFOQueue sendBlock:^AWSTask *(NSArray<AWSSQSBufferedRequest *> *batch) {
+            return [weakSelf sendMessageBatch:batch];
+        }];
+        _deleteBatcher = [[AWSSQSOutboundBatcher alloc] initWithClient:client queue:_queue sendsSerially:NO sendBlock:^AWSTask *(NSArray<AWSSQSBufferedRequest *> *batch) {
+            return [weakSelf deleteMessageBatch:batch];
+        }];
+        _visibilityBatcher = [[AWSSQSOutboundBatcher alloc] initWithClient:client queue:_queue sendsSerially:NO sendBlock:^AWSTask *(NSArray<AWSSQSBufferedRequest *> *batch) {
+            return [weakSelf changeMessageVisibilityBatch:batch];
+        }];
+    }
+    return self;
+}
+
+#pragma mark - Outbound batches
+
+- (AWSTask *)sendMessageBatch:(NSArray<AWSSQSBufferedRequest *> *)batch {
+    NSMutableArray<AWSSQSSendMessageBatchRequestEntry *> *entries = [NSMutableArray arrayWithCapacity:batch.count];
+    [batch enumerateObjectsUsingBlock:^(AWSSQSBufferedRequest *bufferedRequest, NSUInteger idx, BOOL *stop) {
+        AWSSQSSendMessageRequest *request = bufferedRequest.request;
+        AWSSQSSendMessageBatchRequestEntry *entry = [AWSSQSSendMessageBatchRequestEntry new];
+        entry.identifier = [@(idx) stringValue];
+        entry.delaySeconds = request.delaySeconds;
+        entry.messageAttributes = request.messageAttributes;
+        entry.messageBody = request.messageBody;
+        entry.messageDeduplicationId = request.messageDeduplicationId;
+        entry.messageGroupId = request.messageGroupId;
+        entry.messageSystemAttributes = request.messageSystemAttributes;
+        [entries addObject:entry];
+    }];
+
+    AWSSQSSendMessageBatchRequest *batchRequest = [AWSSQSSendMessageBatchRequest new];
+    batchRequest.queueUrl = self.queueUrl;
+    batchRequest.entries = entries;
+
+    return [[self.client.sqs sendMessageBatch:batchRequest] continueWithBlock:^id(AWSTask<AWSSQSSendMessageBatchResult *> *task) {
+        AWSSQSCompleteBatch(batch, task.error, task.result.successful, task.result.failed, ^id(AWSSQSSendMessageBatchResultEntry *successfulEntry) {
+            AWSSQSSendMessageResult *result = [AWSSQSSendMessageResult new];
+            result.MD5OfMessageAttributes = successfulEntry.MD5OfMessageAttributes;
+            result.MD5OfMessageBody = successfulEntry.MD5OfMessageBody;
+            result.MD5OfMessageSystemAttributes = successfulEntry.MD5OfMessageSystemAttributes;
+            result.messageId = successfulEntry.messageId;
+            result.sequenceNumber = successfulEntry.sequenceNumber;
+            return result;
+        });
+        return nil;
+    }];
+}
+
+- (AWSTask *)deleteMessageBatch:(NSArray<AWSSQSBufferedRequest *> *)batch {
+    NSMutableArray<AWSSQSDeleteMessageBatchRequestEntry *> *entries = [NSMutableArray arrayWithCapacity:batch.count];
+    [batch enumerateObjectsUsingBlock:^(AWSSQSBufferedRequest *bufferedRequest, NSUInteger idx, BOOL *stop) {
+        AWSSQSDeleteMessageRequest *request = bufferedRequest.request;
+        AWSSQSDeleteMessageBatchRequestEntry *entry = [AWSSQSDeleteMessageBatchRequestEntry new];
+        entry.identifier = [@(idx) stringValue];
+        entry.receiptHandle = request.receiptHandle;
+        [entries addObject:entry];
+    }];
+
+    AWSSQSDeleteMessageBatchRequest *batchRequest = [AWSSQSDeleteMessageBatchRequest new];
+    batchRequest.queueUrl = self.queueUrl;
+    batchRequest.entries = entries;
+
+    return [[self.client.sqs deleteMessageBatch:batchRequest] continueWithBlock:^id(AWSTask<AWSSQSDeleteMessageBatchResult *> *task) {
+        AWSSQSCompleteBatch(batch, task.error, task.result.successful, task.result.failed, ^id(id successfulEntry) {
+            return nil;
+        });
+        return nil;
+    }];
+}
+
+- (AWSTask *)changeMessageVisibilityBatch:(NSArray<AWSSQSBufferedRequest *> *)batch {
+    NSMutableArray<AWSSQSChangeMessageVisibilityBatchRequestEntry *> *entries = [NSMutableArray arrayWithCapacity:batch.count];
+    [batch enumerateObjectsUsingBlock:^(AWSSQSBufferedRequest *bufferedRequest, NSUInteger idx, BOOL *stop) {
+        AWSSQSChangeMessageVisibilityRequest *request = bufferedRequest.request;
+        AWSSQSChangeMessageVisibilityBatchRequestEntry *entry = [AWSSQSChangeMessageVisibilityBatchRequestEntry new];
+        entry.identifier = [@(idx) stringValue];
+        entry.receiptHandle = request.receiptHandle;
+        entry.visibilityTimeout = request.visibilityTimeout;
+        [entries addObject:entry];
+    }];
+
+    AWSSQSChangeMessageVisibilityBatchRequest *batchRequest = [AWSSQSChangeMessageVisibilityBatchRequest new];
+    batchRequest.queueUrl = self.queueUrl;
+    batchRequest.entries = entries;
+
+    return [[self.client.sqs changeMessageVisibilityBatch:batchRequest] continueWithBlock:^id(AWSTask<AWSSQSChangeMessageVisibilityBatchResult *> *task) {
+        AWSSQSCompleteBatch(batch, task.error, task.result.successful, task.result.failed, ^id(id successfulEntry) {
+            return nil;
+        });
+        return nil;
+    }];
+}
+
+- (AWSTask *)flush {
+    return [AWSTask taskForCompletionOfAllTasks:@[[self.sendBatcher flush],
+                                                  [self.deleteBatcher flush],
+                                                  [self.visibilityBatcher flush]]];
+}
+
+#pragma mark - Prefetching
+
+- (AWSTask<AWSSQSReceiveMessageResult *> *)receiveMessage:(AWSSQSReceiveMessageRequest *)request {
+    AWSTaskCompletionSource<AWSSQSReceiveMessageResult *> *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    NSUInteger maxNumberOfMessages = request.maxNumberOfMessages ? MAX(1, MIN([request.maxNumberOfMessages unsignedIntegerValue], AWSSQSMaxBatchEntries)) : 1;
+    NSTimeInterval waitTime = [request.waitTimeSeconds doubleValue];
+
+    dispatch_async(self.queue, ^{
+        self.lastReceiveDate = [NSDate date];
+        [self discardExpiredMessages];
+
+        if (self.prefetchedMessages.count > 0 && self.waiters.count == 0) {
+            [taskCompletionSource setResult:[self takeMessages:maxNumberOfMessages]];
+        } else if (waitTime <= 0) {
+            [[self.client.sqs receiveMessage:request] continueWithBlock:^id(AWSTask<AWSSQSReceiveMessageResult *> *task) {
+                if (task.error) {
+                    [taskCompletionSource setError:task.error];
+                } else {
+                    [taskCompletionSource setResult:task.result];
+                }
+                return nil;
+            }];
+        } else {
+            AWSSQSReceiveWaiter *waiter = [AWSSQSReceiveWaiter new];
+            waiter.maxNumberOfMessages = maxNumberOfMessages;
+            waiter.taskCompletionSource = taskCompletionSource;
+            [self.waiters addObject:waiter];
+
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(waitTime * NSEC_PER_SEC)), self.queue, ^{
+                if ([self.waiters containsObject:waiter]) {
+                    [self.waiters removeObject:waiter];
+                    [taskCompletionSource setResult:[self takeMessages:0]];
+                }
+            });
+        }
+
+        [self prefetchIfNeeded];
+    });
+
+    return taskCompletionSource.task;
+}
+
+// Must be called on `queue`.
+- (void)discardExpiredMessages {
+    NSDate *now = [NSDate date];
+    NSUInteger expiredCount = 0;
+    while (expiredCount < self.prefetchedMessages.count
+           && [self.prefetchedMessages[expiredCount].expirationDate compare:now] != NSOrderedDescending) {
+        expiredCount++;
+    }
+    if (expiredCount > 0) {
+        AWSDDLogDebug(@"Discarding %lu prefetched messages of %@ whose visibility timeout is running out.", (unsigned long)expiredCount, self.queueUrl);
+        [self.prefetchedMessages removeObjectsInRange:NSMakeRange(0, expiredCount)];
+    }
+}
+
+// Must be called on `queue`.
+- (AWSSQSReceiveMessageResult *)takeMessages:(NSUInteger)maxNumberOfMessages {
+    [self discardExpiredMessages];
+
+    NSUInteger count = MIN(maxNumberOfMessages, self.prefetchedMessages.count);
+    NSMutableArray<AWSSQSMessage *> *messages = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [messages addObject:self.prefetchedMessages[i].message];
+    }
+    [self.prefetchedMessages removeObjectsInRange:NSMakeRange(0, count)];
+
+    AWSSQSReceiveMessageResult *result = [AWSSQSReceiveMessageResult new];
+    result.messages = messages;
+    return result;
+}
+
+// Must be called on `queue`.
+- (void)prefetchIfNeeded {
+    AWSSQSBufferedClient *client = self.client;
+    if (!client || self.prefetchPaused) {
+        return;
+    }
+
+    // Stop prefetching once nobody has read from the queue for a visibility timeout; the messages would only expire.
+    NSInteger visibilityTimeout = client.prefetchVisibilityTimeout;
+    if (!self.lastReceiveDate || -[self.lastReceiveDate timeIntervalSinceNow] > visibilityTimeout) {
+        return;
+    }
+
+    NSUInteger demand = 0;
+    for (AWSSQSReceiveWaiter *waiter in self.waiters) {
+        demand += waiter.maxNumberOfMessages;
+    }
+    NSUInteger target = MAX(client.maxPrefetchedMessages, demand);
+
+    while (self.prefetchedMessages.count + self.requestedMessageCount < target) {
+        NSUInteger count = MIN(target - self.prefetchedMessages.count - self.requestedMessageCount, AWSSQSMaxBatchEntries);
+        self.requestedMessageCount += count;
+
+        AWSSQSReceiveMessageRequest *receiveRequest = [AWSSQSReceiveMessageRequest new];
+        receiveRequest.queueUrl = self.queueUrl;
+        receiveRequest.maxNumberOfMessages = @(count);
+        receiveRequest.visibilityTimeout = @(visibilityTimeout);
+        receiveRequest.waitTimeSeconds = @(client.prefetchWaitTimeSeconds);
+        receiveRequest.attributeNames = @[@"All"];
+        receiveRequest.messageAttributeNames = @[@"All"];
+
+        __weak AWSSQSQueueBuffer *weakSelf = self;
+        dispatch_queue_t queue = self.queue;
+        [[client.sqs receiveMessage:receiveRequest] continueWithBlock:^id(AWSTask<AWSSQSReceiveMessageResult *> *task) {
+            // The visibility timeout started when SQS returned the messages, shortly before now.
+            NSDate *expirationDate = [NSDate dateWithTimeIntervalSinceNow:visibilityTimeout / 2.0];
+            dispatch_async(queue, ^{
+                [weakSelf didReceiveMessages:task.result.messages
+                              expirationDate:expirationDate
+                              requestedCount:count
+                                       error:task.error];
+            });
+            return nil;
+        }];
+    }
+}
+
+// Must be called on `queue`.
+- (void)didReceiveMessages:(NSArray<AWSSQSMessage *> *)messages
+            expirationDate:(NSDate *)expirationDate
+            requestedCount:(NSUInteger)requestedCount
+                     error:(NSError *)error {
+    self.requestedMessageCount -= requestedCount;
+
+    if (error) {
+        AWSDDLogError(@"Failed to prefetch messages from %@: %@", self.queueUrl, error);
+        for (AWSSQSReceiveWaiter *waiter in self.waiters) {
+            [waiter.taskCompletionSource setError:error];
+        }
+        [self.waiters removeAllObjects];
+
+        self.prefetchPaused = YES;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(AWSSQSPrefetchRetryInterval * NSEC_PER_SEC)), self.queue, ^{
+            self.prefetchPaused = NO;
+            [self prefetchIfNeeded];
+        });
+        return;
+    }
+
+    for (AWSSQSMessage *message in messages) {
+        AWSSQSPrefetchedMessage *prefetchedMessage = [AWSSQSPrefetchedMessage new];
+        prefetchedMessage.message = message;
+        prefetchedMessage.expirationDate = expirationDate;
+        [self.prefetchedMessages addObject:prefetchedMessage];
+    }
+
+    while (self.waiters.count > 0 && self.prefetchedMessages.count > 0) {
+        AWSSQSReceiveWaiter *waiter = self.waiters.firstObject;
+        [self.waiters removeObjectAtIndex:0];
+        [waiter.taskCompletionSource setResult:[self takeMessages:waiter.maxNumberOfMessages]];
+    }
+
+    [self prefetchIfNeeded];
+}
+
+@end
+
+#pragma mark - AWSSQSBufferedClient
+
+@interface AWSSQSBufferedClient()
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSSQSQueueBuffer *> *queueBuffers;
+
+@end
+
+@implementation AWSSQSBufferedClient
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithSQS:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithSQS:(AWSSQS *)sqs {
+    if (self = [super init]) {
+        _sqs = sqs;
+        _maxBatchOpenTime = AWSSQSBufferedClientMaxBatchOpenTimeDefault;
+        _maxBatchSize = AWSSQSMaxBatchEntries;
+        _maxPrefetchedMessages = AWSSQSBufferedClientMaxPrefetchedMessagesDefault;
+        _prefetchVisibilityTimeout = AWSSQSBufferedClientPrefetchVisibilityTimeoutDefault;
+        _prefetchWaitTimeSeconds = 20;
+        _queueBuffers = [NSMutableDictionary new];
+    }
+
+    return self;
+}
+
+- (AWSSQSQueueBuffer *)bufferForQueueUrl:(NSString *)queueUrl {
+    @synchronized(self.queueBuffers) {
+        AWSSQSQueueBuffer *queueBuffer = self.queueBuffers[queueUrl];
+        if (!queueBuffer) {
+            queueBuffer = [[AWSSQSQueueBuffer alloc] initWithClient:self queueUrl:queueUrl];
+            self.queueBuffers[queueUrl] = queueBuffer;
+        }
+        return queueBuffer;
+    }
+}
+
+- (AWSTask<AWSSQSSendMessageResult *> *)sendMessage:(AWSSQSSendMessageRequest *)request {
+    if (!request.queueUrl) {
+        return [self.sqs sendMessage:request];
+    }
+    return [[self bufferForQueueUrl:request.queueUrl].sendBatcher addRequest:request bytes:AWSSQSMessagePayloadBytes(request)];
+}
+
+- (AWSTask *)deleteMessage:(AWSSQSDeleteMessageRequest *)request {
+    if (!request.queueUrl) {
+        return [self.sqs deleteMessage:request];
+    }
+    return [[self bufferForQueueUrl:request.queueUrl].deleteBatcher addRequest:request bytes:0];
+}
+
+- (AWSTask *)changeMessageVisibility:(AWSSQSChangeMessageVisibilityRequest *)request {
+    if (!request.queueUrl) {
+        return [self.sqs changeMessageVisibility:request];
+    }
+    return [[self bufferForQueueUrl:request.queueUrl].visibilityBatcher addRequest:request bytes:0];
+}
+
+- (AWSTask<AWSSQSReceiveMessageResult *> *)receiveMessage:(AWSSQSReceiveMessageRequest *)request {
+    if (!request.queueUrl
+        || self.maxPrefetchedMessages == 0
+        || request.visibilityTimeout
+        || request.receiveRequestAttemptId) {
+        return [self.sqs receiveMessage:request];
+    }
+    return [[self bufferForQueueUrl:request.queueUrl] receiveMessage:request];
+}
+
+- (AWSTask *)flush {
+    NSArray<AWSSQSQueueBuffer *> *queueBuffers = nil;
+    @synchronized(self.queueBuffers) {
+        queueBuffers = self.queueBuffers.allValues;
+    }
+
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray arrayWithCapacity:queueBuffers.count];
+    for (AWSSQSQueueBuffer *queueBuffer in queueBuffers) {
+        [tasks addObject:[queueBuffer flush]];
+    }
+    return [[AWSTask taskForCompletionOfAllTasks:tasks] continueWithBlock:^id(AWSTask *task) {
+        return nil;
+    }];
+}
+
+@end
@@ -0,0 +1,391 @@
+//
+// Copyright 2010-2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSSQSService.h"
+#import "AWSSQSBufferedClient.h"
+
+static NSString *const AWSSQSBufferedClientTestsQueueUrl = @"https://sqs.us-east-1.amazonaws.com/123456789012/AWSSQSBufferedClientTests";
+
+@interface AWSSQS()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+// An in-memory, single queue stand-in for SQS. It implements the message calls the buffered client makes, including
+// long polling, and counts the requests it serves.
+@interface AWSSQSBufferedClientTestQueue : AWSSQS
+
+@property (nonatomic, strong) NSMutableArray<AWSSQSMessage *> *visibleMessages;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSSQSMessage *> *inflightMessages;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *requestCounts;
+@property (nonatomic, strong) NSMutableArray<NSString *> *sentBodies;
+
+@end
+
+@implementation AWSSQSBufferedClientTestQueue
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration {
+    if (self = [super initWithConfiguration:configuration]) {
+        _visibleMessages = [NSMutableArray new];
+        _inflightMessages = [NSMutableDictionary new];
+        _requestCounts = [NSMutableDictionary new];
+        _sentBodies = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (void)countRequest:(NSString *)action {
+    self.requestCounts[action] = @([self.requestCounts[action] unsignedIntegerValue] + 1);
+}
+
+- (NSUInteger)totalRequestCount {
+    @synchronized(self) {
+        NSUInteger total = 0;
+        for (NSNumber *count in self.requestCounts.allValues) {
+            total += [count unsignedIntegerValue];
+        }
+        return total;
+    }
+}
+
+- (void)enqueueBody:(NSString *)body {
+    AWSSQSMessage *message = [AWSSQSMessage new];
+    message.messageId = [NSUUID UUID].UUIDString;
+    message.body = body;
+    [self.visibleMessages addObject:message];
+    [self.sentBodies addObject:body];
+}
+
+- (AWSTask<AWSSQSSendMessageResult *> *)sendMessage:(AWSSQSSendMessageRequest *)request {
+    @synchronized(self) {
+        [self countRequest:@"SendMessage"];
+        [self enqueueBody:request.messageBody];
+    }
+    return [AWSTask taskWithResult:[AWSSQSSendMessageResult new]];
+}
+
+- (AWSTask<AWSSQSSendMessageBatchResult *> *)sendMessageBatch:(AWSSQSSendMessageBatchRequest *)request {
+    AWSSQSSendMessageBatchResult *result = [AWSSQSSendMessageBatchResult new];
+    NSMutableArray *successful = [NSMutableArray new];
+    NSMutableArray *failed = [NSMutableArray new];
+    @synchronized(self) {
+        [self countRequest:@"SendMessageBatch"];
+        for (AWSSQSSendMessageBatchRequestEntry *entry in request.entries) {
+            if (entry.messageBody.length == 0) {
+                AWSSQSBatchResultErrorEntry *errorEntry = [AWSSQSBatchResultErrorEntry new];
+                errorEntry.identifier = entry.identifier;
+                errorEntry.code = @"InvalidMessageContents";
+                errorEntry.message = @"The message body must not be empty.";
+                errorEntry.senderFault = @YES;
+                [failed addObject:errorEntry];
+                continue;
+            }
+            [self enqueueBody:entry.messageBody];
+            AWSSQSSendMessageBatchResultEntry *resultEntry = [AWSSQSSendMessageBatchResultEntry new];
+            resultEntry.identifier = entry.identifier;
+            resultEntry.messageId = [self.visibleMessages.lastObject messageId];
+            [successful addObject:resultEntry];
+        }
+    }
+    result.successful = successful;
+    result.failed = failed;
+    return [AWSTask taskWithResult:result];
+}
+
+- (NSArray<AWSSQSMessage *> *)takeVisibleMessages:(NSUInteger)maxNumberOfMessages {
+    @synchronized(self) {
+        NSUInteger count = MIN(maxNumberOfMessages, self.visibleMessages.count);
+        NSMutableArray<AWSSQSMessage *> *messages = [NSMutableArray new];
+        for (NSUInteger i = 0; i < count; i++) {
+            AWSSQSMessage *message = self.visibleMessages[i];
+            message.receiptHandle = [NSUUID UUID].UUIDString;
+            self.inflightMessages[message.receiptHandle] = message;
+            [messages addObject:message];
+        }
+        [self.visibleMessages removeObjectsInRange:NSMakeRange(0, count)];
+        return messages;
+    }
+}
+
+- (AWSTask<AWSSQSReceiveMessageResult *> *)receiveMessage:(AWSSQSReceiveMessageRequest *)request {
+    @synchronized(self) {
+        [self countRequest:@"ReceiveMessage"];
+    }
+
+    NSUInteger maxNumberOfMessages = request.maxNumberOfMessages ? [request.maxNumberOfMessages unsignedIntegerValue] : 1;
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:[request.waitTimeSeconds doubleValue]];
+    AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    __block void (^poll)(void) = nil;
+    void (^pollBlock)(void) = ^{
+        NSArray<AWSSQSMessage *> *messages = [self takeVisibleMessages:maxNumberOfMessages];
+        if (messages.count > 0 || [deadline timeIntervalSinceNow] <= 0) {
+            AWSSQSReceiveMessageResult *result = [AWSSQSReceiveMessageResult new];
+            result.messages = messages;
+            [taskCompletionSource setResult:result];
+            poll = nil;
+        } else {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.01 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), poll);
+        }
+    };
+    poll = pollBlock;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), poll);
+    return taskCompletionSource.task;
+}
+
+- (AWSTask *)deleteMessage:(AWSSQSDeleteMessageRequest *)request {
+    @synchronized(self) {
+        [self countRequest:@"DeleteMessage"];
+        [self.inflightMessages removeObjectForKey:request.receiptHandle];
+    }
+    return [AWSTask taskWithResult:nil];
+}
+
+- (AWSTask<AWSSQSDeleteMessageBatchResult *> *)deleteMessageBatch:(AWSSQSDeleteMessageBatchRequest *)request {
+    AWSSQSDeleteMessageBatchResult *result = [AWSSQSDeleteMessageBatchResult new];
+    NSMutableArray *successful = [NSMutableArray new];
+    NSMutableArray *failed = [NSMutableArray new];
+    @synchronized(self) {
+        [self countRequest:@"DeleteMessageBatch"];
+        for (AWSSQSDeleteMessageBatchRequestEntry *entry in request.entries) {
+            if (!self.inflightMessages[entry.receiptHandle]) {
+                AWSSQSBatchResultErrorEntry *errorEntry = [AWSSQSBatchResultErrorEntry new];
+                errorEntry.identifier = entry.identifier;
+                errorEntry.code = @"ReceiptHandleIsInvalid";
+                errorEntry.senderFault = @YES;
+                [failed addObject:errorEntry];
+                continue;
+            }
+            [self.inflightMessages removeObjectForKey:entry.receiptHandle];
+            AWSSQSDeleteMessageBatchResultEntry *resultEntry = [AWSSQSDeleteMessageBatchResultEntry new];
+            resultEntry.identifier = entry.identifier;
+            [successful addObject:resultEntry];
+        }
+    }
+    result.successful = successful;
+    result.failed = failed;
+    return [AWSTask taskWithResult:result];
+}
+
+- (AWSTask<AWSSQSChangeMessageVisibilityBatchResult *> *)changeMessageVisibilityBatch:(AWSSQSChangeMessageVisibilityBatchRequest *)request {
+    AWSSQSChangeMessageVisibilityBatchResult *result = [AWSSQSChangeMessageVisibilityBatchResult new];
+    NSMutableArray *successful = [NSMutableArray new];
+    @synchronized(self) {
+        [self countRequest:@"ChangeMessageVisibilityBatch"];
+        for (AWSSQSChangeMessageVisibilityBatchRequestEntry *entry in request.entries) {
+            AWSSQSMessage *message = self.inflightMessages[entry.receiptHandle];
+            if (message && [entry.visibilityTimeout integerValue] == 0) {
+                [self.inflightMessages removeObjectForKey:entry.receiptHandle];
+                [self.visibleMessages addObject:message];
+            }
+            AWSSQSChangeMessageVisibilityBatchResultEntry *resultEntry = [AWSSQSChangeMessageVisibilityBatchResultEntry new];
+            resultEntry.identifier = entry.identifier;
+            [successful addObject:resultEntry];
+        }
+    }
+    result.successful = successful;
+    return [AWSTask taskWithResult:result];
+}
+
+@end
+
+@interface AWSSQSBufferedClientTests : XCTestCase
+
+@property (nonatomic, strong) AWSSQSBufferedClientTestQueue *queue;
+@property (nonatomic, strong) AWSSQSBufferedClient *client;
+
+@end
+
+@implementation AWSSQSBufferedClientTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1 credentialsProvider:nil];
+    self.queue = [[AWSSQSBufferedClientTestQueue alloc] initWithConfiguration:configuration];
+    self.client = [[AWSSQSBufferedClient alloc] initWithSQS:self.queue];
+    self.client.prefetchWaitTimeSeconds = 1;
+}
+
+- (AWSSQSSendMessageRequest *)sendMessageRequestWithBody:(NSString *)body {
+    AWSSQSSendMessageRequest *request = [AWSSQSSendMessageRequest new];
+    request.queueUrl = AWSSQSBufferedClientTestsQueueUrl;
+    request.messageBody = body;
+    return request;
+}
+
+- (AWSSQSReceiveMessageRequest *)receiveMessageRequest {
+    AWSSQSReceiveMessageRequest *request = [AWSSQSReceiveMessageRequest new];
+    request.queueUrl = AWSSQSBufferedClientTestsQueueUrl;
+    request.maxNumberOfMessages = @10;
+    request.waitTimeSeconds = @1;
+    return request;
+}
+
+- (void)testSendsAreBatched {
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 25; i++) {
+        [tasks addObject:[self.client sendMessage:[self sendMessageRequestWithBody:[NSString stringWithFormat:@"message %lu", (unsigned long)i]]]];
+    }
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+
+    for (AWSTask<AWSSQSSendMessageResult *> *task in tasks) {
+        XCTAssertNil(task.error);
+        XCTAssertNotNil(task.result.messageId);
+    }
+    XCTAssertEqual(self.queue.sentBodies.count, 25);
+    XCTAssertEqualObjects(self.queue.sentBodies.firstObject, @"message 0");
+    XCTAssertEqualObjects(self.queue.requestCounts[@"SendMessageBatch"], @3);
+    XCTAssertNil(self.queue.requestCounts[@"SendMessage"]);
+}
+
+- (void)testOpenBatchIsSentAfterMaxBatchOpenTime {
+    self.client.maxBatchOpenTime = 0.05;
+    AWSTask *task = [self.client sendMessage:[self sendMessageRequestWithBody:@"lonely"]];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqualObjects(self.queue.requestCounts[@"SendMessageBatch"], @1);
+}
+
+- (void)testFailedEntriesFailOnlyTheirCall {
+    AWSTask *goodTask = [self.client sendMessage:[self sendMessageRequestWithBody:@"good"]];
+    AWSTask *badTask = [self.client sendMessage:[self sendMessageRequestWithBody:@""]];
+    [[self.client flush] waitUntilFinished];
+    [goodTask waitUntilFinished];
+    [badTask waitUntilFinished];
+
+    XCTAssertNil(goodTask.error);
+    XCTAssertEqualObjects(badTask.error.domain, AWSSQSErrorDomain);
+    XCTAssertEqual(badTask.error.code, AWSSQSErrorInvalidMessageContents);
+    XCTAssertEqualObjects(badTask.error.userInfo[@"Code"], @"InvalidMessageContents");
+    XCTAssertEqualObjects(self.queue.requestCounts[@"SendMessageBatch"], @1);
+}
+
+- (void)testReceiveWaitsForPrefetchedMessages {
+    AWSTask<AWSSQSReceiveMessageResult *> *receiveTask = [self.client receiveMessage:[self receiveMessageRequest]];
+    [[[self.client sendMessage:[self sendMessageRequestWithBody:@"hello"]] continueWithBlock:^id(AWSTask *task) {
+        return receiveTask;
+    }] waitUntilFinished];
+
+    XCTAssertNil(receiveTask.error);
+    XCTAssertEqual(receiveTask.result.messages.count, 1);
+    XCTAssertEqualObjects(receiveTask.result.messages.firstObject.body, @"hello");
+}
+
+- (void)testReceiveTimesOutWithNoMessages {
+    AWSSQSReceiveMessageRequest *request = [self receiveMessageRequest];
+    AWSTask<AWSSQSReceiveMessageResult *> *receiveTask = [self.client receiveMessage:request];
+    [receiveTask waitUntilFinished];
+
+    XCTAssertNil(receiveTask.error);
+    XCTAssertEqual(receiveTask.result.messages.count, 0);
+}
+
+- (void)testDeletesAreBatchedAndInvalidHandlesFail {
+    for (NSUInteger i = 0; i < 10; i++) {
+        [self.queue enqueueBody:[NSString stringWithFormat:@"message %lu", (unsigned long)i]];
+    }
+    AWSTask<AWSSQSReceiveMessageResult *> *receiveTask = [self.client receiveMessage:[self receiveMessageRequest]];
+    [receiveTask waitUntilFinished];
+    XCTAssertEqual(receiveTask.result.messages.count, 10);
+
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    for (AWSSQSMessage *message in receiveTask.result.messages) {
+        AWSSQSDeleteMessageRequest *request = [AWSSQSDeleteMessageRequest new];
+        request.queueUrl = AWSSQSBufferedClientTestsQueueUrl;
+        request.receiptHandle = message.receiptHandle;
+        [tasks addObject:[self.client deleteMessage:request]];
+    }
+    AWSSQSDeleteMessageRequest *invalidRequest = [AWSSQSDeleteMessageRequest new];
+    invalidRequest.queueUrl = AWSSQSBufferedClientTestsQueueUrl;
+    invalidRequest.receiptHandle = @"invalid";
+    AWSTask *invalidTask = [self.client deleteMessage:invalidRequest];
+
+    [[self.client flush] waitUntilFinished];
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+    [invalidTask waitUntilFinished];
+
+    for (AWSTask *task in tasks) {
+        XCTAssertNil(task.error);
+    }
+    XCTAssertEqual(invalidTask.error.code, AWSSQSErrorReceiptHandleIsInvalid);
+    XCTAssertEqual(self.queue.inflightMessages.count, 0);
+    XCTAssertEqualObjects(self.queue.requestCounts[@"DeleteMessageBatch"], @2);
+}
+
+- (void)testChangeMessageVisibilityIsBatched {
+    [self.queue enqueueBody:@"message"];
+    AWSTask<AWSSQSReceiveMessageResult *> *receiveTask = [self.client receiveMessage:[self receiveMessageRequest]];
+    [receiveTask waitUntilFinished];
+
+    AWSSQSChangeMessageVisibilityRequest *request = [AWSSQSChangeMessageVisibilityRequest new];
+    request.queueUrl = AWSSQSBufferedClientTestsQueueUrl;
+    request.receiptHandle = receiveTask.result.messages.firstObject.receiptHandle;
+    request.visibilityTimeout = @0;
+    AWSTask *task = [self.client changeMessageVisibility:request];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqualObjects(self.queue.requestCounts[@"ChangeMessageVisibilityBatch"], @1);
+}
+
+// Sends, receives and deletes 500 messages like a worker would, one call per message, and reports the number of SQS
+// requests per message processed. Without the buffered client, it takes three requests per message.
+- (void)testRequestsPerMessageProcessed {
+    NSUInteger const messageCount = 500;
+
+    NSMutableArray<AWSTask *> *sendTasks = [NSMutableArray new];
+    for (NSUInteger i = 0; i < messageCount; i++) {
+        [sendTasks addObject:[self.client sendMessage:[self sendMessageRequestWithBody:[NSString stringWithFormat:@"job %lu", (unsigned long)i]]]];
+    }
+    [[AWSTask taskForCompletionOfAllTasks:sendTasks] waitUntilFinished];
+
+    NSUInteger processedCount = 0;
+    NSMutableArray<AWSTask *> *deleteTasks = [NSMutableArray new];
+    while (processedCount < messageCount) {
+        AWSSQSReceiveMessageRequest *request = [self receiveMessageRequest];
+        request.maxNumberOfMessages = @1;
+        AWSTask<AWSSQSReceiveMessageResult *> *receiveTask = [self.client receiveMessage:request];
+        [receiveTask waitUntilFinished];
+        XCTAssertNil(receiveTask.error);
+        if (receiveTask.result.messages.count == 0) {
+            break;
+        }
+
+        for (AWSSQSMessage *message in receiveTask.result.messages) {
+            AWSSQSDeleteMessageRequest *deleteRequest = [AWSSQSDeleteMessageRequest new];
+            deleteRequest.queueUrl = AWSSQSBufferedClientTestsQueueUrl;
+            deleteRequest.receiptHandle = message.receiptHandle;
+            [deleteTasks addObject:[self.client deleteMessage:deleteRequest]];
+            processedCount++;
+        }
+    }
+    [[self.client flush] waitUntilFinished];
+    [[AWSTask taskForCompletionOfAllTasks:deleteTasks] waitUntilFinished];
+
+    XCTAssertEqual(processedCount, messageCount);
+    XCTAssertEqual(self.queue.inflightMessages.count, 0);
+
+    // Prefetching may still be polling the empty queue; those receives are part of the cost.
+    double requestsPerMessage = (double)[self.queue totalRequestCount] / messageCount;
+    NSLog(@"%.3f SQS requests per message processed (%@).", requestsPerMessage, self.queue.requestCounts);
+    XCTAssertLessThan(requestsPerMessage, 0.5);
+}
+
+@end